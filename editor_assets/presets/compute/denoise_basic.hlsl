@@ -7,6 +7,7 @@ cbuffer Params : register(b0) {
     float invWidth;
     float invHeight;
     uint frame;
+    uint historyFrames; // History slots holding rendered frames
 };
 
 Texture2D<float4> inputTexture : register(t0);
@@ -7,6 +7,7 @@ cbuffer Params : register(b0) {
     float invWidth;
     float invHeight;
     uint frame;
+    uint historyFrames; // History slots holding rendered frames
 };
 
 Texture2D<float4> inputTexture : register(t0);
@@ -21,7 +22,7 @@ void main(uint3 threadID : SV_DispatchThreadID) {
     if (coord.x >= width || coord.y >= height) return;
 
     float4 current = inputTexture[coord];
-    float4 history = historyTexture[coord];
+    float4 history = historyFrames > 0 ? historyTexture[coord] : current;
     float4 accumulated = history * param0 + current * param1;
     accumulated.rgb *= param2;
     outputTexture[coord] = saturate(accumulated);
@@ -20,7 +20,7 @@
 //     - Read current pixel from input texture (bright wireframe)
 //     - Read previous pixel from history texture (dimmer trail)
 //     - Blend: output = history*decay + current*blend
-//     - Store output as new history for next frame
+//     - The output texture becomes the history texture next frame
 //
 //   Result: Moving geometry leaves glowing trails behind it
 // =============================================================================
@@ -35,6 +35,7 @@ cbuffer Params : register(b0) {
     float invWidth;    // 1.0 / texture width
     float invHeight;   // 1.0 / texture height
     uint frame;        // Frame counter
+    uint historyFrames; // History slots holding rendered frames (0 on the first frame)
 };
 
 // Input/output textures
@@ -63,8 +64,9 @@ void main(uint3 threadID : SV_DispatchThreadID) {
     // Read current pixel (bright wireframe edges)
     float4 current = inputTexture[coord];
 
-    // Read history pixel (previous frame's accumulation)
-    float4 history = historyTexture[coord];
+    // Read history pixel (previous frame's accumulation); seed it with the current
+    // frame until the runtime has rendered one
+    float4 history = historyFrames > 0 ? historyTexture[coord] : current;
 
     // Temporal accumulation formula
     float4 accumulated = history * param0 + current * param1;
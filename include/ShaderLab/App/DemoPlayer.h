@@ -1,6 +1,12 @@
 #pragma once
 
 #include "ShaderLab/Core/ShaderLabData.h"
+#include "ShaderLab/Core/DemoSequencer.h"
+#include "ShaderLab/Core/PipelineLoadScheduler.h"
+#include "ShaderLab/Core/ResidencyPlanner.h"
+#include "ShaderLab/Core/DeferredReleaseQueue.h"
+#include "ShaderLab/Core/FrameProfiler.h"
+#include <memory>
 #include <d3d12.h>
 #include <wrl/client.h>
 #include <vector>
@@ -17,6 +23,13 @@ class Swapchain;
 class PreviewRenderer;
 class AudioSystem;
 class ShaderCompiler;
+class Dx12ResourceService;
+class TransientTargetService;
+class DescriptorRingService;
+class FrameUploadRing;
+class RenderGraphExecutor;
+class GpuProfiler;
+class DynamicResolutionController;
 
 class DemoPlayer {
 public:
@@ -29,7 +42,21 @@ public:
     bool IsLooping() const { return m_loopPlayback; }
     void SetVsyncEnabled(bool enabled) { m_vsyncEnabled = enabled; }
     bool IsVsyncEnabled() const { return m_vsyncEnabled; }
+    // Beats ahead of first use that scene render targets are created. Negative keeps every
+    // scene resident for the whole demo.
+    void SetResidencyLeadBeats(double beats) { m_residencyLeadBeats = beats; }
+    // Renders below the output size whenever the GPU frame takes longer than targetMs and
+    // upscales in the final pass. minWidth bounds the render width (0 = half the output);
+    // targetMs <= 0 disables it.
+    void SetDynamicResolution(double targetMs, uint32_t minWidth) {
+        m_dynamicResolutionTargetMs = targetMs;
+        m_dynamicResolutionMinWidth = minWidth;
+    }
     
+    // Frame the caller's queue is recording and the newest one the GPU has finished. Without
+    // it the player assumes the caller waits for the GPU after every frame.
+    void SetGpuFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+
     void Update(double wallTime, float dt);
     void Render(ID3D12GraphicsCommandList* commandList, ID3D12Resource* renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle);
     void OnResize(int width, int height);
@@ -39,28 +66,43 @@ public:
 private:
     void SetActiveScene(int index);
     bool CompileScene(int sceneIndex);
+    bool PollPipelineLoading();
     void EnsureSceneTexture(int sceneIndex);
-    void RenderScene(ID3D12GraphicsCommandList* commandList, int sceneIndex, double time);
+    uint32_t DeclareScene(int sceneIndex, double time);
     std::string GetTransitionShader(const std::string& transitionPresetStem);
     void EnsurePostFxResources(Scene& scene);
+    bool BindSrvTable(ID3D12GraphicsCommandList* commandList,
+                      const D3D12_CPU_DESCRIPTOR_HANDLE* sources,
+                      uint32_t count,
+                      D3D12_GPU_DESCRIPTOR_HANDLE& outTable);
     void EnsurePostFxHistory(Scene::PostFXEffect& effect);
     bool CompilePostFxEffect(Scene::PostFXEffect& effect, int sceneIndex, int fxIndex);
     bool CompileComputeEffect(Scene::ComputeEffect& effect, int sceneIndex, int computeIndex);
-    ID3D12Resource* ApplyPostFxChain(ID3D12GraphicsCommandList* commandList,
-                                    Scene& scene,
-                                    ID3D12Resource* inputTexture,
-                                    double timeSeconds);
+    uint32_t DeclarePostFxChain(Scene& scene, uint32_t input, double timeSeconds);
     void EnsureComputeHistory(Scene::ComputeEffect& effect);
-    ID3D12Resource* ApplyComputeChain(ID3D12GraphicsCommandList* commandList,
-                                     int sceneIndex,
-                                     std::vector<Scene::ComputeEffect>& chain,
-                                     ID3D12Resource* inputTexture,
-                                     double timeSeconds);
-    ID3D12Resource* GetSceneFinalTexture(ID3D12GraphicsCommandList* commandList,
-                                        int sceneIndex,
-                                        double timeSeconds);
+    uint32_t DeclareComputeChain(int sceneIndex,
+                                 std::vector<Scene::ComputeEffect>& chain,
+                                 uint32_t input,
+                                 double timeSeconds);
+    uint32_t DeclareSceneFinal(int sceneIndex, double timeSeconds);
     bool EnsureTransitionPipeline(const std::string& transitionPresetStem);
     void PrimeRuntimeResources();
+    uint64_t EstimateSceneResidentBytes(const Scene& scene) const;
+    void BuildResidencyPlan();
+    void UpdateResidency(double beat);
+    void MakeSceneResident(int sceneIndex);
+    void ReleaseSceneResources(int sceneIndex);
+    void DeferRelease(ComPtr<IUnknown> object);
+    template <typename Effect>
+    void ResetHistoryRing(Effect& effect);
+    void UpdateDynamicResolution(ID3D12Resource* renderTarget);
+    bool EnsureUpscalePipeline();
+    void DeclareUpscale(uint32_t source, uint32_t backbuffer, ID3D12Resource* renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle);
+#if !SHADERLAB_TINY_PLAYER
+    void LoadFileTextures(bool packed);
+    bool LoadFileTexture(const std::string& path, bool packed, ComPtr<ID3D12Resource>& outTexture, std::string& outError);
+    void RecordTextureUploads(ID3D12GraphicsCommandList* commandList);
+#endif
     
     // Core Refs
     Device* m_device = nullptr;
@@ -87,17 +129,61 @@ private:
     bool m_loadingFailed = false;
     int m_compilationIndex = 0;
     std::string m_manifestPath;
+    // Factory outlives the scheduler so worker threads never see a dangling backend.
+    std::unique_ptr<IPipelineFactory> m_pipelineFactory;
+    PipelineLoadScheduler m_pipelineLoader;
 
     // Runtime State
-    int m_activeSceneIndex = -1;
-    float m_activeSceneOffset = 0.0f; // Offset in beats relative to scene start
-    double m_activeSceneStartBeat = 0.0;
+    DemoSequencer m_sequencer; // Active scene + transition state
+    std::vector<SequencerCommand> m_sequencerCommands;
     Transport m_transport; // Runtime transport state
     double m_currentAudioStartTime = 0.0;
 
+    // Scene render target residency
+    double m_residencyLeadBeats = 4.0;
+    ResidencyPlan m_residencyPlan;
+    bool m_residencyPlanValid = false;
+    uint32_t m_residencyPlanWidth = 0;
+    uint32_t m_residencyPlanHeight = 0;
+    std::vector<uint8_t> m_sceneResident;
+
+    // Dynamic resolution: m_width/m_height follow the controller, the backbuffer keeps the output size
+    double m_dynamicResolutionTargetMs = 0.0;
+    uint32_t m_dynamicResolutionMinWidth = 0;
+    std::unique_ptr<DynamicResolutionController> m_dynamicResolution;
+    uint64_t m_dynamicResolutionFrame = 0; // Newest profiler frame fed to the controller
+    ComPtr<ID3D12PipelineState> m_upscalePSO;
+    bool m_upscalePipelineFailed = false;
+    ComPtr<ID3D12DescriptorHeap> m_upscaleRtvHeap; // Transition target when it is not the backbuffer
+
     // Render Resources
     uint32_t m_width = 0;
     uint32_t m_height = 0;
+    std::unique_ptr<Dx12ResourceService> m_resourceService;
+    std::unique_ptr<TransientTargetService> m_transientTargets; // Post-FX/compute ping-pong targets
+    std::unique_ptr<DescriptorRingService> m_descriptorRing; // Shader-visible tables for every draw
+    std::unique_ptr<FrameUploadRing> m_uploadRing; // Per-dispatch compute constants
+    std::unique_ptr<RenderGraphExecutor> m_renderGraph; // Rebuilt every frame from the visible scenes
+    std::vector<uint32_t> m_graphSceneTextures; // Per scene: graph resource of its texture, or invalid
+    std::vector<uint32_t> m_graphSceneOutputs;  // Per scene: graph resource after post-FX/compute
+    std::string m_renderGraphError;
+    std::unique_ptr<GpuProfiler> m_profiler; // Per-pass CPU/GPU timings for the debug overlay
+    std::vector<ProfileFlameBar> m_flameBars;
+    bool m_traceCapturePending = false;
+    std::string m_traceStatus;
+    DeferredReleaseQueue<ComPtr<IUnknown>> m_deferredReleases; // Objects an in-flight frame may still use
+    uint64_t m_frameIndex = 0;
+    int64_t m_completedFrameIndex = -1;
+    bool m_externalFrameClock = false;
+#if !SHADERLAB_TINY_PLAYER
+    // File-bound textures created during loading; their copies are recorded by the next Render.
+    struct PendingTextureUpload {
+        ComPtr<ID3D12Resource> texture;
+        ComPtr<ID3D12Resource> upload;
+        std::vector<D3D12_PLACED_SUBRESOURCE_FOOTPRINT> footprints;
+    };
+    std::vector<PendingTextureUpload> m_pendingTextureUploads;
+#endif
     
     ComPtr<ID3D12Resource> m_dummyTexture;
     ComPtr<ID3D12DescriptorHeap> m_dummySrvHeap;
@@ -114,26 +200,11 @@ private:
     TransportState m_debugLastTransportState = TransportState::Stopped;
     LoadingStage m_debugLastLoadingStage = LoadingStage::Idle;
     
-    // Transition State
-    bool m_transitionActive = false;
-    double m_transitionStartBeat = 0.0;
-    double m_transitionDurationBeats = 1.0;
-    int m_transitionFromIndex = -1;
-    int m_transitionToIndex = -1;
-    double m_transitionFromStartBeat = 0.0;
-    double m_transitionToStartBeat = 0.0;
-    float m_transitionFromOffset = 0.0f;
-    float m_transitionToOffset = 0.0f;
-    std::string m_currentTransitionStem;
-    int m_pendingActiveScene = -2;
-    int m_transitionJustCompletedBeat = -1;
-    
+    // Transition Resources
     ComPtr<ID3D12PipelineState> m_transitionPSO;
-    ComPtr<ID3D12DescriptorHeap> m_transitionSrvHeap;
     std::string m_compiledTransitionStem;
     std::unordered_map<std::string, ComPtr<ID3D12PipelineState>> m_transitionPsoCache;
 
-    std::vector<int> m_renderStack;
     std::vector<uint8_t> m_precompiledVertexShader;
     std::unordered_map<std::string, std::vector<uint8_t>> m_transitionBytecode;
     std::vector<std::vector<uint8_t>> m_microModuleBytecode;
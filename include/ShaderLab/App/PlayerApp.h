@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <windows.h>
 
 namespace ShaderLab {
@@ -10,6 +11,9 @@ struct PlayerLaunchOptions {
     bool screenSaverMode = false;
     bool vsyncEnabled = true;
     bool startFullscreen = true;
+    double residencyLeadBeats = 4.0; // Negative keeps every scene resident
+    double dynamicResolutionTargetMs = 0.0; // GPU frame budget; 0 renders at the output size
+    uint32_t dynamicResolutionMinWidth = 0;  // 0 = half the output width
 };
 
 int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options);
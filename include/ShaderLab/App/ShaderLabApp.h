@@ -14,6 +14,7 @@ class AudioSystem;
 class BeatClock;
 class ShaderCompiler;
 class PreviewRenderer;
+class ShaderBytecodeCache;
 
 class ShaderLabApp {
 public:
@@ -39,6 +40,8 @@ private:
     void UpdateWindowTitle();
     void ConfigureCustomTitlebar();
 
+    // Outlives restarts so a new adapter reuses the compiled bytecode.
+    std::unique_ptr<ShaderBytecodeCache> m_bytecodeCache;
     std::unique_ptr<Device> m_device;
     std::unique_ptr<CommandQueue> m_commandQueue;
     std::unique_ptr<Swapchain> m_swapchain;
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "ShaderLab/Core/AudioAnalyzer.h"
+
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
 #include <vector>
@@ -29,11 +33,26 @@ public:
 
     void PlayOneShot(const std::string& filepath);
 
+    // Decodes a whole encoded file (wav, mp3, flac, ogg) to mono float at its own sample rate.
+    static bool DecodeMono(const void* data, size_t size, std::vector<float>& outSamples, uint32_t& outSampleRate, std::string& outError);
+    // Same, handing over each decoded chunk instead of keeping the whole clip.
+    static bool DecodeMono(const void* data,
+                           size_t size,
+                           const std::function<void(const float*, size_t)>& onSamples,
+                           uint32_t& outSampleRate,
+                           std::string& outError);
+
     bool IsPlaying() const;
     float GetPlaybackTime() const;  // In seconds
     float GetDuration() const;      // In seconds
 
+    // Live analysis of the background sound, produced on a worker from the audio thread's output.
+    AudioShaderBlock GetAnalysisBlock() const { return m_analyzer.GetShaderBlock(); }
+    const AudioAnalyzer& GetAnalyzer() const { return m_analyzer; }
+
 private:
+    void AttachAnalysisTap();
+
     ma_engine* m_engine = nullptr;
     ma_sound* m_sound = nullptr; // Background sound
     
@@ -41,6 +60,9 @@ private:
     void* m_decoder = nullptr; // ma_decoder opaque
     std::vector<uint8_t> m_audioBuffer;
 
+    AudioAnalyzer m_analyzer;
+    void* m_analysisTap = nullptr; // Pass-through node between m_sound and the endpoint
+
     bool m_initialized = false;
 };
 
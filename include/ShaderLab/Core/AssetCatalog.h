@@ -0,0 +1,108 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+
+struct AssetEntry {
+    std::string path;                             // Full path
+    std::string relativePath;                     // From the collection root, '/' separated
+    std::string stem;
+    uint64_t size = 0;
+    int64_t writeTime = 0;                        // file_time_type ticks; compared, never shown
+    std::shared_ptr<const std::string> content;   // Set when the collection loads content
+    std::shared_ptr<const void> parsed;           // Set by the collection's parser
+
+    template <typename T>
+    const T* Parsed() const { return static_cast<const T*>(parsed.get()); }
+};
+
+// Immutable once published; hold the shared_ptr for as long as the entries are in use.
+struct AssetCollectionSnapshot {
+    uint64_t generation = 0;      // Bumped whenever the entries change
+    bool rootExists = false;
+    std::vector<AssetEntry> entries; // Sorted by relativePath
+};
+
+// Runs on the catalog worker for new or changed files only; unchanged files keep their result.
+// entry.content is set during the call even when the collection does not keep content.
+using AssetParseFn = std::function<std::shared_ptr<const void>(const AssetEntry& entry)>;
+
+struct AssetCollectionDesc {
+    std::string root;                      // Empty = no folder; the collection stays idle
+    std::string seedFrom;                  // Files missing from root are copied from here before each scan
+    std::vector<std::string> suffixes;     // File name suffixes, e.g. ".hlsl"; empty = every file
+    int maxDepth = 0;                      // Subfolder levels below root; 0 = root's own files
+    bool loadContent = false;
+    bool createRoot = false;
+    AssetParseFn parse;
+};
+
+struct AssetCatalogStats {
+    uint64_t scans = 0;
+    uint64_t filesRead = 0;       // Content reads and parses
+    uint64_t notifications = 0;   // Change batches from the native watcher
+    bool nativeWatcher = false;
+};
+
+// Watches asset folders (inotify on Linux, ReadDirectoryChangesW on Windows, a slow poll
+// elsewhere) and rescans a collection on its worker when something under it changes. Only files
+// whose size or write time changed are read and parsed again. The UI thread only swaps snapshot
+// pointers, so it never touches the disk.
+class AssetCatalog {
+public:
+    AssetCatalog();
+    ~AssetCatalog();
+    AssetCatalog(const AssetCatalog&) = delete;
+    AssetCatalog& operator=(const AssetCatalog&) = delete;
+
+    // Collections can be added before or after Start; each is scanned as soon as the worker runs.
+    int AddCollection(AssetCollectionDesc desc);
+    // Points a collection at another folder, e.g. after the workspace changes.
+    void SetCollectionRoot(int collection, const std::string& root, const std::string& seedFrom);
+    void SetCollectionSuffixes(int collection, std::vector<std::string> suffixes);
+    void RequestRescan(int collection);
+
+    void Start();
+    void Stop();
+
+    // Null until the first scan of the collection finishes.
+    std::shared_ptr<const AssetCollectionSnapshot> GetSnapshot(int collection) const;
+    uint64_t GetGeneration(int collection) const;
+    // For startup code that needs the assets before the first frame; false on timeout. A zero
+    // timeout only checks whether the latest root and suffixes have been scanned.
+    bool WaitForScan(int collection, uint32_t timeoutMs) const;
+    AssetCatalogStats GetStats() const;
+
+private:
+    struct Watcher;
+    struct Collection {
+        AssetCollectionDesc desc;
+        uint64_t descVersion = 0;
+        uint64_t scannedVersion = ~uint64_t(0);
+        bool dirty = true;
+        bool watched = false;
+        std::shared_ptr<const AssetCollectionSnapshot> snapshot;
+    };
+
+    void WorkerMain();
+    void ScanCollection(int index);
+
+    mutable std::mutex m_mutex;
+    mutable std::condition_variable m_scanned;
+    std::vector<Collection> m_collections;
+    AssetCatalogStats m_stats;
+    std::unique_ptr<Watcher> m_watcher;
+    std::thread m_worker;
+    bool m_stop = false;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ShaderLab/Core/CompilationService.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderLab {
+
+class ShaderBytecodeCache;
+
+enum class CompileTargetKind : uint8_t {
+    Scene,
+    PostFx,     // Effect of a scene's post-FX chain
+    Compute,    // Effect of a scene's compute chain
+    PostFxDraft, // Effect of the post-FX editor's draft chain
+    Thumbnail    // Browse-list thumbnail; one is compiled at a time
+};
+
+// What a request compiles for. A newer request for the same target supersedes older ones.
+struct CompileTargetKey {
+    CompileTargetKind kind = CompileTargetKind::Scene;
+    int sceneIndex = -1;
+    int effectIndex = -1; // Slot in the scene's post-FX/compute chain, -1 for the scene shader
+
+    bool operator==(const CompileTargetKey& other) const {
+        return kind == other.kind && sceneIndex == other.sceneIndex && effectIndex == other.effectIndex;
+    }
+};
+
+struct AsyncCompileRequest {
+    CompileTargetKey key;
+    std::string source;
+    std::string entryPoint = "main";
+    std::string target;      // Empty compiles a preview pixel shader, otherwise a profile such as cs_6_0
+    std::wstring sourceName = L"shader.hlsl";
+    ShaderCompileMode mode = ShaderCompileMode::Live;
+    std::vector<CompilationTextureBinding> bindings;
+    bool flipFragCoord = false;
+    int priority = 0;        // Workers take the highest priority first, FIFO among equals
+};
+
+struct AsyncCompileResult {
+    CompileTargetKey key;
+    uint64_t generation = 0;
+    std::string source; // The text that was compiled
+    ShaderCompileResult result;
+    double compileMs = 0.0;
+    bool cacheHit = false;
+};
+
+struct AsyncCompileStats {
+    uint64_t submitted = 0;
+    uint64_t compiled = 0;
+    uint64_t coalesced = 0; // Replaced by a newer request before a worker picked it up
+    uint64_t canceled = 0;  // Queued requests dropped by Cancel
+    uint64_t discarded = 0; // Finished after a newer request or a cancel for the same target
+    uint64_t delivered = 0;
+    uint64_t cacheHits = 0; // Served from the bytecode cache without compiling
+};
+
+// Compile front end for the editor. Requests queue for a small worker pool; every worker owns
+// its own ICompilationService, made by the factory on the worker thread. Each Submit gets a
+// new generation: a queued request for the same target is replaced in place, and results of
+// older generations are dropped, so Collect only ever hands back the newest result per target.
+// Results come back in completion order on the thread that calls Collect. With a bytecode cache
+// set, a request whose hash is cached skips the compiler and successful compiles are stored.
+class AsyncCompilationService {
+public:
+    using ServiceFactory = std::function<std::unique_ptr<ICompilationService>()>;
+
+    // workerCount 0 compiles every queued request inline in Collect.
+    AsyncCompilationService(ServiceFactory factory, unsigned workerCount);
+    ~AsyncCompilationService();
+
+    AsyncCompilationService(const AsyncCompilationService&) = delete;
+    AsyncCompilationService& operator=(const AsyncCompilationService&) = delete;
+
+    // Returns the request's generation. Never waits for a compile.
+    uint64_t Submit(AsyncCompileRequest request);
+    void Cancel(const CompileTargetKey& key);
+    void CancelAll();
+    // cache must outlive the service or be reset to null first.
+    void SetBytecodeCache(ShaderBytecodeCache* cache);
+
+    // Appends finished results that are still current and returns how many were added.
+    size_t Collect(std::vector<AsyncCompileResult>& outResults);
+    // Blocks until no request is queued or compiling.
+    void WaitIdle();
+
+    bool IsPending(const CompileTargetKey& key) const;
+    size_t GetPendingCount() const;
+    AsyncCompileStats GetStats() const;
+    unsigned GetWorkerCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+    static unsigned DefaultWorkerCount();
+    // Pool size for whole-project compiles: every core but the one driving the UI.
+    static unsigned BatchWorkerCount();
+
+private:
+    struct Job {
+        AsyncCompileRequest request;
+        uint64_t generation = 0;
+    };
+
+    struct TargetState {
+        uint64_t latest = 0;
+        bool pending = false; // Latest generation not yet delivered
+    };
+
+    struct KeyHash {
+        size_t operator()(const CompileTargetKey& key) const {
+            return (static_cast<size_t>(key.sceneIndex) * 1000003u) ^ (static_cast<size_t>(key.effectIndex) << 8) ^
+                   static_cast<size_t>(key.kind);
+        }
+    };
+
+    void WorkerMain();
+    AsyncCompileResult RunJob(ICompilationService* service, Job& job);
+    Job PopJob();
+    void FinishJob(AsyncCompileResult&& result);
+
+    ServiceFactory m_factory;
+    std::unique_ptr<ICompilationService> m_inlineService;
+    ShaderBytecodeCache* m_cache = nullptr;
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::deque<Job> m_queue;
+    std::vector<AsyncCompileResult> m_completed;
+    std::unordered_map<CompileTargetKey, TargetState, KeyHash> m_targets;
+    uint64_t m_nextGeneration = 0;
+    uint32_t m_busy = 0;
+    bool m_stop = false;
+    AsyncCompileStats m_stats;
+};
+
+} // namespace ShaderLab
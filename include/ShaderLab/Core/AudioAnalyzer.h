@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+
+constexpr uint32_t kMaxAudioBands = 64;
+constexpr uint32_t kAudioShaderBands = 8;
+
+// Lock-free single producer / single consumer ring of mono samples. The producer is the audio
+// callback: pushes never block or allocate, and samples that do not fit are dropped and counted.
+class AudioSampleRing {
+public:
+    explicit AudioSampleRing(size_t capacity = 0); // Rounded up to a power of two
+
+    AudioSampleRing(const AudioSampleRing&) = delete;
+    AudioSampleRing& operator=(const AudioSampleRing&) = delete;
+
+    // Producer. Interleaved frames are averaged down to mono. Returns the samples written.
+    size_t Push(const float* samples, size_t count);
+    size_t PushInterleaved(const float* frames, size_t frameCount, uint32_t channels);
+
+    // Consumer.
+    size_t Pop(float* outSamples, size_t count);
+    size_t GetReadable() const;
+
+    size_t GetCapacity() const { return m_buffer.size(); }
+    uint64_t GetDroppedSamples() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<float> m_buffer;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<uint64_t> m_head{ 0 }; // Written by the producer
+    alignas(64) std::atomic<uint64_t> m_tail{ 0 }; // Written by the consumer
+    alignas(64) std::atomic<uint64_t> m_dropped{ 0 };
+};
+
+// Complex FFT over split real / imaginary arrays: radix-4 passes after one radix-2 pass when
+// log2(size) is odd. Twiddles are laid out per pass so the butterflies vectorize.
+class AudioFft {
+public:
+    bool Initialize(uint32_t size, std::string& outError); // Power of two, >= 4
+    void Forward(float* re, float* im) const;               // In place, unnormalized
+    uint32_t GetSize() const { return m_size; }
+
+private:
+    struct Pass {
+        uint32_t quarter = 0;  // Butterflies per block
+        size_t twiddleOffset = 0;
+    };
+
+    uint32_t m_size = 0;
+    bool m_radix2First = false;
+    std::vector<uint32_t> m_bitReverse;
+    std::vector<Pass> m_passes;
+    std::vector<float> m_twiddles; // Per pass: w1 re/im, w2 re/im, w3 re/im, each `quarter` long
+};
+
+struct AudioAnalyzerConfig {
+    uint32_t sampleRate = 48000;
+    uint32_t fftSize = 1024;
+    uint32_t hopSize = 512;
+    uint32_t bandCount = kAudioShaderBands; // Log spaced between min and max frequency
+    float minFrequency = 40.0f;
+    float maxFrequency = 16000.0f;
+    float floorDb = -70.0f;          // Band level mapped to 0; 0 dBFS maps to 1
+    float onsetSensitivity = 1.6f;   // Spectral flux over this multiple of its running mean
+    float onsetMinFlux = 0.02f;
+    float onsetRelease = 0.15f;      // Seconds for the onset envelope to fall to ~37%
+    size_t ringCapacity = 32768;     // Mono samples
+};
+
+struct AudioAnalysisFrame {
+    uint64_t sequence = 0;           // Hops analyzed so far; 0 = nothing yet
+    double timeSeconds = 0.0;        // Stream time of the newest sample in the window
+    float rms = 0.0f;                // Over the newest hop
+    float peak = 0.0f;
+    float flux = 0.0f;
+    float onset = 0.0f;              // 1 on an onset, then decays
+    bool onsetTriggered = false;
+    uint32_t bandCount = 0;
+    float bands[kMaxAudioBands] = {}; // 0..1, see AudioAnalyzerConfig::floorDb
+};
+
+// Appended to the shader constants block, see ShaderBase::BuildConstantsBlock.
+struct AudioShaderBlock {
+    float rms = 0.0f;
+    float onset = 0.0f;
+    float peak = 0.0f;
+    float bands[kAudioShaderBands] = {};
+};
+
+struct AudioAnalyzerStats {
+    uint64_t hops = 0;
+    uint64_t samples = 0;
+    uint64_t droppedSamples = 0;
+    uint64_t onsets = 0;
+    double analyzeMs = 0.0;
+};
+
+// Turns the sample stream of an audio callback into band levels, RMS and onsets. The callback
+// only pushes into the ring; analysis runs on a worker (Start) or on whoever calls Pump.
+class AudioAnalyzer {
+public:
+    AudioAnalyzer();
+    ~AudioAnalyzer();
+
+    AudioAnalyzer(const AudioAnalyzer&) = delete;
+    AudioAnalyzer& operator=(const AudioAnalyzer&) = delete;
+
+    // Not while a producer is pushing; stops the worker.
+    bool Configure(const AudioAnalyzerConfig& config, std::string& outError);
+    const AudioAnalyzerConfig& GetConfig() const { return m_config; }
+
+    // Real-time safe.
+    void PushInterleaved(const float* frames, size_t frameCount, uint32_t channels) {
+        if (m_ring) {
+            m_ring->PushInterleaved(frames, frameCount, channels);
+        }
+    }
+
+    void Start();
+    void Stop();
+    // Analyzes every full hop in the ring on the calling thread. Only without a running worker.
+    size_t Pump();
+    // Forgets levels and onset history, e.g. after a seek. Samples already queued stay.
+    void Reset();
+
+    bool GetLatest(AudioAnalysisFrame& outFrame) const;
+    AudioShaderBlock GetShaderBlock() const;
+    AudioAnalyzerStats GetStats() const;
+    void GetBandRange(uint32_t band, float& outLowHz, float& outHighHz) const;
+
+private:
+    void WorkerMain();
+    size_t AnalyzeAvailable();
+    void AnalyzeHop();
+
+    AudioAnalyzerConfig m_config;
+    std::unique_ptr<AudioSampleRing> m_ring;
+    AudioFft m_fft;
+
+    // Consumer state, owned by the worker or the Pump caller.
+    std::vector<float> m_window;     // Newest fftSize samples
+    std::vector<float> m_hann;
+    std::vector<float> m_re;
+    std::vector<float> m_im;
+    std::vector<float> m_magnitude;
+    std::vector<float> m_previousMagnitude;
+    std::vector<uint32_t> m_bandFirstBin;
+    std::vector<uint32_t> m_bandLastBin;  // Exclusive
+    uint64_t m_samplesConsumed = 0;
+    float m_fluxMean = 0.0f;
+    float m_onsetEnvelope = 0.0f;
+    uint32_t m_hopsSinceOnset = 0;
+    std::atomic<bool> m_resetPending{ false };
+
+    mutable std::mutex m_mutex;
+    AudioAnalysisFrame m_latest;
+    AudioAnalyzerStats m_stats;
+
+    std::thread m_worker;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+};
+
+} // namespace ShaderLab
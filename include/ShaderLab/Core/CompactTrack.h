@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ShaderLab/Core/TrackData.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace CompactTrack {
+
+    constexpr size_t kTransitionSlotCount = 6;
+
+    // Module mapping carried by v3 ('TKR3') track binaries.
+    struct Metadata {
+        int sceneCount = 0;
+        std::vector<int16_t> sceneModuleIndices;
+        std::vector<std::vector<int16_t>> postFxModuleIndices;
+        std::array<int16_t, kTransitionSlotCount> transitionModuleIndices = { -1, -1, -1, -1, -1, -1 };
+        RenderAspectRatioPreset renderAspectRatioPreset = RenderAspectRatioPreset::Ratio_16_9;
+        FullscreenRenderResolutionPreset fullscreenRenderResolutionPreset = FullscreenRenderResolutionPreset::Full;
+    };
+
+    // Returns the transition preset stem stored in a row's transition slot, or nullptr for "none".
+    const char* TransitionStemForSlot(uint8_t slot);
+
+    FullscreenRenderResolutionPreset FullscreenPresetFromByte(uint8_t value);
+    RenderAspectRatioPreset AspectPresetFromByte(uint8_t value);
+
+    // Decodes a v2 ('TKR2') or v3 ('TKR3') compact track written by BuildPipeline.
+    bool Decode(const std::vector<uint8_t>& bytes, DemoTrack& outTrack, Metadata* outMeta, std::string& outError);
+    bool LoadFromFile(const std::string& path, DemoTrack& outTrack, Metadata* outMeta, std::string& outError);
+
+}
+}
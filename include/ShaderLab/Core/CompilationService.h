@@ -1,6 +1,6 @@
 #pragma once
 
-#include "ShaderLab/Shader/ShaderCompiler.h"
+#include "ShaderLab/Shader/ShaderCompileTypes.h"
 
 #include <string>
 #include <vector>
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+namespace ShaderLab {
+
+// Holds objects the GPU may still reference until the frame that last used them completes.
+// T is typically a ref-counted handle whose destructor does the actual release.
+template <typename T>
+class DeferredReleaseQueue {
+public:
+    void Push(uint64_t lastUsedFrame, T value) {
+        m_pending.push_back({ lastUsedFrame, std::move(value) });
+    }
+
+    // Drops everything last used at or before completedFrameIndex (-1: nothing finished yet).
+    size_t Collect(int64_t completedFrameIndex) {
+        size_t released = 0;
+        while (!m_pending.empty() && completedFrameIndex >= 0 &&
+               m_pending.front().frameIndex <= static_cast<uint64_t>(completedFrameIndex)) {
+            m_pending.pop_front();
+            ++released;
+        }
+        return released;
+    }
+
+    // The caller guarantees the GPU is idle.
+    void Clear() { m_pending.clear(); }
+
+    size_t GetPendingCount() const { return m_pending.size(); }
+
+private:
+    struct Entry {
+        uint64_t frameIndex = 0;
+        T value;
+    };
+
+    std::deque<Entry> m_pending; // Pushed in non-decreasing frame order
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "ShaderLab/Core/PlaybackService.h"
+#include "ShaderLab/Core/TrackData.h"
+
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+// What happens when the playhead reaches DemoTrack::lengthBeats.
+enum class SequencerEndPolicy {
+    Continue,          // Keep running past the end (editor Scene/PostFX modes)
+    Loop,              // Wrap to beat 0 and retrigger rows
+    Stop,              // Stop the transport at the end
+    LoopUnlessStopRow  // Stop if the track has a STOP row, otherwise loop (editor Demo mode)
+};
+
+enum class SequencerCommandType {
+    SceneCut,
+    TransitionBegin,
+    TransitionComplete,
+    MusicChange,
+    OneShot,
+    Stop,
+    Loop
+};
+
+// Side effects the host has to apply for one Advance() call, in trigger order.
+struct SequencerCommand {
+    SequencerCommandType type = SequencerCommandType::SceneCut;
+    int beat = 0;
+    int rowId = 0;
+    int sceneIndex = -1;     // SceneCut/TransitionComplete: new active scene. TransitionBegin: target.
+    int fromSceneIndex = -1; // TransitionBegin only
+    float durationBeats = 0.0f;
+    std::string transitionPresetStem;
+    int musicIndex = -1;
+    int oneShotIndex = -1;
+};
+
+struct SequencerState {
+    static constexpr int kNoPendingScene = -2;
+
+    int activeSceneIndex = -1;
+    float activeSceneOffset = 0.0f; // Offset in beats relative to scene start
+    double activeSceneStartBeat = 0.0;
+
+    bool transitionActive = false;
+    double transitionStartBeat = 0.0;
+    double transitionDurationBeats = 1.0;
+    int transitionFromIndex = -1;
+    int transitionToIndex = -1;
+    double transitionFromStartBeat = 0.0;
+    double transitionToStartBeat = 0.0;
+    float transitionFromOffset = 0.0f;
+    float transitionToOffset = 0.0f;
+    std::string transitionPresetStem;
+    int pendingActiveScene = kNoPendingScene;
+    int transitionJustCompletedBeat = -1;
+};
+
+// GPU-free scene/transition state machine shared by the editor transport, the runtime
+// player and the headless simulator. The host owns the clock: it advances
+// Transport::timeSeconds and then calls Advance() once per frame.
+class DemoSequencer {
+public:
+    void SetEndPolicy(SequencerEndPolicy policy) { m_endPolicy = policy; }
+    SequencerEndPolicy GetEndPolicy() const { return m_endPolicy; }
+
+    // Scene cuts to indices >= sceneCount are ignored. Negative means unchecked.
+    void SetSceneCount(int sceneCount) { m_sceneCount = sceneCount; }
+
+    // When disabled, scene and transition rows are skipped (editor Scene mode).
+    void SetSceneCommandsEnabled(bool enabled) { m_sceneCommandsEnabled = enabled; }
+
+    const SequencerState& GetState() const { return m_state; }
+
+    void Reset();
+    void ResetTransition(bool clearActiveScene);
+    void SetActiveScene(int sceneIndex, float offsetBeats, double startBeat);
+    void BeginTransition(int beat,
+                         double durationBeats,
+                         int targetSceneIndex,
+                         float targetOffset,
+                         double targetStartBeat,
+                         const std::string& transitionPresetStem);
+
+    // Finishes the running transition once exactBeat reaches its end. Returns true if it completed.
+    bool CompleteDueTransition(double exactBeat, int currentBeat);
+
+    // Blend factor [0, 1] of the running transition at exactBeat.
+    float GetTransitionProgress(double exactBeat) const;
+
+    void Advance(DemoTrack& track,
+                 Transport& transport,
+                 const std::vector<AudioClip>& audioLibrary,
+                 std::vector<SequencerCommand>& outCommands);
+
+    // Rebuilds scene/transition state as if the track had played from beat 0 to beat.
+    // Returns the music index that should be playing at that beat, or -1.
+    int Seek(const DemoTrack& track, int beat);
+
+private:
+    bool HasStopRow(const DemoTrack& track) const;
+    void ApplySceneEvent(const DemoTrack& track, const PlaybackEvent& event, std::vector<SequencerCommand>& outCommands);
+
+    PlaybackService m_playback;
+    SequencerState m_state;
+    SequencerEndPolicy m_endPolicy = SequencerEndPolicy::Loop;
+    int m_sceneCount = -1;
+    bool m_sceneCommandsEnabled = true;
+    std::vector<PlaybackEvent> m_events;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "ShaderLab/Core/FrameRingBuffer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderLab {
+
+// Identity of a cached view: the resource pointer plus a hash of the view description.
+struct DescriptorViewKey {
+    uint64_t resource = 0;
+    uint64_t view = 0;
+
+    bool operator==(const DescriptorViewKey& other) const { return resource == other.resource && view == other.view; }
+    bool operator!=(const DescriptorViewKey& other) const { return !(*this == other); }
+};
+
+struct DescriptorViewKeyHash {
+    size_t operator()(const DescriptorViewKey& key) const {
+        return static_cast<size_t>(key.resource * 0x9E3779B97F4A7C15ull ^ key.view);
+    }
+};
+
+// Told when a cache slot is evicted so the backend can drop whatever it keeps for that view.
+class IDescriptorCacheBackend {
+public:
+    virtual ~IDescriptorCacheBackend() = default;
+
+    virtual void ReleaseCachedView(uint32_t slot) = 0;
+};
+
+struct DescriptorFrameCounters {
+    uint64_t viewsWritten = 0;      // Cache misses: views the backend had to create
+    uint64_t cacheHits = 0;
+    uint64_t descriptorsCopied = 0; // Ring slots handed out
+    uint64_t tables = 0;
+};
+
+struct DescriptorRingStats {
+    uint32_t cacheCapacity = 0;
+    uint32_t ringCapacity = 0;
+    DescriptorFrameCounters currentFrame;
+    DescriptorFrameCounters lastFrame;
+    DescriptorFrameCounters total;
+    size_t cachedViews = 0;
+    uint32_t ringUsed = 0;     // Slots still owned by frames the GPU has not finished
+    uint32_t ringPeakUsed = 0;
+    uint64_t ringOverflows = 0;
+    uint64_t cacheOverflows = 0;
+    uint64_t evictions = 0;
+};
+
+// Bookkeeping for one shader-visible descriptor heap used as a per-frame linear ring, plus a
+// cache of views in a CPU-only heap keyed by DescriptorViewKey. Tables are filled by copying
+// cached views into ring slots, so an unchanged binding is never re-created.
+//
+// Ring slots of a frame are reclaimed once the GPU has finished that frame. Cached views are
+// evicted after evictAfterFrames unused frames, and never while a frame still in flight may
+// reference them.
+class DescriptorRingAllocator {
+public:
+    static constexpr uint32_t kInvalidSlot = 0xFFFFFFFFu;
+
+    DescriptorRingAllocator(IDescriptorCacheBackend& backend,
+                            uint32_t cacheCapacity,
+                            uint32_t ringCapacity,
+                            uint32_t evictAfterFrames = 2);
+
+    DescriptorRingAllocator(const DescriptorRingAllocator&) = delete;
+    DescriptorRingAllocator& operator=(const DescriptorRingAllocator&) = delete;
+
+    // completedFrameIndex: newest frame the GPU has finished, or -1 if none.
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+    void EndFrame();
+
+    // Cache slot for key, or kInvalidSlot when every slot is pinned by in-flight frames.
+    // outNeedsWrite is set when the caller has to create the view in the returned slot.
+    uint32_t AcquireView(const DescriptorViewKey& key, bool& outNeedsWrite);
+
+    // First of count contiguous ring slots valid for the current frame, or kInvalidSlot.
+    uint32_t AllocateTable(uint32_t count);
+
+    // Drops every cached view and ring allocation. The caller guarantees the GPU is idle.
+    void Clear();
+
+    const DescriptorRingStats& GetStats() const { return m_stats; }
+
+private:
+    struct CacheEntry {
+        DescriptorViewKey key;
+        uint64_t lastUsedFrame = 0;
+        bool alive = false;
+    };
+
+    void Evict(uint32_t slot);
+    bool IsPinned(const CacheEntry& entry) const;
+
+    IDescriptorCacheBackend& m_backend;
+    uint32_t m_evictAfterFrames = 2;
+
+    std::vector<CacheEntry> m_entries;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<DescriptorViewKey, uint32_t, DescriptorViewKeyHash> m_lookup;
+
+    FrameRingBuffer m_ring;
+
+    uint64_t m_frameIndex = 0;
+    int64_t m_completedFrameIndex = -1;
+    DescriptorRingStats m_stats;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ShaderLab {
+
+struct DynamicResolutionSettings {
+    double targetMs = 16.6;        // GPU frame time to hold
+    float minScale = 0.5f;         // Per-axis scale of the output resolution
+    float maxScale = 1.0f;
+    float step = 0.05f;            // Applied scales are maxScale minus whole steps
+    double kp = 0.3;
+    double ki = 0.015;
+    double kd = 0.05;
+    double smoothing = 0.2;        // EMA weight of a new measurement
+    double upscaleHeadroom = 0.05; // Growing must leave this fraction of the budget unused
+    uint32_t holdFrames = 20;      // Frames between applied changes; covers the timestamp latency
+    uint32_t growHoldFrames = 240; // Frames after a decrease before the scale may grow again
+    uint32_t alignment = 8;        // Width alignment of ComputeSize
+};
+
+struct DynamicResolutionStats {
+    uint64_t frames = 0;
+    uint64_t increases = 0;
+    uint64_t decreases = 0;
+    uint64_t reversals = 0; // Changes against the direction of the previous one
+};
+
+// PID on measured GPU frame time. The controller integrates a continuous desired scale; the
+// applied scale only moves in quantized steps once the desired one is a full step away and
+// holdFrames have passed, so noise around the budget does not pump the resolution. Every applied
+// change reallocates the render targets, so growing back after a decrease waits growHoldFrames.
+class DynamicResolutionController {
+public:
+    explicit DynamicResolutionController(const DynamicResolutionSettings& settings = DynamicResolutionSettings());
+
+    void SetSettings(const DynamicResolutionSettings& settings);
+    const DynamicResolutionSettings& GetSettings() const { return m_settings; }
+    void SetScaleRange(float minScale, float maxScale);
+    void Reset();
+
+    // Feeds the GPU time of one completed frame. Returns true when the applied scale changed.
+    bool Update(double gpuFrameMs);
+
+    float GetScale() const { return m_scale; }
+    double GetDesiredScale() const { return m_desired; }
+    double GetFilteredMs() const { return m_filteredMs; }
+    const DynamicResolutionStats& GetStats() const { return m_stats; }
+
+    // Render size for an output of maxWidth x maxHeight: width aligned, height from the output aspect.
+    void ComputeSize(uint32_t maxWidth, uint32_t maxHeight, uint32_t& outWidth, uint32_t& outHeight) const;
+
+private:
+    float Quantize(double scale) const;
+
+    DynamicResolutionSettings m_settings;
+    DynamicResolutionStats m_stats;
+    float m_scale = 1.0f;
+    double m_desired = 1.0;
+    double m_filteredMs = 0.0;
+    double m_error = 0.0;
+    double m_previousError = 0.0;
+    bool m_hasSample = false;
+    uint32_t m_framesSinceChange = 0;
+    int m_lastDirection = 0;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ShaderLab {
+
+// The GPU timeline a FrameContextRing submits against. Values are monotonic.
+class IFrameFence {
+public:
+    virtual ~IFrameFence() = default;
+
+    virtual uint64_t GetCompletedValue() = 0;
+    virtual void WaitForValue(uint64_t value) = 0;
+};
+
+struct FrameContextStats {
+    uint64_t framesBegun = 0;
+    uint64_t waits = 0;          // BeginFrame calls that had to block on the fence
+    uint32_t peakFramesInFlight = 0;
+};
+
+// Fence bookkeeping for N rotating frame contexts (command allocator, upload memory, ...).
+// Frame f records into context f % N; BeginFrame blocks only when that context's previous
+// submission is still on the GPU, so up to N frames can be in flight.
+class FrameContextRing {
+public:
+    explicit FrameContextRing(uint32_t contextCount = 2);
+
+    // Waits until the next context is free and returns its index.
+    uint32_t BeginFrame(IFrameFence& fence);
+    // Records the fence value signalled after the current frame's submission.
+    void EndFrame(uint64_t fenceValue);
+    // Polls the fence and advances the completed frame index.
+    void UpdateCompleted(IFrameFence& fence);
+
+    uint64_t GetFrameIndex() const { return m_frameIndex; }                     // Frame being recorded
+    int64_t GetCompletedFrameIndex() const { return m_completedFrameIndex; }    // -1 until one finishes
+    uint32_t GetContextIndex() const { return m_contextIndex; }
+    uint32_t GetContextCount() const { return static_cast<uint32_t>(m_contexts.size()); }
+    uint32_t GetFramesInFlight() const;
+    const FrameContextStats& GetStats() const { return m_stats; }
+
+private:
+    struct Context {
+        uint64_t fenceValue = 0; // 0: never submitted
+        uint64_t frameIndex = 0;
+    };
+
+    std::vector<Context> m_contexts;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_nextFrameIndex = 0;
+    int64_t m_completedFrameIndex = -1;
+    uint32_t m_contextIndex = 0;
+    FrameContextStats m_stats;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderLab {
+
+enum class ProfileTrack : uint8_t {
+    Cpu = 0,
+    Gpu = 1,
+};
+
+constexpr uint32_t kProfileTrackCount = 2;
+
+// One closed scope. Times are microseconds; CPU scopes use the profiler clock, GPU scopes are
+// placed at their frame's CPU start (the two clocks are not correlated).
+struct ProfileEvent {
+    uint32_t name = 0;      // FrameProfiler::GetName
+    uint32_t stat = 0;      // Index into GetStats()
+    uint32_t depth = 0;
+    double startUs = 0.0;
+    double durationUs = 0.0;
+};
+
+struct ProfileFrame {
+    uint64_t frameIndex = 0;
+    double cpuStartUs = 0.0;
+    double cpuDurationUs = 0.0;
+    std::vector<ProfileEvent> events[kProfileTrackCount];
+};
+
+// Rolling statistics of one scope path (e.g. "frame/scene 2/post-fx") over the last window frames.
+// Repeated scopes with the same path in one frame are summed.
+struct ProfileScopeStats {
+    uint32_t name = 0;
+    uint32_t parent = 0xFFFFFFFFu;
+    uint32_t depth = 0;
+    ProfileTrack track = ProfileTrack::Cpu;
+    double lastMs = 0.0;
+    double avgMs = 0.0;
+    double p95Ms = 0.0;
+    double maxMs = 0.0;
+    uint32_t samples = 0;
+};
+
+// A bar of the flame view: x in [0, 1] of the frame's span on its track, row = scope depth.
+struct ProfileFlameBar {
+    uint32_t name = 0;
+    uint32_t stat = 0;
+    uint32_t depth = 0;
+    float x0 = 0.0f;
+    float x1 = 0.0f;
+    double durationMs = 0.0;
+};
+
+struct FrameProfilerCounters {
+    uint64_t framesCompleted = 0;
+    uint64_t gpuFramesResolved = 0;
+    uint64_t gpuFramesDropped = 0;  // Slot reused before its timestamps were read back
+    uint64_t gpuScopesDropped = 0;  // Query budget of a frame exceeded
+    uint64_t unbalancedScopes = 0;
+};
+
+// Backend-independent hierarchical frame profiler. CPU scopes are timed with the profiler
+// clock. GPU scopes only hand out timestamp query indices: the backend writes the queries,
+// resolves each frame's range into a readback ring and feeds the ticks back through
+// ResolveGpuFrame once the GPU has finished that frame, frameSlots frames later at most.
+class FrameProfiler {
+public:
+    static constexpr uint32_t kInvalidQuery = 0xFFFFFFFFu;
+    static constexpr uint32_t kNoParent = 0xFFFFFFFFu;
+
+    explicit FrameProfiler(uint32_t frameSlots = 3, uint32_t queriesPerFrame = 256, uint32_t statWindow = 120);
+
+    // Microseconds; defaults to a steady clock. Tests install a fake one.
+    void SetClock(std::function<double()> clock);
+    double Now() const;
+
+    void BeginFrame(uint64_t frameIndex);
+    void EndFrame();
+
+    void BeginCpuScope(const char* name);
+    void EndCpuScope();
+
+    // Query index to write the begin/end timestamp to, or kInvalidQuery to skip the query.
+    uint32_t BeginGpuScope(const char* name);
+    uint32_t EndGpuScope();
+    // Query range the current frame wrote, for the backend's resolve.
+    uint32_t GetGpuQueryFirst() const;
+    uint32_t GetGpuQueryCount() const;
+    uint32_t GetQueryCapacity() const { return m_frameSlots * m_queriesPerFrame; }
+    uint32_t GetFrameSlots() const { return m_frameSlots; }
+
+    // Oldest frame the GPU has finished whose timestamps still wait for ResolveGpuFrame.
+    bool GetPendingGpuFrame(int64_t completedFrameIndex, uint64_t& outFrameIndex, uint32_t& outQueryFirst, uint32_t& outQueryCount) const;
+    // ticks[i] is the timestamp of query outQueryFirst + i from GetPendingGpuFrame.
+    void ResolveGpuFrame(uint64_t frameIndex, const uint64_t* ticks, uint64_t ticksPerSecond);
+
+    // Records every frame completed from now on, up to frameCount, for ExportChromeTrace.
+    void BeginCapture(uint32_t frameCount);
+    bool IsCapturing() const { return m_captureRemaining > 0; }
+    uint32_t GetCapturedFrameCount() const { return static_cast<uint32_t>(m_capture.size()); }
+    std::string ExportChromeTrace() const;
+    bool WriteChromeTrace(const std::string& path, std::string& outError) const;
+
+    const std::string& GetName(uint32_t name) const { return m_names[name]; }
+    const std::vector<ProfileScopeStats>& GetStats() const { return m_stats; }
+    // Newest frame whose CPU and GPU scopes are both complete.
+    const ProfileFrame* GetLastFrame() const { return m_hasLastFrame ? &m_lastFrame : nullptr; }
+    void BuildFlame(ProfileTrack track, std::vector<ProfileFlameBar>& outBars) const;
+    const FrameProfilerCounters& GetCounters() const { return m_counters; }
+
+private:
+    struct GpuScope {
+        uint32_t name = 0;
+        uint32_t parent = kNoParent;
+        uint32_t depth = 0;
+        uint32_t beginQuery = kInvalidQuery;
+        uint32_t endQuery = kInvalidQuery;
+    };
+
+    struct GpuSlot {
+        bool pending = false;
+        uint64_t frameIndex = 0;
+        uint32_t queryCount = 0;
+        std::vector<GpuScope> scopes;
+        ProfileFrame frame;  // CPU half, completed when the GPU half resolves
+    };
+
+    struct StatKey {
+        uint32_t parent = kNoParent;
+        uint32_t name = 0;
+        ProfileTrack track = ProfileTrack::Cpu;
+
+        bool operator==(const StatKey& other) const {
+            return parent == other.parent && name == other.name && track == other.track;
+        }
+    };
+
+    struct StatKeyHash {
+        size_t operator()(const StatKey& key) const {
+            return (static_cast<size_t>(key.parent) * 1000003u) ^ (static_cast<size_t>(key.name) << 1) ^ static_cast<size_t>(key.track);
+        }
+    };
+
+    struct StatWindow {
+        std::vector<double> samples;
+        uint32_t next = 0;
+        double frameMs = 0.0;
+        bool touched = false;
+    };
+
+    uint32_t InternName(const char* name);
+    uint32_t FindStat(ProfileTrack track, uint32_t parentStat, uint32_t name, uint32_t depth);
+    void AccumulateStats(const std::vector<ProfileEvent>& events);
+    void FlushStats();
+    void CompleteFrame(ProfileFrame&& frame);
+
+    uint32_t m_frameSlots;
+    uint32_t m_queriesPerFrame;
+    uint32_t m_statWindow;
+    std::function<double()> m_clock;
+
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, uint32_t> m_nameLookup;
+    std::vector<ProfileScopeStats> m_stats;
+    std::vector<StatWindow> m_windows;
+    std::unordered_map<StatKey, uint32_t, StatKeyHash> m_statLookup;
+    std::vector<uint32_t> m_touchedStats;
+    std::vector<double> m_statScratch;
+
+    bool m_inFrame = false;
+    ProfileFrame m_frame;
+    size_t m_cpuEventReserve = 0;
+    std::vector<uint32_t> m_cpuStack;     // Open CPU events
+    std::vector<uint32_t> m_cpuStatStack; // Their stats
+    uint32_t m_gpuSlot = 0;
+    std::vector<uint32_t> m_gpuStack;     // Open GPU scopes in the current slot
+    std::vector<GpuSlot> m_slots;
+
+    ProfileFrame m_lastFrame;
+    bool m_hasLastFrame = false;
+    std::vector<ProfileFrame> m_capture;
+    uint32_t m_captureRemaining = 0;
+    FrameProfilerCounters m_counters;
+};
+
+// Closes its CPU scope on destruction. profiler may be null.
+class ScopedCpuProfile {
+public:
+    ScopedCpuProfile(FrameProfiler* profiler, const char* name) : m_profiler(profiler) {
+        if (m_profiler) m_profiler->BeginCpuScope(name);
+    }
+    ~ScopedCpuProfile() {
+        if (m_profiler) m_profiler->EndCpuScope();
+    }
+
+    ScopedCpuProfile(const ScopedCpuProfile&) = delete;
+    ScopedCpuProfile& operator=(const ScopedCpuProfile&) = delete;
+
+private:
+    FrameProfiler* m_profiler;
+};
+
+} // namespace ShaderLab
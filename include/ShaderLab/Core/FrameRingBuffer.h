@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+namespace ShaderLab {
+
+// Linear per-frame suballocator over a fixed range (descriptor slots, upload bytes). Space
+// handed out during a frame is reclaimed once the GPU has finished that frame. Allocations
+// are contiguous, so one that would straddle the end skips the tail and wraps to zero.
+class FrameRingBuffer {
+public:
+    static constexpr uint64_t kInvalidOffset = ~0ull;
+
+    explicit FrameRingBuffer(uint64_t capacity = 0) : m_capacity(capacity) {}
+
+    void Reset(uint64_t capacity);
+
+    // completedFrameIndex: newest frame the GPU has finished, or -1 if none.
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+    void EndFrame();
+
+    // alignment must be a power of two (or 0/1 for none).
+    uint64_t Allocate(uint64_t size, uint64_t alignment = 1);
+
+    // Drops every allocation. The caller guarantees the GPU is idle.
+    void Clear();
+
+    uint64_t GetCapacity() const { return m_capacity; }
+    uint64_t GetUsed() const { return m_used; } // Including space still owned by in-flight frames
+    uint64_t GetPeakUsed() const { return m_peakUsed; }
+    uint64_t GetOverflowCount() const { return m_overflows; }
+
+private:
+    struct FrameSpan {
+        uint64_t frameIndex = 0;
+        uint64_t size = 0; // Including padding and skipped tail space
+    };
+
+    uint64_t m_capacity = 0;
+    uint64_t m_head = 0;
+    uint64_t m_used = 0;
+    uint64_t m_frameUsed = 0;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_peakUsed = 0;
+    uint64_t m_overflows = 0;
+    std::deque<FrameSpan> m_inFlight;
+};
+
+} // namespace ShaderLab
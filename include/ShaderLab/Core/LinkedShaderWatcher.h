@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ShaderLab/Core/AsyncCompilationService.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+class AssetCatalog;
+
+// A scene, post-FX or compute shader whose code comes from a file.
+struct LinkedShaderLink {
+    CompileTargetKey key;
+    std::string path; // Resolved path of the linked file
+
+    bool operator==(const LinkedShaderLink& other) const {
+        return key == other.key && path == other.path;
+    }
+};
+
+struct LinkedShaderChange {
+    CompileTargetKey key;
+    std::string path;
+    std::shared_ptr<const std::string> code;
+    uint64_t previousHash = 0; // Content the link had on disk before this change
+    uint64_t hash = 0;
+};
+
+struct LinkedShaderWatcherStats {
+    uint64_t changes = 0;        // Reported by Poll
+    uint64_t touches = 0;        // New write time, same content
+    uint64_t coalesced = 0;      // Writes folded into a change that was still settling
+};
+
+// FNV-1a of the text, as stored in LinkedShaderChange.
+uint64_t HashShaderText(const std::string& text);
+
+// Watches the files that scenes and effects are linked to through the shared AssetCatalog, one
+// collection per folder. Content is read and hashed on the catalog worker; a file is reported
+// once it has kept the same new content for the debounce window, and a write that leaves the
+// content unchanged is ignored. Poll takes the clock from the caller, so the debounce can be
+// driven without waiting in real time.
+class LinkedShaderWatcher {
+public:
+    explicit LinkedShaderWatcher(AssetCatalog& catalog, double debounceMs = 150.0);
+
+    // Replaces the watched links. Links that stay keep their known content.
+    void SetLinks(const std::vector<LinkedShaderLink>& links);
+    const std::vector<LinkedShaderLink>& GetLinks() const { return m_links; }
+
+    // Appends the links whose file settled on new content; returns how many were added.
+    size_t Poll(double nowMs, std::vector<LinkedShaderChange>& outChanges);
+
+    LinkedShaderWatcherStats GetStats() const { return m_stats; }
+
+private:
+    struct LinkState {
+        int folder = -1;
+        std::string fileName;
+        uint64_t seenGeneration = 0;
+        std::shared_ptr<const std::string> seenContent;
+        bool known = false;         // The first scan sets the baseline without reporting it
+        uint64_t hash = 0;
+        bool pending = false;
+        double dueMs = 0.0;
+        uint64_t pendingHash = 0;
+        std::shared_ptr<const std::string> pendingCode;
+    };
+    struct Folder {
+        std::string path;
+        int collection = -1;
+        uint64_t seenGeneration = 0;
+    };
+
+    AssetCatalog& m_catalog;
+    double m_debounceMs = 150.0;
+    std::vector<LinkedShaderLink> m_links;
+    std::vector<LinkState> m_states;
+    std::vector<Folder> m_folders;      // Folders without a path are idle collections kept for reuse
+    LinkedShaderWatcherStats m_stats;
+};
+
+} // namespace ShaderLab
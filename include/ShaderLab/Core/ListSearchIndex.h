@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderLab {
+
+// Case-insensitive substring filter for browse lists (scenes, presets, snippets). Each item
+// keeps its display text and a lowercased search key that are only rebuilt when the text
+// changes; the trigram postings catch up on the next query that needs them. Queries of three or
+// more characters start from the rarest trigram's posting list, and a query that extends the
+// previous one only re-checks the previous matches.
+class ListSearchIndex {
+public:
+    // Drops items at and past `count`.
+    void Resize(size_t count);
+    size_t GetCount() const { return m_items.size(); }
+    // Re-keys the item only when `text` differs from what it holds. Returns true if it did.
+    bool SetItem(size_t index, const std::string& text);
+    const std::string& GetText(size_t index) const { return m_items[index].text; }
+    void Clear();
+
+    // Indices of the items whose text contains `needle`, ascending. Every item when it is empty.
+    // The result stays valid until the next call.
+    const std::vector<int>& Query(const std::string& needle);
+
+    // Bumped whenever an item is added, removed or re-keyed.
+    uint64_t GetRevision() const { return m_revision; }
+    size_t GetTrigramCount() const { return m_postings.size(); }
+
+private:
+    struct Item {
+        std::string text;
+        std::string key;
+        std::vector<uint32_t> trigrams; // Unique, sorted; what the postings hold for this item
+        bool stale = false;
+    };
+
+    // Brings the postings up to date with the re-keyed items.
+    void FlushStale();
+    void UnindexItem(int index);
+    bool KeyContains(int index, const std::string& needle) const;
+
+    std::vector<Item> m_items;
+    std::unordered_map<uint32_t, std::vector<int>> m_postings; // Trigram -> item indices, ascending
+    std::vector<int> m_stale;
+    uint64_t m_revision = 0;
+
+    std::string m_lastNeedle;
+    uint64_t m_lastRevision = ~0ull;
+    std::vector<int> m_results;
+};
+
+// ASCII lowercase copy; the search keys and queries go through this.
+std::string ToSearchKey(const std::string& text);
+
+} // namespace ShaderLab
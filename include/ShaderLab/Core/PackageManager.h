@@ -4,6 +4,7 @@
 #include <vector>
 #if !SHADERLAB_TINY_PLAYER
 #include <map>
+#include <mutex>
 #endif
 #include <cstdint>
 
@@ -15,6 +16,16 @@ struct PackedEntry {
     uint64_t size;
 };
 
+#if !SHADERLAB_TINY_PLAYER
+// Read-only bytes of a packed file. Stored entries point straight into the mapped executable;
+// compressed ones are expanded into storage.
+struct PackedFileView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> storage;
+};
+#endif
+
 class PackageManager {
 public:
     static PackageManager& Get();
@@ -25,9 +36,19 @@ public:
     // Returns empty vector if not found or error
     std::vector<uint8_t> GetFile(const std::string& path);
     bool HasFile(const std::string& path) const;
+#if !SHADERLAB_TINY_PLAYER
+    // Avoids the copy GetFile() makes; the executable is mapped on first use and stays mapped
+    // until ReleaseFileViews(). Safe to call from loader threads.
+    bool GetFileView(const std::string& path, PackedFileView& outView);
+    // Unmaps the executable. Views handed out before must no longer be in use.
+    void ReleaseFileViews();
+#endif
 
 private:
     PackageManager() = default;
+#if !SHADERLAB_TINY_PLAYER
+    bool MapExecutable();
+#endif
 
     bool m_initialized = false;
     bool m_isPacked = false;
@@ -37,6 +58,10 @@ private:
     std::vector<PackedEntry> m_directory;
 #else
     std::map<std::string, PackedEntry> m_directory;
+    std::mutex m_mappingMutex; // Guards the mapping below
+    void* m_mapping = nullptr;
+    const uint8_t* m_mappedBase = nullptr;
+    uint64_t m_mappedSize = 0;
 #endif
 };
 
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ShaderLab {
+
+// Immutable vector stored as a table of shared fixed-size chunks. Copies share everything;
+// a modified copy only owns the chunks that changed plus a new table, so keeping many
+// versions costs about one chunk per edit. Chunks are by index: inserting in the middle
+// reallocates every chunk after the insertion point.
+template <typename T, size_t ChunkSize>
+class PersistentVector {
+public:
+    using Chunk = std::vector<T>;
+    using ChunkPtr = std::shared_ptr<const Chunk>;
+    using Table = std::vector<ChunkPtr>;
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    const T& operator[](size_t index) const { return (*(*m_table)[index / ChunkSize])[index % ChunkSize]; }
+
+    std::vector<T> ToVector() const {
+        std::vector<T> values;
+        values.reserve(m_size);
+        if (m_table) {
+            for (const ChunkPtr& chunk : *m_table) {
+                values.insert(values.end(), chunk->begin(), chunk->end());
+            }
+        }
+        return values;
+    }
+
+    // Builds a vector of count elements from a mutable source. keep(i, element) says whether
+    // element i of previous still matches the source; make(i, previousElementOrNull) creates
+    // the new element otherwise. Unchanged chunks, and the table when nothing changed, are
+    // shared with previous.
+    template <typename Keep, typename Make>
+    static PersistentVector Rebuild(const PersistentVector& previous, size_t count, Keep keep, Make make) {
+        const Table* previousTable = previous.m_table.get();
+        auto table = std::make_shared<Table>();
+        table->reserve((count + ChunkSize - 1) / ChunkSize);
+        bool allShared = previous.m_size == count;
+        for (size_t begin = 0; begin < count; begin += ChunkSize) {
+            const size_t length = (std::min)(ChunkSize, count - begin);
+            const size_t chunkIndex = begin / ChunkSize;
+            const ChunkPtr* previousChunk =
+                previousTable && chunkIndex < previousTable->size() ? &(*previousTable)[chunkIndex] : nullptr;
+            const size_t previousLength = previousChunk ? (*previousChunk)->size() : 0;
+
+            size_t kept = 0;
+            while (kept < length && kept < previousLength && keep(begin + kept, (**previousChunk)[kept])) {
+                ++kept;
+            }
+            if (kept == length && previousLength == length) {
+                table->push_back(*previousChunk);
+                continue;
+            }
+
+            allShared = false;
+            auto chunk = std::make_shared<Chunk>();
+            chunk->reserve(length);
+            for (size_t i = 0; i < length; ++i) {
+                const T* previousElement = i < previousLength ? &(**previousChunk)[i] : nullptr;
+                if (i < kept || (i > kept && previousElement && keep(begin + i, *previousElement))) {
+                    chunk->push_back(*previousElement);
+                } else {
+                    chunk->push_back(make(begin + i, previousElement));
+                }
+            }
+            table->push_back(std::move(chunk));
+        }
+        if (allShared && previous.m_table) {
+            return previous;
+        }
+        PersistentVector result;
+        result.m_table = std::move(table);
+        result.m_size = count;
+        return result;
+    }
+
+    // For memory accounting; null when empty and never built.
+    const Table* GetTable() const { return m_table.get(); }
+    bool SharesTableWith(const PersistentVector& other) const { return m_table == other.m_table; }
+
+private:
+    std::shared_ptr<const Table> m_table;
+    size_t m_size = 0;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+
+enum class PipelineKind : uint8_t {
+    ScenePixel,
+    PostFxPixel,
+    Compute
+};
+
+struct PipelineLoadJob {
+    PipelineKind kind = PipelineKind::ScenePixel;
+    int sceneIndex = -1;
+    int effectIndex = -1;    // Post-FX/compute slot within the scene, -1 for the scene shader
+    std::string bytecodeKey; // Jobs with the same non-empty key share one LoadBytecode call
+};
+
+enum class PipelineLoadState : uint8_t {
+    Pending,
+    Ready,
+    Failed
+};
+
+// Backend hook for PipelineLoadScheduler. Both calls run on worker threads and must be
+// thread-safe; CreatePipeline is called at most once per job index, so per-job result
+// slots need no locking.
+class IPipelineFactory {
+public:
+    virtual ~IPipelineFactory() = default;
+
+    // Read (and decompress or compile) the bytecode for job. Called once per load group.
+    virtual bool LoadBytecode(const PipelineLoadJob& job, std::vector<uint8_t>& outBytecode) = 0;
+    virtual bool CreatePipeline(size_t jobIndex, const PipelineLoadJob& job, const std::vector<uint8_t>& bytecode) = 0;
+};
+
+struct PipelineLoadStats {
+    size_t jobCount = 0;
+    size_t loadCount = 0; // Unique bytecode loads after key de-duplication
+    size_t failedCount = 0;
+    unsigned workerCount = 0;
+    double loadMs = 0.0;   // Summed over workers
+    double createMs = 0.0; // Summed over workers
+    double wallMs = 0.0;
+};
+
+// Loads bytecode and creates pipelines for a fixed job list on a small worker pool.
+// Load tasks are queued in job order; each finished load queues its dependent pipeline
+// creations ahead of the remaining loads so bytecode is released early. The owning thread
+// only polls for completion.
+class PipelineLoadScheduler {
+public:
+    PipelineLoadScheduler() = default;
+    ~PipelineLoadScheduler();
+
+    PipelineLoadScheduler(const PipelineLoadScheduler&) = delete;
+    PipelineLoadScheduler& operator=(const PipelineLoadScheduler&) = delete;
+
+    // workerCount 0 runs every job inline on the first Poll().
+    void Start(std::vector<PipelineLoadJob> jobs, IPipelineFactory& factory, unsigned workerCount);
+
+    // Returns true once every job finished (workers are joined at that point).
+    bool Poll();
+    void Wait();
+    void Cancel();
+
+    bool IsStarted() const { return m_factory != nullptr; }
+    size_t GetJobCount() const { return m_jobs.size(); }
+    size_t GetFinishedCount() const { return m_finishedCount.load(std::memory_order_acquire); }
+    const PipelineLoadJob& GetJob(size_t index) const { return m_jobs[index]; }
+    PipelineLoadState GetJobState(size_t index) const;
+    const PipelineLoadStats& GetStats() const { return m_stats; }
+
+    static unsigned DefaultWorkerCount();
+
+private:
+    struct LoadGroup {
+        std::vector<size_t> jobs;
+    };
+
+    struct Task {
+        bool isLoad = true;
+        size_t index = 0; // Group index for loads, job index for creates
+        std::shared_ptr<const std::vector<uint8_t>> bytecode;
+    };
+
+    void BuildGroups();
+    void WorkerMain();
+    void RunTask(Task& task);
+    void FinishJob(size_t jobIndex, bool ok);
+    void JoinWorkers();
+
+    std::vector<PipelineLoadJob> m_jobs;
+    std::vector<LoadGroup> m_groups;
+    std::unique_ptr<std::atomic<uint8_t>[]> m_jobStates;
+    IPipelineFactory* m_factory = nullptr;
+
+    std::vector<std::thread> m_workers;
+    std::deque<Task> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stop = false;
+    bool m_inline = false;
+    std::atomic<size_t> m_finishedCount{0};
+    std::atomic<int64_t> m_loadNs{0};
+    std::atomic<int64_t> m_createNs{0};
+    int64_t m_startNs = 0;
+    bool m_completed = false;
+    PipelineLoadStats m_stats;
+};
+
+} // namespace ShaderLab
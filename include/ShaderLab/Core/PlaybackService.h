@@ -1,7 +1,8 @@
 #pragma once
 
-#include "ShaderLab/Core/ShaderLabData.h"
+#include "ShaderLab/Core/TrackData.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "ShaderLab/Core/AsyncCompilationService.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace ShaderLab {
+
+// Tracks one whole-project compile fanned out through AsyncCompilationService. A target counts
+// as done once the service no longer has it pending: delivered, superseded by a newer edit
+// that was delivered, or canceled.
+class ProjectCompileBatch {
+public:
+    // Submits every request, highest priority first, so no lower-priority target of the batch is
+    // already on a worker when the top one is queued. Jobs submitted before Start may still be.
+    void Start(AsyncCompilationService& service, std::vector<AsyncCompileRequest> requests);
+    // Returns true on the call that completes the batch.
+    bool Update(const AsyncCompilationService& service);
+    void Reset();
+
+    bool IsActive() const { return !m_remaining.empty(); }
+    size_t GetTotal() const { return m_total; }
+    size_t GetCompleted() const { return m_total - m_remaining.size(); }
+    float GetProgress() const { return m_total == 0 ? 1.0f : static_cast<float>(GetCompleted()) / static_cast<float>(m_total); }
+    // Wall time from Start to completion, or so far while active.
+    double GetElapsedMs() const;
+
+private:
+    std::vector<CompileTargetKey> m_remaining;
+    size_t m_total = 0;
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_end;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "ShaderLab/Core/PersistentVector.h"
+#include "ShaderLab/Core/TrackData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Immutable, structurally shared project model for undo history and restarts. Only document
+// data lives here; GPU objects stay on the editor's working copy of the scenes.
+
+namespace ShaderLab {
+
+struct BindingDoc {
+    int channelIndex = 0;
+    bool enabled = false;
+    BindingType bindingType = BindingType::Scene;
+    int sourceSceneIndex = -1;
+    std::string filePath;
+    TextureType type = TextureType::Texture2D;
+
+    bool operator==(const BindingDoc& other) const;
+};
+
+struct PostFxDoc {
+    std::string name;
+    std::shared_ptr<const std::string> shaderCode;
+    std::string shaderCodePath;
+    std::string precompiledPath;
+    bool enabled = true;
+};
+
+struct ComputeDoc {
+    std::string name;
+    std::shared_ptr<const std::string> shaderCode;
+    std::string shaderCodePath;
+    std::string precompiledPath;
+    std::string entryPoint = "main";
+    int type = 0; // Scene::ComputeEffect::Type
+    bool enabled = true;
+    float params[4] = {};
+    uint32_t threadGroup[3] = { 8, 8, 1 };
+    int historyCount = 0;
+};
+
+struct SceneDoc {
+    uint64_t sceneId = 0; // Scene::id of the scene this was captured from
+    std::string name;
+    std::string description;
+    std::shared_ptr<const std::string> shaderCode;
+    std::string shaderCodePath;
+    std::string precompiledPath;
+    TextureType outputType = TextureType::Texture2D;
+    std::shared_ptr<const std::vector<BindingDoc>> bindings;
+    std::shared_ptr<const std::vector<PostFxDoc>> postFxChain;
+    std::shared_ptr<const std::vector<ComputeDoc>> computeChain;
+};
+
+struct ProjectSettingsDoc {
+    std::string trackName;
+    float trackBpm = 120.0f;
+    int trackLengthBeats = 128;
+    float transportBpm = 140.0f;
+    RenderAspectRatioPreset renderAspectRatioPreset = RenderAspectRatioPreset::Ratio_16_9;
+    FullscreenRenderResolutionPreset fullscreenRenderResolutionPreset = FullscreenRenderResolutionPreset::Full;
+    std::string demoTitle;
+    std::string demoAuthor;
+    std::string demoDescription;
+
+    bool operator==(const ProjectSettingsDoc& other) const;
+};
+
+using SceneNode = std::shared_ptr<const SceneDoc>;
+constexpr size_t kSnapshotSceneChunk = 16;
+constexpr size_t kSnapshotRowChunk = 64;
+
+struct ProjectSnapshot {
+    PersistentVector<SceneNode, kSnapshotSceneChunk> scenes;
+    PersistentVector<TrackerRow, kSnapshotRowChunk> trackRows;
+    std::shared_ptr<const std::vector<AudioClip>> audioLibrary;
+    std::shared_ptr<const ProjectSettingsDoc> settings;
+
+    // True when every top-level part is shared, i.e. nothing changed between the two.
+    bool SharesAllWith(const ProjectSnapshot& other) const;
+};
+
+// Text shared with previous when equal, copied otherwise. Comparing is cheap next to
+// allocating, so unchanged shader code never gets a second copy.
+std::shared_ptr<const std::string> ShareText(const std::shared_ptr<const std::string>& previous, const std::string& text);
+std::shared_ptr<const std::vector<AudioClip>> ShareAudioLibrary(const std::shared_ptr<const std::vector<AudioClip>>& previous,
+                                                                 const std::vector<AudioClip>& clips);
+std::shared_ptr<const ProjectSettingsDoc> ShareSettings(const std::shared_ptr<const ProjectSettingsDoc>& previous,
+                                                        const ProjectSettingsDoc& settings);
+PersistentVector<TrackerRow, kSnapshotRowChunk> ShareTrackRows(const PersistentVector<TrackerRow, kSnapshotRowChunk>& previous,
+                                                               const TrackerRowStore& rows);
+bool TrackerRowsEqual(const TrackerRow& a, const TrackerRow& b);
+
+// Bytes owned by a set of snapshots, counting every shared node once.
+size_t MeasureSnapshotBytes(const std::vector<const ProjectSnapshot*>& snapshots);
+
+// Linear undo history of snapshots. Push drops the redo tail; the oldest level goes once
+// maxLevels is exceeded.
+class ProjectHistory {
+public:
+    explicit ProjectHistory(size_t maxLevels = 256);
+
+    // Returns false (and stores nothing) when snapshot shares everything with the current level.
+    bool Push(ProjectSnapshot snapshot);
+    const ProjectSnapshot* Current() const;
+    const ProjectSnapshot* Undo();
+    const ProjectSnapshot* Redo();
+    bool CanUndo() const { return m_current > 0; }
+    bool CanRedo() const { return m_current + 1 < m_levels.size(); }
+    void Clear();
+
+    size_t GetLevelCount() const { return m_levels.size(); }
+    size_t GetMaxLevels() const { return m_maxLevels; }
+    size_t MeasureBytes() const;
+
+private:
+    std::deque<ProjectSnapshot> m_levels;
+    size_t m_current = 0;
+    size_t m_maxLevels;
+};
+
+} // namespace ShaderLab
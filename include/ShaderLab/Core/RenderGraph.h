@@ -0,0 +1,128 @@
+#pragma once
+
+#include "ShaderLab/Core/TransientTargetPool.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+// How a pass touches a texture. Read-only bits may be combined into one resource state.
+enum RenderGraphAccess : uint32_t {
+    RenderGraphAccessNone = 0,
+    RenderGraphAccessPixelRead = 1u << 0,
+    RenderGraphAccessComputeRead = 1u << 1,
+    RenderGraphAccessCopySource = 1u << 2,
+    RenderGraphAccessRenderTarget = 1u << 3,
+    RenderGraphAccessUnorderedAccess = 1u << 4,
+    RenderGraphAccessCopyDest = 1u << 5,
+    RenderGraphAccessPresent = 1u << 6,
+};
+
+constexpr uint32_t kRenderGraphReadAccessMask =
+    RenderGraphAccessPixelRead | RenderGraphAccessComputeRead | RenderGraphAccessCopySource;
+
+enum class RenderGraphBarrierType : uint8_t {
+    Transition,
+    Uav,
+};
+
+// Barriers refer to physical resources: imported textures first, then transient slots.
+struct RenderGraphBarrier {
+    RenderGraphBarrierType type = RenderGraphBarrierType::Transition;
+    uint32_t physical = 0;
+    uint32_t before = RenderGraphAccessNone;
+    uint32_t after = RenderGraphAccessNone;
+};
+
+struct RenderGraphStep {
+    uint32_t pass = 0;
+    uint32_t firstBarrier = 0;
+    uint32_t barrierCount = 0;
+};
+
+struct RenderGraphStats {
+    uint32_t passesDeclared = 0;
+    uint32_t passesCulled = 0;
+    uint32_t barriers = 0;       // Transition + UAV barriers in the plan
+    uint32_t barrierBatches = 0; // ResourceBarrier calls the executor makes
+    uint32_t transientTextures = 0;
+    uint32_t transientTargets = 0; // Physical slots after lifetime-based reuse
+};
+
+// Output of RenderGraph::Compile: live passes in execution order, each preceded by one batch of
+// barriers, plus a closing batch that returns every physical resource to its resting state.
+struct RenderGraphPlan {
+    std::vector<RenderGraphStep> steps;
+    std::vector<RenderGraphBarrier> barriers;
+    uint32_t finalFirstBarrier = 0;
+    uint32_t finalBarrierCount = 0;
+    std::vector<uint32_t> resourcePhysical;           // Logical resource -> physical index
+    uint32_t importedCount = 0;                       // Physical [0, importedCount) are imports
+    std::vector<TransientTargetDesc> transientDescs;  // Physical importedCount + i
+    RenderGraphStats stats;
+
+    void Clear();
+};
+
+// GPU-agnostic frame graph. Passes declare the textures they read and write; Compile orders
+// them by dependency, culls passes whose results nobody reads, assigns transient textures to
+// physical slots by lifetime (so a ping-pong chain needs two) and derives the minimal batched
+// barrier list. Passes that write an imported texture, or are marked as having side effects,
+// are always kept.
+class RenderGraph {
+public:
+    static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+    void Reset();
+
+    // externalId is opaque to the graph (the executor's resource pointer). initial/final is the
+    // state the texture is in before the frame and must be returned to afterwards.
+    uint32_t ImportTexture(const char* name, uint64_t externalId, uint32_t initialAccess, uint32_t finalAccess);
+    // Transient textures rest in restAccess between frames (the transient pool's convention).
+    uint32_t CreateTexture(const char* name, const TransientTargetDesc& desc, uint32_t restAccess = RenderGraphAccessPixelRead);
+
+    uint32_t AddPass(const char* name, bool hasSideEffects = false);
+    void Read(uint32_t pass, uint32_t resource, uint32_t access = RenderGraphAccessPixelRead);
+    void Write(uint32_t pass, uint32_t resource, uint32_t access = RenderGraphAccessRenderTarget);
+
+    bool Compile(RenderGraphPlan& outPlan, std::string& outError) const;
+
+    uint32_t GetPassCount() const { return static_cast<uint32_t>(m_passes.size()); }
+    uint32_t GetResourceCount() const { return static_cast<uint32_t>(m_resources.size()); }
+    const char* GetPassName(uint32_t pass) const { return m_passes[pass].name; }
+    const char* GetResourceName(uint32_t resource) const { return m_resources[resource].name; }
+    bool IsImported(uint32_t resource) const { return m_resources[resource].imported; }
+    uint64_t GetExternalId(uint32_t resource) const { return m_resources[resource].externalId; }
+    const TransientTargetDesc& GetDesc(uint32_t resource) const { return m_resources[resource].desc; }
+
+private:
+    struct Use {
+        uint32_t resource = 0;
+        uint32_t access = RenderGraphAccessNone;
+        bool write = false;
+    };
+
+    struct Pass {
+        const char* name = "";
+        bool hasSideEffects = false;
+        std::vector<Use> uses;
+    };
+
+    struct Resource {
+        const char* name = "";
+        bool imported = false;
+        uint64_t externalId = 0;
+        uint32_t initialAccess = RenderGraphAccessNone;
+        uint32_t finalAccess = RenderGraphAccessNone;
+        TransientTargetDesc desc;
+    };
+
+    void AddUse(uint32_t pass, uint32_t resource, uint32_t access, bool write);
+
+    std::vector<Pass> m_passes;
+    std::vector<Resource> m_resources;
+};
+
+} // namespace ShaderLab
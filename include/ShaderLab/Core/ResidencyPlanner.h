@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ShaderLab/Core/TrackData.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+struct ResidencySceneInfo {
+    uint64_t bytes = 0;            // GPU footprint while resident
+    std::vector<int> dependencies; // Scenes sampled through bindings
+};
+
+struct ResidencySettings {
+    double leadBeats = 4.0;         // Allocate this long before first use
+    double releaseDelayBeats = 0.0; // Keep resources this long after last use
+    bool looping = true;            // Wrap lead time from the track start onto the track end
+};
+
+struct ResidencyInterval {
+    double startBeat = 0.0;
+    double endBeat = 0.0; // Exclusive
+};
+
+struct ResidencyEvent {
+    double beat = 0.0;
+    int sceneIndex = -1;
+    bool allocate = true;
+};
+
+struct ResidencyPlan {
+    double endBeat = 0.0;
+    std::vector<std::vector<int>> dependencyClosure;                 // Per scene, includes the scene itself
+    std::vector<std::vector<ResidencyInterval>> activeIntervals;    // Visible or sampled, transitions included
+    std::vector<std::vector<ResidencyInterval>> residentIntervals;  // Active widened by lead/release time
+    std::vector<ResidencyEvent> events;                             // Sorted by beat, allocations first
+    uint64_t peakBytes = 0;
+    double peakBeat = 0.0;
+    uint64_t eagerBytes = 0; // Every scene resident for the whole demo
+
+    bool IsResident(int sceneIndex, double beat) const;
+};
+
+// Pure CPU planner: replays the compiled track the way DemoSequencer does and derives when each
+// scene's render targets have to exist. Scenes never reached by the track are never resident.
+class ResidencyPlanner {
+public:
+    static bool Build(const DemoTrack& track,
+                      const std::vector<ResidencySceneInfo>& scenes,
+                      const ResidencySettings& settings,
+                      ResidencyPlan& outPlan,
+                      std::string& outError);
+};
+
+} // namespace ShaderLab
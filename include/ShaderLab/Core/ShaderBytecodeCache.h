@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderLab {
+
+struct AsyncCompileRequest;
+
+struct ShaderBytecodeCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+};
+
+// Compiled bytecode keyed by a hash of everything that goes into the compile. Bytecode does
+// not depend on the adapter, so the cache outlives the device and a restart onto another GPU
+// only has to re-create pipeline states. Safe to use from the compile workers.
+class ShaderBytecodeCache {
+public:
+    explicit ShaderBytecodeCache(size_t maxBytes = 64u * 1024u * 1024u);
+
+    static uint64_t HashRequest(const AsyncCompileRequest& request);
+
+    bool Find(uint64_t key, std::vector<uint8_t>& outBytecode);
+    // Oldest entries are evicted once maxBytes is exceeded.
+    void Store(uint64_t key, const std::vector<uint8_t>& bytecode);
+    void Clear();
+
+    ShaderBytecodeCacheStats GetStats() const;
+
+private:
+    size_t m_maxBytes;
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, std::vector<uint8_t>> m_entries;
+    std::deque<uint64_t> m_order; // Insertion order for eviction
+    ShaderBytecodeCacheStats m_stats;
+};
+
+} // namespace ShaderLab
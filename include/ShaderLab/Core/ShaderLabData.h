@@ -1,8 +1,11 @@
 #pragma once
 
+#include "ShaderLab/Core/TrackData.h"
+
 #include <string>
 #include <vector>
 #include <cstddef>
+#include <cstdint>
 #include <d3d12.h>
 #include <wrl/client.h>
 
@@ -10,23 +13,6 @@ using Microsoft::WRL::ComPtr;
 
 namespace ShaderLab {
 
-enum class TextureType { Texture2D, TextureCube, Texture3D };
-enum class BindingType { Scene, File };
-enum class AudioType { Music, OneShot };
-enum class RenderAspectRatioPreset : uint8_t { Ratio_16_9 = 0, Ratio_1_1 = 1, Ratio_16_10 = 2, Ratio_4_3 = 3 };
-enum class FullscreenRenderResolutionPreset : uint8_t {
-    Full = 0,
-    W4096 = 1,
-    W2560 = 2,
-    W2048 = 3,
-    W1920 = 4,
-    W1600 = 5,
-    W1280 = 6,
-    W1024 = 7,
-    W800 = 8,
-    W640 = 9
-};
-
 struct TextureBinding {
     int channelIndex = 0;
     bool enabled = false;
@@ -38,47 +24,8 @@ struct TextureBinding {
     TextureType type = TextureType::Texture2D; 
 };
 
-struct AudioClip {
-    std::string name;
-    std::string path;
-    AudioType type = AudioType::Music;
-    float bpm = 120.0f;
-};
-
-struct TrackerRow {
-    int rowId = 0; 
-    int sceneIndex = -1;
-    std::string transitionPresetStem;
-    std::string transitionShaderPath;
-    float transitionDuration = 1.0f; 
-    float timeOffset = 0.0f; // Offset in beats to subtract from global time for this scene
-    int musicIndex = -1; 
-    int oneShotIndex = -1; 
-    bool isBeat = true; 
-    bool stop = false; 
-};
-
-struct DemoTrack {
-    std::string name = "Untitled Track";
-    float bpm = 120.0f;
-    int lengthBeats = 128; 
-    std::vector<TrackerRow> rows;
-    int currentBeat = 0;
-    int lastTriggeredBeat = -1;
-};
-
-enum class TransportState { Stopped, Playing, Paused };
-
-struct Transport { // Renamed from PreviewTransport for genera use
-    TransportState state = TransportState::Stopped;
-    double timeSeconds = 0.0;
-    double lastFrameWallSeconds = 0.0;
-    bool freezeTime = false;
-    bool freezeBeat = false;
-    float bpm = 140.0f;
-};
-
 struct Scene {
+    uint64_t id = 0; // Editor-assigned, stable across reorders; 0 until assigned
     std::string name;
     std::string description;
     std::string shaderCode;
@@ -101,6 +48,7 @@ struct Scene {
         size_t compiledShaderBytes = 0;
         int historyIndex = 0;
         bool historyInitialized = false;
+        int historyFrames = 0; // History slots holding rendered frames (runtime ring)
         std::vector<ComPtr<ID3D12Resource>> historyTextures;
 
         PostFXEffect() = default;
@@ -148,6 +96,7 @@ struct Scene {
         size_t compiledShaderBytes = 0;
         int historyIndex = 0;
         bool historyInitialized = false;
+        int historyFrames = 0; // History slots holding rendered frames (runtime ring)
         std::vector<ComPtr<ID3D12Resource>> historyTextures;
         int historyCount = 0;  // How many history frames this effect needs
 
@@ -172,7 +121,6 @@ struct Scene {
     // Post FX runtime resources
     ComPtr<ID3D12Resource> postFxTextureA;
     ComPtr<ID3D12Resource> postFxTextureB;
-    ComPtr<ID3D12DescriptorHeap> postFxSrvHeap;
     ComPtr<ID3D12DescriptorHeap> postFxRtvHeap;
     bool postFxValid = false;
     
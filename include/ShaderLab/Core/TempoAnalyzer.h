@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace ShaderLab {
+
+struct TempoAnalysisOptions {
+    float minBpm = 70.0f;
+    float maxBpm = 180.0f;
+    uint32_t beatsPerBar = 4;
+    unsigned workerCount = 0; // 0 = hardware concurrency
+};
+
+struct TempoAnalysisResult {
+    float bpm = 0.0f;
+    float beatOffset = 0.0f;   // Seconds from the start to the first downbeat
+    float firstBeat = 0.0f;    // Seconds from the start to the first beat
+    float confidence = 0.0f;   // 0..1, how sharply the onsets line up on the grid
+    double durationSeconds = 0.0;
+    double onsetMs = 0.0;      // Spectral flux over the whole clip
+    double tempoMs = 0.0;      // Tempo, phase and downbeat search
+};
+
+// Estimates the tempo and beat grid of decoded mono audio. Onsets come from spectral flux,
+// computed in parallel over time chunks; the tempo from a comb over the onset autocorrelation,
+// refined by folding the onset envelope over the whole clip at candidate periods. The downbeat
+// is the beat of the bar with the most low-frequency onset energy.
+bool AnalyzeTempo(const float* samples,
+                  size_t sampleCount,
+                  uint32_t sampleRate,
+                  const TempoAnalysisOptions& options,
+                  TempoAnalysisResult& outResult,
+                  std::string& outError);
+
+// FNV-1a of the encoded file, the key of TempoAnalysisCache.
+uint64_t HashTempoSource(const void* data, size_t size);
+
+// Analysis results by file hash, persisted as one text line per clip. Thread safe.
+class TempoAnalysisCache {
+public:
+    bool Find(uint64_t hash, TempoAnalysisResult& outResult) const;
+    void Store(uint64_t hash, const TempoAnalysisResult& result);
+    size_t GetSize() const;
+
+    // A missing file is an empty cache, not an error.
+    bool Load(const std::string& path, std::string& outError);
+    bool Save(const std::string& path, std::string& outError) const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, TempoAnalysisResult> m_entries;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ShaderLab {
+
+constexpr size_t kTextNotFound = std::string::npos;
+
+// Offset of the first `needle` at or after `from`, or kTextNotFound. The scan tests the needle's
+// first and last bytes at 16 positions per step and compares the rest only where both match.
+size_t FindText(const char* text, size_t textSize, const char* needle, size_t needleSize, size_t from = 0);
+
+// Non-overlapping matches, counted left to right.
+size_t CountText(const char* text, size_t textSize, const char* needle, size_t needleSize);
+
+// Replaces every non-overlapping `needle` in one pass, writing the result to outText.
+// Returns the number of replacements; outText is a copy of `text` when there are none.
+size_t ReplaceAllText(const std::string& text,
+                      const std::string& needle,
+                      const std::string& replacement,
+                      std::string& outText);
+
+} // namespace ShaderLab
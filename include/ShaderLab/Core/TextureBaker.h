@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ShaderLab/Core/TextureUploadQueue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+enum class BakedTextureDimension : uint32_t { Texture2D = 0, TextureCube = 1, Texture3D = 2 };
+// BC4 keeps the red channel only.
+enum class BakedTextureFormat : uint32_t { RGBA8 = 0, BC1 = 1, BC4 = 2, BC7 = 3 };
+enum class MipFilter : uint32_t { Box = 0, Kaiser = 1 };
+
+struct TextureBakeOptions {
+    BakedTextureFormat format = BakedTextureFormat::BC7;
+    MipFilter mipFilter = MipFilter::Kaiser;
+    bool generateMips = true;
+    bool srgb = true;          // Color data; mips are filtered in linear light
+    unsigned workerCount = 0;  // 0 = hardware concurrency
+};
+
+struct TextureBakeStats {
+    uint64_t sourceBytes = 0;
+    uint64_t payloadBytes = 0;
+    uint32_t mipLevels = 0;
+    bool formatFallback = false; // Block compression needs a top level in whole 4x4 blocks
+    double mipMs = 0.0;
+    double encodeMs = 0.0;
+};
+
+// .sltex: header, subresource table, then the payload at a 512-byte boundary. Subresources
+// follow D3D12 order (mip + slice * mipLevels) with the placement and row pitch alignment of
+// D3D12 upload footprints, so the whole payload can be copied into an upload buffer as is.
+constexpr uint32_t kSlTexMagic = 0x58544C53u; // "SLTX"
+constexpr uint32_t kSlTexVersion = 1;
+constexpr uint32_t kSlTexRowPitchAlignment = 256;
+constexpr uint32_t kSlTexPlacementAlignment = 512;
+constexpr uint32_t kSlTexFlagSrgb = 1u;
+
+struct SlTexHeader {
+    uint32_t magic = kSlTexMagic;
+    uint32_t version = kSlTexVersion;
+    uint32_t dimension = 0;        // BakedTextureDimension
+    uint32_t format = 0;           // BakedTextureFormat
+    uint32_t flags = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t depth = 1;            // Texture3D only
+    uint32_t arraySize = 1;        // 6 for cubes
+    uint32_t mipLevels = 1;
+    uint32_t subresourceCount = 0;
+    uint32_t reserved = 0;
+    uint64_t payloadOffset = 0;    // From the start of the file
+    uint64_t payloadSize = 0;
+};
+static_assert(sizeof(SlTexHeader) == 64, "SlTexHeader layout is part of the file format");
+
+struct SlTexSubresource {
+    uint64_t offset = 0;           // From the start of the payload
+    uint32_t rowPitch = 0;
+    uint32_t rowCount = 0;         // Rows of blocks for BC formats, per depth slice
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t depth = 1;
+    uint32_t reserved = 0;
+};
+static_assert(sizeof(SlTexSubresource) == 32, "SlTexSubresource layout is part of the file format");
+
+// Non-owning view over a container, e.g. a mapped package entry. The payload is not copied.
+struct SlTexView {
+    SlTexHeader header;
+    std::vector<SlTexSubresource> subresources;
+    const uint8_t* payload = nullptr;
+
+    static bool Parse(const uint8_t* data, size_t size, SlTexView& outView, std::string& outError);
+    const uint8_t* GetSubresourceData(uint32_t index) const { return payload + subresources[index].offset; }
+    BakedTextureFormat GetFormat() const { return static_cast<BakedTextureFormat>(header.format); }
+    BakedTextureDimension GetDimension() const { return static_cast<BakedTextureDimension>(header.dimension); }
+    bool IsSrgb() const { return (header.flags & kSlTexFlagSrgb) != 0; }
+};
+
+// Cubes come as a 6:1 strip or 1:6 column of square faces (+X, -X, +Y, -Y, +Z, -Z); volumes as
+// square slices stacked vertically or side by side.
+bool BakeTexture(const DecodedImage& source,
+                 BakedTextureDimension dimension,
+                 const TextureBakeOptions& options,
+                 std::vector<uint8_t>& outFile,
+                 std::string& outError,
+                 TextureBakeStats* outStats = nullptr);
+
+// Expands one subresource back to tightly packed RGBA8 (width * height * depth texels).
+bool DecodeSlTexSubresource(const SlTexView& view, uint32_t index, std::vector<uint8_t>& outRgba, std::string& outError);
+
+uint32_t GetBakedTextureBlockBytes(BakedTextureFormat format); // Per 4x4 block, or per texel for RGBA8
+bool IsBlockCompressed(BakedTextureFormat format);
+const char* GetBakedTextureFormatName(BakedTextureFormat format);
+bool ParseBakedTextureFormat(const std::string& name, BakedTextureFormat& outFormat);
+
+} // namespace ShaderLab
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "ShaderLab/Core/FrameRingBuffer.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace ShaderLab {
+
+// Tightly packed RGBA8 pixels.
+struct DecodedImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> rgba;
+};
+
+// Runs on a decode worker; must be thread safe.
+using ImageDecodeFunction = std::function<bool(const std::string& path, DecodedImage& outImage, std::string& outError)>;
+
+struct TextureStagingFootprint {
+    uint32_t rowPitch = 0;    // Bytes between rows in staging memory
+    uint64_t totalBytes = 0;  // Including row padding
+    uint64_t alignment = 1;   // Required placement alignment of the first row
+};
+
+// GPU half of TextureUploadQueue. Uploads are grouped into batches; batch i is submitted once
+// and reported complete through GetCompletedBatch(), typically from a fence signalled with i + 1.
+class ITextureUploadBackend {
+public:
+    virtual ~ITextureUploadBackend() = default;
+
+    // Persistently mapped staging memory of GetStagingCapacity() bytes.
+    virtual uint8_t* GetStagingMemory() = 0;
+    virtual uint64_t GetStagingCapacity() const = 0;
+    // Only called while no batch is in flight. Invalidates GetStagingMemory().
+    virtual bool ResizeStaging(uint64_t capacityBytes) = 0;
+
+    virtual TextureStagingFootprint GetFootprint(uint32_t width, uint32_t height) = 0;
+    // Creates the texture for ticket and records its copy from stagingOffset into the open batch.
+    virtual bool RecordUpload(uint64_t ticket, uint32_t width, uint32_t height, uint64_t stagingOffset,
+                              const TextureStagingFootprint& footprint, std::string& outError) = 0;
+    virtual void SubmitBatch(uint64_t batchIndex) = 0;
+    // Newest finished batch, or -1 if none.
+    virtual int64_t GetCompletedBatch() = 0;
+    // Drops the texture of a ticket nobody wants anymore. Its batch has completed.
+    virtual void ReleaseTexture(uint64_t ticket) = 0;
+};
+
+struct TextureUploadResult {
+    uint64_t ticket = 0;
+    bool success = false;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::string path;
+    std::string error;
+};
+
+struct TextureUploadStats {
+    uint64_t requested = 0;
+    uint64_t decoded = 0;
+    uint64_t uploaded = 0;
+    uint64_t failed = 0;
+    uint64_t canceled = 0;
+    uint64_t batches = 0;
+    uint64_t bytesStaged = 0;
+    uint64_t stagingStalls = 0;   // Updates that left decoded images waiting for ring space
+    uint64_t stagingResizes = 0;
+    double decodeMs = 0.0;        // Summed over workers
+    double stageMs = 0.0;         // Row copies into staging on the calling thread
+};
+
+// Loads images into GPU textures without blocking the caller. Files decode on worker threads;
+// Update(), called once per frame from the render thread, copies finished images into a
+// persistent staging ring, records them into one batch and hands out textures whose batch the
+// GPU has finished. Ring space is reclaimed per batch, like FrameRingBuffer does per frame.
+class TextureUploadQueue {
+public:
+    TextureUploadQueue(ITextureUploadBackend* backend, ImageDecodeFunction decoder, unsigned workerCount);
+    ~TextureUploadQueue();
+
+    TextureUploadQueue(const TextureUploadQueue&) = delete;
+    TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+
+    static unsigned DefaultWorkerCount();
+
+    // Tickets start at 1.
+    uint64_t RequestFile(const std::string& path);
+    // Pixels that are already in memory skip the decode workers.
+    uint64_t RequestImage(DecodedImage image, const std::string& label = std::string());
+    // The ticket's texture is released instead of delivered.
+    void Cancel(uint64_t ticket);
+    void CancelAll();
+
+    // Stages decoded images, submits at most one batch and appends finished uploads.
+    size_t Update(std::vector<TextureUploadResult>& outResults);
+    // Blocks until every request made so far has been delivered. waitForBatch must block until
+    // the given batch is complete; the queue itself never waits on the GPU.
+    void Flush(const std::function<void(uint64_t batchIndex)>& waitForBatch, std::vector<TextureUploadResult>& outResults);
+
+    void SetBatchByteBudget(uint64_t bytes) { m_batchByteBudget = bytes; }
+    uint64_t GetBatchByteBudget() const { return m_batchByteBudget; }
+    size_t GetPendingCount() const;
+    TextureUploadStats GetStats() const;
+    uint64_t GetStagingPeakUsed() const { return m_ring.GetPeakUsed(); }
+
+private:
+    struct DecodeJob {
+        uint64_t ticket = 0;
+        std::string path;
+    };
+    struct Decoded {
+        uint64_t ticket = 0;
+        std::string path;
+        DecodedImage image;
+        bool success = false;
+        std::string error;
+    };
+    struct InFlight {
+        uint64_t batchIndex = 0;
+        TextureUploadResult result;
+    };
+
+    void WorkerMain();
+    void DecodeOne(DecodeJob& job, Decoded& out);
+    bool IsCanceled(uint64_t ticket) const; // m_mutex held
+    void Retire(std::vector<TextureUploadResult>& outResults, size_t& added);
+    void StageDecoded(std::vector<TextureUploadResult>& outResults, size_t& added);
+
+    ITextureUploadBackend* m_backend = nullptr;
+    ImageDecodeFunction m_decoder;
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_decodedSignal;
+    std::deque<DecodeJob> m_decodeQueue;
+    std::deque<Decoded> m_decoded;
+    std::unordered_set<uint64_t> m_canceled;
+    uint64_t m_canceledThrough = 0; // CancelAll() drops every ticket up to this one
+    uint64_t m_nextTicket = 0;
+    size_t m_decoding = 0;
+    bool m_stop = false;
+    TextureUploadStats m_stats;
+
+    // Render thread only.
+    FrameRingBuffer m_ring;
+    std::deque<InFlight> m_inFlight;
+    uint64_t m_nextBatch = 0;
+    uint64_t m_batchByteBudget = 64ull * 1024ull * 1024ull;
+};
+
+} // namespace ShaderLab
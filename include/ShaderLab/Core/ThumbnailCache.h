@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ShaderLab {
+
+// Every thumbnail has the same size, so a page is a plain grid of cells.
+struct ThumbnailAtlasDesc {
+    uint32_t cellWidth = 160;
+    uint32_t cellHeight = 90;
+    uint32_t columns = 8;
+    uint32_t rows = 8;
+    uint32_t maxPages = 4;
+};
+
+// Where a thumbnail sits, in pixels of its page.
+struct ThumbnailSlot {
+    uint32_t page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint64_t revision = 0; // Page revision that first holds this image
+};
+
+struct ThumbnailCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t inserts = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+};
+
+// .slthumb: header, the entry table, then each entry's cell as tight RGBA8 in table order.
+constexpr uint32_t kSlThumbMagic = 0x42544C53u; // "SLTB"
+constexpr uint32_t kSlThumbVersion = 1;
+
+struct SlThumbHeader {
+    uint32_t magic = kSlThumbMagic;
+    uint32_t version = kSlThumbVersion;
+    uint32_t cellWidth = 0;
+    uint32_t cellHeight = 0;
+    uint32_t columns = 0;
+    uint32_t rows = 0;
+    uint32_t entryCount = 0;
+    uint32_t reserved = 0;
+    uint64_t payloadHash = 0; // FNV-1a of the entry table and pixels
+};
+static_assert(sizeof(SlThumbHeader) == 40, "SlThumbHeader layout is part of the file format");
+
+struct SlThumbEntry {
+    uint64_t key = 0;
+    uint64_t lastUse = 0;
+    uint32_t page = 0;
+    uint32_t cell = 0;
+};
+static_assert(sizeof(SlThumbEntry) == 24, "SlThumbEntry layout is part of the file format");
+
+// Key of a rendered thumbnail: the shader's content hash plus the render settings.
+uint64_t MakeThumbnailKey(uint64_t sourceHash, uint32_t width, uint32_t height, float timeSeconds);
+
+// CPU side of the shader thumbnail atlas. Images live in RGBA8 pages that the editor uploads
+// as textures; a page only has to be uploaded again once its revision moved past the one on
+// the GPU. When every page is full the least recently found thumbnail gives up its cell.
+class ThumbnailCache {
+public:
+    explicit ThumbnailCache(const ThumbnailAtlasDesc& desc = ThumbnailAtlasDesc());
+
+    const ThumbnailAtlasDesc& GetDesc() const { return m_desc; }
+    uint32_t GetPageWidth() const { return m_desc.cellWidth * m_desc.columns; }
+    uint32_t GetPageHeight() const { return m_desc.cellHeight * m_desc.rows; }
+
+    // Marks the thumbnail as used.
+    bool Find(uint64_t key, ThumbnailSlot& outSlot);
+    bool Contains(uint64_t key) const { return m_entries.find(key) != m_entries.end(); }
+    // Copies a cellWidth x cellHeight RGBA8 image whose rows are rowPitch bytes apart. A key
+    // that is already cached keeps its cell and gets the new image.
+    bool Insert(uint64_t key, const uint8_t* rgba, uint32_t rowPitch, ThumbnailSlot& outSlot);
+    bool Remove(uint64_t key);
+    void Clear();
+
+    size_t GetPageCount() const { return m_pages.size(); }
+    const std::vector<uint8_t>& GetPagePixels(size_t page) const { return m_pages[page].pixels; }
+    uint64_t GetPageRevision(size_t page) const { return m_pages[page].revision; }
+    // Changed since the last Save or Load.
+    bool IsDirty() const { return m_dirty; }
+    ThumbnailCacheStats GetStats() const;
+
+    void Serialize(std::vector<uint8_t>& outData) const;
+    // Rejects files written with another cell layout; the cache is left empty then.
+    bool Deserialize(const uint8_t* data, size_t size, std::string& outError);
+    bool Save(const std::string& path, std::string& outError);
+    bool Load(const std::string& path, std::string& outError);
+
+private:
+    struct Entry {
+        uint32_t page = 0;
+        uint32_t cell = 0;
+        uint64_t lastUse = 0;
+        uint64_t revision = 0;
+    };
+    struct Page {
+        std::vector<uint8_t> pixels;
+        std::vector<bool> cellUsed;
+        uint32_t usedCells = 0;
+        uint64_t revision = 0;
+    };
+
+    uint32_t CellsPerPage() const { return m_desc.columns * m_desc.rows; }
+    ThumbnailSlot SlotOf(const Entry& entry) const;
+    // Free cell, a new page or the least recently used cell, in that order.
+    bool AcquireCell(uint32_t& outPage, uint32_t& outCell);
+    void WriteCell(uint32_t page, uint32_t cell, const uint8_t* rgba, uint32_t rowPitch);
+
+    ThumbnailAtlasDesc m_desc;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::vector<Page> m_pages;
+    uint64_t m_useClock = 0;
+    uint64_t m_revision = 0;
+    bool m_dirty = false;
+    ThumbnailCacheStats m_stats;
+};
+
+} // namespace ShaderLab
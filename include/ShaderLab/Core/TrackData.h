@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ShaderLab/Core/TrackerRowStore.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Project types with no graphics API dependency (shared with headless tools).
+
+namespace ShaderLab {
+
+enum class AudioType { Music, OneShot };
+enum class TextureType { Texture2D, TextureCube, Texture3D };
+enum class BindingType { Scene, File };
+enum class RenderAspectRatioPreset : uint8_t { Ratio_16_9 = 0, Ratio_1_1 = 1, Ratio_16_10 = 2, Ratio_4_3 = 3 };
+enum class FullscreenRenderResolutionPreset : uint8_t {
+    Full = 0,
+    W4096 = 1,
+    W2560 = 2,
+    W2048 = 3,
+    W1920 = 4,
+    W1600 = 5,
+    W1280 = 6,
+    W1024 = 7,
+    W800 = 8,
+    W640 = 9
+};
+
+struct AudioClip {
+    std::string name;
+    std::string path;
+    AudioType type = AudioType::Music;
+    float bpm = 120.0f;
+    float beatOffset = 0.0f; // Seconds to the first downbeat, as detected
+};
+
+struct TrackerRow {
+    int rowId = 0; 
+    int sceneIndex = -1;
+    std::string transitionPresetStem;
+    std::string transitionShaderPath;
+    float transitionDuration = 1.0f; 
+    float timeOffset = 0.0f; // Offset in beats to subtract from global time for this scene
+    int musicIndex = -1; 
+    int oneShotIndex = -1; 
+    bool isBeat = true; 
+    bool stop = false; 
+};
+
+struct DemoTrack {
+    std::string name = "Untitled Track";
+    float bpm = 120.0f;
+    int lengthBeats = 128; 
+    TrackerRowStore rows;
+    int currentBeat = 0;
+    int lastTriggeredBeat = -1;
+};
+
+enum class TransportState { Stopped, Playing, Paused };
+
+struct Transport { // Renamed from PreviewTransport for genera use
+    TransportState state = TransportState::Stopped;
+    double timeSeconds = 0.0;
+    double lastFrameWallSeconds = 0.0;
+    bool freezeTime = false;
+    bool freezeBeat = false;
+    float bpm = 140.0f;
+};
+
+} // namespace ShaderLab
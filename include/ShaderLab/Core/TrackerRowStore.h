@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+
+struct TrackerRow;
+
+// Tracker rows keyed by beat (TrackerRow::rowId), at most one row per beat. Rows live in
+// fixed-size slabs that never move, so a TrackerRow* handed out stays valid across inserts
+// until that row is erased or the store is cleared or reassigned. A sorted index of
+// (beat, row) gives O(log n) lookup and iteration in beat order. The beat of a stored row is
+// its key: change it with ShiftBeats, never through the pointer; debug builds assert on
+// lookup that the rows found still carry their key.
+class TrackerRowStore {
+private:
+    struct Entry {
+        int beat;
+        TrackerRow* row;
+    };
+
+public:
+    template <typename Row>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = TrackerRow;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Row*;
+        using reference = Row&;
+        using EntryIt = std::vector<Entry>::const_iterator;
+
+        BasicIterator() = default;
+        explicit BasicIterator(EntryIt it) : m_it(it) {}
+        // iterator converts to const_iterator, not the other way round.
+        template <typename OtherRow>
+            requires std::is_const_v<Row> && (!std::is_const_v<OtherRow>)
+        BasicIterator(const BasicIterator<OtherRow>& other) : m_it(other.Base()) {}
+
+        reference operator*() const { return *m_it->row; }
+        pointer operator->() const { return m_it->row; }
+        reference operator[](difference_type n) const { return *m_it[n].row; }
+        BasicIterator& operator++() { ++m_it; return *this; }
+        BasicIterator operator++(int) { BasicIterator copy = *this; ++m_it; return copy; }
+        BasicIterator& operator--() { --m_it; return *this; }
+        BasicIterator operator--(int) { BasicIterator copy = *this; --m_it; return copy; }
+        BasicIterator& operator+=(difference_type n) { m_it += n; return *this; }
+        BasicIterator& operator-=(difference_type n) { m_it -= n; return *this; }
+        BasicIterator operator+(difference_type n) const { return BasicIterator(m_it + n); }
+        BasicIterator operator-(difference_type n) const { return BasicIterator(m_it - n); }
+        difference_type operator-(const BasicIterator& other) const { return m_it - other.m_it; }
+        bool operator==(const BasicIterator& other) const { return m_it == other.m_it; }
+        bool operator!=(const BasicIterator& other) const { return m_it != other.m_it; }
+        bool operator<(const BasicIterator& other) const { return m_it < other.m_it; }
+
+        EntryIt Base() const { return m_it; }
+
+    private:
+        EntryIt m_it{};
+    };
+
+    using iterator = BasicIterator<TrackerRow>;
+    using const_iterator = BasicIterator<const TrackerRow>;
+
+    TrackerRowStore();
+    ~TrackerRowStore();
+    TrackerRowStore(const TrackerRowStore& other);
+    TrackerRowStore& operator=(const TrackerRowStore& other);
+    TrackerRowStore(TrackerRowStore&& other) noexcept;
+    TrackerRowStore& operator=(TrackerRowStore&& other) noexcept;
+
+    size_t size() const { return m_index.size(); }
+    bool empty() const { return m_index.empty(); }
+    void clear();
+    void reserve(size_t count);
+
+    iterator begin() { return iterator(m_index.cbegin()); }
+    iterator end() { return iterator(m_index.cend()); }
+    const_iterator begin() const { return const_iterator(m_index.cbegin()); }
+    const_iterator end() const { return const_iterator(m_index.cend()); }
+    // The index-th row in beat order.
+    TrackerRow& operator[](size_t index) { return *m_index[index].row; }
+    const TrackerRow& operator[](size_t index) const { return *m_index[index].row; }
+
+    TrackerRow* Find(int beat);
+    const TrackerRow* Find(int beat) const;
+    // First row at or after `beat`; walk from here for a beat range.
+    iterator LowerBound(int beat);
+    const_iterator LowerBound(int beat) const;
+
+    // Keeps an existing row at the same beat; the bool says whether `row` was inserted.
+    std::pair<TrackerRow*, bool> Insert(const TrackerRow& row);
+    // The row at `beat`, inserted with default fields when missing.
+    TrackerRow& Ensure(int beat);
+    bool Erase(int beat);
+    // Removes the rows in [firstBeat, lastBeat). Returns how many were removed.
+    size_t EraseRange(int firstBeat, int lastBeat);
+
+    // Batch edits, one index rebuild each however many rows they touch.
+    // Inserts rows in any order; as with Insert, rows at beats already present are skipped.
+    size_t InsertBatch(const TrackerRow* rows, size_t count);
+    // Replaces the contents; the first of several rows at one beat wins. Returns how many
+    // rows were dropped that way.
+    size_t Assign(std::vector<TrackerRow> rows);
+    // Moves every row at or after fromBeat by delta beats, e.g. to insert or delete beats.
+    // With a negative delta the rows in [fromBeat + delta, fromBeat) are erased first.
+    void ShiftBeats(int fromBeat, int delta);
+
+    std::vector<TrackerRow> ToVector() const;
+
+private:
+    TrackerRow* Allocate(const TrackerRow& row);
+    void Release(TrackerRow* row);
+    std::vector<Entry>::iterator LowerBoundEntry(int beat);
+
+    std::vector<std::unique_ptr<TrackerRow[]>> m_slabs;
+    size_t m_slabUsed = 0;             // Slots handed out from the newest slab
+    std::vector<TrackerRow*> m_free;   // Erased slots, reused before the slab grows
+    std::vector<Entry> m_index;        // Sorted by beat
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ShaderLab {
+
+// Backend-neutral target key. format/flags carry the graphics API's enum values verbatim.
+struct TransientTargetDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t format = 0;
+    uint32_t flags = 0;
+
+    bool operator==(const TransientTargetDesc& other) const {
+        return width == other.width && height == other.height && format == other.format && flags == other.flags;
+    }
+    bool operator!=(const TransientTargetDesc& other) const { return !(*this == other); }
+};
+
+// Creates and destroys the physical targets. The backend keeps its own per-handle storage;
+// handles are small dense indices that are reused after DestroyTarget.
+class ITransientTargetBackend {
+public:
+    virtual ~ITransientTargetBackend() = default;
+
+    virtual bool CreateTarget(uint32_t handle, const TransientTargetDesc& desc, uint64_t& outBytes) = 0;
+    virtual void DestroyTarget(uint32_t handle) = 0;
+};
+
+struct TransientTargetPoolStats {
+    uint64_t createCount = 0;  // Backend allocations since construction
+    uint64_t destroyCount = 0;
+    uint64_t acquireCount = 0;
+    uint64_t reuseCount = 0;   // Acquires served without a backend allocation
+    size_t liveTargets = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakLiveBytes = 0;
+    uint64_t frameLeasedBytes = 0; // Most bytes leased at once during the last frame
+    uint64_t peakLeasedBytes = 0;
+    uint64_t idleBytes = 0;        // Live but untouched during the last frame
+};
+
+// Per-frame pool of interchangeable targets keyed by TransientTargetDesc. A lease lasts until
+// Release() or EndFrame(); a released target can be handed out again later in the same frame,
+// so passes whose lifetimes do not overlap share memory. Contents do not survive a lease.
+//
+// Reuse across frames is safe on a single queue. Destruction is not, so idle targets are only
+// trimmed once the GPU has finished the last frame that used them.
+class TransientTargetPool {
+public:
+    static constexpr uint32_t kInvalidHandle = 0xFFFFFFFFu;
+
+    explicit TransientTargetPool(ITransientTargetBackend& backend, uint32_t trimAfterFrames = 120);
+    ~TransientTargetPool();
+
+    TransientTargetPool(const TransientTargetPool&) = delete;
+    TransientTargetPool& operator=(const TransientTargetPool&) = delete;
+
+    // completedFrameIndex: newest frame the GPU has finished, or -1 if none.
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+    uint32_t Acquire(const TransientTargetDesc& desc);
+    void Release(uint32_t handle);
+    void EndFrame();
+
+    // Destroys every target. The caller guarantees the GPU is idle.
+    void Clear();
+
+    bool IsLeased(uint32_t handle) const;
+    const TransientTargetPoolStats& GetStats() const { return m_stats; }
+
+private:
+    struct Entry {
+        TransientTargetDesc desc;
+        uint64_t bytes = 0;
+        uint64_t lastUsedFrame = 0;
+        bool alive = false;
+        bool leased = false;
+    };
+
+    void Destroy(uint32_t handle);
+
+    ITransientTargetBackend& m_backend;
+    uint32_t m_trimAfterFrames = 120;
+    std::vector<Entry> m_entries;
+    std::vector<uint32_t> m_freeSlots;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_leasedBytes = 0;
+    TransientTargetPoolStats m_stats;
+};
+
+} // namespace ShaderLab
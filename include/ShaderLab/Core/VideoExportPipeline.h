@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ShaderLab/Core/VideoFrameSink.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+
+struct VideoExportStats {
+    uint64_t framesWritten = 0;
+    double convertMs = 0.0; // RGBA -> RGB on the worker
+    double writeMs = 0.0;   // Time spent in the sink
+    size_t maxQueued = 0;
+};
+
+// Background half of a video export. The render thread submits frames that stay valid until
+// the worker has consumed them (persistently mapped readback buffers); the worker converts each
+// to RGB and feeds the sink in submission order. At most capacity frames are in flight, so
+// frame i can reuse ring slot i % capacity once CanSubmit() is true.
+class VideoExportPipeline {
+public:
+    VideoExportPipeline(std::unique_ptr<IVideoFrameSink> sink, size_t capacity);
+    ~VideoExportPipeline();
+
+    VideoExportPipeline(const VideoExportPipeline&) = delete;
+    VideoExportPipeline& operator=(const VideoExportPipeline&) = delete;
+
+    bool Start(const VideoFrameFormat& format, std::string& outError);
+    bool CanSubmit() const;
+    // rgba must stay untouched until GetConsumedCount() has passed this frame.
+    bool Submit(const uint8_t* rgba, uint32_t rowPitch);
+    // Waits for queued frames, then closes the sink.
+    bool Finish(std::string& outError);
+    // Drops queued frames and closes the sink.
+    void Cancel();
+
+    uint64_t GetSubmittedCount() const { return m_submitted; }
+    uint64_t GetConsumedCount() const { return m_consumed.load(); }
+    size_t GetCapacity() const { return m_capacity; }
+    bool HasFailed() const { return m_failed.load(); }
+    std::string GetError() const;
+    VideoExportStats GetStats() const;
+    const IVideoFrameSink& GetSink() const { return *m_sink; }
+
+private:
+    struct Frame {
+        const uint8_t* rgba = nullptr;
+        uint32_t rowPitch = 0;
+        uint64_t index = 0;
+    };
+
+    void WorkerMain();
+    bool Stop(bool drain, std::string& outError);
+
+    std::unique_ptr<IVideoFrameSink> m_sink;
+    size_t m_capacity;
+    VideoFrameFormat m_format;
+    std::vector<uint8_t> m_rgb;
+    std::thread m_worker;
+    uint64_t m_submitted = 0;
+    std::atomic<uint64_t> m_consumed{ 0 };
+    std::atomic<bool> m_failed{ false };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<Frame> m_queue;
+    bool m_stop = false;
+    bool m_started = false;
+    std::string m_error;
+    VideoExportStats m_stats;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+struct VideoFrameFormat {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t fps = 60;
+};
+
+// Receives tightly packed RGB24 frames, in order, from the export worker.
+class IVideoFrameSink {
+public:
+    virtual ~IVideoFrameSink() = default;
+
+    virtual bool Open(const VideoFrameFormat& format, std::string& outError) = 0;
+    virtual bool WriteFrame(const uint8_t* rgb, uint64_t frameIndex, std::string& outError) = 0;
+    // Flushes and waits for whatever consumes the frames. Called once, also after a failure.
+    virtual bool Close(std::string& outError) = 0;
+    virtual const char* GetName() const = 0;
+};
+
+// Streams raw frames into the stdin of a child process, typically ffmpeg reading rawvideo.
+// Nothing touches the disk except what the encoder writes.
+class EncoderPipeSink : public IVideoFrameSink {
+public:
+    explicit EncoderPipeSink(std::string commandLine);
+    ~EncoderPipeSink() override;
+
+    bool Open(const VideoFrameFormat& format, std::string& outError) override;
+    bool WriteFrame(const uint8_t* rgb, uint64_t frameIndex, std::string& outError) override;
+    bool Close(std::string& outError) override;
+    const char* GetName() const override { return "encoder pipe"; }
+
+    // ffmpeg command reading rgb24 frames of format from stdin and writing H.264 to outputPath.
+    static std::string FfmpegCommand(const std::string& ffmpegPath, const VideoFrameFormat& format,
+                                     const std::string& outputPath);
+    // True when executable runs with -version and exits cleanly.
+    static bool ProbeEncoder(const std::string& executable);
+
+private:
+    struct Process;
+
+    std::string m_commandLine;
+    std::unique_ptr<Process> m_process;
+    size_t m_frameBytes = 0;
+};
+
+// Built-in fallback when no encoder is installed: one QOI image per frame in a directory.
+// QOI is lossless, encodes in a single pass and typically lands near PNG size.
+class QoiSequenceSink : public IVideoFrameSink {
+public:
+    explicit QoiSequenceSink(std::string directory);
+
+    bool Open(const VideoFrameFormat& format, std::string& outError) override;
+    bool WriteFrame(const uint8_t* rgb, uint64_t frameIndex, std::string& outError) override;
+    bool Close(std::string& outError) override;
+    const char* GetName() const override { return "QOI sequence"; }
+
+    const std::string& GetDirectory() const { return m_directory; }
+    uint64_t GetBytesWritten() const { return m_bytesWritten; }
+
+private:
+    std::string m_directory;
+    VideoFrameFormat m_format;
+    std::vector<uint8_t> m_encoded;
+    uint64_t m_bytesWritten = 0;
+};
+
+// Packs rows of RGBA8 (rowPitch bytes apart) into tight RGB24. Uses SSSE3 when the CPU has it.
+void ConvertRgbaToRgb(const uint8_t* rgba, uint32_t rowPitch, uint32_t width, uint32_t height, uint8_t* outRgb);
+// Appends a complete QOI file (3 channels, sRGB) for a tightly packed RGB24 image.
+void EncodeQoi(const uint8_t* rgb, uint32_t width, uint32_t height, std::vector<uint8_t>& out);
+
+} // namespace ShaderLab
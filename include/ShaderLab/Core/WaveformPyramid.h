@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+// Quantized to 16 bits: min rounds down and max rounds up, so a bucket always bounds its samples.
+struct WaveformBucket {
+    int16_t min = 0;
+    int16_t max = 0;
+    uint16_t rms = 0; // 0..1 mapped to 0..65535
+};
+static_assert(sizeof(WaveformBucket) == 6, "WaveformBucket layout is part of the file format");
+
+struct WaveformColumn {
+    float min = 0.0f;
+    float max = 0.0f;
+    float rms = 0.0f;
+    bool valid = false; // False past either end of the clip
+};
+
+// .slwave: header, then the buckets of every level from the finest up. Bucket counts follow from
+// the sample count and base bucket size, so there is no level table.
+constexpr uint32_t kSlWaveMagic = 0x56574C53u; // "SLWV"
+constexpr uint32_t kSlWaveVersion = 1;
+
+struct SlWaveHeader {
+    uint32_t magic = kSlWaveMagic;
+    uint32_t version = kSlWaveVersion;
+    uint32_t sampleRate = 0;
+    uint32_t baseBucketSamples = 0;
+    uint32_t levelCount = 0;
+    uint32_t reserved = 0;
+    uint64_t sampleCount = 0;
+    uint64_t sourceHash = 0;       // FNV-1a of the encoded audio file
+    uint64_t payloadHash = 0;      // FNV-1a of the buckets
+};
+static_assert(sizeof(SlWaveHeader) == 48, "SlWaveHeader layout is part of the file format");
+
+// Min / max / RMS mip pyramid of a mono clip. Level 0 holds one bucket per baseBucketSamples
+// samples; every level above merges pairs of the one below, up to a single bucket.
+class WaveformPyramid {
+public:
+    uint32_t GetSampleRate() const { return m_sampleRate; }
+    uint64_t GetSampleCount() const { return m_sampleCount; }
+    double GetDurationSeconds() const;
+    uint32_t GetBaseBucketSamples() const { return m_baseBucketSamples; }
+    size_t GetLevelCount() const { return m_levels.size(); }
+    const std::vector<WaveformBucket>& GetLevel(size_t level) const { return m_levels[level]; }
+    uint64_t GetSourceHash() const { return m_sourceHash; }
+    void SetSourceHash(uint64_t hash) { m_sourceHash = hash; }
+    bool IsEmpty() const { return m_levels.empty(); }
+
+    // Fills `columnCount` columns spanning [startSeconds, endSeconds) from the coarsest level whose
+    // buckets are no wider than a column, so the cost is O(columns) at any zoom. A column covers
+    // every bucket it overlaps. Returns the number of valid columns.
+    size_t Query(double startSeconds, double endSeconds, uint32_t columnCount, WaveformColumn* outColumns) const;
+
+    void Serialize(std::vector<uint8_t>& outData) const;
+    static bool Deserialize(const uint8_t* data, size_t size, WaveformPyramid& outPyramid, std::string& outError);
+    bool Save(const std::string& path, std::string& outError) const;
+    static bool Load(const std::string& path, WaveformPyramid& outPyramid, std::string& outError);
+
+private:
+    friend class WaveformPyramidBuilder;
+
+    uint32_t m_sampleRate = 0;
+    uint32_t m_baseBucketSamples = 0;
+    uint64_t m_sampleCount = 0;
+    uint64_t m_sourceHash = 0;
+    std::vector<std::vector<WaveformBucket>> m_levels;
+};
+
+struct WaveformBuildOptions {
+    uint32_t baseBucketSamples = 256;
+    unsigned workerCount = 0; // 0 = hardware concurrency
+};
+
+// Builds a pyramid from samples fed in chunks of any size, e.g. straight from a decoder. Samples
+// are staged and reduced to level 0 buckets in parallel batches, so memory stays bounded by the
+// pyramid itself; Finish reduces the upper levels, each one in parallel.
+class WaveformPyramidBuilder {
+public:
+    bool Begin(const WaveformBuildOptions& options, std::string& outError);
+    void Append(const float* samples, size_t count);
+    bool Finish(uint32_t sampleRate, WaveformPyramid& outPyramid, std::string& outError);
+
+private:
+    void Flush(bool final);
+
+    WaveformBuildOptions m_options;
+    std::vector<float> m_staging;
+    std::vector<WaveformBucket> m_base;
+    uint64_t m_sampleCount = 0;
+    bool m_begun = false;
+};
+
+bool BuildWaveformPyramid(const float* samples,
+                          size_t sampleCount,
+                          uint32_t sampleRate,
+                          const WaveformBuildOptions& options,
+                          WaveformPyramid& outPyramid,
+                          std::string& outError);
+
+} // namespace ShaderLab
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ShaderLab/Core/TextureBaker.h"
+
 #include <functional>
 #include <cstdint>
 #include <string>
@@ -65,6 +67,8 @@ struct BuildRequest {
     bool runtimeDebugLog = false;
     bool compactTrackDebugLog = false;
     bool microDeveloperBuild = false;
+    BakedTextureFormat textureFormat = BakedTextureFormat::BC7; // File-bound textures in packed builds
+    bool textureMips = true;
     std::unordered_map<std::string, std::vector<std::string>> microUbershaderKeepEntrypointsBySignature;
 };
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "ShaderLab/Core/FrameContextRing.h"
+
 #include <cstdint>
+#include <vector>
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <d3d12.h>
@@ -12,12 +15,15 @@ using Microsoft::WRL::ComPtr;
 
 class Device;
 
-class CommandQueue {
+// Direct queue with one command list recorded from a ring of frameContextCount allocators.
+// ResetCommandList only blocks when the allocator it is about to reuse is still executing,
+// so callers that skip WaitForGPU keep up to frameContextCount frames in flight.
+class CommandQueue final : private IFrameFence {
 public:
     CommandQueue();
     ~CommandQueue();
 
-    bool Initialize(Device* device, D3D12_COMMAND_LIST_TYPE type);
+    bool Initialize(Device* device, D3D12_COMMAND_LIST_TYPE type, uint32_t frameContextCount = 1);
     void Shutdown();
 
     ID3D12CommandQueue* GetQueue() const { return m_queue.Get(); }
@@ -28,14 +34,24 @@ public:
     void WaitForGPU();
     uint64_t SignalFence();
 
+    // Frame recorded since the last ResetCommandList, and the newest one the GPU has finished.
+    uint64_t GetFrameIndex() const { return m_frames.GetFrameIndex(); }
+    int64_t GetCompletedFrameIndex() const { return m_frames.GetCompletedFrameIndex(); }
+    uint32_t GetFrameContextCount() const { return m_frames.GetContextCount(); }
+    const FrameContextStats& GetFrameStats() const { return m_frames.GetStats(); }
+
 private:
+    uint64_t GetCompletedValue() override;
+    void WaitForValue(uint64_t value) override;
+
     ComPtr<ID3D12CommandQueue> m_queue;
-    ComPtr<ID3D12CommandAllocator> m_commandAllocator;
+    std::vector<ComPtr<ID3D12CommandAllocator>> m_commandAllocators;
     ComPtr<ID3D12GraphicsCommandList> m_commandList;
     ComPtr<ID3D12Fence> m_fence;
 
     uint64_t m_fenceValue = 0;
     HANDLE m_fenceEvent = nullptr;
+    FrameContextRing m_frames;
 };
 
 } // namespace ShaderLab
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ShaderLab/Core/DescriptorRingAllocator.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace ShaderLab {
+
+using Microsoft::WRL::ComPtr;
+
+// D3D12 front end of DescriptorRingAllocator: one shader-visible CBV/SRV/UAV heap for every
+// per-frame table, and a CPU-only heap that caches views by resource and view description.
+class DescriptorRingService final : private IDescriptorCacheBackend {
+public:
+    DescriptorRingService() = default;
+    ~DescriptorRingService();
+
+    DescriptorRingService(const DescriptorRingService&) = delete;
+    DescriptorRingService& operator=(const DescriptorRingService&) = delete;
+
+    bool Initialize(ID3D12Device* device, uint32_t cacheCapacity, uint32_t ringCapacity);
+    void Shutdown();
+
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+    void EndFrame();
+
+    ID3D12DescriptorHeap* GetHeap() const { return m_ringHeap.Get(); }
+
+    // Cached CPU-only SRV; resource may be null for a null view of the given description.
+    bool GetSrv(ID3D12Resource* resource, const D3D12_SHADER_RESOURCE_VIEW_DESC& desc, D3D12_CPU_DESCRIPTOR_HANDLE& outHandle);
+    bool GetTexture2DSrv(ID3D12Resource* resource, DXGI_FORMAT format, D3D12_CPU_DESCRIPTOR_HANDLE& outHandle);
+    bool GetUav(ID3D12Resource* resource, const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc, D3D12_CPU_DESCRIPTOR_HANDLE& outHandle);
+
+    // Copies sources into count fresh ring slots and returns the table's GPU start.
+    bool AllocateTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources, uint32_t count, D3D12_GPU_DESCRIPTOR_HANDLE& outTable);
+    // Same, for a tableSize-slot table whose slots past sourceCount the caller writes through outCpu
+    // (per-frame views such as CBVs that are not worth caching).
+    bool AllocateTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources,
+                       uint32_t sourceCount,
+                       uint32_t tableSize,
+                       D3D12_CPU_DESCRIPTOR_HANDLE& outCpu,
+                       D3D12_GPU_DESCRIPTOR_HANDLE& outTable);
+
+    uint32_t GetDescriptorSize() const { return m_descriptorSize; }
+
+    const DescriptorRingStats& GetStats() const;
+
+private:
+    void ReleaseCachedView(uint32_t slot) override;
+    bool AcquireCacheSlot(ID3D12Resource* resource, uint64_t viewHash, D3D12_CPU_DESCRIPTOR_HANDLE& outHandle, bool& outNeedsWrite);
+
+    ID3D12Device* m_device = nullptr;
+    ComPtr<ID3D12DescriptorHeap> m_cacheHeap;
+    ComPtr<ID3D12DescriptorHeap> m_ringHeap;
+    uint32_t m_descriptorSize = 0;
+    std::vector<ComPtr<ID3D12Resource>> m_cachedResources; // Keeps cached pointers from being reused
+    std::vector<uint32_t> m_copySizes;
+    std::unique_ptr<DescriptorRingAllocator> m_allocator;
+};
+
+} // namespace ShaderLab
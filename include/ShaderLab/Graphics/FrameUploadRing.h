@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ShaderLab/Core/FrameRingBuffer.h"
+
+#include <cstdint>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace ShaderLab {
+
+using Microsoft::WRL::ComPtr;
+
+// Persistently mapped upload buffer carved up per frame, for constants written while
+// recording. Memory handed out in a frame stays untouched until the GPU has finished it.
+class FrameUploadRing {
+public:
+    FrameUploadRing() = default;
+    ~FrameUploadRing();
+
+    FrameUploadRing(const FrameUploadRing&) = delete;
+    FrameUploadRing& operator=(const FrameUploadRing&) = delete;
+
+    bool Initialize(ID3D12Device* device, uint64_t capacityBytes);
+    void Shutdown();
+
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+    void EndFrame();
+
+    bool Allocate(uint64_t size, uint64_t alignment, void*& outCpu, D3D12_GPU_VIRTUAL_ADDRESS& outGpu);
+
+    uint64_t GetCapacity() const { return m_ring.GetCapacity(); }
+    uint64_t GetPeakUsed() const { return m_ring.GetPeakUsed(); }
+    uint64_t GetOverflowCount() const { return m_ring.GetOverflowCount(); }
+
+private:
+    ComPtr<ID3D12Resource> m_buffer;
+    uint8_t* m_mapped = nullptr;
+    FrameRingBuffer m_ring;
+};
+
+} // namespace ShaderLab
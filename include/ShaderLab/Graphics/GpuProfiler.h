@@ -0,0 +1,76 @@
+#pragma once
+
+#include "ShaderLab/Core/FrameProfiler.h"
+
+#include <cstdint>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace ShaderLab {
+
+using Microsoft::WRL::ComPtr;
+
+// D3D12 front end of FrameProfiler: one timestamp query heap and one readback buffer with a
+// region per frame slot. Each frame resolves its own queries; BeginFrame reads back the
+// frames the GPU has finished, so timings arrive a few frames late without ever stalling.
+class GpuProfiler {
+public:
+    // frameSlots should cover the frames in flight.
+    explicit GpuProfiler(uint32_t frameSlots = 3, uint32_t queriesPerFrame = 256);
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    // queue supplies the timestamp frequency. CPU scopes work without a successful Initialize.
+    bool Initialize(ID3D12Device* device, ID3D12CommandQueue* queue);
+    void Shutdown();
+
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex);
+    // Resolves this frame's queries; record before the command list is closed.
+    void EndFrame(ID3D12GraphicsCommandList* commandList);
+
+    void BeginScope(ID3D12GraphicsCommandList* commandList, const char* name);
+    void EndScope(ID3D12GraphicsCommandList* commandList);
+
+    FrameProfiler& GetProfiler() { return m_profiler; }
+    const FrameProfiler& GetProfiler() const { return m_profiler; }
+    bool IsInitialized() const { return m_queryHeap != nullptr; }
+
+private:
+    void CollectCompleted(int64_t completedFrameIndex);
+
+    FrameProfiler m_profiler;
+    ComPtr<ID3D12QueryHeap> m_queryHeap;
+    ComPtr<ID3D12Resource> m_readback;
+    uint64_t m_frequency = 0;
+};
+
+// CPU and GPU scope around a block of recorded commands. profiler may be null.
+class ScopedGpuProfile {
+public:
+    ScopedGpuProfile(GpuProfiler* profiler, ID3D12GraphicsCommandList* commandList, const char* name)
+        : m_profiler(profiler), m_commandList(commandList) {
+        if (m_profiler) {
+            m_profiler->GetProfiler().BeginCpuScope(name);
+            m_profiler->BeginScope(m_commandList, name);
+        }
+    }
+    ~ScopedGpuProfile() {
+        if (m_profiler) {
+            m_profiler->EndScope(m_commandList);
+            m_profiler->GetProfiler().EndCpuScope();
+        }
+    }
+
+    ScopedGpuProfile(const ScopedGpuProfile&) = delete;
+    ScopedGpuProfile& operator=(const ScopedGpuProfile&) = delete;
+
+private:
+    GpuProfiler* m_profiler;
+    ID3D12GraphicsCommandList* m_commandList;
+};
+
+} // namespace ShaderLab
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ShaderLab/Core/AudioAnalyzer.h"
+
 #include <d3d12.h>
 #include <wrl/client.h>
 #include <cstddef>
@@ -52,10 +54,14 @@ public:
                 float iBar = 0.0f,
                 float fBarBeat16 = 0.0f,
                 float fBeat = 0.0f,
-                float fBarBeat = 0.0f);
+                float fBarBeat = 0.0f,
+                uint32_t historyFrames = 0);
 
     bool IsValid(ID3D12PipelineState* pso) const { return pso != nullptr; }
 
+    // Audio analysis passed to every following Render call; set once per frame.
+    void SetAudioConstants(const AudioShaderBlock& audio) { m_audio = audio; }
+
     float GetLastGPUTimeMs() const { return m_lastGPUTimeMs; }
     size_t GetLastCompiledPixelShaderSize() const { return m_lastCompiledPixelShaderSize; }
 
@@ -82,6 +88,8 @@ private:
     uint64_t m_gpuFrequency = 0;
     float m_lastGPUTimeMs = 0.0f;
     size_t m_lastCompiledPixelShaderSize = 0;
+
+    AudioShaderBlock m_audio;
 };
 
 } // namespace ShaderLab
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "ShaderLab/Core/RenderGraph.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <d3d12.h>
+
+namespace ShaderLab {
+
+class TransientTargetService;
+class GpuProfiler;
+
+// D3D12 front end of RenderGraph: imports ID3D12Resources, leases transient textures from the
+// transient pool, and records each live pass after one batched ResourceBarrier call. With a
+// profiler set, every pass is a CPU and GPU scope named after the pass.
+class RenderGraphExecutor {
+public:
+    using PassFunction = std::function<void(ID3D12GraphicsCommandList*)>;
+
+    explicit RenderGraphExecutor(TransientTargetService& targets);
+
+    void Reset();
+
+    uint32_t Import(const char* name,
+                    ID3D12Resource* resource,
+                    uint32_t initialAccess = RenderGraphAccessPixelRead,
+                    uint32_t finalAccess = RenderGraphAccessPixelRead);
+    uint32_t CreateTexture(const char* name, uint32_t width, uint32_t height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags);
+    uint32_t AddPass(const char* name, PassFunction function, bool hasSideEffects = false);
+    void Read(uint32_t pass, uint32_t resource, uint32_t access = RenderGraphAccessPixelRead) { m_graph.Read(pass, resource, access); }
+    void Write(uint32_t pass, uint32_t resource, uint32_t access = RenderGraphAccessRenderTarget) { m_graph.Write(pass, resource, access); }
+
+    // Resolved texture for a graph resource; valid while passes execute.
+    ID3D12Resource* GetResource(uint32_t resource) const;
+
+    void SetProfiler(GpuProfiler* profiler) { m_profiler = profiler; }
+
+    bool Execute(ID3D12GraphicsCommandList* commandList, std::string& outError);
+
+    const RenderGraphStats& GetStats() const { return m_plan.stats; }
+
+    static D3D12_RESOURCE_STATES ToResourceState(uint32_t access);
+
+private:
+    void RecordBarriers(ID3D12GraphicsCommandList* commandList, uint32_t first, uint32_t count);
+
+    TransientTargetService& m_targets;
+    GpuProfiler* m_profiler = nullptr;
+    RenderGraph m_graph;
+    RenderGraphPlan m_plan;
+    std::vector<PassFunction> m_passFunctions;
+    std::vector<ID3D12Resource*> m_physical;
+    std::vector<uint32_t> m_leases;
+    std::vector<D3D12_RESOURCE_BARRIER> m_barrierScratch;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ShaderLab/Core/TextureUploadQueue.h"
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <d3d12.h>
+#include <wrl/client.h>
+
+namespace ShaderLab {
+
+using Microsoft::WRL::ComPtr;
+
+// D3D12 backend of TextureUploadQueue: one persistently mapped staging buffer, its own queue
+// and one command list per batch. Batch i signals the fence with i + 1. The queue is a direct
+// one so a batch can leave its textures in PIXEL_SHADER_RESOURCE, the state the renderers expect.
+class Dx12TextureUploader final : public ITextureUploadBackend {
+public:
+    Dx12TextureUploader() = default;
+    ~Dx12TextureUploader() override;
+
+    Dx12TextureUploader(const Dx12TextureUploader&) = delete;
+    Dx12TextureUploader& operator=(const Dx12TextureUploader&) = delete;
+
+    bool Initialize(ID3D12Device* device, uint64_t stagingBytes);
+    // Waits for submitted batches.
+    void Shutdown();
+    void WaitForBatch(uint64_t batchIndex);
+
+    // Hands over the texture of a delivered upload.
+    ComPtr<ID3D12Resource> TakeTexture(uint64_t ticket);
+
+    uint8_t* GetStagingMemory() override { return m_stagingMapped; }
+    uint64_t GetStagingCapacity() const override { return m_stagingCapacity; }
+    bool ResizeStaging(uint64_t capacityBytes) override;
+    TextureStagingFootprint GetFootprint(uint32_t width, uint32_t height) override;
+    bool RecordUpload(uint64_t ticket, uint32_t width, uint32_t height, uint64_t stagingOffset,
+                      const TextureStagingFootprint& footprint, std::string& outError) override;
+    void SubmitBatch(uint64_t batchIndex) override;
+    int64_t GetCompletedBatch() override;
+    void ReleaseTexture(uint64_t ticket) override;
+
+private:
+    struct PendingAllocator {
+        uint64_t batchIndex = 0;
+        ComPtr<ID3D12CommandAllocator> allocator;
+    };
+
+    bool CreateStaging(uint64_t capacityBytes);
+    void ReleaseStaging();
+    bool OpenBatch();
+
+    ComPtr<ID3D12Device> m_device;
+    ComPtr<ID3D12CommandQueue> m_queue;
+    ComPtr<ID3D12GraphicsCommandList> m_commandList;
+    ComPtr<ID3D12CommandAllocator> m_openAllocator;
+    std::vector<ComPtr<ID3D12CommandAllocator>> m_freeAllocators;
+    std::deque<PendingAllocator> m_pendingAllocators;
+    ComPtr<ID3D12Fence> m_fence;
+    HANDLE m_fenceEvent = nullptr;
+    uint64_t m_lastSignaled = 0;
+
+    ComPtr<ID3D12Resource> m_staging;
+    uint8_t* m_stagingMapped = nullptr;
+    uint64_t m_stagingCapacity = 0;
+
+    std::unordered_map<uint64_t, ComPtr<ID3D12Resource>> m_textures;
+};
+
+} // namespace ShaderLab
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "ShaderLab/Core/TransientTargetPool.h"
+#include "ShaderLab/Graphics/ResourceService.h"
+
+#include <vector>
+
+namespace ShaderLab {
+
+// D3D12 front end of TransientTargetPool. Targets are allocated through any IResourceService
+// and rest in PIXEL_SHADER_RESOURCE between leases.
+class TransientTargetService final : private ITransientTargetBackend {
+public:
+    explicit TransientTargetService(IResourceService& resources, uint32_t trimAfterFrames = 120);
+
+    void BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) { m_pool.BeginFrame(frameIndex, completedFrameIndex); }
+    void EndFrame() { m_pool.EndFrame(); }
+    void Clear() { m_pool.Clear(); }
+
+    // Returns nullptr on failure; outHandle is TransientTargetPool::kInvalidHandle then.
+    ID3D12Resource* Acquire(uint32_t width, uint32_t height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags, uint32_t& outHandle);
+    void Release(uint32_t handle) { m_pool.Release(handle); }
+
+    const TransientTargetPoolStats& GetStats() const { return m_pool.GetStats(); }
+
+private:
+    bool CreateTarget(uint32_t handle, const TransientTargetDesc& desc, uint64_t& outBytes) override;
+    void DestroyTarget(uint32_t handle) override;
+
+    IResourceService& m_resources;
+    std::vector<ComPtr<ID3D12Resource>> m_targets;
+    TransientTargetPool m_pool; // Declared last: its destructor releases through m_targets
+};
+
+} // namespace ShaderLab
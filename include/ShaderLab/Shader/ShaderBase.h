@@ -20,6 +20,11 @@ cbuffer Constants : register(b0) {
     float fBeat;
     float fBarBeat;
     float fBarBeat16;
+    uint iHistoryFrames; // Post-FX history slots holding rendered frames; the rest hold the input
+    float iAudioRms;     // Live analysis of the playing music
+    float iAudioOnset;   // 1 on a detected onset, then decays
+    float iAudioPeak;
+    float4 iAudioBands[2]; // 8 log-spaced band levels, 0..1, low to high
 };
 )";
 }
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+
+enum class ShaderCompileMode {
+    Live,    // Debug, no optimization, fast compile
+    Build    // Release, O3, stripped for final demo
+};
+
+struct ShaderDiagnostic {
+    std::string message;
+    std::string filename;
+    uint32_t line = 0;
+    uint32_t column = 0;
+    bool isError = false;
+};
+
+struct ShaderCompileResult {
+    std::vector<uint8_t> bytecode;
+    std::vector<ShaderDiagnostic> diagnostics;
+    bool success = false;
+};
+
+} // namespace ShaderLab
@@ -4,6 +4,7 @@
 #include <dxcapi.h>
 #include <wrl/client.h>
 #include "ShaderLab/Shader/ShaderBase.h"
+#include "ShaderLab/Shader/ShaderCompileTypes.h"
 #include <string>
 #include <vector>
 
@@ -11,25 +12,6 @@ using Microsoft::WRL::ComPtr;
 
 namespace ShaderLab {
 
-enum class ShaderCompileMode {
-    Live,    // Debug, no optimization, fast compile
-    Build    // Release, O3, stripped for final demo
-};
-
-struct ShaderDiagnostic {
-    std::string message;
-    std::string filename;
-    uint32_t line = 0;
-    uint32_t column = 0;
-    bool isError = false;
-};
-
-struct ShaderCompileResult {
-    std::vector<uint8_t> bytecode;
-    std::vector<ShaderDiagnostic> diagnostics;
-    bool success = false;
-};
-
 class ShaderCompiler {
 public:
     struct BindingDecl {
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <imgui.h>
+
+namespace ShaderLab {
+class WaveformPyramid;
+}
+
+namespace ShaderLab::EditorWaveformWidgets {
+
+// Draws [startSeconds, endSeconds) of a clip as one min/max and RMS line per pixel and reserves
+// `size` in the layout. A null pyramid (still building) draws an empty frame.
+void DrawWaveform(const WaveformPyramid* pyramid, double startSeconds, double endSeconds, const ImVec2& size);
+
+}
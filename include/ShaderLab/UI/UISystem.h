@@ -7,15 +7,24 @@
 #include <vector>
 #include <functional>
 #include <future>
+#include <memory>
 #include <atomic>
 #include <mutex>
 #include <fstream>
 #include <cstddef>
 #include <array>
+#include <deque>
 #include <unordered_map>
+#include <unordered_set>
 #include "TextEditor.h"
 #include "ShaderLab/DevKit/BuildPipeline.h"
 #include "ShaderLab/Core/ShaderLabData.h"
+#include "ShaderLab/Core/DemoSequencer.h"
+#include "ShaderLab/Core/FrameProfiler.h"
+#include "ShaderLab/Core/ListSearchIndex.h"
+#include "ShaderLab/Core/ProjectSnapshot.h"
+#include "ShaderLab/Core/TempoAnalyzer.h"
+#include "ShaderLab/Core/WaveformPyramid.h"
 
 using Microsoft::WRL::ComPtr;
 
@@ -29,6 +38,21 @@ class Swapchain;
 class PreviewRenderer;
 class AudioSystem;
 class ICompilationService;
+class AsyncCompilationService;
+class AssetCatalog;
+class LinkedShaderWatcher;
+class ProjectCompileBatch;
+class ShaderBytecodeCache;
+class ThumbnailCache;
+class VideoExportPipeline;
+class TextureUploadQueue;
+class Dx12TextureUploader;
+struct TextureUploadResult;
+struct ShaderCompileResult;
+struct AsyncCompileResult;
+enum class CompileTargetKind : uint8_t;
+class GpuProfiler;
+class DescriptorRingService;
 
 enum class UIMode { Demo, Scene, PostFX };
 
@@ -72,15 +96,12 @@ struct ShaderEditState {
 };
 
 struct ProjectState {
-    std::vector<Scene> scenes;
-    std::vector<AudioClip> audioLibrary;
-    DemoTrack track;
+    ProjectSnapshot project; // Scenes, track, audio library and settings
+    ProjectHistory history;  // Undo levels survive the restart
+    uint64_t nextSceneId = 1;
+    int trackCurrentBeat = 0;
+    int trackLastTriggeredBeat = -1;
     PreviewTransport transport;
-    RenderAspectRatioPreset renderAspectRatioPreset = RenderAspectRatioPreset::Ratio_16_9;
-    FullscreenRenderResolutionPreset fullscreenRenderResolutionPreset = FullscreenRenderResolutionPreset::Full;
-    std::string demoTitle;
-    std::string demoAuthor;
-    std::string demoDescription;
     UIMode currentMode;
     ShaderEditState shaderState;
     int activeSceneIndex;
@@ -179,6 +200,8 @@ public:
 
     void SetRestartCallback(std::function<void(int)> callback) { m_restartCallback = callback; }
     void SetAudioSystem(AudioSystem* audio) { m_audioSystem = audio; }
+    // Shared with the compile services; owned by the app so it survives adapter restarts.
+    void SetBytecodeCache(ShaderBytecodeCache* cache);
     
     ProjectState CaptureState();
     void RestoreState(const ProjectState& state);
@@ -194,6 +217,17 @@ public:
 private:
     void SetActiveScene(int index);
 
+    // Undo/redo over project snapshots
+    ProjectSnapshot CaptureSnapshot() const;
+    void ApplySnapshot(const ProjectSnapshot& snapshot);
+    void UpdateUndoCheckpoint();
+    // Edits made outside a widget (buttons, menus, drops) call this; widgets report their own
+    void NoteProjectEdit() { ++m_projectEditGeneration; }
+    void AssignSceneIds();
+    void CapturePendingEdits();
+    void UndoProjectEdit();
+    void RedoProjectEdit();
+
     void CreateDescriptorHeap(Device* device);
     void CreatePreviewTexture(uint32_t width, uint32_t height);
     void CreateTitlebarIconTexture();
@@ -206,6 +240,7 @@ private:
     void EnsurePostFxPreviewResources(uint32_t width, uint32_t height);
     void EnsurePostFxHistory(Scene::PostFXEffect& effect, uint32_t width, uint32_t height);
     bool CompilePostFxEffect(Scene::PostFXEffect& effect, std::vector<std::string>& outErrors);
+    bool ApplyPostFxCompileResult(Scene::PostFXEffect& effect, const ShaderCompileResult& compileResult, std::vector<std::string>& outErrors);
     ID3D12Resource* ApplyPostFxChain(ID3D12GraphicsCommandList* commandList,
                                     Scene& scene,
                                     std::vector<Scene::PostFXEffect>& chain,
@@ -275,6 +310,15 @@ private:
                                         int& focusedBeatThisFrame);
     void RenderPlaylistMusicColumn(int beat, TrackerRow*& row, int& focusedBeatThisFrame);
     void RenderPlaylistOneShotColumn(int beat, TrackerRow*& row, int& focusedBeatThisFrame);
+    // Which clip plays from which beat; rebuilt once per frame for the waveform column.
+    struct PlaylistMusicSpan {
+        int beat = 0;
+        int musicIndex = -1;
+        double timeSeconds = 0.0; // Transport time at `beat`, which is also the clip time
+        float bpm = 120.0f;
+    };
+    void BuildPlaylistMusicSpans(std::vector<PlaylistMusicSpan>& outSpans) const;
+    void RenderPlaylistWaveColumn(int beat, const std::vector<PlaylistMusicSpan>& spans);
     TrackerRow* FindPlaylistRowByBeat(int targetBeat);
     TrackerRow* EnsurePlaylistRowByBeat(int targetBeat);
     void ScrubPlaylistToBeat(int targetBeat);
@@ -282,19 +326,38 @@ private:
     void HandlePlaylistFocusScrub(bool playlistWindowFocused, bool editingAnyItem, int focusedBeatThisFrame);
     void HandlePlaylistScrollFollow(int focusedBeatThisFrame);
     void ShowAudioLibrary();
+    void StartTempoDetection(const std::string& clipPath);
+    void PollTempoDetections();
+    const WaveformPyramid* RequestWaveform(const std::string& clipPath);
     void ShowDemoRuntimeLogWindow();
     void CreateDefaultScene();
     void CreateDefaultTrack();
     void InitializeCodeEditors();
     void LoadGlobalUiBuildSettings();
     void SaveGlobalUiBuildSettings() const;
-    bool LoadTextureFromFile(const std::string& path, ComPtr<ID3D12Resource>& outResource);
+    // Clears the binding and queues its file; the binding turns valid once the texture is on the GPU.
+    void RequestFileTexture(TextureBinding& binding);
+    // Blocks until the texture is uploaded. For small startup textures only.
     void CreateTextureFromData(const void* data, int width, int height, int channels, ComPtr<ID3D12Resource>& outResource);
+    bool EnsureTextureUploads();
+    void UpdateTextureUploads();
+    void ApplyTextureUploadResults(std::vector<TextureUploadResult>& results);
     bool CompileScene(int sceneIndex);
+    bool ApplySceneCompileResult(int sceneIndex, const ShaderCompileResult& compileResult);
+    // Queue a compile on m_asyncCompiler; the current PSO keeps rendering until ApplyCompletedCompiles.
+    bool SubmitSceneCompile(int sceneIndex);
+    bool SubmitPostFxCompile(int sceneIndex, int effectIndex, const Scene::PostFXEffect& effect);
+    // Reloads scenes and effects whose linked .hlsl changed on disk and queues only their compiles.
+    void UpdateLinkedShaders();
+    void ApplyCompletedCompiles();
+    // Compiles every scene and effect without a pipeline on a worker pool, active scene first.
+    void StartProjectCompile();
+    bool IsCompilePending(CompileTargetKind kind, int sceneIndex, int effectIndex) const;
     void SyncPostFxEditorToSelection();
     void SyncComputeEditorToSelection();
     bool CompileComputeEffect(Scene::ComputeEffect& effect, std::vector<Diagnostic>& outDiagnostics);
     bool CompileComputePipeline(Scene::ComputeEffect& effect);
+    bool CreateComputePipelineFromBytecode(Scene::ComputeEffect& effect, const ShaderCompileResult& compileResult);
     void EnsureComputeHistory(Scene::ComputeEffect& effect, uint32_t width, uint32_t height);
     ID3D12Resource* ApplyComputeEffectChain(ID3D12GraphicsCommandList* commandList,
                                             int sceneIndex,
@@ -315,24 +378,33 @@ private:
     ImVec4 GetSemanticErrorColor() const;
     ImVec4 GetSemanticInfoColor() const;
     void ShowThemeEditorPopup();
-    void RefreshTutsCatalog(bool force = false);
+    void RefreshTutsCatalog();
     void ShowTutsMenu();
     void ShowTutsPopup();
     void RenderTutsPreviewTexture(ID3D12GraphicsCommandList* commandList);
+    // Draws a shader's thumbnail from the atlas. A shader without one gets a placeholder and is
+    // queued to render once, at a fixed time and size, in the background. postFx shaders sample
+    // a test card as iChannel0. Returns true once the image is drawn.
+    bool DrawShaderThumbnail(const std::string& code, uint64_t codeHash, bool postFx, const ImVec2& size);
+    void UpdateShaderThumbnails();
+    void ApplyThumbnailCompileResult(const AsyncCompileResult& result);
+    bool ApplyThumbnailPageUpload(TextureUploadResult& result);
+    void RenderShaderThumbnails(ID3D12GraphicsCommandList* commandList);
+    void SaveShaderThumbnails();
     void ApplyUiTheme();
     void ApplyCodeEditorControlOpacity();
     void LoadUiThemeSettings();
     void SaveUiThemeSettings() const;
     bool AddOrReplaceCustomTheme(const std::string& name, const UIThemeColors& colors);
     void EnsureThemeBackgroundTexture();
+    void ApplyThemeBackgroundTexture(ComPtr<ID3D12Resource> texture, int width, int height, const std::string& path);
     void DrawThemeBackgroundTiled();
     void UpdatePreviewVideoExportBeginFrame();
     void QueuePreviewVideoCapture(ID3D12GraphicsCommandList* commandList);
-    bool WritePreviewCaptureFrameToDisk();
     bool StartPreviewVideoExport(const std::string& outputPath, uint32_t width, uint32_t height, uint32_t fps);
     void CancelPreviewVideoExport(bool restoreTransportState = true);
     void FinalizePreviewVideoExport();
-    bool RunFfmpegEncode(const std::string& inputPattern, const std::string& outputPath, uint32_t fps, std::string& outMessage);
+    void ReleasePreviewVideoExportRing();
 
     ComPtr<ID3D12DescriptorHeap> m_srvHeap;
     ImGuiContext* m_context = nullptr;
@@ -365,6 +437,31 @@ private:
     PreviewRenderer* m_previewRenderer = nullptr;
     AudioSystem* m_audioSystem = nullptr;
     std::unique_ptr<ICompilationService> m_compilationService;
+    std::unique_ptr<AsyncCompilationService> m_asyncCompiler;
+    std::unique_ptr<AsyncCompilationService> m_projectCompiler; // Lives for one StartProjectCompile batch
+    std::unique_ptr<ProjectCompileBatch> m_projectCompileBatch;
+    ShaderBytecodeCache* m_bytecodeCache = nullptr;
+
+    // Image decode and texture upload; the queue is declared last so it is destroyed first
+    std::unique_ptr<Dx12TextureUploader> m_textureUploader;
+    std::unique_ptr<TextureUploadQueue> m_textureUploads;
+    std::unordered_map<uint64_t, std::string> m_fileTextureTickets;     // Ticket -> path
+    std::unordered_map<std::string, uint64_t> m_fileTextureLoadsByPath; // One load per path in flight
+
+    // Tutorials, presets and snippets; scanned on its worker when their folders change
+    std::unique_ptr<AssetCatalog> m_assetCatalog;
+    int m_tutsCollection = -1;
+    int m_snippetsCollection = -1;
+    std::unique_ptr<LinkedShaderWatcher> m_linkedShaders;
+    uint64_t m_linkedShaderSignature = 0; // Project path and every shaderCodePath, in order
+
+    // Frame profiler (Alt+P window)
+    std::unique_ptr<GpuProfiler> m_profiler;
+    uint64_t m_gpuFrameIndex = 0; // Advances once per Render; shared by the profiler and descriptor ring
+    std::vector<ProfileFlameBar> m_profilerFlameBars;
+    bool m_profilerWindowOpen = false;
+    bool m_profilerTracePending = false;
+    std::string m_profilerTraceStatus;
 
     // Preview Texture (Final/Active)
     ComPtr<ID3D12Resource> m_previewTexture;
@@ -391,11 +488,41 @@ private:
     std::vector<AudioClip> m_audioLibrary;
     int m_activeMusicIndex = -1;
 
+    // BPM detection runs off the UI thread; results apply to every clip with the same path.
+    struct TempoDetection {
+        std::string path;
+        TempoAnalysisResult result;
+        std::string error;
+        std::future<bool> done;
+    };
+    std::vector<std::unique_ptr<TempoDetection>> m_tempoDetections;
+    std::shared_ptr<TempoAnalysisCache> m_tempoCache;
+    std::string m_tempoCachePath;
+
+    // Waveform pyramids by clip path, built off the UI thread and kept on disk by file hash.
+    struct WaveformBuild {
+        WaveformPyramid pyramid;
+        std::string error;
+        std::future<bool> done;
+        bool ready = false;
+        bool failed = false;
+    };
+    std::unordered_map<std::string, std::unique_ptr<WaveformBuild>> m_waveforms;
+    std::string m_waveformCacheDir;
+
     std::vector<Scene> m_scenes;
     int m_activeSceneIndex = 0;
     int m_editingSceneIndex = 0;
-    float m_activeSceneOffset = 0.0f; // Offset in beats relative to scene start
-    double m_activeSceneStartBeat = 0.0;
+    // Scene library filter; names are only re-keyed while a filter is typed
+    char m_sceneListFilter[64] = {};
+    ListSearchIndex m_sceneListSearch;
+
+    // Undo history; a checkpoint is taken once an edit gesture ends
+    ProjectHistory m_undoHistory;
+    uint64_t m_projectEditGeneration = 1;
+    uint64_t m_undoCapturedGeneration = 0;
+    uint64_t m_nextSceneId = 1;
+    bool m_shaderEditorFocused = false; // The text editor keeps its own undo
     
     // Editor
     TextEditor m_textEditor;
@@ -403,19 +530,9 @@ private:
     TextEditor m_tutCodeTextEditor;
     TextEditor m_ubershaderTextEditor;
     
-    // Transition State
-    bool m_transitionActive = false;
-    double m_transitionStartBeat = 0.0;
-    double m_transitionDurationBeats = 1.0;
-    int m_transitionFromIndex = -1;
-    int m_transitionToIndex = -1;
-    double m_transitionFromStartBeat = 0.0;
-    double m_transitionToStartBeat = 0.0;
-    float m_transitionFromOffset = 0.0f;
-    float m_transitionToOffset = 0.0f;
-    std::string m_currentTransitionStem;
-    int m_pendingActiveScene = -2; // -2 = None
-    int m_transitionJustCompletedBeat = -1;
+    // Scene/transition state machine (active scene offset/start beat, running transition)
+    DemoSequencer m_sequencer;
+    std::vector<SequencerCommand> m_sequencerCommands;
 
     float m_titlebarHeight = 0.0f;
     
@@ -445,6 +562,7 @@ private:
 
     // Post FX editor state
     int m_postFxSourceSceneIndex = -1;
+    bool m_postFxDraftCompileFailed = false;
     int m_postFxSelectedIndex = -1;
     std::vector<Scene::PostFXEffect> m_postFxDraftChain;
     std::vector<Scene::PostFXEffect> m_computePreviewEmulationChain;
@@ -467,11 +585,15 @@ private:
     int m_themeBackgroundWidth = 0;
     int m_themeBackgroundHeight = 0;
     std::string m_loadedThemeBackgroundPath;
+    std::string m_requestedThemeBackgroundPath; // Loaded, loading or failed; not requested again
+    uint64_t m_themeBackgroundTicket = 0;
+
+    // Per-frame shader-visible SRV tables (post-FX passes)
+    std::unique_ptr<DescriptorRingService> m_descriptorRing;
 
     // Post FX preview resources (draft)
     ComPtr<ID3D12Resource> m_postFxPreviewTextureA;
     ComPtr<ID3D12Resource> m_postFxPreviewTextureB;
-    ComPtr<ID3D12DescriptorHeap> m_postFxPreviewSrvHeap;
     ComPtr<ID3D12DescriptorHeap> m_postFxPreviewRtvHeap;
     uint32_t m_postFxPreviewWidth = 0;
     uint32_t m_postFxPreviewHeight = 0;
@@ -502,12 +624,7 @@ private:
     void ResetTransportTimelineState();
     void StopAudioAndClearMusicState();
     void ApplyPlaybackActiveScene(int index);
-    void BeginSceneTransition(int beat,
-                              double durationBeats,
-                              int targetSceneIndex,
-                              float targetOffset,
-                              double targetStartBeat,
-                              const std::string& transitionPresetStem);
+    void SyncSequencerActiveScene();
     void SeekToBeat(int beat);
 
     void LoadGlobalSnippets();
@@ -565,6 +682,8 @@ private:
     int m_snippetDraftFolderIndex = -1;
     int m_snippetDraftIndex = -1;
     std::string m_snippetDraftCode;
+    char m_snippetListFilter[64] = {};
+    ListSearchIndex m_snippetListSearch; // Names of the active folder's snippets
 
     float m_paletteA[3] = { 0.5f, 0.5f, 0.5f };
     float m_paletteB[3] = { 0.5f, 0.5f, 0.5f };
@@ -582,6 +701,7 @@ private:
 
     struct TutCodeBlock {
         std::string code;
+        uint64_t hash = 0; // HashShaderText(code), keys the thumbnail
         bool looksLikeSceneContract = false;
     };
 
@@ -595,6 +715,7 @@ private:
     struct TutItem {
         std::string title;
         std::string filePath;
+        std::shared_ptr<const std::string> markdown;
     };
 
     struct TutTopic {
@@ -610,7 +731,7 @@ private:
     TutDocument m_tutActiveDocument;
     std::string m_tutPopupTitle;
     std::string m_tutErrorMessage;
-    double m_tutsLastScanTime = 0.0;
+    uint64_t m_tutsGeneration = 0;
 
     ComPtr<ID3D12Resource> m_tutPreviewTexture;
     ComPtr<ID3D12DescriptorHeap> m_tutPreviewRtvHeap;
@@ -628,29 +749,64 @@ private:
     bool m_tutPreviewPlaying = true;
     double m_tutPreviewTimeSeconds = 0.0;
 
+    // Shader thumbnails: one compile, render and readback at a time; atlas pages are uploaded
+    // whole once the list has settled
+    struct ThumbnailRequest {
+        uint64_t key = 0;
+        std::string source;
+        bool postFx = false;
+    };
+    struct ThumbnailPage {
+        ComPtr<ID3D12Resource> texture;
+        uint64_t revision = 0;        // Atlas revision the texture shows
+        uint64_t ticket = 0;          // Upload in flight
+        uint64_t ticketRevision = 0;
+        double changedAt = -1.0;      // First change the texture does not show yet
+    };
+    std::unique_ptr<ThumbnailCache> m_thumbnails;
+    std::string m_thumbnailCachePath;
+    std::deque<ThumbnailRequest> m_thumbnailQueue;
+    std::unordered_set<uint64_t> m_thumbnailRequested; // Queued or rendering
+    std::unordered_set<uint64_t> m_thumbnailFailed;    // Not retried; edited code gets a new key
+    ThumbnailRequest m_thumbnailActive;                // key 0 when idle
+    ComPtr<ID3D12PipelineState> m_thumbnailPso;
+    uint64_t m_thumbnailReadbackKey = 0;               // Copy recorded last frame
+    std::vector<ThumbnailPage> m_thumbnailPages;
+    ComPtr<ID3D12Resource> m_thumbnailTarget;
+    ComPtr<ID3D12Resource> m_thumbnailReadback;
+    uint8_t* m_thumbnailReadbackMapped = nullptr;
+    uint32_t m_thumbnailReadbackRowPitch = 0;
+    ComPtr<ID3D12DescriptorHeap> m_thumbnailRtvHeap;
+    ComPtr<ID3D12DescriptorHeap> m_thumbnailInputSrvHeap;
+    ComPtr<ID3D12Resource> m_thumbnailTestCard;
+
     size_t m_lastDemoCompiledSizeBytes = 0;
     bool m_hasDemoCompiledSize = false;
 
     // Preview video export
     bool m_previewVideoExportActive = false;
     bool m_previewVideoExportEncoding = false;
-    bool m_previewVideoExportPendingReadback = false;
+    bool m_previewVideoExportPendingReadback = false; // Copy recorded, handed to the worker next frame
     uint32_t m_previewVideoExportWidth = 1280;
     uint32_t m_previewVideoExportHeight = 720;
     uint32_t m_previewVideoExportFps = 60;
     uint64_t m_previewVideoExportTotalFrames = 0;
     uint64_t m_previewVideoExportCapturedFrames = 0;
-    int64_t m_previewVideoExportPendingFrameIndex = -1;
     uint32_t m_previewVideoExportReadbackRowPitch = 0;
     uint64_t m_previewVideoExportReadbackBytes = 0;
-    std::string m_previewVideoExportFramesDir;
     std::string m_previewVideoExportOutputPath;
     std::string m_previewVideoExportStatus;
     int m_previewVideoResolutionPresetIndex = 1;
     int m_previewVideoFpsPresetIndex = 1;
     bool m_previewVideoExportUseFullTimeline = true;
     float m_previewVideoExportSeconds = 10.0f;
-    ComPtr<ID3D12Resource> m_previewVideoExportReadbackBuffer;
+    // Persistently mapped readback ring: slot i % size holds frame i until the export worker
+    // has consumed it, so the GPU copies the next frames while the worker converts and encodes.
+    static constexpr size_t kPreviewVideoExportRingSize = 3;
+    std::array<ComPtr<ID3D12Resource>, kPreviewVideoExportRingSize> m_previewVideoExportReadback;
+    std::array<uint8_t*, kPreviewVideoExportRingSize> m_previewVideoExportMapped{};
+    // Declared after the ring so it stops reading mapped memory before the ring is released.
+    std::unique_ptr<VideoExportPipeline> m_previewVideoExport;
 
     // Transport snapshot for export restore
     PreviewTransport m_previewVideoExportSavedTransport;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -13,13 +14,18 @@ struct ShaderPreset {
     std::string code;
     std::string filePath;
     std::string stem;
+    uint64_t contentHash = 0; // HashShaderText(code)
 };
 
 extern const int kPostFxHistoryCount;
 extern const int kMaxPostFxChain;
 extern const int kAboutSrvIndex;
 
-void InitializePresetService(const std::string& workspaceRoot, const std::string& appRoot);
+class AssetCatalog;
+
+// Registers (or re-roots) the preset folders in `catalog` and waits for their first scan.
+void InitializePresetService(AssetCatalog& catalog, const std::string& workspaceRoot, const std::string& appRoot);
+// Picks up preset folder changes the catalog has already scanned; never touches the disk.
 void RefreshPresetService();
 
 const std::vector<ShaderPreset>& GetScenePresets();
@@ -36,4 +42,15 @@ std::string GetTransitionDisplayNameByStem(const std::string& stem);
 
 std::string GetEditorTransitionShaderSourceByStem(const std::string& stem);
 
+// A pixel shader the preview renderer can draw on its own (tutorial examples, snippets).
+bool LooksLikeSceneContract(const std::string& code);
+// Beat clock of the tutorial preview and shader thumbnails, which have no transport.
+void ComputeTutTiming(double timeSeconds,
+                      float bpm,
+                      float& outIBeat,
+                      float& outIBar,
+                      float& outFBeat,
+                      float& outFBarBeat,
+                      float& outFBarBeat16);
+
 } // namespace ShaderLab
@@ -6,15 +6,15 @@
 namespace ShaderLab {
 
 inline const TrackerRow* FindNextSceneRow(const DemoTrack& track, int afterBeat) {
-    const TrackerRow* bestRow = nullptr;
-    int bestBeat = INT_MAX;
-    for (const auto& row : track.rows) {
-        if (row.sceneIndex >= 0 && row.rowId > afterBeat && row.rowId < bestBeat) {
-            bestBeat = row.rowId;
-            bestRow = &row;
+    if (afterBeat == INT_MAX) {
+        return nullptr;
+    }
+    for (auto it = track.rows.LowerBound(afterBeat + 1); it != track.rows.end(); ++it) {
+        if (it->sceneIndex >= 0) {
+            return &*it;
         }
     }
-    return bestRow;
+    return nullptr;
 }
 
 inline int FindNextSceneIndex(const DemoTrack& track, int afterBeat) {
@@ -7,6 +7,7 @@
 #include "ShaderLab/Audio/AudioSystem.h"
 #include "ShaderLab/Audio/BeatClock.h"
 #include "ShaderLab/Shader/ShaderCompiler.h"
+#include "ShaderLab/Core/ShaderBytecodeCache.h"
 
 #include <dwmapi.h>
 #include <windowsx.h>
@@ -129,6 +130,10 @@ bool ShaderLabApp::Initialize(HWND hwnd, uint32_t width, uint32_t height) {
     // Pass preview renderer to UI system
     m_ui->SetPreviewRenderer(m_previewRenderer.get());
     m_ui->SetAudioSystem(m_audio.get());
+    if (!m_bytecodeCache) {
+        m_bytecodeCache = std::make_unique<ShaderBytecodeCache>();
+    }
+    m_ui->SetBytecodeCache(m_bytecodeCache.get());
     m_ui->SetRestartCallback([this](int index) { RequestRestart(index); });
 
     f = fopen(logPath.c_str(), "a");
@@ -261,7 +266,10 @@ void ShaderLabApp::Render() {
     const bool previewVsyncEnabled = m_ui ? m_ui->IsPreviewVsyncEnabled() : true;
     m_swapchain->Present(previewVsyncEnabled);
 
-    // Wait for GPU (simple approach for now)
+    // Only the players keep frames in flight. The IDE still rewrites its scene binding, compute
+    // and thumbnail heaps and the compute constant buffer in place, and frees scene targets
+    // without deferral, so it stays on a single frame context and waits here until those move
+    // onto the descriptor and upload rings.
     m_commandQueue->WaitForGPU();
 }
 
@@ -5,6 +5,8 @@
 
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/RenderGraphExecutor.h"
 
 namespace ShaderLab {
 
@@ -49,168 +51,93 @@ void ComputeShaderMusicalTimingEffectChains(const Transport& transport,
 
 } // namespace
 
-ID3D12Resource* DemoPlayer::ApplyPostFxChain(ID3D12GraphicsCommandList* commandList,
-                                            Scene& scene,
-                                            ID3D12Resource* inputTexture,
-                                            double timeSeconds) {
-    if (!commandList || !inputTexture) return inputTexture;
+// History is a ring of kPostFxHistoryCount + 1 textures per effect: each frame the effect renders
+// into the oldest slot, which becomes the newest history entry next frame, so nothing is copied.
+// Slots that have not been rendered yet read the pass input; iHistoryFrames tells the shader how
+// many history slots hold real frames.
+uint32_t DemoPlayer::DeclarePostFxChain(Scene& scene, uint32_t input, double timeSeconds) {
+    if (input == RenderGraph::kInvalid) return input;
 
     bool anyEnabled = false;
     for (const auto& fx : scene.postFxChain) {
         if (fx.enabled) { anyEnabled = true; break; }
     }
-    if (!anyEnabled) return inputTexture;
+    if (!anyEnabled) return input;
 
     EnsurePostFxResources(scene);
-    if (!scene.postFxTextureA || !scene.postFxTextureB || !scene.postFxSrvHeap || !scene.postFxRtvHeap) return inputTexture;
-
-    auto device = m_device->GetDevice();
-    auto handleStep = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    auto startHandle = scene.postFxSrvHeap->GetCPUDescriptorHandleForHeapStart();
-
-    auto bindInput = [&](ID3D12Resource* src, Scene::PostFXEffect& fx, int baseSlot) {
-        D3D12_CPU_DESCRIPTOR_HANDLE dest = startHandle;
-        dest.ptr += baseSlot * handleStep;
-        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-        srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MipLevels = 1;
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        device->CreateShaderResourceView(src, &srvDesc, dest);
-
-        for (int i = 1; i <= kPostFxHistoryCountEffectChains; ++i) {
-            int historySlot = i;
-            int historyIndex = fx.historyIndex - (i - 1);
-            while (historyIndex < 0) historyIndex += kPostFxHistoryCountEffectChains;
-            ID3D12Resource* historyRes = nullptr;
-            if (!fx.historyTextures.empty()) {
-                historyRes = fx.historyTextures[historyIndex].Get();
-            }
-
-            D3D12_CPU_DESCRIPTOR_HANDLE histDest = startHandle;
-            histDest.ptr += (baseSlot + historySlot) * handleStep;
-            if (historyRes) {
-                device->CreateShaderResourceView(historyRes, &srvDesc, histDest);
-            } else if (m_dummySrvHeap) {
-                device->CopyDescriptorsSimple(1, histDest, m_dummySrvHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-            }
-        }
-
-        for (int i = kPostFxHistoryCountEffectChains + 1; i < 8; ++i) {
-            D3D12_CPU_DESCRIPTOR_HANDLE dummyDest = startHandle;
-            dummyDest.ptr += (baseSlot + i) * handleStep;
-            if (m_dummySrvHeap) {
-                device->CopyDescriptorsSimple(1, dummyDest, m_dummySrvHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-            }
-        }
-    };
-
-    ID3D12Resource* ping = scene.postFxTextureA.Get();
-    ID3D12Resource* pong = scene.postFxTextureB.Get();
-    ID3D12Resource* currentInput = inputTexture;
-    ID3D12Resource* currentOutput = ping;
+    if (!scene.postFxRtvHeap || !m_descriptorRing) return input;
 
+    constexpr int kRingSize = kPostFxHistoryCountEffectChains + 1;
+    uint32_t currentInput = input;
     int passIndex = 0;
-    for (auto& fx : scene.postFxChain) {
-        if (!fx.enabled) continue;
-        if (!fx.pipelineState) continue;
+    for (auto& effect : scene.postFxChain) {
+        if (!effect.enabled) continue;
+        if (!effect.pipelineState) continue;
         if (passIndex >= kMaxPostFxChainEffectChains) break;
 
-        EnsurePostFxHistory(fx);
-        if (fx.historyTextures.empty()) continue;
-
-        if (!fx.historyInitialized) {
-            for (int i = 0; i < kPostFxHistoryCountEffectChains; ++i) {
-                D3D12_RESOURCE_BARRIER initBarriers[2] = {};
-                initBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-                initBarriers[0].Transition.pResource = currentInput;
-                initBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-                initBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-                initBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-
-                initBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-                initBarriers[1].Transition.pResource = fx.historyTextures[i].Get();
-                initBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-                initBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-                initBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-                commandList->ResourceBarrier(2, initBarriers);
-
-                commandList->CopyResource(fx.historyTextures[i].Get(), currentInput);
-
-                std::swap(initBarriers[0].Transition.StateBefore, initBarriers[0].Transition.StateAfter);
-                std::swap(initBarriers[1].Transition.StateBefore, initBarriers[1].Transition.StateAfter);
-                commandList->ResourceBarrier(2, initBarriers);
+        EnsurePostFxHistory(effect);
+        if (effect.historyTextures.size() != kRingSize) continue;
+
+        Scene::PostFXEffect* fx = &effect;
+        const int writeIndex = (fx->historyIndex + 1) % kRingSize;
+        const int historyFrames = fx->historyFrames;
+        const uint32_t output = m_renderGraph->Import("post-fx ring", fx->historyTextures[writeIndex].Get());
+
+        Scene* owner = &scene;
+        const uint32_t pass = m_renderGraph->AddPass(fx->name.empty() ? "post-fx" : fx->name.c_str(), [this, owner, fx, writeIndex, historyFrames, currentInput, timeSeconds](ID3D12GraphicsCommandList* cmd) {
+            ID3D12Resource* src = m_renderGraph->GetResource(currentInput);
+            ID3D12Resource* dst = fx->historyTextures[writeIndex].Get();
+
+            // Slot 0 is the pass input, 1..N the effect's history (newest first), the rest the dummy texture.
+            D3D12_CPU_DESCRIPTOR_HANDLE sources[8] = {};
+            bool sourcesReady = m_descriptorRing->GetTexture2DSrv(src, DXGI_FORMAT_R8G8B8A8_UNORM, sources[0]);
+            for (int i = 1; i < 8 && sourcesReady; ++i) {
+                ID3D12Resource* historyRes = m_dummyTexture.Get();
+                if (i <= kPostFxHistoryCountEffectChains) {
+                    historyRes = i <= historyFrames ? fx->historyTextures[(writeIndex - i + kRingSize) % kRingSize].Get() : src;
+                }
+                sourcesReady = m_descriptorRing->GetTexture2DSrv(historyRes, DXGI_FORMAT_R8G8B8A8_UNORM, sources[i]);
             }
-            fx.historyInitialized = true;
-            fx.historyIndex = 0;
+            D3D12_GPU_DESCRIPTOR_HANDLE srvGpu = {};
+            if (sourcesReady) {
+                BindSrvTable(cmd, sources, 8, srvGpu);
+            }
+
+            D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = owner->postFxRtvHeap->GetCPUDescriptorHandleForHeapStart();
+            m_device->GetDevice()->CreateRenderTargetView(dst, nullptr, rtvHandle);
+
+            float iBeat = 0.0f;
+            float iBar = 0.0f;
+            float fBeat = 0.0f;
+            float fBarBeat = 0.0f;
+            float fBarBeat16 = 0.0f;
+            ComputeShaderMusicalTimingEffectChains(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
+            m_renderer->Render(
+                cmd,
+                fx->pipelineState.Get(),
+                dst,
+                rtvHandle,
+                srvGpu,
+                m_width, m_height,
+                (float)timeSeconds,
+                iBeat,
+                iBar,
+                fBarBeat16,
+                fBeat,
+                fBarBeat,
+                static_cast<uint32_t>(historyFrames)
+            );
+        });
+        m_renderGraph->Read(pass, currentInput);
+        for (int i = 1; i <= historyFrames; ++i) {
+            m_renderGraph->Read(pass, m_renderGraph->Import("post-fx ring", fx->historyTextures[(writeIndex - i + kRingSize) % kRingSize].Get()));
         }
+        m_renderGraph->Write(pass, output);
 
-        D3D12_RESOURCE_BARRIER barrier = {};
-        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        barrier.Transition.pResource = currentOutput;
-        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        commandList->ResourceBarrier(1, &barrier);
-
-        int baseSlot = passIndex * 8;
-        bindInput(currentInput, fx, baseSlot);
-        ID3D12DescriptorHeap* heaps[] = { scene.postFxSrvHeap.Get() };
-        commandList->SetDescriptorHeaps(1, heaps);
-
-        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = scene.postFxRtvHeap->GetCPUDescriptorHandleForHeapStart();
-        m_device->GetDevice()->CreateRenderTargetView(currentOutput, nullptr, rtvHandle);
-
-        D3D12_GPU_DESCRIPTOR_HANDLE srvGpu = scene.postFxSrvHeap->GetGPUDescriptorHandleForHeapStart();
-        srvGpu.ptr += baseSlot * handleStep;
-        float iBeat = 0.0f;
-        float iBar = 0.0f;
-        float fBeat = 0.0f;
-        float fBarBeat = 0.0f;
-        float fBarBeat16 = 0.0f;
-        ComputeShaderMusicalTimingEffectChains(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
-        m_renderer->Render(
-            commandList,
-            fx.pipelineState.Get(),
-            currentOutput,
-            rtvHandle,
-            srvGpu,
-            m_width, m_height,
-            (float)timeSeconds,
-            iBeat,
-            iBar,
-            fBarBeat16,
-            fBeat,
-            fBarBeat
-        );
-
-        std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
-        commandList->ResourceBarrier(1, &barrier);
-
-        int writeIndex = (fx.historyIndex + 1) % kPostFxHistoryCountEffectChains;
-        D3D12_RESOURCE_BARRIER historyBarriers[2] = {};
-        historyBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        historyBarriers[0].Transition.pResource = currentOutput;
-        historyBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        historyBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        historyBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-
-        historyBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        historyBarriers[1].Transition.pResource = fx.historyTextures[writeIndex].Get();
-        historyBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        historyBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-        historyBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        commandList->ResourceBarrier(2, historyBarriers);
-
-        commandList->CopyResource(fx.historyTextures[writeIndex].Get(), currentOutput);
-
-        std::swap(historyBarriers[0].Transition.StateBefore, historyBarriers[0].Transition.StateAfter);
-        std::swap(historyBarriers[1].Transition.StateBefore, historyBarriers[1].Transition.StateAfter);
-        commandList->ResourceBarrier(2, historyBarriers);
-        fx.historyIndex = writeIndex;
-
-        currentInput = currentOutput;
-        currentOutput = (currentOutput == ping) ? pong : ping;
+        fx->historyIndex = writeIndex;
+        fx->historyFrames = (std::min)(historyFrames + 1, kPostFxHistoryCountEffectChains);
+        fx->historyInitialized = true;
+        currentInput = output;
         passIndex++;
     }
 
@@ -218,4 +145,4 @@ ID3D12Resource* DemoPlayer::ApplyPostFxChain(ID3D12GraphicsCommandList* commandL
     return currentInput;
 }
 
-}
\ No newline at end of file
+} // namespace ShaderLab
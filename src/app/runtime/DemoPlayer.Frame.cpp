@@ -4,9 +4,16 @@
 #include <cmath>
 #include <cctype>
 
+#include "ShaderLab/Core/DynamicResolution.h"
 #include "ShaderLab/Core/PackageManager.h"
+#include "ShaderLab/Graphics/TransientTargetService.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/FrameUploadRing.h"
+#include "ShaderLab/Graphics/RenderGraphExecutor.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Audio/AudioSystem.h"
 
 #ifndef SHADERLAB_RUNTIME_IMGUI
 #define SHADERLAB_RUNTIME_IMGUI 1
@@ -80,6 +87,51 @@ std::string CanonicalTransitionStemFrame(const std::string& transitionPresetStem
     return stem;
 }
 
+#if SHADERLAB_RUNTIME_IMGUI && !SHADERLAB_TINY_PLAYER
+constexpr uint32_t kTraceCaptureFramesFrame = 120;
+constexpr const char* kTraceCapturePathFrame = "shaderlab_trace.json";
+
+// One row per scope depth, bars scaled to the track's span in the last complete frame. Hovering
+// a bar shows the scope's rolling statistics.
+void DrawProfilerTrackFrame(const FrameProfiler& profiler, ProfileTrack track, std::vector<ProfileFlameBar>& bars) {
+    profiler.BuildFlame(track, bars);
+    const ProfileFrame* frame = profiler.GetLastFrame();
+    double totalMs = 0.0;
+    uint32_t rows = 1;
+    for (const ProfileFlameBar& bar : bars) {
+        if (bar.depth == 0) totalMs += bar.durationMs;
+        rows = (std::max)(rows, bar.depth + 1);
+    }
+    if (track == ProfileTrack::Cpu && frame) {
+        totalMs = frame->cpuDurationUs / 1000.0;
+    }
+    ImGui::Text("%s %.2f ms", track == ProfileTrack::Cpu ? "CPU" : "GPU", totalMs);
+
+    const float rowHeight = ImGui::GetTextLineHeight() + 2.0f;
+    const float width = 420.0f;
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(ImVec2(width, rowHeight * static_cast<float>(rows)));
+    const bool hovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (const ProfileFlameBar& bar : bars) {
+        const ImVec2 min(origin.x + bar.x0 * width, origin.y + static_cast<float>(bar.depth) * rowHeight);
+        const ImVec2 max((std::max)(origin.x + bar.x1 * width, min.x + 1.0f), min.y + rowHeight - 1.0f);
+        const uint32_t hash = (bar.name + 1u) * 2654435761u;
+        drawList->AddRectFilled(min, max, IM_COL32(70 + (hash >> 8) % 120, 70 + (hash >> 16) % 120, 130 + (hash >> 24) % 110, 230));
+        const std::string& name = profiler.GetName(bar.name);
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(255, 255, 255, 255), name.c_str());
+        drawList->PopClipRect();
+        if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+            const ProfileScopeStats& stats = profiler.GetStats()[bar.stat];
+            ImGui::SetTooltip("%s\nlast %.3f ms\navg %.3f ms  p95 %.3f ms  max %.3f ms (%u frames)",
+                              name.c_str(), stats.lastMs, stats.avgMs, stats.p95Ms, stats.maxMs, stats.samples);
+        }
+    }
+}
+#endif
+
 } // namespace
 
 void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle) {
@@ -91,39 +143,49 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
         }
     }
 
-    auto copyTextureToBackbuffer = [&](ID3D12Resource* srcTexture) -> bool {
-        if (!srcTexture || !renderTarget) {
-            return false;
-        }
-
-        const auto srcDesc = srcTexture->GetDesc();
-        const auto dstDesc = renderTarget->GetDesc();
-        if (srcDesc.Width != dstDesc.Width || srcDesc.Height != dstDesc.Height || srcDesc.Format != dstDesc.Format) {
-            return false;
+    // Without SetGpuFrame the caller waits for the GPU after every frame.
+    if (!m_externalFrameClock) {
+        m_completedFrameIndex = static_cast<int64_t>(m_frameIndex) - 1;
+    }
+    m_deferredReleases.Collect(m_completedFrameIndex);
+    if (m_transientTargets) {
+        m_transientTargets->BeginFrame(m_frameIndex, m_completedFrameIndex);
+    }
+    if (m_descriptorRing) {
+        m_descriptorRing->BeginFrame(m_frameIndex, m_completedFrameIndex);
+    }
+    if (m_uploadRing) {
+        m_uploadRing->BeginFrame(m_frameIndex, m_completedFrameIndex);
+    }
+#if !SHADERLAB_TINY_PLAYER
+    if (m_audio && m_renderer) {
+        m_renderer->SetAudioConstants(m_audio->GetAnalysisBlock());
+    }
+#endif
+#if !SHADERLAB_TINY_PLAYER
+    if (m_profiler) {
+        m_profiler->BeginFrame(m_frameIndex, m_completedFrameIndex);
+        if (m_traceCapturePending && !m_profiler->GetProfiler().IsCapturing()) {
+            m_traceCapturePending = false;
+            std::string traceError;
+            m_traceStatus = m_profiler->GetProfiler().WriteChromeTrace(kTraceCapturePathFrame, traceError)
+                ? std::string("Trace written to ") + kTraceCapturePathFrame
+                : traceError;
         }
-
-        D3D12_RESOURCE_BARRIER dstBarrier = {};
-        dstBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        dstBarrier.Transition.pResource = renderTarget;
-        dstBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
-        dstBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-        cmd->ResourceBarrier(1, &dstBarrier);
-
-        D3D12_RESOURCE_BARRIER srcBarrier = {};
-        srcBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        srcBarrier.Transition.pResource = srcTexture;
-        srcBarrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        srcBarrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-        cmd->ResourceBarrier(1, &srcBarrier);
-
-        cmd->CopyResource(renderTarget, srcTexture);
-
-        std::swap(dstBarrier.Transition.StateBefore, dstBarrier.Transition.StateAfter);
-        cmd->ResourceBarrier(1, &dstBarrier);
-        std::swap(srcBarrier.Transition.StateBefore, srcBarrier.Transition.StateAfter);
-        cmd->ResourceBarrier(1, &srcBarrier);
-        return true;
-    };
+    }
+    UpdateDynamicResolution(renderTarget);
+#endif
+    bool executeGraph = false;
+    bool declareScopeOpen = false;
+    uint32_t backbuffer = RenderGraph::kInvalid;
+    // Below the output size the final pass resamples into the backbuffer.
+    bool upscaleOutput = false;
+#if !SHADERLAB_TINY_PLAYER
+    if (renderTarget && m_dynamicResolutionTargetMs > 0.0) {
+        const D3D12_RESOURCE_DESC outputDesc = renderTarget->GetDesc();
+        upscaleOutput = (outputDesc.Width != m_width || outputDesc.Height != m_height) && EnsureUpscalePipeline();
+    }
+#endif
 
     auto renderSceneDirectToBackbuffer = [&](int sceneIndex, double sceneTime) -> bool {
         if (sceneIndex < 0 || sceneIndex >= static_cast<int>(m_project.scenes.size())) {
@@ -131,7 +193,7 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
         }
 
         auto& scene = m_project.scenes[static_cast<size_t>(sceneIndex)];
-        if (!scene.pipelineState || !scene.postFxChain.empty()) {
+        if (upscaleOutput || !scene.pipelineState || !scene.postFxChain.empty()) {
             return false;
         }
 
@@ -146,9 +208,12 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
         float fBarBeat16 = 0.0f;
         ComputeShaderMusicalTimingFrame(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
 
-        if (scene.srvHeap) {
-            ID3D12DescriptorHeap* heaps[] = { scene.srvHeap.Get() };
-            cmd->SetDescriptorHeaps(1, heaps);
+        // No bindings: every channel reads a null view.
+        D3D12_GPU_DESCRIPTOR_HANDLE srvTable = {};
+        D3D12_CPU_DESCRIPTOR_HANDLE nullSrv = {};
+        if (m_descriptorRing && m_descriptorRing->GetTexture2DSrv(nullptr, DXGI_FORMAT_R8G8B8A8_UNORM, nullSrv)) {
+            const D3D12_CPU_DESCRIPTOR_HANDLE sources[8] = { nullSrv, nullSrv, nullSrv, nullSrv, nullSrv, nullSrv, nullSrv, nullSrv };
+            BindSrvTable(cmd, sources, 8, srvTable);
         }
 
         m_renderer->Render(
@@ -156,7 +221,7 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
             scene.pipelineState.Get(),
             renderTarget,
             rtvHandle,
-            scene.srvHeap ? scene.srvHeap->GetGPUDescriptorHandleForHeapStart() : D3D12_GPU_DESCRIPTOR_HANDLE{},
+            srvTable,
             m_width,
             m_height,
             static_cast<float>(sceneTime),
@@ -182,6 +247,9 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
 
         m_dummyTextureInitialized = true;
     }
+#if !SHADERLAB_TINY_PLAYER
+    RecordTextureUploads(cmd);
+#endif
 
 #if SHADERLAB_RUNTIME_IMGUI
     auto loadingStageLabel = [&](LoadingStage stage) -> const char* {
@@ -201,7 +269,7 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
 
 #if !SHADERLAB_TINY_PLAYER
     ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f), ImGuiCond_Always);
-    ImGui::SetNextWindowSize(ImVec2(static_cast<float>(m_width), 34.0f), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x, 34.0f), ImGuiCond_Always);
     ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0.0f);
     ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0.0f);
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 7.0f));
@@ -237,9 +305,66 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
                 ImGui::Separator();
                 ImGui::TextColored(ImVec4(1,1,0,1), "Loading Stage: %d", (int)m_loadingStage);
             } else {
-                ImGui::Text("Scene: %d", m_activeSceneIndex);
-                if (m_transitionActive) ImGui::TextColored(ImVec4(0.4f,1.0f,0.4f,1.0f), "Transition Active");
+                ImGui::Text("Scene: %d", m_sequencer.GetState().activeSceneIndex);
+                if (m_sequencer.GetState().transitionActive) ImGui::TextColored(ImVec4(0.4f,1.0f,0.4f,1.0f), "Transition Active");
+                if (m_residencyPlanValid) {
+                    ImGui::Text("Scene targets: %.1f MB peak / %.1f MB eager",
+                                static_cast<double>(m_residencyPlan.peakBytes) / (1024.0 * 1024.0),
+                                static_cast<double>(m_residencyPlan.eagerBytes) / (1024.0 * 1024.0));
+                }
+                if (m_transientTargets) {
+                    const auto& pool = m_transientTargets->GetStats();
+                    ImGui::Text("Transient targets: %zu live, %.1f MB (%llu created, %llu reused)",
+                                pool.liveTargets,
+                                static_cast<double>(pool.liveBytes) / (1024.0 * 1024.0),
+                                static_cast<unsigned long long>(pool.createCount),
+                                static_cast<unsigned long long>(pool.reuseCount));
+                }
+                if (m_descriptorRing) {
+                    const auto& descriptors = m_descriptorRing->GetStats();
+                    ImGui::Text("Descriptors/frame: %llu views written, %llu copied (%zu cached)",
+                                static_cast<unsigned long long>(descriptors.lastFrame.viewsWritten),
+                                static_cast<unsigned long long>(descriptors.lastFrame.descriptorsCopied),
+                                descriptors.cachedViews);
+                }
+                if (m_renderGraph) {
+                    const auto& graph = m_renderGraph->GetStats();
+                    ImGui::Text("Render graph: %u passes (%u culled), %u barriers in %u batches",
+                                graph.passesDeclared, graph.passesCulled, graph.barriers, graph.barrierBatches);
+                    if (!m_renderGraphError.empty()) {
+                        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", m_renderGraphError.c_str());
+                    }
+                }
+#if !SHADERLAB_TINY_PLAYER
+                if (m_dynamicResolution) {
+                    ImGui::Text("Dynamic resolution: %ux%u (%.0f%%), GPU %.2f / %.1f ms",
+                                m_width, m_height, m_dynamicResolution->GetScale() * 100.0,
+                                m_dynamicResolution->GetFilteredMs(), m_dynamicResolution->GetSettings().targetMs);
+                }
+#endif
+                ImGui::Text("Frames queued on GPU: %lld (%zu deferred releases)",
+                            static_cast<long long>(m_frameIndex) - m_completedFrameIndex - 1,
+                            m_deferredReleases.GetPendingCount());
             }
+#if !SHADERLAB_TINY_PLAYER
+            if (m_profiler) {
+                ImGui::Separator();
+                const FrameProfiler& profiler = m_profiler->GetProfiler();
+                DrawProfilerTrackFrame(profiler, ProfileTrack::Cpu, m_flameBars);
+                if (m_profiler->IsInitialized()) {
+                    DrawProfilerTrackFrame(profiler, ProfileTrack::Gpu, m_flameBars);
+                }
+                if (m_traceCapturePending) {
+                    ImGui::Text("Capturing trace: %u / %u frames", profiler.GetCapturedFrameCount(), kTraceCaptureFramesFrame);
+                } else if (ImGui::Button("Capture trace")) {
+                    m_profiler->GetProfiler().BeginCapture(kTraceCaptureFramesFrame);
+                    m_traceCapturePending = true;
+                }
+                if (!m_traceStatus.empty()) {
+                    ImGui::TextUnformatted(m_traceStatus.c_str());
+                }
+            }
+#endif
         }
         ImGui::End();
     }
@@ -258,8 +383,8 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
         ImGui::Text("Time: %.2f s", m_transport.timeSeconds);
         ImGui::Text("Load: %d  Scene: %d  Transition: %s",
             static_cast<int>(m_loadingStage),
-            m_activeSceneIndex,
-            m_transitionActive ? "on" : "off");
+            m_sequencer.GetState().activeSceneIndex,
+            m_sequencer.GetState().transitionActive ? "on" : "off");
 
         ImGui::Separator();
         ImGui::BeginChild("tiny_dev_log", ImVec2(640.0f, 220.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
@@ -306,121 +431,137 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
         goto render_ui;
     }
 
-    m_renderStack.clear();
+    if (!m_renderGraph) {
+        float clearColor[] = {0, 0, 0, 1};
+        cmd->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
+        goto render_ui;
+    }
+    m_renderGraph->Reset();
+#if !SHADERLAB_TINY_PLAYER
+    if (m_profiler) {
+        m_profiler->GetProfiler().BeginCpuScope("declare graph");
+        declareScopeOpen = true;
+    }
+#endif
+    m_graphSceneTextures.assign(m_project.scenes.size(), RenderGraph::kInvalid);
+    m_graphSceneOutputs.assign(m_project.scenes.size(), RenderGraph::kInvalid);
+    backbuffer = m_renderGraph->Import("backbuffer", renderTarget, RenderGraphAccessRenderTarget, RenderGraphAccessRenderTarget);
 
-    if (m_transitionActive) {
+    if (m_sequencer.GetState().transitionActive) {
+        const SequencerState& transition = m_sequencer.GetState();
         float beatsPerSec = m_transport.bpm / 60.0f;
         double exactBeat = m_transport.timeSeconds * beatsPerSec;
-        double progress = (exactBeat - m_transitionStartBeat) / m_transitionDurationBeats;
-
-        if (progress >= 1.0) {
-            m_transitionActive = false;
-            if (m_pendingActiveScene != -2) {
-                SetActiveScene(m_pendingActiveScene);
-                m_activeSceneStartBeat = m_transitionToStartBeat;
-                m_activeSceneOffset = (m_pendingActiveScene >= 0) ? m_transitionToOffset : 0.0f;
-                m_pendingActiveScene = -2;
-            }
-        } else {
-            ID3D12Resource* fromTex = nullptr;
-            ID3D12Resource* toTex = nullptr;
 
-            if (m_transitionFromIndex >= 0) {
-                const double fromTime = SceneTimeSecondsFrame(exactBeat, m_transitionFromStartBeat, m_transitionFromOffset, m_transport.bpm);
-                fromTex = GetSceneFinalTexture(cmd, m_transitionFromIndex, fromTime);
+        // Once the blend is done the new active scene renders below.
+        m_sequencer.CompleteDueTransition(exactBeat, -1);
+        if (transition.transitionActive) {
+            const float progress = m_sequencer.GetTransitionProgress(exactBeat);
+            uint32_t fromRes = RenderGraph::kInvalid;
+            uint32_t toRes = RenderGraph::kInvalid;
+
+            if (transition.transitionFromIndex >= 0) {
+                const double fromTime = SceneTimeSecondsFrame(exactBeat, transition.transitionFromStartBeat, transition.transitionFromOffset, m_transport.bpm);
+                fromRes = DeclareSceneFinal(transition.transitionFromIndex, fromTime);
             }
-            if (m_transitionToIndex >= 0) {
-                const double toTime = SceneTimeSecondsFrame(exactBeat, m_transitionToStartBeat, m_transitionToOffset, m_transport.bpm);
-                toTex = GetSceneFinalTexture(cmd, m_transitionToIndex, toTime);
+            if (transition.transitionToIndex >= 0) {
+                const double toTime = SceneTimeSecondsFrame(exactBeat, transition.transitionToStartBeat, transition.transitionToOffset, m_transport.bpm);
+                toRes = DeclareSceneFinal(transition.transitionToIndex, toTime);
             }
 
-            const std::string canonicalTransitionStem = CanonicalTransitionStemFrame(m_currentTransitionStem);
+            const std::string canonicalTransitionStem = CanonicalTransitionStemFrame(transition.transitionPresetStem);
             if (!m_transitionPSO || m_compiledTransitionStem != canonicalTransitionStem) {
                 EnsureTransitionPipeline(canonicalTransitionStem);
             }
             if (m_transitionPSO) {
-                if (!m_transitionSrvHeap) {
-                    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-                    heapDesc.NumDescriptors = 8;
-                    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-                    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-                    m_device->GetDevice()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_transitionSrvHeap));
-                }
-                auto device = m_device->GetDevice();
-                auto handleStep = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                auto start = m_transitionSrvHeap->GetCPUDescriptorHandleForHeapStart();
-
-                auto Bind = [&](ID3D12Resource* res, int slot) {
-                    D3D12_CPU_DESCRIPTOR_HANDLE dest = start;
-                    dest.ptr += slot * handleStep;
-                    if (!res) {
-                        if (m_dummySrvHeap) {
-                            device->CopyDescriptorsSimple(1, dest, m_dummySrvHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                        } else {
-                            D3D12_SHADER_RESOURCE_VIEW_DESC nullSrv = {};
-                            nullSrv.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-                            nullSrv.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-                            nullSrv.Texture2D.MipLevels = 1;
-                            nullSrv.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-                            device->CreateShaderResourceView(nullptr, &nullSrv, dest);
-                        }
-                        return;
+                const uint32_t target = upscaleOutput
+                    ? m_renderGraph->CreateTexture("transition", m_width, m_height, DXGI_FORMAT_R8G8B8A8_UNORM, D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET)
+                    : backbuffer;
+                const uint32_t pass = m_renderGraph->AddPass("transition", [this, fromRes, toRes, progress, target, renderTarget, rtvHandle, upscaleOutput](ID3D12GraphicsCommandList* commandList) {
+                    // Slots past the two scene inputs read the dummy texture.
+                    D3D12_CPU_DESCRIPTOR_HANDLE sources[8] = {};
+                    bool sourcesReady = m_descriptorRing != nullptr;
+                    ID3D12Resource* inputs[8] = { m_renderGraph->GetResource(fromRes), m_renderGraph->GetResource(toRes),
+                                                  m_dummyTexture.Get(), m_dummyTexture.Get(), m_dummyTexture.Get(),
+                                                  m_dummyTexture.Get(), m_dummyTexture.Get(), m_dummyTexture.Get() };
+                    for (int slot = 0; slot < 8 && sourcesReady; ++slot) {
+                        ID3D12Resource* res = inputs[slot] ? inputs[slot] : m_dummyTexture.Get();
+                        const DXGI_FORMAT format = res ? res->GetDesc().Format : DXGI_FORMAT_R8G8B8A8_UNORM;
+                        sourcesReady = m_descriptorRing->GetTexture2DSrv(res, format, sources[slot]);
+                    }
+                    D3D12_GPU_DESCRIPTOR_HANDLE srvTable = {};
+                    if (sourcesReady) {
+                        BindSrvTable(commandList, sources, 8, srvTable);
+                    }
+
+                    float iBeat = 0.0f;
+                    float iBar = 0.0f;
+                    float fBeat = 0.0f;
+                    float fBarBeat = 0.0f;
+                    float fBarBeat16 = 0.0f;
+                    ComputeShaderMusicalTimingFrame(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
+                    ID3D12Resource* targetResource = renderTarget;
+                    D3D12_CPU_DESCRIPTOR_HANDLE targetRtv = rtvHandle;
+                    if (upscaleOutput) {
+                        targetResource = m_renderGraph->GetResource(target);
+                        targetRtv = m_upscaleRtvHeap->GetCPUDescriptorHandleForHeapStart();
+                        m_device->GetDevice()->CreateRenderTargetView(targetResource, nullptr, targetRtv);
                     }
-                    D3D12_SHADER_RESOURCE_VIEW_DESC srv = {};
-                    srv.Format = res->GetDesc().Format;
-                    srv.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-                    srv.Texture2D.MipLevels = 1;
-                    srv.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-                    device->CreateShaderResourceView(res, &srv, dest);
-                };
-                Bind(fromTex, 0);
-                Bind(toTex, 1);
-
-                ID3D12DescriptorHeap* heaps[] = { m_transitionSrvHeap.Get() };
-                cmd->SetDescriptorHeaps(1, heaps);
-
-                float iBeat = 0.0f;
-                float iBar = 0.0f;
-                float fBeat = 0.0f;
-                float fBarBeat = 0.0f;
-                float fBarBeat16 = 0.0f;
-                ComputeShaderMusicalTimingFrame(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
-                m_renderer->Render(cmd,
-                                  m_transitionPSO.Get(),
-                                  renderTarget,
-                                  rtvHandle,
-                                  m_transitionSrvHeap->GetGPUDescriptorHandleForHeapStart(),
-                                  m_width,
-                                  m_height,
-                                  (float)progress,
-                                  iBeat,
-                                  iBar,
-                                  fBarBeat16,
-                                  fBeat,
-                                  fBarBeat);
+                    m_renderer->Render(commandList,
+                                      m_transitionPSO.Get(),
+                                      targetResource,
+                                      targetRtv,
+                                      srvTable,
+                                      m_width,
+                                      m_height,
+                                      progress,
+                                      iBeat,
+                                      iBar,
+                                      fBarBeat16,
+                                      fBeat,
+                                      fBarBeat);
+                });
+                if (fromRes != RenderGraph::kInvalid) m_renderGraph->Read(pass, fromRes);
+                if (toRes != RenderGraph::kInvalid) m_renderGraph->Read(pass, toRes);
+                m_renderGraph->Write(pass, target);
+                if (upscaleOutput) {
+                    DeclareUpscale(target, backbuffer, renderTarget, rtvHandle);
+                }
             } else {
                 float clearColor[] = {0, 0, 0, 1};
                 cmd->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
             }
+            executeGraph = true;
             goto render_ui;
         }
     }
 
-    if (m_activeSceneIndex >= 0) {
+    if (m_sequencer.GetState().activeSceneIndex >= 0) {
+        const SequencerState& sequencerState = m_sequencer.GetState();
         const double beatsPerSec = m_transport.bpm / 60.0f;
         const double exactBeat = m_transport.timeSeconds * beatsPerSec;
-        const double activeTime = SceneTimeSecondsFrame(exactBeat, m_activeSceneStartBeat, m_activeSceneOffset, m_transport.bpm);
+        const double activeTime = SceneTimeSecondsFrame(exactBeat, sequencerState.activeSceneStartBeat, sequencerState.activeSceneOffset, m_transport.bpm);
 
-        if (renderSceneDirectToBackbuffer(m_activeSceneIndex, activeTime)) {
+        if (renderSceneDirectToBackbuffer(sequencerState.activeSceneIndex, activeTime)) {
             goto render_ui;
         }
 
-        ID3D12Resource* finalTex = GetSceneFinalTexture(cmd, m_activeSceneIndex, activeTime);
-        if (finalTex) {
-            if (!copyTextureToBackbuffer(finalTex)) {
+        const uint32_t finalRes = DeclareSceneFinal(sequencerState.activeSceneIndex, activeTime);
+        if (finalRes != RenderGraph::kInvalid) {
+            // Post-FX/compute outputs and scene textures are RGBA8 at the output size.
+            const D3D12_RESOURCE_DESC dstDesc = renderTarget ? renderTarget->GetDesc() : D3D12_RESOURCE_DESC{};
+            if (dstDesc.Width == m_width && dstDesc.Height == m_height && dstDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM) {
+                const uint32_t pass = m_renderGraph->AddPass("copy to backbuffer", [this, finalRes, renderTarget](ID3D12GraphicsCommandList* commandList) {
+                    commandList->CopyResource(renderTarget, m_renderGraph->GetResource(finalRes));
+                });
+                m_renderGraph->Read(pass, finalRes, RenderGraphAccessCopySource);
+                m_renderGraph->Write(pass, backbuffer, RenderGraphAccessCopyDest);
+            } else if (upscaleOutput) {
+                DeclareUpscale(finalRes, backbuffer, renderTarget, rtvHandle);
+            } else {
                 float clearColor[] = {0, 0, 0, 1};
                 cmd->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
             }
+            executeGraph = true;
         }
     } else {
         float clearColor[] = {0,0,0,1};
@@ -428,15 +569,79 @@ void DemoPlayer::Render(ID3D12GraphicsCommandList* cmd, ID3D12Resource* renderTa
     }
 
 render_ui:
-    (void)0;
+#if !SHADERLAB_TINY_PLAYER
+    if (declareScopeOpen) {
+        m_profiler->GetProfiler().EndCpuScope();
+    }
+#else
+    (void)declareScopeOpen;
+#endif
+    if (executeGraph) {
+#if !SHADERLAB_TINY_PLAYER
+        ScopedCpuProfile executeScope(m_profiler ? &m_profiler->GetProfiler() : nullptr, "execute graph");
+#endif
+        m_renderGraphError.clear();
+        if (!m_renderGraph->Execute(cmd, m_renderGraphError)) {
+            float clearColor[] = {0, 0, 0, 1};
+            cmd->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
+        }
+    }
+    if (m_transientTargets) {
+        m_transientTargets->EndFrame();
+    }
+    if (m_descriptorRing) {
+        m_descriptorRing->EndFrame();
+    }
+    if (m_uploadRing) {
+        m_uploadRing->EndFrame();
+    }
+    if (!m_externalFrameClock) {
+        ++m_frameIndex;
+    }
 #if SHADERLAB_RUNTIME_IMGUI
     ImGui::Render();
     if (m_imguiSrvHeap) {
+#if !SHADERLAB_TINY_PLAYER
+        ScopedGpuProfile uiScope(m_profiler.get(), cmd, "ui");
+#endif
         ID3D12DescriptorHeap* heaps[] = { m_imguiSrvHeap.Get() };
         cmd->SetDescriptorHeaps(1, heaps);
         ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), cmd);
     }
 #endif
+#if !SHADERLAB_TINY_PLAYER
+    if (m_profiler) {
+        m_profiler->EndFrame(cmd);
+    }
+#endif
+}
+
+void DemoPlayer::DeclareUpscale(uint32_t source, uint32_t backbuffer, ID3D12Resource* renderTarget, D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle) {
+#if !SHADERLAB_TINY_PLAYER
+    const D3D12_RESOURCE_DESC outputDesc = renderTarget->GetDesc();
+    const uint32_t outputWidth = static_cast<uint32_t>(outputDesc.Width);
+    const uint32_t outputHeight = outputDesc.Height;
+    const uint32_t pass = m_renderGraph->AddPass("upscale", [this, source, renderTarget, rtvHandle, outputWidth, outputHeight](ID3D12GraphicsCommandList* commandList) {
+        D3D12_CPU_DESCRIPTOR_HANDLE sources[8] = {};
+        bool sourcesReady = m_descriptorRing != nullptr;
+        for (int slot = 0; slot < 8 && sourcesReady; ++slot) {
+            ID3D12Resource* res = slot == 0 ? m_renderGraph->GetResource(source) : m_dummyTexture.Get();
+            sourcesReady = m_descriptorRing->GetTexture2DSrv(res, DXGI_FORMAT_R8G8B8A8_UNORM, sources[slot]);
+        }
+        D3D12_GPU_DESCRIPTOR_HANDLE srvTable = {};
+        if (sourcesReady) {
+            BindSrvTable(commandList, sources, 8, srvTable);
+        }
+        m_renderer->Render(commandList, m_upscalePSO.Get(), renderTarget, rtvHandle, srvTable, outputWidth, outputHeight, 0.0f);
+    });
+    m_renderGraph->Read(pass, source);
+    m_renderGraph->Write(pass, backbuffer);
+#else
+    (void)source;
+    (void)backbuffer;
+    (void)renderTarget;
+    (void)rtvHandle;
+#endif
 }
 
 } // namespace ShaderLab
\ No newline at end of file
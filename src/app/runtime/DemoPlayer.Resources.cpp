@@ -3,7 +3,10 @@
 #include <algorithm>
 #include <cstring>
 
+#include "ShaderLab/Core/DynamicResolution.h"
 #include "ShaderLab/Graphics/Device.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
 
 namespace ShaderLab {
 
@@ -12,7 +15,6 @@ bool CreateRuntimeUavTexture(Device* deviceRef, uint32_t width, uint32_t height,
 namespace {
 
 constexpr int kPostFxHistoryCountResources = 4;
-constexpr int kMaxPostFxChainResources = 32;
 constexpr uint32_t kComputeHistorySlotsResources = 8;
 
 } // namespace
@@ -29,8 +31,9 @@ void DemoPlayer::EnsureSceneTexture(int sceneIndex) {
     }
 
     if (needsCreate) {
-        scene.texture.Reset();
-        scene.srvHeap.Reset();
+        // Frames still in flight may be reading the old size.
+        DeferRelease(std::move(scene.texture));
+        DeferRelease(std::move(scene.rtvHeap));
         scene.textureValid = false;
 
         D3D12_HEAP_PROPERTIES heapProps = { D3D12_HEAP_TYPE_DEFAULT };
@@ -54,12 +57,6 @@ void DemoPlayer::EnsureSceneTexture(int sceneIndex) {
             D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
             &clearValue, IID_PPV_ARGS(&scene.texture));
 
-        D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-        heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-        heapDesc.NumDescriptors = 8 * kMaxPostFxChainResources;
-        heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-        m_device->GetDevice()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&scene.srvHeap));
-
         D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
         rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
         rtvHeapDesc.NumDescriptors = 1;
@@ -71,54 +68,14 @@ void DemoPlayer::EnsureSceneTexture(int sceneIndex) {
     }
 }
 
+// Effects render into their history rings and SRV tables come from m_descriptorRing; only the
+// per-scene RTV heap lives here.
 void DemoPlayer::EnsurePostFxResources(Scene& scene) {
-    if (m_width == 0 || m_height == 0 || !m_device) return;
-
-    bool needsCreate = !scene.postFxTextureA || !scene.postFxTextureB;
-    if (scene.postFxTextureA) {
-        auto desc = scene.postFxTextureA->GetDesc();
-        if (desc.Width != m_width || desc.Height != m_height) needsCreate = true;
-    }
-    if (!needsCreate) return;
+    if (!m_device) return;
+    if (scene.postFxRtvHeap) return;
 
-    scene.postFxTextureA.Reset();
-    scene.postFxTextureB.Reset();
-    scene.postFxSrvHeap.Reset();
-    scene.postFxRtvHeap.Reset();
     scene.postFxValid = false;
 
-    D3D12_HEAP_PROPERTIES heapProps = { D3D12_HEAP_TYPE_DEFAULT };
-    D3D12_RESOURCE_DESC texDesc = {};
-    texDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
-    texDesc.Width = m_width;
-    texDesc.Height = m_height;
-    texDesc.DepthOrArraySize = 1;
-    texDesc.MipLevels = 1;
-    texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    texDesc.SampleDesc.Count = 1;
-    texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
-
-    float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
-    D3D12_CLEAR_VALUE clearValue = {};
-    clearValue.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    memcpy(clearValue.Color, clearColor, sizeof(clearColor));
-
-    m_device->GetDevice()->CreateCommittedResource(
-        &heapProps, D3D12_HEAP_FLAG_NONE, &texDesc,
-        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-        &clearValue, IID_PPV_ARGS(&scene.postFxTextureA));
-
-    m_device->GetDevice()->CreateCommittedResource(
-        &heapProps, D3D12_HEAP_FLAG_NONE, &texDesc,
-        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
-        &clearValue, IID_PPV_ARGS(&scene.postFxTextureB));
-
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.NumDescriptors = 8 * kMaxPostFxChainResources;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    m_device->GetDevice()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&scene.postFxSrvHeap));
-
     D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
     rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
     rtvHeapDesc.NumDescriptors = 1;
@@ -126,10 +83,37 @@ void DemoPlayer::EnsurePostFxResources(Scene& scene) {
     m_device->GetDevice()->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&scene.postFxRtvHeap));
 }
 
+bool DemoPlayer::BindSrvTable(ID3D12GraphicsCommandList* commandList,
+                              const D3D12_CPU_DESCRIPTOR_HANDLE* sources,
+                              uint32_t count,
+                              D3D12_GPU_DESCRIPTOR_HANDLE& outTable) {
+    outTable = D3D12_GPU_DESCRIPTOR_HANDLE{};
+    if (!m_descriptorRing || !m_descriptorRing->AllocateTable(sources, count, outTable)) return false;
+
+    ID3D12DescriptorHeap* heaps[] = { m_descriptorRing->GetHeap() };
+    commandList->SetDescriptorHeaps(1, heaps);
+    return true;
+}
+
+// Drops the ring through DeferRelease and restarts the history, so the shader sees its history
+// frame count (iHistoryFrames / historyFrames) climb from zero again.
+template <typename Effect>
+void DemoPlayer::ResetHistoryRing(Effect& effect) {
+    for (auto& history : effect.historyTextures) {
+        DeferRelease(std::move(history));
+    }
+    effect.historyTextures.clear();
+    effect.historyIndex = 0;
+    effect.historyInitialized = false;
+    effect.historyFrames = 0;
+}
+
 void DemoPlayer::EnsurePostFxHistory(Scene::PostFXEffect& effect) {
     if (!m_device || m_width == 0 || m_height == 0) return;
 
-    bool needsCreate = (int)effect.historyTextures.size() != kPostFxHistoryCountResources;
+    // One slot more than the shader reads: the effect renders into the oldest one.
+    constexpr int kRingSize = kPostFxHistoryCountResources + 1;
+    bool needsCreate = (int)effect.historyTextures.size() != kRingSize;
     if (!needsCreate) {
         auto desc = effect.historyTextures[0]->GetDesc();
         if (desc.Width != m_width || desc.Height != m_height) needsCreate = true;
@@ -137,10 +121,8 @@ void DemoPlayer::EnsurePostFxHistory(Scene::PostFXEffect& effect) {
 
     if (!needsCreate) return;
 
-    effect.historyTextures.clear();
-    effect.historyTextures.resize(kPostFxHistoryCountResources);
-    effect.historyIndex = 0;
-    effect.historyInitialized = false;
+    ResetHistoryRing(effect);
+    effect.historyTextures.resize(kRingSize);
 
     D3D12_HEAP_PROPERTIES heapProps = { D3D12_HEAP_TYPE_DEFAULT };
     D3D12_RESOURCE_DESC texDesc = {};
@@ -151,9 +133,9 @@ void DemoPlayer::EnsurePostFxHistory(Scene::PostFXEffect& effect) {
     texDesc.MipLevels = 1;
     texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
     texDesc.SampleDesc.Count = 1;
-    texDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+    texDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
 
-    for (int i = 0; i < kPostFxHistoryCountResources; ++i) {
+    for (int i = 0; i < kRingSize; ++i) {
         m_device->GetDevice()->CreateCommittedResource(
             &heapProps, D3D12_HEAP_FLAG_NONE, &texDesc,
             D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
@@ -161,6 +143,18 @@ void DemoPlayer::EnsurePostFxHistory(Scene::PostFXEffect& effect) {
     }
 }
 
+void DemoPlayer::SetGpuFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    m_externalFrameClock = true;
+    m_frameIndex = frameIndex;
+    m_completedFrameIndex = completedFrameIndex;
+}
+
+void DemoPlayer::DeferRelease(ComPtr<IUnknown> object) {
+    if (object) {
+        m_deferredReleases.Push(m_frameIndex, std::move(object));
+    }
+}
+
 void DemoPlayer::EnsureComputeHistory(Scene::ComputeEffect& effect) {
 #if SHADERLAB_TINY_PLAYER
     (void)effect;
@@ -169,33 +163,155 @@ void DemoPlayer::EnsureComputeHistory(Scene::ComputeEffect& effect) {
     if (!m_device || m_width == 0 || m_height == 0) return;
     const int historyCount = (std::max)(0, (std::min)(effect.historyCount, static_cast<int>(kComputeHistorySlotsResources)));
     if (historyCount <= 0) {
-        effect.historyTextures.clear();
-        effect.historyIndex = 0;
-        effect.historyInitialized = false;
+        ResetHistoryRing(effect);
         return;
     }
 
-    bool needsCreate = static_cast<int>(effect.historyTextures.size()) != historyCount;
+    // One slot more than the shader reads: the effect writes the oldest one.
+    const int ringSize = historyCount + 1;
+    bool needsCreate = static_cast<int>(effect.historyTextures.size()) != ringSize;
     if (!needsCreate && !effect.historyTextures.empty()) {
         const auto desc = effect.historyTextures.front()->GetDesc();
         needsCreate = desc.Width != m_width || desc.Height != m_height;
     }
     if (!needsCreate) return;
 
-    effect.historyTextures.clear();
-    effect.historyTextures.resize(static_cast<size_t>(historyCount));
-    effect.historyIndex = 0;
-    effect.historyInitialized = false;
+    ResetHistoryRing(effect);
+    effect.historyTextures.resize(static_cast<size_t>(ringSize));
 
-    for (int i = 0; i < historyCount; ++i) {
+    for (int i = 0; i < ringSize; ++i) {
         if (!CreateRuntimeUavTexture(m_device, m_width, m_height, effect.historyTextures[static_cast<size_t>(i)])) {
-            effect.historyTextures.clear();
-            effect.historyIndex = 0;
-            effect.historyInitialized = false;
+            ResetHistoryRing(effect);
             return;
         }
     }
 #endif
 }
 
-}
\ No newline at end of file
+#if !SHADERLAB_TINY_PLAYER
+uint64_t DemoPlayer::EstimateSceneResidentBytes(const Scene& scene) const {
+    // Every runtime target is RGBA8 at the output size.
+    const uint64_t targetBytes = static_cast<uint64_t>(m_width) * m_height * 4u;
+    uint64_t targets = (scene.outputType == TextureType::TextureCube) ? 6u : 1u;
+
+    // Effects render into their history ring; compute effects without history use pooled
+    // transient targets, which are not counted here.
+    if (!scene.postFxChain.empty()) {
+        for (const auto& fx : scene.postFxChain) {
+            if (fx.enabled) {
+                targets += kPostFxHistoryCountResources + 1;
+            }
+        }
+    }
+
+    for (const auto& effect : scene.computeEffectChain) {
+        if (!effect.enabled) continue;
+        const int historyCount = (std::max)(0, (std::min)(effect.historyCount, static_cast<int>(kComputeHistorySlotsResources)));
+        targets += historyCount > 0 ? static_cast<uint64_t>(historyCount + 1) : 0u;
+    }
+    return targets * targetBytes;
+}
+
+void DemoPlayer::MakeSceneResident(int sceneIndex) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_project.scenes.size()) return;
+    if (m_sceneResident.size() < m_project.scenes.size()) {
+        m_sceneResident.resize(m_project.scenes.size(), 0);
+    }
+    auto& scene = m_project.scenes[sceneIndex];
+
+    EnsureSceneTexture(sceneIndex);
+    if (!scene.postFxChain.empty()) {
+        EnsurePostFxResources(scene);
+        for (auto& fx : scene.postFxChain) {
+            if (fx.enabled && fx.pipelineState) {
+                EnsurePostFxHistory(fx);
+            }
+        }
+    }
+    for (auto& effect : scene.computeEffectChain) {
+        if (effect.enabled) {
+            EnsureComputeHistory(effect);
+        }
+    }
+    m_sceneResident[static_cast<size_t>(sceneIndex)] = 1;
+}
+
+void DemoPlayer::ReleaseSceneResources(int sceneIndex) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_project.scenes.size()) return;
+    auto& scene = m_project.scenes[sceneIndex];
+
+    // Called from Update, so the last recorded frame may still be reading these.
+    DeferRelease(std::move(scene.texture));
+    DeferRelease(std::move(scene.rtvHeap));
+    scene.textureValid = false;
+
+    DeferRelease(std::move(scene.postFxRtvHeap));
+    scene.postFxValid = false;
+    for (auto& fx : scene.postFxChain) {
+        ResetHistoryRing(fx);
+    }
+    for (auto& effect : scene.computeEffectChain) {
+        ResetHistoryRing(effect);
+    }
+    if (static_cast<size_t>(sceneIndex) < m_sceneResident.size()) {
+        m_sceneResident[static_cast<size_t>(sceneIndex)] = 0;
+    }
+}
+
+// Feeds the newest resolved GPU frame to the controller and moves m_width/m_height with it.
+// Scene shaders sample their inputs over the whole texture, so targets follow the render size
+// instead of rendering into a viewport of a full-size target. Only resident scenes own targets;
+// they are rebuilt here so prewarmed scenes do not reallocate on first use. Any other scene that
+// still holds a target resizes it in the declare pass, like after a window resize.
+void DemoPlayer::UpdateDynamicResolution(ID3D12Resource* renderTarget) {
+    if (m_dynamicResolutionTargetMs <= 0.0 || !renderTarget || !m_profiler || !m_profiler->IsInitialized()) {
+        return;
+    }
+    const D3D12_RESOURCE_DESC outputDesc = renderTarget->GetDesc();
+    const uint32_t outputWidth = static_cast<uint32_t>(outputDesc.Width);
+    const uint32_t outputHeight = outputDesc.Height;
+    if (outputWidth == 0 || outputHeight == 0) {
+        return;
+    }
+    if (!m_dynamicResolution) {
+        DynamicResolutionSettings settings;
+        settings.targetMs = m_dynamicResolutionTargetMs;
+        m_dynamicResolution = std::make_unique<DynamicResolutionController>(settings);
+    }
+    const float minScale = m_dynamicResolutionMinWidth > 0
+        ? static_cast<float>(m_dynamicResolutionMinWidth) / static_cast<float>(outputWidth)
+        : 0.5f;
+    m_dynamicResolution->SetScaleRange(minScale, 1.0f);
+
+    const ProfileFrame* frame = m_profiler->GetProfiler().GetLastFrame();
+    if (frame && frame->frameIndex != m_dynamicResolutionFrame && !frame->events[static_cast<size_t>(ProfileTrack::Gpu)].empty()) {
+        const auto& gpuEvents = frame->events[static_cast<size_t>(ProfileTrack::Gpu)];
+        m_dynamicResolutionFrame = frame->frameIndex;
+        double startUs = gpuEvents.front().startUs;
+        double endUs = startUs;
+        for (const ProfileEvent& event : gpuEvents) {
+            if (event.depth == 0) {
+                startUs = (std::min)(startUs, event.startUs);
+                endUs = (std::max)(endUs, event.startUs + event.durationUs);
+            }
+        }
+        m_dynamicResolution->Update((endUs - startUs) / 1000.0);
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    m_dynamicResolution->ComputeSize(outputWidth, outputHeight, width, height);
+    if (width == m_width && height == m_height) {
+        return;
+    }
+    m_width = width;
+    m_height = height;
+    for (int sceneIndex = 0; sceneIndex < static_cast<int>(m_sceneResident.size()); ++sceneIndex) {
+        if (m_sceneResident[static_cast<size_t>(sceneIndex)]) {
+            MakeSceneResident(sceneIndex);
+        }
+    }
+}
+#endif
+
+}
@@ -5,6 +5,8 @@
 
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/RenderGraphExecutor.h"
 
 namespace ShaderLab {
 
@@ -46,147 +48,158 @@ void ComputeShaderMusicalTimingSceneGraph(const Transport& transport,
 
 } // namespace
 
-ID3D12Resource* DemoPlayer::GetSceneFinalTexture(ID3D12GraphicsCommandList* commandList,
-                                                 int sceneIndex,
-                                                 double timeSeconds) {
-    if (sceneIndex < 0 || sceneIndex >= (int)m_project.scenes.size()) return nullptr;
-    RenderScene(commandList, sceneIndex, timeSeconds);
+uint32_t DemoPlayer::DeclareSceneFinal(int sceneIndex, double timeSeconds) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_project.scenes.size()) return RenderGraph::kInvalid;
+    if (m_graphSceneOutputs[sceneIndex] != RenderGraph::kInvalid) return m_graphSceneOutputs[sceneIndex];
+
+    uint32_t output = DeclareScene(sceneIndex, timeSeconds);
+    if (output == RenderGraph::kInvalid) return output;
     auto& scene = m_project.scenes[sceneIndex];
-    if (!scene.texture) return nullptr;
-    ID3D12Resource* output = scene.texture.Get();
     if (!scene.postFxChain.empty()) {
-        output = ApplyPostFxChain(commandList, scene, output, timeSeconds);
+        output = DeclarePostFxChain(scene, output, timeSeconds);
     }
 #if !SHADERLAB_TINY_PLAYER
     if (!scene.computeEffectChain.empty()) {
-        output = ApplyComputeChain(commandList, sceneIndex, scene.computeEffectChain, output, timeSeconds);
+        output = DeclareComputeChain(sceneIndex, scene.computeEffectChain, output, timeSeconds);
     }
 #endif
+    m_graphSceneOutputs[sceneIndex] = output;
     return output;
 }
 
 void DemoPlayer::OnResize(int width, int height) {
+    // The swapchain resize already drained the GPU, so stale-sized pooled targets can go now.
+    if (m_transientTargets && (static_cast<uint32_t>(width) != m_width || static_cast<uint32_t>(height) != m_height)) {
+        m_transientTargets->Clear();
+    }
     m_width = width;
     m_height = height;
 }
 
-void DemoPlayer::RenderScene(ID3D12GraphicsCommandList* cmd, int sceneIndex, double time) {
-    for (int s : m_renderStack) {
-        if (s == sceneIndex) return;
-    }
-    m_renderStack.push_back(sceneIndex);
+// Declares the scene pass after the scenes it samples. A scene is imported before its inputs are
+// declared, so a binding cycle reads the previous frame's texture instead of recursing.
+uint32_t DemoPlayer::DeclareScene(int sceneIndex, double time) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_project.scenes.size()) return RenderGraph::kInvalid;
+    if (m_graphSceneTextures[sceneIndex] != RenderGraph::kInvalid) return m_graphSceneTextures[sceneIndex];
 
     EnsureSceneTexture(sceneIndex);
     auto& scene = m_project.scenes[sceneIndex];
+    if (!scene.texture) return RenderGraph::kInvalid;
 
-    if (!scene.texture) {
-        m_renderStack.pop_back();
-        return;
-    }
+    const uint32_t texture = m_renderGraph->Import("scene", scene.texture.Get());
+    m_graphSceneTextures[sceneIndex] = texture;
 
     for (const auto& binding : scene.bindings) {
         if (binding.enabled && binding.sourceSceneIndex != -1 && binding.sourceSceneIndex != sceneIndex) {
-            RenderScene(cmd, binding.sourceSceneIndex, time);
+            DeclareScene(binding.sourceSceneIndex, time);
         }
     }
 
-    if (!scene.pipelineState) {
-        m_renderStack.pop_back();
-        return;
-    }
-
-    if (scene.srvHeap) {
-        auto device = m_device->GetDevice();
-        auto handleStep = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-        auto startHandle = scene.srvHeap->GetCPUDescriptorHandleForHeapStart();
-
-        for (int i = 0; i < 8; ++i) {
-            D3D12_CPU_DESCRIPTOR_HANDLE dest = startHandle;
-            dest.ptr += i * handleStep;
-
-            bool bound = false;
-            for (const auto& b : scene.bindings) {
-                if (b.channelIndex == i && b.enabled) {
-                    ID3D12Resource* srcRes = nullptr;
-                    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-                    srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-                    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-
-                    if (b.bindingType == BindingType::Scene) {
-                        if (b.sourceSceneIndex >= 0 && b.sourceSceneIndex < (int)m_project.scenes.size()) {
-                            auto& src = m_project.scenes[b.sourceSceneIndex];
-                            if (src.texture) {
-                                srcRes = src.texture.Get();
-                                if (b.type == TextureType::TextureCube) {
-                                    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
-                                    srvDesc.TextureCube.MipLevels = 1;
-                                } else {
-                                    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-                                    srvDesc.Texture2D.MipLevels = 1;
-                                }
-                            }
-                        }
-                    }
-
-                    if (srcRes) {
-                        device->CreateShaderResourceView(srcRes, &srvDesc, dest);
-                        bound = true;
+    if (!scene.pipelineState) return texture;
+
+    // Scene and effect names label the passes in the profiler.
+    const char* passName = scene.name.empty() ? "scene" : scene.name.c_str();
+    const uint32_t pass = m_renderGraph->AddPass(passName, [this, sceneIndex, time](ID3D12GraphicsCommandList* cmd) {
+        auto& target = m_project.scenes[sceneIndex];
+
+        // Unchanged bindings hit the view cache; only the 8-slot table is copied each frame.
+        D3D12_CPU_DESCRIPTOR_HANDLE sources[8] = {};
+        bool sourcesReady = m_descriptorRing != nullptr;
+        for (int i = 0; i < 8 && sourcesReady; ++i) {
+            ID3D12Resource* srcRes = nullptr;
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Texture2D.MipLevels = 1;
+
+            for (const auto& b : target.bindings) {
+                if (b.channelIndex != i || !b.enabled) continue;
+#if !SHADERLAB_TINY_PLAYER
+                if (b.bindingType == BindingType::File && b.fileTextureValid && b.textureResource) {
+                    // Baked textures carry their own format, shape and mip chain.
+                    srcRes = b.textureResource.Get();
+                    const D3D12_RESOURCE_DESC desc = srcRes->GetDesc();
+                    srvDesc.Format = desc.Format;
+                    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D) {
+                        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE3D;
+                        srvDesc.Texture3D = {};
+                        srvDesc.Texture3D.MipLevels = desc.MipLevels;
+                    } else if (desc.DepthOrArraySize == 6) {
+                        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
+                        srvDesc.TextureCube = {};
+                        srvDesc.TextureCube.MipLevels = desc.MipLevels;
+                    } else {
+                        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+                        srvDesc.Texture2D = {};
+                        srvDesc.Texture2D.MipLevels = desc.MipLevels;
                     }
+                    continue;
+                }
+#endif
+                if (b.bindingType != BindingType::Scene) continue;
+                if (b.sourceSceneIndex < 0 || b.sourceSceneIndex >= (int)m_project.scenes.size()) continue;
+                auto& src = m_project.scenes[b.sourceSceneIndex];
+                if (!src.texture) continue;
+                srcRes = src.texture.Get();
+                if (b.type == TextureType::TextureCube) {
+                    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURECUBE;
+                    srvDesc.TextureCube = {};
+                    srvDesc.TextureCube.MipLevels = 1;
+                } else {
+                    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+                    srvDesc.Texture2D = {};
+                    srvDesc.Texture2D.MipLevels = 1;
                 }
             }
 
-            if (!bound) {
-                D3D12_SHADER_RESOURCE_VIEW_DESC nullSrvDesc = {};
-                nullSrvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-                nullSrvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-                nullSrvDesc.Texture2D.MipLevels = 1;
-                nullSrvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-                device->CreateShaderResourceView(nullptr, &nullSrvDesc, dest);
-            }
+            // Unbound channels get a null view.
+            sourcesReady = m_descriptorRing->GetSrv(srcRes, srvDesc, sources[i]);
         }
-    }
 
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = scene.texture.Get();
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
-    cmd->ResourceBarrier(1, &barrier);
-
-    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = scene.rtvHeap->GetCPUDescriptorHandleForHeapStart();
-
-    float clearColor[] = { 0, 0, 0, 1 };
-    cmd->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
-    cmd->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
-
-    ID3D12DescriptorHeap* heaps[] = { scene.srvHeap.Get() };
-    if (scene.srvHeap) cmd->SetDescriptorHeaps(1, heaps);
-
-    float iBeat = 0.0f;
-    float iBar = 0.0f;
-    float fBeat = 0.0f;
-    float fBarBeat = 0.0f;
-    float fBarBeat16 = 0.0f;
-    ComputeShaderMusicalTimingSceneGraph(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
-    m_renderer->Render(cmd,
-                       scene.pipelineState.Get(),
-                       scene.texture.Get(),
-                       rtvHandle,
-                       scene.srvHeap ? scene.srvHeap->GetGPUDescriptorHandleForHeapStart() : D3D12_GPU_DESCRIPTOR_HANDLE{},
-                       m_width,
-                       m_height,
-                       (float)time,
-                       iBeat,
-                       iBar,
-                       fBarBeat16,
-                       fBeat,
-                       fBarBeat);
-
-    std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
-    cmd->ResourceBarrier(1, &barrier);
-
-    scene.textureValid = true;
-    m_renderStack.pop_back();
+        D3D12_GPU_DESCRIPTOR_HANDLE srvTable = {};
+        if (sourcesReady) {
+            BindSrvTable(cmd, sources, 8, srvTable);
+        }
+
+        D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = target.rtvHeap->GetCPUDescriptorHandleForHeapStart();
+
+        float clearColor[] = { 0, 0, 0, 1 };
+        cmd->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
+        cmd->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
+
+        float iBeat = 0.0f;
+        float iBar = 0.0f;
+        float fBeat = 0.0f;
+        float fBarBeat = 0.0f;
+        float fBarBeat16 = 0.0f;
+        ComputeShaderMusicalTimingSceneGraph(m_transport, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
+        m_renderer->Render(cmd,
+                           target.pipelineState.Get(),
+                           target.texture.Get(),
+                           rtvHandle,
+                           srvTable,
+                           m_width,
+                           m_height,
+                           (float)time,
+                           iBeat,
+                           iBar,
+                           fBarBeat16,
+                           fBeat,
+                           fBarBeat);
+        target.textureValid = true;
+    });
+
+    for (const auto& b : scene.bindings) {
+        if (!b.enabled || b.bindingType != BindingType::Scene || b.sourceSceneIndex == sceneIndex) continue;
+        if (b.sourceSceneIndex < 0 || b.sourceSceneIndex >= (int)m_project.scenes.size()) continue;
+        const uint32_t source = m_graphSceneTextures[b.sourceSceneIndex];
+        if (source != RenderGraph::kInvalid) {
+            m_renderGraph->Read(pass, source);
+        }
+    }
+    m_renderGraph->Write(pass, texture);
+    return texture;
 }
 
-} // namespace ShaderLab
\ No newline at end of file
+} // namespace ShaderLab
@@ -2,6 +2,13 @@
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/Swapchain.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/Dx12ResourceService.h"
+#include "ShaderLab/Graphics/TransientTargetService.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/FrameUploadRing.h"
+#include "ShaderLab/Graphics/RenderGraphExecutor.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
+#include "ShaderLab/Graphics/CommandQueue.h"
 #include "ShaderLab/Shader/ShaderCompiler.h"
 #include "ShaderLab/Runtime/RuntimeStartupPolicy.h"
 #include <d3dcompiler.h>
@@ -17,10 +24,13 @@
 #include "ShaderLab/Core/Serializer.h"
 #endif
 #include "ShaderLab/Core/PackageManager.h" 
-#include "stb_image.h"
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DynamicResolution.h"
+#if !SHADERLAB_TINY_PLAYER
+#include "ShaderLab/Core/TextureBaker.h"
+#endif
 #include <windows.h>
 #include <cmath>
-#include <climits>
 #include <cstdint>
 #include <cstring>
 #include <cctype>
@@ -32,6 +42,7 @@
 #include <iostream>
 #endif
 #include <fstream>
+#include <iterator>
 #if !SHADERLAB_TINY_PLAYER
 #include <filesystem>
 #endif
@@ -75,6 +86,11 @@ namespace fs = std::filesystem;
 static const int kPostFxHistoryCount = 4;
 static const int kMaxPostFxChain = 32;
 static const char* kPackedVertexShaderPath = "assets/shaders/vertex.cso";
+// Views cached in the CPU-only heap / slots in the per-frame shader-visible ring.
+static constexpr uint32_t kDescriptorCacheCapacity = 1024;
+static constexpr uint32_t kDescriptorRingCapacity = 8192;
+// Compute dispatch constants for every frame in flight (256 bytes per dispatch).
+static constexpr uint64_t kComputeUploadRingBytes = 256 * 1024;
 static const char* kPackedMicroUbershaderBytecodePath = "assets/shaders/ubershader.bin";
 
 static constexpr size_t kTransitionSlotCount = 6;
@@ -169,29 +185,15 @@ struct ComputeDispatchParams {
     float invWidth;
     float invHeight;
     uint32_t frame;
-};
-
-struct RuntimeComputeSceneResources {
-    ComPtr<ID3D12Resource> textureA;
-    ComPtr<ID3D12Resource> textureB;
-    uint32_t width = 0;
-    uint32_t height = 0;
+    uint32_t historyFrames; // History slots holding rendered frames; the rest read the input
 };
 
 ComPtr<ID3D12RootSignature> g_runtimeComputeRootSignature;
-ComPtr<ID3D12DescriptorHeap> g_runtimeComputeDescriptorHeap;
-ComPtr<ID3D12Resource> g_runtimeComputeParamsBuffer;
-uint8_t* g_runtimeComputeParamsMapped = nullptr;
-std::unordered_map<int, RuntimeComputeSceneResources> g_runtimeComputeSceneResources;
 
 uint32_t Align256(uint32_t value) {
     return (value + 255u) & ~255u;
 }
 
-UINT DescriptorStep(ID3D12Device* device) {
-    return device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-}
-
 bool CreateRuntimeUavTexture(Device* deviceRef, uint32_t width, uint32_t height, ComPtr<ID3D12Resource>& outTexture) {
     if (!deviceRef || width == 0 || height == 0) return false;
 
@@ -211,7 +213,7 @@ bool CreateRuntimeUavTexture(Device* deviceRef, uint32_t width, uint32_t height,
         &heapProps,
         D3D12_HEAP_FLAG_NONE,
         &texDesc,
-        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,
+        D3D12_RESOURCE_STATE_ALL_SHADER_RESOURCE,
         nullptr,
         IID_PPV_ARGS(outTexture.ReleaseAndGetAddressOf())));
 }
@@ -279,54 +281,6 @@ bool EnsureRuntimeComputeRootSignature(Device* deviceRef) {
         serialized->GetBufferSize(),
         IID_PPV_ARGS(g_runtimeComputeRootSignature.ReleaseAndGetAddressOf())));
 }
-
-bool EnsureRuntimeComputeDispatchResources(Device* deviceRef) {
-    if (!deviceRef) return false;
-    ID3D12Device* device = deviceRef->GetDevice();
-
-    if (!g_runtimeComputeDescriptorHeap) {
-        D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-        heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-        heapDesc.NumDescriptors = kComputeDescriptorCount;
-        heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-        if (FAILED(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(g_runtimeComputeDescriptorHeap.ReleaseAndGetAddressOf())))) {
-            return false;
-        }
-    }
-
-    if (!g_runtimeComputeParamsBuffer) {
-        D3D12_HEAP_PROPERTIES heapProps = {};
-        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-
-        D3D12_RESOURCE_DESC bufferDesc = {};
-        bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-        bufferDesc.Width = Align256(static_cast<uint32_t>(sizeof(ComputeDispatchParams)));
-        bufferDesc.Height = 1;
-        bufferDesc.DepthOrArraySize = 1;
-        bufferDesc.MipLevels = 1;
-        bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
-        bufferDesc.SampleDesc.Count = 1;
-        bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-        if (FAILED(device->CreateCommittedResource(
-                &heapProps,
-                D3D12_HEAP_FLAG_NONE,
-                &bufferDesc,
-                D3D12_RESOURCE_STATE_GENERIC_READ,
-                nullptr,
-                IID_PPV_ARGS(g_runtimeComputeParamsBuffer.ReleaseAndGetAddressOf())))) {
-            return false;
-        }
-
-        if (FAILED(g_runtimeComputeParamsBuffer->Map(0, nullptr, reinterpret_cast<void**>(&g_runtimeComputeParamsMapped)))) {
-            g_runtimeComputeParamsBuffer.Reset();
-            g_runtimeComputeParamsMapped = nullptr;
-            return false;
-        }
-    }
-
-    return true;
-}
 #endif
 
 static std::string CanonicalTransitionStem(const std::string& transitionPresetStem) {
@@ -729,14 +683,7 @@ static const char* GetTransitionPackedPathForStem(const std::string& transitionP
     return "";
 }
 
-struct TinyTrackMetadata {
-    int sceneCount = 0;
-    std::vector<int16_t> sceneModuleIndices;
-    std::vector<std::vector<int16_t>> postFxModuleIndices;
-    std::array<int16_t, kTransitionSlotCount> transitionModuleIndices = { -1, -1, -1, -1, -1, -1 };
-    RenderAspectRatioPreset renderAspectRatioPreset = RenderAspectRatioPreset::Ratio_16_9;
-    FullscreenRenderResolutionPreset fullscreenRenderResolutionPreset = FullscreenRenderResolutionPreset::Full;
-};
+using TinyTrackMetadata = CompactTrack::Metadata;
 
 #if SHADERLAB_TINY_PLAYER
 static bool LoadCompactTrackBinaryFromBytesTiny(const std::vector<uint8_t>& bytes,
@@ -838,7 +785,7 @@ static bool LoadCompactTrackBinaryFromBytesTiny(const std::vector<uint8_t>& byte
         row.oneShotIndex = -1;
         row.stop = (flags & 0x1u) != 0;
         row.isBeat = false;
-        decoded.rows.push_back(row);
+        decoded.rows.Insert(row);
     }
 
     track = std::move(decoded);
@@ -853,136 +800,12 @@ static bool LoadCompactTrackBinaryFromBytes(const std::vector<uint8_t>& bytes, D
 #if SHADERLAB_TINY_PLAYER
     return LoadCompactTrackBinaryFromBytesTiny(bytes, track, outMeta, outError);
 #else
-    constexpr size_t kHeaderV2Size = 10;
-    constexpr size_t kHeaderV3Size = 14;
-    constexpr size_t kRowSize = 9;
-    if (bytes.size() < kHeaderV2Size) {
-        SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary too small."));
-        return false;
-    }
-
-    const auto readU16 = [&bytes](size_t offset) -> uint16_t {
-        return static_cast<uint16_t>(bytes[offset]) |
-               static_cast<uint16_t>(static_cast<uint16_t>(bytes[offset + 1]) << 8);
-    };
-    const auto readI16 = [&readU16](size_t offset) -> int16_t {
-        return static_cast<int16_t>(readU16(offset));
-    };
-    const auto readI8 = [&bytes](size_t offset) -> int8_t {
-        return static_cast<int8_t>(bytes[offset]);
-    };
-
-    const uint16_t magic0 = readU16(0);
-    const uint16_t magic1 = readU16(2);
-    if (magic0 != 0x4B54u || (magic1 != 0x3252u && magic1 != 0x3352u)) {
-        SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary has invalid magic."));
-        return false;
-    }
-    const bool isV3 = (magic1 == 0x3352u);
-
-    const uint16_t bpmQ8 = readU16(4);
-    const uint16_t lengthBeats = readU16(6);
-    const uint16_t rowCount = readU16(8);
-
-    TinyTrackMetadata decodedMeta;
-    size_t offset = isV3 ? kHeaderV3Size : kHeaderV2Size;
-
-    if (isV3) {
-        if (bytes.size() < kHeaderV3Size) {
-            SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary header truncated."));
-            return false;
-        }
-
-        const uint16_t sceneCount = readU16(10);
-        const uint8_t transitionSlotCount = bytes[12];
-        const uint8_t compactRenderConfig = bytes[13];
-        if (transitionSlotCount < 6) {
-            SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary transition map is invalid."));
-            return false;
-        }
-
-        decodedMeta.sceneCount = static_cast<int>(sceneCount);
-        decodedMeta.sceneModuleIndices.resize(sceneCount, -1);
-        decodedMeta.postFxModuleIndices.resize(sceneCount);
-        decodedMeta.fullscreenRenderResolutionPreset = FullscreenPresetFromCompactByte(compactRenderConfig);
-        decodedMeta.renderAspectRatioPreset = AspectPresetFromCompactByte(compactRenderConfig);
-
-        for (int i = 0; i < 6; ++i) {
-            if (offset + 2 > bytes.size()) {
-                SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary transition map truncated."));
-                return false;
-            }
-            decodedMeta.transitionModuleIndices[static_cast<size_t>(i)] = readI16(offset);
-            offset += 2;
-        }
-
-        for (uint16_t sceneIndex = 0; sceneIndex < sceneCount; ++sceneIndex) {
-            if (offset + 4 > bytes.size()) {
-                SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary scene map truncated."));
-                return false;
-            }
-
-            const int16_t sceneModule = readI16(offset);
-            offset += 2;
-            const uint16_t fxCount = readU16(offset);
-            offset += 2;
-
-            decodedMeta.sceneModuleIndices[sceneIndex] = sceneModule;
-            auto& fxModules = decodedMeta.postFxModuleIndices[sceneIndex];
-            fxModules.resize(fxCount, -1);
-            for (uint16_t fxIndex = 0; fxIndex < fxCount; ++fxIndex) {
-                if (offset + 2 > bytes.size()) {
-                    SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary post FX map truncated."));
-                    return false;
-                }
-                fxModules[fxIndex] = readI16(offset);
-                offset += 2;
-            }
-        }
-    }
-
-    const size_t expectedSize = offset + static_cast<size_t>(rowCount) * kRowSize;
-    if (bytes.size() < expectedSize) {
-        SetCompactTrackDecodeError(outError, SHADERLAB_TRACK_ERROR("Compact track binary truncated."));
-        return false;
-    }
-
-    DemoTrack decoded;
-    decoded.name = "CompactTrack";
-    decoded.bpm = static_cast<float>(bpmQ8) / 256.0f;
-    decoded.lengthBeats = static_cast<int>(lengthBeats);
-    decoded.rows.reserve(rowCount);
-
-    for (uint32_t i = 0; i < rowCount; ++i) {
-        const int16_t rowId = readI16(offset); offset += 2;
-        const int16_t sceneIndex = readI16(offset); offset += 2;
-        const uint8_t transition = bytes[offset++];
-        const uint8_t flags = bytes[offset++];
-        const uint8_t transitionDurationQ4 = bytes[offset++];
-        const int8_t timeOffsetQ4 = readI8(offset++);
-        const int8_t musicIndex = readI8(offset++);
-
-        TrackerRow row;
-        row.rowId = static_cast<int>(rowId);
-        row.sceneIndex = static_cast<int>(sceneIndex);
-        row.transitionPresetStem.clear();
-        if (transition < kTransitionSlotCount) {
-            row.transitionPresetStem = kTransitionSlotStems[transition];
-        }
-        row.transitionDuration = static_cast<float>(transitionDurationQ4) / 16.0f;
-        row.timeOffset = static_cast<float>(timeOffsetQ4) / 16.0f;
-        row.musicIndex = static_cast<int>(musicIndex);
-        row.oneShotIndex = -1;
-        row.stop = (flags & 0x1u) != 0;
-        row.isBeat = false;
-        decoded.rows.push_back(row);
-    }
-
-    track = std::move(decoded);
-    if (outMeta) {
-        *outMeta = std::move(decodedMeta);
+    std::string decodeError;
+    const bool decoded = CompactTrack::Decode(bytes, track, outMeta, decodeError);
+    if (!decoded) {
+        SetCompactTrackDecodeError(outError, decodeError.c_str());
     }
-    return true;
+    return decoded;
 #endif
 }
 
@@ -1252,23 +1075,6 @@ static bool BuildTinyProjectFromAssets(ProjectData& project,
     return true;
 }
 
-static const TrackerRow* FindNextSceneRow(const DemoTrack& track, int afterBeat) {
-    const TrackerRow* bestRow = nullptr;
-    int bestBeat = INT_MAX;
-    for (const auto& row : track.rows) {
-        if (row.sceneIndex >= 0 && row.rowId > afterBeat && row.rowId < bestBeat) {
-            bestBeat = row.rowId;
-            bestRow = &row;
-        }
-    }
-    return bestRow;
-}
-
-static int FindNextSceneIndex(const DemoTrack& track, int afterBeat) {
-    const TrackerRow* row = FindNextSceneRow(track, afterBeat);
-    return row ? row->sceneIndex : -1;
-}
-
 static void ComputeShaderMusicalTiming(const Transport& transport,
                                        float& outIBeat,
                                        float& outIBar,
@@ -1365,10 +1171,107 @@ return lerp(colA, colB, t);
     return common + " return colB; }";
 }
 
+#if !SHADERLAB_TINY_PLAYER
+// Worker-thread half of the CompilingShaders stage. Only reads project data that stays
+// immutable while loading; pipelines land in per-job slots collected on the render thread.
+class RuntimePipelineFactory final : public IPipelineFactory {
+public:
+    RuntimePipelineFactory(const ProjectData& project,
+                           PreviewRenderer* renderer,
+                           Device* device,
+                           const std::string& manifestPath,
+                           size_t jobCount)
+        : m_project(project),
+          m_renderer(renderer),
+          m_device(device),
+          m_manifestPath(manifestPath),
+          m_packed(PackageManager::Get().IsPacked()),
+          m_pipelines(jobCount),
+          m_bytecodeSizes(jobCount, 0) {}
+
+    bool LoadBytecode(const PipelineLoadJob& job, std::vector<uint8_t>& outBytecode) override {
+        if (!job.bytecodeKey.empty()) {
+            if (m_packed) {
+                outBytecode = PackageManager::Get().GetFile(job.bytecodeKey);
+            } else {
+                LoadBytecodeFromPathCandidates(job.bytecodeKey, m_manifestPath, outBytecode);
+            }
+            if (!outBytecode.empty()) {
+                return true;
+            }
+            SHADERLAB_RT_DEBUG_LOG_ERROR("No precompiled shader data for: " + job.bytecodeKey);
+        }
+
+        // Only compute effects may fall back to source, both when they have no precompiled path
+        // and when its data is missing, like the serial loader did.
+        if (job.kind != PipelineKind::Compute) {
+            return false;
+        }
+        const auto& effect = m_project.scenes[job.sceneIndex].computeEffectChain[job.effectIndex];
+        if (effect.shaderCode.empty()) {
+            return false;
+        }
+        const std::string entryPoint = effect.entryPoint.empty() ? "main" : effect.entryPoint;
+        ComPtr<ID3DBlob> shaderBlob;
+        ComPtr<ID3DBlob> errorBlob;
+        if (FAILED(D3DCompile(effect.shaderCode.c_str(),
+                              effect.shaderCode.size(),
+                              "compute_runtime.hlsl",
+                              nullptr,
+                              nullptr,
+                              entryPoint.c_str(),
+                              "cs_5_0",
+                              D3DCOMPILE_ENABLE_STRICTNESS,
+                              0,
+                              shaderBlob.GetAddressOf(),
+                              errorBlob.GetAddressOf())) || !shaderBlob) {
+            return false;
+        }
+        const uint8_t* begin = static_cast<const uint8_t*>(shaderBlob->GetBufferPointer());
+        outBytecode.assign(begin, begin + shaderBlob->GetBufferSize());
+        return true;
+    }
+
+    bool CreatePipeline(size_t jobIndex, const PipelineLoadJob& job, const std::vector<uint8_t>& bytecode) override {
+        ComPtr<ID3D12PipelineState> pso;
+        if (job.kind == PipelineKind::Compute) {
+            D3D12_COMPUTE_PIPELINE_STATE_DESC desc = {};
+            desc.pRootSignature = g_runtimeComputeRootSignature.Get();
+            desc.CS = { bytecode.data(), bytecode.size() };
+            if (!desc.pRootSignature ||
+                FAILED(m_device->GetDevice()->CreateComputePipelineState(&desc, IID_PPV_ARGS(pso.GetAddressOf())))) {
+                return false;
+            }
+        } else {
+            pso = m_renderer->CreatePSOFromBytecode(bytecode);
+        }
+        m_pipelines[jobIndex] = pso;
+        m_bytecodeSizes[jobIndex] = bytecode.size();
+        return pso != nullptr;
+    }
+
+    ComPtr<ID3D12PipelineState> TakePipeline(size_t jobIndex) { return std::move(m_pipelines[jobIndex]); }
+    size_t GetBytecodeSize(size_t jobIndex) const { return m_bytecodeSizes[jobIndex]; }
+
+private:
+    const ProjectData& m_project;
+    PreviewRenderer* m_renderer = nullptr;
+    Device* m_device = nullptr;
+    std::string m_manifestPath;
+    bool m_packed = false;
+    std::vector<ComPtr<ID3D12PipelineState>> m_pipelines;
+    std::vector<size_t> m_bytecodeSizes;
+};
+#endif
+
 DemoPlayer::DemoPlayer() {}
 DemoPlayer::~DemoPlayer() { Shutdown(); }
 
 void DemoPlayer::Shutdown() {
+    // Workers may still be creating pipelines through m_renderer.
+    m_pipelineLoader.Cancel();
+    m_pipelineFactory.reset();
+
     // Shutdown ImGui
 #if SHADERLAB_RUNTIME_IMGUI
     if (ImGui::GetCurrentContext()) {
@@ -1383,9 +1286,22 @@ void DemoPlayer::Shutdown() {
 #else
     m_audio = nullptr;
 #endif
+    m_deferredReleases.Clear();
+    m_renderGraph.reset();
+    m_profiler.reset();
+    m_dynamicResolution.reset();
+    m_upscalePSO.Reset();
+    m_upscaleRtvHeap.Reset();
+    m_upscalePipelineFailed = false;
+    m_transientTargets.reset();
+    m_resourceService.reset();
+    m_descriptorRing.reset();
+    m_uploadRing.reset();
     if (m_renderer) { m_renderer->Shutdown(); delete m_renderer; m_renderer = nullptr; }
 #if !SHADERLAB_TINY_PLAYER
     if (m_compiler) { m_compiler->Shutdown(); delete m_compiler; m_compiler = nullptr; }
+    // Texture loads read packed files through views of the mapped executable.
+    PackageManager::Get().ReleaseFileViews();
 #else
     m_compiler = nullptr;
     m_compilerReady = false;
@@ -1396,6 +1312,28 @@ void DemoPlayer::Shutdown() {
 bool DemoPlayer::Initialize(HWND hwnd, Device* device, Swapchain* swapchain, int width, int height) {
     m_device = device;
     m_swapchain = swapchain;
+    if (m_device && m_device->GetDevice()) {
+        m_resourceService = std::make_unique<Dx12ResourceService>(m_device->GetDevice());
+        m_transientTargets = std::make_unique<TransientTargetService>(*m_resourceService);
+        m_renderGraph = std::make_unique<RenderGraphExecutor>(*m_transientTargets);
+        m_descriptorRing = std::make_unique<DescriptorRingService>();
+        if (!m_descriptorRing->Initialize(m_device->GetDevice(), kDescriptorCacheCapacity, kDescriptorRingCapacity)) {
+            RuntimeErr("E209", "descriptor heap create failed");
+            m_descriptorRing.reset();
+        }
+        m_uploadRing = std::make_unique<FrameUploadRing>();
+        if (!m_uploadRing->Initialize(m_device->GetDevice(), kComputeUploadRingBytes)) {
+            RuntimeErr("E210", "upload ring create failed");
+            m_uploadRing.reset();
+        }
+#if !SHADERLAB_TINY_PLAYER
+        // Without timestamp queries the profiler still records CPU scopes.
+        m_profiler = std::make_unique<GpuProfiler>(Swapchain::BUFFER_COUNT + 1);
+        CommandQueue* queue = m_swapchain ? m_swapchain->GetCommandQueue() : nullptr;
+        m_profiler->Initialize(m_device->GetDevice(), queue ? queue->GetQueue() : nullptr);
+        m_renderGraph->SetProfiler(m_profiler.get());
+#endif
+    }
 
     PackageManager::Get().Initialize();
     if (PackageManager::Get().HasFile(kPackedVertexShaderPath)) {
@@ -1524,7 +1462,7 @@ bool DemoPlayer::Initialize(HWND hwnd, Device* device, Swapchain* swapchain, int
         m_device->GetDevice()->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_imguiSrvHeap));
 
         ImGui_ImplWin32_Init(hwnd);
-        ImGui_ImplDX12_Init(m_device->GetDevice(), 2,
+        ImGui_ImplDX12_Init(m_device->GetDevice(), Swapchain::BUFFER_COUNT,
             DXGI_FORMAT_R8G8B8A8_UNORM, m_imguiSrvHeap.Get(),
             m_imguiSrvHeap->GetCPUDescriptorHandleForHeapStart(),
             m_imguiSrvHeap->GetGPUDescriptorHandleForHeapStart());
@@ -1669,12 +1607,62 @@ bool DemoPlayer::EnsureTransitionPipeline(const std::string& transitionPresetSte
     return true;
 }
 
+#if !SHADERLAB_TINY_PLAYER
+// Bilinear resample of the render-size image to the output; UVs stay half a texel inside the
+// source so the wrap samplers never blend in the opposite edge.
+static constexpr const char* kUpscaleShaderSource = R"(
+float4 main(float2 fragCoord, float2 iResolution, float iTime) {
+float2 size;
+iChannel0.GetDimensions(size.x, size.y);
+float2 halfTexel = 0.5 / size;
+float2 uv = clamp(fragCoord / iResolution, halfTexel, 1.0 - halfTexel);
+return iChannel0.SampleLevel(iSampler0, uv, 0.0);
+}
+)";
+
+bool DemoPlayer::EnsureUpscalePipeline() {
+    if (m_upscalePSO) return true;
+    if (m_upscalePipelineFailed || !m_renderer || !m_rendererReady || !m_device) return false;
+
+    std::vector<std::string> errorOut;
+    std::vector<PreviewRenderer::TextureDecl> textures;
+    textures.push_back({0, "Texture2D"});
+    m_upscalePSO = m_renderer->CompileShader(kUpscaleShaderSource, textures, errorOut);
+
+    D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
+    rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+    rtvHeapDesc.NumDescriptors = 1;
+    rtvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    if (!m_upscalePSO || FAILED(m_device->GetDevice()->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_upscaleRtvHeap)))) {
+        std::string errStr;
+        for (const auto& e : errorOut) errStr += e + "\n";
+        SHADERLAB_RT_DEBUG_LOG_ERROR("Failed to create the dynamic resolution upscale pipeline: " + errStr);
+        m_upscalePSO.Reset();
+        m_upscalePipelineFailed = true;
+        return false;
+    }
+    return true;
+}
+#endif
+
 void DemoPlayer::PrimeRuntimeResources() {
-    for (int sceneIndex = 0; sceneIndex < static_cast<int>(m_project.scenes.size()); ++sceneIndex) {
-        EnsureSceneTexture(sceneIndex);
-        auto& scene = m_project.scenes[static_cast<size_t>(sceneIndex)];
-        if (!scene.postFxChain.empty()) {
-            EnsurePostFxResources(scene);
+#if !SHADERLAB_TINY_PLAYER
+    m_residencyPlanValid = false;
+    m_sceneResident.assign(m_project.scenes.size(), 0);
+    const bool eagerResidency = m_residencyLeadBeats < 0.0;
+    if (!eagerResidency) {
+        UpdateResidency(0.0);
+    }
+#else
+    const bool eagerResidency = true;
+#endif
+    if (eagerResidency) {
+        for (int sceneIndex = 0; sceneIndex < static_cast<int>(m_project.scenes.size()); ++sceneIndex) {
+            EnsureSceneTexture(sceneIndex);
+            auto& scene = m_project.scenes[static_cast<size_t>(sceneIndex)];
+            if (!scene.postFxChain.empty()) {
+                EnsurePostFxResources(scene);
+            }
         }
     }
 
@@ -1697,13 +1685,248 @@ void DemoPlayer::PrimeRuntimeResources() {
     }
 }
 
-// Minimal helpers
-static ComPtr<ID3D12Resource> LoadTexture(Device* dev, const std::string& path) {
-    (void)dev;
-    (void)path;
-    // ... Implementation omitted for brevity
-    return nullptr;
+#if !SHADERLAB_TINY_PLAYER
+void DemoPlayer::BuildResidencyPlan() {
+    std::vector<ResidencySceneInfo> scenes(m_project.scenes.size());
+    for (size_t sceneIndex = 0; sceneIndex < m_project.scenes.size(); ++sceneIndex) {
+        const auto& scene = m_project.scenes[sceneIndex];
+        scenes[sceneIndex].bytes = EstimateSceneResidentBytes(scene);
+        for (const auto& binding : scene.bindings) {
+            if (binding.enabled && binding.bindingType == BindingType::Scene && binding.sourceSceneIndex >= 0) {
+                scenes[sceneIndex].dependencies.push_back(binding.sourceSceneIndex);
+            }
+        }
+    }
+
+    ResidencySettings settings;
+    settings.leadBeats = m_residencyLeadBeats;
+    settings.looping = m_loopPlayback;
+    std::string error;
+    m_residencyPlanValid = ResidencyPlanner::Build(m_project.track, scenes, settings, m_residencyPlan, error);
+    m_residencyPlanWidth = m_width;
+    m_residencyPlanHeight = m_height;
+    if (!m_residencyPlanValid) {
+        SHADERLAB_RT_DEBUG_LOG_ERROR("Residency plan failed: " + error);
+        return;
+    }
+    SHADERLAB_RT_DEBUG_LOG("Residency plan: peak " + std::to_string(m_residencyPlan.peakBytes / (1024 * 1024)) +
+                           " MB at beat " + std::to_string(m_residencyPlan.peakBeat) + ", eager " +
+                           std::to_string(m_residencyPlan.eagerBytes / (1024 * 1024)) + " MB, " +
+                           std::to_string(m_residencyPlan.events.size()) + " events");
+}
+
+void DemoPlayer::UpdateResidency(double beat) {
+    if (m_residencyLeadBeats < 0.0 || m_width == 0 || m_height == 0) {
+        return;
+    }
+    if (!m_residencyPlanValid || m_residencyPlanWidth != m_width || m_residencyPlanHeight != m_height) {
+        BuildResidencyPlan();
+        if (!m_residencyPlanValid) {
+            // Fall back to keeping everything resident.
+            m_residencyLeadBeats = -1.0;
+            for (int sceneIndex = 0; sceneIndex < static_cast<int>(m_project.scenes.size()); ++sceneIndex) {
+                MakeSceneResident(sceneIndex);
+            }
+            return;
+        }
+    }
+    m_sceneResident.resize(m_project.scenes.size(), 0);
+
+    // Whatever is on screen stays resident even if playback left the plan (loop wrap, manual cut).
+    std::vector<uint8_t> pinned(m_project.scenes.size(), 0);
+    auto pin = [&](int sceneIndex) {
+        if (sceneIndex < 0 || sceneIndex >= static_cast<int>(m_residencyPlan.dependencyClosure.size())) {
+            return;
+        }
+        for (int dependency : m_residencyPlan.dependencyClosure[static_cast<size_t>(sceneIndex)]) {
+            pinned[static_cast<size_t>(dependency)] = 1;
+        }
+    };
+    const SequencerState& state = m_sequencer.GetState();
+    pin(state.activeSceneIndex);
+    if (state.transitionActive) {
+        pin(state.transitionFromIndex);
+        pin(state.transitionToIndex);
+    }
+
+    // Up to BUFFER_COUNT frames may still reference these scenes; ReleaseSceneResources hands
+    // everything to DeferRelease, which keeps it alive until this frame's fence has passed.
+    for (int sceneIndex = 0; sceneIndex < static_cast<int>(m_project.scenes.size()); ++sceneIndex) {
+        const bool wanted = pinned[static_cast<size_t>(sceneIndex)] || m_residencyPlan.IsResident(sceneIndex, beat);
+        const bool resident = m_sceneResident[static_cast<size_t>(sceneIndex)] != 0 ||
+                              m_project.scenes[static_cast<size_t>(sceneIndex)].texture;
+        if (wanted && !m_sceneResident[static_cast<size_t>(sceneIndex)]) {
+            MakeSceneResident(sceneIndex);
+        } else if (!wanted && resident) {
+            ReleaseSceneResources(sceneIndex);
+        }
+    }
+}
+#endif
+
+#if !SHADERLAB_TINY_PLAYER
+// File-bound channels ship as .sltex (see BuildPipeline). Its payload already follows D3D12
+// upload footprints, so loading a texture is a single copy into an upload buffer.
+void DemoPlayer::LoadFileTextures(bool packed) {
+    std::unordered_map<std::string, ComPtr<ID3D12Resource>> byPath;
+    for (auto& scene : m_project.scenes) {
+        for (auto& binding : scene.bindings) {
+            if (binding.bindingType != BindingType::File || binding.filePath.empty()) {
+                continue;
+            }
+            auto it = byPath.find(binding.filePath);
+            if (it == byPath.end()) {
+                ComPtr<ID3D12Resource> texture;
+                std::string error;
+                if (!LoadFileTexture(binding.filePath, packed, texture, error)) {
+                    SHADERLAB_RT_DEBUG_LOG_ERROR("Texture not loaded (" + binding.filePath + "): " + error);
+                }
+                it = byPath.emplace(binding.filePath, texture).first;
+            }
+            binding.textureResource = it->second;
+            binding.fileTextureValid = it->second != nullptr;
+        }
+    }
+}
+
+bool DemoPlayer::LoadFileTexture(const std::string& path, bool packed, ComPtr<ID3D12Resource>& outTexture, std::string& outError) {
+    if (!m_device) {
+        outError = "no device";
+        return false;
+    }
+
+    PackedFileView packedView;
+    std::vector<uint8_t> diskBytes;
+    const uint8_t* bytes = nullptr;
+    size_t size = 0;
+    if (packed && PackageManager::Get().GetFileView(path, packedView)) {
+        bytes = packedView.data;
+        size = packedView.size;
+    } else {
+        std::vector<std::filesystem::path> candidates = { std::filesystem::path(path) };
+        if (!m_manifestPath.empty()) {
+            candidates.push_back(std::filesystem::path(m_manifestPath).parent_path() / path);
+        }
+        for (const auto& candidate : candidates) {
+            std::ifstream file(candidate, std::ios::binary);
+            if (file) {
+                diskBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                break;
+            }
+        }
+        bytes = diskBytes.data();
+        size = diskBytes.size();
+    }
+    if (size == 0) {
+        outError = "file not found";
+        return false;
+    }
+
+    SlTexView view;
+    if (!SlTexView::Parse(bytes, size, view, outError)) {
+        return false;
+    }
+
+    // UNORM views like the editor's: shaders see the stored values. The sRGB flag only decided
+    // how the mips were filtered.
+    DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    switch (view.GetFormat()) {
+    case BakedTextureFormat::BC1: format = DXGI_FORMAT_BC1_UNORM; break;
+    case BakedTextureFormat::BC4: format = DXGI_FORMAT_BC4_UNORM; break;
+    case BakedTextureFormat::BC7: format = DXGI_FORMAT_BC7_UNORM; break;
+    default: break;
+    }
+    const bool volume = view.GetDimension() == BakedTextureDimension::Texture3D;
+    const bool blockCompressed = IsBlockCompressed(view.GetFormat());
+
+    D3D12_HEAP_PROPERTIES defaultHeap = { D3D12_HEAP_TYPE_DEFAULT };
+    D3D12_RESOURCE_DESC texDesc = {};
+    texDesc.Dimension = volume ? D3D12_RESOURCE_DIMENSION_TEXTURE3D : D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    texDesc.Width = view.header.width;
+    texDesc.Height = view.header.height;
+    texDesc.DepthOrArraySize = static_cast<UINT16>(volume ? view.header.depth : view.header.arraySize);
+    texDesc.MipLevels = static_cast<UINT16>(view.header.mipLevels);
+    texDesc.Format = format;
+    texDesc.SampleDesc.Count = 1;
+
+    PendingTextureUpload upload;
+    if (FAILED(m_device->GetDevice()->CreateCommittedResource(
+            &defaultHeap, D3D12_HEAP_FLAG_NONE, &texDesc,
+            D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&upload.texture)))) {
+        outError = "texture creation failed";
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES uploadHeap = { D3D12_HEAP_TYPE_UPLOAD };
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = view.header.payloadSize;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    void* mapped = nullptr;
+    if (FAILED(m_device->GetDevice()->CreateCommittedResource(
+            &uploadHeap, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+            D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&upload.upload))) ||
+        FAILED(upload.upload->Map(0, nullptr, &mapped))) {
+        outError = "upload buffer creation failed";
+        return false;
+    }
+    std::memcpy(mapped, view.payload, static_cast<size_t>(view.header.payloadSize));
+    upload.upload->Unmap(0, nullptr);
+
+    // BC footprints cover whole blocks, so small mips round up to 4x4.
+    upload.footprints.resize(view.subresources.size());
+    for (size_t i = 0; i < view.subresources.size(); ++i) {
+        const SlTexSubresource& sub = view.subresources[i];
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT& footprint = upload.footprints[i];
+        footprint.Offset = sub.offset;
+        footprint.Footprint.Format = format;
+        footprint.Footprint.Width = blockCompressed ? (sub.width + 3u) & ~3u : sub.width;
+        footprint.Footprint.Height = blockCompressed ? (sub.height + 3u) & ~3u : sub.height;
+        footprint.Footprint.Depth = sub.depth;
+        footprint.Footprint.RowPitch = sub.rowPitch;
+    }
+
+    outTexture = upload.texture;
+    m_pendingTextureUploads.push_back(std::move(upload));
+    return true;
+}
+
+void DemoPlayer::RecordTextureUploads(ID3D12GraphicsCommandList* commandList) {
+    if (m_pendingTextureUploads.empty()) {
+        return;
+    }
+    std::vector<D3D12_RESOURCE_BARRIER> barriers;
+    barriers.reserve(m_pendingTextureUploads.size());
+    for (auto& upload : m_pendingTextureUploads) {
+        for (size_t i = 0; i < upload.footprints.size(); ++i) {
+            D3D12_TEXTURE_COPY_LOCATION dst = {};
+            dst.pResource = upload.texture.Get();
+            dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+            dst.SubresourceIndex = static_cast<UINT>(i);
+            D3D12_TEXTURE_COPY_LOCATION src = {};
+            src.pResource = upload.upload.Get();
+            src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+            src.PlacedFootprint = upload.footprints[i];
+            commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+        }
+
+        D3D12_RESOURCE_BARRIER barrier = {};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = upload.texture.Get();
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+        barriers.push_back(barrier);
+        DeferRelease(std::move(upload.upload));
+    }
+    commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+    m_pendingTextureUploads.clear();
 }
+#endif
 
 
 void DemoPlayer::Update(double wallTime, float dt) {
@@ -1963,6 +2186,7 @@ void DemoPlayer::Update(double wallTime, float dt) {
             for(auto& clip : m_project.audioLibrary) {
                 loadAudioClip(clip, packed);
             }
+            LoadFileTextures(packed);
     #endif
             m_compilationIndex = 0;
 
@@ -1972,29 +2196,33 @@ void DemoPlayer::Update(double wallTime, float dt) {
         }
 
         if (m_loadingStage == LoadingStage::CompilingShaders) {
+#if SHADERLAB_TINY_PLAYER
             if (m_compilationIndex < (int)m_project.scenes.size()) {
                 m_loadingStatus = "Compiling scene " + std::to_string(m_compilationIndex + 1) + "/" + std::to_string(m_project.scenes.size());
                 const bool ok = CompileScene(m_compilationIndex);
                 if (!ok) {
                     TinyTrace("CompileScene failed at index " + std::to_string(m_compilationIndex));
-#if !SHADERLAB_TINY_PLAYER
-                    RuntimeErr("E200", "scene compile failed");
-#endif
                     m_loadingStatus = "Compile failed at scene " + std::to_string(m_compilationIndex);
                 }
                 m_compilationIndex++;
-            } else {
-                PrimeRuntimeResources();
-                m_transport = m_project.transport;
-                m_transport.state = TransportState::Playing;
-                m_transport.timeSeconds = 0.0;
-                m_project.track.currentBeat = 0;
-                m_project.track.lastTriggeredBeat = -1;
-                m_lastFrameTime = wallTime;
-                m_loadingStage = LoadingStage::Ready;
-                m_loadingStatus = "Ready";
-                TinyTrace("LoadingStage READY");
+                return;
+            }
+#else
+            if (!PollPipelineLoading()) {
+                return;
             }
+#endif
+            PrimeRuntimeResources();
+            m_transport = m_project.transport;
+            m_transport.state = TransportState::Playing;
+            m_transport.timeSeconds = 0.0;
+            m_project.track.currentBeat = 0;
+            m_project.track.lastTriggeredBeat = -1;
+            m_sequencer.Reset();
+            m_lastFrameTime = wallTime;
+            m_loadingStage = LoadingStage::Ready;
+            m_loadingStatus = "Ready";
+            TinyTrace("LoadingStage READY");
             return;
         }
         return;
@@ -2019,116 +2247,30 @@ void DemoPlayer::Update(double wallTime, float dt) {
         // if (m_audio) m_audio->Update();
 
         // Track Logic
-        float beatsPerSec = m_transport.bpm / 60.0f;
-        float exactBeat = (float)(m_transport.timeSeconds * beatsPerSec);
-        m_project.track.currentBeat = (int)std::floor(exactBeat);
-
-        if (m_transitionActive) {
-            double transitionEndBeat = m_transitionStartBeat + m_transitionDurationBeats;
-            if (exactBeat >= transitionEndBeat) {
-                m_transitionActive = false;
-                if (m_pendingActiveScene != -2) {
-                    SetActiveScene(m_pendingActiveScene);
-                    m_activeSceneStartBeat = m_transitionToStartBeat;
-                    m_activeSceneOffset = (m_pendingActiveScene >= 0) ? m_transitionToOffset : 0.0f;
-                    m_pendingActiveScene = -2;
-                    m_transitionJustCompletedBeat = m_project.track.currentBeat;
-                }
-            }
-        }
-        
-        auto& track = m_project.track;
-        if (track.lengthBeats > 0 && track.currentBeat >= track.lengthBeats) {
-            if (m_loopPlayback) {
-                m_transport.timeSeconds = 0;
-                m_project.track.currentBeat = 0;
-                m_project.track.lastTriggeredBeat = -1;
-            } else {
-                m_transport.state = TransportState::Stopped;
+        m_sequencer.SetEndPolicy(m_loopPlayback ? SequencerEndPolicy::Loop : SequencerEndPolicy::Stop);
+        m_sequencer.SetSceneCount(static_cast<int>(m_project.scenes.size()));
+        m_sequencer.Advance(m_project.track, m_transport, m_project.audioLibrary, m_sequencerCommands);
 #if !SHADERLAB_TINY_PLAYER
-                if (m_audio) {
-                    m_audio->Stop();
-                }
+        UpdateResidency(m_transport.timeSeconds * (m_transport.bpm / 60.0));
 #endif
-                m_project.track.currentBeat = track.lengthBeats;
-            }
-        }
 
-        if (track.currentBeat > track.lastTriggeredBeat) {
-             for (int b = track.lastTriggeredBeat + 1; b <= track.currentBeat; ++b) {
-                 for(auto& row : track.rows) {
-                     if (row.rowId == b) {
-                         // Scene
-                         if (!row.transitionPresetStem.empty() && row.transitionDuration > 0) {
-                            m_transitionActive = true;
-                            m_transitionFromIndex = m_activeSceneIndex;
-                            m_transitionFromOffset = m_activeSceneOffset;
-                            m_transitionFromStartBeat = m_activeSceneStartBeat;
-                            m_transitionToStartBeat = static_cast<double>(b);
-                            int target = row.sceneIndex;
-                            float targetOffset = row.timeOffset;
-
-                            if (target == -1) {
-                                const TrackerRow* nextRow = FindNextSceneRow(track, b);
-                                if (nextRow) {
-                                    target = nextRow->sceneIndex;
-                                    targetOffset = nextRow->timeOffset;
-                                    m_transitionToStartBeat = static_cast<double>(nextRow->rowId);
-                                }
-                            }
-
-                            if (target == -1) {
-                                targetOffset = 0.0f;
-                                m_transitionToStartBeat = static_cast<double>(b);
-                            } else if (target == m_activeSceneIndex) {
-                                targetOffset = m_activeSceneOffset;
-                                m_transitionToStartBeat = m_activeSceneStartBeat;
-                            }
-                            m_transitionToIndex = target;
-                            m_transitionToOffset = targetOffset;
-                            m_transitionStartBeat = (double)b;
-                            m_transitionDurationBeats = (double)row.transitionDuration;
-                            m_currentTransitionStem = row.transitionPresetStem;
-                            m_pendingActiveScene = target;
-                         } else if (row.sceneIndex >= 0) {
-                             if (m_transitionJustCompletedBeat == row.rowId &&
-                                 row.sceneIndex == m_activeSceneIndex) {
-                                 continue;
-                             }
-                             if (m_transitionActive && row.sceneIndex == m_pendingActiveScene) {
-                                 continue;
-                             }
-                             m_transitionActive = false;
-                             SetActiveScene(row.sceneIndex);
-                             m_activeSceneStartBeat = static_cast<double>(b);
-                             m_activeSceneOffset = row.timeOffset;
-                         }
-                         
-#if !SHADERLAB_TINY_PLAYER
-                         // Audio
-                         if (row.musicIndex >= 0 && row.musicIndex < (int)m_project.audioLibrary.size() && m_audio) {
-                             auto& clip = m_project.audioLibrary[row.musicIndex];
-                             if (loadAudioClip(clip, PackageManager::Get().IsPacked())) {
-                                 m_audio->Play();
-                             }
-                             if(clip.bpm > 0) m_transport.bpm = clip.bpm;
-                         }
-#endif
-                         // Stop
-                         if (row.stop) {
-                             m_transport.state = TransportState::Stopped;
 #if !SHADERLAB_TINY_PLAYER
-                             if (m_audio) {
-                                 m_audio->Stop();
-                             }
-#endif
-                         }
-                     }
-                 }
-             }
-             track.lastTriggeredBeat = track.currentBeat;
+        for (const auto& command : m_sequencerCommands) {
+            // Audio
+            if (command.type == SequencerCommandType::MusicChange &&
+                command.musicIndex < (int)m_project.audioLibrary.size() && m_audio) {
+                auto& clip = m_project.audioLibrary[command.musicIndex];
+                if (loadAudioClip(clip, PackageManager::Get().IsPacked()) &&
+                    m_transport.state == TransportState::Playing) {
+                    m_audio->Play();
+                }
+            }
+            // Stop
+            if (command.type == SequencerCommandType::Stop && m_audio) {
+                m_audio->Stop();
+            }
         }
-        m_transitionJustCompletedBeat = -1;
+#endif
     }
 
 #if SHADERLAB_RUNTIME_DEBUG_LOG && !SHADERLAB_TINY_PLAYER
@@ -2143,15 +2285,10 @@ void DemoPlayer::Update(double wallTime, float dt) {
 }
 
 void DemoPlayer::SetActiveScene(int index) {
-    if (index == -1) {
-        m_activeSceneIndex = -1;
-        return;
-    }
-    if (index >= 0 && index < (int)m_project.scenes.size()) {
-        m_activeSceneIndex = index;
-    } else {
-        m_activeSceneIndex = -1; // Black
-    }
+    // Out-of-range indices render black.
+    const SequencerState& state = m_sequencer.GetState();
+    m_sequencer.SetSceneCount(static_cast<int>(m_project.scenes.size()));
+    m_sequencer.SetActiveScene(index, state.activeSceneOffset, state.activeSceneStartBeat);
 }
 
 bool DemoPlayer::CompileScene(int sceneIndex) {
@@ -2245,6 +2382,111 @@ bool DemoPlayer::CompileScene(int sceneIndex) {
 }
 
 
+#if !SHADERLAB_TINY_PLAYER
+// Non-blocking replacement for calling CompileScene() once per loading frame: every scene,
+// post-FX and compute pipeline is loaded and created on worker threads while the loading
+// screen keeps presenting. Returns true once all pipelines are installed.
+bool DemoPlayer::PollPipelineLoading() {
+    if (!m_pipelineLoader.IsStarted()) {
+        if (!m_renderer || !m_rendererReady) {
+            RuntimeErr("E207", "renderer unavailable for scene compile");
+            return true;
+        }
+
+        std::vector<PipelineLoadJob> jobs;
+        bool hasCompute = false;
+        for (size_t sceneIndex = 0; sceneIndex < m_project.scenes.size(); ++sceneIndex) {
+            const auto& scene = m_project.scenes[sceneIndex];
+            PipelineLoadJob sceneJob;
+            sceneJob.kind = PipelineKind::ScenePixel;
+            sceneJob.sceneIndex = static_cast<int>(sceneIndex);
+            sceneJob.bytecodeKey = scene.precompiledPath;
+            jobs.push_back(sceneJob);
+
+            for (size_t fxIndex = 0; fxIndex < scene.postFxChain.size(); ++fxIndex) {
+                PipelineLoadJob fxJob;
+                fxJob.kind = PipelineKind::PostFxPixel;
+                fxJob.sceneIndex = static_cast<int>(sceneIndex);
+                fxJob.effectIndex = static_cast<int>(fxIndex);
+                fxJob.bytecodeKey = scene.postFxChain[fxIndex].precompiledPath;
+                jobs.push_back(fxJob);
+            }
+            for (size_t computeIndex = 0; computeIndex < scene.computeEffectChain.size(); ++computeIndex) {
+                PipelineLoadJob computeJob;
+                computeJob.kind = PipelineKind::Compute;
+                computeJob.sceneIndex = static_cast<int>(sceneIndex);
+                computeJob.effectIndex = static_cast<int>(computeIndex);
+                computeJob.bytecodeKey = scene.computeEffectChain[computeIndex].precompiledPath;
+                jobs.push_back(computeJob);
+                hasCompute = true;
+            }
+        }
+
+        // The root signature is shared by every compute PSO; create it before workers start.
+        if (hasCompute) {
+            EnsureRuntimeComputeRootSignature(m_device);
+        }
+
+        m_pipelineFactory = std::make_unique<RuntimePipelineFactory>(m_project, m_renderer, m_device, m_manifestPath, jobs.size());
+        m_pipelineLoader.Start(std::move(jobs), *m_pipelineFactory, PipelineLoadScheduler::DefaultWorkerCount());
+    }
+
+    m_loadingStatus = "Loading shaders " + std::to_string(m_pipelineLoader.GetFinishedCount()) + "/" +
+                      std::to_string(m_pipelineLoader.GetJobCount());
+    if (!m_pipelineLoader.Poll()) {
+        return false;
+    }
+
+    auto& factory = static_cast<RuntimePipelineFactory&>(*m_pipelineFactory);
+    for (size_t jobIndex = 0; jobIndex < m_pipelineLoader.GetJobCount(); ++jobIndex) {
+        const PipelineLoadJob& job = m_pipelineLoader.GetJob(jobIndex);
+        const bool ok = m_pipelineLoader.GetJobState(jobIndex) == PipelineLoadState::Ready;
+        auto& scene = m_project.scenes[job.sceneIndex];
+
+        if (job.kind == PipelineKind::ScenePixel) {
+            if (ok) {
+                scene.pipelineState = factory.TakePipeline(jobIndex);
+            } else {
+                SHADERLAB_RT_DEBUG_LOG_ERROR("Missing precompiled scene shader for scene " + scene.name);
+                RuntimeErr("E200", "scene compile failed");
+            }
+        } else if (job.kind == PipelineKind::PostFxPixel) {
+            auto& fx = scene.postFxChain[job.effectIndex];
+            if (ok) {
+                fx.pipelineState = factory.TakePipeline(jobIndex);
+                fx.isDirty = false;
+                fx.lastCompiledCode = fx.shaderCode;
+            } else {
+                SHADERLAB_RT_DEBUG_LOG_ERROR("Failed to compile post fx for scene " + scene.name + " (" + fx.name + ")");
+            }
+        } else {
+            auto& effect = scene.computeEffectChain[job.effectIndex];
+            if (ok) {
+                effect.pipelineState = factory.TakePipeline(jobIndex);
+                effect.compiledShaderBytes = factory.GetBytecodeSize(jobIndex);
+                effect.isDirty = false;
+                effect.lastCompiledCode = effect.shaderCode;
+            } else {
+                // DeclareComputeChain retries dirty effects on the render thread.
+                SHADERLAB_RT_DEBUG_LOG_ERROR("Failed to compile compute fx for scene " + scene.name + " (" + effect.name + ")");
+            }
+        }
+    }
+
+    const PipelineLoadStats& stats = m_pipelineLoader.GetStats();
+    SHADERLAB_RT_DEBUG_LOG("Pipelines loaded: " + std::to_string(stats.jobCount) + " jobs, " +
+                           std::to_string(stats.loadCount) + " loads, " + std::to_string(stats.failedCount) +
+                           " failed, " + std::to_string(stats.workerCount) + " workers, wall " +
+                           std::to_string(stats.wallMs) + " ms (load " + std::to_string(stats.loadMs) +
+                           " ms, create " + std::to_string(stats.createMs) + " ms)");
+    (void)stats;
+
+    m_pipelineLoader.Cancel();
+    m_pipelineFactory.reset();
+    return true;
+}
+#endif
+
 bool DemoPlayer::CompilePostFxEffect(Scene::PostFXEffect& effect, int sceneIndex, int fxIndex) {
     if (!m_renderer || !m_rendererReady) return false;
 
@@ -2373,6 +2615,9 @@ bool DemoPlayer::CompileComputeEffect(Scene::ComputeEffect& effect, int sceneInd
         return false;
     }
 
+    if (effect.pipelineState) {
+        DeferRelease(std::move(effect.pipelineState));
+    }
     effect.pipelineState = pso;
     effect.compiledShaderBytes = bytecode.size();
     effect.isDirty = false;
@@ -2382,21 +2627,22 @@ bool DemoPlayer::CompileComputeEffect(Scene::ComputeEffect& effect, int sceneInd
 }
 
 
-ID3D12Resource* DemoPlayer::ApplyComputeChain(ID3D12GraphicsCommandList* commandList,
-                                             int sceneIndex,
-                                             std::vector<Scene::ComputeEffect>& chain,
-                                             ID3D12Resource* inputTexture,
-                                             double timeSeconds) {
+// Effects with history write into the oldest slot of their ring (historyCount + 1 textures),
+// which becomes history[0] next frame; effects without history write a transient UAV target.
+// Ring textures rest readable by both pixel and compute shaders.
+uint32_t DemoPlayer::DeclareComputeChain(int sceneIndex,
+                                         std::vector<Scene::ComputeEffect>& chain,
+                                         uint32_t input,
+                                         double timeSeconds) {
 #if SHADERLAB_TINY_PLAYER
-    (void)commandList;
     (void)sceneIndex;
     (void)chain;
     (void)timeSeconds;
-    return inputTexture;
+    return input;
 #else
-    if (!commandList || !inputTexture || !m_device || chain.empty()) return inputTexture;
-    if (!EnsureRuntimeComputeRootSignature(m_device) || !EnsureRuntimeComputeDispatchResources(m_device)) {
-        return inputTexture;
+    if (input == RenderGraph::kInvalid || !m_device || chain.empty()) return input;
+    if (!EnsureRuntimeComputeRootSignature(m_device) || !m_descriptorRing || !m_uploadRing) {
+        return input;
     }
 
     bool anyEnabled = false;
@@ -2406,31 +2652,10 @@ ID3D12Resource* DemoPlayer::ApplyComputeChain(ID3D12GraphicsCommandList* command
             break;
         }
     }
-    if (!anyEnabled) return inputTexture;
-
-    auto& resources = g_runtimeComputeSceneResources[sceneIndex];
-    const bool recreate = !resources.textureA || !resources.textureB || resources.width != m_width || resources.height != m_height;
-    if (recreate) {
-        resources = {};
-        if (!CreateRuntimeUavTexture(m_device, m_width, m_height, resources.textureA) ||
-            !CreateRuntimeUavTexture(m_device, m_width, m_height, resources.textureB)) {
-            resources = {};
-            return inputTexture;
-        }
-        resources.width = m_width;
-        resources.height = m_height;
-    }
-
-    ID3D12Device* device = m_device->GetDevice();
-    const UINT step = DescriptorStep(device);
-    const auto heapCpu = g_runtimeComputeDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
-    const auto heapGpu = g_runtimeComputeDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
-
-    ID3D12Resource* currentInput = inputTexture;
-    ID3D12Resource* outputA = resources.textureA.Get();
-    ID3D12Resource* outputB = resources.textureB.Get();
-    ID3D12Resource* currentOutput = outputA;
+    if (!anyEnabled) return input;
 
+    constexpr uint32_t kHistoryAccess = RenderGraphAccessPixelRead | RenderGraphAccessComputeRead;
+    uint32_t currentInput = input;
     for (auto& effect : chain) {
         if (!effect.enabled) continue;
         if (effect.isDirty || !effect.pipelineState) {
@@ -2441,148 +2666,117 @@ ID3D12Resource* DemoPlayer::ApplyComputeChain(ID3D12GraphicsCommandList* command
 
         EnsureComputeHistory(effect);
 
-        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-        srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        srvDesc.Texture2D.MipLevels = 1;
-
-        D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
-        uavDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
-
-        D3D12_CPU_DESCRIPTOR_HANDLE inputCpu = heapCpu;
-        device->CreateShaderResourceView(currentInput, &srvDesc, inputCpu);
-
-        for (uint32_t i = 0; i < kComputeHistorySlots; ++i) {
-            D3D12_CPU_DESCRIPTOR_HANDLE histCpu = heapCpu;
-            histCpu.ptr += static_cast<SIZE_T>(step) * (1 + i);
-            ID3D12Resource* historyRes = nullptr;
-            const int historyCount = static_cast<int>(effect.historyTextures.size());
-            if (historyCount > 0) {
-                int readIndex = effect.historyIndex - static_cast<int>(i);
-                while (readIndex < 0) readIndex += historyCount;
-                readIndex %= historyCount;
-                historyRes = effect.historyTextures[static_cast<size_t>(readIndex)].Get();
+        Scene::ComputeEffect* fx = &effect;
+        const int ringSize = static_cast<int>(effect.historyTextures.size());
+        const int writeIndex = ringSize > 0 ? (effect.historyIndex + 1) % ringSize : 0;
+        const int historyFrames = effect.historyFrames;
+        const uint32_t output = ringSize > 0
+            ? m_renderGraph->Import("compute ring", effect.historyTextures[static_cast<size_t>(writeIndex)].Get(), kHistoryAccess, kHistoryAccess)
+            : m_renderGraph->CreateTexture("compute", m_width, m_height, DXGI_FORMAT_R8G8B8A8_UNORM, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+        const uint32_t pass = m_renderGraph->AddPass(effect.name.empty() ? "compute" : effect.name.c_str(), [this, fx, writeIndex, historyFrames, currentInput, output, timeSeconds](ID3D12GraphicsCommandList* commandList) {
+            ID3D12Device* device = m_device->GetDevice();
+            const UINT step = m_descriptorRing->GetDescriptorSize();
+            ID3D12Resource* src = m_renderGraph->GetResource(currentInput);
+            ID3D12Resource* dst = m_renderGraph->GetResource(output);
+
+            D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+            srvDesc.Texture2D.MipLevels = 1;
+
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+            uavDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+            uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+
+            // Table layout: t0, t1..t8, u0, b0. Views come from the cache; only the CBV is per dispatch.
+            D3D12_CPU_DESCRIPTOR_HANDLE sources[kComputeDescriptorCount - 1] = {};
+            bool sourcesReady = m_descriptorRing->GetSrv(src, srvDesc, sources[0]);
+            // History slot i holds the output of i + 1 frames ago; slots past the effect's history
+            // count repeat, and slots not rendered yet read the input.
+            const int ringSize = static_cast<int>(fx->historyTextures.size());
+            for (uint32_t i = 0; sourcesReady && i < kComputeHistorySlots; ++i) {
+                ID3D12Resource* historyRes = src;
+                if (ringSize > 1) {
+                    const int age = static_cast<int>(i) % (ringSize - 1) + 1;
+                    if (age <= historyFrames) {
+                        historyRes = fx->historyTextures[static_cast<size_t>((writeIndex - age + ringSize) % ringSize)].Get();
+                    }
+                }
+                sourcesReady = m_descriptorRing->GetSrv(historyRes, srvDesc, sources[1 + i]);
+            }
+            sourcesReady = sourcesReady && m_descriptorRing->GetUav(dst, uavDesc, sources[9]);
+
+            void* paramsCpu = nullptr;
+            D3D12_GPU_VIRTUAL_ADDRESS paramsGpu = 0;
+            const uint32_t paramsSize = Align256(static_cast<uint32_t>(sizeof(ComputeDispatchParams)));
+            D3D12_CPU_DESCRIPTOR_HANDLE tableCpu = {};
+            D3D12_GPU_DESCRIPTOR_HANDLE tableGpu = {};
+            if (!sourcesReady ||
+                !m_uploadRing->Allocate(paramsSize, D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT, paramsCpu, paramsGpu) ||
+                !m_descriptorRing->AllocateTable(sources, kComputeDescriptorCount - 1, kComputeDescriptorCount, tableCpu, tableGpu)) {
+                return;
             }
-            if (!historyRes) historyRes = currentInput;
-            device->CreateShaderResourceView(historyRes, &srvDesc, histCpu);
-        }
-
-        D3D12_CPU_DESCRIPTOR_HANDLE outputCpu = heapCpu;
-        outputCpu.ptr += static_cast<SIZE_T>(step) * 9;
-        device->CreateUnorderedAccessView(currentOutput, nullptr, &uavDesc, outputCpu);
-
-        if (!g_runtimeComputeParamsMapped || !g_runtimeComputeParamsBuffer) {
-            return currentInput;
-        }
-
-        ComputeDispatchParams params{};
-        params.param0 = effect.param0;
-        params.param1 = effect.param1;
-        params.param2 = effect.param2;
-        params.param3 = effect.param3;
-        params.time = static_cast<float>(timeSeconds);
-        params.invWidth = m_width > 0 ? 1.0f / static_cast<float>(m_width) : 0.0f;
-        params.invHeight = m_height > 0 ? 1.0f / static_cast<float>(m_height) : 0.0f;
-        params.frame = static_cast<uint32_t>(m_transport.timeSeconds * 60.0);
-        std::memcpy(g_runtimeComputeParamsMapped, &params, sizeof(params));
-
-        D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
-        cbvDesc.BufferLocation = g_runtimeComputeParamsBuffer->GetGPUVirtualAddress();
-        cbvDesc.SizeInBytes = Align256(static_cast<uint32_t>(sizeof(ComputeDispatchParams)));
-        D3D12_CPU_DESCRIPTOR_HANDLE cbvCpu = heapCpu;
-        cbvCpu.ptr += static_cast<SIZE_T>(step) * 10;
-        device->CreateConstantBufferView(&cbvDesc, cbvCpu);
-
-        D3D12_RESOURCE_BARRIER beginBarriers[2] = {};
-        beginBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        beginBarriers[0].Transition.pResource = currentInput;
-        beginBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        beginBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        beginBarriers[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-
-        beginBarriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-        beginBarriers[1].Transition.pResource = currentOutput;
-        beginBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        beginBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        beginBarriers[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        commandList->ResourceBarrier(2, beginBarriers);
-
-        ID3D12DescriptorHeap* heaps[] = { g_runtimeComputeDescriptorHeap.Get() };
-        commandList->SetDescriptorHeaps(1, heaps);
-        commandList->SetComputeRootSignature(g_runtimeComputeRootSignature.Get());
-        commandList->SetPipelineState(effect.pipelineState.Get());
-
-        D3D12_GPU_DESCRIPTOR_HANDLE inputGpu = heapGpu;
-        D3D12_GPU_DESCRIPTOR_HANDLE historyGpu = heapGpu;
-        historyGpu.ptr += static_cast<UINT64>(step) * 1;
-        D3D12_GPU_DESCRIPTOR_HANDLE outputGpu = heapGpu;
-        outputGpu.ptr += static_cast<UINT64>(step) * 9;
-        D3D12_GPU_DESCRIPTOR_HANDLE cbvGpu = heapGpu;
-        cbvGpu.ptr += static_cast<UINT64>(step) * 10;
-
-        commandList->SetComputeRootDescriptorTable(0, inputGpu);
-        commandList->SetComputeRootDescriptorTable(1, historyGpu);
-        commandList->SetComputeRootDescriptorTable(2, outputGpu);
-        commandList->SetComputeRootDescriptorTable(3, cbvGpu);
-
-        const uint32_t tgx = (std::max)(1u, effect.threadGroupX);
-        const uint32_t tgy = (std::max)(1u, effect.threadGroupY);
-        const uint32_t tgz = (std::max)(1u, effect.threadGroupZ);
-        const uint32_t groupsX = (m_width + tgx - 1u) / tgx;
-        const uint32_t groupsY = (m_height + tgy - 1u) / tgy;
-        const uint32_t groupsZ = (1u + tgz - 1u) / tgz;
-        commandList->Dispatch(groupsX, groupsY, groupsZ);
-
-        D3D12_RESOURCE_BARRIER uavBarrier = {};
-        uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
-        uavBarrier.UAV.pResource = currentOutput;
-        commandList->ResourceBarrier(1, &uavBarrier);
-
-        D3D12_RESOURCE_BARRIER endBarriers[2] = {};
-        endBarriers[0] = beginBarriers[0];
-        endBarriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
-        endBarriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        endBarriers[1] = beginBarriers[1];
-        endBarriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
-        endBarriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-        commandList->ResourceBarrier(2, endBarriers);
-
-        if (!effect.historyTextures.empty()) {
-            const int historyCount = static_cast<int>(effect.historyTextures.size());
-            const int writeIndex = (effect.historyIndex + 1) % historyCount;
-
-            D3D12_RESOURCE_BARRIER preCopy[2] = {};
-            preCopy[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-            preCopy[0].Transition.pResource = currentOutput;
-            preCopy[0].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            preCopy[0].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            preCopy[0].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-
-            preCopy[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-            preCopy[1].Transition.pResource = effect.historyTextures[static_cast<size_t>(writeIndex)].Get();
-            preCopy[1].Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            preCopy[1].Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_DEST;
-            preCopy[1].Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-            commandList->ResourceBarrier(2, preCopy);
-
-            commandList->CopyResource(effect.historyTextures[static_cast<size_t>(writeIndex)].Get(), currentOutput);
-
-            preCopy[0].Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
-            preCopy[0].Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            preCopy[1].Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-            preCopy[1].Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-            commandList->ResourceBarrier(2, preCopy);
 
+            ComputeDispatchParams params{};
+            params.param0 = fx->param0;
+            params.param1 = fx->param1;
+            params.param2 = fx->param2;
+            params.param3 = fx->param3;
+            params.time = static_cast<float>(timeSeconds);
+            params.invWidth = m_width > 0 ? 1.0f / static_cast<float>(m_width) : 0.0f;
+            params.invHeight = m_height > 0 ? 1.0f / static_cast<float>(m_height) : 0.0f;
+            params.frame = static_cast<uint32_t>(m_transport.timeSeconds * 60.0);
+            params.historyFrames = static_cast<uint32_t>(historyFrames);
+            std::memcpy(paramsCpu, &params, sizeof(params));
+
+            D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
+            cbvDesc.BufferLocation = paramsGpu;
+            cbvDesc.SizeInBytes = paramsSize;
+            D3D12_CPU_DESCRIPTOR_HANDLE cbvCpu = tableCpu;
+            cbvCpu.ptr += static_cast<SIZE_T>(step) * 10;
+            device->CreateConstantBufferView(&cbvDesc, cbvCpu);
+
+            ID3D12DescriptorHeap* heaps[] = { m_descriptorRing->GetHeap() };
+            commandList->SetDescriptorHeaps(1, heaps);
+            commandList->SetComputeRootSignature(g_runtimeComputeRootSignature.Get());
+            commandList->SetPipelineState(fx->pipelineState.Get());
+
+            D3D12_GPU_DESCRIPTOR_HANDLE inputGpu = tableGpu;
+            D3D12_GPU_DESCRIPTOR_HANDLE historyGpu = tableGpu;
+            historyGpu.ptr += static_cast<UINT64>(step) * 1;
+            D3D12_GPU_DESCRIPTOR_HANDLE outputGpu = tableGpu;
+            outputGpu.ptr += static_cast<UINT64>(step) * 9;
+            D3D12_GPU_DESCRIPTOR_HANDLE cbvGpu = tableGpu;
+            cbvGpu.ptr += static_cast<UINT64>(step) * 10;
+
+            commandList->SetComputeRootDescriptorTable(0, inputGpu);
+            commandList->SetComputeRootDescriptorTable(1, historyGpu);
+            commandList->SetComputeRootDescriptorTable(2, outputGpu);
+            commandList->SetComputeRootDescriptorTable(3, cbvGpu);
+
+            const uint32_t tgx = (std::max)(1u, fx->threadGroupX);
+            const uint32_t tgy = (std::max)(1u, fx->threadGroupY);
+            const uint32_t tgz = (std::max)(1u, fx->threadGroupZ);
+            const uint32_t groupsX = (m_width + tgx - 1u) / tgx;
+            const uint32_t groupsY = (m_height + tgy - 1u) / tgy;
+            const uint32_t groupsZ = (1u + tgz - 1u) / tgz;
+            commandList->Dispatch(groupsX, groupsY, groupsZ);
+        });
+        m_renderGraph->Read(pass, currentInput, RenderGraphAccessComputeRead);
+        for (int age = 1; age <= historyFrames && age < ringSize; ++age) {
+            ID3D12Resource* history = effect.historyTextures[static_cast<size_t>((writeIndex - age + ringSize) % ringSize)].Get();
+            m_renderGraph->Read(pass, m_renderGraph->Import("compute ring", history, kHistoryAccess, kHistoryAccess), RenderGraphAccessComputeRead);
+        }
+        m_renderGraph->Write(pass, output, RenderGraphAccessUnorderedAccess);
+
+        if (ringSize > 0) {
             effect.historyIndex = writeIndex;
+            effect.historyFrames = (std::min)(historyFrames + 1, ringSize - 1);
             effect.historyInitialized = true;
         }
-
-        currentInput = currentOutput;
-        currentOutput = (currentOutput == outputA) ? outputB : outputA;
+        currentInput = output;
     }
-
     return currentInput;
 #endif
 }
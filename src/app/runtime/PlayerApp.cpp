@@ -339,7 +339,7 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
 #endif
 
     g_Resources.commandQueue = new CommandQueue();
-    if (!g_Resources.commandQueue->Initialize(g_Resources.device, D3D12_COMMAND_LIST_TYPE_DIRECT)) {
+    if (!g_Resources.commandQueue->Initialize(g_Resources.device, D3D12_COMMAND_LIST_TYPE_DIRECT, Swapchain::BUFFER_COUNT)) {
 #if !SHADERLAB_TINY_PLAYER
         RuntimeStartupPolicy::EmitRuntimeError("E103", "command queue init failed");
 #endif
@@ -384,6 +384,8 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
     }
     g_Resources.player->SetLooping(options.loopPlayback);
     g_Resources.player->SetVsyncEnabled(g_Runtime.vsyncEnabled);
+    g_Resources.player->SetResidencyLeadBeats(options.residencyLeadBeats);
+    g_Resources.player->SetDynamicResolution(options.dynamicResolutionTargetMs, options.dynamicResolutionMinWidth);
 
 #if SHADERLAB_TINY_PLAYER
     const std::string projectPath = "assets/track.bin";
@@ -469,7 +471,9 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
                 }
             }
 
+            // Blocks only if the frame that last used this allocator is still on the GPU.
             g_Resources.commandQueue->ResetCommandList();
+            g_Resources.player->SetGpuFrame(g_Resources.commandQueue->GetFrameIndex(), g_Resources.commandQueue->GetCompletedFrameIndex());
             auto cmdList = g_Resources.commandQueue->GetCommandList();
 
             auto* backBuffer = g_Resources.swapchain->GetCurrentBackBuffer();
@@ -494,7 +498,6 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
 
             g_Resources.commandQueue->ExecuteCommandList();
             g_Resources.swapchain->Present(g_Runtime.vsyncEnabled);
-            g_Resources.commandQueue->WaitForGPU();
 
             g_Runtime.fpsAccumSeconds += dt;
             g_Runtime.fpsAccumFrames += 1;
@@ -2,6 +2,7 @@
 #include <DbgHelp.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -138,6 +139,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
     bool loopPlayback = !HasAnyFlag(args, {L"--no-loop", L"-noloop"});
     bool vsyncEnabled = true;
     bool startFullscreen = true;
+    double residencyLeadBeats = 4.0;
+    double dynamicResolutionTargetMs = 0.0;
+    uint32_t dynamicResolutionMinWidth = 0;
     if (HasAnyFlag(args, {L"--loop", L"-loop"})) {
         loopPlayback = true;
     }
@@ -151,6 +155,16 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
             startFullscreen = false;
         } else if (IsArg(args[i], L"--fullscreen") || IsArg(args[i], L"-fullscreen")) {
             startFullscreen = true;
+        } else if (IsArg(args[i], L"--eager-resources")) {
+            residencyLeadBeats = -1.0;
+        } else if (IsArg(args[i], L"--residency-lead") && i + 1 < args.size()) {
+            residencyLeadBeats = (std::max)(0.0, std::wcstod(args[++i].c_str(), nullptr));
+        } else if (IsArg(args[i], L"--dynamic-resolution")) {
+            dynamicResolutionTargetMs = 1000.0 / 60.0;
+        } else if (IsArg(args[i], L"--dynres-target") && i + 1 < args.size()) {
+            dynamicResolutionTargetMs = (std::max)(0.0, std::wcstod(args[++i].c_str(), nullptr));
+        } else if (IsArg(args[i], L"--dynres-min-width") && i + 1 < args.size()) {
+            dynamicResolutionMinWidth = static_cast<uint32_t>(std::wcstoul(args[++i].c_str(), nullptr, 10));
         }
     }
 
@@ -160,6 +174,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int) {
     options.screenSaverMode = false;
     options.vsyncEnabled = vsyncEnabled;
     options.startFullscreen = startFullscreen;
+    options.residencyLeadBeats = residencyLeadBeats;
+    options.dynamicResolutionTargetMs = dynamicResolutionTargetMs;
+    options.dynamicResolutionMinWidth = dynamicResolutionMinWidth;
 
     return ShaderLab::RunPlayerApp(hInstance, options);
 }
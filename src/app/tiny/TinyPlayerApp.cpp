@@ -149,7 +149,7 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
     }
 
     g_resources.commandQueue = new CommandQueue();
-    if (!g_resources.commandQueue->Initialize(g_resources.device, D3D12_COMMAND_LIST_TYPE_DIRECT)) {
+    if (!g_resources.commandQueue->Initialize(g_resources.device, D3D12_COMMAND_LIST_TYPE_DIRECT, Swapchain::BUFFER_COUNT)) {
         ShutdownTinyRuntimeResources();
         return -1;
     }
@@ -202,7 +202,9 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
                 }
             }
 
+            // Blocks only if the frame that last used this allocator is still on the GPU.
             g_resources.commandQueue->ResetCommandList();
+            g_resources.player->SetGpuFrame(g_resources.commandQueue->GetFrameIndex(), g_resources.commandQueue->GetCompletedFrameIndex());
             auto* cmdList = g_resources.commandQueue->GetCommandList();
 
             auto* backBuffer = g_resources.swapchain->GetCurrentBackBuffer();
@@ -226,7 +228,6 @@ int RunPlayerApp(HINSTANCE hInstance, const PlayerLaunchOptions& options) {
 
             g_resources.commandQueue->ExecuteCommandList();
             g_resources.swapchain->Present(g_runtime.vsyncEnabled);
-            g_resources.commandQueue->WaitForGPU();
         }
     }
 
@@ -69,7 +69,9 @@ void PrintUsage() {
         << "  [--restricted-compact-track]\n"
         << "  [--runtime-debug]\n"
         << "  [--compact-debug]\n"
-        << "  [--micro-dev]\n";
+        << "  [--micro-dev]\n"
+        << "  [--texture-format rgba8|bc1|bc4|bc7]\n"
+        << "  [--no-texture-mips]\n";
 }
 
 } // namespace
@@ -105,6 +107,13 @@ int main(int argc, char** argv) {
         } else if (arg == "--micro-dev") {
             request.microDeveloperBuild = true;
             request.runtimeDebugLog = true;
+        } else if (arg == "--texture-format" && i + 1 < argc) {
+            if (!ShaderLab::ParseBakedTextureFormat(argv[++i], request.textureFormat)) {
+                PrintUsage();
+                return 2;
+            }
+        } else if (arg == "--no-texture-mips") {
+            request.textureMips = false;
         } else if (arg == "--help" || arg == "-h") {
             PrintUsage();
             return 0;
@@ -0,0 +1,309 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/AudioAnalyzer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Synthetic mono signals at 48 kHz for the audio analysis checks.
+std::vector<float> MakeSine(float hz, float amplitude, float seconds, uint32_t sampleRate) {
+    std::vector<float> samples(static_cast<size_t>(seconds * sampleRate));
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = amplitude * static_cast<float>(std::sin(2.0 * 3.14159265358979323846 * hz * i / sampleRate));
+    }
+    return samples;
+}
+
+size_t FeedAnalyzer(ShaderLab::AudioAnalyzer& analyzer, const std::vector<float>& samples, size_t chunk,
+                    std::vector<ShaderLab::AudioAnalysisFrame>* outFrames = nullptr) {
+    size_t hops = 0;
+    for (size_t offset = 0; offset < samples.size(); offset += chunk) {
+        analyzer.PushInterleaved(samples.data() + offset, (std::min)(chunk, samples.size() - offset), 1);
+        const size_t analyzed = analyzer.Pump();
+        hops += analyzed;
+        if (outFrames && analyzed > 0) {
+            ShaderLab::AudioAnalysisFrame frame;
+            analyzer.GetLatest(frame);
+            outFrames->push_back(frame);
+        }
+    }
+    return hops;
+}
+
+} // namespace
+
+int RunAudioBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    const double seconds = options.audioSeconds > 0 ? options.audioSeconds : 10.0;
+    const uint32_t sampleRate = 48000;
+    int errors = 0;
+    std::string error;
+
+    // FFT against a direct DFT, for sizes with and without the radix-2 pass.
+    for (const uint32_t size : { 16u, 64u, 512u, 1024u, 2048u }) {
+        AudioFft fft;
+        if (!fft.Initialize(size, error)) {
+            ++errors;
+            continue;
+        }
+        uint32_t seed = size;
+        std::vector<float> re(size);
+        std::vector<float> im(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            re[i] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+            seed = seed * 1664525u + 1013904223u;
+            im[i] = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+        }
+        std::vector<float> outRe = re;
+        std::vector<float> outIm = im;
+        fft.Forward(outRe.data(), outIm.data());
+        double worst = 0.0;
+        for (uint32_t k = 0; k < size; ++k) {
+            double sumRe = 0.0;
+            double sumIm = 0.0;
+            for (uint32_t i = 0; i < size; ++i) {
+                const double angle = -2.0 * 3.14159265358979323846 * static_cast<double>((static_cast<uint64_t>(i) * k) % size) / size;
+                sumRe += re[i] * std::cos(angle) - im[i] * std::sin(angle);
+                sumIm += re[i] * std::sin(angle) + im[i] * std::cos(angle);
+            }
+            worst = (std::max)(worst, std::hypot(sumRe - outRe[k], sumIm - outIm[k]) / std::sqrt(static_cast<double>(size)));
+        }
+        if (worst > 1e-4) {
+            ++errors;
+        }
+
+        const int iterations = static_cast<int>(4000000 / size);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            fft.Forward(outRe.data(), outIm.data());
+            if (std::fabs(outRe[0]) > 1e30f) {
+                std::fill(outRe.begin(), outRe.end(), 0.5f);
+            }
+        }
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+        std::printf("fft %5u: error=%.2e %.2f us\n", size, worst, us);
+    }
+
+    // Ring: one producer thread pushing a counter in uneven chunks, the consumer checks the order.
+    {
+        AudioSampleRing ring(4096);
+        const uint32_t total = 1u << 22;
+        std::atomic<bool> producerDone{ false };
+        const auto start = std::chrono::steady_clock::now();
+        std::thread producer([&]() {
+            float chunk[700];
+            uint32_t next = 0;
+            uint32_t size = 1;
+            while (next < total) {
+                size = size * 7u % 691u + 1u;
+                const uint32_t count = (std::min)(size, total - next);
+                for (uint32_t i = 0; i < count; ++i) {
+                    chunk[i] = static_cast<float>((next + i) & 0xFFFFFu);
+                }
+                uint32_t pushed = 0;
+                while (pushed < count) {
+                    pushed += static_cast<uint32_t>(ring.Push(chunk + pushed, count - pushed));
+                    if (pushed < count) {
+                        std::this_thread::yield();
+                    }
+                }
+                next += count;
+            }
+            producerDone = true;
+        });
+        std::vector<float> buffer(1000);
+        uint32_t expected = 0;
+        uint32_t mismatches = 0;
+        while (expected < total) {
+            const size_t popped = ring.Pop(buffer.data(), buffer.size());
+            for (size_t i = 0; i < popped; ++i, ++expected) {
+                mismatches += buffer[i] != static_cast<float>(expected & 0xFFFFFu) ? 1u : 0u;
+            }
+            if (popped == 0) {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        // Pushing into a full ring drops and counts instead of blocking.
+        AudioSampleRing small(8);
+        const float burst[12] = {};
+        const size_t accepted = small.Push(burst, 12);
+        if (mismatches != 0 || !producerDone || ring.GetReadable() != 0 || accepted != 8 || small.GetDroppedSamples() != 4) {
+            ++errors;
+        }
+        std::printf("ring: samples=%u mismatches=%u %.1f Msamples/s dropped_on_full=%llu\n", total, mismatches,
+                    total / (ms * 1000.0), static_cast<unsigned long long>(small.GetDroppedSamples()));
+    }
+
+    AudioAnalyzerConfig config;
+    config.sampleRate = sampleRate;
+
+    // A sine lands in the band that contains it; stereo downmix keeps its level.
+    for (const float hz : { 250.0f, 600.0f, 1200.0f, 2500.0f, 5000.0f, 11000.0f }) {
+        AudioAnalyzer analyzer;
+        if (!analyzer.Configure(config, error)) {
+            ++errors;
+            break;
+        }
+        const std::vector<float> mono = MakeSine(hz, 0.5f, 0.25f, sampleRate);
+        std::vector<float> stereo(mono.size() * 2u);
+        for (size_t i = 0; i < mono.size(); ++i) {
+            stereo[i * 2u] = mono[i];
+            stereo[i * 2u + 1u] = mono[i];
+        }
+        for (size_t offset = 0; offset < mono.size(); offset += 480) {
+            analyzer.PushInterleaved(stereo.data() + offset * 2u, (std::min)(size_t(480), mono.size() - offset), 2);
+            analyzer.Pump();
+        }
+        AudioAnalysisFrame frame;
+        analyzer.GetLatest(frame);
+        uint32_t expectedBand = 0;
+        uint32_t loudest = 0;
+        for (uint32_t band = 0; band < frame.bandCount; ++band) {
+            float lowHz = 0.0f;
+            float highHz = 0.0f;
+            analyzer.GetBandRange(band, lowHz, highHz);
+            if (hz >= lowHz && hz < highHz) {
+                expectedBand = band;
+            }
+            if (frame.bands[band] > frame.bands[loudest]) {
+                loudest = band;
+            }
+        }
+        float farthest = 0.0f;
+        for (uint32_t band = 0; band < frame.bandCount; ++band) {
+            if (band + 1u < expectedBand || band > expectedBand + 1u) {
+                farthest = (std::max)(farthest, frame.bands[band]);
+            }
+        }
+        // 0.5 amplitude is -6 dBFS.
+        const float expectedLevel = (-6.02f - config.floorDb) / -config.floorDb;
+        if (loudest != expectedBand || std::fabs(frame.bands[loudest] - expectedLevel) > 0.03f || farthest > 0.4f ||
+            std::fabs(frame.rms - 0.3536f) > 0.01f || std::fabs(frame.peak - 0.5f) > 0.01f) {
+            ++errors;
+        }
+        const AudioShaderBlock block = analyzer.GetShaderBlock();
+        std::printf("sine %5.0f Hz: band=%u/%u level=%.3f others<=%.3f rms=%.4f shader_band=%.3f\n", hz, loudest,
+                    expectedBand, frame.bands[loudest], farthest, frame.rms, block.bands[loudest]);
+    }
+
+    // Silence stays at zero; a click train triggers one onset per click close to its time.
+    {
+        AudioAnalyzer analyzer;
+        analyzer.Configure(config, error);
+        std::vector<float> signal(static_cast<size_t>(sampleRate) * 3u, 0.0f);
+        std::vector<double> clickTimes;
+        uint32_t seed = 7;
+        for (double t = 0.5; t < 2.9; t += 0.3) {
+            clickTimes.push_back(t);
+            const size_t first = static_cast<size_t>(t * sampleRate);
+            for (size_t i = 0; i < 480; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                const float noise = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+                signal[first + i] += 0.5f * noise * std::exp(-static_cast<float>(i) / 120.0f);
+            }
+        }
+        // A quiet steady tone underneath must not trigger anything by itself.
+        const std::vector<float> hum = MakeSine(110.0f, 0.05f, 3.0f, sampleRate);
+        for (size_t i = 0; i < signal.size(); ++i) {
+            signal[i] += hum[i];
+        }
+        std::vector<float> silence(sampleRate / 2u, 0.0f);
+        std::vector<AudioAnalysisFrame> frames;
+        FeedAnalyzer(analyzer, silence, 256, &frames);
+        const AudioAnalysisFrame silent = frames.empty() ? AudioAnalysisFrame() : frames.back();
+        const bool silentOk = !frames.empty() && silent.rms == 0.0f && silent.bands[0] == 0.0f && analyzer.GetStats().onsets == 0;
+        analyzer.Reset();
+        frames.clear();
+        FeedAnalyzer(analyzer, signal, 256, &frames);
+
+        const double window = static_cast<double>(config.fftSize) / sampleRate;
+        size_t matched = 0;
+        size_t spurious = 0;
+        for (const AudioAnalysisFrame& frame : frames) {
+            if (!frame.onsetTriggered) {
+                continue;
+            }
+            // Frame times count from the Reset, i.e. half a second into the stream.
+            const double time = frame.timeSeconds - 0.5;
+            const bool hit = std::any_of(clickTimes.begin(), clickTimes.end(),
+                                         [&](double click) { return time >= click && time <= click + window; });
+            hit ? ++matched : ++spurious;
+        }
+        // The envelope decays to about 1/e after onsetRelease.
+        float envelopeAfterRelease = 1.0f;
+        for (const AudioAnalysisFrame& frame : frames) {
+            const double time = frame.timeSeconds - 0.5;
+            if (time > clickTimes[0] + window + config.onsetRelease && time < clickTimes[1]) {
+                envelopeAfterRelease = frame.onset;
+                break;
+            }
+        }
+        if (!silentOk || matched != clickTimes.size() || spurious != 0 || envelopeAfterRelease > 0.37f) {
+            ++errors;
+        }
+        std::printf("onsets: clicks=%zu matched=%zu spurious=%zu envelope_after_release=%.2f silence_ok=%d\n",
+                    clickTimes.size(), matched, spurious, envelopeAfterRelease, silentOk ? 1 : 0);
+    }
+
+    // Worker mode at full speed: a producer thread plays the part of the audio callback.
+    {
+        AudioAnalyzerConfig workerConfig = config;
+        workerConfig.bandCount = 32;
+        workerConfig.ringCapacity = static_cast<size_t>(seconds * sampleRate) + workerConfig.fftSize;
+        AudioAnalyzer analyzer;
+        analyzer.Configure(workerConfig, error);
+        const std::vector<float> music = MakeSine(440.0f, 0.25f, static_cast<float>(seconds), sampleRate);
+        std::vector<float> stereo(music.size() * 2u);
+        for (size_t i = 0; i < music.size(); ++i) {
+            stereo[i * 2u] = music[i];
+            stereo[i * 2u + 1u] = -0.5f * music[i];
+        }
+        analyzer.Start();
+        const auto start = std::chrono::steady_clock::now();
+        std::thread callback([&]() {
+            for (size_t offset = 0; offset < music.size(); offset += 512) {
+                analyzer.PushInterleaved(stereo.data() + offset * 2u, (std::min)(size_t(512), music.size() - offset), 2);
+            }
+        });
+        callback.join();
+        const uint64_t expectedHops = music.size() / workerConfig.hopSize;
+        while (analyzer.GetStats().hops < expectedHops &&
+               std::chrono::steady_clock::now() - start < std::chrono::seconds(30)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        analyzer.Stop();
+        const AudioAnalyzerStats stats = analyzer.GetStats();
+        const AudioShaderBlock block = analyzer.GetShaderBlock();
+        const double hopBudgetMs = 1000.0 * workerConfig.hopSize / sampleRate;
+        const double perHopMs = stats.hops > 0 ? stats.analyzeMs / stats.hops : 0.0;
+        if (stats.hops != expectedHops || stats.droppedSamples != 0 || perHopMs > hopBudgetMs || block.rms <= 0.0f) {
+            ++errors;
+        }
+        std::printf("worker: %.1f s audio in %.1f ms hops=%llu dropped=%llu analyze=%.3f ms/hop (budget %.2f) realtime_x=%.0f\n",
+                    seconds, wallMs, static_cast<unsigned long long>(stats.hops),
+                    static_cast<unsigned long long>(stats.droppedSamples), perHopMs, hopBudgetMs,
+                    perHopMs > 0.0 ? hopBudgetMs / perHopMs : 0.0);
+    }
+
+    std::printf("audio: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
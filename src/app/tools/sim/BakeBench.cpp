@@ -0,0 +1,236 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/TextureBaker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Smooth colour ramps with an alpha gradient; block codecs should reproduce them closely.
+void FillBakeBenchImage(uint32_t width, uint32_t height, float phase, ShaderLab::DecodedImage& outImage) {
+    outImage.width = width;
+    outImage.height = height;
+    outImage.rgba.resize(static_cast<size_t>(width) * height * 4u);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* texel = outImage.rgba.data() + (static_cast<size_t>(y) * width + x) * 4u;
+            texel[0] = static_cast<uint8_t>(127.5 + 127.0 * std::sin(x * 0.045 + phase));
+            texel[1] = static_cast<uint8_t>(255u * y / (std::max)(height - 1u, 1u));
+            texel[2] = static_cast<uint8_t>(127.5 + 127.0 * std::cos((x + y) * 0.03 - phase));
+            texel[3] = static_cast<uint8_t>(255u * x / (std::max)(width - 1u, 1u));
+        }
+    }
+}
+
+// PSNR over the first channels of every texel; both buffers are tightly packed RGBA8.
+double BakePsnr(const std::vector<uint8_t>& expected, const std::vector<uint8_t>& actual, int channels) {
+    if (expected.size() != actual.size() || expected.empty()) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < expected.size(); i += 4) {
+        for (int c = 0; c < channels; ++c) {
+            const double d = static_cast<double>(expected[i + c]) - actual[i + c];
+            sum += d * d;
+            ++count;
+        }
+    }
+    if (sum == 0.0) {
+        return 99.0;
+    }
+    return 10.0 * std::log10(255.0 * 255.0 / (sum / count));
+}
+
+} // namespace
+
+int RunBakeBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    const uint32_t size = options.bakeSize > 0 ? (std::max)(static_cast<uint32_t>(options.bakeSize), 8u) & ~3u : 256u;
+    int errors = 0;
+
+    struct Case {
+        BakedTextureDimension dimension;
+        const char* name;
+        uint32_t edge;     // Face / slice edge
+        uint32_t slices;   // Cube faces or volume depth
+    };
+    const uint32_t volumeEdge = (std::max)(size / 8u, 4u);
+    const Case cases[] = {
+        { BakedTextureDimension::Texture2D, "2d", size, 1 },
+        { BakedTextureDimension::TextureCube, "cube", size / 2u, 6 },
+        { BakedTextureDimension::Texture3D, "3d", volumeEdge, volumeEdge },
+    };
+    struct Format {
+        BakedTextureFormat format;
+        int channels;      // Channels that must survive
+        double minPsnr;
+    };
+    const Format formats[] = {
+        { BakedTextureFormat::RGBA8, 4, 99.0 },
+        { BakedTextureFormat::BC1, 3, 32.0 },
+        { BakedTextureFormat::BC4, 1, 40.0 },
+        { BakedTextureFormat::BC7, 4, 36.0 },
+    };
+
+    for (const Case& test : cases) {
+        DecodedImage source;
+        const bool vertical = test.dimension == BakedTextureDimension::Texture3D;
+        FillBakeBenchImage(vertical ? test.edge : test.edge * test.slices, vertical ? test.edge * test.slices : test.edge,
+                           0.5f, source);
+        for (const Format& format : formats) {
+            TextureBakeOptions bakeOptions;
+            bakeOptions.format = format.format;
+            bakeOptions.srgb = format.format != BakedTextureFormat::BC4;
+            std::vector<uint8_t> file;
+            std::string error;
+            TextureBakeStats stats;
+            SlTexView view;
+            if (!BakeTexture(source, test.dimension, bakeOptions, file, error, &stats) ||
+                !SlTexView::Parse(file.data(), file.size(), view, error)) {
+                std::printf("bake %s %s failed: %s\n", test.name, GetBakedTextureFormatName(format.format), error.c_str());
+                ++errors;
+                continue;
+            }
+            const uint32_t expectedArray = test.dimension == BakedTextureDimension::TextureCube ? 6u : 1u;
+            const uint32_t expectedDepth = test.dimension == BakedTextureDimension::Texture3D ? test.slices : 1u;
+            uint32_t expectedMips = 1;
+            for (uint32_t extent = (std::max)(test.edge, expectedDepth); extent > 1; extent >>= 1) {
+                ++expectedMips;
+            }
+            if (view.GetFormat() != format.format || view.header.width != test.edge || view.header.height != test.edge ||
+                view.header.depth != expectedDepth || view.header.arraySize != expectedArray ||
+                view.header.mipLevels != expectedMips || view.header.payloadOffset % kSlTexPlacementAlignment != 0 ||
+                view.IsSrgb() != bakeOptions.srgb) {
+                ++errors;
+            }
+
+            // Top level of every face / the whole volume against the source tiles.
+            double worstPsnr = 99.0;
+            for (uint32_t slice = 0; slice < view.header.arraySize; ++slice) {
+                std::vector<uint8_t> decoded;
+                if (!DecodeSlTexSubresource(view, slice * view.header.mipLevels, decoded, error)) {
+                    ++errors;
+                    continue;
+                }
+                std::vector<uint8_t> expected(decoded.size());
+                const size_t rowBytes = static_cast<size_t>(test.edge) * 4u;
+                const uint32_t rows = test.edge * view.header.depth;
+                for (uint32_t row = 0; row < rows; ++row) {
+                    const uint8_t* src = test.dimension == BakedTextureDimension::TextureCube
+                        ? source.rgba.data() + static_cast<size_t>(row) * source.width * 4u + slice * rowBytes
+                        : source.rgba.data() + static_cast<size_t>(row) * rowBytes;
+                    std::memcpy(expected.data() + row * rowBytes, src, rowBytes);
+                }
+                worstPsnr = (std::min)(worstPsnr, BakePsnr(expected, decoded, format.channels));
+            }
+            for (uint32_t i = 0; i < view.header.subresourceCount; ++i) {
+                std::vector<uint8_t> decoded;
+                if (!DecodeSlTexSubresource(view, i, decoded, error)) {
+                    ++errors;
+                }
+            }
+            if (worstPsnr < format.minPsnr) {
+                ++errors;
+            }
+            std::printf("bake %-4s %-5s: %ux%ux%u mips=%u bytes=%llu ratio=%.2f psnr=%.1f mip_ms=%.1f encode_ms=%.1f\n",
+                        test.name, GetBakedTextureFormatName(format.format), test.edge, test.edge,
+                        test.slices, view.header.mipLevels, static_cast<unsigned long long>(file.size()),
+                        static_cast<double>(stats.sourceBytes) / file.size(), worstPsnr, stats.mipMs, stats.encodeMs);
+        }
+    }
+
+    // sRGB-aware filtering: a black/white checkerboard averages to 50% linear light, not code 128.
+    {
+        DecodedImage checker;
+        checker.width = 8;
+        checker.height = 8;
+        checker.rgba.resize(8 * 8 * 4);
+        for (uint32_t i = 0; i < 64; ++i) {
+            const uint8_t v = ((i % 8) + (i / 8)) % 2 ? 255 : 0;
+            std::memset(checker.rgba.data() + i * 4u, v, 3);
+            checker.rgba[i * 4u + 3] = 255;
+        }
+        for (const MipFilter filter : { MipFilter::Box, MipFilter::Kaiser }) {
+            for (const bool srgb : { true, false }) {
+                TextureBakeOptions bakeOptions;
+                bakeOptions.format = BakedTextureFormat::RGBA8;
+                bakeOptions.mipFilter = filter;
+                bakeOptions.srgb = srgb;
+                std::vector<uint8_t> file;
+                std::vector<uint8_t> mip1;
+                std::string error;
+                SlTexView view;
+                if (!BakeTexture(checker, BakedTextureDimension::Texture2D, bakeOptions, file, error) ||
+                    !SlTexView::Parse(file.data(), file.size(), view, error) ||
+                    !DecodeSlTexSubresource(view, 1, mip1, error)) {
+                    ++errors;
+                    continue;
+                }
+                // Kaiser lobes do not cancel the pattern exactly next to the clamped edges.
+                const int expected = srgb ? 188 : 128;
+                const int tolerance = filter == MipFilter::Box ? 1 : 8;
+                for (size_t i = 0; i < mip1.size(); i += 4) {
+                    if (std::abs(static_cast<int>(mip1[i]) - expected) > tolerance) {
+                        ++errors;
+                        break;
+                    }
+                }
+                std::printf("mip_filter %-6s srgb=%d: mip1=%u\n", filter == MipFilter::Box ? "box" : "kaiser",
+                            srgb ? 1 : 0, static_cast<unsigned>(mip1[0]));
+            }
+        }
+    }
+
+    // Worker count must not change the output; odd sizes fall back to RGBA8; damage is rejected.
+    {
+        DecodedImage source;
+        FillBakeBenchImage(size, size, 1.5f, source);
+        TextureBakeOptions bakeOptions;
+        bakeOptions.workerCount = 1;
+        std::vector<uint8_t> serial;
+        std::vector<uint8_t> threaded;
+        std::string error;
+        TextureBakeStats serialStats;
+        TextureBakeStats threadedStats;
+        BakeTexture(source, BakedTextureDimension::Texture2D, bakeOptions, serial, error, &serialStats);
+        bakeOptions.workerCount = 4;
+        BakeTexture(source, BakedTextureDimension::Texture2D, bakeOptions, threaded, error, &threadedStats);
+        if (serial.empty() || serial != threaded) {
+            ++errors;
+        }
+        std::printf("workers: 1=%.1fms 4=%.1fms identical=%d\n", serialStats.mipMs + serialStats.encodeMs,
+                    threadedStats.mipMs + threadedStats.encodeMs, serial == threaded ? 1 : 0);
+
+        DecodedImage odd;
+        FillBakeBenchImage(6, 10, 0.0f, odd);
+        std::vector<uint8_t> file;
+        TextureBakeStats oddStats;
+        SlTexView view;
+        if (!BakeTexture(odd, BakedTextureDimension::Texture2D, TextureBakeOptions(), file, error, &oddStats) ||
+            !SlTexView::Parse(file.data(), file.size(), view, error) || !oddStats.formatFallback ||
+            view.GetFormat() != BakedTextureFormat::RGBA8 || view.header.mipLevels != 4) {
+            ++errors;
+        }
+        if (SlTexView::Parse(serial.data(), serial.size() - 1, view, error) ||
+            BakeTexture(odd, BakedTextureDimension::TextureCube, TextureBakeOptions(), file, error)) {
+            ++errors;
+        }
+    }
+
+    std::printf("bake: size=%u errors=%d\n", size, errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,236 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/AssetCatalog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace ShaderLab {
+namespace Sim {
+
+int RunCatalogBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    int errors = 0;
+    const int fileCount = options.catalogFiles > 0 ? options.catalogFiles : 500;
+
+    const fs::path root = fs::temp_directory_path() / ("shaderlab_catalog_bench_" + std::to_string(options.seed));
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root / "seeds", ec);
+    fs::create_directories(root / "presets", ec);
+    fs::create_directories(root / "tuts", ec);
+    auto writeFile = [](const fs::path& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    };
+    const std::string body = MakeBenchShaderSource(40);
+    for (int i = 0; i < 3; ++i) {
+        writeFile(root / "seeds" / ("seed_" + std::to_string(i) + ".hlsl"), body);
+    }
+    for (int i = 0; i < fileCount; ++i) {
+        writeFile(root / "presets" / ("preset_" + std::to_string(i) + ".hlsl"), body);
+        writeFile(root / "presets" / ("preset_" + std::to_string(i) + ".txt"), "ignored");
+    }
+    for (int t = 0; t < 10; ++t) {
+        const fs::path topic = root / "tuts" / ("topic_" + std::to_string(t));
+        fs::create_directories(topic / "deeper", ec);
+        writeFile(topic / "deeper" / "ignored.md", "# too deep\n");
+        for (int i = 0; i < 5; ++i) {
+            writeFile(topic / ("page_" + std::to_string(i) + ".md"), "# Page\n\nline\nline\n");
+        }
+    }
+
+    AssetCatalog catalog;
+    AssetCollectionDesc presetsDesc;
+    presetsDesc.root = (root / "presets").string();
+    presetsDesc.seedFrom = (root / "seeds").string();
+    presetsDesc.suffixes = { ".hlsl" };
+    presetsDesc.loadContent = true;
+    presetsDesc.createRoot = true;
+    const int presets = catalog.AddCollection(presetsDesc);
+
+    AssetCollectionDesc tutsDesc;
+    tutsDesc.root = (root / "tuts").string();
+    tutsDesc.suffixes = { ".md" };
+    tutsDesc.maxDepth = 1;
+    tutsDesc.parse = [](const AssetEntry& entry) -> std::shared_ptr<const void> {
+        return std::make_shared<size_t>(
+            static_cast<size_t>(std::count(entry.content->begin(), entry.content->end(), '\n')));
+    };
+    const int tuts = catalog.AddCollection(tutsDesc);
+
+    auto start = Clock::now();
+    catalog.Start();
+    const bool scanned = catalog.WaitForScan(presets, 10000) && catalog.WaitForScan(tuts, 10000);
+    const double initialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    auto presetSnapshot = catalog.GetSnapshot(presets);
+    auto tutSnapshot = catalog.GetSnapshot(tuts);
+    const size_t presetCount = presetSnapshot ? presetSnapshot->entries.size() : 0;
+    const size_t tutCount = tutSnapshot ? tutSnapshot->entries.size() : 0;
+    bool parsedOk = tutSnapshot && !tutSnapshot->entries.empty();
+    if (parsedOk) {
+        for (const AssetEntry& entry : tutSnapshot->entries) {
+            parsedOk = parsedOk && entry.Parsed<size_t>() && *entry.Parsed<size_t>() == 4 && !entry.content;
+        }
+    }
+    errors += !scanned || presetCount != static_cast<size_t>(fileCount) + 3 || tutCount != 50 || !parsedOk ? 1 : 0;
+    std::printf("initial scan: %zu presets (3 seeded), %zu tutorials, %.2f ms, native watcher=%d\n", presetCount,
+                tutCount, initialMs, catalog.GetStats().nativeWatcher ? 1 : 0);
+
+    // What the UI used to do on the main thread every 200 ms: list the folder and read every preset.
+    {
+        const int repeats = 5;
+        size_t bytes = 0;
+        start = Clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            for (const auto& entry : fs::directory_iterator(root / "presets", ec)) {
+                if (entry.path().extension() != ".hlsl") {
+                    continue;
+                }
+                std::ifstream in(entry.path(), std::ios::binary);
+                std::stringstream buffer;
+                buffer << in.rdbuf();
+                bytes += buffer.str().size();
+            }
+        }
+        const double rescanMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeats;
+        std::printf("old full rescan: %.2f ms per refresh (%zu bytes read)\n", rescanMs, bytes / repeats);
+    }
+
+    auto waitForGeneration = [&catalog](int collection, uint64_t after, double& outMs) {
+        const auto begin = Clock::now();
+        while (catalog.GetGeneration(collection) <= after) {
+            if (Clock::now() - begin > std::chrono::seconds(10)) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        outMs = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        return true;
+    };
+    auto findEntry = [](const AssetCollectionSnapshot& snapshot, const std::string& relativePath) -> const AssetEntry* {
+        for (const AssetEntry& entry : snapshot.entries) {
+            if (entry.relativePath == relativePath) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    };
+
+    // Edit one preset: only that file is read again, every other entry shares the old content.
+    {
+        const AssetCatalogStats before = catalog.GetStats();
+        const uint64_t generation = catalog.GetGeneration(presets);
+        writeFile(root / "presets" / "preset_7.hlsl", body + "// edited\n");
+        double latencyMs = 0.0;
+        const bool seen = waitForGeneration(presets, generation, latencyMs);
+        const AssetCatalogStats after = catalog.GetStats();
+        auto edited = catalog.GetSnapshot(presets);
+        const AssetEntry* entry = edited ? findEntry(*edited, "preset_7.hlsl") : nullptr;
+        const bool contentOk = entry && entry->content && *entry->content == body + "// edited\n";
+        size_t shared = 0;
+        for (size_t i = 0; edited && i < edited->entries.size() && i < presetSnapshot->entries.size(); ++i) {
+            shared += edited->entries[i].content == presetSnapshot->entries[i].content ? 1 : 0;
+        }
+        const uint64_t reads = after.filesRead - before.filesRead;
+        errors += !seen || !contentOk || reads != 1 || shared != presetCount - 1 ? 1 : 0;
+        std::printf("edit one file: seen after %.2f ms, files read=%llu, entries shared=%zu/%zu, old snapshot intact=%d\n",
+                    latencyMs, static_cast<unsigned long long>(reads), shared, presetCount,
+                    findEntry(*presetSnapshot, "preset_7.hlsl")->content->size() == body.size() ? 1 : 0);
+    }
+
+    // Structural changes: a new topic folder, a deleted page, a renamed preset.
+    {
+        uint64_t generation = catalog.GetGeneration(tuts);
+        fs::create_directories(root / "tuts" / "topic_new", ec);
+        writeFile(root / "tuts" / "topic_new" / "intro.md", "# New\n\nline\nline\n");
+        double latencyMs = 0.0;
+        bool seen = waitForGeneration(tuts, generation, latencyMs);
+        auto snapshot = catalog.GetSnapshot(tuts);
+        if (snapshot && !findEntry(*snapshot, "topic_new/intro.md")) {
+            // The folder and the file can land in separate batches; the file follows shortly.
+            seen = waitForGeneration(tuts, snapshot->generation, latencyMs);
+            snapshot = catalog.GetSnapshot(tuts);
+        }
+        const bool added = seen && snapshot && findEntry(*snapshot, "topic_new/intro.md");
+        errors += added ? 0 : 1;
+        std::printf("new topic folder + page: %s after %.2f ms\n", added ? "seen" : "MISSING", latencyMs);
+
+        // The new folder is watched too, so a second page in it shows up.
+        generation = catalog.GetGeneration(tuts);
+        writeFile(root / "tuts" / "topic_new" / "next.md", "# Next\n");
+        seen = waitForGeneration(tuts, generation, latencyMs);
+        snapshot = catalog.GetSnapshot(tuts);
+        const bool nested = seen && snapshot && findEntry(*snapshot, "topic_new/next.md");
+        errors += nested ? 0 : 1;
+        std::printf("page in the new folder: %s after %.2f ms\n", nested ? "seen" : "MISSING", latencyMs);
+
+        generation = catalog.GetGeneration(tuts);
+        fs::remove(root / "tuts" / "topic_3" / "page_2.md", ec);
+        seen = waitForGeneration(tuts, generation, latencyMs);
+        snapshot = catalog.GetSnapshot(tuts);
+        const bool removed = seen && snapshot && !findEntry(*snapshot, "topic_3/page_2.md") && snapshot->entries.size() == 51;
+        errors += removed ? 0 : 1;
+        std::printf("delete page: %s after %.2f ms\n", removed ? "gone" : "STILL LISTED", latencyMs);
+
+        generation = catalog.GetGeneration(presets);
+        fs::rename(root / "presets" / "preset_3.hlsl", root / "presets" / "renamed.hlsl", ec);
+        seen = waitForGeneration(presets, generation, latencyMs);
+        snapshot = catalog.GetSnapshot(presets);
+        const bool renamed = seen && snapshot && findEntry(*snapshot, "renamed.hlsl") &&
+                             !findEntry(*snapshot, "preset_3.hlsl") && snapshot->entries.size() == presetCount;
+        errors += renamed ? 0 : 1;
+        std::printf("rename preset: %s after %.2f ms\n", renamed ? "ok" : "WRONG", latencyMs);
+    }
+
+    // Re-rooting, as on a workspace change: the missing folder is created and seeded.
+    {
+        start = Clock::now();
+        catalog.SetCollectionRoot(presets, (root / "other_workspace").string(), (root / "seeds").string());
+        const bool rerooted = catalog.WaitForScan(presets, 10000);
+        const double rerootMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        auto snapshot = catalog.GetSnapshot(presets);
+        const bool ok = rerooted && snapshot && snapshot->rootExists && snapshot->entries.size() == 3;
+        errors += ok ? 0 : 1;
+        std::printf("new root: %zu seeded presets after %.2f ms\n", snapshot ? snapshot->entries.size() : 0, rerootMs);
+    }
+
+    // The UI side: one locked pointer copy per frame, and no scans while nothing changes.
+    {
+        const int calls = 1000000;
+        size_t total = 0;
+        start = Clock::now();
+        for (int i = 0; i < calls; ++i) {
+            total += catalog.GetSnapshot(tuts)->entries.size();
+        }
+        const double callNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+        const uint64_t scansBefore = catalog.GetStats().scans;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        const AssetCatalogStats stats = catalog.GetStats();
+        const uint64_t idleScans = stats.scans - scansBefore;
+        errors += total != static_cast<size_t>(calls) * 51 || (stats.nativeWatcher && idleScans != 0) ? 1 : 0;
+        std::printf("GetSnapshot: %.1f ns per call; idle scans in 300 ms=%llu; totals: scans=%llu files read=%llu "
+                    "notification batches=%llu\n",
+                    callNs, static_cast<unsigned long long>(idleScans), static_cast<unsigned long long>(stats.scans),
+                    static_cast<unsigned long long>(stats.filesRead),
+                    static_cast<unsigned long long>(stats.notifications));
+    }
+
+    catalog.Stop();
+    fs::remove_all(root, ec);
+    std::printf("catalog: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
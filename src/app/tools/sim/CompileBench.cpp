@@ -0,0 +1,179 @@
+#include "SimBenches.h"
+#include "SimMockCompiler.h"
+
+#include "ShaderLab/Core/AsyncCompilationService.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+struct CompileBenchTarget {
+    ShaderLab::CompileTargetKey key;
+    std::string lastSubmitted;
+    std::string lastDelivered;
+    uint64_t lastGeneration = 0;
+    bool canceled = false;
+    int delivered = 0;
+};
+
+// Drives AsyncCompilationService like the editor: submits edits between frames, collects once per
+// frame, and checks that each target ends on its last submitted text, generations only grow and
+// canceled targets never deliver.
+int RunCompileScenario(const char* name,
+                       unsigned workers,
+                       double compileMs,
+                       int edits,
+                       int targetCount,
+                       uint32_t seed,
+                       ShaderLab::AsyncCompileStats& outStats) {
+    using namespace ShaderLab;
+    AsyncCompilationService service([compileMs]() { return std::make_unique<MockCompilationService>(compileMs); }, workers);
+
+    std::vector<CompileBenchTarget> targets(static_cast<size_t>(targetCount));
+    for (int i = 0; i < targetCount; ++i) {
+        CompileTargetKey& key = targets[static_cast<size_t>(i)].key;
+        key.kind = static_cast<CompileTargetKind>(i % 3);
+        key.sceneIndex = i / 3;
+        key.effectIndex = key.kind == CompileTargetKind::Scene ? -1 : i % 2;
+    }
+    int errors = 0;
+    double maxSubmitUs = 0.0;
+    std::vector<AsyncCompileResult> results;
+    auto collect = [&]() {
+        results.clear();
+        service.Collect(results);
+        for (const AsyncCompileResult& result : results) {
+            CompileBenchTarget* target = nullptr;
+            for (CompileBenchTarget& candidate : targets) {
+                if (candidate.key == result.key) {
+                    target = &candidate;
+                }
+            }
+            const std::string bytes(result.result.bytecode.begin(), result.result.bytecode.end());
+            if (!target || target->canceled || result.generation <= target->lastGeneration ||
+                !result.result.success || bytes != result.source) {
+                ++errors;
+                continue;
+            }
+            target->lastGeneration = result.generation;
+            target->lastDelivered = result.source;
+            ++target->delivered;
+        }
+    };
+
+    uint32_t state = seed ? seed : 1u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    const int cancelAt = targetCount > 1 ? edits / 2 : -1;
+    for (int edit = 0; edit < edits; ++edit) {
+        CompileBenchTarget& target = targets[next() % static_cast<uint32_t>(targetCount)];
+        if (target.canceled) {
+            continue;
+        }
+        AsyncCompileRequest request;
+        request.key = target.key;
+        request.source = "edit " + std::to_string(edit) + " // cost=" + std::to_string(compileMs * (0.5 + (next() % 100) / 100.0));
+        target.lastSubmitted = request.source;
+        const auto start = std::chrono::steady_clock::now();
+        service.Submit(std::move(request));
+        maxSubmitUs = (std::max)(maxSubmitUs, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+        if (edit == cancelAt) {
+            CompileBenchTarget& canceled = targets.back();
+            service.Cancel(canceled.key);
+            canceled.canceled = true;
+        }
+        // A frame passes every few edits, like typing with Ctrl+Enter held.
+        if (next() % 3 == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1 + next() % 4));
+            collect();
+        }
+    }
+    while (service.GetPendingCount() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        collect();
+    }
+    service.WaitIdle();
+    collect();
+
+    int finished = 0;
+    for (const CompileBenchTarget& target : targets) {
+        if (target.canceled) {
+            continue;
+        }
+        if (target.lastDelivered != target.lastSubmitted) {
+            ++errors;
+        }
+        finished += target.lastSubmitted.empty() ? 0 : 1;
+    }
+    outStats = service.GetStats();
+    if (outStats.submitted != outStats.compiled + outStats.coalesced + outStats.canceled ||
+        outStats.compiled != outStats.delivered + outStats.discarded) {
+        ++errors;
+    }
+    if (workers > 0 && maxSubmitUs > compileMs * 500.0) {
+        ++errors; // Submit must not wait for a compile
+    }
+    std::printf("%s: workers=%u targets=%d submitted=%llu compiled=%llu coalesced=%llu canceled=%llu discarded=%llu delivered=%llu max_submit_us=%.1f errors=%d\n",
+                name, service.GetWorkerCount(), finished,
+                static_cast<unsigned long long>(outStats.submitted),
+                static_cast<unsigned long long>(outStats.compiled),
+                static_cast<unsigned long long>(outStats.coalesced),
+                static_cast<unsigned long long>(outStats.canceled),
+                static_cast<unsigned long long>(outStats.discarded),
+                static_cast<unsigned long long>(outStats.delivered),
+                maxSubmitUs, errors);
+    return errors;
+}
+
+} // namespace
+
+int RunCompileBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    const unsigned workers = options.compileBenchWorkers > 0
+        ? static_cast<unsigned>(options.compileBenchWorkers)
+        : AsyncCompilationService::DefaultWorkerCount();
+    AsyncCompileStats burst;
+    AsyncCompileStats mixed;
+    AsyncCompileStats inlineStats;
+    int errors = RunCompileScenario("burst", workers, options.compileMs, 40, 1, options.seed, burst);
+    errors += RunCompileScenario("mixed", workers, options.compileMs, 120, 7, options.seed, mixed);
+    errors += RunCompileScenario("inline", 0, options.compileMs * 0.1, 40, 4, options.seed, inlineStats);
+    // Rapid edits of one target must coalesce instead of compiling every keystroke.
+    if (burst.compiled >= burst.submitted) {
+        ++errors;
+    }
+
+    // Diagnostics come back untouched and a failed compile is still delivered.
+    AsyncCompilationService service([&]() { return std::make_unique<MockCompilationService>(0.0); }, workers);
+    AsyncCompileRequest request;
+    request.source = "float4 main() {\n#error\n}";
+    service.Submit(std::move(request));
+    service.WaitIdle();
+    std::vector<AsyncCompileResult> results;
+    service.Collect(results);
+    if (results.size() != 1 || results[0].result.success || results[0].result.diagnostics.size() != 1 ||
+        results[0].result.diagnostics[0].line != 2) {
+        ++errors;
+    }
+    std::printf("errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,153 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DescriptorRingAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Stand-in for DescriptorRingService: counts view writes and checks that evicted slots were
+// live and that no table overlaps slots still owned by an in-flight frame.
+class FakeDescriptorDevice final : public ShaderLab::IDescriptorCacheBackend {
+public:
+    explicit FakeDescriptorDevice(uint32_t cacheCapacity) : m_live(cacheCapacity, false) {}
+
+    void WriteView(uint32_t slot) {
+        if (slot >= m_live.size() || m_live[slot]) {
+            ++m_errors;
+            return;
+        }
+        m_live[slot] = true;
+    }
+
+    void ReleaseCachedView(uint32_t slot) override {
+        if (slot >= m_live.size() || !m_live[slot]) {
+            ++m_errors;
+            return;
+        }
+        m_live[slot] = false;
+    }
+
+    int GetErrorCount() const { return m_errors; }
+
+private:
+    std::vector<bool> m_live;
+    int m_errors = 0;
+};
+
+} // namespace
+
+// Issues the player's per-frame SRV tables (scene, one post-FX pass with 4 history slots, and
+// the transition) through DescriptorRingAllocator and compares the descriptors written against
+// rebuilding every table from scratch each frame.
+int RunDescriptorBench(const ShaderLab::DemoTrack& track,
+                       const ShaderLab::CompactTrack::Metadata& meta,
+                       const SimOptions& options,
+                       const std::vector<double>& traceMs) {
+    constexpr uint32_t kTableSize = 8;
+    constexpr uint32_t kHistoryCount = 4;
+    constexpr uint32_t kCacheCapacity = 1024;
+    constexpr uint32_t kRingCapacity = 8192;
+    constexpr uint64_t kNullView = 0;
+    constexpr uint64_t kDummyView = 1;
+
+    const int sceneCount = ResolveSceneCount(track, meta);
+    FakeDescriptorDevice device(kCacheCapacity);
+    ShaderLab::DescriptorRingAllocator allocator(device, kCacheCapacity, kRingCapacity);
+
+    // Frame that last filled each ring slot, to check that a table never reuses in-flight slots.
+    std::vector<int64_t> slotFrame(kRingCapacity, -1);
+    std::vector<uint32_t> historyIndex(static_cast<size_t>((std::max)(0, sceneCount)), 0u);
+    uint64_t rebuildWrites = 0;
+    int errors = 0;
+    int64_t currentFrame = 0;
+
+    auto table = [&](const uint64_t* resources) {
+        for (uint32_t i = 0; i < kTableSize; ++i) {
+            ShaderLab::DescriptorViewKey key;
+            key.resource = resources[i];
+            key.view = 0x5356u; // One view description (RGBA8 Texture2D) for every binding
+            bool needsWrite = false;
+            const uint32_t slot = allocator.AcquireView(key, needsWrite);
+            if (slot == ShaderLab::DescriptorRingAllocator::kInvalidSlot) {
+                ++errors;
+                return;
+            }
+            if (needsWrite) {
+                device.WriteView(slot);
+            }
+        }
+        const uint32_t start = allocator.AllocateTable(kTableSize);
+        if (start == ShaderLab::DescriptorRingAllocator::kInvalidSlot) {
+            ++errors;
+            return;
+        }
+        for (uint32_t i = start; i < start + kTableSize; ++i) {
+            // The player waits for the GPU every frame, so only this frame's slots are in flight.
+            if (slotFrame[i] == currentFrame) {
+                ++errors;
+            }
+            slotFrame[i] = currentFrame;
+        }
+        rebuildWrites += kTableSize;
+    };
+
+    const int frames = ReplayVisibleScenes(track, sceneCount, options, traceMs, [&](int frame, const int* visible) {
+        currentFrame = frame;
+        allocator.BeginFrame(static_cast<uint64_t>(frame), frame - 1);
+        for (int i = 0; i < 2; ++i) {
+            const int sceneIndex = visible[i];
+            if (sceneIndex < 0) {
+                continue;
+            }
+            const uint64_t sceneTexture = 100u + static_cast<uint64_t>(sceneIndex);
+            const uint64_t sceneTable[kTableSize] = { kNullView, kNullView, kNullView, kNullView,
+                                                      kNullView, kNullView, kNullView, kNullView };
+            table(sceneTable);
+
+            uint32_t& newest = historyIndex[static_cast<size_t>(sceneIndex)];
+            uint64_t fxTable[kTableSize] = { sceneTexture };
+            for (uint32_t h = 1; h < kTableSize; ++h) {
+                fxTable[h] = h <= kHistoryCount
+                    ? 1000u + static_cast<uint64_t>(sceneIndex) * kHistoryCount + (newest + kHistoryCount - (h - 1)) % kHistoryCount
+                    : kDummyView;
+            }
+            table(fxTable);
+            newest = (newest + 1) % kHistoryCount;
+        }
+        if (visible[1] >= 0) {
+            const uint64_t transitionTable[kTableSize] = { 100u + static_cast<uint64_t>(visible[0] < 0 ? 0 : visible[0]),
+                                                           100u + static_cast<uint64_t>(visible[1]),
+                                                           kDummyView, kDummyView, kDummyView, kDummyView, kDummyView, kDummyView };
+            table(transitionTable);
+        }
+        allocator.EndFrame();
+    });
+
+    const ShaderLab::DescriptorRingStats stats = allocator.GetStats();
+    allocator.Clear();
+    errors += device.GetErrorCount();
+    std::printf("frames=%d tables=%llu views_written=%llu cache_hits=%llu descriptors_copied=%llu "
+                "rebuild_writes=%llu ring_peak=%u cached_views=%zu errors=%d\n",
+                frames,
+                static_cast<unsigned long long>(stats.total.tables),
+                static_cast<unsigned long long>(stats.total.viewsWritten),
+                static_cast<unsigned long long>(stats.total.cacheHits),
+                static_cast<unsigned long long>(stats.total.descriptorsCopied),
+                static_cast<unsigned long long>(rebuildWrites),
+                stats.ringPeakUsed,
+                stats.cachedViews,
+                errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
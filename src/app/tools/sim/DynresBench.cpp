@@ -0,0 +1,180 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+struct DynresRunResult {
+    int frames = 0;
+    int overBudget = 0;
+    double scaleSum = 0.0;
+    float minScale = 1.0f;
+    int errors = 0;
+};
+
+// Feeds one frame's full-resolution GPU cost through the controller with latency frames of
+// timestamp delay. Cost scales with the pixel count on top of a fixed, unscaled part.
+class DynresModel {
+public:
+    DynresModel(const ShaderLab::DynamicResolutionSettings& settings, bool enabled, uint32_t width, uint32_t height, uint32_t seed)
+        : m_controller(settings), m_enabled(enabled), m_width(width), m_height(height), m_state(seed ? seed : 1u) {}
+
+    void Frame(double fullResMs, double fixedMs, DynresRunResult& result) {
+        constexpr size_t kLatency = 2;
+        const float scale = m_controller.GetScale();
+        uint32_t width = 0;
+        uint32_t height = 0;
+        m_controller.ComputeSize(m_width, m_height, width, height);
+        const double area = static_cast<double>(width) * height / (static_cast<double>(m_width) * m_height);
+        m_state = m_state * 1664525u + 1013904223u;
+        const double noise = 1.0 + (static_cast<double>(m_state >> 8) / static_cast<double>(1u << 24) * 2.0 - 1.0) * 0.05;
+        const double ms = (fixedMs + fullResMs * area) * noise;
+
+        ++result.frames;
+        result.scaleSum += scale;
+        result.minScale = (std::min)(result.minScale, scale);
+        if (ms > m_controller.GetSettings().targetMs) {
+            ++result.overBudget;
+        }
+        const double aspect = static_cast<double>(m_width) / m_height;
+        const bool aligned = width == m_width || width % m_controller.GetSettings().alignment == 0;
+        if (scale < m_controller.GetSettings().minScale || scale > m_controller.GetSettings().maxScale || !aligned ||
+            std::fabs(static_cast<double>(width) / height - aspect) > aspect * 0.01 || width > m_width || height > m_height) {
+            ++result.errors;
+        }
+
+        m_pending.push_back(ms);
+        if (m_pending.size() > kLatency) {
+            if (m_enabled) {
+                m_controller.Update(m_pending.front());
+            }
+            m_pending.erase(m_pending.begin());
+        }
+    }
+
+    const ShaderLab::DynamicResolutionController& GetController() const { return m_controller; }
+
+private:
+    ShaderLab::DynamicResolutionController m_controller;
+    bool m_enabled;
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_state;
+    std::vector<double> m_pending;
+};
+
+} // namespace
+
+// Compares fixed and dynamic resolution on the track with a per-scene GPU cost of gpuMs times a
+// fixed 1x-4x weight, then checks the step response of a light-heavy-light load for pumping.
+int RunDynresBench(const ShaderLab::DemoTrack& track,
+                   const ShaderLab::CompactTrack::Metadata& meta,
+                   const SimOptions& options,
+                   const std::vector<double>& traceMs) {
+    using namespace ShaderLab;
+    constexpr double kFixedMs = 0.5;
+    const int sceneCount = ResolveSceneCount(track, meta);
+    DynamicResolutionSettings settings;
+    settings.targetMs = options.targetMs;
+
+    auto sceneMs = [&](int scene) {
+        const uint32_t hash = static_cast<uint32_t>(scene + 1) * 2654435761u;
+        return options.gpuMs * (1.0 + 3.0 * static_cast<double>((hash >> 8) % 101u) / 100.0);
+    };
+    DynresRunResult fixed;
+    DynresRunResult dynamic;
+    DynresModel fixedModel(settings, false, options.targetWidth, options.targetHeight, options.seed);
+    DynresModel dynamicModel(settings, true, options.targetWidth, options.targetHeight, options.seed);
+    ReplayVisibleScenes(track, sceneCount, options, traceMs, [&](int, const int* visible) {
+        double ms = 0.0;
+        for (int i = 0; i < 2; ++i) {
+            if (visible[i] >= 0 && !(i == 1 && visible[1] == visible[0])) {
+                ms += sceneMs(visible[i]);
+            }
+        }
+        fixedModel.Frame(ms, kFixedMs, fixed);
+        dynamicModel.Frame(ms, kFixedMs, dynamic);
+    });
+
+    // Step response: light, then well over budget, then light again.
+    constexpr int kPhaseFrames = 400;
+    const double phaseMs[3] = { settings.targetMs * 0.4, settings.targetMs * 1.8, settings.targetMs * 0.4 };
+    DynresModel stepModel(settings, true, options.targetWidth, options.targetHeight, options.seed);
+    DynresRunResult step;
+    int settleErrors = 0;
+    for (int phase = 0; phase < 3; ++phase) {
+        DynresRunResult tail;
+        uint64_t changesBeforeTail = 0;
+        for (int frame = 0; frame < kPhaseFrames; ++frame) {
+            if (frame == kPhaseFrames / 2) {
+                const DynamicResolutionStats& stats = stepModel.GetController().GetStats();
+                changesBeforeTail = stats.increases + stats.decreases;
+            }
+            stepModel.Frame(phaseMs[phase], kFixedMs, frame < kPhaseFrames / 2 ? step : tail);
+        }
+        step.errors += tail.errors;
+        const DynamicResolutionStats& stats = stepModel.GetController().GetStats();
+        const bool settled = stats.increases + stats.decreases == changesBeforeTail;
+        const bool withinBudget = tail.overBudget <= tail.frames / 20;
+        const bool full = phase == 1 || stepModel.GetController().GetScale() >= settings.maxScale;
+        std::printf("step phase %d: full_res=%.1f ms scale=%.2f over_budget_tail=%d settled=%d\n",
+                    phase, phaseMs[phase], stepModel.GetController().GetScale(), tail.overBudget, settled ? 1 : 0);
+        if (!settled || !withinBudget || !full) {
+            ++settleErrors;
+        }
+    }
+    const DynamicResolutionStats& stepStats = stepModel.GetController().GetStats();
+
+    // Load hovering around the budget. Each applied change reallocates the player's targets, so
+    // the controller must not chase every swing back up.
+    constexpr int kHoverFrames = 1200;
+    DynresModel hoverModel(settings, true, options.targetWidth, options.targetHeight, options.seed);
+    DynresRunResult hover;
+    for (int frame = 0; frame < kHoverFrames; ++frame) {
+        hoverModel.Frame(settings.targetMs * ((frame / 60) % 2 == 0 ? 0.8 : 1.25), kFixedMs, hover);
+    }
+    const DynamicResolutionStats& hoverStats = hoverModel.GetController().GetStats();
+
+    int errors = fixed.errors + dynamic.errors + step.errors + hover.errors + settleErrors;
+    // A grow after a drop waits growHoldFrames, which bounds the up/down cycles.
+    if (hoverStats.reversals > 2 * (kHoverFrames / (std::max)(settings.growHoldFrames, 1u)) + 1) {
+        ++errors;
+    }
+    if (fixed.overBudget > 0 && dynamic.overBudget >= fixed.overBudget) {
+        ++errors;
+    }
+    if (stepStats.reversals > 2) {
+        ++errors;
+    }
+    const DynamicResolutionStats& stats = dynamicModel.GetController().GetStats();
+    std::printf("frames=%d target=%.1f ms size=%ux%u\n", fixed.frames, settings.targetMs, options.targetWidth, options.targetHeight);
+    std::printf("fixed:   over_budget=%d\n", fixed.overBudget);
+    std::printf("dynamic: over_budget=%d avg_scale=%.2f min_scale=%.2f increases=%llu decreases=%llu reversals=%llu\n",
+                dynamic.overBudget, dynamic.frames > 0 ? dynamic.scaleSum / dynamic.frames : 1.0, dynamic.minScale,
+                static_cast<unsigned long long>(stats.increases),
+                static_cast<unsigned long long>(stats.decreases),
+                static_cast<unsigned long long>(stats.reversals));
+    std::printf("hover: increases=%llu decreases=%llu reversals=%llu\n",
+                static_cast<unsigned long long>(hoverStats.increases),
+                static_cast<unsigned long long>(hoverStats.decreases),
+                static_cast<unsigned long long>(hoverStats.reversals));
+    std::printf("step: increases=%llu decreases=%llu reversals=%llu errors=%d\n",
+                static_cast<unsigned long long>(stepStats.increases),
+                static_cast<unsigned long long>(stepStats.decreases),
+                static_cast<unsigned long long>(stepStats.reversals), errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
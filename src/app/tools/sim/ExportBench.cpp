@@ -0,0 +1,329 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/VideoExportPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Reference decoder for the QOI frames the export writes (3 or 4 channels, all ops).
+bool DecodeQoi(const std::vector<uint8_t>& data, uint32_t& outWidth, uint32_t& outHeight, std::vector<uint8_t>& outRgb) {
+    if (data.size() < 22 || data[0] != 'q' || data[1] != 'o' || data[2] != 'i' || data[3] != 'f') {
+        return false;
+    }
+    auto read32 = [&data](size_t at) {
+        return (uint32_t(data[at]) << 24) | (uint32_t(data[at + 1]) << 16) | (uint32_t(data[at + 2]) << 8) | uint32_t(data[at + 3]);
+    };
+    outWidth = read32(4);
+    outHeight = read32(8);
+    const size_t pixelCount = static_cast<size_t>(outWidth) * outHeight;
+    outRgb.assign(pixelCount * 3u, 0);
+    uint8_t index[64][4] = {};
+    uint8_t px[4] = { 0, 0, 0, 255 };
+    size_t at = 14;
+    const size_t end = data.size() - 8;
+    int run = 0;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (run > 0) {
+            --run;
+        } else if (at < end) {
+            const uint8_t op = data[at++];
+            if (op == 0xFE) {
+                px[0] = data[at++];
+                px[1] = data[at++];
+                px[2] = data[at++];
+            } else if (op == 0xFF) {
+                px[0] = data[at++];
+                px[1] = data[at++];
+                px[2] = data[at++];
+                px[3] = data[at++];
+            } else if ((op & 0xC0) == 0x00) {
+                std::memcpy(px, index[op], 4);
+            } else if ((op & 0xC0) == 0x40) {
+                px[0] = static_cast<uint8_t>(px[0] + ((op >> 4) & 3) - 2);
+                px[1] = static_cast<uint8_t>(px[1] + ((op >> 2) & 3) - 2);
+                px[2] = static_cast<uint8_t>(px[2] + (op & 3) - 2);
+            } else if ((op & 0xC0) == 0x80) {
+                const int dg = (op & 0x3F) - 32;
+                const uint8_t second = data[at++];
+                px[0] = static_cast<uint8_t>(px[0] + dg - 8 + (second >> 4));
+                px[1] = static_cast<uint8_t>(px[1] + dg);
+                px[2] = static_cast<uint8_t>(px[2] + dg - 8 + (second & 0x0F));
+            } else {
+                run = op & 0x3F;
+            }
+            std::memcpy(index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64], px, 4);
+        } else {
+            return false;
+        }
+        std::memcpy(&outRgb[i * 3u], px, 3);
+    }
+    return true;
+}
+
+// Stand-in for a rendered frame: gradients, flat bands and noise, different every frame.
+void FillExportBenchFrame(uint8_t* rgba, uint32_t rowPitch, uint32_t width, uint32_t height, uint64_t frame) {
+    uint32_t state = static_cast<uint32_t>(frame) * 2654435761u + 1u;
+    for (uint32_t y = 0; y < height; ++y) {
+        uint8_t* row = rgba + static_cast<size_t>(y) * rowPitch;
+        const bool flat = ((y + frame) / 64) % 3 == 0;
+        for (uint32_t x = 0; x < width; ++x) {
+            state = state * 1664525u + 1013904223u;
+            const uint8_t noise = static_cast<uint8_t>(state >> 29);
+            row[x * 4 + 0] = flat ? 40 : static_cast<uint8_t>(x + frame * 3 + noise);
+            row[x * 4 + 1] = flat ? 90 : static_cast<uint8_t>(y + noise);
+            row[x * 4 + 2] = flat ? 160 : static_cast<uint8_t>((x ^ y) + frame);
+            row[x * 4 + 3] = 255;
+        }
+    }
+}
+
+void ExpectedExportRgb(const uint8_t* rgba, uint32_t rowPitch, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    out.resize(static_cast<size_t>(width) * height * 3u);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            for (uint32_t c = 0; c < 3; ++c) {
+                out[(static_cast<size_t>(y) * width + x) * 3u + c] = rgba[static_cast<size_t>(y) * rowPitch + x * 4u + c];
+            }
+        }
+    }
+}
+
+bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    out.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+} // namespace
+
+int RunExportBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    using Clock = std::chrono::steady_clock;
+    namespace fs = std::filesystem;
+    const uint32_t width = options.targetWidth;
+    const uint32_t height = options.targetHeight;
+    const uint64_t frameCount = options.exportFrames > 0 ? static_cast<uint64_t>(options.exportFrames) : 24u;
+    const uint32_t rowPitch = (width * 4u + 255u) & ~255u; // D3D12 readback rows are 256-byte aligned
+    const size_t frameBytes = static_cast<size_t>(rowPitch) * height;
+    const size_t rgbBytes = static_cast<size_t>(width) * height * 3u;
+    const size_t ringSize = 3;
+    int errors = 0;
+
+    // Conversion must match the plain loop for every tail length and padded pitch.
+    {
+        std::vector<uint8_t> src;
+        std::vector<uint8_t> fast;
+        std::vector<uint8_t> expected;
+        const uint32_t widths[] = { 1, 5, 15, 16, 17, 31, 33, 64, 250 };
+        for (uint32_t w : widths) {
+            const uint32_t pitch = (w * 4u + 255u) & ~255u;
+            src.resize(static_cast<size_t>(pitch) * 7u);
+            for (size_t i = 0; i < src.size(); ++i) {
+                src[i] = static_cast<uint8_t>(i * 131u + w);
+            }
+            fast.assign(static_cast<size_t>(w) * 7u * 3u + 16u, 0xCD);
+            ConvertRgbaToRgb(src.data(), pitch, w, 7, fast.data());
+            ExpectedExportRgb(src.data(), pitch, w, 7, expected);
+            if (!std::equal(expected.begin(), expected.end(), fast.begin()) || fast[expected.size()] != 0xCD) {
+                ++errors;
+            }
+        }
+    }
+
+    std::vector<uint8_t> frame(frameBytes);
+    FillExportBenchFrame(frame.data(), rowPitch, width, height, 0);
+    std::vector<uint8_t> rgb(rgbBytes);
+    std::vector<uint8_t> expected;
+    ExpectedExportRgb(frame.data(), rowPitch, width, height, expected);
+
+    const int convertIterations = 10;
+    auto start = Clock::now();
+    for (int i = 0; i < convertIterations; ++i) {
+        ExpectedExportRgb(frame.data(), rowPitch, width, height, rgb);
+    }
+    const double scalarMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / convertIterations;
+    start = Clock::now();
+    for (int i = 0; i < convertIterations; ++i) {
+        ConvertRgbaToRgb(frame.data(), rowPitch, width, height, rgb.data());
+    }
+    const double convertMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / convertIterations;
+
+    // QOI must round-trip exactly.
+    std::vector<uint8_t> qoi;
+    EncodeQoi(expected.data(), width, height, qoi);
+    std::vector<uint8_t> decoded;
+    uint32_t decodedWidth = 0;
+    uint32_t decodedHeight = 0;
+    if (!DecodeQoi(qoi, decodedWidth, decodedHeight, decoded) || decodedWidth != width || decodedHeight != height ||
+        decoded != expected) {
+        ++errors;
+    }
+
+    const fs::path root = fs::temp_directory_path() / ("shaderlab_export_bench_" + std::to_string(options.seed));
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+
+    // Old path: one readback, per-byte PPM writes on the render thread, encode afterwards.
+    const double renderMs = options.gpuMs;
+    uint64_t ppmBytes = 0;
+    start = Clock::now();
+    for (uint64_t f = 0; f < frameCount; ++f) {
+        FillExportBenchFrame(frame.data(), rowPitch, width, height, f);
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(renderMs));
+        char fileName[64] = {};
+        std::snprintf(fileName, sizeof(fileName), "frame_%05llu.ppm", static_cast<unsigned long long>(f));
+        std::ofstream out(root / fileName, std::ios::binary | std::ios::trunc);
+        out << "P6\n" << width << " " << height << "\n255\n";
+        for (uint32_t y = 0; y < height; ++y) {
+            const uint8_t* row = frame.data() + static_cast<size_t>(y) * rowPitch;
+            for (uint32_t x = 0; x < width; ++x) {
+                out.put(static_cast<char>(row[x * 4 + 0]));
+                out.put(static_cast<char>(row[x * 4 + 1]));
+                out.put(static_cast<char>(row[x * 4 + 2]));
+            }
+        }
+        ppmBytes += static_cast<uint64_t>(out.tellp());
+    }
+    const double serialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // New path: ring of readback slots, conversion and writing on the export worker.
+    std::string exportError;
+    auto runPipeline = [&](std::unique_ptr<IVideoFrameSink> sink, double& outMs, uint64_t& outStalls, VideoExportStats& outStats) {
+        std::vector<std::vector<uint8_t>> ring(ringSize, std::vector<uint8_t>(frameBytes));
+        VideoExportPipeline pipeline(std::move(sink), ringSize);
+        VideoFrameFormat format;
+        format.width = width;
+        format.height = height;
+        format.fps = 60;
+        const auto begin = Clock::now();
+        if (!pipeline.Start(format, exportError)) {
+            return false;
+        }
+        outStalls = 0;
+        for (uint64_t f = 0; f < frameCount; ++f) {
+            while (!pipeline.CanSubmit() && !pipeline.HasFailed()) {
+                ++outStalls;
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            uint8_t* slot = ring[f % ringSize].data();
+            FillExportBenchFrame(slot, rowPitch, width, height, f);
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(renderMs));
+            if (!pipeline.Submit(slot, rowPitch)) {
+                break;
+            }
+        }
+        const bool ok = pipeline.Finish(exportError);
+        outMs = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        outStats = pipeline.GetStats();
+        return ok && outStats.framesWritten == frameCount;
+    };
+
+    const fs::path qoiDir = root / "qoi";
+    double pipelineMs = 0.0;
+    uint64_t stalls = 0;
+    VideoExportStats stats;
+    if (!runPipeline(std::make_unique<QoiSequenceSink>(qoiDir.string()), pipelineMs, stalls, stats)) {
+        std::fprintf(stderr, "QOI export failed: %s\n", exportError.c_str());
+        ++errors;
+    }
+    uint64_t qoiTotal = 0;
+    for (uint64_t f : { uint64_t(0), frameCount / 2, frameCount - 1 }) {
+        char fileName[64] = {};
+        std::snprintf(fileName, sizeof(fileName), "frame_%05llu.qoi", static_cast<unsigned long long>(f));
+        std::vector<uint8_t> file;
+        FillExportBenchFrame(frame.data(), rowPitch, width, height, f);
+        ExpectedExportRgb(frame.data(), rowPitch, width, height, expected);
+        if (!ReadWholeFile((qoiDir / fileName).string(), file) || !DecodeQoi(file, decodedWidth, decodedHeight, decoded) ||
+            decoded != expected) {
+            ++errors;
+        }
+    }
+    for (const auto& entry : fs::directory_iterator(qoiDir, ec)) {
+        qoiTotal += entry.file_size();
+    }
+
+    // Encoder pipe: ffmpeg when installed, otherwise a shell copy of stdin that proves the
+    // frames arrive in order and complete.
+    const bool haveFfmpeg = EncoderPipeSink::ProbeEncoder("ffmpeg");
+    VideoFrameFormat pipeFormat;
+    pipeFormat.width = width;
+    pipeFormat.height = height;
+    pipeFormat.fps = 60;
+    const fs::path rawPath = root / "stream.rgb";
+    const std::string command = haveFfmpeg
+        ? EncoderPipeSink::FfmpegCommand("ffmpeg", pipeFormat, (root / "export.mp4").string())
+        : "cat > \"" + rawPath.string() + "\"";
+    double pipeMs = 0.0;
+    uint64_t pipeStalls = 0;
+    VideoExportStats pipeStats;
+    if (!runPipeline(std::make_unique<EncoderPipeSink>(command), pipeMs, pipeStalls, pipeStats)) {
+        std::fprintf(stderr, "Encoder export failed: %s\n", exportError.c_str());
+        ++errors;
+    }
+    uint64_t pipeOutputBytes = 0;
+    if (haveFfmpeg) {
+        pipeOutputBytes = fs::file_size(root / "export.mp4", ec);
+        if (ec || pipeOutputBytes == 0) {
+            ++errors;
+        }
+    } else {
+        std::vector<uint8_t> stream;
+        if (!ReadWholeFile(rawPath.string(), stream) || stream.size() != rgbBytes * frameCount) {
+            ++errors;
+        } else {
+            FillExportBenchFrame(frame.data(), rowPitch, width, height, frameCount - 1);
+            ExpectedExportRgb(frame.data(), rowPitch, width, height, expected);
+            if (!std::equal(expected.begin(), expected.end(), stream.end() - static_cast<std::ptrdiff_t>(rgbBytes))) {
+                ++errors;
+            }
+        }
+        pipeOutputBytes = stream.size();
+    }
+
+    // A sink that dies mid-stream has to fail the export, not hang it.
+    double deadMs = 0.0;
+    uint64_t deadStalls = 0;
+    VideoExportStats deadStats;
+    if (runPipeline(std::make_unique<EncoderPipeSink>("exit 3"), deadMs, deadStalls, deadStats)) {
+        ++errors;
+    }
+
+    // Not asserted: on one core, or unoptimized, the worker competes with the render loop.
+    const double renderBoundMs = renderMs * static_cast<double>(frameCount);
+    fs::remove_all(root, ec);
+
+    std::printf("export: %ux%u frames=%llu ring=%zu render_ms=%.1f\n", width, height,
+                static_cast<unsigned long long>(frameCount), ringSize, renderMs);
+    std::printf("convert: scalar_ms=%.2f simd_ms=%.2f speedup=%.1fx\n", scalarMs, convertMs,
+                scalarMs / (std::max)(convertMs, 1e-6));
+    std::printf("serial_ppm: total_ms=%.1f disk_bytes=%llu\n", serialMs, static_cast<unsigned long long>(ppmBytes));
+    std::printf("pipelined_qoi: total_ms=%.1f render_bound_ms=%.1f stalls=%llu worker_convert_ms=%.1f worker_write_ms=%.1f max_queued=%zu disk_bytes=%llu\n",
+                pipelineMs, renderBoundMs, static_cast<unsigned long long>(stalls), stats.convertMs, stats.writeMs,
+                stats.maxQueued, static_cast<unsigned long long>(qoiTotal));
+    std::printf("encoder_pipe: %s total_ms=%.1f output_bytes=%llu errors=%d\n", haveFfmpeg ? "ffmpeg" : "cat",
+                pipeMs, static_cast<unsigned long long>(pipeOutputBytes), errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
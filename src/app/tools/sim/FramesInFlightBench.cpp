@@ -0,0 +1,200 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DeferredReleaseQueue.h"
+#include "ShaderLab/Core/FrameContextRing.h"
+#include "ShaderLab/Core/FrameRingBuffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Simulated GPU queue: frames execute back to back in submission order, and fence value n
+// signals when the nth submission finishes. Time only moves through Advance and waits.
+class FakeFrameFence final : public ShaderLab::IFrameFence {
+public:
+    uint64_t Submit(double gpuMs) {
+        const double start = (std::max)(m_nowMs, m_busyUntilMs);
+        m_busyUntilMs = start + gpuMs;
+        m_doneAtMs.push_back(m_busyUntilMs);
+        return m_doneAtMs.size();
+    }
+
+    uint64_t GetCompletedValue() override {
+        while (m_completed < m_doneAtMs.size() && m_doneAtMs[m_completed] <= m_nowMs) {
+            ++m_completed;
+        }
+        return m_completed;
+    }
+
+    void WaitForValue(uint64_t value) override {
+        if (value > 0 && value <= m_doneAtMs.size() && m_doneAtMs[value - 1] > m_nowMs) {
+            m_waitMs += m_doneAtMs[value - 1] - m_nowMs;
+            m_nowMs = m_doneAtMs[value - 1];
+        }
+    }
+
+    void Advance(double ms) { m_nowMs += ms; }
+    void Finish() { WaitForValue(m_doneAtMs.size()); }
+
+    double GetNowMs() const { return m_nowMs; }
+    double GetWaitMs() const { return m_waitMs; }
+    double GetBusyMs() const { return m_busyUntilMs; }
+
+private:
+    std::vector<double> m_doneAtMs;
+    uint64_t m_completed = 0;
+    double m_nowMs = 0.0;
+    double m_busyUntilMs = 0.0;
+    double m_waitMs = 0.0;
+};
+
+// Deferred object that reports an error if it is destroyed while its frame is still queued.
+class FakeGpuObject {
+public:
+    FakeGpuObject(FakeFrameFence& fence, uint64_t fenceValue, int& errors)
+        : m_fence(&fence), m_fenceValue(fenceValue), m_errors(&errors) {}
+    FakeGpuObject(FakeGpuObject&& other) noexcept
+        : m_fence(other.m_fence), m_fenceValue(other.m_fenceValue), m_errors(other.m_errors) {
+        other.m_fence = nullptr;
+    }
+    FakeGpuObject(const FakeGpuObject&) = delete;
+    FakeGpuObject& operator=(const FakeGpuObject&) = delete;
+
+    ~FakeGpuObject() {
+        if (m_fence && m_fence->GetCompletedValue() < m_fenceValue) {
+            ++*m_errors;
+        }
+    }
+
+private:
+    FakeFrameFence* m_fence;
+    uint64_t m_fenceValue;
+    int* m_errors;
+};
+
+struct FramePacingResult {
+    int frames = 0;
+    double totalMs = 0.0;
+    double waitMs = 0.0;
+    ShaderLab::FrameContextStats stats;
+    uint64_t uploadPeak = 0;
+    int errors = 0;
+};
+
+// Drives FrameContextRing, a per-frame upload ring and a deferred release queue against the fake
+// fence, checking that nothing is reused or released while the GPU may still read it.
+FramePacingResult SimulateFramePacing(const ShaderLab::DemoTrack& track,
+                                      int sceneCount,
+                                      const SimOptions& options,
+                                      const std::vector<double>& traceMs,
+                                      uint32_t contextCount) {
+    constexpr uint64_t kUploadBytes = 64 * 1024;
+    constexpr uint64_t kConstantsBytes = 256;
+
+    FramePacingResult result;
+    FakeFrameFence fence;
+    ShaderLab::FrameContextRing ring(contextCount);
+    ShaderLab::FrameRingBuffer upload(kUploadBytes);
+    ShaderLab::DeferredReleaseQueue<FakeGpuObject> deferred;
+    std::vector<uint64_t> contextFence(ring.GetContextCount(), 0);
+    std::vector<uint64_t> blockFence(kUploadBytes / kConstantsBytes, 0);
+    int previousVisible[2] = { -1, -1 };
+
+    result.frames = ReplayVisibleScenes(track, sceneCount, options, traceMs, [&](int, const int* visible) {
+        const uint32_t context = ring.BeginFrame(fence);
+        const uint64_t frame = ring.GetFrameIndex();
+        if (fence.GetCompletedValue() < contextFence[context]) {
+            ++result.errors; // Allocator reset while its last submission is still executing
+        }
+        deferred.Collect(ring.GetCompletedFrameIndex());
+        upload.BeginFrame(frame, ring.GetCompletedFrameIndex());
+
+        uint32_t visibleCount = 0;
+        for (int i = 0; i < 2; ++i) {
+            if (visible[i] < 0) {
+                continue;
+            }
+            ++visibleCount;
+            const uint64_t offset = upload.Allocate(kConstantsBytes, kConstantsBytes);
+            if (offset == ShaderLab::FrameRingBuffer::kInvalidOffset) {
+                ++result.errors;
+                continue;
+            }
+            uint64_t& owner = blockFence[offset / kConstantsBytes];
+            if (fence.GetCompletedValue() < owner) {
+                ++result.errors; // Constants overwritten while an earlier frame reads them
+            }
+            owner = frame + 1;
+        }
+        upload.EndFrame();
+
+        // Scenes leaving the screen release their targets the way ReleaseSceneResources does.
+        for (int previous : previousVisible) {
+            if (previous >= 0 && previous != visible[0] && previous != visible[1] && frame > 0) {
+                deferred.Push(frame - 1, FakeGpuObject(fence, frame, result.errors));
+            }
+        }
+        previousVisible[0] = visible[0];
+        previousVisible[1] = visible[1];
+
+        fence.Advance(options.cpuMs);
+        const uint64_t fenceValue = fence.Submit(options.gpuMs * (std::max)(1u, visibleCount));
+        contextFence[context] = fenceValue;
+        ring.EndFrame(fenceValue);
+    });
+
+    fence.Finish();
+    ring.UpdateCompleted(fence);
+    deferred.Collect(ring.GetCompletedFrameIndex());
+    if (deferred.GetPendingCount() != 0) {
+        ++result.errors;
+    }
+
+    result.totalMs = fence.GetNowMs();
+    result.waitMs = fence.GetWaitMs();
+    result.stats = ring.GetStats();
+    result.uploadPeak = upload.GetPeakUsed();
+    return result;
+}
+
+} // namespace
+
+// Compares the serial loop (wait after every frame) with N frame contexts on the fake fence.
+int RunFramesInFlightBench(const ShaderLab::DemoTrack& track,
+                           const ShaderLab::CompactTrack::Metadata& meta,
+                           const SimOptions& options,
+                           const std::vector<double>& traceMs) {
+    const int sceneCount = ResolveSceneCount(track, meta);
+    const FramePacingResult serial = SimulateFramePacing(track, sceneCount, options, traceMs, 1u);
+    const FramePacingResult pipelined = SimulateFramePacing(track, sceneCount, options, traceMs,
+                                                            static_cast<uint32_t>(options.framesInFlight));
+    const int errors = serial.errors + pipelined.errors;
+    for (const FramePacingResult* result : { &serial, &pipelined }) {
+        const uint32_t contexts = result == &serial ? 1u : static_cast<uint32_t>(options.framesInFlight);
+        std::printf("contexts=%u frames=%d total_ms=%.1f ms_per_frame=%.2f cpu_wait_ms=%.1f waits=%llu "
+                    "peak_in_flight=%u upload_peak=%llu\n",
+                    contexts,
+                    result->frames,
+                    result->totalMs,
+                    result->frames > 0 ? result->totalMs / result->frames : 0.0,
+                    result->waitMs,
+                    static_cast<unsigned long long>(result->stats.waits),
+                    result->stats.peakFramesInFlight,
+                    static_cast<unsigned long long>(result->uploadPeak));
+    }
+    std::printf("speedup=%.2f errors=%d\n",
+                pipelined.totalMs > 0.0 ? serial.totalMs / pipelined.totalMs : 0.0,
+                errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,270 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/RenderGraph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Records declared uses so the plan can be replayed against a per-physical state tracker.
+class CheckedRenderGraph {
+public:
+    struct Use {
+        uint32_t pass;
+        uint32_t resource;
+        uint32_t access;
+        bool write;
+    };
+
+    ShaderLab::RenderGraph graph;
+    std::vector<Use> uses;
+
+    void Reset() {
+        graph.Reset();
+        uses.clear();
+    }
+    void Read(uint32_t pass, uint32_t resource, uint32_t access = ShaderLab::RenderGraphAccessPixelRead) {
+        graph.Read(pass, resource, access);
+        uses.push_back({ pass, resource, access, false });
+    }
+    void Write(uint32_t pass, uint32_t resource, uint32_t access = ShaderLab::RenderGraphAccessRenderTarget) {
+        graph.Write(pass, resource, access);
+        uses.push_back({ pass, resource, access, true });
+    }
+
+    // Applies every barrier batch and checks that each live use sees a compatible state, that
+    // aliased transients never read another texture's contents, and that imports end at rest.
+    int Validate(const ShaderLab::RenderGraphPlan& plan) const {
+        const size_t physicalCount = plan.importedCount + plan.transientDescs.size();
+        std::vector<uint32_t> state(physicalCount, ShaderLab::RenderGraphAccessPixelRead);
+        std::vector<uint32_t> owner(physicalCount, ShaderLab::RenderGraph::kInvalid);
+        for (uint32_t r = 0; r < graph.GetResourceCount(); ++r) {
+            if (graph.IsImported(r)) {
+                state[plan.resourcePhysical[r]] = InitialAccess(r);
+                owner[plan.resourcePhysical[r]] = r;
+            }
+        }
+
+        int errors = 0;
+        auto apply = [&](uint32_t first, uint32_t count) {
+            for (uint32_t i = first; i < first + count; ++i) {
+                const ShaderLab::RenderGraphBarrier& barrier = plan.barriers[i];
+                if (barrier.physical >= physicalCount || barrier.before != state[barrier.physical]) {
+                    ++errors;
+                    continue;
+                }
+                state[barrier.physical] = barrier.after;
+            }
+        };
+        for (const ShaderLab::RenderGraphStep& step : plan.steps) {
+            apply(step.firstBarrier, step.barrierCount);
+            for (const Use& use : uses) {
+                if (use.pass != step.pass) {
+                    continue;
+                }
+                const uint32_t physical = plan.resourcePhysical[use.resource];
+                if (use.write) {
+                    errors += state[physical] == use.access ? 0 : 1;
+                    owner[physical] = use.resource;
+                } else {
+                    errors += (state[physical] & use.access) == use.access ? 0 : 1;
+                    errors += owner[physical] == use.resource ? 0 : 1;
+                }
+            }
+        }
+        apply(plan.finalFirstBarrier, plan.finalBarrierCount);
+        for (uint32_t r = 0; r < graph.GetResourceCount(); ++r) {
+            errors += state[plan.resourcePhysical[r]] == InitialAccess(r) ? 0 : 1;
+        }
+        return errors;
+    }
+
+    void SetInitialAccess(uint32_t resource, uint32_t access) {
+        if (m_initial.size() <= resource) {
+            m_initial.resize(resource + 1, ShaderLab::RenderGraphAccessPixelRead);
+        }
+        m_initial[resource] = access;
+    }
+
+private:
+    uint32_t InitialAccess(uint32_t resource) const {
+        return resource < m_initial.size() ? m_initial[resource] : ShaderLab::RenderGraphAccessPixelRead;
+    }
+
+    std::vector<uint32_t> m_initial;
+};
+
+} // namespace
+
+// Builds the player's frame graph (scene pass, post-FX and compute chains rendering into their
+// history rings, then the transition or the copy to the backbuffer) for every visible scene, and
+// compares the compiled barriers and copied bytes with the hand-written code it replaced, which
+// rendered into a scratch target and copied it into history.
+int RunGraphBench(const ShaderLab::DemoTrack& track,
+                  const ShaderLab::CompactTrack::Metadata& meta,
+                  const SimOptions& options,
+                  const std::vector<double>& traceMs) {
+    using namespace ShaderLab;
+    constexpr uint32_t kPostFxHistory = 4;
+    constexpr uint32_t kComputeHistory = 2;
+    constexpr uint32_t kHistoryAccess = RenderGraphAccessPixelRead | RenderGraphAccessComputeRead;
+
+    const int sceneCount = ResolveSceneCount(track, meta);
+    const size_t scenes = static_cast<size_t>((std::max)(0, sceneCount));
+    std::vector<bool> historyInitialized(scenes, false);
+    // Rendered frames held by each effect's ring, per scene.
+    std::vector<uint32_t> postFxFrames(scenes * static_cast<size_t>((std::max)(0, options.graphPostFx)), 0);
+    std::vector<uint32_t> computeFrames(scenes * static_cast<size_t>((std::max)(0, options.graphCompute)), 0);
+    const uint64_t targetBytes = static_cast<uint64_t>(options.targetWidth) * options.targetHeight * 4u;
+
+    CheckedRenderGraph checked;
+    RenderGraphPlan plan;
+    uint64_t legacyBarriers = 0;
+    uint64_t legacyCalls = 0;
+    uint64_t legacyCopyBytes = 0;
+    uint64_t legacyHistoryBytes = 0;
+    uint64_t graphBarriers = 0;
+    uint64_t graphBatches = 0;
+    uint64_t graphCopyBytes = 0;
+    uint64_t passes = 0;
+    uint64_t culled = 0;
+    uint32_t peakTransientTargets = 0;
+    uint32_t peakTransientTextures = 0;
+    int errors = 0;
+
+    // Imports the ring slot an effect writes this frame and the slots holding its rendered
+    // history; historyFrames counts those, up to historyCount.
+    auto declareRing = [&](const char* name, uint32_t access, uint32_t pass, uint32_t historyCount,
+                           uint32_t& historyFrames, uint32_t readAccess, uint32_t writeAccess) {
+        for (uint32_t i = 0; i < historyFrames; ++i) {
+            const uint32_t history = checked.graph.ImportTexture(name, 0, access, access);
+            checked.SetInitialAccess(history, access);
+            checked.Read(pass, history, readAccess);
+        }
+        const uint32_t output = checked.graph.ImportTexture(name, 0, access, access);
+        checked.SetInitialAccess(output, access);
+        checked.Write(pass, output, writeAccess);
+        historyFrames = (std::min)(historyFrames + 1, historyCount);
+        return output;
+    };
+
+    auto declareScene = [&](int sceneIndex) -> uint32_t {
+        const uint32_t texture = checked.graph.ImportTexture("scene", 100u + static_cast<uint64_t>(sceneIndex),
+                                                             RenderGraphAccessPixelRead, RenderGraphAccessPixelRead);
+        const uint32_t scenePass = checked.graph.AddPass("scene");
+        checked.Write(scenePass, texture);
+        legacyBarriers += 2;
+        legacyCalls += 2;
+
+        uint32_t current = texture;
+        const bool firstUse = !historyInitialized[static_cast<size_t>(sceneIndex)];
+        for (int fx = 0; fx < options.graphPostFx; ++fx) {
+            if (firstUse) {
+                legacyBarriers += 4 * kPostFxHistory;
+                legacyCalls += 2 * kPostFxHistory;
+                legacyCopyBytes += kPostFxHistory * targetBytes;
+                legacyHistoryBytes += kPostFxHistory * targetBytes;
+            }
+            const uint32_t pass = checked.graph.AddPass("post-fx");
+            checked.Read(pass, current);
+            uint32_t& frames = postFxFrames[static_cast<size_t>(sceneIndex) * static_cast<size_t>(options.graphPostFx) + static_cast<size_t>(fx)];
+            const uint32_t output = declareRing("post-fx ring", RenderGraphAccessPixelRead, pass, kPostFxHistory, frames,
+                                                RenderGraphAccessPixelRead, RenderGraphAccessRenderTarget);
+            legacyBarriers += 2 + 4;
+            legacyCalls += 2 + 2;
+            legacyCopyBytes += targetBytes;
+            legacyHistoryBytes += targetBytes;
+            current = output;
+        }
+        for (int fx = 0; fx < options.graphCompute; ++fx) {
+            const uint32_t pass = checked.graph.AddPass("compute");
+            checked.Read(pass, current, RenderGraphAccessComputeRead);
+            uint32_t& frames = computeFrames[static_cast<size_t>(sceneIndex) * static_cast<size_t>(options.graphCompute) + static_cast<size_t>(fx)];
+            const uint32_t output = declareRing("compute ring", kHistoryAccess, pass, kComputeHistory, frames,
+                                                RenderGraphAccessComputeRead, RenderGraphAccessUnorderedAccess);
+            legacyBarriers += 2 + 1 + 2 + 4;
+            legacyCalls += 1 + 1 + 1 + 2;
+            legacyCopyBytes += targetBytes;
+            legacyHistoryBytes += targetBytes;
+            current = output;
+        }
+        historyInitialized[static_cast<size_t>(sceneIndex)] = true;
+        return current;
+    };
+
+    const int frames = ReplayVisibleScenes(track, sceneCount, options, traceMs, [&](int, const int* visible) {
+        checked.Reset();
+        const uint32_t backbuffer = checked.graph.ImportTexture("backbuffer", 1u, RenderGraphAccessRenderTarget, RenderGraphAccessRenderTarget);
+        checked.SetInitialAccess(backbuffer, RenderGraphAccessRenderTarget);
+
+        uint32_t outputs[2] = { RenderGraph::kInvalid, RenderGraph::kInvalid };
+        for (int i = 0; i < 2; ++i) {
+            if (visible[i] >= 0 && (i == 0 || visible[i] != visible[0])) {
+                outputs[i] = declareScene(visible[i]);
+            }
+        }
+        if (visible[1] >= 0) {
+            const uint32_t pass = checked.graph.AddPass("transition");
+            for (uint32_t output : outputs) {
+                if (output != RenderGraph::kInvalid) {
+                    checked.Read(pass, output);
+                }
+            }
+            checked.Write(pass, backbuffer);
+        } else if (outputs[0] != RenderGraph::kInvalid) {
+            const uint32_t pass = checked.graph.AddPass("copy to backbuffer");
+            checked.Read(pass, outputs[0], RenderGraphAccessCopySource);
+            checked.Write(pass, backbuffer, RenderGraphAccessCopyDest);
+            legacyBarriers += 4;
+            legacyCalls += 4;
+            legacyCopyBytes += targetBytes;
+            graphCopyBytes += targetBytes;
+        }
+
+        std::string error;
+        if (!checked.graph.Compile(plan, error)) {
+            std::fprintf(stderr, "graph compile failed: %s\n", error.c_str());
+            ++errors;
+            return;
+        }
+        errors += checked.Validate(plan);
+        graphBarriers += plan.stats.barriers;
+        graphBatches += plan.stats.barrierBatches;
+        passes += plan.stats.passesDeclared;
+        culled += plan.stats.passesCulled;
+        peakTransientTextures = (std::max)(peakTransientTextures, plan.stats.transientTextures);
+        peakTransientTargets = (std::max)(peakTransientTargets, plan.stats.transientTargets);
+    });
+
+    const double perFrame = frames > 0 ? 1.0 / static_cast<double>(frames) : 0.0;
+    std::printf("frames=%d passes_per_frame=%.2f culled=%llu transient_textures_peak=%u transient_targets_peak=%u\n",
+                frames,
+                static_cast<double>(passes) * perFrame,
+                static_cast<unsigned long long>(culled),
+                peakTransientTextures,
+                peakTransientTargets);
+    std::printf("before: barriers_per_frame=%.2f barrier_calls_per_frame=%.2f\n",
+                static_cast<double>(legacyBarriers) * perFrame,
+                static_cast<double>(legacyCalls) * perFrame);
+    std::printf("after:  barriers_per_frame=%.2f barrier_calls_per_frame=%.2f errors=%d\n",
+                static_cast<double>(graphBarriers) * perFrame,
+                static_cast<double>(graphBatches) * perFrame,
+                errors);
+    std::printf("copied_bytes_per_frame: before=%.0f (history %.0f) after=%.0f\n",
+                static_cast<double>(legacyCopyBytes) * perFrame,
+                static_cast<double>(legacyHistoryBytes) * perFrame,
+                static_cast<double>(graphCopyBytes) * perFrame);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
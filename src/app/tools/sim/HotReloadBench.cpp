@@ -0,0 +1,211 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/AssetCatalog.h"
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+int RunHotReloadBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    int errors = 0;
+    // The scenarios below edit links up to index 14, i.e. scene 7's post-FX.
+    const int sceneCount = options.hotReloadScenes > 0 ? (std::max)(8, options.hotReloadScenes) : 16;
+    constexpr double kDebounceMs = 150.0;
+
+    const fs::path root = fs::temp_directory_path() / ("shaderlab_hotreload_bench_" + std::to_string(options.seed));
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root / "scenes", ec);
+    fs::create_directories(root / "postfx", ec);
+    fs::create_directories(root / "other", ec);
+    auto writeFile = [](const fs::path& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    };
+    const std::string body = MakeBenchShaderSource(60);
+
+    // The IDE's side: the code each target currently runs and the compiles it queued.
+    std::vector<LinkedShaderLink> links;
+    std::vector<std::string> code;
+    for (int i = 0; i < sceneCount; ++i) {
+        LinkedShaderLink link;
+        link.key.kind = CompileTargetKind::Scene;
+        link.key.sceneIndex = i;
+        link.path = (root / "scenes" / ("scene_" + std::to_string(i) + ".hlsl")).string();
+        writeFile(link.path, body + "// scene " + std::to_string(i) + "\n");
+        links.push_back(link);
+        code.push_back(body + "// scene " + std::to_string(i) + "\n");
+
+        link.key.kind = CompileTargetKind::PostFx;
+        link.key.effectIndex = 0;
+        link.path = (root / "postfx" / ("fx_" + std::to_string(i) + ".hlsl")).string();
+        writeFile(link.path, "// fx " + std::to_string(i) + "\n");
+        links.push_back(link);
+        code.push_back("// fx " + std::to_string(i) + "\n");
+    }
+    writeFile(root / "scenes" / "notes.txt", "not linked");
+
+    AssetCatalog catalog;
+    catalog.Start();
+    LinkedShaderWatcher watcher(catalog, kDebounceMs);
+    watcher.SetLinks(links);
+
+    const auto begin = Clock::now();
+    auto nowMs = [&begin]() {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    };
+    std::vector<LinkedShaderChange> changes;
+    int compilesQueued = 0;
+    int conflicts = 0;
+    // Polls like the frame loop would for `ms`, applying changes the way the IDE does.
+    auto pump = [&](double ms) {
+        const double end = nowMs() + ms;
+        size_t added = 0;
+        while (nowMs() < end) {
+            const size_t first = changes.size();
+            added += watcher.Poll(nowMs(), changes);
+            for (size_t c = first; c < changes.size(); ++c) {
+                const LinkedShaderChange& change = changes[c];
+                const auto link = std::find_if(links.begin(), links.end(), [&](const LinkedShaderLink& l) {
+                    return l.key == change.key;
+                });
+                std::string& current = code[link - links.begin()];
+                if (HashShaderText(current) != change.previousHash) {
+                    ++conflicts;
+                    continue;
+                }
+                if (*change.code != current) {
+                    current = *change.code;
+                    ++compilesQueued;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        return added;
+    };
+
+    // Baseline: the first scan sets every link's known content and reports nothing.
+    size_t reported = pump(400.0);
+    errors += reported != 0 ? 1 : 0;
+    std::printf("%zu links in 2 folders: baseline scan reported %zu changes\n", links.size(), reported);
+
+    // Save without changes (and a touch): the write time moves, the content does not.
+    {
+        writeFile(links[2].path, code[2]);
+        fs::last_write_time(links[4].path, fs::file_time_type::clock::now(), ec);
+        reported = pump(400.0);
+        const LinkedShaderWatcherStats stats = watcher.GetStats();
+        errors += reported != 0 || stats.touches < 2 ? 1 : 0;
+        std::printf("save same content + touch: %zu changes, %llu touches ignored\n", reported,
+                    static_cast<unsigned long long>(stats.touches));
+    }
+
+    // A burst of saves, 30 ms apart: one compile with the last content, after the debounce.
+    {
+        const size_t first = changes.size();
+        const int queuedBefore = compilesQueued;
+        double lastWriteMs = 0.0;
+        for (int w = 0; w < 6; ++w) {
+            writeFile(links[6].path, body + "// burst " + std::to_string(w) + "\n");
+            lastWriteMs = nowMs();
+            pump(30.0);
+        }
+        double seenMs = -1.0;
+        while (nowMs() < lastWriteMs + 2000.0 && changes.size() == first) {
+            pump(2.0);
+        }
+        seenMs = changes.size() > first ? nowMs() - lastWriteMs : -1.0;
+        pump(300.0);
+        const bool ok = changes.size() == first + 1 && code[6] == body + "// burst 5\n" &&
+                        compilesQueued == queuedBefore + 1 && seenMs >= kDebounceMs * 0.5;
+        errors += ok ? 0 : 1;
+        std::printf("6 saves in 180 ms: %zu change(s), %d compile(s), applied %.0f ms after the last save "
+                    "(debounce %.0f ms), %llu writes coalesced\n",
+                    changes.size() - first, compilesQueued - queuedBefore, seenMs, kDebounceMs,
+                    static_cast<unsigned long long>(watcher.GetStats().coalesced));
+    }
+
+    // Edited and reverted before it settled: nothing to compile.
+    {
+        const size_t first = changes.size();
+        writeFile(links[8].path, "// temporary\n");
+        pump(60.0);
+        writeFile(links[8].path, code[8]);
+        pump(400.0);
+        errors += changes.size() != first ? 1 : 0;
+        std::printf("edit then revert within the debounce: %zu changes\n", changes.size() - first);
+    }
+
+    // Two targets in different folders: each gets its own compile, nothing else is queued.
+    {
+        const size_t first = changes.size();
+        writeFile(links[10].path, body + "// scene edited\n");
+        writeFile(links[11].path, "// fx edited\n");
+        pump(500.0);
+        bool keysOk = changes.size() == first + 2;
+        for (size_t c = first; keysOk && c < changes.size(); ++c) {
+            keysOk = changes[c].key == links[10].key || changes[c].key == links[11].key;
+        }
+        errors += keysOk ? 0 : 1;
+        std::printf("scene + post-FX edited: %zu changes, right targets=%d\n", changes.size() - first, keysOk ? 1 : 0);
+    }
+
+    // In-app edits win: a file change under an unsaved edit is reported but not applied.
+    {
+        const int conflictsBefore = conflicts;
+        code[12] += "// edited in the IDE\n";
+        writeFile(links[12].path, "// edited outside\n");
+        pump(500.0);
+        errors += conflicts != conflictsBefore + 1 || code[12].find("edited in the IDE") == std::string::npos ? 1 : 0;
+        std::printf("external edit over unsaved IDE edit: kept the IDE copy (%d conflict)\n", conflicts - conflictsBefore);
+    }
+
+    // Relinking (a scene pointed at another file): only the new file is watched for it.
+    {
+        links[14].path = (root / "other" / "moved.hlsl").string();
+        writeFile(links[14].path, code[14]);
+        watcher.SetLinks(links);
+        pump(400.0);
+        const size_t first = changes.size();
+        writeFile(root / "scenes" / "scene_7.hlsl", "// old link target\n");
+        writeFile(links[14].path, body + "// moved and edited\n");
+        pump(500.0);
+        const bool ok = changes.size() == first + 1 && changes.back().key == links[14].key;
+        errors += ok ? 0 : 1;
+        std::printf("relinked scene: %zu change(s) after editing the old and the new file\n", changes.size() - first);
+    }
+
+    // Frame cost when nothing changed.
+    {
+        const int polls = 100000;
+        std::vector<LinkedShaderChange> none;
+        const auto start = Clock::now();
+        for (int i = 0; i < polls; ++i) {
+            watcher.Poll(nowMs(), none);
+        }
+        const double pollNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / polls;
+        errors += none.empty() ? 0 : 1;
+        std::printf("idle Poll: %.0f ns per frame; catalog files read=%llu\n", pollNs,
+                    static_cast<unsigned long long>(catalog.GetStats().filesRead));
+    }
+
+    catalog.Stop();
+    fs::remove_all(root, ec);
+    std::printf("hotreload: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
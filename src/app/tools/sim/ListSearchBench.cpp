@@ -0,0 +1,156 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/ListSearchIndex.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+int RunListSearchBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    using Clock = std::chrono::steady_clock;
+    int errors = 0;
+    const int itemCount = options.listItems > 0 ? options.listItems : 500;
+
+    uint32_t state = options.seed ? options.seed : 1u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    static const char* const kWords[] = {
+        "Plasma", "Tunnel", "Raymarch", "Bloom", "Glitch", "Voronoi", "Fractal", "Nebula", "Kaleido", "Grid",
+        "Warp", "Chroma", "Feedback", "Terrain", "Clouds", "Metaballs", "Noise", "Starfield", "Ocean", "Neon",
+    };
+    constexpr size_t kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+    auto makeName = [&](int i) {
+        std::string name = kWords[next() % kWordCount];
+        name += ' ';
+        name += kWords[next() % kWordCount];
+        name += " " + std::to_string(i + 1);
+        return name;
+    };
+    std::vector<std::string> names;
+    for (int i = 0; i < itemCount; ++i) {
+        names.push_back(makeName(i));
+    }
+
+    // What the list views did before: lowercase every name, every frame.
+    auto linearQuery = [&](const std::string& needle, std::vector<int>& out) {
+        out.clear();
+        const std::string key = ToSearchKey(needle);
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (ToSearchKey(names[i]).find(key) != std::string::npos) {
+                out.push_back(static_cast<int>(i));
+            }
+        }
+    };
+
+    ListSearchIndex index;
+    auto sync = [&]() {
+        int rekeyed = 0;
+        index.Resize(names.size());
+        for (size_t i = 0; i < names.size(); ++i) {
+            rekeyed += index.SetItem(i, names[i]) ? 1 : 0;
+        }
+        return rekeyed;
+    };
+    const auto buildStart = Clock::now();
+    const int built = sync();
+    const double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+    const auto syncStart = Clock::now();
+    const int resynced = sync();
+    const double syncUs = std::chrono::duration<double, std::micro>(Clock::now() - syncStart).count();
+    std::printf("index: %d items keyed in %.3f ms; unchanged sync %.1f us, %d re-keyed\n",
+                itemCount, buildMs, syncUs, resynced);
+    errors += built == itemCount ? 0 : 1;
+    errors += resynced == 0 ? 0 : 1;
+
+    // Typing each query a character at a time, the way the filter box sees it.
+    std::vector<std::string> queries = { "pla", "TUNNEL", "o", "ra", "noise 1", "zzz", "e 4", "Neon Ocean", "" };
+    for (int i = 0; i < 24; ++i) {
+        const std::string& name = names[next() % names.size()];
+        const size_t start = next() % name.size();
+        queries.push_back(name.substr(start, 1 + next() % 8));
+    }
+    std::vector<int> expected;
+    double indexedUs = 0.0;
+    double linearUs = 0.0;
+    int keystrokes = 0;
+    for (const std::string& query : queries) {
+        for (size_t length = 0; length <= query.size(); ++length) {
+            const std::string typed = query.substr(0, length);
+            auto t0 = Clock::now();
+            const std::vector<int>& result = index.Query(typed);
+            auto t1 = Clock::now();
+            linearQuery(typed, expected);
+            auto t2 = Clock::now();
+            indexedUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+            linearUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+            ++keystrokes;
+            if (result != expected) {
+                std::printf("mismatch for \"%s\": %zu vs %zu matches\n", typed.c_str(), result.size(), expected.size());
+                ++errors;
+            }
+        }
+    }
+    // Pasted queries skip the refinement and go through the trigram postings.
+    double pastedUs = 0.0;
+    double pastedLinearUs = 0.0;
+    for (const std::string& query : queries) {
+        index.Query("");
+        auto t0 = Clock::now();
+        const std::vector<int>& result = index.Query(query);
+        auto t1 = Clock::now();
+        linearQuery(query, expected);
+        auto t2 = Clock::now();
+        pastedUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        pastedLinearUs += std::chrono::duration<double, std::micro>(t2 - t1).count();
+        if (result != expected) {
+            std::printf("mismatch for pasted \"%s\": %zu vs %zu matches\n", query.c_str(), result.size(), expected.size());
+            ++errors;
+        }
+    }
+    std::printf("%d keystrokes: indexed %.2f us, linear lowercase scan %.2f us per keystroke\n", keystrokes,
+                indexedUs / keystrokes, linearUs / keystrokes);
+    std::printf("%zu pasted queries over %zu trigrams: indexed %.2f us, linear %.2f us per query\n", queries.size(),
+                index.GetTrigramCount(), pastedUs / queries.size(), pastedLinearUs / queries.size());
+
+    // A rename or an append only re-keys what changed, and queries see it at once.
+    const size_t before = index.Query("plasma").size();
+    names[next() % names.size()] = "Renamed Plasma Special";
+    names.push_back("Added Plasma");
+    const int rekeyed = sync();
+    linearQuery("plasma", expected);
+    errors += index.Query("plasma") == expected ? 0 : 1;
+    linearQuery("special", expected);
+    errors += index.Query("special") == expected && expected.size() == 1 ? 0 : 1;
+    errors += rekeyed == 2 ? 0 : 1;
+    // Deleting the first item shifts every index, so everything after it is re-keyed once.
+    names.erase(names.begin());
+    const auto deleteStart = Clock::now();
+    const int shifted = sync();
+    index.Query("plasma!");
+    const double deleteMs = std::chrono::duration<double, std::milli>(Clock::now() - deleteStart).count();
+    linearQuery("plasma", expected);
+    errors += index.Query("plasma") == expected ? 0 : 1;
+    std::printf("rename + add: %d re-keyed, \"plasma\" %zu -> %zu matches; delete first: %d re-keyed in %.3f ms\n",
+                rekeyed, before, expected.size(), shifted, deleteMs);
+
+    names.resize(names.size() / 2);
+    sync();
+    linearQuery("e", expected);
+    errors += index.Query("e") == expected ? 0 : 1;
+    index.Clear();
+    errors += index.Query("").empty() && index.GetTrigramCount() == 0 ? 0 : 1;
+
+    std::printf("listsearch: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,101 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/PipelineLoadScheduler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Stand-in for the player's D3D12 factory: fixed per-call costs, no device.
+class SyntheticPipelineFactory final : public ShaderLab::IPipelineFactory {
+public:
+    SyntheticPipelineFactory(double loadMs, double createMs) : m_loadMs(loadMs), m_createMs(createMs) {}
+
+    bool LoadBytecode(const ShaderLab::PipelineLoadJob& job, std::vector<uint8_t>& outBytecode) override {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(m_loadMs));
+        outBytecode.assign(job.bytecodeKey.begin(), job.bytecodeKey.end());
+        return true;
+    }
+
+    bool CreatePipeline(size_t, const ShaderLab::PipelineLoadJob&, const std::vector<uint8_t>& bytecode) override {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(m_createMs));
+        return !bytecode.empty();
+    }
+
+private:
+    double m_loadMs;
+    double m_createMs;
+};
+
+// Mirrors the player's job list: one scene pipeline plus its post-FX chain per scene, keyed
+// by shader module so shared modules load once.
+std::vector<ShaderLab::PipelineLoadJob> BuildLoadJobs(const ShaderLab::DemoTrack& track,
+                                                      const ShaderLab::CompactTrack::Metadata& meta) {
+    const int sceneCount = ResolveSceneCount(track, meta);
+
+    std::vector<ShaderLab::PipelineLoadJob> jobs;
+    for (int sceneIndex = 0; sceneIndex < sceneCount; ++sceneIndex) {
+        ShaderLab::PipelineLoadJob sceneJob;
+        sceneJob.kind = ShaderLab::PipelineKind::ScenePixel;
+        sceneJob.sceneIndex = sceneIndex;
+        const int moduleIndex = sceneIndex < static_cast<int>(meta.sceneModuleIndices.size())
+            ? meta.sceneModuleIndices[static_cast<size_t>(sceneIndex)]
+            : -1;
+        sceneJob.bytecodeKey = moduleIndex >= 0 ? "module:" + std::to_string(moduleIndex)
+                                                : "scene:" + std::to_string(sceneIndex);
+        jobs.push_back(sceneJob);
+
+        if (sceneIndex < static_cast<int>(meta.postFxModuleIndices.size())) {
+            const auto& fxModules = meta.postFxModuleIndices[static_cast<size_t>(sceneIndex)];
+            for (size_t fxIndex = 0; fxIndex < fxModules.size(); ++fxIndex) {
+                ShaderLab::PipelineLoadJob fxJob;
+                fxJob.kind = ShaderLab::PipelineKind::PostFxPixel;
+                fxJob.sceneIndex = sceneIndex;
+                fxJob.effectIndex = static_cast<int>(fxIndex);
+                fxJob.bytecodeKey = "module:" + std::to_string(fxModules[fxIndex]);
+                jobs.push_back(fxJob);
+            }
+        }
+    }
+    return jobs;
+}
+
+} // namespace
+
+int RunLoadBench(const ShaderLab::DemoTrack& track,
+                 const ShaderLab::CompactTrack::Metadata& meta,
+                 const SimOptions& options) {
+    const std::vector<ShaderLab::PipelineLoadJob> jobs = BuildLoadJobs(track, meta);
+    const unsigned workers = options.loadBenchWorkers > 0
+        ? static_cast<unsigned>(options.loadBenchWorkers)
+        : ShaderLab::PipelineLoadScheduler::DefaultWorkerCount();
+
+    SyntheticPipelineFactory factory(options.loadMs, options.createMs);
+    const unsigned configs[2] = { 0u, workers };
+    for (unsigned workerCount : configs) {
+        ShaderLab::PipelineLoadScheduler scheduler;
+        scheduler.Start(jobs, factory, workerCount);
+        scheduler.Wait();
+        const ShaderLab::PipelineLoadStats& stats = scheduler.GetStats();
+        std::printf("workers=%u jobs=%zu loads=%zu failed=%zu wall_ms=%.1f load_ms=%.1f create_ms=%.1f\n",
+                    stats.workerCount, stats.jobCount, stats.loadCount, stats.failedCount,
+                    stats.wallMs, stats.loadMs, stats.createMs);
+        if (stats.failedCount > 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
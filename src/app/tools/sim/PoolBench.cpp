@@ -0,0 +1,123 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/TransientTargetPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Stand-in for TransientTargetService: RGBA8 byte counts, no device. Tracks which handles
+// hold a live target so the bench can catch the pool handing out a destroyed slot.
+class FakeTransientTargetBackend final : public ShaderLab::ITransientTargetBackend {
+public:
+    bool CreateTarget(uint32_t handle, const ShaderLab::TransientTargetDesc& desc, uint64_t& outBytes) override {
+        if (handle >= m_live.size()) {
+            m_live.resize(static_cast<size_t>(handle) + 1, false);
+        }
+        if (m_live[handle]) {
+            ++m_errors;
+        }
+        m_live[handle] = true;
+        outBytes = static_cast<uint64_t>(desc.width) * desc.height * 4u;
+        return true;
+    }
+
+    void DestroyTarget(uint32_t handle) override {
+        if (handle >= m_live.size() || !m_live[handle]) {
+            ++m_errors;
+            return;
+        }
+        m_live[handle] = false;
+    }
+
+    bool IsLive(uint32_t handle) const { return handle < m_live.size() && m_live[handle]; }
+    int GetErrorCount() const { return m_errors; }
+
+private:
+    std::vector<bool> m_live;
+    int m_errors = 0;
+};
+
+} // namespace
+
+// Issues the player's per-frame post-FX and compute ping-pong leases for every visible scene,
+// then compares the pool against one dedicated pair per scene.
+int RunPoolBench(const ShaderLab::DemoTrack& track,
+                 const ShaderLab::CompactTrack::Metadata& meta,
+                 const SimOptions& options,
+                 const std::vector<double>& traceMs) {
+    const int sceneCount = ResolveSceneCount(track, meta);
+
+    // Without project data every scene is assumed to run one post-FX and one compute chain.
+    ShaderLab::TransientTargetDesc postFxDesc;
+    postFxDesc.width = options.targetWidth;
+    postFxDesc.height = options.targetHeight;
+    postFxDesc.flags = 1u;
+    ShaderLab::TransientTargetDesc computeDesc = postFxDesc;
+    computeDesc.flags = 2u;
+
+    FakeTransientTargetBackend backend;
+    ShaderLab::TransientTargetPool pool(backend);
+    std::vector<bool> sceneSeen(static_cast<size_t>((std::max)(0, sceneCount)), false);
+    std::vector<uint32_t> frameLeases;
+    int leaseErrors = 0;
+
+    auto runChain = [&](const ShaderLab::TransientTargetDesc& desc) {
+        const uint32_t a = pool.Acquire(desc);
+        const uint32_t b = pool.Acquire(desc);
+        for (uint32_t handle : frameLeases) {
+            if (handle == a || handle == b) {
+                ++leaseErrors;
+            }
+        }
+        if (a == b || !backend.IsLive(a) || !backend.IsLive(b)) {
+            ++leaseErrors;
+        }
+        // Odd chain length leaves the output in a, like a single-pass chain in the player.
+        pool.Release(b);
+        frameLeases.push_back(a);
+    };
+
+    const int frames = ReplayVisibleScenes(track, sceneCount, options, traceMs, [&](int frame, const int* visible) {
+        pool.BeginFrame(static_cast<uint64_t>(frame), frame - 1);
+        frameLeases.clear();
+        for (int i = 0; i < 2; ++i) {
+            if (visible[i] < 0) {
+                continue;
+            }
+            sceneSeen[static_cast<size_t>(visible[i])] = true;
+            runChain(computeDesc);
+            runChain(postFxDesc);
+        }
+        pool.EndFrame();
+    });
+    pool.Clear();
+
+    const ShaderLab::TransientTargetPoolStats& stats = pool.GetStats();
+    const uint64_t targetBytes = static_cast<uint64_t>(options.targetWidth) * options.targetHeight * 4u;
+    const uint64_t dedicatedBytes = static_cast<uint64_t>(std::count(sceneSeen.begin(), sceneSeen.end(), true)) * 4u * targetBytes;
+    const int errors = leaseErrors + backend.GetErrorCount() + (stats.liveTargets != 0 ? 1 : 0);
+    std::printf("frames=%d acquires=%llu creates=%llu reuses=%llu destroys=%llu peak_live_bytes=%llu "
+                "peak_leased_bytes=%llu dedicated_bytes=%llu errors=%d\n",
+                frames,
+                static_cast<unsigned long long>(stats.acquireCount),
+                static_cast<unsigned long long>(stats.createCount),
+                static_cast<unsigned long long>(stats.reuseCount),
+                static_cast<unsigned long long>(stats.destroyCount),
+                static_cast<unsigned long long>(stats.peakLiveBytes),
+                static_cast<unsigned long long>(stats.peakLeasedBytes),
+                static_cast<unsigned long long>(dedicatedBytes),
+                errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,232 @@
+#include "SimBenches.h"
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/FrameProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+struct ProfileRunResult {
+    int frames = 0;
+    int gpuFrames = 0;
+    std::vector<double> sceneGpuMs;  // Simulated GPU "scene" total per frame that had one
+    ShaderLab::FrameProfilerCounters counters;
+    std::string trace;
+    uint32_t tracedFrames = 0;
+    int errors = 0;
+};
+
+// Replays the track through FrameProfiler with a fake clock and fake GPU timestamps that are read
+// back latency frames late. CPU scopes nest declare/execute/scene, GPU scopes nest post-fx in scene.
+ProfileRunResult SimulateProfiler(const ShaderLab::DemoTrack& track,
+                                  int sceneCount,
+                                  const SimOptions& options,
+                                  const std::vector<double>& traceMs,
+                                  uint32_t frameSlots,
+                                  uint32_t latency,
+                                  uint32_t traceFrames) {
+    using namespace ShaderLab;
+    constexpr uint64_t kTicksPerSecond = 10000000u;
+    ProfileRunResult result;
+    FrameProfiler profiler(frameSlots, 64);
+    double nowUs = 0.0;
+    profiler.SetClock([&nowUs]() { return nowUs; });
+    std::vector<uint64_t> ticks(profiler.GetQueryCapacity(), 0);
+    uint64_t gpuTick = 0;
+    auto stamp = [&](uint32_t query) {
+        if (query != FrameProfiler::kInvalidQuery) {
+            ticks[query] = gpuTick;
+        }
+    };
+    auto advanceGpu = [&](double ms) {
+        gpuTick += static_cast<uint64_t>(ms * static_cast<double>(kTicksPerSecond) / 1000.0 + 0.5);
+    };
+    auto resolve = [&](int64_t completedFrameIndex) {
+        uint64_t frameIndex = 0;
+        uint32_t first = 0;
+        uint32_t count = 0;
+        while (profiler.GetPendingGpuFrame(completedFrameIndex, frameIndex, first, count)) {
+            profiler.ResolveGpuFrame(frameIndex, ticks.data() + first, kTicksPerSecond);
+        }
+    };
+
+    profiler.BeginCapture(traceFrames);
+    result.frames = ReplayVisibleScenes(track, sceneCount, options, traceMs, [&](int frame, const int* visible) {
+        resolve(static_cast<int64_t>(frame) - static_cast<int64_t>(latency));
+        profiler.BeginFrame(static_cast<uint64_t>(frame));
+        profiler.BeginCpuScope("declare graph");
+        nowUs += options.cpuMs * 250.0;
+        profiler.EndCpuScope();
+        profiler.BeginCpuScope("execute graph");
+        double frameGpuMs = 0.0;
+        bool hasScene = false;
+        for (int i = 0; i < 2; ++i) {
+            if (visible[i] < 0 || (i == 1 && visible[1] == visible[0])) {
+                continue;
+            }
+            const bool stall = i == 0 && options.stallEvery > 0 && frame > 0 && (frame % options.stallEvery) == 0;
+            const double sceneMs = options.gpuMs + (stall ? options.stallMs : 0.0);
+            profiler.BeginCpuScope("scene");
+            stamp(profiler.BeginGpuScope("scene"));
+            advanceGpu(sceneMs * 0.5);
+            stamp(profiler.BeginGpuScope("post-fx"));
+            advanceGpu(sceneMs * 0.5);
+            stamp(profiler.EndGpuScope());
+            stamp(profiler.EndGpuScope());
+            nowUs += options.cpuMs * 250.0;
+            profiler.EndCpuScope();
+            frameGpuMs += sceneMs;
+            hasScene = true;
+        }
+        profiler.EndCpuScope();
+        nowUs += options.cpuMs * 250.0;
+        profiler.EndFrame();
+        if (hasScene) {
+            ++result.gpuFrames;
+            result.sceneGpuMs.push_back(frameGpuMs);
+        }
+    });
+    resolve(static_cast<int64_t>(result.frames) - 1);
+
+    result.counters = profiler.GetCounters();
+    result.trace = profiler.ExportChromeTrace();
+    result.tracedFrames = profiler.GetCapturedFrameCount();
+    if (!options.logPath.empty()) {
+        std::string error;
+        if (!profiler.WriteChromeTrace(options.logPath, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            ++result.errors;
+        }
+    }
+
+    // The GPU "scene" scope must match the simulated cost over the stat window, post-fx must nest
+    // under it, and the CPU "scene" scope under "execute graph".
+    const auto& stats = profiler.GetStats();
+    const ProfileScopeStats* gpuScene = nullptr;
+    uint32_t gpuSceneIndex = FrameProfiler::kNoParent;
+    bool postFxNested = false;
+    bool cpuSceneNested = false;
+    for (uint32_t i = 0; i < stats.size(); ++i) {
+        if (stats[i].track == ProfileTrack::Gpu && profiler.GetName(stats[i].name) == "scene") {
+            gpuScene = &stats[i];
+            gpuSceneIndex = i;
+        }
+    }
+    for (const ProfileScopeStats& stat : stats) {
+        const std::string& name = profiler.GetName(stat.name);
+        if (stat.track == ProfileTrack::Gpu && name == "post-fx") {
+            postFxNested = stat.parent == gpuSceneIndex && stat.depth == 1;
+        }
+        if (stat.track == ProfileTrack::Cpu && name == "scene") {
+            cpuSceneNested = stat.parent != FrameProfiler::kNoParent && profiler.GetName(stats[stat.parent].name) == "execute graph";
+        }
+    }
+    if (result.gpuFrames > 0 && latency < frameSlots) {
+        const size_t window = (std::min)(result.sceneGpuMs.size(), static_cast<size_t>(120));
+        std::vector<double> expected(result.sceneGpuMs.end() - static_cast<std::ptrdiff_t>(window), result.sceneGpuMs.end());
+        std::sort(expected.begin(), expected.end());
+        double sum = 0.0;
+        for (double ms : expected) {
+            sum += ms;
+        }
+        const double avg = sum / static_cast<double>(window);
+        const double p95 = expected[static_cast<size_t>(std::ceil(0.95 * static_cast<double>(window))) - 1];
+        if (!gpuScene || std::fabs(gpuScene->avgMs - avg) > 1.0e-3 || std::fabs(gpuScene->p95Ms - p95) > 1.0e-3 ||
+            std::fabs(gpuScene->maxMs - expected.back()) > 1.0e-3 || !postFxNested || !cpuSceneNested) {
+            ++result.errors;
+        }
+        if (gpuScene) {
+            std::printf("gpu scene: avg=%.3f p95=%.3f max=%.3f ms (expected %.3f %.3f %.3f)\n",
+                        gpuScene->avgMs, gpuScene->p95Ms, gpuScene->maxMs, avg, p95, expected.back());
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+// Checks FrameProfiler with delayed readback over enough slots (every GPU frame resolves) and with
+// too few slots (frames are dropped but still counted), then times real-clock scope overhead.
+int RunProfileBench(const ShaderLab::DemoTrack& track,
+                    const ShaderLab::CompactTrack::Metadata& meta,
+                    const SimOptions& options,
+                    const std::vector<double>& traceMs) {
+    using namespace ShaderLab;
+    constexpr uint32_t kTraceFrames = 8;
+    const int sceneCount = ResolveSceneCount(track, meta);
+
+    const ProfileRunResult delayed = SimulateProfiler(track, sceneCount, options, traceMs, 3, 2, kTraceFrames);
+    SimOptions noTrace = options;
+    noTrace.logPath.clear();
+    const ProfileRunResult starved = SimulateProfiler(track, sceneCount, noTrace, traceMs, 2, 3, 0);
+
+    int errors = delayed.errors + starved.errors;
+    const FrameProfilerCounters& a = delayed.counters;
+    const FrameProfilerCounters& b = starved.counters;
+    if (a.framesCompleted != static_cast<uint64_t>(delayed.frames) ||
+        a.gpuFramesResolved != static_cast<uint64_t>(delayed.gpuFrames) ||
+        a.gpuFramesDropped != 0 || a.gpuScopesDropped != 0 || a.unbalancedScopes != 0) {
+        ++errors;
+    }
+    if (b.framesCompleted != static_cast<uint64_t>(starved.frames) ||
+        b.gpuFramesResolved + b.gpuFramesDropped != static_cast<uint64_t>(starved.gpuFrames) ||
+        (starved.gpuFrames > 2 && b.gpuFramesDropped == 0)) {
+        ++errors;
+    }
+
+    size_t traceEvents = 0;
+    size_t traceFrames = 0;
+    for (size_t at = delayed.trace.find("\"ph\":\"X\""); at != std::string::npos; at = delayed.trace.find("\"ph\":\"X\"", at + 1)) {
+        ++traceEvents;
+    }
+    for (size_t at = delayed.trace.find("{\"name\":\"frame "); at != std::string::npos; at = delayed.trace.find("{\"name\":\"frame ", at + 1)) {
+        ++traceFrames;
+    }
+    const uint32_t expectedTraceFrames = (std::min)(kTraceFrames, static_cast<uint32_t>((std::max)(0, delayed.frames)));
+    if (delayed.tracedFrames != expectedTraceFrames || traceFrames != expectedTraceFrames || traceEvents <= traceFrames) {
+        ++errors;
+    }
+
+    // Real clock: one frame of 64 nested and flat scopes.
+    FrameProfiler timed;
+    constexpr int kTimedFrames = 2000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kTimedFrames; ++frame) {
+        timed.BeginFrame(static_cast<uint64_t>(frame));
+        for (int i = 0; i < 32; ++i) {
+            ScopedCpuProfile outer(&timed, "pass");
+            ScopedCpuProfile inner(&timed, "draw");
+        }
+        timed.EndFrame();
+    }
+    const double elapsedNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("frames=%d gpu_frames=%d resolved=%llu dropped=%llu scopes_dropped=%llu unbalanced=%llu\n",
+                delayed.frames, delayed.gpuFrames,
+                static_cast<unsigned long long>(a.gpuFramesResolved),
+                static_cast<unsigned long long>(a.gpuFramesDropped),
+                static_cast<unsigned long long>(a.gpuScopesDropped),
+                static_cast<unsigned long long>(a.unbalancedScopes));
+    std::printf("starved slots=2 latency=3: resolved=%llu dropped=%llu\n",
+                static_cast<unsigned long long>(b.gpuFramesResolved),
+                static_cast<unsigned long long>(b.gpuFramesDropped));
+    std::printf("trace: frames=%zu events=%zu bytes=%zu%s%s\n",
+                traceFrames, traceEvents, delayed.trace.size(),
+                options.logPath.empty() ? "" : " written to ", options.logPath.c_str());
+    std::printf("ns_per_scope=%.1f errors=%d\n", elapsedNs / (kTimedFrames * 64.0), errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,185 @@
+#include "SimBenches.h"
+#include "SimMockCompiler.h"
+
+#include "ShaderLab/Core/AsyncCompilationService.h"
+#include "ShaderLab/Core/ProjectCompileBatch.h"
+#include "ShaderLab/Core/ShaderBytecodeCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+struct ProjectCompileRun {
+    double totalMs = 0.0;
+    double activeReadyMs = 0.0;
+    size_t activeOrder = 0; // Position of the active scene among delivered results
+    uint64_t compilerCalls = 0;
+    uint64_t cacheHits = 0;
+    int errors = 0;
+};
+
+// One project open: fans the requests out like ShaderLabIDE::StartProjectCompile, polls once a
+// millisecond like the UI frame loop and checks progress and the per-target results.
+ProjectCompileRun RunProjectCompile(const std::vector<ShaderLab::AsyncCompileRequest>& requests,
+                                    const ShaderLab::CompileTargetKey& activeKey,
+                                    unsigned workers,
+                                    double compileMs,
+                                    ShaderLab::ShaderBytecodeCache& cache) {
+    using namespace ShaderLab;
+    ProjectCompileRun run;
+    std::atomic<uint64_t> compilerCalls{0};
+    AsyncCompilationService service([&]() { return std::make_unique<MockCompilationService>(compileMs, &compilerCalls); }, workers);
+    service.SetBytecodeCache(&cache);
+
+    ProjectCompileBatch batch;
+    batch.Start(service, requests);
+    size_t delivered = 0;
+    size_t lastCompleted = 0;
+    bool activeReady = false;
+    std::vector<AsyncCompileResult> results;
+    for (;;) {
+        results.clear();
+        service.Collect(results);
+        for (const AsyncCompileResult& result : results) {
+            if (!result.result.success ||
+                std::string(result.result.bytecode.begin(), result.result.bytecode.end()) != result.source) {
+                ++run.errors;
+            }
+            if (result.key == activeKey) {
+                activeReady = true;
+                run.activeOrder = delivered;
+                run.activeReadyMs = batch.GetElapsedMs();
+            }
+            ++delivered;
+        }
+        const bool finished = batch.Update(service);
+        if (batch.GetCompleted() < lastCompleted || batch.GetCompleted() > batch.GetTotal()) {
+            ++run.errors; // Progress must only move forward
+        }
+        lastCompleted = batch.GetCompleted();
+        if (finished || !batch.IsActive()) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    run.totalMs = batch.GetElapsedMs();
+    run.compilerCalls = compilerCalls.load();
+    run.cacheHits = service.GetStats().cacheHits;
+    if (!activeReady || delivered != requests.size() || lastCompleted != requests.size()) {
+        ++run.errors;
+    }
+    return run;
+}
+
+} // namespace
+
+int RunProjectCompileBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    const int sceneCount = options.projectCompileScenes > 0 ? options.projectCompileScenes : 100;
+    const unsigned workers = options.compileBenchWorkers > 0
+        ? static_cast<unsigned>(options.compileBenchWorkers)
+        : AsyncCompilationService::BatchWorkerCount();
+    const int activeScene = sceneCount / 2;
+
+    // A project shaped like a demo: every scene, a post-FX chain on every other scene and a
+    // compute effect on every fourth. Costs vary around --compile-ms.
+    uint32_t state = options.seed ? options.seed : 1u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    auto makeRequest = [&](CompileTargetKind kind, int scene, int effect) {
+        AsyncCompileRequest request;
+        request.key.kind = kind;
+        request.key.sceneIndex = scene;
+        request.key.effectIndex = effect;
+        request.source = "target " + std::to_string(static_cast<int>(kind)) + "/" + std::to_string(scene) + "/" +
+                         std::to_string(effect) + " // cost=" + std::to_string(options.compileMs * (0.5 + (next() % 100) / 100.0));
+        request.target = kind == CompileTargetKind::Compute ? "cs_6_0" : "";
+        request.flipFragCoord = kind == CompileTargetKind::PostFx;
+        request.priority = scene == activeScene ? (kind == CompileTargetKind::Scene ? 2 : 1) : 0;
+        return request;
+    };
+    std::vector<AsyncCompileRequest> requests;
+    double serialMs = 0.0;
+    for (int scene = 0; scene < sceneCount; ++scene) {
+        requests.push_back(makeRequest(CompileTargetKind::Scene, scene, -1));
+        if (scene % 2 == 0) {
+            requests.push_back(makeRequest(CompileTargetKind::PostFx, scene, 0));
+            requests.push_back(makeRequest(CompileTargetKind::PostFx, scene, 1));
+        }
+        if (scene % 4 == 0) {
+            requests.push_back(makeRequest(CompileTargetKind::Compute, scene, 0));
+        }
+    }
+    for (const AsyncCompileRequest& request : requests) {
+        serialMs += std::atof(request.source.c_str() + request.source.find("// cost=") + 8);
+    }
+    CompileTargetKey activeKey;
+    activeKey.kind = CompileTargetKind::Scene;
+    activeKey.sceneIndex = activeScene;
+
+    ShaderBytecodeCache cache;
+    const ProjectCompileRun open = RunProjectCompile(requests, activeKey, workers, options.compileMs, cache);
+    // Adapter restart: same sources, new service, the cache survives.
+    const ProjectCompileRun restart = RunProjectCompile(requests, activeKey, workers, options.compileMs, cache);
+    // Reopen after editing a few scenes: only those reach the compiler.
+    std::vector<AsyncCompileRequest> edited = requests;
+    const size_t editCount = (std::min)(static_cast<size_t>(5), edited.size());
+    for (size_t i = 0; i < editCount; ++i) {
+        edited[(i * 7) % edited.size()].source += "\n// edit";
+    }
+    const ProjectCompileRun reopen = RunProjectCompile(edited, activeKey, workers, options.compileMs, cache);
+
+    int errors = open.errors + restart.errors + reopen.errors;
+    // Nothing outranks the active scene and Start submits it first, so it is ready after its own
+    // compile time, not after a share of the whole project. The service runs no other jobs here;
+    // one that was already compiling before Start would add its remaining time.
+    double activeCostMs = 0.0;
+    for (const AsyncCompileRequest& request : requests) {
+        if (request.key == activeKey) {
+            activeCostMs = std::atof(request.source.c_str() + request.source.find("// cost=") + 8);
+        }
+    }
+    if (open.activeReadyMs > activeCostMs + options.compileMs) {
+        ++errors;
+    }
+    if (open.compilerCalls != requests.size() || restart.compilerCalls != 0 || restart.cacheHits != requests.size() ||
+        reopen.compilerCalls != editCount) {
+        ++errors;
+    }
+    if (workers > 1 && open.totalMs > serialMs * 0.75) {
+        ++errors; // The fan-out has to beat compiling one after another
+    }
+    const ShaderBytecodeCacheStats cacheStats = cache.GetStats();
+    std::printf("project: scenes=%d targets=%zu workers=%u serial_ms=%.1f\n", sceneCount, requests.size(), workers, serialMs);
+    auto printRun = [](const char* name, const ProjectCompileRun& run) {
+        std::printf("%s: total_ms=%.1f active_ready_ms=%.1f active_order=%zu compiler_calls=%llu cache_hits=%llu errors=%d\n",
+                    name, run.totalMs, run.activeReadyMs, run.activeOrder,
+                    static_cast<unsigned long long>(run.compilerCalls),
+                    static_cast<unsigned long long>(run.cacheHits), run.errors);
+    };
+    printRun("open", open);
+    printRun("restart", restart);
+    printRun("reopen", reopen);
+    std::printf("cache: entries=%zu bytes=%zu hits=%llu misses=%llu errors=%d\n",
+                cacheStats.entries, cacheStats.bytes,
+                static_cast<unsigned long long>(cacheStats.hits),
+                static_cast<unsigned long long>(cacheStats.misses), errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,206 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/ProjectSnapshot.h"
+#include "ShaderLab/Core/TrackData.h"
+#include "ShaderLab/Core/TrackerRowStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+int RunRowStoreBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    using Clock = std::chrono::steady_clock;
+    const int rowCount = options.rowCount > 0 ? options.rowCount : 20000;
+    int errors = 0;
+    uint32_t state = options.seed ? options.seed : 1u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+
+    // A long track with a row on about every third beat, entered in random order.
+    DemoTrack track;
+    track.lengthBeats = rowCount * 3;
+    std::vector<TrackerRow> flat;
+    for (int beat = 0; beat < track.lengthBeats; ++beat) {
+        if (next() % 3 == 0) {
+            TrackerRow row;
+            row.rowId = beat;
+            row.sceneIndex = beat % 16 == 0 ? static_cast<int>(next() % 8) : -1;
+            row.musicIndex = beat % 64 == 0 ? static_cast<int>(next() % 4) : -1;
+            row.oneShotIndex = beat % 5 == 0 ? 1 : -1;
+            flat.push_back(row);
+        }
+    }
+    for (size_t i = flat.size(); i > 1; --i) {
+        std::swap(flat[i - 1], flat[next() % i]);
+    }
+
+    // Pointers taken before further inserts must stay valid (the tracker holds them per frame).
+    std::vector<std::pair<int, const TrackerRow*>> handles;
+    for (size_t i = 0; i < flat.size(); ++i) {
+        const auto inserted = track.rows.Insert(flat[i]);
+        if (!inserted.second) {
+            ++errors;
+        }
+        if (i % 97 == 0) {
+            handles.emplace_back(flat[i].rowId, inserted.first);
+        }
+    }
+    int moved = 0;
+    for (const auto& handle : handles) {
+        moved += track.rows.Find(handle.first) != handle.second || handle.second->rowId != handle.first ? 1 : 0;
+    }
+    bool sorted = std::is_sorted(track.rows.begin(), track.rows.end(), [](const TrackerRow& a, const TrackerRow& b) {
+        return a.rowId < b.rowId;
+    });
+    if (moved != 0 || !sorted || track.rows.size() != flat.size()) {
+        ++errors;
+    }
+    std::printf("insert %zu rows: handles=%zu moved=%d sorted=%d\n", track.rows.size(), handles.size(), moved, sorted ? 1 : 0);
+
+    // Per-frame tracker lookups: 48 visible beats, five columns each, at random scroll positions.
+    {
+        const int frames = 2000;
+        const int visible = 48;
+        std::vector<TrackerRow> linear = track.rows.ToVector();
+        std::vector<int> scroll(frames);
+        for (int& position : scroll) {
+            position = static_cast<int>(next() % static_cast<uint32_t>(track.lengthBeats - visible));
+        }
+        size_t foundStore = 0;
+        auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (int beat = scroll[frame]; beat < scroll[frame] + visible; ++beat) {
+                for (int column = 0; column < 5; ++column) {
+                    foundStore += track.rows.Find(beat) ? 1 : 0;
+                }
+            }
+        }
+        const double storeUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / frames;
+        size_t foundLinear = 0;
+        const int linearFrames = 20;
+        start = Clock::now();
+        for (int frame = 0; frame < linearFrames; ++frame) {
+            for (int beat = scroll[frame]; beat < scroll[frame] + visible; ++beat) {
+                for (int column = 0; column < 5; ++column) {
+                    for (const TrackerRow& row : linear) {
+                        if (row.rowId == beat) {
+                            ++foundLinear;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+        const double linearUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / linearFrames;
+        size_t expectedLinear = 0;
+        for (int frame = 0; frame < linearFrames; ++frame) {
+            for (int beat = scroll[frame]; beat < scroll[frame] + visible; ++beat) {
+                expectedLinear += track.rows.Find(beat) ? 5 : 0;
+            }
+        }
+        if (foundLinear != expectedLinear) {
+            ++errors;
+        }
+        std::printf("frame lookups (%d beats x 5 columns): store %.2f us, linear scan %.1f us (found %zu)\n", visible,
+                    storeUs, linearUs, foundStore / frames);
+    }
+
+    // Playback walks beat ranges; compare with the old scan over every row for every beat.
+    {
+        PlaybackService playback;
+        std::vector<std::pair<int, const TrackerRow*>> triggered;
+        int mismatches = 0;
+        const auto start = Clock::now();
+        int windows = 0;
+        for (int from = -1; from < track.lengthBeats; from += 7, ++windows) {
+            playback.CollectTriggeredRows(track, from, from + 7, triggered);
+            size_t expected = 0;
+            for (int beat = from + 1; beat <= from + 7; ++beat) {
+                expected += track.rows.Find(beat) ? 1 : 0;
+            }
+            if (triggered.size() != expected) {
+                ++mismatches;
+            }
+            for (const auto& entry : triggered) {
+                mismatches += entry.second->rowId != entry.first || entry.first <= from || entry.first > from + 7 ? 1 : 0;
+            }
+        }
+        const double collectUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / windows;
+        errors += mismatches > 0 ? 1 : 0;
+        std::printf("playback windows=%d mismatches=%d collect %.2f us/window\n", windows, mismatches, collectUs);
+    }
+
+    // Batch edits and their merge rules.
+    {
+        TrackerRowStore store;
+        std::vector<TrackerRow> batch(6);
+        const int beats[] = { 8, 2, 8, 5, 2, 11 };
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i].rowId = beats[i];
+            batch[i].sceneIndex = static_cast<int>(i);
+        }
+        const size_t dropped = store.Assign(batch);
+        const bool assignOk = dropped == 2 && store.size() == 4 && store.Find(8)->sceneIndex == 0 && store.Find(2)->sceneIndex == 1;
+        TrackerRow* five = store.Find(5);
+
+        std::vector<TrackerRow> more(3);
+        more[0].rowId = 5;
+        more[0].sceneIndex = 99;
+        more[1].rowId = 1;
+        more[2].rowId = 20;
+        const size_t added = store.InsertBatch(more.data(), more.size());
+        const bool batchOk = added == 2 && store.size() == 6 && store.Find(5) == five && five->sceneIndex == 3;
+
+        // Delete beats 3..5, then open two beats at 10.
+        store.ShiftBeats(6, -3);
+        store.ShiftBeats(10, 2);
+        const bool shiftOk = store.size() == 5 && store.Find(2) && store.Find(5) && store.Find(5)->sceneIndex == 0 &&
+                             store.Find(8) && store.Find(8)->sceneIndex == 5 && store.Find(19) && !store.Find(20);
+
+        TrackerRowStore copy = store;
+        copy.Ensure(3).sceneIndex = 7;
+        const bool copyOk = !store.Find(3) && copy.Find(3) && copy.size() == store.size() + 1 && &copy[0] != &store[0];
+
+        const size_t erased = store.EraseRange(0, 6);
+        const bool eraseOk = erased == 3 && store.size() == 2 && store[0].rowId == 8 && !store.Erase(4) && store.Erase(19);
+        store.Ensure(40);
+        const bool reuseOk = store.size() == 2 && store[1].rowId == 40 && store[1].sceneIndex == -1;
+
+        if (!assignOk || !batchOk || !shiftOk || !copyOk || !eraseOk || !reuseOk) {
+            ++errors;
+        }
+        std::printf("batch edits: assign=%d insert_batch=%d shift=%d copy=%d erase=%d reuse=%d\n", assignOk ? 1 : 0,
+                    batchOk ? 1 : 0, shiftOk ? 1 : 0, copyOk ? 1 : 0, eraseOk ? 1 : 0, reuseOk ? 1 : 0);
+    }
+
+    // Bulk load from a snapshot-sized vector vs one insert at a time in random order.
+    {
+        const auto start = Clock::now();
+        TrackerRowStore loaded;
+        loaded.Assign(flat);
+        const double assignMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const bool same = loaded.size() == track.rows.size() &&
+            std::equal(loaded.begin(), loaded.end(), track.rows.begin(), [](const TrackerRow& a, const TrackerRow& b) {
+                return TrackerRowsEqual(a, b);
+            });
+        if (!same) {
+            ++errors;
+        }
+        std::printf("assign %zu rows: %.2f ms same=%d\n", flat.size(), assignMs, same ? 1 : 0);
+    }
+
+    std::printf("rows: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
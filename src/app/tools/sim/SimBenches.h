@@ -0,0 +1,68 @@
+#pragma once
+
+#include "SimOptions.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/TrackData.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+// Each bench prints its measurements plus "<name>: errors=N" and returns 0 only when N is 0.
+
+// Track benches: replay the --track file (and --trace frame times, when given).
+int RunLoadBench(const ShaderLab::DemoTrack& track,
+                 const ShaderLab::CompactTrack::Metadata& meta,
+                 const SimOptions& options);
+int RunPoolBench(const ShaderLab::DemoTrack& track,
+                 const ShaderLab::CompactTrack::Metadata& meta,
+                 const SimOptions& options,
+                 const std::vector<double>& traceMs);
+int RunDescriptorBench(const ShaderLab::DemoTrack& track,
+                       const ShaderLab::CompactTrack::Metadata& meta,
+                       const SimOptions& options,
+                       const std::vector<double>& traceMs);
+int RunFramesInFlightBench(const ShaderLab::DemoTrack& track,
+                           const ShaderLab::CompactTrack::Metadata& meta,
+                           const SimOptions& options,
+                           const std::vector<double>& traceMs);
+int RunGraphBench(const ShaderLab::DemoTrack& track,
+                  const ShaderLab::CompactTrack::Metadata& meta,
+                  const SimOptions& options,
+                  const std::vector<double>& traceMs);
+int RunProfileBench(const ShaderLab::DemoTrack& track,
+                    const ShaderLab::CompactTrack::Metadata& meta,
+                    const SimOptions& options,
+                    const std::vector<double>& traceMs);
+int RunDynresBench(const ShaderLab::DemoTrack& track,
+                   const ShaderLab::CompactTrack::Metadata& meta,
+                   const SimOptions& options,
+                   const std::vector<double>& traceMs);
+
+// Component benches: synthetic inputs only.
+int RunCompileBench(const SimOptions& options);
+int RunProjectCompileBench(const SimOptions& options);
+int RunSnapshotBench(const SimOptions& options);
+int RunExportBench(const SimOptions& options);
+int RunUploadBench(const SimOptions& options);
+int RunBakeBench(const SimOptions& options);
+int RunAudioBench(const SimOptions& options);
+int RunTempoBench(const SimOptions& options);
+int RunWaveformBench(const SimOptions& options);
+int RunRowStoreBench(const SimOptions& options);
+int RunTextBench(const SimOptions& options);
+int RunCatalogBench(const SimOptions& options);
+int RunHotReloadBench(const SimOptions& options);
+int RunThumbnailBench(const SimOptions& options);
+int RunListSearchBench(const SimOptions& options);
+
+// Synthetic inputs shared between benches.
+std::vector<float> MakeClickTrack(float bpm, float downbeatSeconds, float seconds, uint32_t sampleRate, uint32_t seed);
+std::string MakeBenchShaderSource(int lines);
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ShaderLab/Core/CompilationService.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+// Stand-in for DXC: sleeps "// cost=<ms>" (or the default) and returns the source bytes as
+// bytecode so results can be matched to requests. "#error" fails on that line.
+class MockCompilationService final : public ShaderLab::ICompilationService {
+public:
+    explicit MockCompilationService(double defaultMs, std::atomic<uint64_t>* compileCount = nullptr)
+        : m_defaultMs(defaultMs), m_compileCount(compileCount) {}
+
+    ShaderLab::ShaderCompileResult CompileFromSource(const std::string& source,
+                                                     const std::string&,
+                                                     const std::string&,
+                                                     const std::wstring&,
+                                                     ShaderLab::ShaderCompileMode,
+                                                     const std::vector<ShaderLab::CompilationTextureBinding>&) override {
+        return Compile(source);
+    }
+
+    ShaderLab::ShaderCompileResult CompilePreviewShader(const std::string& shaderSource,
+                                                        const std::vector<ShaderLab::CompilationTextureBinding>&,
+                                                        bool,
+                                                        const std::string&,
+                                                        const std::wstring&,
+                                                        ShaderLab::ShaderCompileMode) override {
+        return Compile(shaderSource);
+    }
+
+private:
+    ShaderLab::ShaderCompileResult Compile(const std::string& source) const {
+        if (m_compileCount) {
+            ++*m_compileCount;
+        }
+        double ms = m_defaultMs;
+        const size_t cost = source.find("// cost=");
+        if (cost != std::string::npos) {
+            ms = std::atof(source.c_str() + cost + 8);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(ms * 1000.0)));
+
+        ShaderLab::ShaderCompileResult result;
+        const size_t error = source.find("#error");
+        if (error != std::string::npos) {
+            ShaderLab::ShaderDiagnostic diagnostic;
+            diagnostic.message = "mock error";
+            diagnostic.line = static_cast<uint32_t>(std::count(source.begin(), source.begin() + static_cast<std::ptrdiff_t>(error), '\n') + 1);
+            diagnostic.isError = true;
+            result.diagnostics.push_back(diagnostic);
+            return result;
+        }
+        result.bytecode.assign(source.begin(), source.end());
+        result.success = true;
+        return result;
+    }
+
+    double m_defaultMs;
+    std::atomic<uint64_t>* m_compileCount;
+};
+
+} // namespace Sim
+} // namespace ShaderLab
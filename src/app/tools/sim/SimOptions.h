@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ShaderLab/Core/DemoSequencer.h"
+
+#include <cstdint>
+#include <string>
+
+namespace ShaderLab {
+namespace Sim {
+
+struct SimOptions {
+    std::string trackPath;
+    std::string logPath;
+    std::string expectPath;
+    std::string tracePath;
+    double fps = 60.0;
+    double jitter = 0.0;       // Fraction of the frame time, e.g. 0.25 = +/-25%
+    uint32_t seed = 1u;
+    int stallEvery = 0;        // Every Nth frame takes stallMs longer
+    double stallMs = 0.0;
+    double maxSeconds = 0.0;   // 0 = track length (+1 beat) for stop policies
+    int maxFrames = 0;
+    ShaderLab::SequencerEndPolicy endPolicy = ShaderLab::SequencerEndPolicy::Stop;
+    bool logFrames = false;
+    int benchIterations = 0;
+    int loadBenchWorkers = -1; // >= 0 runs the pipeline-load benchmark instead of the simulation
+    double loadMs = 2.0;
+    double createMs = 8.0;
+    double residencyLeadBeats = -1.0; // >= 0 prints the residency plan instead of simulating
+    uint32_t targetWidth = 1920;
+    uint32_t targetHeight = 1080;
+    bool poolBench = false;
+    bool descriptorBench = false;
+    int framesInFlight = 0;    // > 0 runs the frame-context benchmark instead of the simulation
+    double cpuMs = 6.0;
+    double gpuMs = 5.0;        // Per visible scene
+    bool graphBench = false;
+    int graphPostFx = 1;       // Post-FX effects per visible scene for --graph-bench
+    int graphCompute = 0;      // Compute effects per visible scene for --graph-bench
+    bool profileBench = false;
+    bool dynresBench = false;
+    double targetMs = 16.6;    // GPU frame budget for --dynres-bench
+    int compileBenchWorkers = -1; // >= 0 runs the async compile benchmark (0 = default worker count)
+    int projectCompileScenes = -1; // >= 0 runs the whole-project compile benchmark (0 = 100 scenes)
+    int snapshotScenes = -1;       // >= 0 runs the undo snapshot benchmark (0 = 200 scenes)
+    int snapshotEdits = 500;
+    int exportFrames = -1;         // >= 0 runs the video export benchmark (0 = 24 frames)
+    int uploadTextures = -1;       // >= 0 runs the texture upload benchmark (0 = 64 textures)
+    int bakeSize = -1;             // >= 0 runs the texture bake round trip (0 = 256 texels)
+    int audioSeconds = -1;         // >= 0 runs the audio analysis benchmark (0 = 10 s of audio)
+    int tempoSeconds = -1;         // >= 0 runs the tempo detection benchmark (0 = a 5 minute track)
+    int waveformSeconds = -1;      // >= 0 runs the waveform pyramid benchmark (0 = a 5 minute track)
+    int rowCount = -1;             // >= 0 runs the tracker row store benchmark (0 = 20000 rows)
+    int textLines = -1;            // >= 0 runs the text search benchmark (0 = 10k and 100k lines)
+    int catalogFiles = -1;         // >= 0 runs the asset catalog benchmark (0 = 500 files)
+    int hotReloadScenes = -1;      // >= 0 runs the linked shader hot reload benchmark (0 = 16 scenes)
+    int thumbnailShaders = -1;     // >= 0 runs the thumbnail atlas benchmark (0 = 200 shaders)
+    int listItems = -1;            // >= 0 runs the browse list search benchmark (0 = 500 items)
+    double compileMs = 20.0;
+};
+
+} // namespace Sim
+} // namespace ShaderLab
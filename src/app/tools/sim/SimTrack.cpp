@@ -0,0 +1,262 @@
+#include "SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DemoSequencer.h"
+#include "ShaderLab/Core/ResidencyPlanner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+const char* CommandLabel(ShaderLab::SequencerCommandType type) {
+    switch (type) {
+    case ShaderLab::SequencerCommandType::SceneCut: return "SCENE";
+    case ShaderLab::SequencerCommandType::TransitionBegin: return "TRANSITION";
+    case ShaderLab::SequencerCommandType::TransitionComplete: return "TRANSITION_DONE";
+    case ShaderLab::SequencerCommandType::MusicChange: return "MUSIC";
+    case ShaderLab::SequencerCommandType::OneShot: return "ONESHOT";
+    case ShaderLab::SequencerCommandType::Stop: return "STOP";
+    case ShaderLab::SequencerCommandType::Loop: return "LOOP";
+    }
+    return "?";
+}
+
+void AppendCommandLine(std::string& log, int frame, double timeSeconds, const ShaderLab::SequencerCommand& command) {
+    char line[256];
+    int written = std::snprintf(line, sizeof(line), "f=%d t=%.6f beat=%d %s",
+                                frame, timeSeconds, command.beat, CommandLabel(command.type));
+    log.append(line, static_cast<size_t>((std::max)(0, (std::min)(written, static_cast<int>(sizeof(line)) - 1))));
+
+    switch (command.type) {
+    case ShaderLab::SequencerCommandType::SceneCut:
+    case ShaderLab::SequencerCommandType::TransitionComplete:
+        log += " scene=" + std::to_string(command.sceneIndex);
+        break;
+    case ShaderLab::SequencerCommandType::TransitionBegin:
+        written = std::snprintf(line, sizeof(line), " %s from=%d to=%d dur=%.3f",
+                                command.transitionPresetStem.c_str(), command.fromSceneIndex,
+                                command.sceneIndex, command.durationBeats);
+        log.append(line, static_cast<size_t>((std::max)(0, (std::min)(written, static_cast<int>(sizeof(line)) - 1))));
+        break;
+    case ShaderLab::SequencerCommandType::MusicChange:
+        log += " music=" + std::to_string(command.musicIndex);
+        break;
+    case ShaderLab::SequencerCommandType::OneShot:
+        log += " oneshot=" + std::to_string(command.oneShotIndex);
+        break;
+    default:
+        break;
+    }
+    log += '\n';
+}
+
+void AppendFrameLine(std::string& log, int frame, double timeSeconds, int beat, const ShaderLab::DemoSequencer& sequencer, double exactBeat) {
+    const ShaderLab::SequencerState& state = sequencer.GetState();
+    char line[192];
+    const int written = std::snprintf(line, sizeof(line), "f=%d t=%.6f beat=%d FRAME scene=%d transition=%s progress=%.4f\n",
+                                      frame, timeSeconds, beat, state.activeSceneIndex,
+                                      state.transitionActive ? state.transitionPresetStem.c_str() : "-",
+                                      sequencer.GetTransitionProgress(exactBeat));
+    log.append(line, static_cast<size_t>((std::max)(0, (std::min)(written, static_cast<int>(sizeof(line)) - 1))));
+}
+
+} // namespace
+
+// Mirrors DemoPlayer::Update + Render: advance time, run the sequencer, then let the render
+// step finish due transitions.
+SimResult Simulate(const ShaderLab::DemoTrack& sourceTrack,
+                   const ShaderLab::CompactTrack::Metadata& meta,
+                   const SimOptions& options,
+                   const std::vector<double>& traceMs,
+                   bool captureLog) {
+    SimResult result;
+    ShaderLab::DemoTrack track = sourceTrack;
+    track.currentBeat = 0;
+    track.lastTriggeredBeat = -1;
+
+    ShaderLab::Transport transport;
+    transport.bpm = track.bpm > 0.0f ? track.bpm : 120.0f;
+    transport.state = ShaderLab::TransportState::Playing;
+    transport.timeSeconds = 0.0;
+
+    ShaderLab::DemoSequencer sequencer;
+    sequencer.SetEndPolicy(options.endPolicy);
+    sequencer.SetSceneCount(meta.sceneCount > 0 ? meta.sceneCount : -1);
+
+    double maxSeconds = options.maxSeconds;
+    if (maxSeconds <= 0.0) {
+        const double lengthBeats = static_cast<double>((std::max)(1, track.lengthBeats) + 1);
+        maxSeconds = lengthBeats * 60.0 / static_cast<double>(transport.bpm);
+    }
+
+    const std::vector<ShaderLab::AudioClip> noAudio;
+    std::vector<ShaderLab::SequencerCommand> commands;
+    FrameTimeSource frameTimes(options, traceMs);
+    double elapsedSeconds = 0.0;
+
+    for (int frame = 0; transport.state == ShaderLab::TransportState::Playing; ++frame) {
+        if (elapsedSeconds >= maxSeconds || (options.maxFrames > 0 && frame >= options.maxFrames)) {
+            break;
+        }
+
+        const float dt = frameTimes.Next(frame);
+        elapsedSeconds += dt;
+        transport.timeSeconds += dt;
+
+        sequencer.Advance(track, transport, noAudio, commands);
+        result.commands += commands.size();
+        if (captureLog) {
+            for (const auto& command : commands) {
+                AppendCommandLine(result.log, frame, transport.timeSeconds, command);
+            }
+        }
+
+        const double exactBeat = transport.timeSeconds * static_cast<double>(transport.bpm) / 60.0;
+        if (sequencer.CompleteDueTransition(exactBeat, -1) && captureLog) {
+            ShaderLab::SequencerCommand completed;
+            completed.type = ShaderLab::SequencerCommandType::TransitionComplete;
+            completed.beat = track.currentBeat;
+            completed.sceneIndex = sequencer.GetState().activeSceneIndex;
+            AppendCommandLine(result.log, frame, transport.timeSeconds, completed);
+        }
+        if (captureLog && options.logFrames) {
+            AppendFrameLine(result.log, frame, transport.timeSeconds, track.currentBeat, sequencer, exactBeat);
+        }
+        result.frames = frame + 1;
+    }
+    return result;
+}
+
+int ResolveSceneCount(const ShaderLab::DemoTrack& track, const ShaderLab::CompactTrack::Metadata& meta) {
+    int sceneCount = meta.sceneCount;
+    if (sceneCount <= 0) {
+        for (const auto& row : track.rows) {
+            sceneCount = (std::max)(sceneCount, row.sceneIndex + 1);
+        }
+    }
+    return sceneCount;
+}
+
+namespace {
+
+void AppendIntervals(std::string& log, const char* label, const std::vector<ShaderLab::ResidencyInterval>& intervals) {
+    char text[64];
+    log += ' ';
+    log += label;
+    log += '=';
+    if (intervals.empty()) {
+        log += '-';
+    }
+    for (size_t i = 0; i < intervals.size(); ++i) {
+        const int written = std::snprintf(text, sizeof(text), "%s[%.3f,%.3f)", i > 0 ? "," : "",
+                                          intervals[i].startBeat, intervals[i].endBeat);
+        log.append(text, static_cast<size_t>((std::max)(0, (std::min)(written, static_cast<int>(sizeof(text)) - 1))));
+    }
+}
+
+// Residency plan for the track with one RGBA8 output-sized target per scene (no project data,
+// so no post-FX/compute targets or scene bindings).
+
+} // namespace
+
+bool PlanResidency(const ShaderLab::DemoTrack& track,
+                   const ShaderLab::CompactTrack::Metadata& meta,
+                   const SimOptions& options,
+                   SimResult& outResult) {
+    std::vector<ShaderLab::ResidencySceneInfo> scenes(static_cast<size_t>((std::max)(0, ResolveSceneCount(track, meta))));
+    for (auto& scene : scenes) {
+        scene.bytes = static_cast<uint64_t>(options.targetWidth) * options.targetHeight * 4u;
+    }
+
+    ShaderLab::ResidencySettings settings;
+    settings.leadBeats = options.residencyLeadBeats;
+    settings.looping = options.endPolicy != ShaderLab::SequencerEndPolicy::Stop;
+
+    ShaderLab::ResidencyPlan plan;
+    std::string error;
+    if (!ShaderLab::ResidencyPlanner::Build(track, scenes, settings, plan, error)) {
+        std::cerr << "Residency plan failed: " << error << "\n";
+        return false;
+    }
+
+    std::string& log = outResult.log;
+    for (size_t sceneIndex = 0; sceneIndex < scenes.size(); ++sceneIndex) {
+        log += "scene=" + std::to_string(sceneIndex);
+        AppendIntervals(log, "active", plan.activeIntervals[sceneIndex]);
+        AppendIntervals(log, "resident", plan.residentIntervals[sceneIndex]);
+        log += '\n';
+    }
+
+    char line[160];
+    for (const auto& event : plan.events) {
+        const int written = std::snprintf(line, sizeof(line), "beat=%.3f %s scene=%d\n",
+                                          event.beat, event.allocate ? "ALLOC" : "RELEASE", event.sceneIndex);
+        log.append(line, static_cast<size_t>((std::max)(0, (std::min)(written, static_cast<int>(sizeof(line)) - 1))));
+    }
+    const int written = std::snprintf(line, sizeof(line), "end_beat=%.3f peak_bytes=%llu peak_beat=%.3f eager_bytes=%llu\n",
+                                      plan.endBeat,
+                                      static_cast<unsigned long long>(plan.peakBytes),
+                                      plan.peakBeat,
+                                      static_cast<unsigned long long>(plan.eagerBytes));
+    log.append(line, static_cast<size_t>((std::max)(0, (std::min)(written, static_cast<int>(sizeof(line)) - 1))));
+    outResult.commands = plan.events.size();
+    return true;
+}
+
+bool ReadTextFile(const std::string& path, std::string& outText) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    outText = buffer.str();
+    return true;
+}
+
+bool LoadFrameTrace(const std::string& path, std::vector<double>& outMs) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        char* end = nullptr;
+        const double value = std::strtod(line.c_str(), &end);
+        if (end != line.c_str() && value >= 0.0) {
+            outMs.push_back(value);
+        }
+    }
+    return !outMs.empty();
+}
+
+bool ParseEndPolicy(const std::string& value, ShaderLab::SequencerEndPolicy& outPolicy) {
+    if (value == "stop") {
+        outPolicy = ShaderLab::SequencerEndPolicy::Stop;
+    } else if (value == "loop") {
+        outPolicy = ShaderLab::SequencerEndPolicy::Loop;
+    } else if (value == "loop-unless-stop") {
+        outPolicy = ShaderLab::SequencerEndPolicy::LoopUnlessStopRow;
+    } else if (value == "continue") {
+        outPolicy = ShaderLab::SequencerEndPolicy::Continue;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
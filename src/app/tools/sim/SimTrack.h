@@ -0,0 +1,127 @@
+#pragma once
+
+#include "SimOptions.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DemoSequencer.h"
+#include "ShaderLab/Core/TrackData.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+struct SimResult {
+    int frames = 0;
+    size_t commands = 0;
+    std::string log;
+};
+
+// Deterministic frame-time source: fixed rate, optional recorded trace (ms per line, cycled),
+// seeded jitter and periodic stalls. No wall clock is involved.
+class FrameTimeSource {
+public:
+    explicit FrameTimeSource(const SimOptions& options, const std::vector<double>& traceMs)
+        : m_options(options), m_traceMs(traceMs), m_state(options.seed ? options.seed : 1u) {}
+
+    float Next(int frameIndex) {
+        double ms = m_traceMs.empty()
+            ? 1000.0 / (std::max)(1.0, m_options.fps)
+            : m_traceMs[static_cast<size_t>(frameIndex) % m_traceMs.size()];
+
+        if (m_options.jitter > 0.0) {
+            m_state = m_state * 1664525u + 1013904223u;
+            const double unit = static_cast<double>(m_state >> 8) / static_cast<double>(1u << 24);
+            ms *= 1.0 + (unit * 2.0 - 1.0) * m_options.jitter;
+        }
+        if (m_options.stallEvery > 0 && frameIndex > 0 && (frameIndex % m_options.stallEvery) == 0) {
+            ms += m_options.stallMs;
+        }
+        return static_cast<float>((std::max)(0.0, ms) / 1000.0);
+    }
+
+private:
+    const SimOptions& m_options;
+    const std::vector<double>& m_traceMs;
+    uint32_t m_state;
+};
+
+// Replays the track like Simulate() and calls onFrame(frame, visible) once per frame with the
+// scenes on screen: the active scene, or both sides of a running transition (-1 when unused).
+template <typename FrameCallback>
+int ReplayVisibleScenes(const ShaderLab::DemoTrack& sourceTrack,
+                        int sceneCount,
+                        const SimOptions& options,
+                        const std::vector<double>& traceMs,
+                        FrameCallback&& onFrame) {
+    ShaderLab::DemoTrack track = sourceTrack;
+    track.currentBeat = 0;
+    track.lastTriggeredBeat = -1;
+
+    ShaderLab::Transport transport;
+    transport.bpm = track.bpm > 0.0f ? track.bpm : 120.0f;
+    transport.state = ShaderLab::TransportState::Playing;
+
+    ShaderLab::DemoSequencer sequencer;
+    sequencer.SetEndPolicy(options.endPolicy);
+    sequencer.SetSceneCount(sceneCount > 0 ? sceneCount : -1);
+
+    double maxSeconds = options.maxSeconds;
+    if (maxSeconds <= 0.0) {
+        const double lengthBeats = static_cast<double>((std::max)(1, track.lengthBeats) + 1);
+        maxSeconds = lengthBeats * 60.0 / static_cast<double>(transport.bpm);
+    }
+
+    const std::vector<ShaderLab::AudioClip> noAudio;
+    std::vector<ShaderLab::SequencerCommand> commands;
+    FrameTimeSource frameTimes(options, traceMs);
+    double elapsedSeconds = 0.0;
+    int frames = 0;
+    for (int frame = 0; transport.state == ShaderLab::TransportState::Playing; ++frame) {
+        if (elapsedSeconds >= maxSeconds || (options.maxFrames > 0 && frame >= options.maxFrames)) {
+            break;
+        }
+        const float dt = frameTimes.Next(frame);
+        elapsedSeconds += dt;
+        transport.timeSeconds += dt;
+        sequencer.Advance(track, transport, noAudio, commands);
+        sequencer.CompleteDueTransition(transport.timeSeconds * static_cast<double>(transport.bpm) / 60.0, -1);
+
+        const ShaderLab::SequencerState& state = sequencer.GetState();
+        int visible[2] = { state.transitionActive ? state.transitionFromIndex : state.activeSceneIndex,
+                           state.transitionActive ? state.transitionToIndex : -1 };
+        for (int& sceneIndex : visible) {
+            if (sceneIndex >= sceneCount) {
+                sceneIndex = -1;
+            }
+        }
+        onFrame(frame, visible);
+        frames = frame + 1;
+    }
+    return frames;
+}
+
+SimResult Simulate(const ShaderLab::DemoTrack& sourceTrack,
+                   const ShaderLab::CompactTrack::Metadata& meta,
+                   const SimOptions& options,
+                   const std::vector<double>& traceMs,
+                   bool captureLog);
+
+// Scene count from the track metadata, or from the highest scene index the rows reference.
+int ResolveSceneCount(const ShaderLab::DemoTrack& track, const ShaderLab::CompactTrack::Metadata& meta);
+
+bool PlanResidency(const ShaderLab::DemoTrack& track,
+                   const ShaderLab::CompactTrack::Metadata& meta,
+                   const SimOptions& options,
+                   SimResult& outResult);
+
+bool ReadTextFile(const std::string& path, std::string& outText);
+bool LoadFrameTrace(const std::string& path, std::vector<double>& outMs);
+bool ParseEndPolicy(const std::string& value, ShaderLab::SequencerEndPolicy& outPolicy);
+
+} // namespace Sim
+} // namespace ShaderLab
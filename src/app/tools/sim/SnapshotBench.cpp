@@ -0,0 +1,306 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/ProjectSnapshot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Working copy of a scene's document data, laid out like ShaderLab::Scene without the GPU side.
+struct SnapshotBenchScene {
+    std::string name;
+    std::string description;
+    std::string shaderCode;
+    std::string shaderCodePath;
+    std::vector<ShaderLab::BindingDoc> bindings;
+    std::vector<std::pair<std::string, std::string>> postFx; // name, code
+    std::vector<std::pair<std::string, std::string>> compute;
+};
+
+struct SnapshotBenchProject {
+    std::vector<SnapshotBenchScene> scenes;
+    ShaderLab::TrackerRowStore rows;
+    std::vector<ShaderLab::AudioClip> audio;
+    ShaderLab::ProjectSettingsDoc settings;
+};
+
+template <typename Doc>
+
+bool SnapshotChainMatches(const std::vector<std::pair<std::string, std::string>>& chain,
+                          const std::shared_ptr<const std::vector<Doc>>& docs) {
+    if (!docs || docs->size() != chain.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < chain.size(); ++i) {
+        if ((*docs)[i].name != chain[i].first || *(*docs)[i].shaderCode != chain[i].second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Doc>
+
+std::shared_ptr<const std::vector<Doc>> SnapshotShareChain(const std::vector<std::pair<std::string, std::string>>& chain,
+                                                           const std::shared_ptr<const std::vector<Doc>>& previous) {
+    if (SnapshotChainMatches(chain, previous)) {
+        return previous;
+    }
+    auto docs = std::make_shared<std::vector<Doc>>(chain.size());
+    for (size_t i = 0; i < chain.size(); ++i) {
+        (*docs)[i].name = chain[i].first;
+        (*docs)[i].shaderCode = ShaderLab::ShareText(previous && i < previous->size() ? (*previous)[i].shaderCode : nullptr,
+                                                     chain[i].second);
+    }
+    return docs;
+}
+
+// The capture the editor does: diff the working copy against the previous snapshot and only
+// allocate what changed.
+ShaderLab::ProjectSnapshot CaptureBenchSnapshot(const SnapshotBenchProject& project, const ShaderLab::ProjectSnapshot* previous) {
+    using namespace ShaderLab;
+    static const ProjectSnapshot kEmpty;
+    const ProjectSnapshot& base = previous ? *previous : kEmpty;
+    ProjectSnapshot snapshot;
+    snapshot.scenes = PersistentVector<SceneNode, kSnapshotSceneChunk>::Rebuild(
+        base.scenes, project.scenes.size(),
+        [&](size_t i, const SceneNode& node) {
+            const SnapshotBenchScene& scene = project.scenes[i];
+            return node->name == scene.name && node->description == scene.description &&
+                   node->shaderCodePath == scene.shaderCodePath && *node->shaderCode == scene.shaderCode &&
+                   *node->bindings == scene.bindings && SnapshotChainMatches(scene.postFx, node->postFxChain) &&
+                   SnapshotChainMatches(scene.compute, node->computeChain);
+        },
+        [&](size_t i, const SceneNode* previousNode) {
+            const SnapshotBenchScene& scene = project.scenes[i];
+            const SceneDoc* old = previousNode ? previousNode->get() : nullptr;
+            auto doc = std::make_shared<SceneDoc>();
+            doc->name = scene.name;
+            doc->description = scene.description;
+            doc->shaderCodePath = scene.shaderCodePath;
+            doc->shaderCode = ShareText(old ? old->shaderCode : nullptr, scene.shaderCode);
+            doc->bindings = old && *old->bindings == scene.bindings ? old->bindings
+                                                                     : std::make_shared<const std::vector<BindingDoc>>(scene.bindings);
+            doc->postFxChain = SnapshotShareChain<PostFxDoc>(scene.postFx, old ? old->postFxChain : nullptr);
+            doc->computeChain = SnapshotShareChain<ComputeDoc>(scene.compute, old ? old->computeChain : nullptr);
+            return SceneNode(std::move(doc));
+        });
+    snapshot.trackRows = ShareTrackRows(base.trackRows, project.rows);
+    snapshot.audioLibrary = ShareAudioLibrary(base.audioLibrary, project.audio);
+    snapshot.settings = ShareSettings(base.settings, project.settings);
+    return snapshot;
+}
+
+uint64_t HashSnapshotText(uint64_t hash, const std::string& text) {
+    return (hash ^ static_cast<uint64_t>(std::hash<std::string>()(text))) * 1099511628211ull;
+}
+
+uint64_t HashBenchProject(const SnapshotBenchProject& project) {
+    uint64_t hash = 1469598103934665603ull;
+    for (const SnapshotBenchScene& scene : project.scenes) {
+        hash = HashSnapshotText(HashSnapshotText(HashSnapshotText(hash, scene.name), scene.description), scene.shaderCode);
+        for (const auto& effect : scene.postFx) {
+            hash = HashSnapshotText(HashSnapshotText(hash, effect.first), effect.second);
+        }
+        for (const auto& effect : scene.compute) {
+            hash = HashSnapshotText(HashSnapshotText(hash, effect.first), effect.second);
+        }
+        hash = HashSnapshotText(hash, std::to_string(scene.bindings.size()));
+    }
+    for (const ShaderLab::TrackerRow& row : project.rows) {
+        hash = HashSnapshotText(hash, std::to_string(row.sceneIndex) + "/" + std::to_string(row.musicIndex) + "/" +
+                                          std::to_string(row.timeOffset) + row.transitionPresetStem);
+    }
+    return HashSnapshotText(hash, project.settings.demoTitle);
+}
+
+uint64_t HashSnapshot(const ShaderLab::ProjectSnapshot& snapshot, const ShaderLab::ProjectSettingsDoc& settings) {
+    // Materialize the snapshot back into a working copy, like an undo does.
+    SnapshotBenchProject project;
+    for (size_t i = 0; i < snapshot.scenes.size(); ++i) {
+        const ShaderLab::SceneDoc& doc = *snapshot.scenes[i];
+        SnapshotBenchScene scene;
+        scene.name = doc.name;
+        scene.description = doc.description;
+        scene.shaderCode = *doc.shaderCode;
+        scene.bindings = *doc.bindings;
+        for (const auto& effect : *doc.postFxChain) {
+            scene.postFx.emplace_back(effect.name, *effect.shaderCode);
+        }
+        for (const auto& effect : *doc.computeChain) {
+            scene.compute.emplace_back(effect.name, *effect.shaderCode);
+        }
+        project.scenes.push_back(std::move(scene));
+    }
+    project.rows.Assign(snapshot.trackRows.ToVector());
+    project.settings = snapshot.settings ? *snapshot.settings : settings;
+    return HashBenchProject(project);
+}
+
+} // namespace
+
+int RunSnapshotBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    using Clock = std::chrono::steady_clock;
+    const int sceneCount = options.snapshotScenes > 0 ? options.snapshotScenes : 200;
+    uint32_t state = options.seed ? options.seed : 1u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+    auto makeCode = [&](size_t lines) {
+        std::string code;
+        for (size_t i = 0; i < lines; ++i) {
+            code += "    float v" + std::to_string(i) + " = sin(uv.x * " + std::to_string(next() % 1000) + ".0 + iTime);\n";
+        }
+        return code;
+    };
+
+    SnapshotBenchProject project;
+    for (int i = 0; i < sceneCount; ++i) {
+        SnapshotBenchScene scene;
+        scene.name = "Scene " + std::to_string(i);
+        scene.description = "Generated scene for the snapshot benchmark";
+        scene.shaderCode = makeCode(80 + next() % 160); // roughly 4-12 KB
+        scene.shaderCodePath = "scenes/scene_" + std::to_string(i) + ".hlsl";
+        for (int b = 0; b < 2; ++b) {
+            BindingDoc binding;
+            binding.channelIndex = b;
+            binding.enabled = b == 0;
+            binding.sourceSceneIndex = (i + 1) % sceneCount;
+            scene.bindings.push_back(binding);
+        }
+        for (int fx = 0; fx < static_cast<int>(next() % 3); ++fx) {
+            scene.postFx.emplace_back("Post " + std::to_string(fx), makeCode(30));
+        }
+        if (i % 4 == 0) {
+            scene.compute.emplace_back("Trails", makeCode(40));
+        }
+        project.scenes.push_back(std::move(scene));
+    }
+    for (int row = 0; row < 4096; ++row) {
+        TrackerRow trackerRow;
+        trackerRow.rowId = row;
+        trackerRow.sceneIndex = row % 8 == 0 ? static_cast<int>(next() % static_cast<uint32_t>(sceneCount)) : -1;
+        project.rows.Insert(trackerRow);
+    }
+    for (int clip = 0; clip < 8; ++clip) {
+        project.audio.push_back(AudioClip{"clip " + std::to_string(clip), "audio/clip_" + std::to_string(clip) + ".wav", AudioType::Music, 120.0f});
+    }
+    project.settings.demoTitle = "Snapshot bench";
+
+    // Baseline: what CaptureState did, a deep copy of the whole document.
+    constexpr int kCopyRuns = 20;
+    auto start = Clock::now();
+    size_t checksum = 0;
+    for (int run = 0; run < kCopyRuns; ++run) {
+        SnapshotBenchProject copy = project;
+        checksum += copy.scenes.back().shaderCode.size();
+    }
+    const double deepCopyUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / kCopyRuns;
+
+    ProjectHistory history(static_cast<size_t>(options.snapshotEdits) + 16);
+    start = Clock::now();
+    history.Push(CaptureBenchSnapshot(project, nullptr));
+    const double fullCaptureUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    const size_t fullBytes = history.MeasureBytes();
+    std::vector<uint64_t> levelHashes = { HashBenchProject(project) };
+
+    int errors = 0;
+    // Nothing changed: the capture must share the whole project and not add a level.
+    if (history.Push(CaptureBenchSnapshot(project, history.Current()))) {
+        ++errors;
+    }
+
+    double captureUs = 0.0;
+    double maxCaptureUs = 0.0;
+    size_t editedBytes = 0;
+    for (int edit = 0; edit < options.snapshotEdits; ++edit) {
+        const uint32_t kind = next() % 10;
+        SnapshotBenchScene& scene = project.scenes[next() % project.scenes.size()];
+        if (kind < 6) {
+            scene.shaderCode += "    // tweak " + std::to_string(edit) + "\n";
+            editedBytes += scene.shaderCode.size();
+        } else if (kind < 8) {
+            TrackerRow& row = project.rows[next() % project.rows.size()];
+            row.sceneIndex = static_cast<int>(next() % static_cast<uint32_t>(sceneCount));
+            row.timeOffset += 0.25f;
+        } else if (kind < 9 && !scene.postFx.empty()) {
+            scene.postFx[0].second += "// fx " + std::to_string(edit) + "\n";
+            editedBytes += scene.postFx[0].second.size();
+        } else {
+            scene.name += "*";
+        }
+
+        const auto captureStart = Clock::now();
+        ProjectSnapshot snapshot = CaptureBenchSnapshot(project, history.Current());
+        const double us = std::chrono::duration<double, std::micro>(Clock::now() - captureStart).count();
+        captureUs += us;
+        maxCaptureUs = (std::max)(maxCaptureUs, us);
+
+        // One edit touches one scene node: every other chunk of the scene table is shared.
+        size_t sharedChunks = 0;
+        const auto* before = history.Current()->scenes.GetTable();
+        const auto* after = snapshot.scenes.GetTable();
+        for (size_t c = 0; before && after && c < before->size() && c < after->size(); ++c) {
+            sharedChunks += (*before)[c] == (*after)[c] ? 1u : 0u;
+        }
+        if (after && sharedChunks + 1 < after->size()) {
+            ++errors;
+        }
+        if (history.Push(std::move(snapshot))) {
+            levelHashes.push_back(HashBenchProject(project));
+        }
+    }
+
+    const size_t historyBytes = history.MeasureBytes();
+    const size_t levels = history.GetLevelCount();
+
+    // Walk every level down and back up; each must materialize to exactly what was captured.
+    size_t level = levels - 1;
+    for (;;) {
+        if (HashSnapshot(*history.Current(), project.settings) != levelHashes[level]) {
+            ++errors;
+        }
+        if (!history.Undo()) {
+            break;
+        }
+        --level;
+    }
+    while (history.Redo()) {
+        ++level;
+    }
+    if (level != levels - 1 || HashSnapshot(*history.Current(), project.settings) != HashBenchProject(project)) {
+        ++errors;
+    }
+
+    // Hundreds of levels should cost the edits plus per-level chunk overhead, not copies.
+    const size_t perLevelOverhead = 4096;
+    if (historyBytes > fullBytes + editedBytes + levels * perLevelOverhead) {
+        ++errors;
+    }
+    const double avgCaptureUs = options.snapshotEdits > 0 ? captureUs / options.snapshotEdits : 0.0;
+    std::printf("snapshot: scenes=%d rows=%zu project_bytes=%zu deep_copy_us=%.1f full_capture_us=%.1f (checksum %zu)\n",
+                sceneCount, project.rows.size(), fullBytes, deepCopyUs, fullCaptureUs, checksum % 10);
+    std::printf("edits=%d levels=%zu capture_avg_us=%.1f capture_max_us=%.1f edited_bytes=%zu\n",
+                options.snapshotEdits, levels, avgCaptureUs, maxCaptureUs, editedBytes);
+    std::printf("history_bytes=%zu deep_copy_history_bytes=%zu ratio=%.3f errors=%d\n",
+                historyBytes, fullBytes * levels,
+                static_cast<double>(historyBytes) / static_cast<double>((std::max)(fullBytes * levels, static_cast<size_t>(1))),
+                errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
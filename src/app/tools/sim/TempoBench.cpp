@@ -0,0 +1,147 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/TempoAnalyzer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+// Click track: a pickup beat, then bars whose downbeat adds a low thump to the click.
+std::vector<float> MakeClickTrack(float bpm, float downbeatSeconds, float seconds, uint32_t sampleRate, uint32_t seed) {
+    std::vector<float> samples(static_cast<size_t>(seconds * sampleRate));
+    const double beatSeconds = 60.0 / bpm;
+    const double pi = 3.14159265358979323846;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        samples[i] = 0.01f * (static_cast<float>(seed >> 8) / 8388608.0f - 1.0f);
+    }
+    int beat = downbeatSeconds >= beatSeconds ? -1 : 0;
+    for (double t = downbeatSeconds + beat * beatSeconds; t < seconds; t += beatSeconds, ++beat) {
+        const bool downbeat = ((beat % 4) + 4) % 4 == 0;
+        const size_t first = static_cast<size_t>(t * sampleRate);
+        const size_t length = (std::min)(samples.size() - (std::min)(first, samples.size()), static_cast<size_t>(sampleRate / 20u));
+        for (size_t i = 0; i < length; ++i) {
+            const double time = static_cast<double>(i) / sampleRate;
+            double value = 0.3 * std::sin(2.0 * pi * 2000.0 * time) * std::exp(-time * 150.0);
+            if (downbeat) {
+                value += 0.6 * std::sin(2.0 * pi * 60.0 * time) * std::exp(-time * 30.0);
+            }
+            samples[first + i] += static_cast<float>(value);
+        }
+    }
+    return samples;
+}
+
+int RunTempoBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    const uint32_t sampleRate = 44100;
+    int errors = 0;
+    std::string error;
+
+    struct Case {
+        float bpm;
+        float downbeat;
+    };
+    const Case cases[] = { { 87.0f, 0.37f }, { 100.0f, 1.9f }, { 120.0f, 0.05f }, { 128.0f, 0.81f },
+                           { 140.0f, 1.2f }, { 174.0f, 0.6f } };
+    for (const Case& test : cases) {
+        const std::vector<float> track = MakeClickTrack(test.bpm, test.downbeat, 60.0f, sampleRate, 11u);
+        TempoAnalysisOptions tempoOptions;
+        TempoAnalysisResult result;
+        if (!AnalyzeTempo(track.data(), track.size(), sampleRate, tempoOptions, result, error)) {
+            std::printf("tempo %.1f failed: %s\n", test.bpm, error.c_str());
+            ++errors;
+            continue;
+        }
+        const float beatError = std::fabs(result.beatOffset - test.downbeat);
+        if (std::fabs(result.bpm - test.bpm) > 0.05f || beatError > 0.012f || result.confidence < 0.5f) {
+            ++errors;
+        }
+        std::printf("tempo %5.1f: bpm=%.3f downbeat=%.3f (expected %.3f) first_beat=%.3f confidence=%.2f\n", test.bpm,
+                    result.bpm, result.beatOffset, test.downbeat, result.firstBeat, result.confidence);
+    }
+
+    // A full-length track: timing, and the worker count must not change the answer.
+    {
+        const float seconds = options.tempoSeconds > 0 ? static_cast<float>(options.tempoSeconds) : 300.0f;
+        const std::vector<float> track = MakeClickTrack(123.4f, 0.52f, seconds, sampleRate, 5u);
+        TempoAnalysisOptions tempoOptions;
+        TempoAnalysisResult parallel;
+        TempoAnalysisResult serial;
+        AnalyzeTempo(track.data(), track.size(), sampleRate, tempoOptions, parallel, error);
+        tempoOptions.workerCount = 1;
+        AnalyzeTempo(track.data(), track.size(), sampleRate, tempoOptions, serial, error);
+        if (parallel.bpm != serial.bpm || parallel.beatOffset != serial.beatOffset || std::fabs(parallel.bpm - 123.4f) > 0.02f) {
+            ++errors;
+        }
+        const unsigned hardware = (std::max)(1u, std::thread::hardware_concurrency());
+        std::printf("track %.0f s: bpm=%.3f workers=%u %.1f ms (onsets %.1f, tempo %.1f) serial %.1f ms\n", seconds,
+                    parallel.bpm, hardware, parallel.onsetMs + parallel.tempoMs, parallel.onsetMs, parallel.tempoMs,
+                    serial.onsetMs + serial.tempoMs);
+    }
+
+    // Too short to hold enough beats; cache round trip keyed by file hash.
+    {
+        const std::vector<float> blip = MakeClickTrack(120.0f, 0.1f, 2.0f, sampleRate, 3u);
+        TempoAnalysisResult result;
+        if (AnalyzeTempo(blip.data(), blip.size(), sampleRate, TempoAnalysisOptions(), result, error)) {
+            ++errors;
+        }
+
+        const std::string bytesA = "RIFF fake clip A";
+        const std::string bytesB = "RIFF fake clip B";
+        const uint64_t hashA = HashTempoSource(bytesA.data(), bytesA.size());
+        const uint64_t hashB = HashTempoSource(bytesB.data(), bytesB.size());
+        TempoAnalysisCache cache;
+        result.bpm = 128.0f;
+        result.beatOffset = 0.25f;
+        result.confidence = 0.9f;
+        cache.Store(hashA, result);
+        const std::string path = (std::filesystem::temp_directory_path() / "shaderlab_tempo_cache.txt").string();
+        TempoAnalysisCache reloaded;
+        TempoAnalysisResult found;
+        // Detections that finish together save from their own workers.
+        cache.Store(hashB, result);
+        std::atomic<bool> saved{ true };
+        std::vector<std::thread> savers;
+        for (int t = 0; t < 4; ++t) {
+            savers.emplace_back([&cache, &path, &saved]() {
+                std::string saveError;
+                for (int i = 0; i < 20; ++i) {
+                    if (!cache.Save(path, saveError)) {
+                        saved = false;
+                    }
+                }
+            });
+        }
+        for (std::thread& saver : savers) {
+            saver.join();
+        }
+        const bool loaded = reloaded.Load(path, error);
+        std::filesystem::remove(path);
+        const bool leftTemp = std::filesystem::exists(path + ".tmp");
+        if (hashA == hashB || !saved || !loaded || leftTemp || reloaded.GetSize() != 2 || !reloaded.Find(hashA, found) ||
+            !reloaded.Find(hashB, found) || (reloaded.Find(hashA, found), found.bpm != 128.0f || found.beatOffset != 0.25f)) {
+            ++errors;
+        }
+        TempoAnalysisCache missing;
+        if (!missing.Load(path, error) || missing.GetSize() != 0) {
+            ++errors;
+        }
+    }
+
+    std::printf("tempo: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,133 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/TextSearch.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+// Shader-like source of `lines` lines; every line is distinct so matches land at known places.
+std::string MakeBenchShaderSource(int lines) {
+    static const char* const kBodies[] = {
+        "    float3 col = 0.5 + 0.5 * cos(iTime + uv.xyx + float3(0, 2, 4));",
+        "    float d = length(p) - 0.25; // distance to the sphere",
+        "    col = lerp(col, saturate(col * 1.5), step(0.0, d));",
+        "/* fold the domain */ p = abs(p) - float2(0.3, 0.2);",
+        "    uv = (fragCoord * 2.0 - iResolution.xy) / iResolution.y;",
+        "#define ITERATIONS 64",
+        "    return float4(col, 1.0);",
+    };
+    std::string text;
+    text.reserve(static_cast<size_t>(lines) * 64);
+    for (int i = 0; i < lines; ++i) {
+        text += kBodies[i % 7];
+        text += " // ";
+        text += std::to_string(i);
+        text += '\n';
+    }
+    return text;
+}
+
+int RunTextBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    using Clock = std::chrono::steady_clock;
+    int errors = 0;
+    uint32_t state = options.seed ? options.seed : 1u;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+
+    // Random needles and offsets against std::string::find, including misses and buffer tails.
+    {
+        const std::string text = MakeBenchShaderSource(400);
+        int mismatches = 0;
+        for (int i = 0; i < 20000; ++i) {
+            const size_t start = next() % text.size();
+            const size_t length = 1 + next() % 24;
+            std::string needle = text.substr(start, length);
+            if (i % 5 == 0) {
+                needle.back() = '#';
+            }
+            const size_t from = next() % (text.size() + 2);
+            const size_t expected = text.find(needle, from);
+            const size_t found = FindText(text.data(), text.size(), needle.data(), needle.size(), from);
+            mismatches += found != expected ? 1 : 0;
+        }
+        const size_t tail = FindText(text.data(), text.size(), "// 399\n", 7);
+        mismatches += tail != text.size() - 7 ? 1 : 0;
+        errors += mismatches > 0 ? 1 : 0;
+        std::printf("find vs std::string::find: 20000 needles, mismatches=%d\n", mismatches);
+    }
+
+    std::vector<int> sizes;
+    if (options.textLines > 0) {
+        sizes.push_back(options.textLines);
+    } else {
+        sizes = { 10000, 100000 };
+    }
+    for (const int lines : sizes) {
+        const std::string text = MakeBenchShaderSource(lines);
+        const char* const needles[] = { "iResolution", "saturate(col", "// 4242\n" };
+
+        for (const char* needleText : needles) {
+            const std::string needle = needleText;
+            const int repeats = 20;
+            size_t countSimd = 0;
+            auto start = Clock::now();
+            for (int r = 0; r < repeats; ++r) {
+                countSimd = CountText(text.data(), text.size(), needle.data(), needle.size());
+            }
+            const double simdMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeats;
+            size_t countStd = 0;
+            start = Clock::now();
+            for (int r = 0; r < repeats; ++r) {
+                countStd = 0;
+                for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + needle.size())) {
+                    ++countStd;
+                }
+            }
+            const double stdMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / repeats;
+            errors += countSimd != countStd ? 1 : 0;
+            std::printf("%d lines, find all \"%s\": %zu matches, FindText %.3f ms, std::string::find %.3f ms\n", lines,
+                        needle[needle.size() - 1] == '\n' ? "// 4242\\n" : needleText, countSimd, simdMs, stdMs);
+        }
+
+        // Replace All: one pass vs the old replace-in-place loop, which moves the tail once per match.
+        const std::string needle = "iTime";
+        const std::string replacement = "iTimeSeconds";
+        std::string replaced;
+        auto start = Clock::now();
+        const size_t count = ReplaceAllText(text, needle, replacement, replaced);
+        const double onePassMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const bool sizeOk = replaced.size() == text.size() + count * (replacement.size() - needle.size());
+        errors += !sizeOk || count != static_cast<size_t>((lines + 6) / 7) ? 1 : 0;
+        if (lines <= 20000) {
+            std::string looped = text;
+            start = Clock::now();
+            size_t pos = 0;
+            while ((pos = looped.find(needle, pos)) != std::string::npos) {
+                looped.replace(pos, needle.size(), replacement);
+                pos += replacement.size();
+            }
+            const double loopMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            errors += looped != replaced ? 1 : 0;
+            std::printf("%d lines, replace all %zu: one pass %.2f ms, replace loop %.2f ms, same=%d\n", lines, count,
+                        onePassMs, loopMs, looped == replaced ? 1 : 0);
+        } else {
+            std::printf("%d lines, replace all %zu: one pass %.2f ms (replace loop skipped, quadratic)\n", lines, count,
+                        onePassMs);
+        }
+    }
+
+    std::printf("text: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
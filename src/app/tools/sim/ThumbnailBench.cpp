@@ -0,0 +1,216 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
+#include "ShaderLab/Core/ThumbnailCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+int RunThumbnailBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    int errors = 0;
+    const int shaderCount = options.thumbnailShaders > 0 ? options.thumbnailShaders : 200;
+    constexpr float kThumbnailTime = 2.0f;
+
+    const fs::path root = fs::temp_directory_path() / ("shaderlab_thumbnail_bench_" + std::to_string(options.seed));
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    fs::create_directories(root, ec);
+    const std::string cachePath = (root / "thumbnails.slthumb").string();
+
+    ThumbnailAtlasDesc desc;
+    const uint32_t cellW = desc.cellWidth;
+    const uint32_t cellH = desc.cellHeight;
+    const uint32_t readbackPitch = 256 * ((cellW * 4 + 255) / 256); // D3D12 row alignment
+    // Stands in for the GPU render: a pattern derived from the key, written with padded rows.
+    auto render = [&](uint64_t key, std::vector<uint8_t>& out) {
+        out.assign(static_cast<size_t>(readbackPitch) * cellH, 0);
+        for (uint32_t y = 0; y < cellH; ++y) {
+            for (uint32_t x = 0; x < cellW; ++x) {
+                uint8_t* p = out.data() + static_cast<size_t>(y) * readbackPitch + x * 4u;
+                p[0] = static_cast<uint8_t>(key >> 8) ^ static_cast<uint8_t>(x);
+                p[1] = static_cast<uint8_t>(key >> 16) ^ static_cast<uint8_t>(y);
+                p[2] = static_cast<uint8_t>(key >> 24);
+                p[3] = 255;
+            }
+        }
+    };
+    auto cellMatches = [&](const ThumbnailCache& cache, const ThumbnailSlot& slot, uint64_t key) {
+        std::vector<uint8_t> expected;
+        render(key, expected);
+        const std::vector<uint8_t>& page = cache.GetPagePixels(slot.page);
+        const size_t pagePitch = static_cast<size_t>(cache.GetPageWidth()) * 4u;
+        for (uint32_t y = 0; y < cellH; ++y) {
+            if (std::memcmp(page.data() + (slot.y + y) * pagePitch + slot.x * 4u,
+                            expected.data() + static_cast<size_t>(y) * readbackPitch, cellW * 4u) != 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<std::string> sources;
+    for (int i = 0; i < shaderCount; ++i) {
+        sources.push_back(MakeBenchShaderSource(40) + "// preset " + std::to_string(i) + "\n");
+    }
+    std::vector<uint64_t> keys(sources.size());
+    auto rekey = [&]() {
+        for (size_t i = 0; i < sources.size(); ++i) {
+            keys[i] = MakeThumbnailKey(HashShaderText(sources[i]), cellW, cellH, kThumbnailTime);
+        }
+    };
+    rekey();
+
+    // One pass over the browse list the way the editor draws it: a hit is drawn, a miss is rendered.
+    std::vector<uint8_t> pixels;
+    auto browse = [&](ThumbnailCache& cache) {
+        int renders = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            ThumbnailSlot slot;
+            if (cache.Find(keys[i], slot)) {
+                continue;
+            }
+            render(keys[i], pixels);
+            if (!cache.Insert(keys[i], pixels.data(), readbackPitch, slot) || !cellMatches(cache, slot, keys[i])) {
+                ++errors;
+            }
+            ++renders;
+        }
+        return renders;
+    };
+
+    {
+        ThumbnailCache cache(desc);
+        std::string error;
+        errors += cache.Load(cachePath, error) ? 1 : 0; // No file yet
+        const auto start = Clock::now();
+        const int firstRenders = browse(cache);
+        const double firstMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        const int secondRenders = browse(cache);
+        const ThumbnailCacheStats stats = cache.GetStats();
+        const size_t capacity = static_cast<size_t>(desc.columns) * desc.rows * desc.maxPages;
+        std::printf("first browse: %d renders (%.2f ms CPU); second: %d renders; entries=%zu pages=%zu evictions=%llu\n",
+                    firstRenders, firstMs, secondRenders, stats.entries, cache.GetPageCount(),
+                    static_cast<unsigned long long>(stats.evictions));
+        errors += firstRenders == shaderCount ? 0 : 1;
+        // A list larger than the atlas thrashes by design; one that fits renders nothing twice.
+        if (static_cast<size_t>(shaderCount) <= capacity) {
+            errors += secondRenders == 0 ? 0 : 1;
+            errors += stats.evictions == 0 ? 0 : 1;
+        } else {
+            errors += stats.entries == capacity ? 0 : 1;
+        }
+
+        const auto saveStart = Clock::now();
+        if (!cache.Save(cachePath, error)) {
+            std::printf("save failed: %s\n", error.c_str());
+            ++errors;
+        }
+        const double saveMs = std::chrono::duration<double, std::milli>(Clock::now() - saveStart).count();
+        std::printf("save: %.2f ms, %llu KiB on disk\n", saveMs,
+                    static_cast<unsigned long long>(fs::file_size(cachePath, ec) / 1024));
+        errors += cache.IsDirty() ? 1 : 0;
+    }
+
+    {
+        // Restart: the same list renders only what is not on disk, then only edited shaders.
+        ThumbnailCache cache(desc);
+        std::string error;
+        const auto loadStart = Clock::now();
+        if (!cache.Load(cachePath, error)) {
+            std::printf("load failed: %s\n", error.c_str());
+            ++errors;
+        }
+        const double loadMs = std::chrono::duration<double, std::milli>(Clock::now() - loadStart).count();
+        const size_t loaded = cache.GetStats().entries;
+        int verified = 0;
+        for (uint64_t key : keys) {
+            ThumbnailSlot slot;
+            if (cache.Contains(key) && cache.Find(key, slot)) {
+                errors += cellMatches(cache, slot, key) ? 0 : 1;
+                ++verified;
+            }
+        }
+        errors += static_cast<size_t>(verified) == loaded ? 0 : 1;
+        const int restartRenders = browse(cache);
+        std::printf("load: %.2f ms, %zu thumbnails; restart browse: %d renders\n", loadMs, loaded, restartRenders);
+        if (static_cast<size_t>(shaderCount) <= static_cast<size_t>(desc.columns) * desc.rows * desc.maxPages) {
+            errors += restartRenders == 0 ? 0 : 1;
+        }
+
+        const int edited = (std::max)(1, shaderCount / 20);
+        for (int i = 0; i < edited; ++i) {
+            sources[(i * 7) % sources.size()] += "// edited\n";
+        }
+        rekey();
+        const int editRenders = browse(cache);
+        std::printf("after editing %d shaders: %d renders\n", edited, editRenders);
+        if (static_cast<size_t>(shaderCount) <= static_cast<size_t>(desc.columns) * desc.rows * desc.maxPages) {
+            errors += editRenders == edited ? 0 : 1;
+        }
+
+        ThumbnailSlot slot;
+        const int finds = 200000;
+        const auto findStart = Clock::now();
+        uint64_t found = 0;
+        for (int i = 0; i < finds; ++i) {
+            found += cache.Find(keys[static_cast<size_t>(i) % keys.size()], slot) ? 1 : 0;
+        }
+        const double findNs = std::chrono::duration<double, std::nano>(Clock::now() - findStart).count() / finds;
+        std::printf("Find: %.0f ns per lookup (%llu hits)\n", findNs, static_cast<unsigned long long>(found));
+    }
+
+    {
+        // LRU: with a one-page atlas, thumbnails drawn recently survive a flood of new ones.
+        ThumbnailAtlasDesc small = desc;
+        small.columns = 4;
+        small.rows = 2;
+        small.maxPages = 1;
+        ThumbnailCache cache(small);
+        ThumbnailSlot slot;
+        for (uint64_t key = 1; key <= 8; ++key) {
+            render(key, pixels);
+            errors += cache.Insert(key, pixels.data(), readbackPitch, slot) ? 0 : 1;
+        }
+        const uint64_t revisionBefore = cache.GetPageRevision(0);
+        errors += cache.Find(2, slot) && cache.Find(5, slot) ? 0 : 1;
+        for (uint64_t key = 100; key < 106; ++key) {
+            render(key, pixels);
+            errors += cache.Insert(key, pixels.data(), readbackPitch, slot) ? 0 : 1;
+            errors += slot.revision > revisionBefore ? 0 : 1;
+        }
+        errors += cache.Contains(2) && cache.Contains(5) && !cache.Contains(1) && !cache.Contains(8) ? 0 : 1;
+        errors += cache.GetStats().evictions == 6 ? 0 : 1;
+        errors += cache.GetPageCount() == 1 ? 0 : 1;
+
+        // Files from another layout or with flipped bits are rejected and leave the cache empty.
+        std::vector<uint8_t> data;
+        cache.Serialize(data);
+        std::string error;
+        ThumbnailCache other(desc);
+        errors += other.Deserialize(data.data(), data.size(), error) ? 1 : 0;
+        data[data.size() / 2] ^= 0x40u;
+        ThumbnailCache same(small);
+        errors += same.Deserialize(data.data(), data.size(), error) ? 1 : 0;
+        errors += same.GetStats().entries == 0 ? 0 : 1;
+        errors += same.Deserialize(data.data(), data.size() - 1, error) ? 1 : 0;
+    }
+
+    fs::remove_all(root, ec);
+    std::printf("thumbnail: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
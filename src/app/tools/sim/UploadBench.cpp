@@ -0,0 +1,339 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/TextureUploadQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+namespace {
+
+// Fake GPU for TextureUploadQueue: a batch completes `latency` ticks after its submit, and only
+// then are its copies read out of staging, so a ring slot reused too early shows up as corrupt
+// texels.
+class FakeTextureUploadBackend : public ShaderLab::ITextureUploadBackend {
+public:
+    FakeTextureUploadBackend(uint64_t stagingBytes, uint64_t latency) : m_staging(stagingBytes), m_latency(latency) {}
+
+    uint8_t* GetStagingMemory() override { return m_staging.data(); }
+    uint64_t GetStagingCapacity() const override { return m_staging.size(); }
+    bool ResizeStaging(uint64_t capacityBytes) override {
+        if (!m_batches.empty()) {
+            return false;
+        }
+        m_staging.assign(capacityBytes, 0);
+        return true;
+    }
+
+    ShaderLab::TextureStagingFootprint GetFootprint(uint32_t width, uint32_t height) override {
+        ShaderLab::TextureStagingFootprint footprint;
+        footprint.rowPitch = (width * 4u + 255u) & ~255u;
+        footprint.totalBytes = static_cast<uint64_t>(footprint.rowPitch) * (height - 1u) + width * 4u;
+        footprint.alignment = 512;
+        return footprint;
+    }
+
+    bool RecordUpload(uint64_t ticket, uint32_t width, uint32_t height, uint64_t stagingOffset,
+                      const ShaderLab::TextureStagingFootprint& footprint, std::string& outError) override {
+        if (stagingOffset % footprint.alignment != 0 || stagingOffset + footprint.totalBytes > m_staging.size()) {
+            outError = "Copy outside of staging.";
+            return false;
+        }
+        m_open.push_back({ ticket, width, height, stagingOffset, footprint.rowPitch });
+        return true;
+    }
+
+    void SubmitBatch(uint64_t batchIndex) override {
+        if (batchIndex != m_submittedBatches) {
+            ++m_orderErrors;
+        }
+        m_batches.push_back({ batchIndex, m_tick + m_latency, std::move(m_open) });
+        m_open.clear();
+        ++m_submittedBatches;
+    }
+
+    int64_t GetCompletedBatch() override {
+        while (!m_batches.empty() && m_batches.front().completeTick <= m_tick) {
+            Complete(m_batches.front());
+            m_completed = static_cast<int64_t>(m_batches.front().index);
+            m_batches.pop_front();
+        }
+        return m_completed;
+    }
+
+    void ReleaseTexture(uint64_t ticket) override {
+        m_released.push_back(ticket);
+        m_textures.erase(ticket);
+    }
+
+    void Tick() { ++m_tick; }
+    void WaitForBatch(uint64_t batchIndex) {
+        while (m_completed < static_cast<int64_t>(batchIndex)) {
+            ++m_tick;
+            GetCompletedBatch();
+        }
+    }
+
+    const std::vector<uint8_t>* FindTexture(uint64_t ticket) const {
+        auto it = m_textures.find(ticket);
+        return it != m_textures.end() ? &it->second : nullptr;
+    }
+    const std::vector<uint64_t>& GetReleased() const { return m_released; }
+    uint64_t GetSubmittedBatches() const { return m_submittedBatches; }
+    int GetOrderErrors() const { return m_orderErrors; }
+
+private:
+    struct Copy {
+        uint64_t ticket;
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;
+        uint32_t rowPitch;
+    };
+    struct Batch {
+        uint64_t index;
+        uint64_t completeTick;
+        std::vector<Copy> copies;
+    };
+
+    void Complete(const Batch& batch) {
+        for (const Copy& copy : batch.copies) {
+            std::vector<uint8_t>& texels = m_textures[copy.ticket];
+            const size_t rowBytes = static_cast<size_t>(copy.width) * 4u;
+            texels.resize(rowBytes * copy.height);
+            for (uint32_t y = 0; y < copy.height; ++y) {
+                std::memcpy(texels.data() + rowBytes * y, m_staging.data() + copy.offset + static_cast<size_t>(y) * copy.rowPitch,
+                            rowBytes);
+            }
+        }
+    }
+
+    std::vector<uint8_t> m_staging;
+    uint64_t m_latency;
+    uint64_t m_tick = 0;
+    int64_t m_completed = -1;
+    uint64_t m_submittedBatches = 0;
+    int m_orderErrors = 0;
+    std::vector<Copy> m_open;
+    std::deque<Batch> m_batches;
+    std::unordered_map<uint64_t, std::vector<uint8_t>> m_textures;
+    std::vector<uint64_t> m_released;
+};
+
+// Synthetic image names: "img_<seed>_<w>x<h>"; anything else fails to decode.
+bool ParseUploadBenchName(const std::string& path, uint32_t& outSeed, uint32_t& outWidth, uint32_t& outHeight) {
+    unsigned seed = 0;
+    unsigned width = 0;
+    unsigned height = 0;
+    if (std::sscanf(path.c_str(), "img_%u_%ux%u", &seed, &width, &height) != 3 || width == 0 || height == 0) {
+        return false;
+    }
+    outSeed = seed;
+    outWidth = width;
+    outHeight = height;
+    return true;
+}
+
+void FillUploadBenchImage(uint32_t seed, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    out.resize(static_cast<size_t>(width) * height * 4u);
+    uint32_t state = seed * 2654435761u + 1u;
+    for (uint8_t& value : out) {
+        state = state * 1664525u + 1013904223u;
+        value = static_cast<uint8_t>(state >> 24);
+    }
+}
+
+std::string UploadBenchName(uint32_t index) {
+    // Mostly small tiles with the odd large texture, like a typical project.
+    const uint32_t sizes[] = { 64, 128, 256, 256, 512, 100, 1024, 333 };
+    const uint32_t width = sizes[index % 8u];
+    const uint32_t height = sizes[(index * 5u + 3u) % 8u];
+    return "img_" + std::to_string(index + 1u) + "_" + std::to_string(width) + "x" + std::to_string(height);
+}
+
+bool VerifyUploadBenchTexture(const FakeTextureUploadBackend& backend, const ShaderLab::TextureUploadResult& result) {
+    uint32_t seed = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    const std::vector<uint8_t>* texels = backend.FindTexture(result.ticket);
+    if (!result.success || !texels || !ParseUploadBenchName(result.path, seed, width, height) ||
+        result.width != width || result.height != height) {
+        return false;
+    }
+    std::vector<uint8_t> expected;
+    FillUploadBenchImage(seed, width, height, expected);
+    return *texels == expected;
+}
+
+} // namespace
+
+int RunUploadBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    using Clock = std::chrono::steady_clock;
+    const uint32_t textureCount = options.uploadTextures > 0 ? static_cast<uint32_t>(options.uploadTextures) : 64u;
+    const double decodeMs = options.loadMs;
+    const double gpuMs = options.gpuMs;
+    const double frameMs = 1000.0 / (std::max)(1.0, options.fps);
+    const uint64_t latencyFrames = 2;
+    int errors = 0;
+
+    std::atomic<uint64_t> decodeCalls{ 0 };
+    auto decoder = [&](const std::string& path, DecodedImage& outImage, std::string& outError) {
+        ++decodeCalls;
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(decodeMs));
+        uint32_t seed = 0;
+        if (!ParseUploadBenchName(path, seed, outImage.width, outImage.height)) {
+            outError = "Missing file " + path;
+            return false;
+        }
+        FillUploadBenchImage(seed, outImage.width, outImage.height, outImage.rgba);
+        return true;
+    };
+
+    // Old path: decode on the render thread, then a dedicated queue and a blocking wait per file.
+    auto start = Clock::now();
+    for (uint32_t i = 0; i < textureCount; ++i) {
+        DecodedImage image;
+        std::string error;
+        decoder(UploadBenchName(i), image, error);
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(gpuMs));
+    }
+    const double serialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    decodeCalls = 0;
+
+    // New path: the frame loop keeps running while textures stream in.
+    const uint64_t stagingBytes = 16ull * 1024ull * 1024ull;
+    FakeTextureUploadBackend backend(stagingBytes, latencyFrames);
+    const unsigned workers = TextureUploadQueue::DefaultWorkerCount();
+    uint64_t missingTicket = 0;
+    uint64_t canceledQueued = 0;
+    std::vector<uint64_t> tickets;
+    std::vector<TextureUploadResult> results;
+    double maxUpdateMs = 0.0;
+    int frames = 0;
+    uint64_t staged = 0;
+    TextureUploadStats stats;
+    {
+        TextureUploadQueue queue(&backend, decoder, workers);
+        queue.SetBatchByteBudget(8ull * 1024ull * 1024ull);
+        start = Clock::now();
+        for (uint32_t i = 0; i < textureCount; ++i) {
+            tickets.push_back(queue.RequestFile(UploadBenchName(i)));
+        }
+        missingTicket = queue.RequestFile("missing.png");
+        canceledQueued = queue.RequestFile(UploadBenchName(textureCount));
+        queue.Cancel(canceledQueued);
+
+        while (queue.GetPendingCount() > 0 && frames < 100000) {
+            backend.Tick();
+            const auto updateStart = Clock::now();
+            queue.Update(results);
+            maxUpdateMs = (std::max)(maxUpdateMs,
+                                     std::chrono::duration<double, std::milli>(Clock::now() - updateStart).count());
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(frameMs));
+            ++frames;
+        }
+        stats = queue.GetStats();
+        staged = queue.GetStagingPeakUsed();
+    }
+    const double asyncMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    size_t delivered = 0;
+    bool missingFailed = false;
+    for (const TextureUploadResult& result : results) {
+        if (result.ticket == missingTicket) {
+            missingFailed = !result.success && !result.error.empty();
+            continue;
+        }
+        if (result.ticket == canceledQueued || !VerifyUploadBenchTexture(backend, result)) {
+            ++errors;
+            continue;
+        }
+        ++delivered;
+    }
+    if (delivered != textureCount || !missingFailed || backend.GetOrderErrors() != 0 ||
+        stats.batches != backend.GetSubmittedBatches() || stats.batches > static_cast<uint64_t>(frames) ||
+        staged > stagingBytes || decodeCalls.load() != textureCount + 1u) {
+        ++errors;
+    }
+
+    // Tight ring: uploads wait for retired space, a texture larger than the ring grows it once,
+    // and cancels after staging release the texture instead of delivering it.
+    TextureUploadStats tightStats;
+    {
+        FakeTextureUploadBackend tight(1024u * 1024u, latencyFrames);
+        TextureUploadQueue queue(&tight, decoder, 0);
+        std::vector<TextureUploadResult> tightResults;
+        std::vector<uint64_t> tightTickets;
+        for (uint32_t i = 0; i < 12; ++i) {
+            tightTickets.push_back(queue.RequestFile("img_" + std::to_string(100 + i) + "_256x256"));
+        }
+        const uint64_t large = queue.RequestFile("img_200_1024x1024");
+        DecodedImage inMemory;
+        FillUploadBenchImage(300, 17, 3, inMemory.rgba);
+        inMemory.width = 17;
+        inMemory.height = 3;
+        const uint64_t memoryTicket = queue.RequestImage(std::move(inMemory), "img_300_17x3");
+
+        tight.Tick();
+        queue.Update(tightResults);
+        const uint64_t stagedCanceled = tightTickets[0];
+        queue.Cancel(stagedCanceled);
+        queue.Flush([&](uint64_t batchIndex) { tight.WaitForBatch(batchIndex); }, tightResults);
+        tightStats = queue.GetStats();
+
+        size_t good = 0;
+        for (const TextureUploadResult& result : tightResults) {
+            if (result.ticket == stagedCanceled || !VerifyUploadBenchTexture(tight, result)) {
+                ++errors;
+                continue;
+            }
+            good += result.ticket == large || result.ticket == memoryTicket ? 0u : 1u;
+        }
+        if (good != tightTickets.size() - 1 || tightStats.stagingStalls == 0 || tightStats.stagingResizes != 1 ||
+            tight.GetReleased() != std::vector<uint64_t>{ stagedCanceled } || queue.GetPendingCount() != 0 ||
+            !tight.FindTexture(large) || !tight.FindTexture(memoryTicket)) {
+            ++errors;
+        }
+
+        // CancelAll drops everything outstanding, including already submitted uploads.
+        const uint64_t dropped = queue.RequestFile("img_400_64x64");
+        tight.Tick();
+        queue.Update(tightResults);
+        queue.RequestFile("img_401_64x64");
+        queue.CancelAll();
+        const size_t before = tightResults.size();
+        queue.Flush([&](uint64_t batchIndex) { tight.WaitForBatch(batchIndex); }, tightResults);
+        if (tightResults.size() != before || tight.FindTexture(dropped) || queue.GetPendingCount() != 0) {
+            ++errors;
+        }
+    }
+
+    std::printf("upload: textures=%u workers=%u decode_ms=%.1f gpu_ms=%.1f frame_ms=%.1f\n", textureCount, workers,
+                decodeMs, gpuMs, frameMs);
+    std::printf("serial: render_thread_blocked_ms=%.1f\n", serialMs);
+    std::printf("batched: total_ms=%.1f frames=%d max_update_ms=%.2f batches=%llu staged_mb=%.1f peak_staging_mb=%.1f stage_ms=%.1f\n",
+                asyncMs, frames, maxUpdateMs, static_cast<unsigned long long>(stats.batches),
+                static_cast<double>(stats.bytesStaged) / (1024.0 * 1024.0),
+                static_cast<double>(staged) / (1024.0 * 1024.0), stats.stageMs);
+    std::printf("tight_ring: batches=%llu stalls=%llu resizes=%llu canceled=%llu errors=%d\n",
+                static_cast<unsigned long long>(tightStats.batches), static_cast<unsigned long long>(tightStats.stagingStalls),
+                static_cast<unsigned long long>(tightStats.stagingResizes),
+                static_cast<unsigned long long>(tightStats.canceled), errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,229 @@
+#include "SimBenches.h"
+
+#include "ShaderLab/Core/WaveformPyramid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+namespace Sim {
+
+int RunWaveformBench(const SimOptions& options) {
+    using namespace ShaderLab;
+    const uint32_t sampleRate = 48000;
+    int errors = 0;
+    std::string error;
+
+    const float seconds = options.waveformSeconds > 0 ? static_cast<float>(options.waveformSeconds) : 300.0f;
+    std::vector<float> track = MakeClickTrack(128.0f, 0.4f, seconds, sampleRate, 9u);
+    // A slow swell so the levels differ along the track, plus samples past full scale.
+    for (size_t i = 0; i < track.size(); ++i) {
+        track[i] *= 0.5f + 0.5f * std::sin(static_cast<float>(i) / sampleRate * 0.37f);
+    }
+    track[track.size() / 3] = 1.5f;
+    track[track.size() / 2] = -2.0f;
+
+    // One shot with every worker, then streamed in random chunks on one worker: same pyramid.
+    WaveformBuildOptions buildOptions;
+    WaveformPyramid pyramid;
+    auto start = std::chrono::steady_clock::now();
+    if (!BuildWaveformPyramid(track.data(), track.size(), sampleRate, buildOptions, pyramid, error)) {
+        std::printf("build failed: %s\n", error.c_str());
+        return 1;
+    }
+    const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    WaveformPyramid streamed;
+    WaveformPyramidBuilder builder;
+    buildOptions.workerCount = 1;
+    builder.Begin(buildOptions, error);
+    uint32_t seed = 17u;
+    start = std::chrono::steady_clock::now();
+    for (size_t offset = 0; offset < track.size();) {
+        seed = seed * 1664525u + 1013904223u;
+        const size_t chunk = (std::min)(track.size() - offset, static_cast<size_t>(1 + (seed >> 8) % 9000u));
+        builder.Append(track.data() + offset, chunk);
+        offset += chunk;
+    }
+    builder.Finish(sampleRate, streamed, error);
+    const double streamMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    bool identical = streamed.GetLevelCount() == pyramid.GetLevelCount() && streamed.GetSampleCount() == track.size();
+    for (size_t level = 0; identical && level < pyramid.GetLevelCount(); ++level) {
+        const auto& a = pyramid.GetLevel(level);
+        const auto& b = streamed.GetLevel(level);
+        identical = a.size() == b.size() &&
+            std::equal(a.begin(), a.end(), b.begin(), [](const WaveformBucket& x, const WaveformBucket& y) {
+                return x.min == y.min && x.max == y.max && x.rms == y.rms;
+            });
+    }
+    if (!identical || pyramid.GetLevel(pyramid.GetLevelCount() - 1).size() != 1) {
+        ++errors;
+    }
+    size_t bucketCount = 0;
+    for (size_t level = 0; level < pyramid.GetLevelCount(); ++level) {
+        bucketCount += pyramid.GetLevel(level).size();
+    }
+    const unsigned hardware = (std::max)(1u, std::thread::hardware_concurrency());
+    std::printf("build %.0f s: levels=%zu buckets=%zu (%.0f KB) workers=%u %.1f ms, streamed serial %.1f ms identical=%d\n",
+                seconds, pyramid.GetLevelCount(), bucketCount, bucketCount * sizeof(WaveformBucket) / 1024.0, hardware,
+                buildMs, streamMs, identical ? 1 : 0);
+
+    // Columns must bound the samples they cover and stay within the buckets they overlap.
+    struct View {
+        double start;
+        double end;
+        uint32_t columns;
+    };
+    const View views[] = { { 0.0, seconds, 800 }, { 10.0, 10.5, 120 }, { 61.3, 61.31, 64 },
+                           { seconds * 0.5 - 2.0, seconds * 0.5 + 2.0, 300 }, { -1.0, 3.0, 200 },
+                           { seconds - 1.0, seconds + 1.0, 100 } };
+    std::vector<WaveformColumn> columns;
+    for (const View& view : views) {
+        columns.resize(view.columns);
+        pyramid.Query(view.start, view.end, view.columns, columns.data());
+        const double columnSamples = (view.end - view.start) * sampleRate / view.columns;
+        int bad = 0;
+        size_t valid = 0;
+        for (uint32_t c = 0; c < view.columns; ++c) {
+            const double begin = view.start * sampleRate + columnSamples * c;
+            const double end = begin + columnSamples;
+            const bool inside = end > 0.0 && begin < static_cast<double>(track.size());
+            if (columns[c].valid != inside) {
+                ++bad;
+                continue;
+            }
+            if (!inside) {
+                continue;
+            }
+            ++valid;
+            const size_t first = static_cast<size_t>((std::max)(begin, 0.0));
+            const size_t last = (std::min)(track.size(), (std::max)(first + 1, static_cast<size_t>(std::ceil(end))));
+            // Widest possible bucket span at the level Query picks: under two columns either side.
+            const size_t slack = static_cast<size_t>(2.0 * (std::max)(columnSamples, 256.0));
+            const size_t wideFirst = first > slack ? first - slack : 0;
+            const size_t wideLast = (std::min)(track.size(), last + slack);
+            float low = 1.0f;
+            float high = -1.0f;
+            for (size_t i = first; i < last; ++i) {
+                low = (std::min)(low, (std::max)(-1.0f, track[i]));
+                high = (std::max)(high, (std::min)(1.0f, track[i]));
+            }
+            float wideLow = 1.0f;
+            float wideHigh = -1.0f;
+            for (size_t i = wideFirst; i < wideLast; ++i) {
+                wideLow = (std::min)(wideLow, (std::max)(-1.0f, track[i]));
+                wideHigh = (std::max)(wideHigh, (std::min)(1.0f, track[i]));
+            }
+            const float quantum = 1.0f / 32767.0f;
+            if (columns[c].min > low + quantum * 0.5f || columns[c].max < high - quantum * 0.5f ||
+                columns[c].min < wideLow - quantum || columns[c].max > wideHigh + quantum ||
+                columns[c].rms < 0.0f || columns[c].rms > (std::max)(std::fabs(wideLow), std::fabs(wideHigh)) + quantum) {
+                ++bad;
+            }
+        }
+        errors += bad > 0 ? 1 : 0;
+        std::printf("query %.2f..%.2f s x %u: valid=%zu bad=%d\n", view.start, view.end, view.columns, valid, bad);
+    }
+
+    // Cost per frame at any zoom stays O(columns); brute force over the samples for comparison.
+    {
+        const uint32_t width = 1000;
+        columns.resize(width);
+        const int iterations = 200;
+        const double spans[] = { 0.05, 2.0, 60.0, static_cast<double>(seconds) };
+        for (double span : spans) {
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                pyramid.Query(0.0, span, width, columns.data());
+            }
+            const double queryUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+            start = std::chrono::steady_clock::now();
+            const size_t samples = (std::min)(track.size(), static_cast<size_t>(span * sampleRate));
+            float sink = 0.0f;
+            for (uint32_t c = 0; c < width; ++c) {
+                const size_t first = samples * c / width;
+                const size_t last = (std::max)(first + 1, samples * (c + 1) / width);
+                float low = track[first];
+                float high = track[first];
+                for (size_t s = first; s < last; ++s) {
+                    low = (std::min)(low, track[s]);
+                    high = (std::max)(high, track[s]);
+                }
+                sink += high - low;
+            }
+            const double bruteUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            if (queryUs > 1000.0) {
+                ++errors;
+            }
+            std::printf("zoom %7.2f s x %u px: pyramid %.1f us, raw samples %.1f us%s\n", span, width, queryUs, bruteUs,
+                        sink < 0.0f ? "!" : "");
+        }
+    }
+
+    // Sidecar round trip; truncated, corrupt and foreign data are rejected.
+    {
+        pyramid.SetSourceHash(0x1234abcdull);
+        const std::string path = (std::filesystem::temp_directory_path() / "shaderlab_waveform.slwave").string();
+        WaveformPyramid loaded;
+        const bool saved = pyramid.Save(path, error);
+        const bool reloaded = WaveformPyramid::Load(path, loaded, error);
+        std::filesystem::remove(path);
+        std::vector<WaveformColumn> before(256);
+        std::vector<WaveformColumn> after(256);
+        pyramid.Query(3.0, 40.0, 256, before.data());
+        loaded.Query(3.0, 40.0, 256, after.data());
+        bool same = true;
+        for (size_t c = 0; c < before.size(); ++c) {
+            same = same && before[c].min == after[c].min && before[c].max == after[c].max && before[c].rms == after[c].rms;
+        }
+        if (!saved || !reloaded || !same || loaded.GetSourceHash() != 0x1234abcdull ||
+            loaded.GetSampleRate() != sampleRate || loaded.GetSampleCount() != track.size()) {
+            ++errors;
+        }
+
+        std::vector<uint8_t> data;
+        pyramid.Serialize(data);
+        WaveformPyramid rejected;
+        int accepted = 0;
+        accepted += WaveformPyramid::Deserialize(data.data(), data.size() - 1, rejected, error) ? 1 : 0;
+        accepted += WaveformPyramid::Deserialize(data.data(), sizeof(SlWaveHeader) - 4, rejected, error) ? 1 : 0;
+        std::vector<uint8_t> corrupt = data;
+        corrupt[corrupt.size() / 2] ^= 0x40u;
+        accepted += WaveformPyramid::Deserialize(corrupt.data(), corrupt.size(), rejected, error) ? 1 : 0;
+        corrupt = data;
+        corrupt[0] = 'X';
+        accepted += WaveformPyramid::Deserialize(corrupt.data(), corrupt.size(), rejected, error) ? 1 : 0;
+        if (accepted != 0 || WaveformPyramid::Load(path, rejected, error)) {
+            ++errors;
+        }
+        std::printf("sidecar: %zu bytes saved=%d reloaded=%d same=%d rejected=%d/4\n", data.size(), saved ? 1 : 0,
+                    reloaded ? 1 : 0, same ? 1 : 0, 4 - accepted);
+    }
+
+    // Edge cases: nothing to build, one partial bucket.
+    {
+        WaveformPyramid tiny;
+        const float few[3] = { 0.25f, -0.5f, 0.1f };
+        WaveformColumn column;
+        const bool emptyFails = !BuildWaveformPyramid(few, 0, sampleRate, WaveformBuildOptions(), tiny, error);
+        const bool built = BuildWaveformPyramid(few, 3, sampleRate, WaveformBuildOptions(), tiny, error);
+        tiny.Query(0.0, 1.0, 1, &column);
+        if (!emptyFails || !built || tiny.GetLevelCount() != 1 || !column.valid || column.min > -0.5f || column.max < 0.25f) {
+            ++errors;
+        }
+    }
+
+    std::printf("waveform: errors=%d\n", errors);
+    return errors == 0 ? 0 : 1;
+}
+
+} // namespace Sim
+} // namespace ShaderLab
@@ -0,0 +1,377 @@
+#include "sim/SimBenches.h"
+#include "sim/SimTrack.h"
+
+#include "ShaderLab/Core/CompactTrack.h"
+#include "ShaderLab/Core/DemoSequencer.h"
+#include "ShaderLab/Core/TrackData.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ShaderLab::Sim;
+
+namespace {
+
+void PrintUsage() {
+    std::cout
+        << "ShaderLabSimCli usage:\n"
+        << "  --track <track.bin>\n"
+        << "  [--fps <rate>]                 fixed frame rate (default 60)\n"
+        << "  [--trace <file>]               frame times in ms, one per line (cycled)\n"
+        << "  [--jitter <fraction>]          +/- frame time jitter, e.g. 0.5\n"
+        << "  [--seed <n>]                   jitter seed (default 1)\n"
+        << "  [--stall-every <n> --stall-ms <ms>]\n"
+        << "  [--seconds <s>] [--frames <n>] simulation limit (default: track length)\n"
+        << "  [--end stop|loop|loop-unless-stop|continue]\n"
+        << "  [--log-frames]                 also log per-frame scene/transition state\n"
+        << "  [--log <path>]                 write the event log (default: stdout)\n"
+        << "  [--expect <path>]              compare against a golden log, exit 1 on mismatch\n"
+        << "  [--bench <iterations>]         time the simulation without logging\n"
+        << "  [--load-bench <workers>]       time serial vs threaded pipeline loading with a\n"
+        << "                                 synthetic factory (0 = default worker count)\n"
+        << "  [--load-ms <ms> --create-ms <ms>] synthetic per-load/per-pipeline cost\n"
+        << "  [--residency <lead-beats>]     print the scene residency plan instead of simulating\n"
+        << "  [--size <w>x<h>]               render target size for --residency (default 1920x1080)\n"
+        << "  [--pool-bench]                 replay per-frame transient target leases through\n"
+        << "                                 TransientTargetPool with a fake backend\n"
+        << "  [--descriptor-bench]           replay per-frame SRV tables through\n"
+        << "                                 DescriptorRingAllocator with a fake device\n"
+        << "  [--frames-in-flight <n>]       compare the serial loop with n frame contexts on a\n"
+        << "                                 fake GPU fence\n"
+        << "  [--cpu-ms <ms> --gpu-ms <ms>]  simulated record cost per frame / GPU cost per\n"
+        << "                                 visible scene for --frames-in-flight\n"
+        << "  [--graph-bench]                compile the player's per-frame render graph and\n"
+        << "                                 compare its barriers with the hand-written ones\n"
+        << "  [--post-fx <n> --compute <n>]  effects per visible scene for --graph-bench\n"
+        << "                                 (default 1 and 0)\n"
+        << "  [--profile-bench]              replay frames through FrameProfiler with fake GPU\n"
+        << "                                 timestamps, check its stats and write a Chrome\n"
+        << "                                 trace to --log\n"
+        << "  [--dynres-bench]               compare fixed and dynamic resolution on a synthetic\n"
+        << "                                 GPU cost (--gpu-ms per scene, --size output)\n"
+        << "  [--target-ms <ms>]             GPU frame budget for --dynres-bench (default 16.6)\n"
+        << "  [--compile-bench <workers>]    check AsyncCompilationService coalescing, cancel and\n"
+        << "                                 ordering with a mock compiler (no --track needed)\n"
+        << "  [--project-compile-bench <n>]  whole-project compile of n mock scenes (0 = 100): active\n"
+        << "                                 scene first, progress, and a bytecode cache reused on restart\n"
+        << "                                 (--compile-bench sets the worker count; no --track needed)\n"
+        << "  [--snapshot-bench <n>]         undo snapshot cost and history memory for n scenes (0 = 200)\n"
+        << "  [--snapshot-edits <n>]         edits (undo levels) for --snapshot-bench (default 500)\n"
+        << "  [--compile-ms <ms>]            mock compile time for the compile benchmarks (default 20)\n"
+        << "  [--export-bench <n>]           video export of n synthetic frames (0 = 24) at --size: SIMD\n"
+        << "                                 conversion, QOI round trip, pipelined vs per-frame PPM, and\n"
+        << "                                 the encoder pipe (ffmpeg if installed; --gpu-ms render time)\n"
+        << "  [--upload-bench <n>]           stream n synthetic textures (0 = 64) through TextureUploadQueue\n"
+        << "                                 with a fake GPU vs a blocking upload per file (--load-ms\n"
+        << "                                 decode, --gpu-ms per blocking upload, --fps frame rate)\n"
+        << "  [--bake-bench <n>]             bake n x n 2D, cube and volume textures (0 = 256) to .sltex in\n"
+        << "                                 every format and check mips, layout and decoded quality\n"
+        << "  [--audio-bench <s>]            FFT and live analysis of s seconds of synthetic audio (0 = 10):\n"
+        << "                                 bands, onsets, and the worker keeping up with real time\n"
+        << "  [--tempo-bench <s>]            tempo and downbeat detection on click tracks, a full track of\n"
+        << "                                 s seconds (0 = 300) and the analysis cache\n"
+        << "  [--waveform-bench <s>]         build the waveform pyramid of an s second track (0 = 300),\n"
+        << "                                 streamed and in parallel; query bounds, zoom cost, sidecar\n"
+        << "  [--rows-bench <n>]             tracker row store with n rows (0 = 20000): handle stability,\n"
+        << "                                 per-frame lookups vs a linear scan, playback ranges, batch edits\n"
+        << "  [--text-bench <n>]             editor find / replace all on an n line shader (0 = 10k and 100k):\n"
+        << "                                 SIMD search vs std::string::find, one-pass vs in-place replace\n"
+        << "  [--catalog-bench <n>]          asset catalog over n preset files (0 = 500) in a temp folder:\n"
+        << "                                 watcher latency, files re-read per edit, vs a full rescan\n"
+        << "  [--hotreload-bench <n>]        linked shader hot reload for n scenes + post-FX (0 = 16, min 8):\n"
+        << "                                 touches, save bursts, reverts, conflicts and relinking\n"
+        << "  [--thumbnail-bench <n>]        shader thumbnail atlas for n browse-list shaders (0 = 200): renders\n"
+        << "                                 per browse, restart from the .slthumb file, edits, LRU eviction\n"
+        << "  [--list-search-bench <n>]      browse list filter over n names (0 = 500): trigram index vs a\n"
+        << "                                 lowercase scan per keystroke, re-keying only edited items\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SimOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--track" && i + 1 < argc) {
+            options.trackPath = argv[++i];
+        } else if (arg == "--fps" && i + 1 < argc) {
+            options.fps = std::atof(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--jitter" && i + 1 < argc) {
+            options.jitter = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--stall-every" && i + 1 < argc) {
+            options.stallEvery = std::atoi(argv[++i]);
+        } else if (arg == "--stall-ms" && i + 1 < argc) {
+            options.stallMs = std::atof(argv[++i]);
+        } else if (arg == "--seconds" && i + 1 < argc) {
+            options.maxSeconds = std::atof(argv[++i]);
+        } else if (arg == "--frames" && i + 1 < argc) {
+            options.maxFrames = std::atoi(argv[++i]);
+        } else if (arg == "--end" && i + 1 < argc) {
+            if (!ParseEndPolicy(argv[++i], options.endPolicy)) {
+                PrintUsage();
+                return 2;
+            }
+        } else if (arg == "--log-frames") {
+            options.logFrames = true;
+        } else if (arg == "--log" && i + 1 < argc) {
+            options.logPath = argv[++i];
+        } else if (arg == "--expect" && i + 1 < argc) {
+            options.expectPath = argv[++i];
+        } else if (arg == "--bench" && i + 1 < argc) {
+            options.benchIterations = std::atoi(argv[++i]);
+        } else if (arg == "--load-bench" && i + 1 < argc) {
+            options.loadBenchWorkers = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--load-ms" && i + 1 < argc) {
+            options.loadMs = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--create-ms" && i + 1 < argc) {
+            options.createMs = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--residency" && i + 1 < argc) {
+            options.residencyLeadBeats = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--size" && i + 1 < argc) {
+            unsigned width = 0;
+            unsigned height = 0;
+            if (std::sscanf(argv[++i], "%ux%u", &width, &height) != 2 || width == 0 || height == 0) {
+                PrintUsage();
+                return 2;
+            }
+            options.targetWidth = width;
+            options.targetHeight = height;
+        } else if (arg == "--pool-bench") {
+            options.poolBench = true;
+        } else if (arg == "--descriptor-bench") {
+            options.descriptorBench = true;
+        } else if (arg == "--frames-in-flight" && i + 1 < argc) {
+            options.framesInFlight = (std::max)(1, std::atoi(argv[++i]));
+        } else if (arg == "--cpu-ms" && i + 1 < argc) {
+            options.cpuMs = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--gpu-ms" && i + 1 < argc) {
+            options.gpuMs = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--graph-bench") {
+            options.graphBench = true;
+        } else if (arg == "--post-fx" && i + 1 < argc) {
+            options.graphPostFx = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--compute" && i + 1 < argc) {
+            options.graphCompute = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--profile-bench") {
+            options.profileBench = true;
+        } else if (arg == "--dynres-bench") {
+            options.dynresBench = true;
+        } else if (arg == "--compile-bench" && i + 1 < argc) {
+            options.compileBenchWorkers = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--project-compile-bench" && i + 1 < argc) {
+            options.projectCompileScenes = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--snapshot-bench" && i + 1 < argc) {
+            options.snapshotScenes = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--snapshot-edits" && i + 1 < argc) {
+            options.snapshotEdits = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--export-bench" && i + 1 < argc) {
+            options.exportFrames = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--upload-bench" && i + 1 < argc) {
+            options.uploadTextures = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--list-search-bench" && i + 1 < argc) {
+            options.listItems = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--thumbnail-bench" && i + 1 < argc) {
+            options.thumbnailShaders = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--hotreload-bench" && i + 1 < argc) {
+            options.hotReloadScenes = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--catalog-bench" && i + 1 < argc) {
+            options.catalogFiles = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--text-bench" && i + 1 < argc) {
+            options.textLines = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--rows-bench" && i + 1 < argc) {
+            options.rowCount = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--waveform-bench" && i + 1 < argc) {
+            options.waveformSeconds = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--tempo-bench" && i + 1 < argc) {
+            options.tempoSeconds = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--audio-bench" && i + 1 < argc) {
+            options.audioSeconds = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--bake-bench" && i + 1 < argc) {
+            options.bakeSize = (std::max)(0, std::atoi(argv[++i]));
+        } else if (arg == "--compile-ms" && i + 1 < argc) {
+            options.compileMs = (std::max)(0.0, std::atof(argv[++i]));
+        } else if (arg == "--target-ms" && i + 1 < argc) {
+            options.targetMs = (std::max)(0.1, std::atof(argv[++i]));
+        } else if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return 0;
+        }
+    }
+
+    if (options.listItems >= 0) {
+        return RunListSearchBench(options);
+    }
+    if (options.thumbnailShaders >= 0) {
+        return RunThumbnailBench(options);
+    }
+    if (options.hotReloadScenes >= 0) {
+        return RunHotReloadBench(options);
+    }
+    if (options.catalogFiles >= 0) {
+        return RunCatalogBench(options);
+    }
+    if (options.textLines >= 0) {
+        return RunTextBench(options);
+    }
+    if (options.rowCount >= 0) {
+        return RunRowStoreBench(options);
+    }
+    if (options.waveformSeconds >= 0) {
+        return RunWaveformBench(options);
+    }
+    if (options.tempoSeconds >= 0) {
+        return RunTempoBench(options);
+    }
+    if (options.audioSeconds >= 0) {
+        return RunAudioBench(options);
+    }
+    if (options.bakeSize >= 0) {
+        return RunBakeBench(options);
+    }
+    if (options.uploadTextures >= 0) {
+        return RunUploadBench(options);
+    }
+    if (options.exportFrames >= 0) {
+        return RunExportBench(options);
+    }
+    if (options.snapshotScenes >= 0) {
+        return RunSnapshotBench(options);
+    }
+    if (options.projectCompileScenes >= 0) {
+        return RunProjectCompileBench(options);
+    }
+    if (options.compileBenchWorkers >= 0) {
+        return RunCompileBench(options);
+    }
+    if (options.trackPath.empty()) {
+        PrintUsage();
+        return 2;
+    }
+
+    const bool loops = options.endPolicy == ShaderLab::SequencerEndPolicy::Loop ||
+                       options.endPolicy == ShaderLab::SequencerEndPolicy::Continue;
+    if (loops && options.residencyLeadBeats < 0.0 && options.maxSeconds <= 0.0 && options.maxFrames <= 0) {
+        std::cerr << "--end loop/continue needs --seconds or --frames\n";
+        return 2;
+    }
+
+    ShaderLab::DemoTrack track;
+    ShaderLab::CompactTrack::Metadata meta;
+    std::string error;
+    if (!ShaderLab::CompactTrack::LoadFromFile(options.trackPath, track, &meta, error)) {
+        std::cerr << "Failed to load track: " << error << "\n";
+        return 1;
+    }
+
+    if (options.loadBenchWorkers >= 0) {
+        return RunLoadBench(track, meta, options);
+    }
+
+    std::vector<double> traceMs;
+    if (!options.tracePath.empty() && !LoadFrameTrace(options.tracePath, traceMs)) {
+        std::cerr << "Failed to read frame trace: " << options.tracePath << "\n";
+        return 1;
+    }
+
+    if (options.poolBench) {
+        return RunPoolBench(track, meta, options, traceMs);
+    }
+    if (options.descriptorBench) {
+        return RunDescriptorBench(track, meta, options, traceMs);
+    }
+    if (options.framesInFlight > 0) {
+        return RunFramesInFlightBench(track, meta, options, traceMs);
+    }
+    if (options.graphBench) {
+        return RunGraphBench(track, meta, options, traceMs);
+    }
+    if (options.profileBench) {
+        return RunProfileBench(track, meta, options, traceMs);
+    }
+    if (options.dynresBench) {
+        return RunDynresBench(track, meta, options, traceMs);
+    }
+
+    if (options.benchIterations > 0) {
+        size_t totalFrames = 0;
+        size_t totalCommands = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < options.benchIterations; ++i) {
+            const SimResult result = Simulate(track, meta, options, traceMs, false);
+            totalFrames += static_cast<size_t>(result.frames);
+            totalCommands += result.commands;
+        }
+        const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        const double nsPerFrame = totalFrames > 0 ? elapsed / static_cast<double>(totalFrames) : 0.0;
+        std::printf("iterations=%d frames=%zu commands=%zu total_ms=%.3f ns_per_frame=%.1f\n",
+                    options.benchIterations, totalFrames, totalCommands, elapsed / 1.0e6, nsPerFrame);
+        return 0;
+    }
+
+    SimResult result;
+    if (options.residencyLeadBeats >= 0.0) {
+        if (!PlanResidency(track, meta, options, result)) {
+            return 1;
+        }
+    } else {
+        result = Simulate(track, meta, options, traceMs, true);
+    }
+
+    if (!options.logPath.empty()) {
+        std::ofstream out(options.logPath, std::ios::binary);
+        if (!out) {
+            std::cerr << "Failed to write log: " << options.logPath << "\n";
+            return 1;
+        }
+        out << result.log;
+    } else if (options.expectPath.empty()) {
+        std::cout << result.log;
+    }
+
+    if (!options.expectPath.empty()) {
+        std::string expected;
+        if (!ReadTextFile(options.expectPath, expected)) {
+            std::cerr << "Failed to read golden log: " << options.expectPath << "\n";
+            return 1;
+        }
+        expected.erase(std::remove(expected.begin(), expected.end(), '\r'), expected.end());
+        if (expected != result.log) {
+            std::istringstream expectedLines(expected);
+            std::istringstream actualLines(result.log);
+            std::string expectedLine;
+            std::string actualLine;
+            int lineNumber = 1;
+            while (true) {
+                const bool hasExpected = static_cast<bool>(std::getline(expectedLines, expectedLine));
+                const bool hasActual = static_cast<bool>(std::getline(actualLines, actualLine));
+                if (!hasExpected && !hasActual) {
+                    break;
+                }
+                if (!hasExpected || !hasActual || expectedLine != actualLine) {
+                    std::cerr << "Event log mismatch at line " << lineNumber << "\n"
+                              << "  expected: " << (hasExpected ? expectedLine : "<eof>") << "\n"
+                              << "  actual:   " << (hasActual ? actualLine : "<eof>") << "\n";
+                    break;
+                }
+                ++lineNumber;
+            }
+            return 1;
+        }
+        std::cout << "Event log matches " << options.expectPath << " (" << result.frames << " frames)\n";
+    }
+
+    return 0;
+}
@@ -2,10 +2,33 @@
 
 #define MINIAUDIO_IMPLEMENTATION
 #include <miniaudio.h>
+#include <algorithm>
+#include <string>
 #include <vector>
 
 namespace ShaderLab {
 
+namespace {
+
+struct AnalysisTapNode {
+    ma_node_base base; // Must stay first
+    AudioAnalyzer* analyzer = nullptr;
+    ma_uint32 channels = 0;
+};
+
+// Audio thread: copies its input through and queues it for analysis without locking.
+void AnalysisTapProcess(ma_node* node, const float** framesIn, ma_uint32* frameCountIn, float** framesOut, ma_uint32* frameCountOut) {
+    AnalysisTapNode* tap = (AnalysisTapNode*)node;
+    const ma_uint32 frameCount = (std::min)(frameCountIn[0], *frameCountOut);
+    ma_copy_pcm_frames(framesOut[0], framesIn[0], frameCount, ma_format_f32, tap->channels);
+    tap->analyzer->PushInterleaved(framesIn[0], frameCount, tap->channels);
+    *frameCountOut = frameCount;
+}
+
+ma_node_vtable g_analysisTapVtable = { AnalysisTapProcess, nullptr, 1, 1, 0 };
+
+} // namespace
+
 AudioSystem::AudioSystem() = default;
 
 AudioSystem::~AudioSystem() {
@@ -26,10 +49,40 @@ bool AudioSystem::Initialize() {
         return false;
     }
 
+    // Analysis is optional; playback works without the tap.
+    AudioAnalyzerConfig analyzerConfig;
+    analyzerConfig.sampleRate = ma_engine_get_sample_rate(m_engine);
+    std::string analyzerError;
+    if (m_analyzer.Configure(analyzerConfig, analyzerError)) {
+        AnalysisTapNode* tap = new AnalysisTapNode();
+        tap->analyzer = &m_analyzer;
+        tap->channels = ma_engine_get_channels(m_engine);
+        ma_node_config nodeConfig = ma_node_config_init();
+        nodeConfig.vtable = &g_analysisTapVtable;
+        nodeConfig.pInputChannels = &tap->channels;
+        nodeConfig.pOutputChannels = &tap->channels;
+        if (ma_node_init(ma_engine_get_node_graph(m_engine), &nodeConfig, nullptr, &tap->base) != MA_SUCCESS) {
+            delete tap;
+        } else if (ma_node_attach_output_bus(&tap->base, 0, ma_engine_get_endpoint(m_engine), 0) != MA_SUCCESS) {
+            ma_node_uninit(&tap->base, nullptr);
+            delete tap;
+        } else {
+            m_analysisTap = tap;
+            m_analyzer.Start();
+        }
+    }
+
     m_initialized = true;
     return true;
 }
 
+void AudioSystem::AttachAnalysisTap() {
+    m_analyzer.Reset();
+    if (m_sound && m_analysisTap) {
+        ma_node_attach_output_bus(m_sound, 0, &((AnalysisTapNode*)m_analysisTap)->base, 0);
+    }
+}
+
 void AudioSystem::Shutdown() {
     if (m_sound) {
         ma_sound_uninit(m_sound);
@@ -44,6 +97,13 @@ void AudioSystem::Shutdown() {
     }
     m_audioBuffer.clear();
 
+    if (m_analysisTap) {
+        ma_node_uninit(&((AnalysisTapNode*)m_analysisTap)->base, nullptr);
+        delete (AnalysisTapNode*)m_analysisTap;
+        m_analysisTap = nullptr;
+    }
+    m_analyzer.Stop();
+
     if (m_engine) {
         ma_engine_uninit(m_engine);
         delete m_engine;
@@ -83,6 +143,7 @@ bool AudioSystem::LoadAudio(const std::string& filepath) {
         return false;
     }
 
+    AttachAnalysisTap();
     return true;
 }
 
@@ -122,6 +183,7 @@ bool AudioSystem::LoadAudioFromMemory(const void* data, size_t size) {
         m_sound = nullptr;
         return false;
     }
+    AttachAnalysisTap();
     return true;
 }
 
@@ -142,6 +204,7 @@ void AudioSystem::Stop() {
         ma_sound_stop(m_sound);
         ma_sound_seek_to_pcm_frame(m_sound, 0);
     }
+    m_analyzer.Reset();
 }
 
 void AudioSystem::Seek(float timeInSeconds) {
@@ -158,6 +221,7 @@ void AudioSystem::Seek(float timeInSeconds) {
 
     ma_uint64 framePosition = static_cast<ma_uint64>(timeInSeconds * sampleRate);
     ma_sound_seek_to_pcm_frame(m_sound, framePosition);
+    m_analyzer.Reset();
 }
 void AudioSystem::SetVolume(float volume) {
     if (m_sound) {
@@ -170,6 +234,47 @@ void AudioSystem::PlayOneShot(const std::string& filepath) {
     ma_engine_play_sound(m_engine, filepath.c_str(), nullptr);
 }
 
+bool AudioSystem::DecodeMono(const void* data, size_t size, std::vector<float>& outSamples, uint32_t& outSampleRate, std::string& outError) {
+    outSamples.clear();
+    return DecodeMono(data, size, [&](const float* samples, size_t count) {
+        outSamples.insert(outSamples.end(), samples, samples + count);
+    }, outSampleRate, outError);
+}
+
+bool AudioSystem::DecodeMono(const void* data,
+                             size_t size,
+                             const std::function<void(const float*, size_t)>& onSamples,
+                             uint32_t& outSampleRate,
+                             std::string& outError) {
+    ma_decoder decoder;
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 1, 0);
+    if (!data || size == 0 || ma_decoder_init_memory(data, size, &config, &decoder) != MA_SUCCESS) {
+        outError = "Unsupported or damaged audio file.";
+        return false;
+    }
+    outSampleRate = decoder.outputSampleRate;
+    // Lengths are estimates for some formats, so read until the decoder runs dry.
+    float chunk[4096];
+    size_t total = 0;
+    for (;;) {
+        ma_uint64 read = 0;
+        const ma_result result = ma_decoder_read_pcm_frames(&decoder, chunk, 4096, &read);
+        if (read > 0) {
+            onSamples(chunk, static_cast<size_t>(read));
+            total += static_cast<size_t>(read);
+        }
+        if (result != MA_SUCCESS || read == 0) {
+            break;
+        }
+    }
+    ma_decoder_uninit(&decoder);
+    if (total == 0 || outSampleRate == 0) {
+        outError = "Audio file holds no samples.";
+        return false;
+    }
+    return true;
+}
+
 bool AudioSystem::IsPlaying() const {
     if (!m_sound) {
         return false;
@@ -0,0 +1,672 @@
+#include "ShaderLab/Core/AssetCatalog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace ShaderLab {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kPollIntervalMs = 2000; // Roots without a native watch (missing folder, no watcher)
+constexpr int kSettleMs = 50;         // Editors save in bursts: temp file, rename, touch
+constexpr int kMaxSettleRounds = 10;
+
+bool MatchesSuffix(const std::string& name, const std::vector<std::string>& suffixes) {
+    if (suffixes.empty()) {
+        return true;
+    }
+    for (const std::string& suffix : suffixes) {
+        if (name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReadFileContent(const std::string& path, std::string& outContent) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    if (size < 0) {
+        return false;
+    }
+    outContent.resize(static_cast<size_t>(size));
+    in.seekg(0, std::ios::beg);
+    if (!outContent.empty()) {
+        in.read(outContent.data(), static_cast<std::streamsize>(outContent.size()));
+    }
+    return static_cast<bool>(in) || in.eof();
+}
+
+void SeedMissingFiles(const fs::path& from, const fs::path& to, const std::vector<std::string>& suffixes) {
+    std::error_code ec;
+    if (!fs::is_directory(from, ec)) {
+        return;
+    }
+    for (const auto& entry : fs::directory_iterator(from, ec)) {
+        if (ec || !entry.is_regular_file(ec)) {
+            continue;
+        }
+        const std::string name = entry.path().filename().string();
+        if (!MatchesSuffix(name, suffixes)) {
+            continue;
+        }
+        const fs::path destination = to / entry.path().filename();
+        if (!fs::exists(destination, ec)) {
+            fs::copy_file(entry.path(), destination, fs::copy_options::none, ec);
+        }
+    }
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------------------------
+
+// Folder change notifications, tagged with the collection index. Only the worker calls Watch and
+// Wait; Wake may come from any thread.
+struct AssetCatalog::Watcher {
+    bool native = false;
+
+#if defined(_WIN32)
+    struct DirWatch {
+        int tag = -1;
+        std::wstring root;
+        bool recursive = false;
+        HANDLE dir = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped = {};
+        std::vector<DWORD> buffer = std::vector<DWORD>(4096);
+    };
+    HANDLE wake = nullptr;
+    std::vector<std::unique_ptr<DirWatch>> watches;
+
+    static constexpr DWORD kFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                     FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                     FILE_NOTIFY_CHANGE_CREATION;
+
+    bool Issue(DirWatch& watch) {
+        ResetEvent(watch.overlapped.hEvent);
+        return ReadDirectoryChangesW(watch.dir, watch.buffer.data(), static_cast<DWORD>(watch.buffer.size() * sizeof(DWORD)),
+                                     watch.recursive ? TRUE : FALSE, kFilter, nullptr, &watch.overlapped, nullptr) != FALSE;
+    }
+
+    void Release(DirWatch& watch) {
+        if (watch.dir != INVALID_HANDLE_VALUE) {
+            CancelIoEx(watch.dir, &watch.overlapped);
+            DWORD ignored = 0;
+            GetOverlappedResult(watch.dir, &watch.overlapped, &ignored, TRUE);
+            CloseHandle(watch.dir);
+            watch.dir = INVALID_HANDLE_VALUE;
+        }
+        if (watch.overlapped.hEvent) {
+            CloseHandle(watch.overlapped.hEvent);
+            watch.overlapped.hEvent = nullptr;
+        }
+    }
+
+    void Open() {
+        wake = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+        native = wake != nullptr;
+    }
+
+    void Close() {
+        for (auto& watch : watches) {
+            Release(*watch);
+        }
+        watches.clear();
+        if (wake) {
+            CloseHandle(wake);
+            wake = nullptr;
+        }
+    }
+
+    // One handle per root; subfolders are covered by watching the subtree.
+    bool Watch(int tag, const std::string& root, bool recursive, const std::vector<std::string>& subdirs) {
+        (void)subdirs;
+        const std::wstring wideRoot = fs::path(root).wstring();
+        for (auto it = watches.begin(); it != watches.end(); ++it) {
+            if ((*it)->tag != tag) {
+                continue;
+            }
+            if ((*it)->root == wideRoot && (*it)->recursive == recursive) {
+                return true;
+            }
+            Release(**it);
+            watches.erase(it);
+            break;
+        }
+        // WaitForMultipleObjects takes at most 64 handles, one of them the wake event.
+        if (!native || root.empty() || watches.size() + 1 >= MAXIMUM_WAIT_OBJECTS) {
+            return false;
+        }
+
+        auto watch = std::make_unique<DirWatch>();
+        watch->tag = tag;
+        watch->root = wideRoot;
+        watch->recursive = recursive;
+        watch->dir = CreateFileW(wideRoot.c_str(), FILE_LIST_DIRECTORY,
+                                 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                 FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        watch->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (watch->dir == INVALID_HANDLE_VALUE || !watch->overlapped.hEvent || !Issue(*watch)) {
+            Release(*watch);
+            return false;
+        }
+        watches.push_back(std::move(watch));
+        return true;
+    }
+
+    void Wait(int timeoutMs, std::vector<int>& outTags) {
+        std::vector<HANDLE> handles;
+        handles.reserve(watches.size() + 1);
+        handles.push_back(wake);
+        for (const auto& watch : watches) {
+            handles.push_back(watch->overlapped.hEvent);
+        }
+        DWORD timeout = timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs);
+        for (;;) {
+            const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, timeout);
+            if (result < WAIT_OBJECT_0 + 1 || result >= WAIT_OBJECT_0 + handles.size()) {
+                return;
+            }
+            // The buffer is not parsed: any change, or an overflowed buffer, rescans the collection.
+            DirWatch& watch = *watches[result - WAIT_OBJECT_0 - 1];
+            DWORD bytes = 0;
+            GetOverlappedResult(watch.dir, &watch.overlapped, &bytes, FALSE);
+            outTags.push_back(watch.tag);
+            if (!Issue(watch)) {
+                // The folder went away; the rescan notices and watches it again if it comes back.
+                handles.erase(handles.begin() + (result - WAIT_OBJECT_0));
+                Release(watch);
+                watches.erase(watches.begin() + (result - WAIT_OBJECT_0 - 1));
+            }
+            timeout = 0;
+        }
+    }
+
+    void Wake() {
+        if (wake) {
+            SetEvent(wake);
+        }
+    }
+#elif defined(__linux__)
+    int fd = -1;
+    int wakeFd = -1;
+    std::map<int, std::vector<int>> tagsByWatch;
+    std::map<int, std::vector<int>> watchesByTag;
+
+    static constexpr uint32_t kMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM |
+                                      IN_MOVED_TO | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    void Open() {
+        fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        native = fd >= 0 && wakeFd >= 0;
+    }
+
+    void Close() {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+        if (wakeFd >= 0) {
+            close(wakeFd);
+            wakeFd = -1;
+        }
+        tagsByWatch.clear();
+        watchesByTag.clear();
+    }
+
+    void Drop(int wd, int tag) {
+        auto it = tagsByWatch.find(wd);
+        if (it == tagsByWatch.end()) {
+            return;
+        }
+        it->second.erase(std::remove(it->second.begin(), it->second.end(), tag), it->second.end());
+        if (it->second.empty()) {
+            inotify_rm_watch(fd, wd);
+            tagsByWatch.erase(it);
+        }
+    }
+
+    // inotify is not recursive, so every subfolder gets its own watch. Adding a watched folder
+    // again returns the same descriptor.
+    bool Watch(int tag, const std::string& root, bool recursive, const std::vector<std::string>& subdirs) {
+        (void)recursive;
+        std::vector<int> previous;
+        previous.swap(watchesByTag[tag]);
+        std::vector<int>& current = watchesByTag[tag];
+
+        bool rootWatched = false;
+        if (native && !root.empty()) {
+            const int rootWd = inotify_add_watch(fd, root.c_str(), kMask);
+            rootWatched = rootWd >= 0;
+            if (rootWatched) {
+                current.push_back(rootWd);
+                for (const std::string& dir : subdirs) {
+                    const int wd = inotify_add_watch(fd, dir.c_str(), kMask);
+                    if (wd >= 0) {
+                        current.push_back(wd);
+                    }
+                }
+            }
+        }
+        for (const int wd : current) {
+            auto& tags = tagsByWatch[wd];
+            if (std::find(tags.begin(), tags.end(), tag) == tags.end()) {
+                tags.push_back(tag);
+            }
+        }
+        for (const int wd : previous) {
+            if (std::find(current.begin(), current.end(), wd) == current.end()) {
+                Drop(wd, tag);
+            }
+        }
+        return rootWatched;
+    }
+
+    void Wait(int timeoutMs, std::vector<int>& outTags) {
+        pollfd fds[2] = { { fd, POLLIN, 0 }, { wakeFd, POLLIN, 0 } };
+        if (poll(fds, 2, timeoutMs) <= 0) {
+            return;
+        }
+        if (fds[1].revents & POLLIN) {
+            uint64_t count = 0;
+            (void)!read(wakeFd, &count, sizeof(count));
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            return;
+        }
+        alignas(inotify_event) char buffer[16384];
+        for (;;) {
+            const ssize_t length = read(fd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                break;
+            }
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+                if (event->mask & IN_Q_OVERFLOW) {
+                    outTags.push_back(-1);
+                    continue;
+                }
+                auto it = tagsByWatch.find(event->wd);
+                if (it == tagsByWatch.end()) {
+                    continue;
+                }
+                outTags.insert(outTags.end(), it->second.begin(), it->second.end());
+                if (event->mask & IN_IGNORED) {
+                    // The folder is gone and the kernel dropped the watch.
+                    for (const int tag : it->second) {
+                        auto& wds = watchesByTag[tag];
+                        wds.erase(std::remove(wds.begin(), wds.end(), event->wd), wds.end());
+                    }
+                    tagsByWatch.erase(it);
+                }
+            }
+        }
+    }
+
+    void Wake() {
+        if (wakeFd >= 0) {
+            const uint64_t one = 1;
+            (void)!write(wakeFd, &one, sizeof(one));
+        }
+    }
+#else
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool woken = false;
+
+    void Open() {}
+    void Close() {}
+
+    bool Watch(int, const std::string&, bool, const std::vector<std::string>&) {
+        return false;
+    }
+
+    void Wait(int timeoutMs, std::vector<int>&) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait_for(lock, std::chrono::milliseconds(timeoutMs < 0 ? kPollIntervalMs : timeoutMs), [this]() {
+            return woken;
+        });
+        woken = false;
+    }
+
+    void Wake() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            woken = true;
+        }
+        cv.notify_all();
+    }
+#endif
+
+    ~Watcher() {
+        Close();
+    }
+};
+
+// ----------------------------------------------------------------------------------------------
+
+AssetCatalog::AssetCatalog()
+    : m_watcher(std::make_unique<Watcher>()) {
+    m_watcher->Open();
+    m_stats.nativeWatcher = m_watcher->native;
+}
+
+AssetCatalog::~AssetCatalog() {
+    Stop();
+}
+
+int AssetCatalog::AddCollection(AssetCollectionDesc desc) {
+    int index = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Collection collection;
+        collection.desc = std::move(desc);
+        m_collections.push_back(std::move(collection));
+        index = static_cast<int>(m_collections.size()) - 1;
+    }
+    m_watcher->Wake();
+    return index;
+}
+
+void AssetCatalog::SetCollectionRoot(int collection, const std::string& root, const std::string& seedFrom) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (collection < 0 || collection >= static_cast<int>(m_collections.size())) {
+            return;
+        }
+        Collection& target = m_collections[collection];
+        if (target.desc.root == root && target.desc.seedFrom == seedFrom) {
+            return;
+        }
+        target.desc.root = root;
+        target.desc.seedFrom = seedFrom;
+        ++target.descVersion;
+        target.dirty = true;
+    }
+    m_watcher->Wake();
+}
+
+void AssetCatalog::SetCollectionSuffixes(int collection, std::vector<std::string> suffixes) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (collection < 0 || collection >= static_cast<int>(m_collections.size())) {
+            return;
+        }
+        Collection& target = m_collections[collection];
+        if (target.desc.suffixes == suffixes) {
+            return;
+        }
+        target.desc.suffixes = std::move(suffixes);
+        ++target.descVersion;
+        target.dirty = true;
+    }
+    m_watcher->Wake();
+}
+
+void AssetCatalog::RequestRescan(int collection) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (collection < 0 || collection >= static_cast<int>(m_collections.size())) {
+            return;
+        }
+        m_collections[collection].dirty = true;
+    }
+    m_watcher->Wake();
+}
+
+void AssetCatalog::Start() {
+    if (m_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = false;
+    }
+    m_worker = std::thread([this]() { WorkerMain(); });
+}
+
+void AssetCatalog::Stop() {
+    if (!m_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_watcher->Wake();
+    m_worker.join();
+}
+
+std::shared_ptr<const AssetCollectionSnapshot> AssetCatalog::GetSnapshot(int collection) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (collection < 0 || collection >= static_cast<int>(m_collections.size())) {
+        return nullptr;
+    }
+    return m_collections[collection].snapshot;
+}
+
+uint64_t AssetCatalog::GetGeneration(int collection) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (collection < 0 || collection >= static_cast<int>(m_collections.size()) || !m_collections[collection].snapshot) {
+        return 0;
+    }
+    return m_collections[collection].snapshot->generation;
+}
+
+bool AssetCatalog::WaitForScan(int collection, uint32_t timeoutMs) const {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (collection < 0 || collection >= static_cast<int>(m_collections.size())) {
+        return false;
+    }
+    return m_scanned.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, collection]() {
+        const Collection& target = m_collections[collection];
+        return !target.dirty && target.snapshot && target.snapshot->generation > 0 && target.scannedVersion == target.descVersion;
+    });
+}
+
+AssetCatalogStats AssetCatalog::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void AssetCatalog::WorkerMain() {
+    std::vector<int> changed;
+    auto lastPoll = std::chrono::steady_clock::now();
+    for (;;) {
+        for (;;) {
+            int next = -1;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_stop) {
+                    return;
+                }
+                for (size_t i = 0; i < m_collections.size(); ++i) {
+                    if (m_collections[i].dirty) {
+                        m_collections[i].dirty = false;
+                        next = static_cast<int>(i);
+                        break;
+                    }
+                }
+            }
+            if (next < 0) {
+                break;
+            }
+            ScanCollection(next);
+        }
+
+        bool polling = !m_watcher->native;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const Collection& collection : m_collections) {
+                polling = polling || !collection.watched;
+            }
+        }
+
+        changed.clear();
+        m_watcher->Wait(polling ? kPollIntervalMs : -1, changed);
+        if (!changed.empty()) {
+            for (int round = 0; round < kMaxSettleRounds; ++round) {
+                const size_t before = changed.size();
+                m_watcher->Wait(kSettleMs, changed);
+                if (changed.size() == before) {
+                    break;
+                }
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        const bool pollDue = polling && now - lastPoll >= std::chrono::milliseconds(kPollIntervalMs);
+        if (pollDue) {
+            lastPoll = now;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!changed.empty()) {
+            ++m_stats.notifications;
+        }
+        for (const int tag : changed) {
+            if (tag < 0) {
+                for (Collection& collection : m_collections) {
+                    collection.dirty = true;
+                }
+            } else if (tag < static_cast<int>(m_collections.size())) {
+                m_collections[tag].dirty = true;
+            }
+        }
+        if (pollDue) {
+            for (Collection& collection : m_collections) {
+                collection.dirty = collection.dirty || !collection.watched;
+            }
+        }
+    }
+}
+
+void AssetCatalog::ScanCollection(int index) {
+    AssetCollectionDesc desc;
+    uint64_t version = 0;
+    std::shared_ptr<const AssetCollectionSnapshot> previous;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        desc = m_collections[index].desc;
+        version = m_collections[index].descVersion;
+        previous = m_collections[index].snapshot;
+    }
+
+    auto next = std::make_shared<AssetCollectionSnapshot>();
+    std::vector<std::string> subdirs;
+    const fs::path root(desc.root);
+    std::error_code ec;
+    if (!desc.root.empty()) {
+        if (desc.createRoot) {
+            fs::create_directories(root, ec);
+        }
+        if (!desc.seedFrom.empty()) {
+            SeedMissingFiles(fs::path(desc.seedFrom), root, desc.suffixes);
+        }
+        next->rootExists = fs::is_directory(root, ec);
+    }
+
+    if (next->rootExists) {
+        fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+            const fs::directory_entry& entry = *it;
+            std::error_code entryError;
+            if (entry.is_directory(entryError)) {
+                if (it.depth() < desc.maxDepth) {
+                    subdirs.push_back(entry.path().string());
+                } else {
+                    it.disable_recursion_pending();
+                }
+                continue;
+            }
+            if (!entry.is_regular_file(entryError) || !MatchesSuffix(entry.path().filename().string(), desc.suffixes)) {
+                continue;
+            }
+            AssetEntry asset;
+            asset.path = entry.path().string();
+            asset.relativePath = entry.path().lexically_relative(root).generic_string();
+            asset.stem = entry.path().stem().string();
+            asset.size = static_cast<uint64_t>(entry.file_size(entryError));
+            asset.writeTime = static_cast<int64_t>(entry.last_write_time(entryError).time_since_epoch().count());
+            next->entries.push_back(std::move(asset));
+        }
+    }
+    std::sort(next->entries.begin(), next->entries.end(), [](const AssetEntry& a, const AssetEntry& b) {
+        return a.relativePath < b.relativePath;
+    });
+
+    // Both lists are sorted, so unchanged files are matched in one merge and keep their content.
+    bool changed = !previous || previous->rootExists != next->rootExists ||
+                   previous->entries.size() != next->entries.size();
+    uint64_t filesRead = 0;
+    size_t old = 0;
+    const size_t oldCount = previous ? previous->entries.size() : 0;
+    for (AssetEntry& asset : next->entries) {
+        while (old < oldCount && previous->entries[old].relativePath < asset.relativePath) {
+            ++old;
+        }
+        const AssetEntry* match = old < oldCount && previous->entries[old].relativePath == asset.relativePath
+            ? &previous->entries[old]
+            : nullptr;
+        if (match && match->size == asset.size && match->writeTime == asset.writeTime && match->path == asset.path) {
+            asset.content = match->content;
+            asset.parsed = match->parsed;
+            continue;
+        }
+        changed = true;
+        if (desc.loadContent || desc.parse) {
+            auto content = std::make_shared<std::string>();
+            ReadFileContent(asset.path, *content);
+            asset.content = std::move(content);
+            if (desc.parse) {
+                asset.parsed = desc.parse(asset);
+            }
+            if (!desc.loadContent) {
+                asset.content.reset();
+            }
+            ++filesRead;
+        }
+    }
+
+    // Also drops the previous root's watches; a collection without a root needs no polling.
+    const bool watched = m_watcher->Watch(index, desc.root, desc.maxDepth > 0, subdirs) || desc.root.empty();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Collection& collection = m_collections[index];
+        ++m_stats.scans;
+        m_stats.filesRead += filesRead;
+        collection.watched = watched;
+        if (collection.descVersion == version) {
+            if (changed) {
+                next->generation = (previous ? previous->generation : 0) + 1;
+                collection.snapshot = std::move(next);
+            }
+            collection.scannedVersion = version;
+        }
+    }
+    m_scanned.notify_all();
+}
+
+} // namespace ShaderLab
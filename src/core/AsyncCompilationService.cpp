@@ -0,0 +1,253 @@
+#include "ShaderLab/Core/AsyncCompilationService.h"
+
+#include "ShaderLab/Core/ShaderBytecodeCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace ShaderLab {
+
+AsyncCompilationService::AsyncCompilationService(ServiceFactory factory, unsigned workerCount)
+    : m_factory(std::move(factory)) {
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this]() { WorkerMain(); });
+    }
+}
+
+AsyncCompilationService::~AsyncCompilationService() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned AsyncCompilationService::DefaultWorkerCount() {
+    // Two workers already keep a scene and its effects compiling side by side; more mostly
+    // competes with the render thread.
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads <= 2 ? 1u : 2u;
+}
+
+unsigned AsyncCompilationService::BatchWorkerCount() {
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return (std::min)((std::max)(hardwareThreads, 2u) - 1u, 8u);
+}
+
+uint64_t AsyncCompilationService::Submit(AsyncCompileRequest request) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint64_t generation = ++m_nextGeneration;
+    TargetState& state = m_targets[request.key];
+    state.latest = generation;
+    state.pending = true;
+    ++m_stats.submitted;
+
+    for (Job& job : m_queue) {
+        if (job.request.key == request.key) {
+            job.request = std::move(request);
+            job.generation = generation;
+            ++m_stats.coalesced;
+            return generation;
+        }
+    }
+    Job job;
+    job.request = std::move(request);
+    job.generation = generation;
+    m_queue.push_back(std::move(job));
+    m_wake.notify_one();
+    return generation;
+}
+
+void AsyncCompilationService::Cancel(const CompileTargetKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_targets.find(key);
+    if (it == m_targets.end()) {
+        return;
+    }
+    // A fresh generation nobody holds: whatever is still compiling for key finishes stale.
+    it->second.latest = ++m_nextGeneration;
+    it->second.pending = false;
+    const size_t before = m_queue.size();
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), [&](const Job& job) { return job.request.key == key; }),
+                  m_queue.end());
+    m_stats.canceled += before - m_queue.size();
+    if (m_queue.empty() && m_busy == 0) {
+        m_idle.notify_all();
+    }
+}
+
+void AsyncCompilationService::SetBytecodeCache(ShaderBytecodeCache* cache) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache = cache;
+}
+
+void AsyncCompilationService::CancelAll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_targets) {
+        entry.second.latest = ++m_nextGeneration;
+        entry.second.pending = false;
+    }
+    m_stats.canceled += m_queue.size();
+    m_queue.clear();
+    m_stats.discarded += m_completed.size();
+    m_completed.clear();
+    if (m_busy == 0) {
+        m_idle.notify_all();
+    }
+}
+
+size_t AsyncCompilationService::Collect(std::vector<AsyncCompileResult>& outResults) {
+    if (m_workers.empty()) {
+        for (;;) {
+            Job job;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_queue.empty()) {
+                    break;
+                }
+                job = PopJob();
+            }
+            if (!m_inlineService && m_factory) {
+                m_inlineService = m_factory();
+            }
+            FinishJob(RunJob(m_inlineService.get(), job));
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t added = 0;
+    for (AsyncCompileResult& result : m_completed) {
+        TargetState& state = m_targets[result.key];
+        if (state.latest != result.generation) {
+            ++m_stats.discarded;
+            continue;
+        }
+        state.pending = false;
+        ++m_stats.delivered;
+        outResults.push_back(std::move(result));
+        ++added;
+    }
+    m_completed.clear();
+    return added;
+}
+
+void AsyncCompilationService::WaitIdle() {
+    if (m_workers.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_queue.empty() && m_busy == 0; });
+}
+
+bool AsyncCompilationService::IsPending(const CompileTargetKey& key) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_targets.find(key);
+    return it != m_targets.end() && it->second.pending;
+}
+
+size_t AsyncCompilationService::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& entry : m_targets) {
+        count += entry.second.pending ? 1u : 0u;
+    }
+    return count;
+}
+
+AsyncCompileStats AsyncCompilationService::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void AsyncCompilationService::WorkerMain() {
+    std::unique_ptr<ICompilationService> service = m_factory ? m_factory() : nullptr;
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_stop) {
+                return;
+            }
+            job = PopJob();
+        }
+        FinishJob(RunJob(service.get(), job));
+    }
+}
+
+AsyncCompilationService::Job AsyncCompilationService::PopJob() {
+    // Called with m_mutex held. Queues are short, a scan beats keeping a heap in sync with
+    // in-place coalescing.
+    auto best = m_queue.begin();
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
+        if (it->request.priority > best->request.priority) {
+            best = it;
+        }
+    }
+    Job job = std::move(*best);
+    m_queue.erase(best);
+    ++m_busy;
+    return job;
+}
+
+AsyncCompileResult AsyncCompilationService::RunJob(ICompilationService* service, Job& job) {
+    AsyncCompileResult result;
+    result.key = job.request.key;
+    result.generation = job.generation;
+
+    const auto start = std::chrono::steady_clock::now();
+    const AsyncCompileRequest& request = job.request;
+    ShaderBytecodeCache* cache = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cache = m_cache;
+    }
+    const uint64_t cacheKey = cache ? ShaderBytecodeCache::HashRequest(request) : 0;
+    if (cache && cache->Find(cacheKey, result.result.bytecode)) {
+        result.result.success = true;
+        result.cacheHit = true;
+    } else if (!service) {
+        ShaderDiagnostic diagnostic;
+        diagnostic.message = "Compilation service unavailable.";
+        diagnostic.isError = true;
+        result.result.diagnostics.push_back(diagnostic);
+    } else if (request.target.empty()) {
+        result.result = service->CompilePreviewShader(request.source, request.bindings, request.flipFragCoord,
+                                                      request.entryPoint, request.sourceName, request.mode);
+    } else {
+        result.result = service->CompileFromSource(request.source, request.entryPoint, request.target,
+                                                   request.sourceName, request.mode, request.bindings);
+    }
+    if (cache && !result.cacheHit && result.result.success) {
+        cache->Store(cacheKey, result.result.bytecode);
+    }
+    result.compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    result.source = std::move(job.request.source);
+    return result;
+}
+
+void AsyncCompilationService::FinishJob(AsyncCompileResult&& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_busy;
+    ++m_stats.compiled;
+    m_stats.cacheHits += result.cacheHit ? 1u : 0u;
+    auto it = m_targets.find(result.key);
+    if (it != m_targets.end() && it->second.latest == result.generation) {
+        m_completed.push_back(std::move(result));
+    } else {
+        ++m_stats.discarded;
+    }
+    if (m_queue.empty() && m_busy == 0) {
+        m_idle.notify_all();
+    }
+}
+
+} // namespace ShaderLab
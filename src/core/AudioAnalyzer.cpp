@@ -0,0 +1,491 @@
+#include "ShaderLab/Core/AudioAnalyzer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1) || defined(__SSE__)
+#define SHADERLAB_AUDIO_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+bool IsPowerOfTwo(uint64_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+// One radix-4 butterfly on split complex values; the twiddles arrive in bit-reversed input order.
+inline void Butterfly4(float* re, float* im, size_t a, size_t q,
+                       float w1r, float w1i, float w2r, float w2i, float w3r, float w3i) {
+    const size_t b = a + q;
+    const size_t c = b + q;
+    const size_t d = c + q;
+    const float br = re[b] * w2r - im[b] * w2i;
+    const float bi = re[b] * w2i + im[b] * w2r;
+    const float cr = re[c] * w1r - im[c] * w1i;
+    const float ci = re[c] * w1i + im[c] * w1r;
+    const float dr = re[d] * w3r - im[d] * w3i;
+    const float di = re[d] * w3i + im[d] * w3r;
+    const float t0r = re[a] + br, t0i = im[a] + bi;
+    const float t1r = re[a] - br, t1i = im[a] - bi;
+    const float t2r = cr + dr, t2i = ci + di;
+    const float t3r = cr - dr, t3i = ci - di;
+    re[a] = t0r + t2r;
+    im[a] = t0i + t2i;
+    re[b] = t1r + t3i;
+    im[b] = t1i - t3r;
+    re[c] = t0r - t2r;
+    im[c] = t0i - t2i;
+    re[d] = t1r - t3i;
+    im[d] = t1i + t3r;
+}
+
+#if defined(SHADERLAB_AUDIO_SSE)
+// Four neighbouring butterflies of one block; q is a multiple of 4.
+void Butterfly4Block(float* re, float* im, size_t base, size_t q, const float* tw) {
+    for (size_t k = 0; k < q; k += 4) {
+        const size_t a = base + k;
+        const size_t b = a + q;
+        const size_t c = b + q;
+        const size_t d = c + q;
+        const __m128 w1r = _mm_loadu_ps(tw + k);
+        const __m128 w1i = _mm_loadu_ps(tw + q + k);
+        const __m128 w2r = _mm_loadu_ps(tw + 2 * q + k);
+        const __m128 w2i = _mm_loadu_ps(tw + 3 * q + k);
+        const __m128 w3r = _mm_loadu_ps(tw + 4 * q + k);
+        const __m128 w3i = _mm_loadu_ps(tw + 5 * q + k);
+
+        const __m128 ar = _mm_loadu_ps(re + a), ai = _mm_loadu_ps(im + a);
+        const __m128 xbr = _mm_loadu_ps(re + b), xbi = _mm_loadu_ps(im + b);
+        const __m128 xcr = _mm_loadu_ps(re + c), xci = _mm_loadu_ps(im + c);
+        const __m128 xdr = _mm_loadu_ps(re + d), xdi = _mm_loadu_ps(im + d);
+        const __m128 br = _mm_sub_ps(_mm_mul_ps(xbr, w2r), _mm_mul_ps(xbi, w2i));
+        const __m128 bi = _mm_add_ps(_mm_mul_ps(xbr, w2i), _mm_mul_ps(xbi, w2r));
+        const __m128 cr = _mm_sub_ps(_mm_mul_ps(xcr, w1r), _mm_mul_ps(xci, w1i));
+        const __m128 ci = _mm_add_ps(_mm_mul_ps(xcr, w1i), _mm_mul_ps(xci, w1r));
+        const __m128 dr = _mm_sub_ps(_mm_mul_ps(xdr, w3r), _mm_mul_ps(xdi, w3i));
+        const __m128 di = _mm_add_ps(_mm_mul_ps(xdr, w3i), _mm_mul_ps(xdi, w3r));
+
+        const __m128 t0r = _mm_add_ps(ar, br), t0i = _mm_add_ps(ai, bi);
+        const __m128 t1r = _mm_sub_ps(ar, br), t1i = _mm_sub_ps(ai, bi);
+        const __m128 t2r = _mm_add_ps(cr, dr), t2i = _mm_add_ps(ci, di);
+        const __m128 t3r = _mm_sub_ps(cr, dr), t3i = _mm_sub_ps(ci, di);
+        _mm_storeu_ps(re + a, _mm_add_ps(t0r, t2r));
+        _mm_storeu_ps(im + a, _mm_add_ps(t0i, t2i));
+        _mm_storeu_ps(re + b, _mm_add_ps(t1r, t3i));
+        _mm_storeu_ps(im + b, _mm_sub_ps(t1i, t3r));
+        _mm_storeu_ps(re + c, _mm_sub_ps(t0r, t2r));
+        _mm_storeu_ps(im + c, _mm_sub_ps(t0i, t2i));
+        _mm_storeu_ps(re + d, _mm_sub_ps(t1r, t3i));
+        _mm_storeu_ps(im + d, _mm_add_ps(t1i, t3r));
+    }
+}
+#endif
+
+} // namespace
+
+AudioSampleRing::AudioSampleRing(size_t capacity) {
+    if (capacity > 0) {
+        size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        m_buffer.resize(rounded);
+        m_mask = rounded - 1;
+    }
+}
+
+size_t AudioSampleRing::Push(const float* samples, size_t count) {
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    const uint64_t tail = m_tail.load(std::memory_order_acquire);
+    const size_t written = (std::min)(count, m_buffer.size() - static_cast<size_t>(head - tail));
+    const size_t start = static_cast<size_t>(head) & m_mask;
+    const size_t first = (std::min)(written, m_buffer.size() - start);
+    if (written > 0) {
+        std::memcpy(m_buffer.data() + start, samples, first * sizeof(float));
+        std::memcpy(m_buffer.data(), samples + first, (written - first) * sizeof(float));
+    }
+    m_head.store(head + written, std::memory_order_release);
+    if (written < count) {
+        m_dropped.fetch_add(count - written, std::memory_order_relaxed);
+    }
+    return written;
+}
+
+size_t AudioSampleRing::PushInterleaved(const float* frames, size_t frameCount, uint32_t channels) {
+    if (channels <= 1) {
+        return Push(frames, frameCount);
+    }
+    const uint64_t head = m_head.load(std::memory_order_relaxed);
+    const uint64_t tail = m_tail.load(std::memory_order_acquire);
+    const size_t written = (std::min)(frameCount, m_buffer.size() - static_cast<size_t>(head - tail));
+    const float scale = 1.0f / static_cast<float>(channels);
+    for (size_t i = 0; i < written; ++i) {
+        const float* frame = frames + i * channels;
+        float sum = 0.0f;
+        for (uint32_t c = 0; c < channels; ++c) {
+            sum += frame[c];
+        }
+        m_buffer[static_cast<size_t>(head + i) & m_mask] = sum * scale;
+    }
+    m_head.store(head + written, std::memory_order_release);
+    if (written < frameCount) {
+        m_dropped.fetch_add(frameCount - written, std::memory_order_relaxed);
+    }
+    return written;
+}
+
+size_t AudioSampleRing::Pop(float* outSamples, size_t count) {
+    const uint64_t tail = m_tail.load(std::memory_order_relaxed);
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const size_t read = (std::min)(count, static_cast<size_t>(head - tail));
+    const size_t start = static_cast<size_t>(tail) & m_mask;
+    const size_t first = (std::min)(read, m_buffer.size() - start);
+    if (read > 0) {
+        std::memcpy(outSamples, m_buffer.data() + start, first * sizeof(float));
+        std::memcpy(outSamples + first, m_buffer.data(), (read - first) * sizeof(float));
+    }
+    m_tail.store(tail + read, std::memory_order_release);
+    return read;
+}
+
+size_t AudioSampleRing::GetReadable() const {
+    return static_cast<size_t>(m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed));
+}
+
+bool AudioFft::Initialize(uint32_t size, std::string& outError) {
+    if (size < 4 || !IsPowerOfTwo(size)) {
+        outError = "FFT size must be a power of two of at least 4.";
+        return false;
+    }
+    uint32_t bits = 0;
+    while ((1u << bits) < size) {
+        ++bits;
+    }
+    m_size = size;
+    m_radix2First = (bits & 1u) != 0;
+    m_bitReverse.resize(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        uint32_t reversed = 0;
+        for (uint32_t bit = 0; bit < bits; ++bit) {
+            reversed |= ((i >> bit) & 1u) << (bits - 1u - bit);
+        }
+        m_bitReverse[i] = reversed;
+    }
+
+    m_passes.clear();
+    m_twiddles.clear();
+    for (uint32_t quarter = m_radix2First ? 2u : 1u; quarter < size; quarter *= 4u) {
+        Pass pass;
+        pass.quarter = quarter;
+        pass.twiddleOffset = m_twiddles.size();
+        m_twiddles.resize(m_twiddles.size() + static_cast<size_t>(quarter) * 6u);
+        float* tw = m_twiddles.data() + pass.twiddleOffset;
+        for (uint32_t k = 0; k < quarter; ++k) {
+            const double angle = -2.0 * kPi * k / (4.0 * quarter);
+            tw[k] = static_cast<float>(std::cos(angle));
+            tw[quarter + k] = static_cast<float>(std::sin(angle));
+            tw[2 * quarter + k] = static_cast<float>(std::cos(2.0 * angle));
+            tw[3 * quarter + k] = static_cast<float>(std::sin(2.0 * angle));
+            tw[4 * quarter + k] = static_cast<float>(std::cos(3.0 * angle));
+            tw[5 * quarter + k] = static_cast<float>(std::sin(3.0 * angle));
+        }
+        m_passes.push_back(pass);
+    }
+    return true;
+}
+
+void AudioFft::Forward(float* re, float* im) const {
+    for (uint32_t i = 0; i < m_size; ++i) {
+        const uint32_t j = m_bitReverse[i];
+        if (i < j) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+    if (m_radix2First) {
+        for (uint32_t i = 0; i < m_size; i += 2) {
+            const float r = re[i + 1];
+            const float m = im[i + 1];
+            re[i + 1] = re[i] - r;
+            im[i + 1] = im[i] - m;
+            re[i] += r;
+            im[i] += m;
+        }
+    }
+    for (const Pass& pass : m_passes) {
+        const size_t q = pass.quarter;
+        const float* tw = m_twiddles.data() + pass.twiddleOffset;
+        for (size_t base = 0; base < m_size; base += 4 * q) {
+#if defined(SHADERLAB_AUDIO_SSE)
+            if (q % 4 == 0) {
+                Butterfly4Block(re, im, base, q, tw);
+                continue;
+            }
+#endif
+            for (size_t k = 0; k < q; ++k) {
+                Butterfly4(re, im, base + k, q, tw[k], tw[q + k], tw[2 * q + k], tw[3 * q + k], tw[4 * q + k], tw[5 * q + k]);
+            }
+        }
+    }
+}
+
+AudioAnalyzer::AudioAnalyzer() = default;
+
+AudioAnalyzer::~AudioAnalyzer() {
+    Stop();
+}
+
+bool AudioAnalyzer::Configure(const AudioAnalyzerConfig& config, std::string& outError) {
+    if (config.sampleRate == 0 || config.hopSize == 0 || config.hopSize > config.fftSize ||
+        config.bandCount == 0 || config.bandCount > kMaxAudioBands ||
+        !(config.minFrequency > 0.0f) || !(config.maxFrequency > config.minFrequency) || !(config.floorDb < 0.0f)) {
+        outError = "Invalid audio analyzer configuration.";
+        return false;
+    }
+    AudioFft fft;
+    if (!fft.Initialize(config.fftSize, outError)) {
+        return false;
+    }
+    Stop();
+
+    m_config = config;
+    m_config.maxFrequency = (std::min)(config.maxFrequency, config.sampleRate * 0.5f);
+    m_config.minFrequency = (std::min)(config.minFrequency, m_config.maxFrequency * 0.5f);
+    m_fft = std::move(fft);
+    m_ring = std::make_unique<AudioSampleRing>((std::max)(config.ringCapacity, static_cast<size_t>(config.fftSize) * 2u));
+
+    const uint32_t n = config.fftSize;
+    const uint32_t bins = n / 2u;
+    m_window.assign(n, 0.0f);
+    m_re.assign(n, 0.0f);
+    m_im.assign(n, 0.0f);
+    m_hann.resize(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        m_hann[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / n));
+    }
+    m_magnitude.assign(bins, 0.0f);
+    m_previousMagnitude.assign(bins, 0.0f);
+
+    // Bins belong to the band their centre frequency falls in; bands narrower than a bin take
+    // the nearest one.
+    const float binHz = static_cast<float>(config.sampleRate) / n;
+    m_bandFirstBin.resize(config.bandCount);
+    m_bandLastBin.resize(config.bandCount);
+    for (uint32_t band = 0; band < config.bandCount; ++band) {
+        float lowHz = 0.0f;
+        float highHz = 0.0f;
+        GetBandRange(band, lowHz, highHz);
+        uint32_t first = (std::max)(1u, static_cast<uint32_t>(std::ceil(lowHz / binHz)));
+        uint32_t last = (std::min)(bins, static_cast<uint32_t>(std::ceil(highHz / binHz)));
+        if (last <= first) {
+            first = (std::min)(bins - 1u, (std::max)(1u, static_cast<uint32_t>(std::lround(std::sqrt(lowHz * highHz) / binHz))));
+            last = first + 1u;
+        }
+        m_bandFirstBin[band] = first;
+        m_bandLastBin[band] = last;
+    }
+
+    m_samplesConsumed = 0;
+    m_fluxMean = 0.0f;
+    m_onsetEnvelope = 0.0f;
+    m_hopsSinceOnset = 0;
+    m_resetPending = false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_latest = AudioAnalysisFrame();
+    m_latest.bandCount = config.bandCount;
+    m_stats = AudioAnalyzerStats();
+    return true;
+}
+
+void AudioAnalyzer::GetBandRange(uint32_t band, float& outLowHz, float& outHighHz) const {
+    const float ratio = m_config.maxFrequency / m_config.minFrequency;
+    const float count = static_cast<float>(m_config.bandCount);
+    outLowHz = m_config.minFrequency * std::pow(ratio, band / count);
+    outHighHz = m_config.minFrequency * std::pow(ratio, (band + 1u) / count);
+}
+
+void AudioAnalyzer::Start() {
+    if (!m_ring || m_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = false;
+    }
+    m_worker = std::thread([this]() { WorkerMain(); });
+}
+
+void AudioAnalyzer::Stop() {
+    if (!m_worker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_worker.join();
+}
+
+size_t AudioAnalyzer::Pump() {
+    return m_worker.joinable() ? 0 : AnalyzeAvailable();
+}
+
+void AudioAnalyzer::Reset() {
+    m_resetPending = true;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t bandCount = m_latest.bandCount;
+    m_latest = AudioAnalysisFrame();
+    m_latest.bandCount = bandCount;
+}
+
+bool AudioAnalyzer::GetLatest(AudioAnalysisFrame& outFrame) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    outFrame = m_latest;
+    return m_latest.sequence > 0;
+}
+
+AudioShaderBlock AudioAnalyzer::GetShaderBlock() const {
+    AudioShaderBlock block;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    block.rms = m_latest.rms;
+    block.onset = m_latest.onset;
+    block.peak = m_latest.peak;
+    const uint32_t count = m_latest.bandCount;
+    if (count == 0) {
+        return block;
+    }
+    for (uint32_t i = 0; i < kAudioShaderBands; ++i) {
+        const uint32_t first = i * count / kAudioShaderBands;
+        const uint32_t last = (std::max)(first + 1u, (i + 1u) * count / kAudioShaderBands);
+        float sum = 0.0f;
+        for (uint32_t band = first; band < last; ++band) {
+            sum += m_latest.bands[band];
+        }
+        block.bands[i] = sum / static_cast<float>(last - first);
+    }
+    return block;
+}
+
+AudioAnalyzerStats AudioAnalyzer::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AudioAnalyzerStats stats = m_stats;
+    stats.droppedSamples = m_ring ? m_ring->GetDroppedSamples() : 0;
+    return stats;
+}
+
+void AudioAnalyzer::WorkerMain() {
+    // The audio thread never signals; the worker polls about twice per hop.
+    const auto interval = std::chrono::microseconds(
+        (std::max)(static_cast<int64_t>(500), static_cast<int64_t>(500000.0 * m_config.hopSize / m_config.sampleRate)));
+    for (;;) {
+        AnalyzeAvailable();
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        if (m_wake.wait_for(lock, interval, [this]() { return m_stop; })) {
+            return;
+        }
+    }
+}
+
+size_t AudioAnalyzer::AnalyzeAvailable() {
+    size_t hops = 0;
+    while (m_ring && m_ring->GetReadable() >= m_config.hopSize) {
+        AnalyzeHop();
+        ++hops;
+    }
+    return hops;
+}
+
+void AudioAnalyzer::AnalyzeHop() {
+    const auto start = std::chrono::steady_clock::now();
+    const uint32_t n = m_config.fftSize;
+    const uint32_t hop = m_config.hopSize;
+    const uint32_t bins = n / 2u;
+
+    if (m_resetPending.exchange(false)) {
+        std::fill(m_window.begin(), m_window.end(), 0.0f);
+        std::fill(m_previousMagnitude.begin(), m_previousMagnitude.end(), 0.0f);
+        m_fluxMean = 0.0f;
+        m_onsetEnvelope = 0.0f;
+        m_hopsSinceOnset = 0;
+    }
+
+    std::memmove(m_window.data(), m_window.data() + hop, static_cast<size_t>(n - hop) * sizeof(float));
+    float* fresh = m_window.data() + (n - hop);
+    m_ring->Pop(fresh, hop);
+    m_samplesConsumed += hop;
+
+    float sumSquares = 0.0f;
+    float peak = 0.0f;
+    for (uint32_t i = 0; i < hop; ++i) {
+        sumSquares += fresh[i] * fresh[i];
+        peak = (std::max)(peak, std::fabs(fresh[i]));
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        m_re[i] = m_window[i] * m_hann[i];
+        m_im[i] = 0.0f;
+    }
+    m_fft.Forward(m_re.data(), m_im.data());
+
+    // A full-scale sine peaks at n / 4 through the Hann window.
+    const float scale = 4.0f / static_cast<float>(n);
+    float flux = 0.0f;
+    for (uint32_t k = 0; k < bins; ++k) {
+        const float magnitude = std::sqrt(m_re[k] * m_re[k] + m_im[k] * m_im[k]) * scale;
+        m_magnitude[k] = magnitude;
+        // Log compression keeps quiet passages from hiding onsets behind loud sustained notes.
+        const float rise = std::log1p(100.0f * magnitude) - std::log1p(100.0f * m_previousMagnitude[k]);
+        flux += (std::max)(rise, 0.0f);
+    }
+    flux /= static_cast<float>(bins);
+    m_previousMagnitude.swap(m_magnitude);
+
+    const float hopSeconds = static_cast<float>(hop) / static_cast<float>(m_config.sampleRate);
+    const uint32_t minGapHops = (std::max)(1u, static_cast<uint32_t>(std::ceil(0.05f / hopSeconds)));
+    const bool triggered = flux > m_config.onsetMinFlux && flux > m_fluxMean * m_config.onsetSensitivity &&
+                           m_hopsSinceOnset >= minGapHops;
+    m_hopsSinceOnset = triggered ? 0u : m_hopsSinceOnset + 1u;
+    const float meanBlend = (std::min)(1.0f, hopSeconds / 0.5f);
+    m_fluxMean += (flux - m_fluxMean) * meanBlend;
+    m_onsetEnvelope = triggered ? 1.0f : m_onsetEnvelope * std::exp(-hopSeconds / (std::max)(m_config.onsetRelease, 1e-3f));
+
+    AudioAnalysisFrame frame;
+    frame.timeSeconds = static_cast<double>(m_samplesConsumed) / m_config.sampleRate;
+    frame.rms = std::sqrt(sumSquares / static_cast<float>(hop));
+    frame.peak = peak;
+    frame.flux = flux;
+    frame.onset = m_onsetEnvelope;
+    frame.onsetTriggered = triggered;
+    frame.bandCount = m_config.bandCount;
+    // Band power is summed, so a sine keeps its level however its energy spreads over bins; the
+    // Hann main lobe holds 1.5x the peak bin's power.
+    for (uint32_t band = 0; band < m_config.bandCount; ++band) {
+        float power = 0.0f;
+        for (uint32_t k = m_bandFirstBin[band]; k < m_bandLastBin[band]; ++k) {
+            power += m_previousMagnitude[k] * m_previousMagnitude[k];
+        }
+        const float amplitude = std::sqrt(power / 1.5f);
+        const float db = 20.0f * std::log10((std::max)(amplitude, 1e-9f));
+        frame.bands[band] = (std::min)(1.0f, (std::max)(0.0f, (db - m_config.floorDb) / -m_config.floorDb));
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    frame.sequence = m_latest.sequence + 1u;
+    m_latest = frame;
+    m_stats.hops += 1u;
+    m_stats.samples += hop;
+    m_stats.onsets += triggered ? 1u : 0u;
+    m_stats.analyzeMs += ms;
+}
+
+} // namespace ShaderLab
@@ -19,6 +19,11 @@
 #include "ShaderLab/Shader/ShaderBaseVertex.h"
 #include "ShaderLab/Shader/ShaderCompiler.h"
 
+// Private copy: the build tools link without the editor, which owns the shared implementation.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
 namespace ShaderLab {
 
 namespace fs = std::filesystem;
@@ -2019,6 +2024,48 @@ bool RunCommand(const std::string& command, const std::function<void(const std::
 
     return exitCode == 0;
 }
+
+// Bakes a staged image into a .sltex next to it. Cube and volume bakes get their own name so one
+// image can feed channels of different types.
+bool BakeStagedTexture(const fs::path& stagedAbsolute,
+                       TextureType type,
+                       const TextureBakeOptions& options,
+                       fs::path& outBakedAbsolute,
+                       TextureBakeStats& outStats,
+                       std::string& outError) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    stbi_uc* pixels = stbi_load(stagedAbsolute.string().c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        const char* reason = stbi_failure_reason();
+        outError = std::string("decode failed: ") + (reason ? reason : "unknown");
+        return false;
+    }
+    DecodedImage image;
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    image.rgba.assign(pixels, pixels + static_cast<size_t>(width) * height * 4u);
+    stbi_image_free(pixels);
+
+    BakedTextureDimension dimension = BakedTextureDimension::Texture2D;
+    std::string suffix = ".sltex";
+    if (type == TextureType::TextureCube) {
+        dimension = BakedTextureDimension::TextureCube;
+        suffix = ".cube.sltex";
+    } else if (type == TextureType::Texture3D) {
+        dimension = BakedTextureDimension::Texture3D;
+        suffix = ".3d.sltex";
+    }
+
+    std::vector<uint8_t> baked;
+    if (!BakeTexture(image, dimension, options, baked, outError, &outStats)) {
+        return false;
+    }
+    outBakedAbsolute = stagedAbsolute;
+    outBakedAbsolute.replace_filename(stagedAbsolute.stem().string() + suffix);
+    return WriteBinaryFile(outBakedAbsolute, baked, outError);
+}
 } // namespace
 
 BuildPrereqReport BuildPipeline::CheckPrereqs(const std::string& appRoot, BuildMode mode) {
@@ -2974,24 +3021,62 @@ BuildResult BuildPipeline::BuildSelfContained(
     if (originalFileBindingPaths.empty()) {
         log("  Textures: none");
     } else {
+        // Textures ship as .sltex with mips and block compression done here, so the player only
+        // copies them into an upload buffer. A texture that fails to bake ships as is.
+        TextureBakeOptions bakeOptions;
+        bakeOptions.format = request.textureFormat;
+        bakeOptions.generateMips = request.textureMips;
+        std::unordered_map<std::string, std::string> bakedPaths;
+        uint64_t bakedSourceBytes = 0;
+        uint64_t bakedBytes = 0;
         for (const auto& snapshot : originalFileBindingPaths) {
             if (snapshot.sceneIndex >= project.scenes.size()) {
                 continue;
             }
-            const auto& scene = project.scenes[snapshot.sceneIndex];
+            auto& scene = project.scenes[snapshot.sceneIndex];
             if (snapshot.bindingIndex >= scene.bindings.size()) {
                 continue;
             }
-            const auto& binding = scene.bindings[snapshot.bindingIndex];
+            auto& binding = scene.bindings[snapshot.bindingIndex];
             const fs::path stagedAbsolute = packRoot / fs::path(binding.filePath);
             std::error_code existsEc;
             const bool stagedExists = fs::exists(stagedAbsolute, existsEc);
+            std::string bakeNote;
             if (stagedExists) {
                 ++textureStagedCount;
-                extraFiles.push_back({stagedAbsolute.string(), binding.filePath});
+                const std::string bakeKey = binding.filePath + "|" + std::to_string(static_cast<int>(binding.type));
+                auto baked = bakedPaths.find(bakeKey);
+                if (baked == bakedPaths.end()) {
+                    fs::path bakedAbsolute;
+                    TextureBakeStats bakeStats;
+                    std::string bakeError;
+                    std::string packedPath = binding.filePath;
+                    if (BakeStagedTexture(stagedAbsolute, binding.type, bakeOptions, bakedAbsolute, bakeStats, bakeError)) {
+                        packedPath = fs::path(binding.filePath).replace_filename(bakedAbsolute.filename()).generic_string();
+                        extraFiles.push_back({bakedAbsolute.string(), packedPath});
+                        bakedSourceBytes += bakeStats.sourceBytes;
+                        bakedBytes += bakeStats.payloadBytes;
+                        char note[160];
+                        std::snprintf(note, sizeof(note), " [baked %s%s, %u mips, %.1f KB, %.0f ms]",
+                                      bakeStats.formatFallback ? "rgba8 (not 4x4 aligned)" : GetBakedTextureFormatName(bakeOptions.format),
+                                      bakeOptions.format == BakedTextureFormat::BC4 && !bakeStats.formatFallback ? " red only" : "",
+                                      bakeStats.mipLevels, static_cast<double>(bakeStats.payloadBytes) / 1024.0,
+                                      bakeStats.mipMs + bakeStats.encodeMs);
+                        bakeNote = note;
+                    } else {
+                        extraFiles.push_back({stagedAbsolute.string(), binding.filePath});
+                        bakeNote = " [not baked: " + bakeError + "]";
+                    }
+                    baked = bakedPaths.emplace(bakeKey, packedPath).first;
+                }
+                binding.filePath = baked->second;
             }
             log("  Texture[scene " + std::to_string(snapshot.sceneIndex) + ", ch " + std::to_string(binding.channelIndex) + "]: " +
-                snapshot.path + " -> " + binding.filePath + (stagedExists ? " [staged]" : " [missing]"));
+                snapshot.path + " -> " + binding.filePath + (stagedExists ? " [staged]" : " [missing]") + bakeNote);
+        }
+        if (bakedBytes > 0) {
+            log("  Baked textures: " + std::to_string(bakedSourceBytes / 1024) + " KB RGBA8 -> " +
+                std::to_string(bakedBytes / 1024) + " KB with mips");
         }
     }
     log("  Summary: audio staged " + std::to_string(audioStagedCount) + "/" + std::to_string(audioTotalCount) +
@@ -0,0 +1,197 @@
+#include "ShaderLab/Core/CompactTrack.h"
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+namespace ShaderLab {
+namespace CompactTrack {
+
+namespace {
+
+constexpr uint16_t kMagic0 = 0x4B54u; // 'TK'
+constexpr uint16_t kMagicV2 = 0x3252u; // 'R2'
+constexpr uint16_t kMagicV3 = 0x3352u; // 'R3'
+constexpr size_t kHeaderV2Size = 10;
+constexpr size_t kHeaderV3Size = 14;
+constexpr size_t kRowSize = 9;
+
+constexpr const char* kTransitionSlotStems[kTransitionSlotCount] = {
+    "crossfade",
+    "dip_to_black",
+    "fade_out",
+    "fade_in",
+    "glitch",
+    "pixelate"
+};
+
+constexpr uint8_t kFullscreenPresetCount = 10;
+
+} // namespace
+
+const char* TransitionStemForSlot(uint8_t slot) {
+    if (slot >= kTransitionSlotCount) {
+        return nullptr;
+    }
+    return kTransitionSlotStems[slot];
+}
+
+FullscreenRenderResolutionPreset FullscreenPresetFromByte(uint8_t value) {
+    const uint8_t resolutionBits = static_cast<uint8_t>(value & 0x0Fu);
+    if (resolutionBits >= kFullscreenPresetCount) {
+        return FullscreenRenderResolutionPreset::Full;
+    }
+    return static_cast<FullscreenRenderResolutionPreset>(resolutionBits);
+}
+
+RenderAspectRatioPreset AspectPresetFromByte(uint8_t value) {
+    const uint8_t aspectBits = static_cast<uint8_t>((value >> 4u) & 0x03u);
+    if (aspectBits > static_cast<uint8_t>(RenderAspectRatioPreset::Ratio_4_3)) {
+        return RenderAspectRatioPreset::Ratio_16_9;
+    }
+    return static_cast<RenderAspectRatioPreset>(aspectBits);
+}
+
+bool Decode(const std::vector<uint8_t>& bytes, DemoTrack& outTrack, Metadata* outMeta, std::string& outError) {
+    outError.clear();
+    if (bytes.size() < kHeaderV2Size) {
+        outError = "Compact track binary too small.";
+        return false;
+    }
+
+    const auto readU16 = [&bytes](size_t offset) -> uint16_t {
+        return static_cast<uint16_t>(bytes[offset]) |
+               static_cast<uint16_t>(static_cast<uint16_t>(bytes[offset + 1]) << 8);
+    };
+    const auto readI16 = [&readU16](size_t offset) -> int16_t {
+        return static_cast<int16_t>(readU16(offset));
+    };
+    const auto readI8 = [&bytes](size_t offset) -> int8_t {
+        return static_cast<int8_t>(bytes[offset]);
+    };
+
+    const uint16_t magic0 = readU16(0);
+    const uint16_t magic1 = readU16(2);
+    if (magic0 != kMagic0 || (magic1 != kMagicV2 && magic1 != kMagicV3)) {
+        outError = "Compact track binary has invalid magic.";
+        return false;
+    }
+    const bool isV3 = (magic1 == kMagicV3);
+
+    const uint16_t bpmQ8 = readU16(4);
+    const uint16_t lengthBeats = readU16(6);
+    const uint16_t rowCount = readU16(8);
+
+    Metadata decodedMeta;
+    size_t offset = isV3 ? kHeaderV3Size : kHeaderV2Size;
+
+    if (isV3) {
+        if (bytes.size() < kHeaderV3Size) {
+            outError = "Compact track binary header truncated.";
+            return false;
+        }
+
+        const uint16_t sceneCount = readU16(10);
+        const uint8_t transitionSlotCount = bytes[12];
+        const uint8_t compactRenderConfig = bytes[13];
+        if (transitionSlotCount < kTransitionSlotCount) {
+            outError = "Compact track binary transition map is invalid.";
+            return false;
+        }
+
+        decodedMeta.sceneCount = static_cast<int>(sceneCount);
+        decodedMeta.sceneModuleIndices.resize(sceneCount, -1);
+        decodedMeta.postFxModuleIndices.resize(sceneCount);
+        decodedMeta.fullscreenRenderResolutionPreset = FullscreenPresetFromByte(compactRenderConfig);
+        decodedMeta.renderAspectRatioPreset = AspectPresetFromByte(compactRenderConfig);
+
+        for (size_t i = 0; i < kTransitionSlotCount; ++i) {
+            if (offset + 2 > bytes.size()) {
+                outError = "Compact track binary transition map truncated.";
+                return false;
+            }
+            decodedMeta.transitionModuleIndices[i] = readI16(offset);
+            offset += 2;
+        }
+
+        for (uint16_t sceneIndex = 0; sceneIndex < sceneCount; ++sceneIndex) {
+            if (offset + 4 > bytes.size()) {
+                outError = "Compact track binary scene map truncated.";
+                return false;
+            }
+
+            const int16_t sceneModule = readI16(offset);
+            offset += 2;
+            const uint16_t fxCount = readU16(offset);
+            offset += 2;
+
+            decodedMeta.sceneModuleIndices[sceneIndex] = sceneModule;
+            auto& fxModules = decodedMeta.postFxModuleIndices[sceneIndex];
+            fxModules.resize(fxCount, -1);
+            for (uint16_t fxIndex = 0; fxIndex < fxCount; ++fxIndex) {
+                if (offset + 2 > bytes.size()) {
+                    outError = "Compact track binary post FX map truncated.";
+                    return false;
+                }
+                fxModules[fxIndex] = readI16(offset);
+                offset += 2;
+            }
+        }
+    }
+
+    const size_t expectedSize = offset + static_cast<size_t>(rowCount) * kRowSize;
+    if (bytes.size() < expectedSize) {
+        outError = "Compact track binary truncated.";
+        return false;
+    }
+
+    DemoTrack decoded;
+    decoded.name = "CompactTrack";
+    decoded.bpm = static_cast<float>(bpmQ8) / 256.0f;
+    decoded.lengthBeats = static_cast<int>(lengthBeats);
+    decoded.rows.reserve(rowCount);
+
+    for (uint32_t i = 0; i < rowCount; ++i) {
+        const int16_t rowId = readI16(offset); offset += 2;
+        const int16_t sceneIndex = readI16(offset); offset += 2;
+        const uint8_t transition = bytes[offset++];
+        const uint8_t flags = bytes[offset++];
+        const uint8_t transitionDurationQ4 = bytes[offset++];
+        const int8_t timeOffsetQ4 = readI8(offset++);
+        const int8_t musicIndex = readI8(offset++);
+
+        TrackerRow row;
+        row.rowId = static_cast<int>(rowId);
+        row.sceneIndex = static_cast<int>(sceneIndex);
+        row.transitionPresetStem.clear();
+        if (const char* stem = TransitionStemForSlot(transition)) {
+            row.transitionPresetStem = stem;
+        }
+        row.transitionDuration = static_cast<float>(transitionDurationQ4) / 16.0f;
+        row.timeOffset = static_cast<float>(timeOffsetQ4) / 16.0f;
+        row.musicIndex = static_cast<int>(musicIndex);
+        row.oneShotIndex = -1;
+        row.stop = (flags & 0x1u) != 0;
+        row.isBeat = false;
+        decoded.rows.Insert(row);
+    }
+
+    outTrack = std::move(decoded);
+    if (outMeta) {
+        *outMeta = std::move(decodedMeta);
+    }
+    return true;
+}
+
+bool LoadFromFile(const std::string& path, DemoTrack& outTrack, Metadata* outMeta, std::string& outError) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        outError = "Failed to open compact track binary file.";
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Decode(bytes, outTrack, outMeta, outError);
+}
+
+}
+}
@@ -0,0 +1,325 @@
+#include "ShaderLab/Core/DemoSequencer.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+
+void DemoSequencer::Reset() {
+    m_state = SequencerState{};
+    m_events.clear();
+}
+
+void DemoSequencer::ResetTransition(bool clearActiveScene) {
+    m_state.transitionActive = false;
+    m_state.pendingActiveScene = SequencerState::kNoPendingScene;
+    m_state.transitionFromIndex = -1;
+    m_state.transitionToIndex = -1;
+    m_state.transitionFromOffset = 0.0f;
+    m_state.transitionToOffset = 0.0f;
+    m_state.transitionStartBeat = 0.0;
+    m_state.transitionDurationBeats = 1.0;
+    m_state.transitionPresetStem.clear();
+    m_state.transitionFromStartBeat = 0.0;
+    m_state.transitionToStartBeat = 0.0;
+    m_state.transitionJustCompletedBeat = -1;
+
+    if (clearActiveScene) {
+        m_state.activeSceneIndex = -1;
+        m_state.activeSceneOffset = 0.0f;
+        m_state.activeSceneStartBeat = 0.0;
+    }
+}
+
+void DemoSequencer::SetActiveScene(int sceneIndex, float offsetBeats, double startBeat) {
+    if (sceneIndex < 0 || (m_sceneCount >= 0 && sceneIndex >= m_sceneCount)) {
+        sceneIndex = -1;
+    }
+    m_state.activeSceneIndex = sceneIndex;
+    m_state.activeSceneOffset = offsetBeats;
+    m_state.activeSceneStartBeat = startBeat;
+}
+
+void DemoSequencer::BeginTransition(int beat,
+                                    double durationBeats,
+                                    int targetSceneIndex,
+                                    float targetOffset,
+                                    double targetStartBeat,
+                                    const std::string& transitionPresetStem) {
+    m_state.transitionActive = true;
+    m_state.transitionFromIndex = m_state.activeSceneIndex;
+    m_state.transitionFromOffset = m_state.activeSceneOffset;
+    m_state.transitionFromStartBeat = m_state.activeSceneStartBeat;
+
+    m_state.transitionToStartBeat = targetStartBeat;
+    m_state.transitionToIndex = targetSceneIndex;
+    m_state.transitionToOffset = targetOffset;
+    m_state.transitionStartBeat = static_cast<double>(beat);
+    m_state.transitionDurationBeats = durationBeats;
+    m_state.transitionPresetStem = transitionPresetStem;
+
+    m_state.pendingActiveScene = targetSceneIndex;
+}
+
+bool DemoSequencer::CompleteDueTransition(double exactBeat, int currentBeat) {
+    if (!m_state.transitionActive) {
+        return false;
+    }
+
+    const double transitionEndBeat = m_state.transitionStartBeat + m_state.transitionDurationBeats;
+    if (exactBeat < transitionEndBeat) {
+        return false;
+    }
+
+    m_state.transitionActive = false;
+    if (m_state.pendingActiveScene == SequencerState::kNoPendingScene) {
+        return false;
+    }
+
+    const int target = m_state.pendingActiveScene;
+    SetActiveScene(target, target >= 0 ? m_state.transitionToOffset : 0.0f, m_state.transitionToStartBeat);
+    m_state.pendingActiveScene = SequencerState::kNoPendingScene;
+    m_state.transitionJustCompletedBeat = currentBeat;
+    return true;
+}
+
+float DemoSequencer::GetTransitionProgress(double exactBeat) const {
+    if (!m_state.transitionActive) {
+        return 0.0f;
+    }
+    if (m_state.transitionDurationBeats <= 0.0) {
+        return 1.0f;
+    }
+    const double progress = (exactBeat - m_state.transitionStartBeat) / m_state.transitionDurationBeats;
+    return static_cast<float>((std::clamp)(progress, 0.0, 1.0));
+}
+
+bool DemoSequencer::HasStopRow(const DemoTrack& track) const {
+    for (const auto& row : track.rows) {
+        if (row.stop) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DemoSequencer::ApplySceneEvent(const DemoTrack& track,
+                                    const PlaybackEvent& event,
+                                    std::vector<SequencerCommand>& outCommands) {
+    if (!event.transitionPresetStem.empty() && event.transitionDuration > 0.0f) {
+        const SceneTransitionResolution target = m_playback.ResolveSceneTransitionTarget(
+            track,
+            event,
+            m_state.activeSceneIndex,
+            m_state.activeSceneOffset,
+            m_state.activeSceneStartBeat);
+
+        BeginTransition(
+            event.beat,
+            static_cast<double>(event.transitionDuration),
+            target.targetSceneIndex,
+            target.targetOffset,
+            target.targetStartBeat,
+            event.transitionPresetStem);
+
+        SequencerCommand command;
+        command.type = SequencerCommandType::TransitionBegin;
+        command.beat = event.beat;
+        command.rowId = event.rowId;
+        command.sceneIndex = m_state.transitionToIndex;
+        command.fromSceneIndex = m_state.transitionFromIndex;
+        command.durationBeats = event.transitionDuration;
+        command.transitionPresetStem = event.transitionPresetStem;
+        outCommands.push_back(std::move(command));
+        return;
+    }
+
+    if (event.sceneIndex < 0) {
+        return;
+    }
+    if (m_state.transitionJustCompletedBeat == event.rowId && event.sceneIndex == m_state.activeSceneIndex) {
+        return;
+    }
+    if (m_state.transitionActive && event.sceneIndex == m_state.pendingActiveScene) {
+        return;
+    }
+    if (m_sceneCount >= 0 && event.sceneIndex >= m_sceneCount) {
+        return;
+    }
+
+    m_state.transitionActive = false;
+    m_state.pendingActiveScene = SequencerState::kNoPendingScene;
+    SetActiveScene(event.sceneIndex, event.timeOffset, static_cast<double>(event.beat));
+
+    SequencerCommand command;
+    command.type = SequencerCommandType::SceneCut;
+    command.beat = event.beat;
+    command.rowId = event.rowId;
+    command.sceneIndex = m_state.activeSceneIndex;
+    outCommands.push_back(std::move(command));
+}
+
+void DemoSequencer::Advance(DemoTrack& track,
+                            Transport& transport,
+                            const std::vector<AudioClip>& audioLibrary,
+                            std::vector<SequencerCommand>& outCommands) {
+    outCommands.clear();
+    if (transport.state != TransportState::Playing) {
+        return;
+    }
+
+    track.currentBeat = m_playback.ComputeCurrentBeat(transport, track.bpm);
+    const float beatsPerSec = transport.bpm / 60.0f;
+    const float exactBeat = static_cast<float>(transport.timeSeconds * beatsPerSec);
+
+    if (CompleteDueTransition(exactBeat, track.currentBeat)) {
+        SequencerCommand command;
+        command.type = SequencerCommandType::TransitionComplete;
+        command.beat = track.currentBeat;
+        command.rowId = track.currentBeat;
+        command.sceneIndex = m_state.activeSceneIndex;
+        outCommands.push_back(std::move(command));
+    }
+
+    if (track.lengthBeats > 0 && track.currentBeat >= track.lengthBeats && m_endPolicy != SequencerEndPolicy::Continue) {
+        SequencerEndPolicy policy = m_endPolicy;
+        if (policy == SequencerEndPolicy::LoopUnlessStopRow) {
+            policy = HasStopRow(track) ? SequencerEndPolicy::Stop : SequencerEndPolicy::Loop;
+        }
+
+        SequencerCommand command;
+        command.beat = track.lengthBeats;
+        command.rowId = track.lengthBeats;
+        if (policy == SequencerEndPolicy::Loop) {
+            // Rows at beat 0 fire again on the wrapped pass below.
+            transport.timeSeconds = 0.0;
+            track.currentBeat = 0;
+            track.lastTriggeredBeat = -1;
+            ResetTransition(false);
+            command.type = SequencerCommandType::Loop;
+        } else {
+            // Rows skipped by a long frame up to the end still fire before the stop.
+            transport.state = TransportState::Stopped;
+            track.currentBeat = track.lengthBeats;
+            command.type = SequencerCommandType::Stop;
+        }
+        outCommands.push_back(std::move(command));
+    }
+
+    if (track.currentBeat > track.lastTriggeredBeat) {
+        m_playback.BuildPlaybackEvents(track, track.lastTriggeredBeat, track.currentBeat, m_events);
+
+        for (const auto& event : m_events) {
+            if (event.type == PlaybackEventType::SceneCommand) {
+                if (m_sceneCommandsEnabled) {
+                    ApplySceneEvent(track, event, outCommands);
+                }
+                continue;
+            }
+
+            SequencerCommand command;
+            command.beat = event.beat;
+            command.rowId = event.rowId;
+
+            if (event.type == PlaybackEventType::MusicChange) {
+                // Clip validity is the host's call; the sequencer only follows the clip tempo.
+                command.type = SequencerCommandType::MusicChange;
+                command.musicIndex = event.musicIndex;
+                if (event.musicIndex < static_cast<int>(audioLibrary.size())) {
+                    const AudioClip& clip = audioLibrary[event.musicIndex];
+                    if (clip.bpm > 0.0f) {
+                        transport.bpm = clip.bpm;
+                    }
+                }
+                outCommands.push_back(std::move(command));
+            } else if (event.type == PlaybackEventType::OneShot) {
+                command.type = SequencerCommandType::OneShot;
+                command.oneShotIndex = event.oneShotIndex;
+                outCommands.push_back(std::move(command));
+            } else if (event.type == PlaybackEventType::Stop) {
+                // Time and beat freeze where the STOP row fired; later rows are not processed.
+                transport.state = TransportState::Stopped;
+                command.type = SequencerCommandType::Stop;
+                outCommands.push_back(std::move(command));
+                break;
+            }
+        }
+        track.lastTriggeredBeat = track.currentBeat;
+    }
+    m_state.transitionJustCompletedBeat = -1;
+}
+
+int DemoSequencer::Seek(const DemoTrack& track, int beat) {
+    ResetTransition(true);
+    m_events.clear();
+
+    // Rows are kept in beat order.
+    std::vector<const TrackerRow*> rows;
+    for (auto it = track.rows.LowerBound(0); it != track.rows.end() && it->rowId <= beat; ++it) {
+        rows.push_back(&*it);
+    }
+
+    int ignoreSceneBeat = -1;
+    int targetMusicIndex = -1;
+    for (const TrackerRow* row : rows) {
+        if (row->musicIndex >= 0) {
+            targetMusicIndex = row->musicIndex;
+        }
+
+        if (!row->transitionPresetStem.empty() && row->transitionDuration > 0.0f) {
+            if (!m_sceneCommandsEnabled) {
+                continue;
+            }
+
+            PlaybackEvent event;
+            event.type = PlaybackEventType::SceneCommand;
+            event.beat = row->rowId;
+            event.rowId = row->rowId;
+            event.sceneIndex = row->sceneIndex;
+            event.transitionPresetStem = row->transitionPresetStem;
+            event.transitionDuration = row->transitionDuration;
+            event.timeOffset = row->timeOffset;
+            const SceneTransitionResolution target = m_playback.ResolveSceneTransitionTarget(
+                track,
+                event,
+                m_state.activeSceneIndex,
+                m_state.activeSceneOffset,
+                m_state.activeSceneStartBeat);
+
+            BeginTransition(
+                row->rowId,
+                static_cast<double>(row->transitionDuration),
+                target.targetSceneIndex,
+                target.targetOffset,
+                target.targetStartBeat,
+                row->transitionPresetStem);
+
+            const double transitionEndBeat = m_state.transitionStartBeat + m_state.transitionDurationBeats;
+            if (static_cast<double>(beat) > transitionEndBeat && CompleteDueTransition(transitionEndBeat, -1)) {
+                ignoreSceneBeat = static_cast<int>(transitionEndBeat);
+            }
+        } else if (row->sceneIndex >= 0) {
+            if (!m_sceneCommandsEnabled) {
+                continue;
+            }
+            if (ignoreSceneBeat == row->rowId && row->sceneIndex == m_state.activeSceneIndex) {
+                continue;
+            }
+            if (m_state.transitionActive && row->sceneIndex == m_state.pendingActiveScene) {
+                continue;
+            }
+            if (m_sceneCount >= 0 && row->sceneIndex >= m_sceneCount) {
+                continue;
+            }
+            m_state.transitionActive = false;
+            m_state.pendingActiveScene = SequencerState::kNoPendingScene;
+            SetActiveScene(row->sceneIndex, row->timeOffset, static_cast<double>(row->rowId));
+        }
+    }
+
+    m_state.transitionJustCompletedBeat = -1;
+    return targetMusicIndex;
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,123 @@
+#include "ShaderLab/Core/DescriptorRingAllocator.h"
+
+namespace ShaderLab {
+
+DescriptorRingAllocator::DescriptorRingAllocator(IDescriptorCacheBackend& backend,
+                                                 uint32_t cacheCapacity,
+                                                 uint32_t ringCapacity,
+                                                 uint32_t evictAfterFrames)
+    : m_backend(backend), m_evictAfterFrames(evictAfterFrames), m_ring(ringCapacity) {
+    m_entries.resize(cacheCapacity);
+    m_freeSlots.reserve(cacheCapacity);
+    for (uint32_t slot = cacheCapacity; slot > 0; --slot) {
+        m_freeSlots.push_back(slot - 1);
+    }
+    m_stats.cacheCapacity = cacheCapacity;
+    m_stats.ringCapacity = ringCapacity;
+}
+
+void DescriptorRingAllocator::BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    m_frameIndex = frameIndex;
+    m_completedFrameIndex = completedFrameIndex;
+    m_stats.currentFrame = DescriptorFrameCounters{};
+    m_ring.BeginFrame(frameIndex, completedFrameIndex);
+    m_stats.ringUsed = static_cast<uint32_t>(m_ring.GetUsed());
+
+    for (uint32_t slot = 0; slot < static_cast<uint32_t>(m_entries.size()); ++slot) {
+        const CacheEntry& entry = m_entries[slot];
+        if (entry.alive && !IsPinned(entry) && entry.lastUsedFrame + m_evictAfterFrames <= frameIndex) {
+            Evict(slot);
+        }
+    }
+}
+
+void DescriptorRingAllocator::EndFrame() {
+    m_ring.EndFrame();
+    m_stats.lastFrame = m_stats.currentFrame;
+}
+
+uint32_t DescriptorRingAllocator::AcquireView(const DescriptorViewKey& key, bool& outNeedsWrite) {
+    outNeedsWrite = false;
+    auto found = m_lookup.find(key);
+    if (found != m_lookup.end()) {
+        m_entries[found->second].lastUsedFrame = m_frameIndex;
+        ++m_stats.currentFrame.cacheHits;
+        ++m_stats.total.cacheHits;
+        return found->second;
+    }
+
+    if (m_freeSlots.empty()) {
+        // Full: evict the least recently used view no in-flight frame can still reference.
+        uint32_t victim = kInvalidSlot;
+        for (uint32_t slot = 0; slot < static_cast<uint32_t>(m_entries.size()); ++slot) {
+            const CacheEntry& entry = m_entries[slot];
+            if (entry.alive && !IsPinned(entry) &&
+                (victim == kInvalidSlot || entry.lastUsedFrame < m_entries[victim].lastUsedFrame)) {
+                victim = slot;
+            }
+        }
+        if (victim == kInvalidSlot) {
+            ++m_stats.cacheOverflows;
+            return kInvalidSlot;
+        }
+        Evict(victim);
+    }
+
+    const uint32_t slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    CacheEntry& entry = m_entries[slot];
+    entry.key = key;
+    entry.lastUsedFrame = m_frameIndex;
+    entry.alive = true;
+    m_lookup.emplace(key, slot);
+    m_stats.cachedViews = m_lookup.size();
+
+    outNeedsWrite = true;
+    ++m_stats.currentFrame.viewsWritten;
+    ++m_stats.total.viewsWritten;
+    return slot;
+}
+
+uint32_t DescriptorRingAllocator::AllocateTable(uint32_t count) {
+    const uint64_t start = m_ring.Allocate(count);
+    m_stats.ringOverflows = m_ring.GetOverflowCount();
+    if (start == FrameRingBuffer::kInvalidOffset) {
+        return kInvalidSlot;
+    }
+    m_stats.ringUsed = static_cast<uint32_t>(m_ring.GetUsed());
+    m_stats.ringPeakUsed = static_cast<uint32_t>(m_ring.GetPeakUsed());
+
+    ++m_stats.currentFrame.tables;
+    ++m_stats.total.tables;
+    m_stats.currentFrame.descriptorsCopied += count;
+    m_stats.total.descriptorsCopied += count;
+    return static_cast<uint32_t>(start);
+}
+
+void DescriptorRingAllocator::Clear() {
+    for (uint32_t slot = 0; slot < static_cast<uint32_t>(m_entries.size()); ++slot) {
+        if (m_entries[slot].alive) {
+            Evict(slot);
+        }
+    }
+    m_ring.Clear();
+    m_stats.ringUsed = 0;
+}
+
+void DescriptorRingAllocator::Evict(uint32_t slot) {
+    CacheEntry& entry = m_entries[slot];
+    m_backend.ReleaseCachedView(slot);
+    m_lookup.erase(entry.key);
+    entry = CacheEntry{};
+    m_freeSlots.push_back(slot);
+    m_stats.cachedViews = m_lookup.size();
+    ++m_stats.evictions;
+}
+
+bool DescriptorRingAllocator::IsPinned(const CacheEntry& entry) const {
+    return entry.lastUsedFrame == m_frameIndex ||
+           m_completedFrameIndex < 0 ||
+           entry.lastUsedFrame > static_cast<uint64_t>(m_completedFrameIndex);
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,126 @@
+#include "ShaderLab/Core/DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ShaderLab {
+
+DynamicResolutionController::DynamicResolutionController(const DynamicResolutionSettings& settings) {
+    SetSettings(settings);
+}
+
+void DynamicResolutionController::SetSettings(const DynamicResolutionSettings& settings) {
+    m_settings = settings;
+    m_settings.targetMs = (std::max)(m_settings.targetMs, 0.1);
+    m_settings.step = (std::max)(m_settings.step, 0.001f);
+    m_settings.smoothing = (std::min)((std::max)(m_settings.smoothing, 0.01), 1.0);
+    m_settings.alignment = (std::max)(m_settings.alignment, 1u);
+    SetScaleRange(m_settings.minScale, m_settings.maxScale);
+    Reset();
+}
+
+void DynamicResolutionController::SetScaleRange(float minScale, float maxScale) {
+    m_settings.maxScale = (std::min)((std::max)(maxScale, 0.05f), 1.0f);
+    m_settings.minScale = (std::min)((std::max)(minScale, 0.05f), m_settings.maxScale);
+    m_desired = (std::min)((std::max)(m_desired, static_cast<double>(m_settings.minScale)), static_cast<double>(m_settings.maxScale));
+    m_scale = (std::min)((std::max)(m_scale, m_settings.minScale), m_settings.maxScale);
+}
+
+void DynamicResolutionController::Reset() {
+    m_stats = DynamicResolutionStats{};
+    m_scale = m_settings.maxScale;
+    m_desired = m_settings.maxScale;
+    m_filteredMs = 0.0;
+    m_error = 0.0;
+    m_previousError = 0.0;
+    m_hasSample = false;
+    m_framesSinceChange = 0;
+    m_lastDirection = 0;
+}
+
+float DynamicResolutionController::Quantize(double scale) const {
+    const double steps = std::round((m_settings.maxScale - scale) / m_settings.step);
+    const double level = m_settings.maxScale - steps * m_settings.step;
+    return static_cast<float>((std::max)(level, static_cast<double>(m_settings.minScale)));
+}
+
+bool DynamicResolutionController::Update(double gpuFrameMs) {
+    if (!(gpuFrameMs > 0.0)) {
+        return false;
+    }
+    ++m_stats.frames;
+    ++m_framesSinceChange;
+    m_filteredMs = m_hasSample ? m_filteredMs + m_settings.smoothing * (gpuFrameMs - m_filteredMs) : gpuFrameMs;
+
+    // Velocity form: the output is a scale delta, so clamping the desired scale is the anti-windup.
+    const double error = (m_settings.targetMs - m_filteredMs) / m_settings.targetMs;
+    if (!m_hasSample) {
+        m_error = error;
+        m_previousError = error;
+        m_hasSample = true;
+    }
+    const double delta = m_settings.kp * (error - m_error) + m_settings.ki * error +
+                         m_settings.kd * (error - 2.0 * m_error + m_previousError);
+    m_previousError = m_error;
+    m_error = error;
+    // Growth is held to one step above the applied scale, so headroom that builds up while a
+    // frame is just under budget cannot wind the controller up for a multi-step jump later.
+    const double ceiling = (std::min)(static_cast<double>(m_settings.maxScale), static_cast<double>(m_scale) + m_settings.step);
+    m_desired = (std::min)((std::max)(m_desired + delta, static_cast<double>(m_settings.minScale)), ceiling);
+
+    if (m_framesSinceChange < m_settings.holdFrames) {
+        return false;
+    }
+    const float next = Quantize(m_desired);
+    const float threshold = m_settings.step * 0.99f;
+    int direction = 0;
+    if (next <= m_scale - threshold && m_filteredMs > m_settings.targetMs) {
+        direction = -1;
+    } else if (next >= m_scale + threshold && (m_lastDirection >= 0 || m_framesSinceChange >= m_settings.growHoldFrames)) {
+        // Grow only if the frame is predicted to still fit at the larger size, assuming the cost
+        // follows the pixel count.
+        const double ratio = static_cast<double>(next) / m_scale;
+        if (m_filteredMs * ratio * ratio < m_settings.targetMs * (1.0 - m_settings.upscaleHeadroom)) {
+            direction = 1;
+        }
+    }
+    if (direction == 0) {
+        return false;
+    }
+
+    // Restart from the applied scale so the next move is driven by measurements at that size.
+    m_scale = next;
+    m_desired = next;
+    m_framesSinceChange = 0;
+    if (direction > 0) {
+        ++m_stats.increases;
+    } else {
+        ++m_stats.decreases;
+    }
+    if (m_lastDirection != 0 && m_lastDirection != direction) {
+        ++m_stats.reversals;
+    }
+    m_lastDirection = direction;
+    return true;
+}
+
+void DynamicResolutionController::ComputeSize(uint32_t maxWidth, uint32_t maxHeight, uint32_t& outWidth, uint32_t& outHeight) const {
+    if (maxWidth == 0 || maxHeight == 0) {
+        outWidth = maxWidth;
+        outHeight = maxHeight;
+        return;
+    }
+    if (m_scale >= 1.0f) {
+        outWidth = maxWidth;
+        outHeight = maxHeight;
+        return;
+    }
+    const uint32_t align = m_settings.alignment;
+    uint32_t width = static_cast<uint32_t>(std::lround(maxWidth * static_cast<double>(m_scale) / align)) * align;
+    width = (std::min)((std::max)(width, (std::min)(align, maxWidth)), maxWidth);
+    const double height = static_cast<double>(width) * maxHeight / maxWidth;
+    outWidth = width;
+    outHeight = (std::max)(static_cast<uint32_t>(std::lround(height)), 1u);
+}
+
+} // namespace ShaderLab
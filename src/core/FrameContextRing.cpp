@@ -0,0 +1,51 @@
+#include "ShaderLab/Core/FrameContextRing.h"
+
+#include <algorithm>
+
+namespace ShaderLab {
+
+FrameContextRing::FrameContextRing(uint32_t contextCount)
+    : m_contexts((std::max)(contextCount, 1u)) {}
+
+uint32_t FrameContextRing::BeginFrame(IFrameFence& fence) {
+    m_frameIndex = m_nextFrameIndex++;
+    m_contextIndex = static_cast<uint32_t>(m_frameIndex % m_contexts.size());
+
+    const Context& context = m_contexts[m_contextIndex];
+    if (context.fenceValue != 0 && fence.GetCompletedValue() < context.fenceValue) {
+        ++m_stats.waits;
+        fence.WaitForValue(context.fenceValue);
+    }
+    UpdateCompleted(fence);
+
+    ++m_stats.framesBegun;
+    m_stats.peakFramesInFlight = (std::max)(m_stats.peakFramesInFlight, GetFramesInFlight() + 1u);
+    return m_contextIndex;
+}
+
+void FrameContextRing::EndFrame(uint64_t fenceValue) {
+    Context& context = m_contexts[m_contextIndex];
+    context.fenceValue = fenceValue;
+    context.frameIndex = m_frameIndex;
+}
+
+void FrameContextRing::UpdateCompleted(IFrameFence& fence) {
+    const uint64_t completed = fence.GetCompletedValue();
+    for (const Context& context : m_contexts) {
+        if (context.fenceValue != 0 && context.fenceValue <= completed) {
+            m_completedFrameIndex = (std::max)(m_completedFrameIndex, static_cast<int64_t>(context.frameIndex));
+        }
+    }
+}
+
+uint32_t FrameContextRing::GetFramesInFlight() const {
+    uint32_t count = 0;
+    for (const Context& context : m_contexts) {
+        if (context.fenceValue != 0 && static_cast<int64_t>(context.frameIndex) > m_completedFrameIndex) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace ShaderLab
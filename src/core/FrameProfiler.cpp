@@ -0,0 +1,434 @@
+#include "ShaderLab/Core/FrameProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+namespace ShaderLab {
+
+namespace {
+
+void AppendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        const unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (u < 0x20) {
+            char escaped[8] = {};
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", u);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void AppendCompleteEvent(std::string& out, const std::string& name, const char* category, int tid,
+                         double startUs, double durationUs, uint64_t frameIndex) {
+    char numbers[160] = {};
+    std::snprintf(numbers, sizeof(numbers),
+                  ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+                  category, tid, startUs, durationUs, static_cast<unsigned long long>(frameIndex));
+    out += ",\n{\"name\":";
+    AppendJsonString(out, name);
+    out += numbers;
+}
+
+} // namespace
+
+FrameProfiler::FrameProfiler(uint32_t frameSlots, uint32_t queriesPerFrame, uint32_t statWindow)
+    : m_frameSlots((std::max)(1u, frameSlots)),
+      m_queriesPerFrame((std::max)(2u, queriesPerFrame)),
+      m_statWindow((std::max)(1u, statWindow)),
+      m_slots(m_frameSlots) {
+    const auto epoch = std::chrono::steady_clock::now();
+    m_clock = [epoch]() {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+    };
+}
+
+void FrameProfiler::SetClock(std::function<double()> clock) {
+    if (clock) {
+        m_clock = std::move(clock);
+    }
+}
+
+double FrameProfiler::Now() const {
+    return m_clock();
+}
+
+void FrameProfiler::BeginFrame(uint64_t frameIndex) {
+    if (m_inFrame) {
+        EndFrame();
+    }
+
+    m_gpuSlot = static_cast<uint32_t>(frameIndex % m_frameSlots);
+    GpuSlot& slot = m_slots[m_gpuSlot];
+    if (slot.pending) {
+        // The backend never read this slot back; keep the CPU half.
+        ++m_counters.gpuFramesDropped;
+        slot.pending = false;
+        CompleteFrame(std::move(slot.frame));
+    }
+    slot.scopes.clear();
+    slot.queryCount = 0;
+    slot.frameIndex = frameIndex;
+    m_gpuStack.clear();
+
+    m_frame = ProfileFrame{};
+    m_frame.frameIndex = frameIndex;
+    m_frame.events[static_cast<size_t>(ProfileTrack::Cpu)].reserve(m_cpuEventReserve);
+    m_frame.cpuStartUs = Now();
+    m_cpuStack.clear();
+    m_cpuStatStack.clear();
+    m_inFrame = true;
+}
+
+void FrameProfiler::EndFrame() {
+    if (!m_inFrame) {
+        return;
+    }
+    const double now = Now();
+    while (!m_cpuStack.empty()) {
+        ProfileEvent& open = m_frame.events[static_cast<size_t>(ProfileTrack::Cpu)][m_cpuStack.back()];
+        open.durationUs = now - open.startUs;
+        m_cpuStack.pop_back();
+        ++m_counters.unbalancedScopes;
+    }
+    m_cpuStatStack.clear();
+    m_counters.unbalancedScopes += m_gpuStack.size();
+    m_gpuStack.clear();
+    m_frame.cpuDurationUs = now - m_frame.cpuStartUs;
+    m_cpuEventReserve = m_frame.events[static_cast<size_t>(ProfileTrack::Cpu)].size();
+    m_inFrame = false;
+
+    AccumulateStats(m_frame.events[static_cast<size_t>(ProfileTrack::Cpu)]);
+    FlushStats();
+
+    GpuSlot& slot = m_slots[m_gpuSlot];
+    if (slot.queryCount > 0) {
+        slot.pending = true;
+        slot.frame = std::move(m_frame);
+    } else {
+        CompleteFrame(std::move(m_frame));
+    }
+}
+
+void FrameProfiler::BeginCpuScope(const char* name) {
+    if (!m_inFrame) {
+        return;
+    }
+    auto& events = m_frame.events[static_cast<size_t>(ProfileTrack::Cpu)];
+    ProfileEvent event;
+    event.name = InternName(name);
+    event.depth = static_cast<uint32_t>(m_cpuStack.size());
+    event.stat = FindStat(ProfileTrack::Cpu, m_cpuStatStack.empty() ? kNoParent : m_cpuStatStack.back(), event.name, event.depth);
+    event.startUs = Now();
+    m_cpuStack.push_back(static_cast<uint32_t>(events.size()));
+    m_cpuStatStack.push_back(event.stat);
+    events.push_back(event);
+}
+
+void FrameProfiler::EndCpuScope() {
+    if (!m_inFrame) {
+        return;
+    }
+    if (m_cpuStack.empty()) {
+        ++m_counters.unbalancedScopes;
+        return;
+    }
+    ProfileEvent& event = m_frame.events[static_cast<size_t>(ProfileTrack::Cpu)][m_cpuStack.back()];
+    event.durationUs = Now() - event.startUs;
+    m_cpuStack.pop_back();
+    m_cpuStatStack.pop_back();
+}
+
+uint32_t FrameProfiler::BeginGpuScope(const char* name) {
+    if (!m_inFrame) {
+        return kInvalidQuery;
+    }
+    GpuSlot& slot = m_slots[m_gpuSlot];
+    uint32_t open = 0;
+    uint32_t parent = kNoParent;
+    for (uint32_t scope : m_gpuStack) {
+        if (scope != kNoParent) {
+            ++open;
+            parent = scope;
+        }
+    }
+    // Keep room for the end query of this scope and of every open one.
+    if (slot.queryCount + open + 2 > m_queriesPerFrame) {
+        ++m_counters.gpuScopesDropped;
+        m_gpuStack.push_back(kNoParent);
+        return kInvalidQuery;
+    }
+
+    GpuScope scope;
+    scope.name = InternName(name);
+    scope.parent = parent;
+    scope.depth = open;
+    scope.beginQuery = slot.queryCount++;
+    m_gpuStack.push_back(static_cast<uint32_t>(slot.scopes.size()));
+    slot.scopes.push_back(scope);
+    return m_gpuSlot * m_queriesPerFrame + scope.beginQuery;
+}
+
+uint32_t FrameProfiler::EndGpuScope() {
+    if (!m_inFrame) {
+        return kInvalidQuery;
+    }
+    if (m_gpuStack.empty()) {
+        ++m_counters.unbalancedScopes;
+        return kInvalidQuery;
+    }
+    const uint32_t index = m_gpuStack.back();
+    m_gpuStack.pop_back();
+    if (index == kNoParent) {
+        return kInvalidQuery;
+    }
+    GpuSlot& slot = m_slots[m_gpuSlot];
+    slot.scopes[index].endQuery = slot.queryCount++;
+    return m_gpuSlot * m_queriesPerFrame + slot.scopes[index].endQuery;
+}
+
+uint32_t FrameProfiler::GetGpuQueryFirst() const {
+    return m_gpuSlot * m_queriesPerFrame;
+}
+
+uint32_t FrameProfiler::GetGpuQueryCount() const {
+    return m_slots[m_gpuSlot].queryCount;
+}
+
+bool FrameProfiler::GetPendingGpuFrame(int64_t completedFrameIndex,
+                                       uint64_t& outFrameIndex,
+                                       uint32_t& outQueryFirst,
+                                       uint32_t& outQueryCount) const {
+    if (completedFrameIndex < 0) {
+        return false;
+    }
+    const GpuSlot* oldest = nullptr;
+    uint32_t oldestSlot = 0;
+    for (uint32_t i = 0; i < m_frameSlots; ++i) {
+        const GpuSlot& slot = m_slots[i];
+        if (slot.pending && slot.frameIndex <= static_cast<uint64_t>(completedFrameIndex) &&
+            (!oldest || slot.frameIndex < oldest->frameIndex)) {
+            oldest = &slot;
+            oldestSlot = i;
+        }
+    }
+    if (!oldest) {
+        return false;
+    }
+    outFrameIndex = oldest->frameIndex;
+    outQueryFirst = oldestSlot * m_queriesPerFrame;
+    outQueryCount = oldest->queryCount;
+    return true;
+}
+
+void FrameProfiler::ResolveGpuFrame(uint64_t frameIndex, const uint64_t* ticks, uint64_t ticksPerSecond) {
+    GpuSlot& slot = m_slots[static_cast<size_t>(frameIndex % m_frameSlots)];
+    if (!slot.pending || slot.frameIndex != frameIndex) {
+        return;
+    }
+    slot.pending = false;
+
+    auto& events = slot.frame.events[static_cast<size_t>(ProfileTrack::Gpu)];
+    events.clear();
+    if (ticks && ticksPerSecond > 0) {
+        uint64_t base = UINT64_MAX;
+        for (const GpuScope& scope : slot.scopes) {
+            if (scope.endQuery != kInvalidQuery) {
+                base = (std::min)(base, ticks[scope.beginQuery]);
+            }
+        }
+        const double usPerTick = 1000000.0 / static_cast<double>(ticksPerSecond);
+        std::vector<uint32_t> scopeStats(slot.scopes.size(), kNoParent);
+        for (size_t i = 0; i < slot.scopes.size(); ++i) {
+            const GpuScope& scope = slot.scopes[i];
+            if (scope.endQuery == kInvalidQuery || ticks[scope.endQuery] < ticks[scope.beginQuery]) {
+                continue;
+            }
+            ProfileEvent event;
+            event.name = scope.name;
+            event.depth = scope.depth;
+            event.stat = FindStat(ProfileTrack::Gpu, scope.parent != kNoParent ? scopeStats[scope.parent] : kNoParent, scope.name, scope.depth);
+            event.startUs = slot.frame.cpuStartUs + static_cast<double>(ticks[scope.beginQuery] - base) * usPerTick;
+            event.durationUs = static_cast<double>(ticks[scope.endQuery] - ticks[scope.beginQuery]) * usPerTick;
+            scopeStats[i] = event.stat;
+            events.push_back(event);
+        }
+    }
+
+    AccumulateStats(events);
+    FlushStats();
+    ++m_counters.gpuFramesResolved;
+    CompleteFrame(std::move(slot.frame));
+}
+
+void FrameProfiler::BeginCapture(uint32_t frameCount) {
+    m_capture.clear();
+    m_captureRemaining = frameCount;
+}
+
+std::string FrameProfiler::ExportChromeTrace() const {
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                      "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ShaderLab\"}},\n"
+                      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+                      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+    const double origin = m_capture.empty() ? 0.0 : m_capture.front().cpuStartUs;
+    for (const ProfileFrame& frame : m_capture) {
+        AppendCompleteEvent(out, "frame " + std::to_string(frame.frameIndex), "cpu", 1,
+                            frame.cpuStartUs - origin, frame.cpuDurationUs, frame.frameIndex);
+        for (uint32_t track = 0; track < kProfileTrackCount; ++track) {
+            for (const ProfileEvent& event : frame.events[track]) {
+                AppendCompleteEvent(out, m_names[event.name], track == 0 ? "cpu" : "gpu", static_cast<int>(track) + 1,
+                                    event.startUs - origin, event.durationUs, frame.frameIndex);
+            }
+        }
+    }
+    out += "\n]}\n";
+    return out;
+}
+
+bool FrameProfiler::WriteChromeTrace(const std::string& path, std::string& outError) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        outError = "cannot open '" + path + "' for writing";
+        return false;
+    }
+    const std::string json = ExportChromeTrace();
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (!file) {
+        outError = "failed to write '" + path + "'";
+        return false;
+    }
+    return true;
+}
+
+void FrameProfiler::BuildFlame(ProfileTrack track, std::vector<ProfileFlameBar>& outBars) const {
+    outBars.clear();
+    if (!m_hasLastFrame) {
+        return;
+    }
+    const auto& events = m_lastFrame.events[static_cast<size_t>(track)];
+    double spanStart = m_lastFrame.cpuStartUs;
+    double spanEnd = m_lastFrame.cpuStartUs + m_lastFrame.cpuDurationUs;
+    if (track == ProfileTrack::Gpu) {
+        spanEnd = spanStart;
+        for (const ProfileEvent& event : events) {
+            spanEnd = (std::max)(spanEnd, event.startUs + event.durationUs);
+        }
+    }
+    const double span = spanEnd - spanStart;
+    if (span <= 0.0) {
+        return;
+    }
+    outBars.reserve(events.size());
+    for (const ProfileEvent& event : events) {
+        ProfileFlameBar bar;
+        bar.name = event.name;
+        bar.stat = event.stat;
+        bar.depth = event.depth;
+        bar.x0 = static_cast<float>((std::clamp)((event.startUs - spanStart) / span, 0.0, 1.0));
+        bar.x1 = static_cast<float>((std::clamp)((event.startUs + event.durationUs - spanStart) / span, 0.0, 1.0));
+        bar.durationMs = event.durationUs / 1000.0;
+        outBars.push_back(bar);
+    }
+}
+
+uint32_t FrameProfiler::InternName(const char* name) {
+    const std::string key = name ? name : "";
+    auto found = m_nameLookup.find(key);
+    if (found != m_nameLookup.end()) {
+        return found->second;
+    }
+    const uint32_t id = static_cast<uint32_t>(m_names.size());
+    m_names.push_back(key);
+    m_nameLookup.emplace(key, id);
+    return id;
+}
+
+uint32_t FrameProfiler::FindStat(ProfileTrack track, uint32_t parentStat, uint32_t name, uint32_t depth) {
+    StatKey key;
+    key.parent = parentStat;
+    key.name = name;
+    key.track = track;
+    auto found = m_statLookup.find(key);
+    if (found != m_statLookup.end()) {
+        return found->second;
+    }
+    ProfileScopeStats stats;
+    stats.name = name;
+    stats.parent = parentStat;
+    stats.depth = depth;
+    stats.track = track;
+    const uint32_t id = static_cast<uint32_t>(m_stats.size());
+    m_stats.push_back(stats);
+    m_windows.emplace_back();
+    m_windows.back().samples.reserve(m_statWindow);
+    m_statLookup.emplace(key, id);
+    return id;
+}
+
+void FrameProfiler::AccumulateStats(const std::vector<ProfileEvent>& events) {
+    for (const ProfileEvent& event : events) {
+        StatWindow& window = m_windows[event.stat];
+        if (!window.touched) {
+            window.touched = true;
+            window.frameMs = 0.0;
+            m_touchedStats.push_back(event.stat);
+        }
+        window.frameMs += event.durationUs / 1000.0;
+    }
+}
+
+void FrameProfiler::FlushStats() {
+    std::vector<double>& sorted = m_statScratch;
+    for (uint32_t stat : m_touchedStats) {
+        StatWindow& window = m_windows[stat];
+        window.touched = false;
+        if (window.samples.size() < m_statWindow) {
+            window.samples.push_back(window.frameMs);
+        } else {
+            window.samples[window.next] = window.frameMs;
+        }
+        window.next = (window.next + 1) % m_statWindow;
+
+        double sum = 0.0;
+        double maxMs = 0.0;
+        for (double sample : window.samples) {
+            sum += sample;
+            maxMs = (std::max)(maxMs, sample);
+        }
+        sorted.assign(window.samples.begin(), window.samples.end());
+        const size_t p95 = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(sorted.size()))) - 1;
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(p95), sorted.end());
+
+        ProfileScopeStats& stats = m_stats[stat];
+        stats.lastMs = window.frameMs;
+        stats.samples = static_cast<uint32_t>(sorted.size());
+        stats.avgMs = sum / static_cast<double>(sorted.size());
+        stats.p95Ms = sorted[p95];
+        stats.maxMs = maxMs;
+    }
+    m_touchedStats.clear();
+}
+
+void FrameProfiler::CompleteFrame(ProfileFrame&& frame) {
+    ++m_counters.framesCompleted;
+    if (m_captureRemaining > 0) {
+        m_capture.push_back(frame);
+        --m_captureRemaining;
+    }
+    if (!m_hasLastFrame || frame.frameIndex >= m_lastFrame.frameIndex) {
+        m_lastFrame = std::move(frame);
+        m_hasLastFrame = true;
+    }
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,64 @@
+#include "ShaderLab/Core/FrameRingBuffer.h"
+
+#include <algorithm>
+
+namespace ShaderLab {
+
+void FrameRingBuffer::Reset(uint64_t capacity) {
+    Clear();
+    m_capacity = capacity;
+    m_peakUsed = 0;
+    m_overflows = 0;
+}
+
+void FrameRingBuffer::BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    m_frameIndex = frameIndex;
+    m_frameUsed = 0;
+    while (!m_inFlight.empty() && completedFrameIndex >= 0 &&
+           m_inFlight.front().frameIndex <= static_cast<uint64_t>(completedFrameIndex)) {
+        m_used -= m_inFlight.front().size;
+        m_inFlight.pop_front();
+    }
+}
+
+void FrameRingBuffer::EndFrame() {
+    if (m_frameUsed > 0) {
+        m_inFlight.push_back({ m_frameIndex, m_frameUsed });
+    }
+    m_frameUsed = 0;
+}
+
+uint64_t FrameRingBuffer::Allocate(uint64_t size, uint64_t alignment) {
+    if (size == 0 || size > m_capacity) {
+        ++m_overflows;
+        return kInvalidOffset;
+    }
+
+    const uint64_t mask = alignment > 1 ? alignment - 1 : 0;
+    uint64_t start = (m_head + mask) & ~mask;
+    uint64_t consumed = start - m_head;
+    if (start + size > m_capacity) {
+        consumed = m_capacity - m_head;
+        start = 0;
+    }
+    consumed += size;
+    if (m_used + consumed > m_capacity) {
+        ++m_overflows;
+        return kInvalidOffset;
+    }
+
+    m_head = (start + size) % m_capacity;
+    m_used += consumed;
+    m_frameUsed += consumed;
+    m_peakUsed = (std::max)(m_peakUsed, m_used);
+    return start;
+}
+
+void FrameRingBuffer::Clear() {
+    m_inFlight.clear();
+    m_head = 0;
+    m_used = 0;
+    m_frameUsed = 0;
+}
+
+} // namespace ShaderLab
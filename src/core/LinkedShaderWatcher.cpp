@@ -0,0 +1,181 @@
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
+
+#include "ShaderLab/Core/AssetCatalog.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+
+namespace ShaderLab {
+
+namespace fs = std::filesystem;
+
+uint64_t HashShaderText(const std::string& text) {
+    uint64_t hash = 1469598103934665603ull;
+    for (const char c : text) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+LinkedShaderWatcher::LinkedShaderWatcher(AssetCatalog& catalog, double debounceMs)
+    : m_catalog(catalog),
+      m_debounceMs(debounceMs) {
+}
+
+void LinkedShaderWatcher::SetLinks(const std::vector<LinkedShaderLink>& links) {
+    if (links == m_links) {
+        return;
+    }
+
+    std::vector<LinkState> states(links.size());
+    std::vector<std::vector<std::string>> folderFiles(m_folders.size());
+    std::vector<bool> folderUsed(m_folders.size(), false);
+    for (size_t i = 0; i < links.size(); ++i) {
+        const fs::path path = fs::path(links[i].path).lexically_normal();
+        const std::string folderPath = path.parent_path().string();
+        LinkState& state = states[i];
+        state.fileName = path.filename().string();
+
+        auto folder = std::find_if(m_folders.begin(), m_folders.end(), [&](const Folder& f) {
+            return f.path == folderPath;
+        });
+        if (folder == m_folders.end()) {
+            folder = std::find_if(m_folders.begin(), m_folders.end(), [&](const Folder& f) {
+                return f.path.empty() && !folderUsed[&f - m_folders.data()];
+            });
+            if (folder == m_folders.end()) {
+                m_folders.emplace_back();
+                folderFiles.emplace_back();
+                folderUsed.push_back(false);
+                folder = m_folders.end() - 1;
+            }
+            folder->path = folderPath;
+            folder->seenGeneration = 0;
+        }
+        state.folder = static_cast<int>(folder - m_folders.begin());
+        folderUsed[state.folder] = true;
+        folderFiles[state.folder].push_back(state.fileName);
+
+        // A link that stays keeps its baseline and any change still settling; a new one takes its
+        // baseline from the folder's current snapshot.
+        bool kept = false;
+        for (size_t old = 0; old < m_links.size() && !kept; ++old) {
+            if (m_links[old] == links[i] && m_states[old].folder == state.folder) {
+                state = m_states[old];
+                kept = true;
+            }
+        }
+        if (!kept) {
+            folder->seenGeneration = 0;
+        }
+    }
+
+    for (size_t f = 0; f < m_folders.size(); ++f) {
+        Folder& folder = m_folders[f];
+        if (!folderUsed[f]) {
+            folder.path.clear();
+        }
+        std::vector<std::string>& files = folderFiles[f];
+        std::sort(files.begin(), files.end());
+        files.erase(std::unique(files.begin(), files.end()), files.end());
+
+        if (folder.collection < 0) {
+            AssetCollectionDesc desc;
+            desc.root = folder.path;
+            desc.suffixes = std::move(files);
+            desc.loadContent = true;
+            desc.parse = [](const AssetEntry& entry) -> std::shared_ptr<const void> {
+                return std::make_shared<uint64_t>(HashShaderText(*entry.content));
+            };
+            folder.collection = m_catalog.AddCollection(std::move(desc));
+        } else {
+            // Suffix matching also lets through longer names ending in a linked name; Poll
+            // compares whole file names.
+            m_catalog.SetCollectionSuffixes(folder.collection, std::move(files));
+            m_catalog.SetCollectionRoot(folder.collection, folder.path, std::string());
+        }
+    }
+
+    m_links = links;
+    m_states = std::move(states);
+}
+
+size_t LinkedShaderWatcher::Poll(double nowMs, std::vector<LinkedShaderChange>& outChanges) {
+    for (size_t f = 0; f < m_folders.size(); ++f) {
+        Folder& folder = m_folders[f];
+        // Skip snapshots from before a re-root or a new file list until the catalog rescanned.
+        if (folder.path.empty() || !m_catalog.WaitForScan(folder.collection, 0)) {
+            continue;
+        }
+        const auto snapshot = m_catalog.GetSnapshot(folder.collection);
+        if (!snapshot || snapshot->generation == folder.seenGeneration) {
+            continue;
+        }
+        folder.seenGeneration = snapshot->generation;
+
+        for (LinkState& state : m_states) {
+            if (state.folder != static_cast<int>(f) || state.seenGeneration == snapshot->generation) {
+                continue;
+            }
+            state.seenGeneration = snapshot->generation;
+            // Entries are sorted by relative path, which is the file name at depth 0.
+            const auto entry = std::lower_bound(snapshot->entries.begin(), snapshot->entries.end(), state.fileName,
+                                                [](const AssetEntry& e, const std::string& name) {
+                                                    return e.relativePath < name;
+                                                });
+            if (entry == snapshot->entries.end() || entry->relativePath != state.fileName || !entry->Parsed<uint64_t>()) {
+                // A deleted file keeps the code already loaded.
+                continue;
+            }
+            if (entry->content == state.seenContent) {
+                // Other files in the folder changed; the catalog kept this one as it was.
+                continue;
+            }
+            state.seenContent = entry->content;
+            const uint64_t hash = *entry->Parsed<uint64_t>();
+            if (!state.known) {
+                state.known = true;
+                state.hash = hash;
+                continue;
+            }
+            if (state.pending && hash == state.pendingHash) {
+                continue;
+            }
+            if (hash == state.hash) {
+                // Touched, or changed and changed back before settling.
+                state.pending = false;
+                state.pendingCode.reset();
+                ++m_stats.touches;
+                continue;
+            }
+            m_stats.coalesced += state.pending ? 1 : 0;
+            state.pending = true;
+            state.dueMs = nowMs + m_debounceMs;
+            state.pendingHash = hash;
+            state.pendingCode = entry->content;
+        }
+    }
+
+    size_t added = 0;
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        LinkState& state = m_states[i];
+        if (!state.pending || nowMs < state.dueMs) {
+            continue;
+        }
+        LinkedShaderChange change;
+        change.key = m_links[i].key;
+        change.path = m_links[i].path;
+        change.code = std::move(state.pendingCode);
+        change.previousHash = state.hash;
+        change.hash = state.pendingHash;
+        outChanges.push_back(std::move(change));
+        state.hash = state.pendingHash;
+        state.pending = false;
+        ++m_stats.changes;
+        ++added;
+    }
+    return added;
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,200 @@
+#include "ShaderLab/Core/ListSearchIndex.h"
+
+#include "ShaderLab/Core/TextSearch.h"
+
+#include <algorithm>
+
+namespace ShaderLab {
+
+namespace {
+
+uint32_t PackTrigram(const char* p) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(p[0])) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(p[1])) << 8) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(p[2])) << 16);
+}
+
+void CollectTrigrams(const std::string& key, std::vector<uint32_t>& outTrigrams) {
+    outTrigrams.clear();
+    if (key.size() < 3) {
+        return;
+    }
+    outTrigrams.reserve(key.size() - 2);
+    for (size_t i = 0; i + 3 <= key.size(); ++i) {
+        outTrigrams.push_back(PackTrigram(key.data() + i));
+    }
+    std::sort(outTrigrams.begin(), outTrigrams.end());
+    outTrigrams.erase(std::unique(outTrigrams.begin(), outTrigrams.end()), outTrigrams.end());
+}
+
+} // namespace
+
+std::string ToSearchKey(const std::string& text) {
+    std::string key = text;
+    for (char& c : key) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return key;
+}
+
+void ListSearchIndex::Resize(size_t count) {
+    if (count == m_items.size()) {
+        return;
+    }
+    for (size_t i = count; i < m_items.size(); ++i) {
+        UnindexItem(static_cast<int>(i));
+    }
+    m_items.resize(count);
+    ++m_revision;
+}
+
+bool ListSearchIndex::SetItem(size_t index, const std::string& text) {
+    if (index >= m_items.size()) {
+        return false;
+    }
+    Item& item = m_items[index];
+    if (item.text == text) {
+        return false;
+    }
+    item.text = text;
+    item.key = ToSearchKey(text);
+    if (!item.stale) {
+        item.stale = true;
+        m_stale.push_back(static_cast<int>(index));
+    }
+    ++m_revision;
+    return true;
+}
+
+void ListSearchIndex::Clear() {
+    m_items.clear();
+    m_postings.clear();
+    m_stale.clear();
+    m_results.clear();
+    m_lastNeedle.clear();
+    ++m_revision;
+}
+
+void ListSearchIndex::FlushStale() {
+    if (m_stale.empty()) {
+        return;
+    }
+    // A delete near the top of the list shifts every item after it; rebuilding in index order
+    // then beats moving each item through its sorted posting lists.
+    if (m_stale.size() * 4 > m_items.size()) {
+        m_postings.clear();
+        for (size_t i = 0; i < m_items.size(); ++i) {
+            Item& item = m_items[i];
+            CollectTrigrams(item.key, item.trigrams);
+            for (uint32_t trigram : item.trigrams) {
+                m_postings[trigram].push_back(static_cast<int>(i));
+            }
+            item.stale = false;
+        }
+        m_stale.clear();
+        return;
+    }
+    for (int index : m_stale) {
+        if (index >= static_cast<int>(m_items.size())) {
+            continue;
+        }
+        Item& item = m_items[index];
+        UnindexItem(index);
+        CollectTrigrams(item.key, item.trigrams);
+        for (uint32_t trigram : item.trigrams) {
+            std::vector<int>& list = m_postings[trigram];
+            list.insert(std::lower_bound(list.begin(), list.end(), index), index);
+        }
+        item.stale = false;
+    }
+    m_stale.clear();
+}
+
+void ListSearchIndex::UnindexItem(int index) {
+    Item& item = m_items[index];
+    for (uint32_t trigram : item.trigrams) {
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end()) {
+            continue;
+        }
+        std::vector<int>& list = it->second;
+        auto pos = std::lower_bound(list.begin(), list.end(), index);
+        if (pos != list.end() && *pos == index) {
+            list.erase(pos);
+        }
+        if (list.empty()) {
+            m_postings.erase(it);
+        }
+    }
+    item.trigrams.clear();
+}
+
+bool ListSearchIndex::KeyContains(int index, const std::string& needle) const {
+    const std::string& key = m_items[index].key;
+    return FindText(key.data(), key.size(), needle.data(), needle.size()) != kTextNotFound;
+}
+
+const std::vector<int>& ListSearchIndex::Query(const std::string& needle) {
+    const std::string key = ToSearchKey(needle);
+    if (m_lastRevision == m_revision && key == m_lastNeedle) {
+        return m_results;
+    }
+
+    // Typing one more character can only narrow the previous matches.
+    const bool refine = m_lastRevision == m_revision && !m_lastNeedle.empty() &&
+                        key.size() > m_lastNeedle.size() && key.compare(0, m_lastNeedle.size(), m_lastNeedle) == 0;
+    m_lastNeedle = key;
+    m_lastRevision = m_revision;
+
+    if (key.empty()) {
+        m_results.resize(m_items.size());
+        for (size_t i = 0; i < m_items.size(); ++i) {
+            m_results[i] = static_cast<int>(i);
+        }
+        return m_results;
+    }
+
+    if (refine) {
+        size_t kept = 0;
+        for (int index : m_results) {
+            if (KeyContains(index, key)) {
+                m_results[kept++] = index;
+            }
+        }
+        m_results.resize(kept);
+        return m_results;
+    }
+
+    m_results.clear();
+    if (key.size() < 3) {
+        for (size_t i = 0; i < m_items.size(); ++i) {
+            if (KeyContains(static_cast<int>(i), key)) {
+                m_results.push_back(static_cast<int>(i));
+            }
+        }
+        return m_results;
+    }
+
+    FlushStale();
+    // Every match holds every trigram of the needle, so the shortest posting list bounds the work.
+    const std::vector<int>* rarest = nullptr;
+    for (size_t i = 0; i + 3 <= key.size(); ++i) {
+        auto it = m_postings.find(PackTrigram(key.data() + i));
+        if (it == m_postings.end()) {
+            return m_results;
+        }
+        if (!rarest || it->second.size() < rarest->size()) {
+            rarest = &it->second;
+        }
+    }
+    for (int index : *rarest) {
+        if (KeyContains(index, key)) {
+            m_results.push_back(index);
+        }
+    }
+    return m_results;
+}
+
+} // namespace ShaderLab
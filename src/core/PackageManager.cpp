@@ -25,26 +25,26 @@ static const char COMPRESSED_MAGIC[] = {'S', 'L', 'Z', '1'};
 
 typedef LONG (WINAPI *RtlDecompressBufferFn)(USHORT, PUCHAR, ULONG, PUCHAR, ULONG, PULONG);
 
-static bool TryDecompressPackedData(const std::vector<uint8_t>& input, std::vector<uint8_t>& output) {
+static bool TryDecompressPackedData(const uint8_t* input, size_t inputSize, std::vector<uint8_t>& output) {
     output.clear();
     constexpr size_t kHeaderSize = 12;
 
-    if (input.size() < kHeaderSize) {
+    if (inputSize < kHeaderSize) {
         return false;
     }
-    if (std::memcmp(input.data(), COMPRESSED_MAGIC, 4) != 0) {
+    if (std::memcmp(input, COMPRESSED_MAGIC, 4) != 0) {
         return false;
     }
 
     uint32_t rawSize = 0;
     uint32_t compressedSize = 0;
-    std::memcpy(&rawSize, input.data() + 4, sizeof(uint32_t));
-    std::memcpy(&compressedSize, input.data() + 8, sizeof(uint32_t));
+    std::memcpy(&rawSize, input + 4, sizeof(uint32_t));
+    std::memcpy(&compressedSize, input + 8, sizeof(uint32_t));
 
     if (rawSize == 0 || compressedSize == 0) {
         return false;
     }
-    if (static_cast<size_t>(compressedSize) + kHeaderSize != input.size()) {
+    if (static_cast<size_t>(compressedSize) + kHeaderSize != inputSize) {
         return false;
     }
 
@@ -69,7 +69,7 @@ static bool TryDecompressPackedData(const std::vector<uint8_t>& input, std::vect
             kLznt1,
             reinterpret_cast<PUCHAR>(output.data()),
             static_cast<ULONG>(output.size()),
-            reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(input.data() + kHeaderSize)),
+            reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(input + kHeaderSize)),
             compressedSize,
             &finalRawSize) != 0) {
         output.clear();
@@ -190,6 +190,9 @@ bool PackageManager::Initialize() {
         return true;
     }
 
+#if !SHADERLAB_TINY_PLAYER
+    ReleaseFileViews();
+#endif
     m_directory.clear();
     m_isPacked = false;
     m_initialized = false;
@@ -334,11 +337,93 @@ std::vector<uint8_t> PackageManager::GetFile(const std::string& path) {
     }
 
     std::vector<uint8_t> decompressed;
-    if (TryDecompressPackedData(data, decompressed)) {
+    if (TryDecompressPackedData(data.data(), data.size(), decompressed)) {
         return decompressed;
     }
 
     return data;
 }
 
+#if !SHADERLAB_TINY_PLAYER
+bool PackageManager::GetFileView(const std::string& path, PackedFileView& outView) {
+    outView = PackedFileView();
+    if (!m_isPacked) {
+        return false;
+    }
+
+    std::string safePath = path;
+    std::replace(safePath.begin(), safePath.end(), '\\', '/');
+    auto it = m_directory.find(safePath);
+    if (it == m_directory.end()) {
+        return false;
+    }
+    const PackedEntry& entry = it->second;
+
+    const uint8_t* base = nullptr;
+    uint64_t mappedSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mappingMutex);
+        if (!m_mappedBase && !MapExecutable()) {
+            return false;
+        }
+        base = m_mappedBase;
+        mappedSize = m_mappedSize;
+    }
+
+    if (entry.offset > mappedSize || entry.size > mappedSize - entry.offset) {
+        return false;
+    }
+    const uint8_t* data = base + entry.offset;
+    const size_t size = static_cast<size_t>(entry.size);
+    if (TryDecompressPackedData(data, size, outView.storage)) {
+        outView.data = outView.storage.data();
+        outView.size = outView.storage.size();
+    } else {
+        outView.data = data;
+        outView.size = size;
+    }
+    return true;
+}
+
+// Called with m_mappingMutex held.
+bool PackageManager::MapExecutable() {
+    HANDLE file = CreateFileA(m_exePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size = {};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    // The mapping keeps the file open.
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    const void* base = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+    m_mappedBase = static_cast<const uint8_t*>(base);
+    m_mappedSize = static_cast<uint64_t>(size.QuadPart);
+    return true;
+}
+
+void PackageManager::ReleaseFileViews() {
+    std::lock_guard<std::mutex> lock(m_mappingMutex);
+    if (m_mappedBase) {
+        UnmapViewOfFile(m_mappedBase);
+        m_mappedBase = nullptr;
+        m_mappedSize = 0;
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+}
+#endif
+
 }
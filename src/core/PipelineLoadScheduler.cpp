@@ -0,0 +1,244 @@
+#include "ShaderLab/Core/PipelineLoadScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <utility>
+
+namespace ShaderLab {
+
+namespace {
+int64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+PipelineLoadScheduler::~PipelineLoadScheduler() {
+    Cancel();
+}
+
+unsigned PipelineLoadScheduler::DefaultWorkerCount() {
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads <= 2) {
+        return 1;
+    }
+    // Leave the render/message thread a core.
+    return (std::min)(hardwareThreads - 1, 8u);
+}
+
+void PipelineLoadScheduler::BuildGroups() {
+    m_groups.clear();
+    std::unordered_map<std::string, size_t> groupByKey;
+    for (size_t jobIndex = 0; jobIndex < m_jobs.size(); ++jobIndex) {
+        const std::string& key = m_jobs[jobIndex].bytecodeKey;
+        if (!key.empty()) {
+            auto it = groupByKey.find(key);
+            if (it != groupByKey.end()) {
+                m_groups[it->second].jobs.push_back(jobIndex);
+                continue;
+            }
+            groupByKey.emplace(key, m_groups.size());
+        }
+        LoadGroup group;
+        group.jobs.push_back(jobIndex);
+        m_groups.push_back(std::move(group));
+    }
+}
+
+void PipelineLoadScheduler::Start(std::vector<PipelineLoadJob> jobs, IPipelineFactory& factory, unsigned workerCount) {
+    Cancel();
+
+    m_jobs = std::move(jobs);
+    m_factory = &factory;
+    m_stop = false;
+    m_completed = false;
+    m_finishedCount.store(0, std::memory_order_release);
+    m_loadNs.store(0);
+    m_createNs.store(0);
+    m_jobStates.reset(new std::atomic<uint8_t>[m_jobs.size()]);
+    for (size_t i = 0; i < m_jobs.size(); ++i) {
+        m_jobStates[i].store(static_cast<uint8_t>(PipelineLoadState::Pending), std::memory_order_relaxed);
+    }
+
+    BuildGroups();
+
+    m_stats = {};
+    m_stats.jobCount = m_jobs.size();
+    m_stats.loadCount = m_groups.size();
+    m_stats.workerCount = (std::min)(workerCount, static_cast<unsigned>(m_groups.size()));
+    m_inline = (m_stats.workerCount == 0);
+    m_startNs = NowNs();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.clear();
+        for (size_t groupIndex = 0; groupIndex < m_groups.size(); ++groupIndex) {
+            Task task;
+            task.isLoad = true;
+            task.index = groupIndex;
+            m_queue.push_back(std::move(task));
+        }
+    }
+
+    m_workers.reserve(m_stats.workerCount);
+    for (unsigned i = 0; i < m_stats.workerCount; ++i) {
+        m_workers.emplace_back([this]() { WorkerMain(); });
+    }
+}
+
+void PipelineLoadScheduler::FinishJob(size_t jobIndex, bool ok) {
+    const PipelineLoadState state = ok ? PipelineLoadState::Ready : PipelineLoadState::Failed;
+    m_jobStates[jobIndex].store(static_cast<uint8_t>(state), std::memory_order_release);
+    const size_t finished = m_finishedCount.fetch_add(1, std::memory_order_acq_rel) + 1;
+    if (finished == m_jobs.size()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_all();
+    }
+}
+
+void PipelineLoadScheduler::RunTask(Task& task) {
+    if (!task.isLoad) {
+        const int64_t start = NowNs();
+        const PipelineLoadJob& job = m_jobs[task.index];
+        const bool ok = m_factory->CreatePipeline(task.index, job, *task.bytecode);
+        m_createNs.fetch_add(NowNs() - start, std::memory_order_relaxed);
+        task.bytecode.reset();
+        FinishJob(task.index, ok);
+        return;
+    }
+
+    const LoadGroup& group = m_groups[task.index];
+    auto bytecode = std::make_shared<std::vector<uint8_t>>();
+    const int64_t start = NowNs();
+    const bool loaded = m_factory->LoadBytecode(m_jobs[group.jobs.front()], *bytecode);
+    m_loadNs.fetch_add(NowNs() - start, std::memory_order_relaxed);
+
+    if (!loaded || bytecode->empty()) {
+        for (size_t jobIndex : group.jobs) {
+            FinishJob(jobIndex, false);
+        }
+        return;
+    }
+
+    std::shared_ptr<const std::vector<uint8_t>> shared = std::move(bytecode);
+    if (m_inline) {
+        // Inline mode: create right away in job order.
+        for (size_t jobIndex : group.jobs) {
+            Task create;
+            create.isLoad = false;
+            create.index = jobIndex;
+            create.bytecode = shared;
+            RunTask(create);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = group.jobs.rbegin(); it != group.jobs.rend(); ++it) {
+            Task create;
+            create.isLoad = false;
+            create.index = *it;
+            create.bytecode = shared;
+            m_queue.push_front(std::move(create));
+        }
+    }
+    // Wait() shares the condition variable with the workers, so never notify_one here.
+    m_wake.notify_all();
+}
+
+void PipelineLoadScheduler::WorkerMain() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() {
+                return m_stop || !m_queue.empty() ||
+                       m_finishedCount.load(std::memory_order_acquire) == m_jobs.size();
+            });
+            if (m_stop || m_queue.empty()) {
+                return;
+            }
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        RunTask(task);
+    }
+}
+
+void PipelineLoadScheduler::JoinWorkers() {
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+bool PipelineLoadScheduler::Poll() {
+    if (!m_factory) {
+        return false;
+    }
+    if (m_completed) {
+        return true;
+    }
+
+    if (m_inline) {
+        while (!m_queue.empty()) {
+            Task task = std::move(m_queue.front());
+            m_queue.pop_front();
+            RunTask(task);
+        }
+    }
+
+    if (m_finishedCount.load(std::memory_order_acquire) < m_jobs.size()) {
+        return false;
+    }
+
+    JoinWorkers();
+    m_completed = true;
+    m_stats.wallMs = static_cast<double>(NowNs() - m_startNs) / 1.0e6;
+    m_stats.loadMs = static_cast<double>(m_loadNs.load()) / 1.0e6;
+    m_stats.createMs = static_cast<double>(m_createNs.load()) / 1.0e6;
+    m_stats.failedCount = 0;
+    for (size_t i = 0; i < m_jobs.size(); ++i) {
+        if (GetJobState(i) == PipelineLoadState::Failed) {
+            ++m_stats.failedCount;
+        }
+    }
+    return true;
+}
+
+void PipelineLoadScheduler::Wait() {
+    if (!m_factory) {
+        return;
+    }
+    if (!m_inline) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this]() {
+            return m_stop || m_finishedCount.load(std::memory_order_acquire) == m_jobs.size();
+        });
+    }
+    Poll();
+}
+
+void PipelineLoadScheduler::Cancel() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+    JoinWorkers();
+    m_factory = nullptr;
+}
+
+PipelineLoadState PipelineLoadScheduler::GetJobState(size_t index) const {
+    if (index >= m_jobs.size()) {
+        return PipelineLoadState::Failed;
+    }
+    return static_cast<PipelineLoadState>(m_jobStates[index].load(std::memory_order_acquire));
+}
+
+} // namespace ShaderLab
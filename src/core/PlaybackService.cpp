@@ -10,15 +10,15 @@ namespace ShaderLab {
 
 namespace {
 const TrackerRow* FindNextSceneRow(const DemoTrack& track, int afterBeat) {
-    const TrackerRow* bestRow = nullptr;
-    int bestBeat = INT_MAX;
-    for (const auto& row : track.rows) {
-        if (row.sceneIndex >= 0 && row.rowId > afterBeat && row.rowId < bestBeat) {
-            bestBeat = row.rowId;
-            bestRow = &row;
+    if (afterBeat == INT_MAX) {
+        return nullptr;
+    }
+    for (auto it = track.rows.LowerBound(afterBeat + 1); it != track.rows.end(); ++it) {
+        if (it->sceneIndex >= 0) {
+            return &*it;
         }
     }
-    return bestRow;
+    return nullptr;
 }
 }
 
@@ -84,12 +84,8 @@ void PlaybackService::CollectTriggeredRows(const DemoTrack& track,
         return;
     }
 
-    for (int beat = fromBeatExclusive + 1; beat <= toBeatInclusive; ++beat) {
-        for (const auto& row : track.rows) {
-            if (row.rowId == beat) {
-                outRows.emplace_back(beat, &row);
-            }
-        }
+    for (auto it = track.rows.LowerBound(fromBeatExclusive + 1); it != track.rows.end() && it->rowId <= toBeatInclusive; ++it) {
+        outRows.emplace_back(it->rowId, &*it);
     }
 }
 
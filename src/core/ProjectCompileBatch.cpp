@@ -0,0 +1,54 @@
+#include "ShaderLab/Core/ProjectCompileBatch.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace ShaderLab {
+
+void ProjectCompileBatch::Start(AsyncCompilationService& service, std::vector<AsyncCompileRequest> requests) {
+    m_remaining.clear();
+    m_remaining.reserve(requests.size());
+    m_total = requests.size();
+    m_start = std::chrono::steady_clock::now();
+    m_end = m_start;
+    // Workers pick up a request the moment it is submitted, so submitting in list order would let
+    // the first few targets start ahead of the active scene. Highest priority goes in first.
+    std::stable_sort(requests.begin(), requests.end(), [](const AsyncCompileRequest& a, const AsyncCompileRequest& b) {
+        return a.priority > b.priority;
+    });
+    for (AsyncCompileRequest& request : requests) {
+        m_remaining.push_back(request.key);
+        service.Submit(std::move(request));
+    }
+}
+
+bool ProjectCompileBatch::Update(const AsyncCompilationService& service) {
+    if (m_remaining.empty()) {
+        return false;
+    }
+    for (size_t i = 0; i < m_remaining.size();) {
+        if (service.IsPending(m_remaining[i])) {
+            ++i;
+            continue;
+        }
+        m_remaining[i] = m_remaining.back();
+        m_remaining.pop_back();
+    }
+    if (!m_remaining.empty()) {
+        return false;
+    }
+    m_end = std::chrono::steady_clock::now();
+    return true;
+}
+
+void ProjectCompileBatch::Reset() {
+    m_remaining.clear();
+    m_total = 0;
+}
+
+double ProjectCompileBatch::GetElapsedMs() const {
+    const auto end = IsActive() ? std::chrono::steady_clock::now() : m_end;
+    return std::chrono::duration<double, std::milli>(end - m_start).count();
+}
+
+} // namespace ShaderLab
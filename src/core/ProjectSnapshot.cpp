@@ -0,0 +1,234 @@
+#include "ShaderLab/Core/ProjectSnapshot.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+
+namespace ShaderLab {
+
+namespace {
+
+size_t StringBytes(const std::string& text) {
+    // Short strings live inside the object.
+    return text.capacity() > 15 ? text.capacity() + 1 : 0;
+}
+
+class SnapshotMeter {
+public:
+    size_t bytes = 0;
+
+    // Counts the object behind pointer the first time it is seen.
+    bool Visit(const void* pointer, size_t size) {
+        if (!pointer || !m_seen.insert(pointer).second) {
+            return false;
+        }
+        bytes += size;
+        return true;
+    }
+
+    void Text(const std::shared_ptr<const std::string>& text) {
+        if (text && Visit(text.get(), sizeof(std::string) + 16)) {
+            bytes += StringBytes(*text);
+        }
+    }
+
+    void Scene(const SceneNode& node) {
+        if (!Visit(node.get(), sizeof(SceneDoc) + 16)) {
+            return;
+        }
+        bytes += StringBytes(node->name) + StringBytes(node->description) +
+                 StringBytes(node->shaderCodePath) + StringBytes(node->precompiledPath);
+        Text(node->shaderCode);
+        if (node->bindings && Visit(node->bindings.get(), sizeof(std::vector<BindingDoc>) + 16)) {
+            bytes += node->bindings->capacity() * sizeof(BindingDoc);
+            for (const BindingDoc& binding : *node->bindings) {
+                bytes += StringBytes(binding.filePath);
+            }
+        }
+        if (node->postFxChain && Visit(node->postFxChain.get(), sizeof(std::vector<PostFxDoc>) + 16)) {
+            bytes += node->postFxChain->capacity() * sizeof(PostFxDoc);
+            for (const PostFxDoc& effect : *node->postFxChain) {
+                bytes += StringBytes(effect.name) + StringBytes(effect.shaderCodePath) + StringBytes(effect.precompiledPath);
+                Text(effect.shaderCode);
+            }
+        }
+        if (node->computeChain && Visit(node->computeChain.get(), sizeof(std::vector<ComputeDoc>) + 16)) {
+            bytes += node->computeChain->capacity() * sizeof(ComputeDoc);
+            for (const ComputeDoc& effect : *node->computeChain) {
+                bytes += StringBytes(effect.name) + StringBytes(effect.shaderCodePath) +
+                         StringBytes(effect.precompiledPath) + StringBytes(effect.entryPoint);
+                Text(effect.shaderCode);
+            }
+        }
+    }
+
+    void Snapshot(const ProjectSnapshot& snapshot) {
+        bytes += sizeof(ProjectSnapshot);
+        if (const auto* table = snapshot.scenes.GetTable(); table && Visit(table, sizeof(*table) + 16)) {
+            bytes += table->capacity() * sizeof(table->front());
+            for (const auto& chunk : *table) {
+                if (Visit(chunk.get(), sizeof(*chunk) + 16)) {
+                    bytes += chunk->capacity() * sizeof(SceneNode);
+                    for (const SceneNode& node : *chunk) {
+                        Scene(node);
+                    }
+                }
+            }
+        }
+        if (const auto* table = snapshot.trackRows.GetTable(); table && Visit(table, sizeof(*table) + 16)) {
+            bytes += table->capacity() * sizeof(table->front());
+            for (const auto& chunk : *table) {
+                if (Visit(chunk.get(), sizeof(*chunk) + 16)) {
+                    bytes += chunk->capacity() * sizeof(TrackerRow);
+                    for (const TrackerRow& row : *chunk) {
+                        bytes += StringBytes(row.transitionPresetStem) + StringBytes(row.transitionShaderPath);
+                    }
+                }
+            }
+        }
+        if (snapshot.audioLibrary && Visit(snapshot.audioLibrary.get(), sizeof(std::vector<AudioClip>) + 16)) {
+            bytes += snapshot.audioLibrary->capacity() * sizeof(AudioClip);
+            for (const AudioClip& clip : *snapshot.audioLibrary) {
+                bytes += StringBytes(clip.name) + StringBytes(clip.path);
+            }
+        }
+        if (snapshot.settings && Visit(snapshot.settings.get(), sizeof(ProjectSettingsDoc) + 16)) {
+            bytes += StringBytes(snapshot.settings->trackName) + StringBytes(snapshot.settings->demoTitle) +
+                     StringBytes(snapshot.settings->demoAuthor) + StringBytes(snapshot.settings->demoDescription);
+        }
+    }
+
+private:
+    std::unordered_set<const void*> m_seen;
+};
+
+} // namespace
+
+bool BindingDoc::operator==(const BindingDoc& other) const {
+    return channelIndex == other.channelIndex && enabled == other.enabled && bindingType == other.bindingType &&
+           sourceSceneIndex == other.sourceSceneIndex && filePath == other.filePath && type == other.type;
+}
+
+bool ProjectSettingsDoc::operator==(const ProjectSettingsDoc& other) const {
+    return trackName == other.trackName && trackBpm == other.trackBpm && trackLengthBeats == other.trackLengthBeats &&
+           transportBpm == other.transportBpm && renderAspectRatioPreset == other.renderAspectRatioPreset &&
+           fullscreenRenderResolutionPreset == other.fullscreenRenderResolutionPreset &&
+           demoTitle == other.demoTitle && demoAuthor == other.demoAuthor && demoDescription == other.demoDescription;
+}
+
+bool ProjectSnapshot::SharesAllWith(const ProjectSnapshot& other) const {
+    return scenes.SharesTableWith(other.scenes) && trackRows.SharesTableWith(other.trackRows) &&
+           audioLibrary == other.audioLibrary && settings == other.settings;
+}
+
+std::shared_ptr<const std::string> ShareText(const std::shared_ptr<const std::string>& previous, const std::string& text) {
+    if (previous && *previous == text) {
+        return previous;
+    }
+    return std::make_shared<const std::string>(text);
+}
+
+std::shared_ptr<const std::vector<AudioClip>> ShareAudioLibrary(const std::shared_ptr<const std::vector<AudioClip>>& previous,
+                                                                 const std::vector<AudioClip>& clips) {
+    if (previous && previous->size() == clips.size()) {
+        bool equal = true;
+        for (size_t i = 0; i < clips.size() && equal; ++i) {
+            const AudioClip& a = (*previous)[i];
+            const AudioClip& b = clips[i];
+            equal = a.name == b.name && a.path == b.path && a.type == b.type && a.bpm == b.bpm &&
+                    a.beatOffset == b.beatOffset;
+        }
+        if (equal) {
+            return previous;
+        }
+    }
+    return std::make_shared<const std::vector<AudioClip>>(clips);
+}
+
+std::shared_ptr<const ProjectSettingsDoc> ShareSettings(const std::shared_ptr<const ProjectSettingsDoc>& previous,
+                                                        const ProjectSettingsDoc& settings) {
+    if (previous && *previous == settings) {
+        return previous;
+    }
+    return std::make_shared<const ProjectSettingsDoc>(settings);
+}
+
+bool TrackerRowsEqual(const TrackerRow& a, const TrackerRow& b) {
+    return a.rowId == b.rowId && a.sceneIndex == b.sceneIndex && a.transitionPresetStem == b.transitionPresetStem &&
+           a.transitionShaderPath == b.transitionShaderPath && a.transitionDuration == b.transitionDuration &&
+           a.timeOffset == b.timeOffset && a.musicIndex == b.musicIndex && a.oneShotIndex == b.oneShotIndex &&
+           a.isBeat == b.isBeat && a.stop == b.stop;
+}
+
+PersistentVector<TrackerRow, kSnapshotRowChunk> ShareTrackRows(const PersistentVector<TrackerRow, kSnapshotRowChunk>& previous,
+                                                               const TrackerRowStore& rows) {
+    return PersistentVector<TrackerRow, kSnapshotRowChunk>::Rebuild(
+        previous, rows.size(),
+        [&rows](size_t i, const TrackerRow& row) { return TrackerRowsEqual(row, rows[i]); },
+        [&rows](size_t i, const TrackerRow*) { return rows[i]; });
+}
+
+size_t MeasureSnapshotBytes(const std::vector<const ProjectSnapshot*>& snapshots) {
+    SnapshotMeter meter;
+    for (const ProjectSnapshot* snapshot : snapshots) {
+        if (snapshot) {
+            meter.Snapshot(*snapshot);
+        }
+    }
+    return meter.bytes;
+}
+
+ProjectHistory::ProjectHistory(size_t maxLevels)
+    : m_maxLevels((std::max)(maxLevels, static_cast<size_t>(1))) {
+}
+
+bool ProjectHistory::Push(ProjectSnapshot snapshot) {
+    if (!m_levels.empty() && m_levels[m_current].SharesAllWith(snapshot)) {
+        return false;
+    }
+    if (!m_levels.empty()) {
+        m_levels.erase(m_levels.begin() + static_cast<std::ptrdiff_t>(m_current) + 1, m_levels.end());
+    }
+    m_levels.push_back(std::move(snapshot));
+    while (m_levels.size() > m_maxLevels) {
+        m_levels.pop_front();
+    }
+    m_current = m_levels.size() - 1;
+    return true;
+}
+
+const ProjectSnapshot* ProjectHistory::Current() const {
+    return m_levels.empty() ? nullptr : &m_levels[m_current];
+}
+
+const ProjectSnapshot* ProjectHistory::Undo() {
+    if (!CanUndo()) {
+        return nullptr;
+    }
+    --m_current;
+    return &m_levels[m_current];
+}
+
+const ProjectSnapshot* ProjectHistory::Redo() {
+    if (!CanRedo()) {
+        return nullptr;
+    }
+    ++m_current;
+    return &m_levels[m_current];
+}
+
+void ProjectHistory::Clear() {
+    m_levels.clear();
+    m_current = 0;
+}
+
+size_t ProjectHistory::MeasureBytes() const {
+    std::vector<const ProjectSnapshot*> snapshots;
+    snapshots.reserve(m_levels.size());
+    for (const ProjectSnapshot& snapshot : m_levels) {
+        snapshots.push_back(&snapshot);
+    }
+    return MeasureSnapshotBytes(snapshots);
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,284 @@
+#include "ShaderLab/Core/RenderGraph.h"
+
+#include <algorithm>
+
+namespace ShaderLab {
+
+namespace {
+
+bool IsReadOnly(uint32_t access) {
+    return access != RenderGraphAccessNone && (access & ~kRenderGraphReadAccessMask) == 0;
+}
+
+} // namespace
+
+void RenderGraphPlan::Clear() {
+    steps.clear();
+    barriers.clear();
+    finalFirstBarrier = 0;
+    finalBarrierCount = 0;
+    resourcePhysical.clear();
+    importedCount = 0;
+    transientDescs.clear();
+    stats = RenderGraphStats{};
+}
+
+void RenderGraph::Reset() {
+    m_passes.clear();
+    m_resources.clear();
+}
+
+uint32_t RenderGraph::ImportTexture(const char* name, uint64_t externalId, uint32_t initialAccess, uint32_t finalAccess) {
+    Resource resource;
+    resource.name = name;
+    resource.imported = true;
+    resource.externalId = externalId;
+    resource.initialAccess = initialAccess;
+    resource.finalAccess = finalAccess;
+    m_resources.push_back(resource);
+    return static_cast<uint32_t>(m_resources.size() - 1);
+}
+
+uint32_t RenderGraph::CreateTexture(const char* name, const TransientTargetDesc& desc, uint32_t restAccess) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    resource.initialAccess = restAccess;
+    resource.finalAccess = restAccess;
+    m_resources.push_back(resource);
+    return static_cast<uint32_t>(m_resources.size() - 1);
+}
+
+uint32_t RenderGraph::AddPass(const char* name, bool hasSideEffects) {
+    Pass pass;
+    pass.name = name;
+    pass.hasSideEffects = hasSideEffects;
+    m_passes.push_back(std::move(pass));
+    return static_cast<uint32_t>(m_passes.size() - 1);
+}
+
+void RenderGraph::Read(uint32_t pass, uint32_t resource, uint32_t access) {
+    AddUse(pass, resource, access, false);
+}
+
+void RenderGraph::Write(uint32_t pass, uint32_t resource, uint32_t access) {
+    AddUse(pass, resource, access, true);
+}
+
+void RenderGraph::AddUse(uint32_t pass, uint32_t resource, uint32_t access, bool write) {
+    if (pass >= m_passes.size()) {
+        return;
+    }
+    auto& uses = m_passes[pass].uses;
+    for (Use& use : uses) {
+        if (use.resource == resource && !use.write && !write && IsReadOnly(use.access | access)) {
+            use.access |= access; // Same texture bound twice for reading: one combined state
+            return;
+        }
+    }
+    uses.push_back({ resource, access, write });
+}
+
+bool RenderGraph::Compile(RenderGraphPlan& outPlan, std::string& outError) const {
+    outPlan.Clear();
+    const uint32_t passCount = static_cast<uint32_t>(m_passes.size());
+    const uint32_t resourceCount = static_cast<uint32_t>(m_resources.size());
+    outPlan.stats.passesDeclared = passCount;
+
+    // Validate. Dependencies resolve against the latest writer at declaration time, so the
+    // declaration order is always a valid execution order.
+    std::vector<uint8_t> written(resourceCount, 0);
+    for (uint32_t p = 0; p < passCount; ++p) {
+        const Pass& pass = m_passes[p];
+        for (size_t i = 0; i < pass.uses.size(); ++i) {
+            const Use& use = pass.uses[i];
+            if (use.resource >= resourceCount) {
+                outError = std::string("pass '") + pass.name + "' uses an unknown resource";
+                return false;
+            }
+            if (use.write == IsReadOnly(use.access)) {
+                outError = std::string("pass '") + pass.name + "' uses '" + m_resources[use.resource].name + "' with a mismatched access";
+                return false;
+            }
+            for (size_t j = i + 1; j < pass.uses.size(); ++j) {
+                if (pass.uses[j].resource == use.resource) {
+                    outError = std::string("pass '") + pass.name + "' both reads and writes '" + m_resources[use.resource].name + "'";
+                    return false;
+                }
+            }
+            if (!use.write && !m_resources[use.resource].imported && !written[use.resource]) {
+                outError = std::string("pass '") + pass.name + "' reads '" + m_resources[use.resource].name + "' before any pass writes it";
+                return false;
+            }
+        }
+        for (const Use& use : pass.uses) {
+            if (use.write) {
+                written[use.resource] = 1;
+            }
+        }
+    }
+
+    // Cull backwards: a pass lives if it has side effects, writes an import, or writes a
+    // texture version some live later pass reads.
+    std::vector<uint8_t> live(passCount, 0);
+    std::vector<uint8_t> needed(resourceCount, 0);
+    for (uint32_t p = passCount; p > 0; --p) {
+        const Pass& pass = m_passes[p - 1];
+        bool keep = pass.hasSideEffects;
+        for (const Use& use : pass.uses) {
+            if (use.write && (m_resources[use.resource].imported || needed[use.resource])) {
+                keep = true;
+            }
+        }
+        if (!keep) {
+            continue;
+        }
+        live[p - 1] = 1;
+        for (const Use& use : pass.uses) {
+            if (use.write) {
+                needed[use.resource] = 0;
+            }
+        }
+        for (const Use& use : pass.uses) {
+            if (!use.write) {
+                needed[use.resource] = 1;
+            }
+        }
+    }
+
+    for (uint32_t p = 0; p < passCount; ++p) {
+        if (live[p]) {
+            RenderGraphStep step;
+            step.pass = p;
+            outPlan.steps.push_back(step);
+        }
+    }
+    const uint32_t stepCount = static_cast<uint32_t>(outPlan.steps.size());
+    outPlan.stats.passesCulled = passCount - stepCount;
+
+    // Lifetimes of transient textures in steps.
+    std::vector<uint32_t> firstStep(resourceCount, kInvalid);
+    std::vector<uint32_t> lastStep(resourceCount, 0);
+    for (uint32_t s = 0; s < stepCount; ++s) {
+        for (const Use& use : m_passes[outPlan.steps[s].pass].uses) {
+            if (firstStep[use.resource] == kInvalid) {
+                firstStep[use.resource] = s;
+            }
+            lastStep[use.resource] = s;
+        }
+    }
+
+    // Physical indices: imports keep declaration order, transients share slots whose previous
+    // occupant's lifetime has ended.
+    outPlan.resourcePhysical.assign(resourceCount, kInvalid);
+    std::vector<uint32_t> physicalInitial;
+    std::vector<uint32_t> physicalFinal;
+    std::vector<uint32_t> transientOrder;
+    for (uint32_t r = 0; r < resourceCount; ++r) {
+        if (m_resources[r].imported) {
+            outPlan.resourcePhysical[r] = outPlan.importedCount++;
+            physicalInitial.push_back(m_resources[r].initialAccess);
+            physicalFinal.push_back(m_resources[r].finalAccess);
+        } else {
+            ++outPlan.stats.transientTextures;
+            if (firstStep[r] != kInvalid) {
+                transientOrder.push_back(r);
+            }
+        }
+    }
+    std::stable_sort(transientOrder.begin(), transientOrder.end(), [&](uint32_t a, uint32_t b) {
+        return firstStep[a] < firstStep[b];
+    });
+    std::vector<uint32_t> slotLastStep;
+    for (uint32_t r : transientOrder) {
+        const Resource& resource = m_resources[r];
+        uint32_t slot = kInvalid;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(outPlan.transientDescs.size()); ++i) {
+            if (outPlan.transientDescs[i] == resource.desc &&
+                physicalInitial[outPlan.importedCount + i] == resource.initialAccess &&
+                slotLastStep[i] < firstStep[r]) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot == kInvalid) {
+            slot = static_cast<uint32_t>(outPlan.transientDescs.size());
+            outPlan.transientDescs.push_back(resource.desc);
+            slotLastStep.push_back(0);
+            physicalInitial.push_back(resource.initialAccess);
+            physicalFinal.push_back(resource.finalAccess);
+        }
+        slotLastStep[slot] = lastStep[r];
+        outPlan.resourcePhysical[r] = outPlan.importedCount + slot;
+    }
+    outPlan.stats.transientTargets = static_cast<uint32_t>(outPlan.transientDescs.size());
+
+    // Every live use per physical resource, in execution order, for read-state lookahead.
+    struct PhysicalUse {
+        uint32_t step = 0;
+        uint32_t access = 0;
+        bool write = false;
+    };
+    const uint32_t physicalCount = static_cast<uint32_t>(physicalInitial.size());
+    std::vector<std::vector<PhysicalUse>> physicalUses(physicalCount);
+    for (uint32_t s = 0; s < stepCount; ++s) {
+        for (const Use& use : m_passes[outPlan.steps[s].pass].uses) {
+            physicalUses[outPlan.resourcePhysical[use.resource]].push_back({ s, use.access, use.write });
+        }
+    }
+
+    std::vector<uint32_t> state = physicalInitial;
+    std::vector<size_t> cursor(physicalCount, 0);
+    for (uint32_t s = 0; s < stepCount; ++s) {
+        RenderGraphStep& step = outPlan.steps[s];
+        step.firstBarrier = static_cast<uint32_t>(outPlan.barriers.size());
+        for (const Use& use : m_passes[step.pass].uses) {
+            const uint32_t physical = outPlan.resourcePhysical[use.resource];
+            const auto& uses = physicalUses[physical];
+            size_t& at = cursor[physical];
+            while (at < uses.size() && uses[at].step < s) {
+                ++at;
+            }
+
+            uint32_t target = use.access;
+            if (use.write) {
+                if (use.access == RenderGraphAccessUnorderedAccess && state[physical] == RenderGraphAccessUnorderedAccess) {
+                    outPlan.barriers.push_back({ RenderGraphBarrierType::Uav, physical, target, target });
+                    continue;
+                }
+            } else {
+                if (IsReadOnly(state[physical]) && (state[physical] & use.access) == use.access) {
+                    continue;
+                }
+                // Merge every read until the next write into one state, so the resource is
+                // transitioned once however many passes sample, compute-read or copy it.
+                for (size_t i = at; i < uses.size() && !uses[i].write; ++i) {
+                    target |= uses[i].access;
+                }
+            }
+            if (state[physical] != target) {
+                outPlan.barriers.push_back({ RenderGraphBarrierType::Transition, physical, state[physical], target });
+                state[physical] = target;
+            }
+        }
+        step.barrierCount = static_cast<uint32_t>(outPlan.barriers.size()) - step.firstBarrier;
+        if (step.barrierCount > 0) {
+            ++outPlan.stats.barrierBatches;
+        }
+    }
+
+    outPlan.finalFirstBarrier = static_cast<uint32_t>(outPlan.barriers.size());
+    for (uint32_t physical = 0; physical < physicalCount; ++physical) {
+        if (state[physical] != physicalFinal[physical]) {
+            outPlan.barriers.push_back({ RenderGraphBarrierType::Transition, physical, state[physical], physicalFinal[physical] });
+        }
+    }
+    outPlan.finalBarrierCount = static_cast<uint32_t>(outPlan.barriers.size()) - outPlan.finalFirstBarrier;
+    if (outPlan.finalBarrierCount > 0) {
+        ++outPlan.stats.barrierBatches;
+    }
+    outPlan.stats.barriers = static_cast<uint32_t>(outPlan.barriers.size());
+    return true;
+}
+
+} // namespace ShaderLab
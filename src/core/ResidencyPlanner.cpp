@@ -0,0 +1,251 @@
+#include "ShaderLab/Core/ResidencyPlanner.h"
+
+#include "ShaderLab/Core/PlaybackService.h"
+
+#include <algorithm>
+
+namespace ShaderLab {
+
+namespace {
+
+struct Segment {
+    int sceneIndex = -1;
+    double startBeat = 0.0;
+    double endBeat = 0.0;
+};
+
+void MergeIntervals(std::vector<ResidencyInterval>& intervals) {
+    if (intervals.empty()) {
+        return;
+    }
+    std::sort(intervals.begin(), intervals.end(), [](const ResidencyInterval& a, const ResidencyInterval& b) {
+        return a.startBeat < b.startBeat;
+    });
+    size_t out = 0;
+    for (size_t i = 1; i < intervals.size(); ++i) {
+        if (intervals[i].startBeat <= intervals[out].endBeat) {
+            intervals[out].endBeat = (std::max)(intervals[out].endBeat, intervals[i].endBeat);
+        } else {
+            intervals[++out] = intervals[i];
+        }
+    }
+    intervals.resize(out + 1);
+}
+
+void CollectClosure(const std::vector<ResidencySceneInfo>& scenes, int sceneIndex, std::vector<int>& outClosure) {
+    std::vector<bool> visited(scenes.size(), false);
+    std::vector<int> stack = { sceneIndex };
+    visited[static_cast<size_t>(sceneIndex)] = true;
+    while (!stack.empty()) {
+        const int current = stack.back();
+        stack.pop_back();
+        outClosure.push_back(current);
+        for (int dependency : scenes[static_cast<size_t>(current)].dependencies) {
+            if (dependency >= 0 && dependency < static_cast<int>(scenes.size()) && !visited[static_cast<size_t>(dependency)]) {
+                visited[static_cast<size_t>(dependency)] = true;
+                stack.push_back(dependency);
+            }
+        }
+    }
+    std::sort(outClosure.begin(), outClosure.end());
+}
+
+// Replays scene cuts and transitions with DemoSequencer's rules and returns the beat ranges
+// in which each scene is on screen (as the active scene or as either side of a transition).
+std::vector<Segment> ReplayTrack(const DemoTrack& track, int sceneCount, double& outEndBeat) {
+    PlaybackService playback;
+    std::vector<PlaybackEvent> events;
+
+    int lastRowBeat = -1;
+    for (const auto& row : track.rows) {
+        lastRowBeat = (std::max)(lastRowBeat, row.rowId);
+    }
+    const int endBeat = track.lengthBeats > 0 ? track.lengthBeats : lastRowBeat + 1;
+    outEndBeat = static_cast<double>((std::max)(0, endBeat));
+    if (endBeat > 0) {
+        playback.BuildPlaybackEvents(track, -1, endBeat - 1, events);
+    }
+
+    std::vector<Segment> segments;
+    auto emit = [&](int sceneIndex, double startBeat, double stopBeat) {
+        if (sceneIndex >= 0 && sceneIndex < sceneCount && stopBeat > startBeat) {
+            segments.push_back({ sceneIndex, startBeat, stopBeat });
+        }
+    };
+
+    int active = -1;
+    float activeOffset = 0.0f;
+    double activeStartBeat = 0.0;
+    double activeSince = 0.0;
+
+    bool transitionActive = false;
+    int target = -1;
+    float targetOffset = 0.0f;
+    double targetStartBeat = 0.0;
+    double targetSince = 0.0;
+    double transitionEnd = 0.0;
+    int justCompletedBeat = -1;
+
+    auto completeTransition = [&]() {
+        emit(active, activeSince, transitionEnd);
+        active = (target >= 0 && target < sceneCount) ? target : -1;
+        activeOffset = target >= 0 ? targetOffset : 0.0f;
+        activeStartBeat = targetStartBeat;
+        activeSince = targetSince;
+        transitionActive = false;
+    };
+
+    for (const auto& event : events) {
+        const double beat = static_cast<double>(event.beat);
+        if (transitionActive && transitionEnd <= beat) {
+            completeTransition();
+            justCompletedBeat = event.beat;
+        }
+
+        if (event.type == PlaybackEventType::Stop) {
+            outEndBeat = beat;
+            break;
+        }
+        if (event.type != PlaybackEventType::SceneCommand) {
+            continue;
+        }
+
+        if (!event.transitionPresetStem.empty() && event.transitionDuration > 0.0f) {
+            const SceneTransitionResolution resolved =
+                playback.ResolveSceneTransitionTarget(track, event, active, activeOffset, activeStartBeat);
+            if (transitionActive) {
+                emit(target, targetSince, beat);
+            }
+            transitionActive = true;
+            target = resolved.targetSceneIndex;
+            targetOffset = resolved.targetOffset;
+            targetStartBeat = resolved.targetStartBeat;
+            targetSince = beat;
+            transitionEnd = beat + static_cast<double>(event.transitionDuration);
+            continue;
+        }
+
+        if (event.sceneIndex < 0 || event.sceneIndex >= sceneCount) {
+            continue;
+        }
+        if (justCompletedBeat == event.beat && event.sceneIndex == active) {
+            continue;
+        }
+        if (transitionActive && event.sceneIndex == target) {
+            continue;
+        }
+        if (transitionActive) {
+            emit(target, targetSince, beat);
+            transitionActive = false;
+        }
+        emit(active, activeSince, beat);
+        active = event.sceneIndex;
+        activeOffset = event.timeOffset;
+        activeStartBeat = beat;
+        activeSince = beat;
+    }
+
+    if (transitionActive && transitionEnd <= outEndBeat) {
+        completeTransition();
+    }
+    if (transitionActive) {
+        emit(target, targetSince, outEndBeat);
+    }
+    emit(active, activeSince, outEndBeat);
+    return segments;
+}
+
+} // namespace
+
+bool ResidencyPlan::IsResident(int sceneIndex, double beat) const {
+    if (sceneIndex < 0 || sceneIndex >= static_cast<int>(residentIntervals.size())) {
+        return false;
+    }
+    // Past the end (stopped or not looping) the last frame stays on screen.
+    const bool pastEnd = beat >= endBeat;
+    for (const auto& interval : residentIntervals[static_cast<size_t>(sceneIndex)]) {
+        if (pastEnd ? interval.endBeat >= endBeat : (beat >= interval.startBeat && beat < interval.endBeat)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ResidencyPlanner::Build(const DemoTrack& track,
+                             const std::vector<ResidencySceneInfo>& scenes,
+                             const ResidencySettings& settings,
+                             ResidencyPlan& outPlan,
+                             std::string& outError) {
+    outPlan = ResidencyPlan{};
+    if (settings.leadBeats < 0.0 || settings.releaseDelayBeats < 0.0) {
+        outError = "Residency lead and release times must not be negative";
+        return false;
+    }
+
+    const int sceneCount = static_cast<int>(scenes.size());
+    outPlan.dependencyClosure.resize(scenes.size());
+    outPlan.activeIntervals.resize(scenes.size());
+    outPlan.residentIntervals.resize(scenes.size());
+    for (int sceneIndex = 0; sceneIndex < sceneCount; ++sceneIndex) {
+        CollectClosure(scenes, sceneIndex, outPlan.dependencyClosure[static_cast<size_t>(sceneIndex)]);
+        outPlan.eagerBytes += scenes[static_cast<size_t>(sceneIndex)].bytes;
+    }
+
+    const std::vector<Segment> segments = ReplayTrack(track, sceneCount, outPlan.endBeat);
+    for (const auto& segment : segments) {
+        for (int sceneIndex : outPlan.dependencyClosure[static_cast<size_t>(segment.sceneIndex)]) {
+            outPlan.activeIntervals[static_cast<size_t>(sceneIndex)].push_back({ segment.startBeat, segment.endBeat });
+        }
+    }
+
+    const double endBeat = outPlan.endBeat;
+    for (int sceneIndex = 0; sceneIndex < sceneCount; ++sceneIndex) {
+        auto& active = outPlan.activeIntervals[static_cast<size_t>(sceneIndex)];
+        MergeIntervals(active);
+
+        auto& resident = outPlan.residentIntervals[static_cast<size_t>(sceneIndex)];
+        for (const auto& interval : active) {
+            const double start = interval.startBeat - settings.leadBeats;
+            const double stop = interval.endBeat >= endBeat
+                ? endBeat
+                : (std::min)(endBeat, interval.endBeat + settings.releaseDelayBeats);
+            resident.push_back({ (std::max)(0.0, start), stop });
+            if (start < 0.0 && settings.looping && endBeat > 0.0) {
+                resident.push_back({ (std::max)(0.0, endBeat + start), endBeat });
+            }
+        }
+        MergeIntervals(resident);
+
+        for (const auto& interval : resident) {
+            outPlan.events.push_back({ interval.startBeat, sceneIndex, true });
+            if (interval.endBeat < endBeat) {
+                outPlan.events.push_back({ interval.endBeat, sceneIndex, false });
+            }
+        }
+    }
+
+    std::stable_sort(outPlan.events.begin(), outPlan.events.end(), [](const ResidencyEvent& a, const ResidencyEvent& b) {
+        if (a.beat != b.beat) {
+            return a.beat < b.beat;
+        }
+        return a.allocate && !b.allocate;
+    });
+
+    // Allocations sort first at equal beats, so a same-beat swap counts both scenes.
+    uint64_t residentBytes = 0;
+    for (const auto& event : outPlan.events) {
+        const uint64_t bytes = scenes[static_cast<size_t>(event.sceneIndex)].bytes;
+        if (event.allocate) {
+            residentBytes += bytes;
+            if (residentBytes > outPlan.peakBytes) {
+                outPlan.peakBytes = residentBytes;
+                outPlan.peakBeat = event.beat;
+            }
+        } else {
+            residentBytes -= bytes;
+        }
+    }
+    return true;
+}
+
+} // namespace ShaderLab
@@ -275,7 +275,9 @@ struct ExecutablePackAccumulator {
         std::vector<uint8_t> compressedData;
         const std::vector<uint8_t>* payload = &data;
 #if defined(_WIN32)
-        if (compressEntries && TryCompressPackedEntry(data, compressedData)) {
+        // Baked textures stay stored so the player can upload them from the mapped executable.
+        const bool stored = fs::path(packedPath).extension() == ".sltex";
+        if (compressEntries && !stored && TryCompressPackedEntry(data, compressedData)) {
             payload = &compressedData;
         }
 #endif
@@ -429,6 +431,8 @@ bool WritePackedExecutable(const std::string& outputPathText,
     void from_json(const json& j, AudioClip& a);
     void to_json(json& j, const TrackerRow& r);
     void from_json(const json& j, TrackerRow& r);
+    void to_json(json& j, const TrackerRowStore& rows);
+    void from_json(const json& j, TrackerRowStore& rows);
     void to_json(json& j, const DemoTrack& t);
     void from_json(const json& j, DemoTrack& t);
     void to_json(json& j, const ProjectData& p);
@@ -477,6 +481,7 @@ bool WritePackedExecutable(const std::string& outputPathText,
         e.pipelineState = nullptr;
         e.historyIndex = 0;
         e.historyInitialized = false;
+        e.historyFrames = 0;
         e.historyTextures.clear();
     }
 
@@ -532,6 +537,7 @@ bool WritePackedExecutable(const std::string& outputPathText,
         e.pipelineState = nullptr;
         e.historyIndex = 0;
         e.historyInitialized = false;
+        e.historyFrames = 0;
         e.historyTextures.clear();
     }
 
@@ -568,6 +574,7 @@ bool WritePackedExecutable(const std::string& outputPathText,
             {"name", a.name},
             {"path", a.path},
             {"bpm", a.bpm},
+            {"beatOffset", a.beatOffset},
             {"type", (int)a.type}
         };
     }
@@ -576,6 +583,7 @@ bool WritePackedExecutable(const std::string& outputPathText,
         j.at("name").get_to(a.name);
         j.at("path").get_to(a.path);
         j.at("bpm").get_to(a.bpm);
+        if(j.contains("beatOffset")) j.at("beatOffset").get_to(a.beatOffset);
         int t; j.at("type").get_to(t); a.type = (AudioType)t;
     }
 
@@ -617,6 +625,20 @@ bool WritePackedExecutable(const std::string& outputPathText,
         if(j.contains("stop")) j.at("stop").get_to(r.stop);
     }
 
+    void to_json(json& j, const TrackerRowStore& rows) {
+        j = json::array();
+        for (const TrackerRow& row : rows) {
+            j.push_back(row);
+        }
+    }
+
+    void from_json(const json& j, TrackerRowStore& rows) {
+        const size_t dropped = rows.Assign(j.get<std::vector<TrackerRow>>());
+        if (dropped > 0) {
+            std::cerr << "Serializer: dropped " << dropped << " tracker row(s) at a beat that already has a row\n";
+        }
+    }
+
     void to_json(json& j, const DemoTrack& t) {
         j = json{
             {"name", t.name},
@@ -0,0 +1,103 @@
+#include "ShaderLab/Core/ShaderBytecodeCache.h"
+
+#include "ShaderLab/Core/AsyncCompilationService.h"
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 1469598103934665603ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+}
+
+template <typename T>
+void HashValue(uint64_t& hash, const T& value) {
+    HashBytes(hash, &value, sizeof(value));
+}
+
+void HashString(uint64_t& hash, const std::string& text) {
+    HashValue(hash, text.size());
+    HashBytes(hash, text.data(), text.size());
+}
+
+} // namespace
+
+ShaderBytecodeCache::ShaderBytecodeCache(size_t maxBytes)
+    : m_maxBytes(maxBytes) {
+}
+
+uint64_t ShaderBytecodeCache::HashRequest(const AsyncCompileRequest& request) {
+    uint64_t hash = kFnvOffset;
+    HashString(hash, request.source);
+    HashString(hash, request.entryPoint);
+    HashString(hash, request.target);
+    HashValue(hash, request.sourceName.size());
+    for (wchar_t c : request.sourceName) {
+        HashValue(hash, static_cast<uint32_t>(c));
+    }
+    HashValue(hash, static_cast<uint32_t>(request.mode));
+    HashValue(hash, static_cast<uint32_t>(request.flipFragCoord ? 1u : 0u));
+    HashValue(hash, request.bindings.size());
+    for (const CompilationTextureBinding& binding : request.bindings) {
+        HashValue(hash, binding.slot);
+        HashString(hash, binding.type);
+    }
+    return hash;
+}
+
+bool ShaderBytecodeCache::Find(uint64_t key, std::vector<uint8_t>& outBytecode) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_stats.misses;
+        return false;
+    }
+    ++m_stats.hits;
+    outBytecode = it->second;
+    return true;
+}
+
+void ShaderBytecodeCache::Store(uint64_t key, const std::vector<uint8_t>& bytecode) {
+    if (bytecode.empty() || bytecode.size() > m_maxBytes) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto inserted = m_entries.emplace(key, bytecode);
+    if (!inserted.second) {
+        return;
+    }
+    m_order.push_back(key);
+    m_stats.bytes += bytecode.size();
+    ++m_stats.stores;
+    while (m_stats.bytes > m_maxBytes && !m_order.empty()) {
+        auto oldest = m_entries.find(m_order.front());
+        m_order.pop_front();
+        if (oldest != m_entries.end()) {
+            m_stats.bytes -= oldest->second.size();
+            m_entries.erase(oldest);
+            ++m_stats.evictions;
+        }
+    }
+    m_stats.entries = m_entries.size();
+}
+
+void ShaderBytecodeCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_order.clear();
+    m_stats.entries = 0;
+    m_stats.bytes = 0;
+}
+
+ShaderBytecodeCacheStats ShaderBytecodeCache::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // namespace ShaderLab
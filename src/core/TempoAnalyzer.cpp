@@ -0,0 +1,383 @@
+#include "ShaderLab/Core/TempoAnalyzer.h"
+#include "ShaderLab/Core/AudioAnalyzer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr uint32_t kFftSize = 1024;
+constexpr uint32_t kHop = 256;
+constexpr float kLowBandHz = 200.0f;
+constexpr double kPi = 3.14159265358979323846;
+
+unsigned ResolveWorkerCount(unsigned requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1u;
+}
+
+// Splits [0, count) into contiguous ranges; every item writes its own output, so the result
+// does not depend on the worker count.
+void ParallelFor(size_t count, unsigned workers, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    workers = static_cast<unsigned>((std::min)(static_cast<size_t>(workers), count));
+    if (workers <= 1) {
+        body(0, count);
+        return;
+    }
+    const size_t chunk = (count + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    for (size_t begin = chunk; begin < count; begin += chunk) {
+        threads.emplace_back(body, begin, (std::min)(count, begin + chunk));
+    }
+    body(0, chunk);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Removes the local mean (a quarter second either side) and keeps what sticks out above it.
+void Detrend(std::vector<float>& envelope, size_t radius) {
+    std::vector<double> prefix(envelope.size() + 1, 0.0);
+    for (size_t i = 0; i < envelope.size(); ++i) {
+        prefix[i + 1] = prefix[i] + envelope[i];
+    }
+    for (size_t i = 0; i < envelope.size(); ++i) {
+        const size_t first = i > radius ? i - radius : 0;
+        const size_t last = (std::min)(envelope.size(), i + radius + 1);
+        const double mean = (prefix[last] - prefix[first]) / static_cast<double>(last - first);
+        envelope[i] = (std::max)(0.0f, envelope[i] - static_cast<float>(mean));
+    }
+}
+
+void Smooth(std::vector<float>& envelope) {
+    if (envelope.size() < 3) {
+        return;
+    }
+    float previous = envelope[0];
+    for (size_t i = 1; i + 1 < envelope.size(); ++i) {
+        const float current = envelope[i];
+        envelope[i] = 0.25f * previous + 0.5f * current + 0.25f * envelope[i + 1];
+        previous = current;
+    }
+}
+
+float Interpolate(const std::vector<float>& values, double position) {
+    if (position < 0.0) {
+        return 0.0f;
+    }
+    const size_t index = static_cast<size_t>(position);
+    if (index + 1 >= values.size()) {
+        return index < values.size() ? values[index] : 0.0f;
+    }
+    const float t = static_cast<float>(position - static_cast<double>(index));
+    return values[index] + (values[index + 1] - values[index]) * t;
+}
+
+struct Fold {
+    float peak = 0.0f;
+    float mean = 0.0f;
+    double phase = 0.0; // Frames into the period
+};
+
+// Folds the envelope modulo period into half-frame bins and finds the strongest phase. A wrong
+// period smears the peak as the phase drifts over the clip.
+Fold FoldEnvelope(const std::vector<float>& envelope, double period, std::vector<float>& bins) {
+    const size_t binCount = static_cast<size_t>(std::ceil(period * 2.0));
+    const double binsPerFrame = static_cast<double>(binCount) / period;
+    bins.assign(binCount, 0.0f);
+    double phase = 0.0;
+    for (const float value : envelope) {
+        bins[(std::min)(binCount - 1, static_cast<size_t>(phase * binsPerFrame))] += value;
+        phase += 1.0;
+        if (phase >= period) {
+            phase -= period;
+        }
+    }
+    Fold fold;
+    size_t best = 0;
+    float total = 0.0f;
+    for (size_t i = 0; i < binCount; ++i) {
+        const float sum = bins[(i + binCount - 1) % binCount] + bins[i] + bins[(i + 1) % binCount];
+        total += bins[i];
+        if (sum > fold.peak) {
+            fold.peak = sum;
+            best = i;
+        }
+    }
+    fold.mean = total * 3.0f / static_cast<float>(binCount);
+    // Centroid of the three bins around the peak.
+    const float left = bins[(best + binCount - 1) % binCount];
+    const float right = bins[(best + 1) % binCount];
+    const double offset = fold.peak > 0.0f ? static_cast<double>(right - left) / fold.peak : 0.0;
+    fold.phase = std::fmod((static_cast<double>(best) + 0.5 + offset) / binsPerFrame + period, period);
+    return fold;
+}
+
+} // namespace
+
+bool AnalyzeTempo(const float* samples,
+                  size_t sampleCount,
+                  uint32_t sampleRate,
+                  const TempoAnalysisOptions& options,
+                  TempoAnalysisResult& outResult,
+                  std::string& outError) {
+    if (!samples || sampleRate == 0 || !(options.minBpm > 0.0f) || !(options.maxBpm > options.minBpm) ||
+        options.beatsPerBar == 0) {
+        outError = "Invalid tempo analysis input.";
+        return false;
+    }
+    const double framesPerSecond = static_cast<double>(sampleRate) / kHop;
+    const double longestPeriod = 60.0 * framesPerSecond / options.minBpm;
+    const size_t frameCount = sampleCount / kHop + 1u;
+    if (static_cast<double>(frameCount) < longestPeriod * 8.0) {
+        outError = "Clip is too short to estimate a tempo.";
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const unsigned workers = ResolveWorkerCount(options.workerCount);
+    AudioFft fft;
+    if (!fft.Initialize(kFftSize, outError)) {
+        return false;
+    }
+    std::vector<float> hann(kFftSize);
+    for (uint32_t i = 0; i < kFftSize; ++i) {
+        hann[i] = static_cast<float>(0.5 - 0.5 * std::cos(2.0 * kPi * i / kFftSize));
+    }
+    const uint32_t bins = kFftSize / 2u;
+    const uint32_t lowBins = (std::max)(2u, static_cast<uint32_t>(kLowBandHz * kFftSize / sampleRate) + 1u);
+
+    // Spectral flux; frame f is centred on sample f * kHop. Each chunk also transforms the
+    // frame before its first so the chunks need nothing from each other.
+    std::vector<float> flux(frameCount, 0.0f);
+    std::vector<float> lowFlux(frameCount, 0.0f);
+    ParallelFor(frameCount, workers, [&](size_t begin, size_t end) {
+        std::vector<float> re(kFftSize);
+        std::vector<float> im(kFftSize);
+        std::vector<float> previous(bins, 0.0f);
+        std::vector<float> current(bins, 0.0f);
+        const float scale = 4.0f / kFftSize;
+        auto transform = [&](size_t frame, std::vector<float>& outLog) {
+            const int64_t first = static_cast<int64_t>(frame) * kHop - kFftSize / 2;
+            for (uint32_t i = 0; i < kFftSize; ++i) {
+                const int64_t index = first + i;
+                re[i] = index >= 0 && index < static_cast<int64_t>(sampleCount) ? samples[index] * hann[i] : 0.0f;
+                im[i] = 0.0f;
+            }
+            fft.Forward(re.data(), im.data());
+            for (uint32_t k = 0; k < bins; ++k) {
+                outLog[k] = std::log1p(100.0f * scale * std::sqrt(re[k] * re[k] + im[k] * im[k]));
+            }
+        };
+        if (begin > 0) {
+            transform(begin - 1, previous);
+        }
+        for (size_t frame = begin; frame < end; ++frame) {
+            transform(frame, current);
+            float sum = 0.0f;
+            float lowSum = 0.0f;
+            for (uint32_t k = 1; k < bins; ++k) {
+                const float rise = (std::max)(0.0f, current[k] - previous[k]);
+                sum += rise;
+                lowSum += k < lowBins ? rise : 0.0f;
+            }
+            flux[frame] = frame > 0 ? sum / bins : 0.0f;
+            lowFlux[frame] = frame > 0 ? lowSum / (lowBins - 1u) : 0.0f;
+            previous.swap(current);
+        }
+    });
+    const auto onsetsDone = std::chrono::steady_clock::now();
+
+    const size_t radius = static_cast<size_t>(framesPerSecond * 0.25);
+    Detrend(flux, radius);
+    Detrend(lowFlux, radius);
+    Smooth(flux);
+    Smooth(lowFlux);
+
+    // Coarse tempo: comb over the autocorrelation. Each tooth subtracts the half-period point, so
+    // half and double tempos, which share some of the peaks, score low.
+    const double shortestPeriod = 60.0 * framesPerSecond / options.maxBpm;
+    const size_t maxLag = static_cast<size_t>(std::ceil(longestPeriod * 4.0)) + 2u;
+    std::vector<float> autocorrelation(maxLag + 1u, 0.0f);
+    ParallelFor(maxLag + 1u, workers, [&](size_t begin, size_t end) {
+        for (size_t lag = begin; lag < end; ++lag) {
+            double sum = 0.0;
+            for (size_t i = lag; i < frameCount; ++i) {
+                sum += static_cast<double>(flux[i]) * flux[i - lag];
+            }
+            autocorrelation[lag] = static_cast<float>(sum / static_cast<double>(frameCount - lag));
+        }
+    });
+    double coarsePeriod = 0.0;
+    double bestScore = -1e30;
+    for (double bpm = options.minBpm; bpm <= options.maxBpm; bpm += 0.1) {
+        const double period = 60.0 * framesPerSecond / bpm;
+        double score = 0.0;
+        for (int k = 1; k <= 4; ++k) {
+            score += Interpolate(autocorrelation, period * k) - Interpolate(autocorrelation, period * (k - 0.5));
+        }
+        // Mild preference for moderate tempos, one octave wide.
+        const double octaves = std::log2(bpm / 120.0);
+        score *= std::exp(-0.5 * octaves * octaves);
+        if (score > bestScore) {
+            bestScore = score;
+            coarsePeriod = period;
+        }
+    }
+
+    // Fine tempo: the period whose fold over the whole clip has the sharpest peak, searched
+    // coarse to fine.
+    double period = coarsePeriod;
+    for (const double step : { 0.02, 0.002 }) {
+        const double span = step == 0.02 ? period * 0.02 : 0.03;
+        const size_t candidates = static_cast<size_t>(span * 2.0 / step) + 1u;
+        std::vector<float> peaks(candidates, 0.0f);
+        const double first = period - span;
+        ParallelFor(candidates, workers, [&](size_t begin, size_t end) {
+            std::vector<float> foldBins;
+            for (size_t i = begin; i < end; ++i) {
+                const double candidate = first + step * static_cast<double>(i);
+                if (candidate >= shortestPeriod * 0.98 && candidate <= longestPeriod * 1.02) {
+                    const Fold fold = FoldEnvelope(flux, candidate, foldBins);
+                    peaks[i] = fold.peak - fold.mean;
+                }
+            }
+        });
+        const size_t best = static_cast<size_t>(std::max_element(peaks.begin(), peaks.end()) - peaks.begin());
+        period = first + step * static_cast<double>(best);
+    }
+
+    std::vector<float> foldBins;
+    const Fold fold = FoldEnvelope(flux, period, foldBins);
+
+    // Downbeat: the beat of the bar that collects the most low-band onset energy.
+    std::vector<double> barEnergy(options.beatsPerBar, 0.0);
+    size_t beat = 0;
+    for (double position = fold.phase; position < static_cast<double>(frameCount); position += period, ++beat) {
+        float strongest = 0.0f;
+        for (int offset = -1; offset <= 1; ++offset) {
+            strongest = (std::max)(strongest, Interpolate(lowFlux, position + offset));
+        }
+        barEnergy[beat % options.beatsPerBar] += strongest;
+    }
+    const size_t downbeat = static_cast<size_t>(std::max_element(barEnergy.begin(), barEnergy.end()) - barEnergy.begin());
+
+    const double secondsPerFrame = static_cast<double>(kHop) / sampleRate;
+    outResult = TempoAnalysisResult();
+    outResult.bpm = static_cast<float>(60.0 * framesPerSecond / period);
+    outResult.firstBeat = static_cast<float>(fold.phase * secondsPerFrame);
+    outResult.beatOffset = static_cast<float>((fold.phase + period * static_cast<double>(downbeat)) * secondsPerFrame);
+    outResult.confidence = fold.peak > 0.0f ? (std::min)(1.0f, (std::max)(0.0f, 1.0f - fold.mean / fold.peak)) : 0.0f;
+    outResult.durationSeconds = static_cast<double>(sampleCount) / sampleRate;
+    outResult.onsetMs = std::chrono::duration<double, std::milli>(onsetsDone - start).count();
+    outResult.tempoMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - onsetsDone).count();
+    return true;
+}
+
+uint64_t HashTempoSource(const void* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool TempoAnalysisCache::Find(uint64_t hash, TempoAnalysisResult& outResult) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(hash);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    outResult = it->second;
+    return true;
+}
+
+void TempoAnalysisCache::Store(uint64_t hash, const TempoAnalysisResult& result) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[hash] = result;
+}
+
+size_t TempoAnalysisCache::GetSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+bool TempoAnalysisCache::Load(const std::string& path, std::string& outError) {
+    std::ifstream file(path);
+    if (!file) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        TempoAnalysisResult result;
+        if (!(fields >> key >> result.bpm >> result.beatOffset >> result.firstBeat >> result.confidence >> result.durationSeconds)) {
+            continue;
+        }
+        char* end = nullptr;
+        const uint64_t hash = std::strtoull(key.c_str(), &end, 16);
+        if (!end || *end != '\0') {
+            outError = "Malformed tempo cache line: " + line;
+            return false;
+        }
+        m_entries[hash] = result;
+    }
+    return true;
+}
+
+bool TempoAnalysisCache::Save(const std::string& path, std::string& outError) const {
+    // Detections finish on their own workers; the lock keeps two saves from writing at once, and
+    // the rename keeps a crash mid-write from truncating the cache.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file) {
+            outError = "Cannot write tempo cache: " + tempPath;
+            return false;
+        }
+        char line[160];
+        for (const auto& entry : m_entries) {
+            const TempoAnalysisResult& result = entry.second;
+            std::snprintf(line, sizeof(line), "%016" PRIx64 " %.4f %.4f %.4f %.3f %.3f\n", entry.first, result.bpm,
+                          result.beatOffset, result.firstBeat, result.confidence, result.durationSeconds);
+            file << line;
+        }
+        file.close();
+        if (!file) {
+            outError = "Cannot write tempo cache: " + tempPath;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        outError = "Cannot replace tempo cache: " + path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,104 @@
+#include "ShaderLab/Core/TextSearch.h"
+
+#include <bit>
+#include <cstring>
+#include <utility>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SHADERLAB_TEXT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace ShaderLab {
+
+size_t FindText(const char* text, size_t textSize, const char* needle, size_t needleSize, size_t from) {
+    if (from > textSize) {
+        return kTextNotFound;
+    }
+    if (needleSize == 0) {
+        return from;
+    }
+    if (textSize - from < needleSize) {
+        return kTextNotFound;
+    }
+    if (needleSize == 1) {
+        const void* hit = std::memchr(text + from, needle[0], textSize - from);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - text) : kTextNotFound;
+    }
+
+    const size_t lastStart = textSize - needleSize;
+    const char first = needle[0];
+    const char last = needle[needleSize - 1];
+    size_t i = from;
+
+#if defined(SHADERLAB_TEXT_SSE2)
+    const __m128i firstMask = _mm_set1_epi8(first);
+    const __m128i lastMask = _mm_set1_epi8(last);
+    // Every start in [i, i + 16) must be a valid match position, so both loads stay in bounds.
+    for (; i + 16 <= lastStart + 1; i += 16) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + needleSize - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstMask), _mm_cmpeq_epi8(blockLast, lastMask))));
+        while (mask != 0) {
+            const size_t candidate = i + static_cast<size_t>(std::countr_zero(mask));
+            if (std::memcmp(text + candidate + 1, needle + 1, needleSize - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i <= lastStart; ++i) {
+        if (text[i] == first && text[i + needleSize - 1] == last &&
+            std::memcmp(text + i + 1, needle + 1, needleSize - 2) == 0) {
+            return i;
+        }
+    }
+    return kTextNotFound;
+}
+
+size_t CountText(const char* text, size_t textSize, const char* needle, size_t needleSize) {
+    if (needleSize == 0) {
+        return 0;
+    }
+    size_t count = 0;
+    size_t pos = 0;
+    while ((pos = FindText(text, textSize, needle, needleSize, pos)) != kTextNotFound) {
+        ++count;
+        pos += needleSize;
+    }
+    return count;
+}
+
+size_t ReplaceAllText(const std::string& text,
+                      const std::string& needle,
+                      const std::string& replacement,
+                      std::string& outText) {
+    if (needle.empty()) {
+        outText = text;
+        return 0;
+    }
+
+    std::string result;
+    result.reserve(text.size());
+    size_t count = 0;
+    size_t pos = 0;
+    size_t found = 0;
+    while ((found = FindText(text.data(), text.size(), needle.data(), needle.size(), pos)) != kTextNotFound) {
+        result.append(text, pos, found - pos);
+        result += replacement;
+        pos = found + needle.size();
+        ++count;
+    }
+    if (count == 0) {
+        outText = text;
+        return 0;
+    }
+    result.append(text, pos, std::string::npos);
+    outText = std::move(result);
+    return count;
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,1190 @@
+#include "ShaderLab/Core/TextureBaker.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+namespace ShaderLab {
+
+namespace {
+
+// Linear RGBA, width * height * depth texels.
+struct FloatImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t depth = 1;
+    std::vector<float> texels;
+
+    void Resize(uint32_t w, uint32_t h, uint32_t d) {
+        width = w;
+        height = h;
+        depth = d;
+        texels.assign(static_cast<size_t>(w) * h * d * 4u, 0.0f);
+    }
+    float* At(uint32_t x, uint32_t y, uint32_t z) {
+        return texels.data() + ((static_cast<size_t>(z) * height + y) * width + x) * 4u;
+    }
+    const float* At(uint32_t x, uint32_t y, uint32_t z) const {
+        return texels.data() + ((static_cast<size_t>(z) * height + y) * width + x) * 4u;
+    }
+};
+
+// RGBA8 level as stored before block encoding.
+struct Level {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t depth = 1;
+    std::vector<uint8_t> rgba;
+};
+
+struct Taps {
+    std::vector<uint32_t> indices;
+    std::vector<float> weights;
+};
+
+uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+unsigned ResolveWorkerCount(unsigned requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1u;
+}
+
+// Splits [0, count) into contiguous ranges; every item writes its own output, so the result
+// does not depend on the worker count.
+void ParallelFor(size_t count, unsigned workers, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    workers = static_cast<unsigned>((std::min)(static_cast<size_t>(workers), count));
+    if (workers <= 1) {
+        body(0, count);
+        return;
+    }
+    const size_t chunk = (count + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    for (size_t begin = chunk; begin < count; begin += chunk) {
+        threads.emplace_back(body, begin, (std::min)(count, begin + chunk));
+    }
+    body(0, chunk);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+const std::array<float, 256>& SrgbToLinearTable() {
+    static const std::array<float, 256> table = []() {
+        std::array<float, 256> values{};
+        for (size_t i = 0; i < values.size(); ++i) {
+            const float c = static_cast<float>(i) / 255.0f;
+            values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+    }();
+    return table;
+}
+
+uint8_t ToUnorm8(float value) {
+    value = (std::min)((std::max)(value, 0.0f), 1.0f);
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+uint8_t LinearToSrgb8(float value) {
+    value = (std::min)((std::max)(value, 0.0f), 1.0f);
+    const float encoded = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    return ToUnorm8(encoded);
+}
+
+// Tiles of tileWidth x tileHeight become the slices of the result.
+FloatImage ExtractTiles(const DecodedImage& source, uint32_t tileWidth, uint32_t tileHeight, uint32_t tileCount,
+                        bool horizontal, uint32_t firstTile, bool srgb) {
+    const auto& toLinear = SrgbToLinearTable();
+    FloatImage image;
+    image.Resize(tileWidth, tileHeight, tileCount);
+    for (uint32_t z = 0; z < tileCount; ++z) {
+        const uint32_t x0 = horizontal ? (firstTile + z) * tileWidth : 0u;
+        const uint32_t y0 = horizontal ? 0u : (firstTile + z) * tileHeight;
+        for (uint32_t y = 0; y < tileHeight; ++y) {
+            const uint8_t* src = source.rgba.data() + (static_cast<size_t>(y0 + y) * source.width + x0) * 4u;
+            float* dst = image.At(0, y, z);
+            for (uint32_t x = 0; x < tileWidth; ++x, src += 4, dst += 4) {
+                for (int c = 0; c < 3; ++c) {
+                    dst[c] = srgb ? toLinear[src[c]] : src[c] / 255.0f;
+                }
+                dst[3] = src[3] / 255.0f;
+            }
+        }
+    }
+    return image;
+}
+
+double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+        const double half = x / (2.0 * k);
+        term *= half * half;
+        sum += term;
+    }
+    return sum;
+}
+
+// Filter taps for halving one axis, with edge texels clamped.
+std::vector<Taps> BuildTaps(uint32_t srcSize, uint32_t dstSize, MipFilter filter) {
+    std::vector<Taps> taps(dstSize);
+    if (srcSize == dstSize) {
+        for (uint32_t i = 0; i < dstSize; ++i) {
+            taps[i].indices = { i };
+            taps[i].weights = { 1.0f };
+        }
+        return taps;
+    }
+    if (filter == MipFilter::Box) {
+        for (uint32_t i = 0; i < dstSize; ++i) {
+            taps[i].indices = { 2 * i, (std::min)(2 * i + 1, srcSize - 1) };
+            taps[i].weights = { 0.5f, 0.5f };
+        }
+        return taps;
+    }
+
+    // Kaiser-windowed sinc, three destination texels wide on each side.
+    constexpr double kRadius = 3.0;
+    constexpr double kAlpha = 4.0;
+    constexpr double kPi = 3.14159265358979323846;
+    const double scale = static_cast<double>(srcSize) / dstSize;
+    const double i0Alpha = BesselI0(kAlpha);
+    for (uint32_t i = 0; i < dstSize; ++i) {
+        const double center = (i + 0.5) * scale - 0.5;
+        const int first = static_cast<int>(std::ceil(center - kRadius * scale));
+        const int last = static_cast<int>(std::floor(center + kRadius * scale));
+        double total = 0.0;
+        std::vector<double> weights;
+        for (int s = first; s <= last; ++s) {
+            const double d = (s - center) / scale;
+            const double t = d / kRadius;
+            if (std::fabs(t) >= 1.0) {
+                continue;
+            }
+            const double sinc = std::fabs(d) < 1e-9 ? 1.0 : std::sin(kPi * d) / (kPi * d);
+            const double w = sinc * BesselI0(kAlpha * std::sqrt(1.0 - t * t)) / i0Alpha;
+            const uint32_t index = static_cast<uint32_t>((std::min)((std::max)(s, 0), static_cast<int>(srcSize) - 1));
+            taps[i].indices.push_back(index);
+            weights.push_back(w);
+            total += w;
+        }
+        for (double w : weights) {
+            taps[i].weights.push_back(static_cast<float>(w / total));
+        }
+    }
+    return taps;
+}
+
+// One separable pass along axis 0 (x), 1 (y) or 2 (z).
+FloatImage ResampleAxis(const FloatImage& src, int axis, const std::vector<Taps>& taps, unsigned workers) {
+    FloatImage dst;
+    const uint32_t size = static_cast<uint32_t>(taps.size());
+    dst.Resize(axis == 0 ? size : src.width, axis == 1 ? size : src.height, axis == 2 ? size : src.depth);
+    ParallelFor(static_cast<size_t>(dst.height) * dst.depth, workers, [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            const uint32_t y = static_cast<uint32_t>(row % dst.height);
+            const uint32_t z = static_cast<uint32_t>(row / dst.height);
+            float* out = dst.At(0, y, z);
+            for (uint32_t x = 0; x < dst.width; ++x, out += 4) {
+                const uint32_t coord = axis == 0 ? x : (axis == 1 ? y : z);
+                const Taps& tap = taps[coord];
+                float sum[4] = {};
+                for (size_t t = 0; t < tap.indices.size(); ++t) {
+                    const uint32_t s = tap.indices[t];
+                    const float* in = axis == 0 ? src.At(s, y, z) : (axis == 1 ? src.At(x, s, z) : src.At(x, y, s));
+                    for (int c = 0; c < 4; ++c) {
+                        sum[c] += in[c] * tap.weights[t];
+                    }
+                }
+                std::memcpy(out, sum, sizeof(sum));
+            }
+        }
+    });
+    return dst;
+}
+
+FloatImage Downsample(const FloatImage& src, MipFilter filter, unsigned workers) {
+    const uint32_t w = (std::max)(src.width / 2u, 1u);
+    const uint32_t h = (std::max)(src.height / 2u, 1u);
+    const uint32_t d = (std::max)(src.depth / 2u, 1u);
+    FloatImage result = ResampleAxis(src, 0, BuildTaps(src.width, w, filter), workers);
+    result = ResampleAxis(result, 1, BuildTaps(src.height, h, filter), workers);
+    if (d != src.depth) {
+        result = ResampleAxis(result, 2, BuildTaps(src.depth, d, filter), workers);
+    }
+    return result;
+}
+
+Level ToLevel(const FloatImage& image, bool srgb, unsigned workers) {
+    Level level;
+    level.width = image.width;
+    level.height = image.height;
+    level.depth = image.depth;
+    level.rgba.resize(image.texels.size());
+    ParallelFor(image.texels.size() / 4u, workers, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const float* in = image.texels.data() + i * 4u;
+            uint8_t* out = level.rgba.data() + i * 4u;
+            for (int c = 0; c < 3; ++c) {
+                out[c] = srgb ? LinearToSrgb8(in[c]) : ToUnorm8(in[c]);
+            }
+            out[3] = ToUnorm8(in[3]);
+        }
+    });
+    return level;
+}
+
+// ---------------------------------------------------------------------------------------------
+// Block codecs. Encoders fit endpoints along the principal axis of the block, then refine them
+// once by least squares over the chosen weights and keep whichever fit is better.
+
+using BlockTexels = std::array<std::array<uint8_t, 4>, 16>;
+
+template <int N>
+void PrincipalAxisEndpoints(const float (&points)[16][N], float (&outLow)[N], float (&outHigh)[N]) {
+    float mean[N] = {};
+    for (const auto& p : points) {
+        for (int c = 0; c < N; ++c) {
+            mean[c] += p[c] / 16.0f;
+        }
+    }
+    float cov[N][N] = {};
+    for (const auto& p : points) {
+        for (int a = 0; a < N; ++a) {
+            for (int b = 0; b < N; ++b) {
+                cov[a][b] += (p[a] - mean[a]) * (p[b] - mean[b]);
+            }
+        }
+    }
+    float axis[N];
+    for (int c = 0; c < N; ++c) {
+        axis[c] = 1.0f;
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[N] = {};
+        float length = 0.0f;
+        for (int a = 0; a < N; ++a) {
+            for (int b = 0; b < N; ++b) {
+                next[a] += cov[a][b] * axis[b];
+            }
+            length = (std::max)(length, std::fabs(next[a]));
+        }
+        if (length < 1e-6f) {
+            break;
+        }
+        for (int c = 0; c < N; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+    float axisLength = 0.0f;
+    for (int c = 0; c < N; ++c) {
+        axisLength += axis[c] * axis[c];
+    }
+    axisLength = std::sqrt(axisLength);
+    for (int c = 0; c < N; ++c) {
+        axis[c] /= axisLength;
+    }
+    float lo = 0.0f;
+    float hi = 0.0f;
+    for (const auto& p : points) {
+        float t = 0.0f;
+        for (int c = 0; c < N; ++c) {
+            t += (p[c] - mean[c]) * axis[c];
+        }
+        lo = (std::min)(lo, t);
+        hi = (std::max)(hi, t);
+    }
+    for (int c = 0; c < N; ++c) {
+        outLow[c] = mean[c] + axis[c] * lo;
+        outHigh[c] = mean[c] + axis[c] * hi;
+    }
+}
+
+// Endpoints a (weight 0) and b (weight 1) minimising the squared error for fixed weights.
+template <int N>
+bool LeastSquaresEndpoints(const float (&points)[16][N], const float (&weights)[16], float (&outA)[N], float (&outB)[N]) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    float xa[N] = {};
+    float xb[N] = {};
+    for (int i = 0; i < 16; ++i) {
+        const float t = weights[i];
+        const float s = 1.0f - t;
+        aa += s * s;
+        ab += s * t;
+        bb += t * t;
+        for (int c = 0; c < N; ++c) {
+            xa[c] += s * points[i][c];
+            xb[c] += t * points[i][c];
+        }
+    }
+    const float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c < N; ++c) {
+        outA[c] = (bb * xa[c] - ab * xb[c]) / det;
+        outB[c] = (aa * xb[c] - ab * xa[c]) / det;
+    }
+    return true;
+}
+
+// BC1 --------------------------------------------------------------------------------------------
+
+void ExpandRgb565(uint16_t color, int (&out)[3]) {
+    const int r = (color >> 11) & 31;
+    const int g = (color >> 5) & 63;
+    const int b = color & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+uint16_t PackRgb565(const float (&color)[3]) {
+    const auto quantize = [](float v, int maxValue) {
+        return (std::min)((std::max)(static_cast<int>(v * maxValue / 255.0f + 0.5f), 0), maxValue);
+    };
+    return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+}
+
+void Bc1Palette(uint16_t c0, uint16_t c1, int (&palette)[4][4]) {
+    int a[3];
+    int b[3];
+    ExpandRgb565(c0, a);
+    ExpandRgb565(c1, b);
+    for (int c = 0; c < 3; ++c) {
+        palette[0][c] = a[c];
+        palette[1][c] = b[c];
+        if (c0 > c1) {
+            palette[2][c] = (2 * a[c] + b[c]) / 3;
+            palette[3][c] = (a[c] + 2 * b[c]) / 3;
+        } else {
+            palette[2][c] = (a[c] + b[c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = c0 > c1 ? 255 : 0;
+}
+
+// Returns the squared error; indices are written to outIndices.
+float Bc1Assign(const float (&points)[16][3], uint16_t c0, uint16_t c1, uint32_t& outIndices, float (&outWeights)[16]) {
+    static const float kWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+    int palette[4][4];
+    Bc1Palette(c0, c1, palette);
+    outIndices = 0;
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        float bestError = 1e30f;
+        for (int k = 0; k < 4; ++k) {
+            float error = 0.0f;
+            for (int c = 0; c < 3; ++c) {
+                const float d = points[i][c] - palette[k][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = k;
+            }
+        }
+        outIndices |= static_cast<uint32_t>(best) << (2 * i);
+        outWeights[i] = kWeights[best];
+        total += bestError;
+    }
+    return total;
+}
+
+// Orders endpoints for four-colour mode and picks indices.
+float Bc1Fit(const float (&points)[16][3], const float (&high)[3], const float (&low)[3],
+             uint16_t& c0, uint16_t& c1, uint32_t& indices, float (&weights)[16]) {
+    c0 = PackRgb565(high);
+    c1 = PackRgb565(low);
+    if (c0 < c1) {
+        std::swap(c0, c1);
+    }
+    if (c0 == c1) {
+        indices = 0;
+        std::fill(std::begin(weights), std::end(weights), 0.0f);
+        int palette[4][4];
+        Bc1Palette(c0, c1, palette);
+        float error = 0.0f;
+        for (const auto& p : points) {
+            for (int c = 0; c < 3; ++c) {
+                error += (p[c] - palette[0][c]) * (p[c] - palette[0][c]);
+            }
+        }
+        return error;
+    }
+    return Bc1Assign(points, c0, c1, indices, weights);
+}
+
+void EncodeBc1Block(const BlockTexels& texels, uint8_t* out) {
+    float points[16][3];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            points[i][c] = texels[i][c];
+        }
+    }
+    float low[3];
+    float high[3];
+    PrincipalAxisEndpoints(points, low, high);
+
+    uint16_t c0 = 0;
+    uint16_t c1 = 0;
+    uint32_t indices = 0;
+    float weights[16];
+    float error = Bc1Fit(points, high, low, c0, c1, indices, weights);
+
+    float a[3];
+    float b[3];
+    if (error > 0.0f && LeastSquaresEndpoints(points, weights, a, b)) {
+        uint16_t r0 = 0;
+        uint16_t r1 = 0;
+        uint32_t refinedIndices = 0;
+        float refinedWeights[16];
+        const float refinedError = Bc1Fit(points, a, b, r0, r1, refinedIndices, refinedWeights);
+        if (refinedError < error) {
+            c0 = r0;
+            c1 = r1;
+            indices = refinedIndices;
+        }
+    }
+    std::memcpy(out, &c0, 2);
+    std::memcpy(out + 2, &c1, 2);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+void DecodeBc1Block(const uint8_t* in, BlockTexels& texels) {
+    uint16_t c0 = 0;
+    uint16_t c1 = 0;
+    uint32_t indices = 0;
+    std::memcpy(&c0, in, 2);
+    std::memcpy(&c1, in + 2, 2);
+    std::memcpy(&indices, in + 4, 4);
+    int palette[4][4];
+    Bc1Palette(c0, c1, palette);
+    for (int i = 0; i < 16; ++i) {
+        const int k = (indices >> (2 * i)) & 3;
+        for (int c = 0; c < 4; ++c) {
+            texels[i][c] = static_cast<uint8_t>(palette[k][c]);
+        }
+    }
+}
+
+// BC4 --------------------------------------------------------------------------------------------
+
+void Bc4Palette(int r0, int r1, int (&palette)[8]) {
+    palette[0] = r0;
+    palette[1] = r1;
+    if (r0 > r1) {
+        for (int i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * r0 + (i - 1) * r1 + 3) / 7;
+        }
+    } else {
+        for (int i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * r0 + (i - 1) * r1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+void EncodeBc4Block(const BlockTexels& texels, uint8_t* out) {
+    int lo = 255;
+    int hi = 0;
+    for (const auto& t : texels) {
+        lo = (std::min)(lo, static_cast<int>(t[0]));
+        hi = (std::max)(hi, static_cast<int>(t[0]));
+    }
+    int palette[8];
+    Bc4Palette(hi, lo, palette);
+    uint64_t bits = 0;
+    if (hi > lo) {
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 1 << 30;
+            for (int k = 0; k < 8; ++k) {
+                const int error = std::abs(palette[k] - texels[i][0]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = k;
+                }
+            }
+            bits |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+    out[0] = static_cast<uint8_t>(hi);
+    out[1] = static_cast<uint8_t>(lo);
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+void DecodeBc4Block(const uint8_t* in, BlockTexels& texels) {
+    int palette[8];
+    Bc4Palette(in[0], in[1], palette);
+    uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i) {
+        bits |= static_cast<uint64_t>(in[2 + i]) << (8 * i);
+    }
+    for (int i = 0; i < 16; ++i) {
+        // Matches what a BC4_UNORM view returns.
+        texels[i] = { static_cast<uint8_t>(palette[(bits >> (3 * i)) & 7]), 0, 0, 255 };
+    }
+}
+
+// BC7. Mode 6 (one RGBA line, 7.7.7.7 endpoints with a p-bit each, 4-bit indices) suits opaque
+// and correlated alpha; mode 5 (RGB 7.7.7 and a separate 8-bit alpha line, 2-bit indices each)
+// covers alpha that varies independently. Each block keeps the mode with the lower error.
+
+constexpr int kBc7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+constexpr int kBc7Weights2[4] = { 0, 21, 43, 64 };
+
+struct Bc7Endpoint {
+    int q[4] = {}; // 7-bit
+    int p = 0;
+    int Value(int c) const { return (q[c] << 1) | p; }
+};
+
+Bc7Endpoint QuantizeBc7Endpoint(const float (&color)[4]) {
+    Bc7Endpoint best;
+    float bestError = 1e30f;
+    for (int p = 0; p < 2; ++p) {
+        Bc7Endpoint candidate;
+        candidate.p = p;
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            candidate.q[c] = (std::min)((std::max)(static_cast<int>(std::floor((color[c] - p) / 2.0f + 0.5f)), 0), 127);
+            const float d = static_cast<float>(candidate.Value(c)) - color[c];
+            error += d * d;
+        }
+        if (error < bestError) {
+            bestError = error;
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+int Bc7Interpolate(int e0, int e1, int weight) {
+    return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+}
+
+// Picks the nearest of weightCount ramp entries between e0 and e1 (N channels of 8-bit values).
+template <int N>
+float Bc7Assign(const float (&points)[16][N], const int (&e0)[N], const int (&e1)[N], const int* weightTable,
+                int weightCount, uint8_t (&outIndices)[16], float (&outWeights)[16]) {
+    int palette[16][N];
+    for (int k = 0; k < weightCount; ++k) {
+        for (int c = 0; c < N; ++c) {
+            palette[k][c] = Bc7Interpolate(e0[c], e1[c], weightTable[k]);
+        }
+    }
+    float total = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        int best = 0;
+        float bestError = 1e30f;
+        for (int k = 0; k < weightCount; ++k) {
+            float error = 0.0f;
+            for (int c = 0; c < N; ++c) {
+                const float d = points[i][c] - palette[k][c];
+                error += d * d;
+            }
+            if (error < bestError) {
+                bestError = error;
+                best = k;
+            }
+        }
+        outIndices[i] = static_cast<uint8_t>(best);
+        outWeights[i] = weightTable[best] / 64.0f;
+        total += bestError;
+    }
+    return total;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* out) : m_out(out) { std::memset(out, 0, 16); }
+    void Write(uint32_t value, int bits) {
+        for (int i = 0; i < bits; ++i, ++m_position) {
+            if ((value >> i) & 1u) {
+                m_out[m_position >> 3] |= static_cast<uint8_t>(1u << (m_position & 7));
+            }
+        }
+    }
+
+private:
+    uint8_t* m_out;
+    int m_position = 0;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* in) : m_in(in) {}
+    uint32_t Read(int bits) {
+        uint32_t value = 0;
+        for (int i = 0; i < bits; ++i, ++m_position) {
+            value |= static_cast<uint32_t>((m_in[m_position >> 3] >> (m_position & 7)) & 1u) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_in;
+    int m_position = 0;
+};
+
+// The anchor (texel 0) index drops its top bit, so it must sit in the lower half of the ramp.
+void FixBc7Anchor(uint8_t (&indices)[16], int weightCount, bool& outSwap) {
+    outSwap = indices[0] >= weightCount / 2;
+    if (outSwap) {
+        for (auto& index : indices) {
+            index = static_cast<uint8_t>(weightCount - 1 - index);
+        }
+    }
+}
+
+float EncodeBc7Mode6(const float (&points)[16][4], uint8_t* out) {
+    float low[4];
+    float high[4];
+    PrincipalAxisEndpoints(points, low, high);
+
+    const auto values = [](const Bc7Endpoint& e, int (&v)[4]) {
+        for (int c = 0; c < 4; ++c) {
+            v[c] = e.Value(c);
+        }
+    };
+    Bc7Endpoint e0 = QuantizeBc7Endpoint(low);
+    Bc7Endpoint e1 = QuantizeBc7Endpoint(high);
+    int v0[4];
+    int v1[4];
+    values(e0, v0);
+    values(e1, v1);
+    uint8_t indices[16];
+    float weights[16];
+    float error = Bc7Assign(points, v0, v1, kBc7Weights4, 16, indices, weights);
+
+    float a[4];
+    float b[4];
+    if (error > 0.0f && LeastSquaresEndpoints(points, weights, a, b)) {
+        const Bc7Endpoint r0 = QuantizeBc7Endpoint(a);
+        const Bc7Endpoint r1 = QuantizeBc7Endpoint(b);
+        values(r0, v0);
+        values(r1, v1);
+        uint8_t refinedIndices[16];
+        float refinedWeights[16];
+        const float refinedError = Bc7Assign(points, v0, v1, kBc7Weights4, 16, refinedIndices, refinedWeights);
+        if (refinedError < error) {
+            error = refinedError;
+            e0 = r0;
+            e1 = r1;
+            std::memcpy(indices, refinedIndices, sizeof(indices));
+        }
+    }
+
+    bool swap = false;
+    FixBc7Anchor(indices, 16, swap);
+    if (swap) {
+        std::swap(e0, e1);
+    }
+
+    BitWriter writer(out);
+    writer.Write(1u << 6, 7);
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(static_cast<uint32_t>(e0.q[c]), 7);
+        writer.Write(static_cast<uint32_t>(e1.q[c]), 7);
+    }
+    writer.Write(static_cast<uint32_t>(e0.p), 1);
+    writer.Write(static_cast<uint32_t>(e1.p), 1);
+    writer.Write(indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(indices[i], 4);
+    }
+    return error;
+}
+
+int ExpandBc7Color7(int q) {
+    return (q << 1) | (q >> 6);
+}
+
+float EncodeBc7Mode5(const float (&points)[16][4], uint8_t* out) {
+    float rgb[16][3];
+    float alpha[16][1];
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            rgb[i][c] = points[i][c];
+        }
+        alpha[i][0] = points[i][3];
+    }
+
+    // Colour line: 7-bit endpoints, 2-bit indices.
+    const auto quantize = [](const float (&color)[3], int (&q)[3], int (&v)[3]) {
+        for (int c = 0; c < 3; ++c) {
+            q[c] = (std::min)((std::max)(static_cast<int>(color[c] * 127.0f / 255.0f + 0.5f), 0), 127);
+            v[c] = ExpandBc7Color7(q[c]);
+        }
+    };
+    float low[3];
+    float high[3];
+    PrincipalAxisEndpoints(rgb, low, high);
+    int q0[3];
+    int q1[3];
+    int v0[3];
+    int v1[3];
+    quantize(low, q0, v0);
+    quantize(high, q1, v1);
+    uint8_t colorIndices[16];
+    float weights[16];
+    float colorError = Bc7Assign(rgb, v0, v1, kBc7Weights2, 4, colorIndices, weights);
+    float a[3];
+    float b[3];
+    if (colorError > 0.0f && LeastSquaresEndpoints(rgb, weights, a, b)) {
+        int r0[3];
+        int r1[3];
+        int rv0[3];
+        int rv1[3];
+        quantize(a, r0, rv0);
+        quantize(b, r1, rv1);
+        uint8_t refinedIndices[16];
+        float refinedWeights[16];
+        const float refinedError = Bc7Assign(rgb, rv0, rv1, kBc7Weights2, 4, refinedIndices, refinedWeights);
+        if (refinedError < colorError) {
+            colorError = refinedError;
+            std::memcpy(q0, r0, sizeof(q0));
+            std::memcpy(q1, r1, sizeof(q1));
+            std::memcpy(colorIndices, refinedIndices, sizeof(colorIndices));
+        }
+    }
+
+    // Alpha line: 8-bit endpoints spanning the block's range.
+    int a0[1] = { 255 };
+    int a1[1] = { 0 };
+    for (const auto& p : alpha) {
+        a0[0] = (std::min)(a0[0], static_cast<int>(p[0]));
+        a1[0] = (std::max)(a1[0], static_cast<int>(p[0]));
+    }
+    uint8_t alphaIndices[16];
+    const float alphaError = Bc7Assign(alpha, a0, a1, kBc7Weights2, 4, alphaIndices, weights);
+
+    bool swap = false;
+    FixBc7Anchor(colorIndices, 4, swap);
+    if (swap) {
+        std::swap(q0, q1);
+    }
+    FixBc7Anchor(alphaIndices, 4, swap);
+    if (swap) {
+        std::swap(a0, a1);
+    }
+
+    BitWriter writer(out);
+    writer.Write(1u << 5, 6);
+    writer.Write(0, 2); // No channel rotation
+    for (int c = 0; c < 3; ++c) {
+        writer.Write(static_cast<uint32_t>(q0[c]), 7);
+        writer.Write(static_cast<uint32_t>(q1[c]), 7);
+    }
+    writer.Write(static_cast<uint32_t>(a0[0]), 8);
+    writer.Write(static_cast<uint32_t>(a1[0]), 8);
+    for (const uint8_t* indices : { colorIndices, alphaIndices }) {
+        writer.Write(indices[0], 1);
+        for (int i = 1; i < 16; ++i) {
+            writer.Write(indices[i], 2);
+        }
+    }
+    return colorError + alphaError;
+}
+
+void EncodeBc7Block(const BlockTexels& texels, uint8_t* out) {
+    float points[16][4];
+    bool opaque = true;
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            points[i][c] = texels[i][c];
+        }
+        opaque = opaque && texels[i][3] == 255;
+    }
+    const float mode6Error = EncodeBc7Mode6(points, out);
+    if (opaque || mode6Error == 0.0f) {
+        return;
+    }
+    uint8_t mode5[16];
+    if (EncodeBc7Mode5(points, mode5) < mode6Error) {
+        std::memcpy(out, mode5, sizeof(mode5));
+    }
+}
+
+bool DecodeBc7Block(const uint8_t* in, BlockTexels& texels) {
+    BitReader reader(in);
+    const uint32_t mode5 = reader.Read(6);
+    if (mode5 == (1u << 5)) {
+        const uint32_t rotation = reader.Read(2);
+        int e0[4];
+        int e1[4];
+        for (int c = 0; c < 3; ++c) {
+            e0[c] = ExpandBc7Color7(static_cast<int>(reader.Read(7)));
+            e1[c] = ExpandBc7Color7(static_cast<int>(reader.Read(7)));
+        }
+        e0[3] = static_cast<int>(reader.Read(8));
+        e1[3] = static_cast<int>(reader.Read(8));
+        uint32_t colorIndices[16];
+        for (int i = 0; i < 16; ++i) {
+            colorIndices[i] = reader.Read(i == 0 ? 1 : 2);
+        }
+        for (int i = 0; i < 16; ++i) {
+            const uint32_t alphaIndex = reader.Read(i == 0 ? 1 : 2);
+            for (int c = 0; c < 4; ++c) {
+                const uint32_t index = c == 3 ? alphaIndex : colorIndices[i];
+                texels[i][c] = static_cast<uint8_t>(Bc7Interpolate(e0[c], e1[c], kBc7Weights2[index]));
+            }
+            if (rotation != 0) {
+                std::swap(texels[i][3], texels[i][rotation - 1]);
+            }
+        }
+        return true;
+    }
+    if (mode5 != 0 || reader.Read(1) != 1u) {
+        return false;
+    }
+    Bc7Endpoint e0;
+    Bc7Endpoint e1;
+    for (int c = 0; c < 4; ++c) {
+        e0.q[c] = static_cast<int>(reader.Read(7));
+        e1.q[c] = static_cast<int>(reader.Read(7));
+    }
+    e0.p = static_cast<int>(reader.Read(1));
+    e1.p = static_cast<int>(reader.Read(1));
+    for (int i = 0; i < 16; ++i) {
+        const uint32_t index = reader.Read(i == 0 ? 3 : 4);
+        for (int c = 0; c < 4; ++c) {
+            texels[i][c] = static_cast<uint8_t>(Bc7Interpolate(e0.Value(c), e1.Value(c), kBc7Weights4[index]));
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------
+
+uint32_t RowBytes(BakedTextureFormat format, uint32_t width) {
+    return IsBlockCompressed(format) ? ((width + 3u) / 4u) * GetBakedTextureBlockBytes(format) : width * 4u;
+}
+
+uint32_t RowCount(BakedTextureFormat format, uint32_t height) {
+    return IsBlockCompressed(format) ? (height + 3u) / 4u : height;
+}
+
+void EncodeLevel(const Level& level, BakedTextureFormat format, const SlTexSubresource& layout, uint8_t* out, unsigned workers) {
+    const size_t slicePitch = static_cast<size_t>(layout.rowPitch) * layout.rowCount;
+    if (!IsBlockCompressed(format)) {
+        const size_t rowBytes = static_cast<size_t>(level.width) * 4u;
+        for (uint32_t z = 0; z < level.depth; ++z) {
+            for (uint32_t y = 0; y < level.height; ++y) {
+                std::memcpy(out + z * slicePitch + static_cast<size_t>(y) * layout.rowPitch,
+                            level.rgba.data() + (static_cast<size_t>(z) * level.height + y) * rowBytes, rowBytes);
+            }
+        }
+        return;
+    }
+
+    const uint32_t blockBytes = GetBakedTextureBlockBytes(format);
+    const uint32_t blocksWide = (level.width + 3u) / 4u;
+    ParallelFor(static_cast<size_t>(layout.rowCount) * level.depth, workers, [&](size_t begin, size_t end) {
+        BlockTexels texels;
+        for (size_t row = begin; row < end; ++row) {
+            const uint32_t by = static_cast<uint32_t>(row % layout.rowCount);
+            const uint32_t z = static_cast<uint32_t>(row / layout.rowCount);
+            uint8_t* dst = out + z * slicePitch + static_cast<size_t>(by) * layout.rowPitch;
+            for (uint32_t bx = 0; bx < blocksWide; ++bx, dst += blockBytes) {
+                // Levels smaller than a block repeat their edge texels.
+                for (uint32_t i = 0; i < 16; ++i) {
+                    const uint32_t x = (std::min)(bx * 4u + (i & 3u), level.width - 1u);
+                    const uint32_t y = (std::min)(by * 4u + (i >> 2), level.height - 1u);
+                    std::memcpy(texels[i].data(),
+                                level.rgba.data() + ((static_cast<size_t>(z) * level.height + y) * level.width + x) * 4u, 4);
+                }
+                switch (format) {
+                case BakedTextureFormat::BC1: EncodeBc1Block(texels, dst); break;
+                case BakedTextureFormat::BC4: EncodeBc4Block(texels, dst); break;
+                case BakedTextureFormat::BC7: EncodeBc7Block(texels, dst); break;
+                default: break;
+                }
+            }
+        }
+    });
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+uint32_t GetBakedTextureBlockBytes(BakedTextureFormat format) {
+    switch (format) {
+    case BakedTextureFormat::BC1:
+    case BakedTextureFormat::BC4:
+        return 8;
+    case BakedTextureFormat::BC7:
+        return 16;
+    default:
+        return 4;
+    }
+}
+
+bool IsBlockCompressed(BakedTextureFormat format) {
+    return format != BakedTextureFormat::RGBA8;
+}
+
+const char* GetBakedTextureFormatName(BakedTextureFormat format) {
+    switch (format) {
+    case BakedTextureFormat::BC1: return "bc1";
+    case BakedTextureFormat::BC4: return "bc4";
+    case BakedTextureFormat::BC7: return "bc7";
+    default: return "rgba8";
+    }
+}
+
+bool ParseBakedTextureFormat(const std::string& name, BakedTextureFormat& outFormat) {
+    for (BakedTextureFormat format : { BakedTextureFormat::RGBA8, BakedTextureFormat::BC1,
+                                       BakedTextureFormat::BC4, BakedTextureFormat::BC7 }) {
+        if (name == GetBakedTextureFormatName(format)) {
+            outFormat = format;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SlTexView::Parse(const uint8_t* data, size_t size, SlTexView& outView, std::string& outError) {
+    if (!data || size < sizeof(SlTexHeader)) {
+        outError = "Texture container is truncated.";
+        return false;
+    }
+    SlTexHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kSlTexMagic || header.version != kSlTexVersion) {
+        outError = "Not a supported .sltex container.";
+        return false;
+    }
+    if (header.dimension > static_cast<uint32_t>(BakedTextureDimension::Texture3D) ||
+        header.format > static_cast<uint32_t>(BakedTextureFormat::BC7) ||
+        header.width == 0 || header.height == 0 || header.depth == 0 || header.arraySize == 0 ||
+        header.mipLevels == 0 || header.mipLevels > 16 ||
+        header.subresourceCount != header.arraySize * header.mipLevels) {
+        outError = "Texture container header is invalid.";
+        return false;
+    }
+    const uint64_t tableEnd = sizeof(SlTexHeader) + static_cast<uint64_t>(header.subresourceCount) * sizeof(SlTexSubresource);
+    if (tableEnd > size || header.payloadOffset < tableEnd || header.payloadOffset > size ||
+        header.payloadSize > size - header.payloadOffset) {
+        outError = "Texture container is truncated.";
+        return false;
+    }
+
+    const BakedTextureFormat format = static_cast<BakedTextureFormat>(header.format);
+    std::vector<SlTexSubresource> subresources(header.subresourceCount);
+    std::memcpy(subresources.data(), data + sizeof(SlTexHeader), subresources.size() * sizeof(SlTexSubresource));
+    for (uint32_t i = 0; i < header.subresourceCount; ++i) {
+        const SlTexSubresource& sub = subresources[i];
+        const uint32_t mip = i % header.mipLevels;
+        const uint32_t expectedDepth = header.dimension == static_cast<uint32_t>(BakedTextureDimension::Texture3D)
+            ? (std::max)(header.depth >> mip, 1u) : 1u;
+        const uint64_t bytes = static_cast<uint64_t>(sub.rowPitch) * sub.rowCount * sub.depth;
+        if (sub.width != (std::max)(header.width >> mip, 1u) || sub.height != (std::max)(header.height >> mip, 1u) ||
+            sub.depth != expectedDepth || sub.rowCount != RowCount(format, sub.height) ||
+            sub.rowPitch < RowBytes(format, sub.width) || sub.rowPitch % kSlTexRowPitchAlignment != 0 ||
+            sub.offset % kSlTexPlacementAlignment != 0 || sub.offset > header.payloadSize ||
+            bytes > header.payloadSize - sub.offset) {
+            outError = "Texture container subresource table is invalid.";
+            return false;
+        }
+    }
+
+    outView.header = header;
+    outView.subresources = std::move(subresources);
+    outView.payload = data + header.payloadOffset;
+    return true;
+}
+
+bool BakeTexture(const DecodedImage& source,
+                 BakedTextureDimension dimension,
+                 const TextureBakeOptions& options,
+                 std::vector<uint8_t>& outFile,
+                 std::string& outError,
+                 TextureBakeStats* outStats) {
+    if (source.width == 0 || source.height == 0 ||
+        source.rgba.size() != static_cast<size_t>(source.width) * source.height * 4u) {
+        outError = "Texture source is empty.";
+        return false;
+    }
+
+    const unsigned workers = ResolveWorkerCount(options.workerCount);
+    BakedTextureFormat format = options.format;
+    const bool srgb = options.srgb && format != BakedTextureFormat::BC4;
+    TextureBakeStats stats;
+    stats.sourceBytes = source.rgba.size();
+
+    // Split the source into faces (cube) or slices (volume).
+    std::vector<FloatImage> slices;
+    uint32_t depth = 1;
+    if (dimension == BakedTextureDimension::TextureCube) {
+        const bool strip = source.width == source.height * 6u;
+        const bool column = source.height == source.width * 6u;
+        if (!strip && !column) {
+            outError = "Cube textures need six square faces in a 6:1 strip or 1:6 column.";
+            return false;
+        }
+        const uint32_t face = strip ? source.height : source.width;
+        for (uint32_t i = 0; i < 6; ++i) {
+            slices.push_back(ExtractTiles(source, face, face, 1, strip, i, srgb));
+        }
+    } else if (dimension == BakedTextureDimension::Texture3D) {
+        const bool vertical = source.height >= source.width && source.height % source.width == 0;
+        const bool horizontal = !vertical && source.width % source.height == 0;
+        if (!vertical && !horizontal) {
+            outError = "Volume textures need square slices stacked vertically or side by side.";
+            return false;
+        }
+        const uint32_t edge = vertical ? source.width : source.height;
+        depth = vertical ? source.height / edge : source.width / edge;
+        slices.push_back(ExtractTiles(source, edge, edge, depth, horizontal, 0, srgb));
+    } else {
+        slices.push_back(ExtractTiles(source, source.width, source.height, 1, true, 0, srgb));
+    }
+
+    const uint32_t width = slices.front().width;
+    const uint32_t height = slices.front().height;
+    if (IsBlockCompressed(format) && (width % 4u != 0 || height % 4u != 0)) {
+        format = BakedTextureFormat::RGBA8;
+        stats.formatFallback = true;
+    }
+    uint32_t mipLevels = 1;
+    if (options.generateMips) {
+        for (uint32_t extent = (std::max)((std::max)(width, height), depth); extent > 1; extent >>= 1) {
+            ++mipLevels;
+        }
+    }
+
+    // Levels in subresource order: mip + slice * mipLevels.
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Level> levels;
+    levels.reserve(slices.size() * mipLevels);
+    for (FloatImage& slice : slices) {
+        FloatImage current = std::move(slice);
+        for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+            if (mip > 0) {
+                current = Downsample(current, options.mipFilter, workers);
+            }
+            levels.push_back(ToLevel(current, srgb, workers));
+        }
+    }
+    stats.mipMs = MillisecondsSince(start);
+
+    SlTexHeader header;
+    header.dimension = static_cast<uint32_t>(dimension);
+    header.format = static_cast<uint32_t>(format);
+    header.flags = srgb ? kSlTexFlagSrgb : 0u;
+    header.width = width;
+    header.height = height;
+    header.depth = depth;
+    header.arraySize = static_cast<uint32_t>(slices.size());
+    header.mipLevels = mipLevels;
+    header.subresourceCount = static_cast<uint32_t>(levels.size());
+
+    std::vector<SlTexSubresource> table(levels.size());
+    uint64_t payloadSize = 0;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        SlTexSubresource& sub = table[i];
+        sub.offset = AlignUp(payloadSize, kSlTexPlacementAlignment);
+        sub.width = levels[i].width;
+        sub.height = levels[i].height;
+        sub.depth = levels[i].depth;
+        sub.rowPitch = static_cast<uint32_t>(AlignUp(RowBytes(format, sub.width), kSlTexRowPitchAlignment));
+        sub.rowCount = RowCount(format, sub.height);
+        payloadSize = sub.offset + static_cast<uint64_t>(sub.rowPitch) * sub.rowCount * sub.depth;
+    }
+    header.payloadOffset = AlignUp(sizeof(SlTexHeader) + table.size() * sizeof(SlTexSubresource), kSlTexPlacementAlignment);
+    header.payloadSize = payloadSize;
+
+    outFile.assign(static_cast<size_t>(header.payloadOffset + payloadSize), 0);
+    std::memcpy(outFile.data(), &header, sizeof(header));
+    std::memcpy(outFile.data() + sizeof(header), table.data(), table.size() * sizeof(SlTexSubresource));
+
+    start = std::chrono::steady_clock::now();
+    uint8_t* payload = outFile.data() + header.payloadOffset;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        EncodeLevel(levels[i], format, table[i], payload + table[i].offset, workers);
+    }
+    stats.encodeMs = MillisecondsSince(start);
+    stats.payloadBytes = payloadSize;
+    stats.mipLevels = mipLevels;
+    if (outStats) {
+        *outStats = stats;
+    }
+    return true;
+}
+
+bool DecodeSlTexSubresource(const SlTexView& view, uint32_t index, std::vector<uint8_t>& outRgba, std::string& outError) {
+    if (index >= view.subresources.size()) {
+        outError = "Subresource index out of range.";
+        return false;
+    }
+    const SlTexSubresource& sub = view.subresources[index];
+    const BakedTextureFormat format = view.GetFormat();
+    const uint8_t* data = view.GetSubresourceData(index);
+    const size_t slicePitch = static_cast<size_t>(sub.rowPitch) * sub.rowCount;
+    outRgba.resize(static_cast<size_t>(sub.width) * sub.height * sub.depth * 4u);
+
+    if (!IsBlockCompressed(format)) {
+        const size_t rowBytes = static_cast<size_t>(sub.width) * 4u;
+        for (uint32_t z = 0; z < sub.depth; ++z) {
+            for (uint32_t y = 0; y < sub.height; ++y) {
+                std::memcpy(outRgba.data() + (static_cast<size_t>(z) * sub.height + y) * rowBytes,
+                            data + z * slicePitch + static_cast<size_t>(y) * sub.rowPitch, rowBytes);
+            }
+        }
+        return true;
+    }
+
+    const uint32_t blockBytes = GetBakedTextureBlockBytes(format);
+    BlockTexels texels;
+    for (uint32_t z = 0; z < sub.depth; ++z) {
+        for (uint32_t by = 0; by < sub.rowCount; ++by) {
+            const uint8_t* block = data + z * slicePitch + static_cast<size_t>(by) * sub.rowPitch;
+            for (uint32_t bx = 0; bx * 4u < sub.width; ++bx, block += blockBytes) {
+                if (format == BakedTextureFormat::BC1) {
+                    DecodeBc1Block(block, texels);
+                } else if (format == BakedTextureFormat::BC4) {
+                    DecodeBc4Block(block, texels);
+                } else if (!DecodeBc7Block(block, texels)) {
+                    outError = "Only BC7 modes 5 and 6 are supported.";
+                    return false;
+                }
+                for (uint32_t i = 0; i < 16; ++i) {
+                    const uint32_t x = bx * 4u + (i & 3u);
+                    const uint32_t y = by * 4u + (i >> 2);
+                    if (x < sub.width && y < sub.height) {
+                        std::memcpy(outRgba.data() + ((static_cast<size_t>(z) * sub.height + y) * sub.width + x) * 4u,
+                                    texels[i].data(), 4);
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace ShaderLab
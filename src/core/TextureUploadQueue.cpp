@@ -0,0 +1,340 @@
+#include "ShaderLab/Core/TextureUploadQueue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace ShaderLab {
+
+TextureUploadQueue::TextureUploadQueue(ITextureUploadBackend* backend, ImageDecodeFunction decoder, unsigned workerCount)
+    : m_backend(backend), m_decoder(std::move(decoder)) {
+    if (m_backend) {
+        m_ring.Reset(m_backend->GetStagingCapacity());
+    }
+    m_workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back([this]() { WorkerMain(); });
+    }
+}
+
+TextureUploadQueue::~TextureUploadQueue() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_decodeQueue.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+unsigned TextureUploadQueue::DefaultWorkerCount() {
+    // Decoding is pure CPU work, but the render thread and the shader compilers need cores too.
+    const unsigned hardwareThreads = std::thread::hardware_concurrency();
+    return (std::min)((std::max)(hardwareThreads, 2u) / 2u, 4u);
+}
+
+uint64_t TextureUploadQueue::RequestFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    DecodeJob job;
+    job.ticket = ++m_nextTicket;
+    job.path = path;
+    m_decodeQueue.push_back(std::move(job));
+    ++m_stats.requested;
+    m_wake.notify_one();
+    return m_nextTicket;
+}
+
+uint64_t TextureUploadQueue::RequestImage(DecodedImage image, const std::string& label) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Decoded decoded;
+    decoded.ticket = ++m_nextTicket;
+    decoded.path = label;
+    decoded.success = image.width > 0 && image.height > 0 &&
+                      image.rgba.size() >= static_cast<size_t>(image.width) * image.height * 4u;
+    if (!decoded.success) {
+        decoded.error = "Invalid image data.";
+    }
+    decoded.image = std::move(image);
+    m_decoded.push_back(std::move(decoded));
+    ++m_stats.requested;
+    return m_nextTicket;
+}
+
+void TextureUploadQueue::Cancel(uint64_t ticket) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (ticket == 0 || ticket > m_nextTicket) {
+        return;
+    }
+    const size_t before = m_decodeQueue.size();
+    m_decodeQueue.erase(std::remove_if(m_decodeQueue.begin(), m_decodeQueue.end(),
+                                       [ticket](const DecodeJob& job) { return job.ticket == ticket; }),
+                        m_decodeQueue.end());
+    if (m_decodeQueue.size() != before) {
+        ++m_stats.canceled;
+        return;
+    }
+    // Decoding, staged or in flight: dropped when it surfaces.
+    m_canceled.insert(ticket);
+}
+
+void TextureUploadQueue::CancelAll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.canceled += m_decodeQueue.size() + m_decoded.size();
+    m_decodeQueue.clear();
+    m_decoded.clear();
+    // Covers whatever is decoding or in flight right now.
+    m_canceledThrough = m_nextTicket;
+}
+
+size_t TextureUploadQueue::Update(std::vector<TextureUploadResult>& outResults) {
+    if (!m_backend) {
+        return 0;
+    }
+    if (m_workers.empty()) {
+        for (;;) {
+            DecodeJob job;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_decodeQueue.empty()) {
+                    break;
+                }
+                job = std::move(m_decodeQueue.front());
+                m_decodeQueue.pop_front();
+                ++m_decoding;
+            }
+            Decoded decoded;
+            DecodeOne(job, decoded);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_decoding;
+            m_decoded.push_back(std::move(decoded));
+        }
+    }
+
+    size_t added = 0;
+    Retire(outResults, added);
+    StageDecoded(outResults, added);
+    return added;
+}
+
+void TextureUploadQueue::Flush(const std::function<void(uint64_t batchIndex)>& waitForBatch,
+                               std::vector<TextureUploadResult>& outResults) {
+    for (;;) {
+        Update(outResults);
+        if (!m_inFlight.empty()) {
+            if (waitForBatch) {
+                waitForBatch(m_inFlight.back().batchIndex);
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_decodeQueue.empty() && m_decoding == 0 && m_decoded.empty()) {
+            return;
+        }
+        if (!m_workers.empty()) {
+            m_decodedSignal.wait(lock, [this]() {
+                return !m_decoded.empty() || (m_decodeQueue.empty() && m_decoding == 0);
+            });
+        }
+    }
+}
+
+size_t TextureUploadQueue::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_decodeQueue.size() + m_decoding + m_decoded.size() + m_inFlight.size();
+}
+
+TextureUploadStats TextureUploadQueue::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void TextureUploadQueue::WorkerMain() {
+    for (;;) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stop || !m_decodeQueue.empty(); });
+            if (m_stop) {
+                return;
+            }
+            job = std::move(m_decodeQueue.front());
+            m_decodeQueue.pop_front();
+            ++m_decoding;
+        }
+        Decoded decoded;
+        DecodeOne(job, decoded);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_decoding;
+            m_decoded.push_back(std::move(decoded));
+        }
+        m_decodedSignal.notify_all();
+    }
+}
+
+void TextureUploadQueue::DecodeOne(DecodeJob& job, Decoded& out) {
+    const auto start = std::chrono::steady_clock::now();
+    out.ticket = job.ticket;
+    out.path = std::move(job.path);
+    if (!m_decoder) {
+        out.error = "No image decoder.";
+    } else if (m_decoder(out.path, out.image, out.error)) {
+        out.success = out.image.width > 0 && out.image.height > 0 &&
+                      out.image.rgba.size() >= static_cast<size_t>(out.image.width) * out.image.height * 4u;
+        if (!out.success) {
+            out.error = "Decoder returned an empty image.";
+        }
+    } else if (out.error.empty()) {
+        out.error = "Failed to decode " + out.path;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.decodeMs += ms;
+    m_stats.decoded += out.success ? 1u : 0u;
+}
+
+bool TextureUploadQueue::IsCanceled(uint64_t ticket) const {
+    return ticket <= m_canceledThrough || m_canceled.find(ticket) != m_canceled.end();
+}
+
+void TextureUploadQueue::Retire(std::vector<TextureUploadResult>& outResults, size_t& added) {
+    const int64_t completed = m_backend->GetCompletedBatch();
+    while (!m_inFlight.empty() && completed >= 0 &&
+           m_inFlight.front().batchIndex <= static_cast<uint64_t>(completed)) {
+        InFlight entry = std::move(m_inFlight.front());
+        m_inFlight.pop_front();
+        bool canceled = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            canceled = IsCanceled(entry.result.ticket);
+            m_canceled.erase(entry.result.ticket);
+            m_stats.canceled += canceled ? 1u : 0u;
+            m_stats.uploaded += canceled ? 0u : 1u;
+        }
+        if (canceled) {
+            m_backend->ReleaseTexture(entry.result.ticket);
+            continue;
+        }
+        outResults.push_back(std::move(entry.result));
+        ++added;
+    }
+    m_ring.BeginFrame(m_nextBatch, completed);
+    if (m_ring.GetUsed() == 0) {
+        // Nothing in flight: start from offset 0 so a large image does not trip over the wrap.
+        m_ring.Clear();
+    }
+}
+
+void TextureUploadQueue::StageDecoded(std::vector<TextureUploadResult>& outResults, size_t& added) {
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t batchBytes = 0;
+    size_t recorded = 0;
+    bool stalled = false;
+    for (;;) {
+        Decoded decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_decoded.empty()) {
+                break;
+            }
+            decoded = std::move(m_decoded.front());
+            m_decoded.pop_front();
+            if (IsCanceled(decoded.ticket)) {
+                m_canceled.erase(decoded.ticket);
+                ++m_stats.canceled;
+                continue;
+            }
+        }
+
+        TextureUploadResult result;
+        result.ticket = decoded.ticket;
+        result.path = decoded.path;
+        result.width = decoded.image.width;
+        result.height = decoded.image.height;
+        if (!decoded.success) {
+            result.error = std::move(decoded.error);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.failed;
+            outResults.push_back(std::move(result));
+            ++added;
+            continue;
+        }
+
+        const TextureStagingFootprint footprint = m_backend->GetFootprint(decoded.image.width, decoded.image.height);
+        const uint64_t required = footprint.totalBytes + footprint.alignment;
+        bool deferred = batchBytes > 0 && batchBytes + footprint.totalBytes > m_batchByteBudget;
+        if (!deferred && required > m_ring.GetCapacity()) {
+            // Larger than the whole ring: grow it once nothing references the old buffer.
+            if (m_inFlight.empty() && recorded == 0) {
+                const uint64_t capacity = (std::max)(m_ring.GetCapacity() * 2, (required + uint64_t(0xFFFFF)) & ~uint64_t(0xFFFFF));
+                if (!m_backend->ResizeStaging(capacity)) {
+                    result.error = "Texture too large for the staging buffer.";
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    ++m_stats.failed;
+                    outResults.push_back(std::move(result));
+                    ++added;
+                    continue;
+                }
+                m_ring.Reset(m_backend->GetStagingCapacity());
+                m_ring.BeginFrame(m_nextBatch, m_backend->GetCompletedBatch());
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_stats.stagingResizes;
+            } else {
+                deferred = true;
+                stalled = true;
+            }
+        }
+        const uint64_t offset = deferred ? FrameRingBuffer::kInvalidOffset
+                                         : m_ring.Allocate(footprint.totalBytes, footprint.alignment);
+        if (offset == FrameRingBuffer::kInvalidOffset) {
+            // Keep the order: the image goes back to the front and waits for a later batch.
+            stalled = stalled || !deferred;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_decoded.push_front(std::move(decoded));
+            break;
+        }
+
+        uint8_t* staging = m_backend->GetStagingMemory() + offset;
+        const size_t rowBytes = static_cast<size_t>(decoded.image.width) * 4u;
+        for (uint32_t y = 0; y < decoded.image.height; ++y) {
+            std::memcpy(staging + static_cast<size_t>(y) * footprint.rowPitch,
+                        decoded.image.rgba.data() + static_cast<size_t>(y) * rowBytes, rowBytes);
+        }
+
+        if (!m_backend->RecordUpload(decoded.ticket, decoded.image.width, decoded.image.height, offset, footprint,
+                                     result.error)) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.failed;
+            outResults.push_back(std::move(result));
+            ++added;
+            continue;
+        }
+        result.success = true;
+        batchBytes += footprint.totalBytes;
+        ++recorded;
+        InFlight entry;
+        entry.batchIndex = m_nextBatch;
+        entry.result = std::move(result);
+        m_inFlight.push_back(std::move(entry));
+    }
+
+    if (recorded > 0) {
+        m_backend->SubmitBatch(m_nextBatch);
+        ++m_nextBatch;
+    }
+    m_ring.EndFrame();
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.batches += recorded > 0 ? 1u : 0u;
+    m_stats.bytesStaged += batchBytes;
+    m_stats.stagingStalls += stalled ? 1u : 0u;
+    m_stats.stageMs += ms;
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,326 @@
+#include "ShaderLab/Core/ThumbnailCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr uint32_t kMaxCellSize = 1024;
+constexpr uint32_t kMaxGrid = 64;
+
+uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+uint64_t MakeThumbnailKey(uint64_t sourceHash, uint32_t width, uint32_t height, float timeSeconds) {
+    uint64_t hash = HashBytes(1469598103934665603ull, &sourceHash, sizeof(sourceHash));
+    hash = HashBytes(hash, &width, sizeof(width));
+    hash = HashBytes(hash, &height, sizeof(height));
+    return HashBytes(hash, &timeSeconds, sizeof(timeSeconds));
+}
+
+ThumbnailCache::ThumbnailCache(const ThumbnailAtlasDesc& desc)
+    : m_desc(desc) {
+    m_desc.cellWidth = (std::max)(1u, (std::min)(m_desc.cellWidth, kMaxCellSize));
+    m_desc.cellHeight = (std::max)(1u, (std::min)(m_desc.cellHeight, kMaxCellSize));
+    m_desc.columns = (std::max)(1u, (std::min)(m_desc.columns, kMaxGrid));
+    m_desc.rows = (std::max)(1u, (std::min)(m_desc.rows, kMaxGrid));
+    m_desc.maxPages = (std::max)(1u, m_desc.maxPages);
+}
+
+ThumbnailSlot ThumbnailCache::SlotOf(const Entry& entry) const {
+    ThumbnailSlot slot;
+    slot.page = entry.page;
+    slot.x = (entry.cell % m_desc.columns) * m_desc.cellWidth;
+    slot.y = (entry.cell / m_desc.columns) * m_desc.cellHeight;
+    slot.revision = entry.revision;
+    return slot;
+}
+
+bool ThumbnailCache::Find(uint64_t key, ThumbnailSlot& outSlot) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_stats.misses;
+        return false;
+    }
+    ++m_stats.hits;
+    it->second.lastUse = ++m_useClock;
+    outSlot = SlotOf(it->second);
+    return true;
+}
+
+bool ThumbnailCache::AcquireCell(uint32_t& outPage, uint32_t& outCell) {
+    const uint32_t cellsPerPage = CellsPerPage();
+    for (uint32_t p = 0; p < m_pages.size(); ++p) {
+        Page& page = m_pages[p];
+        if (page.usedCells == cellsPerPage) {
+            continue;
+        }
+        const auto free = std::find(page.cellUsed.begin(), page.cellUsed.end(), false);
+        outPage = p;
+        outCell = static_cast<uint32_t>(free - page.cellUsed.begin());
+        return true;
+    }
+    if (m_pages.size() < m_desc.maxPages) {
+        Page page;
+        page.pixels.assign(static_cast<size_t>(GetPageWidth()) * GetPageHeight() * 4u, 0);
+        page.cellUsed.assign(cellsPerPage, false);
+        m_pages.push_back(std::move(page));
+        outPage = static_cast<uint32_t>(m_pages.size() - 1);
+        outCell = 0;
+        return true;
+    }
+
+    // Full: a linear scan is fine at a few hundred cells and only runs on a miss.
+    auto oldest = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (oldest == m_entries.end() || it->second.lastUse < oldest->second.lastUse) {
+            oldest = it;
+        }
+    }
+    if (oldest == m_entries.end()) {
+        return false;
+    }
+    outPage = oldest->second.page;
+    outCell = oldest->second.cell;
+    Page& page = m_pages[outPage];
+    page.cellUsed[outCell] = false;
+    --page.usedCells;
+    m_entries.erase(oldest);
+    ++m_stats.evictions;
+    return true;
+}
+
+void ThumbnailCache::WriteCell(uint32_t page, uint32_t cell, const uint8_t* rgba, uint32_t rowPitch) {
+    const size_t pagePitch = static_cast<size_t>(GetPageWidth()) * 4u;
+    const size_t rowBytes = static_cast<size_t>(m_desc.cellWidth) * 4u;
+    const uint32_t x = (cell % m_desc.columns) * m_desc.cellWidth;
+    const uint32_t y = (cell / m_desc.columns) * m_desc.cellHeight;
+    uint8_t* dst = m_pages[page].pixels.data() + y * pagePitch + static_cast<size_t>(x) * 4u;
+    for (uint32_t row = 0; row < m_desc.cellHeight; ++row) {
+        std::memcpy(dst + row * pagePitch, rgba + static_cast<size_t>(row) * rowPitch, rowBytes);
+    }
+}
+
+bool ThumbnailCache::Insert(uint64_t key, const uint8_t* rgba, uint32_t rowPitch, ThumbnailSlot& outSlot) {
+    if (!rgba || rowPitch < m_desc.cellWidth * 4u) {
+        return false;
+    }
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        uint32_t page = 0;
+        uint32_t cell = 0;
+        if (!AcquireCell(page, cell)) {
+            return false;
+        }
+        Page& target = m_pages[page];
+        target.cellUsed[cell] = true;
+        ++target.usedCells;
+        Entry entry;
+        entry.page = page;
+        entry.cell = cell;
+        it = m_entries.emplace(key, entry).first;
+    }
+
+    Entry& entry = it->second;
+    WriteCell(entry.page, entry.cell, rgba, rowPitch);
+    entry.lastUse = ++m_useClock;
+    entry.revision = ++m_revision;
+    m_pages[entry.page].revision = entry.revision;
+    m_dirty = true;
+    ++m_stats.inserts;
+    outSlot = SlotOf(entry);
+    return true;
+}
+
+bool ThumbnailCache::Remove(uint64_t key) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return false;
+    }
+    Page& page = m_pages[it->second.page];
+    page.cellUsed[it->second.cell] = false;
+    --page.usedCells;
+    m_entries.erase(it);
+    m_dirty = true;
+    return true;
+}
+
+void ThumbnailCache::Clear() {
+    m_dirty = m_dirty || !m_entries.empty();
+    m_entries.clear();
+    m_pages.clear();
+}
+
+ThumbnailCacheStats ThumbnailCache::GetStats() const {
+    ThumbnailCacheStats stats = m_stats;
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+void ThumbnailCache::Serialize(std::vector<uint8_t>& outData) const {
+    std::vector<SlThumbEntry> table;
+    table.reserve(m_entries.size());
+    for (const auto& [key, entry] : m_entries) {
+        SlThumbEntry record;
+        record.key = key;
+        record.lastUse = entry.lastUse;
+        record.page = entry.page;
+        record.cell = entry.cell;
+        table.push_back(record);
+    }
+    std::sort(table.begin(), table.end(), [](const SlThumbEntry& a, const SlThumbEntry& b) {
+        return a.page != b.page ? a.page < b.page : a.cell < b.cell;
+    });
+
+    const size_t rowBytes = static_cast<size_t>(m_desc.cellWidth) * 4u;
+    const size_t cellBytes = rowBytes * m_desc.cellHeight;
+    const size_t tableBytes = table.size() * sizeof(SlThumbEntry);
+    outData.assign(sizeof(SlThumbHeader) + tableBytes + table.size() * cellBytes, 0);
+    uint8_t* payload = outData.data() + sizeof(SlThumbHeader);
+    if (tableBytes > 0) {
+        std::memcpy(payload, table.data(), tableBytes);
+    }
+
+    const size_t pagePitch = static_cast<size_t>(GetPageWidth()) * 4u;
+    uint8_t* cells = payload + tableBytes;
+    for (const SlThumbEntry& record : table) {
+        const uint32_t x = (record.cell % m_desc.columns) * m_desc.cellWidth;
+        const uint32_t y = (record.cell / m_desc.columns) * m_desc.cellHeight;
+        const uint8_t* src = m_pages[record.page].pixels.data() + y * pagePitch + static_cast<size_t>(x) * 4u;
+        for (uint32_t row = 0; row < m_desc.cellHeight; ++row) {
+            std::memcpy(cells + row * rowBytes, src + row * pagePitch, rowBytes);
+        }
+        cells += cellBytes;
+    }
+
+    SlThumbHeader header;
+    header.cellWidth = m_desc.cellWidth;
+    header.cellHeight = m_desc.cellHeight;
+    header.columns = m_desc.columns;
+    header.rows = m_desc.rows;
+    header.entryCount = static_cast<uint32_t>(table.size());
+    header.payloadHash = HashBytes(1469598103934665603ull, payload, outData.size() - sizeof(SlThumbHeader));
+    std::memcpy(outData.data(), &header, sizeof(header));
+}
+
+bool ThumbnailCache::Deserialize(const uint8_t* data, size_t size, std::string& outError) {
+    m_entries.clear();
+    m_pages.clear();
+    m_dirty = false;
+
+    if (!data || size < sizeof(SlThumbHeader)) {
+        outError = "Thumbnail cache is truncated.";
+        return false;
+    }
+    SlThumbHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kSlThumbMagic || header.version != kSlThumbVersion) {
+        outError = "Not a supported .slthumb cache.";
+        return false;
+    }
+    if (header.cellWidth != m_desc.cellWidth || header.cellHeight != m_desc.cellHeight ||
+        header.columns != m_desc.columns || header.rows != m_desc.rows) {
+        outError = "Thumbnail cache was written with another atlas layout.";
+        return false;
+    }
+    const uint32_t cellsPerPage = CellsPerPage();
+    if (header.entryCount > static_cast<uint64_t>(cellsPerPage) * m_desc.maxPages) {
+        outError = "Thumbnail cache holds more entries than the atlas.";
+        return false;
+    }
+    const size_t cellBytes = static_cast<size_t>(m_desc.cellWidth) * 4u * m_desc.cellHeight;
+    const size_t tableBytes = static_cast<size_t>(header.entryCount) * sizeof(SlThumbEntry);
+    if (size - sizeof(SlThumbHeader) != tableBytes + header.entryCount * cellBytes) {
+        outError = "Thumbnail cache is truncated.";
+        return false;
+    }
+    const uint8_t* payload = data + sizeof(SlThumbHeader);
+    if (HashBytes(1469598103934665603ull, payload, size - sizeof(SlThumbHeader)) != header.payloadHash) {
+        outError = "Thumbnail cache is corrupt.";
+        return false;
+    }
+
+    std::vector<SlThumbEntry> table(header.entryCount);
+    if (tableBytes > 0) {
+        std::memcpy(table.data(), payload, tableBytes);
+    }
+    uint32_t pageCount = 0;
+    for (const SlThumbEntry& record : table) {
+        if (record.page >= m_desc.maxPages || record.cell >= cellsPerPage) {
+            outError = "Thumbnail cache is corrupt.";
+            return false;
+        }
+        pageCount = (std::max)(pageCount, record.page + 1);
+    }
+
+    m_pages.resize(pageCount);
+    for (Page& page : m_pages) {
+        page.pixels.assign(static_cast<size_t>(GetPageWidth()) * GetPageHeight() * 4u, 0);
+        page.cellUsed.assign(cellsPerPage, false);
+        page.revision = ++m_revision;
+    }
+    const uint8_t* cells = payload + tableBytes;
+    for (const SlThumbEntry& record : table) {
+        Page& page = m_pages[record.page];
+        if (page.cellUsed[record.cell] || m_entries.count(record.key) != 0) {
+            m_entries.clear();
+            m_pages.clear();
+            outError = "Thumbnail cache is corrupt.";
+            return false;
+        }
+        page.cellUsed[record.cell] = true;
+        ++page.usedCells;
+        WriteCell(record.page, record.cell, cells, m_desc.cellWidth * 4u);
+        cells += cellBytes;
+
+        Entry entry;
+        entry.page = record.page;
+        entry.cell = record.cell;
+        entry.lastUse = record.lastUse;
+        entry.revision = page.revision;
+        m_entries.emplace(record.key, entry);
+        m_useClock = (std::max)(m_useClock, record.lastUse);
+    }
+    return true;
+}
+
+bool ThumbnailCache::Save(const std::string& path, std::string& outError) {
+    std::vector<uint8_t> data;
+    Serialize(data);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        outError = "Cannot write thumbnail cache: " + path;
+        return false;
+    }
+    m_dirty = false;
+    return true;
+}
+
+bool ThumbnailCache::Load(const std::string& path, std::string& outError) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        outError = "Cannot read thumbnail cache: " + path;
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    const std::streamoff size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    std::vector<uint8_t> data(size > 0 ? static_cast<size_t>(size) : 0);
+    if (size < 0 || (!data.empty() && !file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))) {
+        outError = "Cannot read thumbnail cache: " + path;
+        return false;
+    }
+    return Deserialize(data.data(), data.size(), outError);
+}
+
+} // namespace ShaderLab
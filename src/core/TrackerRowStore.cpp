@@ -0,0 +1,233 @@
+#include "ShaderLab/Core/TrackerRowStore.h"
+#include "ShaderLab/Core/TrackData.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr size_t kSlabRows = 256;
+
+} // namespace
+
+TrackerRowStore::TrackerRowStore() = default;
+TrackerRowStore::~TrackerRowStore() = default;
+TrackerRowStore::TrackerRowStore(TrackerRowStore&& other) noexcept = default;
+TrackerRowStore& TrackerRowStore::operator=(TrackerRowStore&& other) noexcept = default;
+
+TrackerRowStore::TrackerRowStore(const TrackerRowStore& other) {
+    reserve(other.size());
+    m_index.reserve(other.m_index.size());
+    for (const Entry& entry : other.m_index) {
+        m_index.push_back({ entry.beat, Allocate(*entry.row) });
+    }
+}
+
+TrackerRowStore& TrackerRowStore::operator=(const TrackerRowStore& other) {
+    if (this != &other) {
+        TrackerRowStore copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+void TrackerRowStore::clear() {
+    m_slabs.clear();
+    m_slabUsed = 0;
+    m_free.clear();
+    m_index.clear();
+}
+
+void TrackerRowStore::reserve(size_t count) {
+    m_index.reserve(count);
+    size_t capacity = m_free.size() + (m_slabs.empty() ? 0 : kSlabRows - m_slabUsed);
+    while (capacity < count) {
+        // Reserved slabs go in front of the newest one so m_slabUsed keeps describing it.
+        m_slabs.insert(m_slabs.begin(), std::make_unique<TrackerRow[]>(kSlabRows));
+        for (size_t i = 0; i < kSlabRows; ++i) {
+            m_free.push_back(&m_slabs.front()[kSlabRows - 1 - i]);
+        }
+        if (m_slabs.size() == 1) {
+            m_slabUsed = kSlabRows;
+        }
+        capacity += kSlabRows;
+    }
+}
+
+TrackerRow* TrackerRowStore::Allocate(const TrackerRow& row) {
+    TrackerRow* slot = nullptr;
+    if (!m_free.empty()) {
+        slot = m_free.back();
+        m_free.pop_back();
+    } else {
+        if (m_slabs.empty() || m_slabUsed == kSlabRows) {
+            m_slabs.push_back(std::make_unique<TrackerRow[]>(kSlabRows));
+            m_slabUsed = 0;
+        }
+        slot = &m_slabs.back()[m_slabUsed++];
+    }
+    *slot = row;
+    return slot;
+}
+
+void TrackerRowStore::Release(TrackerRow* row) {
+    *row = TrackerRow();
+    m_free.push_back(row);
+}
+
+std::vector<TrackerRowStore::Entry>::iterator TrackerRowStore::LowerBoundEntry(int beat) {
+    auto it = std::lower_bound(m_index.begin(), m_index.end(), beat, [](const Entry& entry, int value) {
+        return entry.beat < value;
+    });
+    assert((it == m_index.end() || it->row->rowId == it->beat) && "rowId changed outside ShiftBeats");
+    return it;
+}
+
+TrackerRow* TrackerRowStore::Find(int beat) {
+    auto it = LowerBoundEntry(beat);
+    return it != m_index.end() && it->beat == beat ? it->row : nullptr;
+}
+
+const TrackerRow* TrackerRowStore::Find(int beat) const {
+    return const_cast<TrackerRowStore*>(this)->Find(beat);
+}
+
+TrackerRowStore::iterator TrackerRowStore::LowerBound(int beat) {
+    return iterator(m_index.cbegin() + (LowerBoundEntry(beat) - m_index.begin()));
+}
+
+TrackerRowStore::const_iterator TrackerRowStore::LowerBound(int beat) const {
+    return const_cast<TrackerRowStore*>(this)->LowerBound(beat);
+}
+
+std::pair<TrackerRow*, bool> TrackerRowStore::Insert(const TrackerRow& row) {
+    // Rows usually arrive in beat order (decoders, appending at the end of the track).
+    if (m_index.empty() || m_index.back().beat < row.rowId) {
+        m_index.push_back({ row.rowId, Allocate(row) });
+        return { m_index.back().row, true };
+    }
+    auto it = LowerBoundEntry(row.rowId);
+    if (it != m_index.end() && it->beat == row.rowId) {
+        return { it->row, false };
+    }
+    it = m_index.insert(it, { row.rowId, Allocate(row) });
+    return { it->row, true };
+}
+
+TrackerRow& TrackerRowStore::Ensure(int beat) {
+    if (TrackerRow* existing = Find(beat)) {
+        return *existing;
+    }
+    TrackerRow row;
+    row.rowId = beat;
+    return *Insert(row).first;
+}
+
+bool TrackerRowStore::Erase(int beat) {
+    auto it = LowerBoundEntry(beat);
+    if (it == m_index.end() || it->beat != beat) {
+        return false;
+    }
+    Release(it->row);
+    m_index.erase(it);
+    return true;
+}
+
+size_t TrackerRowStore::EraseRange(int firstBeat, int lastBeat) {
+    if (lastBeat <= firstBeat) {
+        return 0;
+    }
+    auto first = LowerBoundEntry(firstBeat);
+    auto last = LowerBoundEntry(lastBeat);
+    for (auto it = first; it != last; ++it) {
+        Release(it->row);
+    }
+    const size_t removed = static_cast<size_t>(last - first);
+    m_index.erase(first, last);
+    return removed;
+}
+
+size_t TrackerRowStore::InsertBatch(const TrackerRow* rows, size_t count) {
+    if (!rows || count == 0) {
+        return 0;
+    }
+    std::vector<const TrackerRow*> incoming;
+    incoming.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        incoming.push_back(&rows[i]);
+    }
+    std::stable_sort(incoming.begin(), incoming.end(), [](const TrackerRow* a, const TrackerRow* b) {
+        return a->rowId < b->rowId;
+    });
+
+    // Merge the sorted batch with the index in one pass.
+    std::vector<Entry> merged;
+    merged.reserve(m_index.size() + incoming.size());
+    size_t inserted = 0;
+    auto existing = m_index.begin();
+    for (size_t i = 0; i < incoming.size(); ++i) {
+        const int beat = incoming[i]->rowId;
+        if (i > 0 && incoming[i - 1]->rowId == beat) {
+            continue;
+        }
+        while (existing != m_index.end() && existing->beat < beat) {
+            merged.push_back(*existing++);
+        }
+        if (existing != m_index.end() && existing->beat == beat) {
+            continue;
+        }
+        merged.push_back({ beat, Allocate(*incoming[i]) });
+        ++inserted;
+    }
+    merged.insert(merged.end(), existing, m_index.end());
+    m_index = std::move(merged);
+    return inserted;
+}
+
+size_t TrackerRowStore::Assign(std::vector<TrackerRow> rows) {
+    clear();
+    reserve(rows.size());
+    std::stable_sort(rows.begin(), rows.end(), [](const TrackerRow& a, const TrackerRow& b) {
+        return a.rowId < b.rowId;
+    });
+    size_t dropped = 0;
+    for (TrackerRow& row : rows) {
+        if (!m_index.empty() && m_index.back().beat == row.rowId) {
+            ++dropped;
+            continue;
+        }
+        TrackerRow* slot = m_free.back();
+        m_free.pop_back();
+        *slot = std::move(row);
+        m_index.push_back({ slot->rowId, slot });
+    }
+    return dropped;
+}
+
+void TrackerRowStore::ShiftBeats(int fromBeat, int delta) {
+    if (delta == 0) {
+        return;
+    }
+    if (delta < 0) {
+        EraseRange(fromBeat + delta, fromBeat);
+    }
+    // Order is kept: everything before fromBeat + delta is gone or stays below it.
+    for (auto it = LowerBoundEntry(fromBeat); it != m_index.end(); ++it) {
+        it->beat += delta;
+        it->row->rowId = it->beat;
+    }
+}
+
+std::vector<TrackerRow> TrackerRowStore::ToVector() const {
+    std::vector<TrackerRow> rows;
+    rows.reserve(m_index.size());
+    for (const Entry& entry : m_index) {
+        assert(entry.row->rowId == entry.beat && "rowId changed outside ShiftBeats");
+        rows.push_back(*entry.row);
+    }
+    return rows;
+}
+
+} // namespace ShaderLab
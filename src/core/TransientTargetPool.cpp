@@ -0,0 +1,136 @@
+#include "ShaderLab/Core/TransientTargetPool.h"
+
+#include <algorithm>
+
+namespace ShaderLab {
+
+TransientTargetPool::TransientTargetPool(ITransientTargetBackend& backend, uint32_t trimAfterFrames)
+    : m_backend(backend), m_trimAfterFrames(trimAfterFrames) {}
+
+TransientTargetPool::~TransientTargetPool() {
+    Clear();
+}
+
+void TransientTargetPool::BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    m_frameIndex = frameIndex;
+    m_leasedBytes = 0;
+    m_stats.frameLeasedBytes = 0;
+
+    for (uint32_t handle = 0; handle < static_cast<uint32_t>(m_entries.size()); ++handle) {
+        const Entry& entry = m_entries[handle];
+        if (!entry.alive || entry.leased) {
+            continue;
+        }
+        const bool gpuDone = completedFrameIndex >= 0 && entry.lastUsedFrame <= static_cast<uint64_t>(completedFrameIndex);
+        if (gpuDone && entry.lastUsedFrame + m_trimAfterFrames <= frameIndex) {
+            Destroy(handle);
+        }
+    }
+}
+
+uint32_t TransientTargetPool::Acquire(const TransientTargetDesc& desc) {
+    ++m_stats.acquireCount;
+
+    // Prefer the most recently used match so a steady frame keeps touching the same memory.
+    uint32_t best = kInvalidHandle;
+    for (uint32_t handle = 0; handle < static_cast<uint32_t>(m_entries.size()); ++handle) {
+        const Entry& entry = m_entries[handle];
+        if (!entry.alive || entry.leased || entry.desc != desc) {
+            continue;
+        }
+        if (best == kInvalidHandle || entry.lastUsedFrame > m_entries[best].lastUsedFrame) {
+            best = handle;
+        }
+    }
+
+    if (best != kInvalidHandle) {
+        ++m_stats.reuseCount;
+    } else {
+        if (!m_freeSlots.empty()) {
+            best = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        } else {
+            best = static_cast<uint32_t>(m_entries.size());
+            m_entries.emplace_back();
+        }
+
+        uint64_t bytes = 0;
+        if (!m_backend.CreateTarget(best, desc, bytes)) {
+            m_freeSlots.push_back(best);
+            return kInvalidHandle;
+        }
+
+        Entry& created = m_entries[best];
+        created.desc = desc;
+        created.bytes = bytes;
+        created.alive = true;
+        ++m_stats.createCount;
+        ++m_stats.liveTargets;
+        m_stats.liveBytes += bytes;
+        m_stats.peakLiveBytes = (std::max)(m_stats.peakLiveBytes, m_stats.liveBytes);
+    }
+
+    Entry& entry = m_entries[best];
+    entry.leased = true;
+    entry.lastUsedFrame = m_frameIndex;
+    m_leasedBytes += entry.bytes;
+    m_stats.frameLeasedBytes = (std::max)(m_stats.frameLeasedBytes, m_leasedBytes);
+    m_stats.peakLeasedBytes = (std::max)(m_stats.peakLeasedBytes, m_leasedBytes);
+    return best;
+}
+
+void TransientTargetPool::Release(uint32_t handle) {
+    if (!IsLeased(handle)) {
+        return;
+    }
+    Entry& entry = m_entries[handle];
+    entry.leased = false;
+    m_leasedBytes -= entry.bytes;
+}
+
+void TransientTargetPool::EndFrame() {
+    uint64_t idleBytes = 0;
+    for (uint32_t handle = 0; handle < static_cast<uint32_t>(m_entries.size()); ++handle) {
+        Entry& entry = m_entries[handle];
+        if (!entry.alive) {
+            continue;
+        }
+        entry.leased = false;
+        if (entry.lastUsedFrame != m_frameIndex) {
+            idleBytes += entry.bytes;
+        }
+    }
+    m_leasedBytes = 0;
+    m_stats.idleBytes = idleBytes;
+}
+
+void TransientTargetPool::Clear() {
+    for (uint32_t handle = 0; handle < static_cast<uint32_t>(m_entries.size()); ++handle) {
+        if (m_entries[handle].alive) {
+            Destroy(handle);
+        }
+    }
+    m_entries.clear();
+    m_freeSlots.clear();
+    m_leasedBytes = 0;
+    m_stats.idleBytes = 0;
+}
+
+bool TransientTargetPool::IsLeased(uint32_t handle) const {
+    return handle < m_entries.size() && m_entries[handle].alive && m_entries[handle].leased;
+}
+
+void TransientTargetPool::Destroy(uint32_t handle) {
+    Entry& entry = m_entries[handle];
+    m_backend.DestroyTarget(handle);
+    if (entry.leased) {
+        m_leasedBytes -= entry.bytes;
+    }
+    ++m_stats.destroyCount;
+    --m_stats.liveTargets;
+    m_stats.liveBytes -= entry.bytes;
+    entry = Entry{};
+    m_freeSlots.push_back(handle);
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,141 @@
+#include "ShaderLab/Core/VideoExportPipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace ShaderLab {
+
+VideoExportPipeline::VideoExportPipeline(std::unique_ptr<IVideoFrameSink> sink, size_t capacity)
+    : m_sink(std::move(sink)), m_capacity((std::max)(capacity, size_t(1))) {
+}
+
+VideoExportPipeline::~VideoExportPipeline() {
+    Cancel();
+}
+
+bool VideoExportPipeline::Start(const VideoFrameFormat& format, std::string& outError) {
+    if (m_started || !m_sink || format.width == 0 || format.height == 0) {
+        outError = "Invalid video export setup.";
+        return false;
+    }
+    if (!m_sink->Open(format, outError)) {
+        return false;
+    }
+    m_format = format;
+    m_rgb.resize(static_cast<size_t>(format.width) * format.height * 3u);
+    m_started = true;
+    m_worker = std::thread([this]() { WorkerMain(); });
+    return true;
+}
+
+bool VideoExportPipeline::CanSubmit() const {
+    return m_started && !m_failed.load() && m_submitted - m_consumed.load() < m_capacity;
+}
+
+bool VideoExportPipeline::Submit(const uint8_t* rgba, uint32_t rowPitch) {
+    if (!CanSubmit() || !rgba) {
+        return false;
+    }
+    Frame frame;
+    frame.rgba = rgba;
+    frame.rowPitch = rowPitch;
+    frame.index = m_submitted++;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(frame);
+        m_stats.maxQueued = (std::max)(m_stats.maxQueued, m_queue.size());
+    }
+    m_wake.notify_one();
+    return true;
+}
+
+bool VideoExportPipeline::Finish(std::string& outError) {
+    return Stop(true, outError);
+}
+
+void VideoExportPipeline::Cancel() {
+    std::string ignored;
+    Stop(false, ignored);
+}
+
+bool VideoExportPipeline::Stop(bool drain, std::string& outError) {
+    if (!m_started) {
+        return !m_failed.load();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!drain) {
+            m_queue.clear();
+        }
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    m_started = false;
+
+    std::string closeError;
+    const bool closed = m_sink->Close(closeError);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!closed && m_error.empty()) {
+        m_error = closeError;
+        m_failed = true;
+    }
+    outError = m_error;
+    return !m_failed.load();
+}
+
+std::string VideoExportPipeline::GetError() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_error;
+}
+
+VideoExportStats VideoExportPipeline::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void VideoExportPipeline::WorkerMain() {
+    for (;;) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;
+            }
+            frame = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        // After a failure frames are still consumed so the producer never waits on a dead sink.
+        double convertMs = 0.0;
+        double writeMs = 0.0;
+        if (!m_failed.load()) {
+            const auto start = std::chrono::steady_clock::now();
+            ConvertRgbaToRgb(frame.rgba, frame.rowPitch, m_format.width, m_format.height, m_rgb.data());
+            const auto converted = std::chrono::steady_clock::now();
+            std::string error;
+            const bool written = m_sink->WriteFrame(m_rgb.data(), frame.index, error);
+            const auto end = std::chrono::steady_clock::now();
+            convertMs = std::chrono::duration<double, std::milli>(converted - start).count();
+            writeMs = std::chrono::duration<double, std::milli>(end - converted).count();
+            if (!written) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_error = error;
+                m_failed = true;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.convertMs += convertMs;
+            m_stats.writeMs += writeMs;
+            m_stats.framesWritten += m_failed.load() ? 0u : 1u;
+        }
+        m_consumed.fetch_add(1);
+    }
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,362 @@
+#include "ShaderLab/Core/VideoFrameSink.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <csignal>
+#include <cstdlib>
+#include <sys/wait.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SHADERLAB_VIDEO_SSSE3 1
+#include <tmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define SHADERLAB_TARGET_SSSE3
+#else
+#define SHADERLAB_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#endif
+
+namespace ShaderLab {
+
+namespace {
+
+void ConvertRowScalar(const uint8_t* src, uint8_t* dst, uint32_t count) {
+    for (uint32_t x = 0; x < count; ++x) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        src += 4;
+        dst += 3;
+    }
+}
+
+#if defined(SHADERLAB_VIDEO_SSSE3)
+bool CpuHasSsse3() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+// 16 pixels per iteration: each 16-byte load shuffles down to 12 bytes, four of those are
+// stitched into three 16-byte stores.
+SHADERLAB_TARGET_SSSE3 uint32_t ConvertRowSsse3(const uint8_t* src, uint8_t* dst, uint32_t count) {
+    const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    uint32_t x = 0;
+    for (; x + 16 <= count; x += 16) {
+        const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), pack);
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), pack);
+        const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)), pack);
+        const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48)), pack);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+        src += 64;
+        dst += 48;
+    }
+    return x;
+}
+#endif
+
+void WriteBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+} // namespace
+
+void ConvertRgbaToRgb(const uint8_t* rgba, uint32_t rowPitch, uint32_t width, uint32_t height, uint8_t* outRgb) {
+#if defined(SHADERLAB_VIDEO_SSSE3)
+    static const bool hasSsse3 = CpuHasSsse3();
+#endif
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* src = rgba + static_cast<size_t>(y) * rowPitch;
+        uint8_t* dst = outRgb + static_cast<size_t>(y) * width * 3u;
+        uint32_t done = 0;
+#if defined(SHADERLAB_VIDEO_SSSE3)
+        if (hasSsse3) {
+            done = ConvertRowSsse3(src, dst, width);
+        }
+#endif
+        ConvertRowScalar(src + static_cast<size_t>(done) * 4u, dst + static_cast<size_t>(done) * 3u, width - done);
+    }
+}
+
+void EncodeQoi(const uint8_t* rgb, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    static const uint8_t kEndMarker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    out.reserve(out.size() + 14 + static_cast<size_t>(width) * height * 4u + sizeof(kEndMarker));
+    out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+    WriteBigEndian32(out, width);
+    WriteBigEndian32(out, height);
+    out.push_back(3); // Channels
+    out.push_back(0); // sRGB
+
+    uint8_t index[64][3] = {};
+    uint8_t previous[3] = { 0, 0, 0 };
+    int run = 0;
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const uint8_t* px = rgb + i * 3u;
+        if (px[0] == previous[0] && px[1] == previous[1] && px[2] == previous[2]) {
+            ++run;
+            if (run == 62 || i + 1 == pixelCount) {
+                out.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(static_cast<uint8_t>(0xC0 | (run - 1)));
+            run = 0;
+        }
+
+        // Alpha is always 255 here, which is part of the index hash.
+        const int slot = (px[0] * 3 + px[1] * 5 + px[2] * 7 + 255 * 11) % 64;
+        if (index[slot][0] == px[0] && index[slot][1] == px[1] && index[slot][2] == px[2]) {
+            out.push_back(static_cast<uint8_t>(slot));
+        } else {
+            std::memcpy(index[slot], px, 3);
+            const int dr = static_cast<int8_t>(px[0] - previous[0]);
+            const int dg = static_cast<int8_t>(px[1] - previous[1]);
+            const int db = static_cast<int8_t>(px[2] - previous[2]);
+            const int drg = dr - dg;
+            const int dbg = db - dg;
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                out.push_back(static_cast<uint8_t>(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)));
+            } else if (drg >= -8 && drg <= 7 && dg >= -32 && dg <= 31 && dbg >= -8 && dbg <= 7) {
+                out.push_back(static_cast<uint8_t>(0x80 | (dg + 32)));
+                out.push_back(static_cast<uint8_t>(((drg + 8) << 4) | (dbg + 8)));
+            } else {
+                out.push_back(0xFE);
+                out.insert(out.end(), px, px + 3);
+            }
+        }
+        std::memcpy(previous, px, 3);
+    }
+    out.insert(out.end(), kEndMarker, kEndMarker + sizeof(kEndMarker));
+}
+
+// ----------------------------------------------------------------------------------------------
+
+struct EncoderPipeSink::Process {
+#if defined(_WIN32)
+    HANDLE process = nullptr;
+    HANDLE input = nullptr;
+#else
+    FILE* pipe = nullptr;
+#endif
+};
+
+EncoderPipeSink::EncoderPipeSink(std::string commandLine)
+    : m_commandLine(std::move(commandLine)) {
+}
+
+EncoderPipeSink::~EncoderPipeSink() {
+    std::string ignored;
+    Close(ignored);
+}
+
+bool EncoderPipeSink::Open(const VideoFrameFormat& format, std::string& outError) {
+    if (m_process) {
+        outError = "Encoder is already running.";
+        return false;
+    }
+    m_frameBytes = static_cast<size_t>(format.width) * format.height * 3u;
+    auto process = std::make_unique<Process>();
+#if defined(_WIN32)
+    SECURITY_ATTRIBUTES inherit = { sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+    HANDLE readEnd = nullptr;
+    if (!CreatePipe(&readEnd, &process->input, &inherit, 0)) {
+        outError = "Could not create the encoder pipe.";
+        return false;
+    }
+    SetHandleInformation(process->input, HANDLE_FLAG_INHERIT, 0);
+    HANDLE nul = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, &inherit, OPEN_EXISTING, 0, nullptr);
+
+    STARTUPINFOA si = {};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = readEnd;
+    si.hStdOutput = nul;
+    si.hStdError = nul;
+    PROCESS_INFORMATION pi = {};
+    std::string commandLine = m_commandLine;
+    const BOOL launched = CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+                                         nullptr, nullptr, &si, &pi);
+    CloseHandle(readEnd);
+    if (nul != INVALID_HANDLE_VALUE) {
+        CloseHandle(nul);
+    }
+    if (!launched) {
+        CloseHandle(process->input);
+        outError = "Could not launch the encoder: " + m_commandLine;
+        return false;
+    }
+    CloseHandle(pi.hThread);
+    process->process = pi.hProcess;
+#else
+    // A dying encoder must surface as a failed write, not kill the editor.
+    std::signal(SIGPIPE, SIG_IGN);
+    process->pipe = popen(m_commandLine.c_str(), "w");
+    if (!process->pipe) {
+        outError = "Could not launch the encoder: " + m_commandLine;
+        return false;
+    }
+#endif
+    m_process = std::move(process);
+    return true;
+}
+
+bool EncoderPipeSink::WriteFrame(const uint8_t* rgb, uint64_t frameIndex, std::string& outError) {
+    if (!m_process) {
+        outError = "Encoder is not running.";
+        return false;
+    }
+#if defined(_WIN32)
+    size_t written = 0;
+    while (written < m_frameBytes) {
+        const DWORD chunk = static_cast<DWORD>((std::min)(m_frameBytes - written, size_t(1) << 24));
+        DWORD done = 0;
+        if (!WriteFile(m_process->input, rgb + written, chunk, &done, nullptr) || done == 0) {
+            break;
+        }
+        written += done;
+    }
+    const bool ok = written == m_frameBytes;
+#else
+    const bool ok = std::fwrite(rgb, 1, m_frameBytes, m_process->pipe) == m_frameBytes;
+#endif
+    if (!ok) {
+        outError = "Encoder stopped accepting frames at frame " + std::to_string(frameIndex) + ".";
+    }
+    return ok;
+}
+
+bool EncoderPipeSink::Close(std::string& outError) {
+    if (!m_process) {
+        return true;
+    }
+    std::unique_ptr<Process> process = std::move(m_process);
+#if defined(_WIN32)
+    // Closing stdin is the encoder's end of stream.
+    CloseHandle(process->input);
+    WaitForSingleObject(process->process, INFINITE);
+    DWORD exitCode = 1;
+    GetExitCodeProcess(process->process, &exitCode);
+    CloseHandle(process->process);
+#else
+    const int status = pclose(process->pipe);
+    const int exitCode = (status != -1 && WIFEXITED(status)) ? WEXITSTATUS(status) : 1;
+#endif
+    if (exitCode != 0) {
+        outError = "Encoder exited with code " + std::to_string(exitCode) + ".";
+        return false;
+    }
+    return true;
+}
+
+std::string EncoderPipeSink::FfmpegCommand(const std::string& ffmpegPath, const VideoFrameFormat& format,
+                                           const std::string& outputPath) {
+    std::ostringstream cmd;
+    cmd << "\"" << ffmpegPath << "\" -y -loglevel error -f rawvideo -pix_fmt rgb24"
+        << " -s " << format.width << "x" << format.height << " -framerate " << format.fps
+        << " -i - -c:v libx264 -pix_fmt yuv420p \"" << outputPath << "\"";
+    return cmd.str();
+}
+
+bool EncoderPipeSink::ProbeEncoder(const std::string& executable) {
+#if defined(_WIN32)
+    SECURITY_ATTRIBUTES inherit = { sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE };
+    HANDLE nul = CreateFileA("NUL", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, &inherit, OPEN_EXISTING, 0, nullptr);
+    STARTUPINFOA si = {};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdOutput = nul;
+    si.hStdError = nul;
+    PROCESS_INFORMATION pi = {};
+    std::string commandLine = "\"" + executable + "\" -version";
+    const BOOL launched = CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, TRUE, CREATE_NO_WINDOW,
+                                         nullptr, nullptr, &si, &pi);
+    if (nul != INVALID_HANDLE_VALUE) {
+        CloseHandle(nul);
+    }
+    if (!launched) {
+        return false;
+    }
+    DWORD exitCode = 1;
+    if (WaitForSingleObject(pi.hProcess, 5000) == WAIT_OBJECT_0) {
+        GetExitCodeProcess(pi.hProcess, &exitCode);
+    } else {
+        TerminateProcess(pi.hProcess, 1);
+    }
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+    return exitCode == 0;
+#else
+    const std::string command = "\"" + executable + "\" -version >/dev/null 2>&1";
+    return std::system(command.c_str()) == 0;
+#endif
+}
+
+// ----------------------------------------------------------------------------------------------
+
+QoiSequenceSink::QoiSequenceSink(std::string directory)
+    : m_directory(std::move(directory)) {
+}
+
+bool QoiSequenceSink::Open(const VideoFrameFormat& format, std::string& outError) {
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (ec) {
+        outError = "Could not create " + m_directory + ": " + ec.message();
+        return false;
+    }
+    m_format = format;
+    m_bytesWritten = 0;
+    return true;
+}
+
+bool QoiSequenceSink::WriteFrame(const uint8_t* rgb, uint64_t frameIndex, std::string& outError) {
+    m_encoded.clear();
+    EncodeQoi(rgb, m_format.width, m_format.height, m_encoded);
+
+    char fileName[64] = {};
+    std::snprintf(fileName, sizeof(fileName), "frame_%05llu.qoi", static_cast<unsigned long long>(frameIndex));
+    const std::string path = (std::filesystem::path(m_directory) / fileName).string();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        outError = "Could not write " + path;
+        return false;
+    }
+    const bool ok = std::fwrite(m_encoded.data(), 1, m_encoded.size(), file) == m_encoded.size();
+    const bool closed = std::fclose(file) == 0;
+    if (!ok || !closed) {
+        outError = "Could not write " + path;
+        return false;
+    }
+    m_bytesWritten += m_encoded.size();
+    return true;
+}
+
+bool QoiSequenceSink::Close(std::string& outError) {
+    (void)outError;
+    return true;
+}
+
+} // namespace ShaderLab
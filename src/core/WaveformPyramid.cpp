@@ -0,0 +1,398 @@
+#include "ShaderLab/Core/WaveformPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr size_t kStagingBuckets = 4096;   // Level 0 buckets reduced per parallel batch
+constexpr size_t kMinBucketsPerWorker = 256;
+constexpr uint32_t kMaxBaseBucketSamples = 1u << 20;
+constexpr uint32_t kMaxLevels = 64;
+
+unsigned ResolveWorkerCount(unsigned requested) {
+    if (requested > 0) {
+        return requested;
+    }
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1u;
+}
+
+// Splits [0, count) into contiguous ranges; every item writes its own output, so the result
+// does not depend on the worker count.
+void ParallelFor(size_t count, unsigned workers, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    workers = static_cast<unsigned>((std::min)(static_cast<size_t>(workers), count));
+    if (workers <= 1) {
+        body(0, count);
+        return;
+    }
+    const size_t chunk = (count + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    for (size_t begin = chunk; begin < count; begin += chunk) {
+        threads.emplace_back(body, begin, (std::min)(count, begin + chunk));
+    }
+    body(0, chunk);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Small batches are not worth a thread each.
+unsigned WorkersFor(size_t buckets, unsigned workers) {
+    const size_t useful = (std::max)(static_cast<size_t>(1), buckets / kMinBucketsPerWorker);
+    return static_cast<unsigned>((std::min)(static_cast<size_t>(workers), useful));
+}
+
+uint64_t HashBytes(const void* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+float ToFloat(int16_t value) {
+    return static_cast<float>(value) / 32767.0f;
+}
+
+float ToFloatRms(uint16_t value) {
+    return static_cast<float>(value) / 65535.0f;
+}
+
+int16_t QuantizeFloor(float value) {
+    const float scaled = std::floor((std::max)(-1.0f, (std::min)(1.0f, value)) * 32767.0f);
+    return static_cast<int16_t>(scaled);
+}
+
+int16_t QuantizeCeil(float value) {
+    const float scaled = std::ceil((std::max)(-1.0f, (std::min)(1.0f, value)) * 32767.0f);
+    return static_cast<int16_t>(scaled);
+}
+
+uint16_t QuantizeRms(float value) {
+    return static_cast<uint16_t>(std::lround((std::max)(0.0f, (std::min)(1.0f, value)) * 65535.0f));
+}
+
+WaveformBucket ReduceSamples(const float* samples, size_t count) {
+    float low = 1.0f; // Quantization clamps to [-1, 1] anyway
+    float high = -1.0f;
+    double sumSquares = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const float sample = std::isfinite(samples[i]) ? samples[i] : 0.0f;
+        low = (std::min)(low, sample);
+        high = (std::max)(high, sample);
+        sumSquares += static_cast<double>(sample) * sample;
+    }
+    WaveformBucket bucket;
+    bucket.min = QuantizeFloor(low);
+    bucket.max = QuantizeCeil(high);
+    bucket.rms = QuantizeRms(static_cast<float>(std::sqrt(sumSquares / static_cast<double>(count))));
+    return bucket;
+}
+
+WaveformBucket MergeBuckets(const WaveformBucket& a, const WaveformBucket& b) {
+    WaveformBucket merged;
+    merged.min = (std::min)(a.min, b.min);
+    merged.max = (std::max)(a.max, b.max);
+    const float ra = ToFloatRms(a.rms);
+    const float rb = ToFloatRms(b.rms);
+    merged.rms = QuantizeRms(std::sqrt(0.5f * (ra * ra + rb * rb)));
+    return merged;
+}
+
+// Bucket counts of every level, finest first; empty when the sizes are out of range.
+std::vector<uint64_t> LevelSizes(uint64_t sampleCount, uint32_t baseBucketSamples) {
+    std::vector<uint64_t> sizes;
+    if (sampleCount == 0 || baseBucketSamples == 0) {
+        return sizes;
+    }
+    uint64_t count = (sampleCount + baseBucketSamples - 1) / baseBucketSamples;
+    sizes.push_back(count);
+    while (count > 1 && sizes.size() < kMaxLevels) {
+        count = (count + 1) / 2;
+        sizes.push_back(count);
+    }
+    return sizes;
+}
+
+} // namespace
+
+double WaveformPyramid::GetDurationSeconds() const {
+    return m_sampleRate > 0 ? static_cast<double>(m_sampleCount) / m_sampleRate : 0.0;
+}
+
+size_t WaveformPyramid::Query(double startSeconds, double endSeconds, uint32_t columnCount, WaveformColumn* outColumns) const {
+    if (columnCount == 0 || !outColumns) {
+        return 0;
+    }
+    std::fill(outColumns, outColumns + columnCount, WaveformColumn{});
+    if (m_levels.empty() || !(endSeconds > startSeconds)) {
+        return 0;
+    }
+
+    const double firstSample = startSeconds * m_sampleRate;
+    const double columnSamples = (endSeconds - startSeconds) * m_sampleRate / columnCount;
+    size_t level = 0;
+    double bucketSamples = m_baseBucketSamples;
+    while (level + 1 < m_levels.size() && bucketSamples * 2.0 <= columnSamples) {
+        ++level;
+        bucketSamples *= 2.0;
+    }
+    const std::vector<WaveformBucket>& buckets = m_levels[level];
+    const double sampleCount = static_cast<double>(m_sampleCount);
+
+    size_t valid = 0;
+    for (uint32_t c = 0; c < columnCount; ++c) {
+        const double begin = firstSample + columnSamples * c;
+        const double end = begin + columnSamples;
+        if (end <= 0.0 || begin >= sampleCount) {
+            continue;
+        }
+        const size_t first = static_cast<size_t>(std::floor((std::max)(begin, 0.0) / bucketSamples));
+        size_t last = static_cast<size_t>(std::ceil((std::min)(end, sampleCount) / bucketSamples));
+        last = (std::min)((std::max)(last, first + 1), buckets.size());
+        if (first >= last) {
+            continue;
+        }
+
+        int16_t low = buckets[first].min;
+        int16_t high = buckets[first].max;
+        float sumSquares = 0.0f;
+        for (size_t b = first; b < last; ++b) {
+            low = (std::min)(low, buckets[b].min);
+            high = (std::max)(high, buckets[b].max);
+            const float rms = ToFloatRms(buckets[b].rms);
+            sumSquares += rms * rms;
+        }
+        WaveformColumn& column = outColumns[c];
+        column.min = ToFloat(low);
+        column.max = ToFloat(high);
+        column.rms = std::sqrt(sumSquares / static_cast<float>(last - first));
+        column.valid = true;
+        ++valid;
+    }
+    return valid;
+}
+
+void WaveformPyramid::Serialize(std::vector<uint8_t>& outData) const {
+    size_t bucketCount = 0;
+    for (const auto& level : m_levels) {
+        bucketCount += level.size();
+    }
+    outData.assign(sizeof(SlWaveHeader) + bucketCount * sizeof(WaveformBucket), 0);
+    uint8_t* payload = outData.data() + sizeof(SlWaveHeader);
+    size_t offset = 0;
+    for (const auto& level : m_levels) {
+        std::memcpy(payload + offset, level.data(), level.size() * sizeof(WaveformBucket));
+        offset += level.size() * sizeof(WaveformBucket);
+    }
+
+    SlWaveHeader header;
+    header.sampleRate = m_sampleRate;
+    header.baseBucketSamples = m_baseBucketSamples;
+    header.levelCount = static_cast<uint32_t>(m_levels.size());
+    header.sampleCount = m_sampleCount;
+    header.sourceHash = m_sourceHash;
+    header.payloadHash = HashBytes(payload, offset);
+    std::memcpy(outData.data(), &header, sizeof(header));
+}
+
+bool WaveformPyramid::Deserialize(const uint8_t* data, size_t size, WaveformPyramid& outPyramid, std::string& outError) {
+    if (!data || size < sizeof(SlWaveHeader)) {
+        outError = "Waveform cache is truncated.";
+        return false;
+    }
+    SlWaveHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kSlWaveMagic || header.version != kSlWaveVersion) {
+        outError = "Not a supported .slwave cache.";
+        return false;
+    }
+    if (header.sampleRate == 0 || header.baseBucketSamples == 0 || header.baseBucketSamples > kMaxBaseBucketSamples ||
+        header.sampleCount == 0) {
+        outError = "Waveform cache header is invalid.";
+        return false;
+    }
+    const std::vector<uint64_t> sizes = LevelSizes(header.sampleCount, header.baseBucketSamples);
+    if (sizes.size() != header.levelCount) {
+        outError = "Waveform cache header is invalid.";
+        return false;
+    }
+    const uint64_t payloadSize = size - sizeof(SlWaveHeader);
+    uint64_t bucketCount = 0;
+    for (uint64_t levelSize : sizes) {
+        bucketCount += levelSize;
+        if (bucketCount > payloadSize / sizeof(WaveformBucket)) {
+            outError = "Waveform cache is truncated.";
+            return false;
+        }
+    }
+    if (bucketCount * sizeof(WaveformBucket) != payloadSize) {
+        outError = "Waveform cache is truncated.";
+        return false;
+    }
+    const uint8_t* payload = data + sizeof(SlWaveHeader);
+    if (HashBytes(payload, static_cast<size_t>(payloadSize)) != header.payloadHash) {
+        outError = "Waveform cache is corrupt.";
+        return false;
+    }
+
+    WaveformPyramid pyramid;
+    pyramid.m_sampleRate = header.sampleRate;
+    pyramid.m_baseBucketSamples = header.baseBucketSamples;
+    pyramid.m_sampleCount = header.sampleCount;
+    pyramid.m_sourceHash = header.sourceHash;
+    pyramid.m_levels.resize(sizes.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        std::vector<WaveformBucket>& level = pyramid.m_levels[i];
+        level.resize(static_cast<size_t>(sizes[i]));
+        std::memcpy(level.data(), payload + offset, level.size() * sizeof(WaveformBucket));
+        offset += level.size() * sizeof(WaveformBucket);
+        for (const WaveformBucket& bucket : level) {
+            if (bucket.min > bucket.max) {
+                outError = "Waveform cache is corrupt.";
+                return false;
+            }
+        }
+    }
+    outPyramid = std::move(pyramid);
+    return true;
+}
+
+bool WaveformPyramid::Save(const std::string& path, std::string& outError) const {
+    std::vector<uint8_t> data;
+    Serialize(data);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        outError = "Cannot write waveform cache: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool WaveformPyramid::Load(const std::string& path, WaveformPyramid& outPyramid, std::string& outError) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        outError = "Cannot read waveform cache: " + path;
+        return false;
+    }
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Deserialize(data.data(), data.size(), outPyramid, outError);
+}
+
+bool WaveformPyramidBuilder::Begin(const WaveformBuildOptions& options, std::string& outError) {
+    if (options.baseBucketSamples == 0 || options.baseBucketSamples > kMaxBaseBucketSamples) {
+        outError = "Waveform bucket size is out of range.";
+        return false;
+    }
+    m_options = options;
+    m_options.workerCount = ResolveWorkerCount(options.workerCount);
+    m_staging.clear();
+    m_staging.reserve(kStagingBuckets * m_options.baseBucketSamples);
+    m_base.clear();
+    m_sampleCount = 0;
+    m_begun = true;
+    return true;
+}
+
+void WaveformPyramidBuilder::Append(const float* samples, size_t count) {
+    if (!m_begun || !samples) {
+        return;
+    }
+    const size_t capacity = kStagingBuckets * m_options.baseBucketSamples;
+    m_sampleCount += count;
+    while (count > 0) {
+        const size_t take = (std::min)(count, capacity - m_staging.size());
+        m_staging.insert(m_staging.end(), samples, samples + take);
+        samples += take;
+        count -= take;
+        if (m_staging.size() == capacity) {
+            Flush(false);
+        }
+    }
+}
+
+void WaveformPyramidBuilder::Flush(bool final) {
+    const size_t bucketSamples = m_options.baseBucketSamples;
+    size_t buckets = m_staging.size() / bucketSamples;
+    if (final && m_staging.size() % bucketSamples != 0) {
+        ++buckets;
+    }
+    if (buckets == 0) {
+        return;
+    }
+    const size_t firstBucket = m_base.size();
+    m_base.resize(firstBucket + buckets);
+    const float* staging = m_staging.data();
+    const size_t stagedSamples = m_staging.size();
+    ParallelFor(buckets, WorkersFor(buckets, m_options.workerCount), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b) {
+            const size_t first = b * bucketSamples;
+            const size_t count = (std::min)(bucketSamples, stagedSamples - first);
+            m_base[firstBucket + b] = ReduceSamples(staging + first, count);
+        }
+    });
+    const size_t consumed = (std::min)(stagedSamples, buckets * bucketSamples);
+    m_staging.erase(m_staging.begin(), m_staging.begin() + static_cast<std::ptrdiff_t>(consumed));
+}
+
+bool WaveformPyramidBuilder::Finish(uint32_t sampleRate, WaveformPyramid& outPyramid, std::string& outError) {
+    if (!m_begun) {
+        outError = "Waveform builder was not started.";
+        return false;
+    }
+    m_begun = false;
+    if (m_sampleCount == 0 || sampleRate == 0) {
+        outError = "Audio holds no samples.";
+        return false;
+    }
+    Flush(true);
+
+    WaveformPyramid pyramid;
+    pyramid.m_sampleRate = sampleRate;
+    pyramid.m_baseBucketSamples = m_options.baseBucketSamples;
+    pyramid.m_sampleCount = m_sampleCount;
+    pyramid.m_levels.push_back(std::move(m_base));
+    m_base.clear();
+    while (pyramid.m_levels.back().size() > 1 && pyramid.m_levels.size() < kMaxLevels) {
+        const std::vector<WaveformBucket>& below = pyramid.m_levels.back();
+        std::vector<WaveformBucket> level((below.size() + 1) / 2);
+        ParallelFor(level.size(), WorkersFor(level.size(), m_options.workerCount), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const size_t left = i * 2;
+                level[i] = left + 1 < below.size() ? MergeBuckets(below[left], below[left + 1]) : below[left];
+            }
+        });
+        pyramid.m_levels.push_back(std::move(level));
+    }
+    outPyramid = std::move(pyramid);
+    return true;
+}
+
+bool BuildWaveformPyramid(const float* samples,
+                          size_t sampleCount,
+                          uint32_t sampleRate,
+                          const WaveformBuildOptions& options,
+                          WaveformPyramid& outPyramid,
+                          std::string& outError) {
+    WaveformPyramidBuilder builder;
+    if (!builder.Begin(options, outError)) {
+        return false;
+    }
+    builder.Append(samples, sampleCount);
+    return builder.Finish(sampleRate, outPyramid, outError);
+}
+
+} // namespace ShaderLab
@@ -9,7 +9,7 @@ CommandQueue::~CommandQueue() {
     Shutdown();
 }
 
-bool CommandQueue::Initialize(Device* device, D3D12_COMMAND_LIST_TYPE type) {
+bool CommandQueue::Initialize(Device* device, D3D12_COMMAND_LIST_TYPE type, uint32_t frameContextCount) {
     if (!device || !device->IsValid()) {
         return false;
     }
@@ -26,14 +26,18 @@ bool CommandQueue::Initialize(Device* device, D3D12_COMMAND_LIST_TYPE type) {
         return false;
     }
 
-    // Create command allocator
-    hr = d3dDevice->CreateCommandAllocator(type, IID_PPV_ARGS(&m_commandAllocator));
-    if (FAILED(hr)) {
-        return false;
+    // One command allocator per frame context
+    m_frames = FrameContextRing(frameContextCount);
+    m_commandAllocators.resize(m_frames.GetContextCount());
+    for (auto& allocator : m_commandAllocators) {
+        hr = d3dDevice->CreateCommandAllocator(type, IID_PPV_ARGS(&allocator));
+        if (FAILED(hr)) {
+            return false;
+        }
     }
 
     // Create command list
-    hr = d3dDevice->CreateCommandList(0, type, m_commandAllocator.Get(), 
+    hr = d3dDevice->CreateCommandList(0, type, m_commandAllocators[0].Get(), 
                                       nullptr, IID_PPV_ARGS(&m_commandList));
     if (FAILED(hr)) {
         return false;
@@ -66,13 +70,14 @@ void CommandQueue::Shutdown() {
 
     m_fence.Reset();
     m_commandList.Reset();
-    m_commandAllocator.Reset();
+    m_commandAllocators.clear();
     m_queue.Reset();
 }
 
 void CommandQueue::ResetCommandList() {
-    m_commandAllocator->Reset();
-    m_commandList->Reset(m_commandAllocator.Get(), nullptr);
+    ID3D12CommandAllocator* allocator = m_commandAllocators[m_frames.BeginFrame(*this)].Get();
+    allocator->Reset();
+    m_commandList->Reset(allocator, nullptr);
 }
 
 void CommandQueue::ExecuteCommandList() {
@@ -80,6 +85,7 @@ void CommandQueue::ExecuteCommandList() {
     
     ID3D12CommandList* commandLists[] = { m_commandList.Get() };
     m_queue->ExecuteCommandLists(1, commandLists);
+    m_frames.EndFrame(SignalFence());
 }
 
 void CommandQueue::WaitForGPU() {
@@ -87,13 +93,8 @@ void CommandQueue::WaitForGPU() {
         return;
     }
 
-    const uint64_t fenceValue = ++m_fenceValue;
-    m_queue->Signal(m_fence.Get(), fenceValue);
-
-    if (m_fence->GetCompletedValue() < fenceValue) {
-        m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent);
-        WaitForSingleObject(m_fenceEvent, INFINITE);
-    }
+    WaitForValue(SignalFence());
+    m_frames.UpdateCompleted(*this);
 }
 
 uint64_t CommandQueue::SignalFence() {
@@ -102,4 +103,15 @@ uint64_t CommandQueue::SignalFence() {
     return fenceValue;
 }
 
+uint64_t CommandQueue::GetCompletedValue() {
+    return m_fence ? m_fence->GetCompletedValue() : m_fenceValue;
+}
+
+void CommandQueue::WaitForValue(uint64_t value) {
+    if (m_fence->GetCompletedValue() < value) {
+        m_fence->SetEventOnCompletion(value, m_fenceEvent);
+        WaitForSingleObject(m_fenceEvent, INFINITE);
+    }
+}
+
 } // namespace ShaderLab
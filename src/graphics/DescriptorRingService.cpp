@@ -0,0 +1,183 @@
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+
+namespace ShaderLab {
+
+namespace {
+
+template <typename ViewDesc>
+uint64_t HashViewDesc(const ViewDesc& desc, uint64_t viewType) {
+    // Callers zero-initialize descriptions, so hashing the raw bytes is stable.
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&desc);
+    uint64_t hash = (1469598103934665603ull ^ viewType) * 1099511628211ull;
+    for (size_t i = 0; i < sizeof(desc); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+DescriptorRingService::~DescriptorRingService() {
+    Shutdown();
+}
+
+bool DescriptorRingService::Initialize(ID3D12Device* device, uint32_t cacheCapacity, uint32_t ringCapacity) {
+    Shutdown();
+    if (!device || cacheCapacity == 0 || ringCapacity == 0) {
+        return false;
+    }
+
+    D3D12_DESCRIPTOR_HEAP_DESC cacheDesc = {};
+    cacheDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    cacheDesc.NumDescriptors = cacheCapacity;
+    cacheDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+    if (FAILED(device->CreateDescriptorHeap(&cacheDesc, IID_PPV_ARGS(&m_cacheHeap)))) {
+        return false;
+    }
+
+    D3D12_DESCRIPTOR_HEAP_DESC ringDesc = {};
+    ringDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+    ringDesc.NumDescriptors = ringCapacity;
+    ringDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+    if (FAILED(device->CreateDescriptorHeap(&ringDesc, IID_PPV_ARGS(&m_ringHeap)))) {
+        m_cacheHeap.Reset();
+        return false;
+    }
+
+    m_device = device;
+    m_descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    m_cachedResources.resize(cacheCapacity);
+    m_allocator = std::make_unique<DescriptorRingAllocator>(*this, cacheCapacity, ringCapacity);
+    return true;
+}
+
+void DescriptorRingService::Shutdown() {
+    if (m_allocator) {
+        m_allocator->Clear();
+    }
+    m_allocator.reset();
+    m_cachedResources.clear();
+    m_ringHeap.Reset();
+    m_cacheHeap.Reset();
+    m_device = nullptr;
+}
+
+void DescriptorRingService::BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    if (m_allocator) {
+        m_allocator->BeginFrame(frameIndex, completedFrameIndex);
+    }
+}
+
+void DescriptorRingService::EndFrame() {
+    if (m_allocator) {
+        m_allocator->EndFrame();
+    }
+}
+
+bool DescriptorRingService::GetSrv(ID3D12Resource* resource,
+                                   const D3D12_SHADER_RESOURCE_VIEW_DESC& desc,
+                                   D3D12_CPU_DESCRIPTOR_HANDLE& outHandle) {
+    bool needsWrite = false;
+    if (!AcquireCacheSlot(resource, HashViewDesc(desc, 0), outHandle, needsWrite)) {
+        return false;
+    }
+    if (needsWrite) {
+        m_device->CreateShaderResourceView(resource, &desc, outHandle);
+    }
+    return true;
+}
+
+bool DescriptorRingService::GetUav(ID3D12Resource* resource,
+                                   const D3D12_UNORDERED_ACCESS_VIEW_DESC& desc,
+                                   D3D12_CPU_DESCRIPTOR_HANDLE& outHandle) {
+    bool needsWrite = false;
+    if (!AcquireCacheSlot(resource, HashViewDesc(desc, 1), outHandle, needsWrite)) {
+        return false;
+    }
+    if (needsWrite) {
+        m_device->CreateUnorderedAccessView(resource, nullptr, &desc, outHandle);
+    }
+    return true;
+}
+
+bool DescriptorRingService::GetTexture2DSrv(ID3D12Resource* resource, DXGI_FORMAT format, D3D12_CPU_DESCRIPTOR_HANDLE& outHandle) {
+    D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
+    desc.Format = format;
+    desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    desc.Texture2D.MipLevels = 1;
+    return GetSrv(resource, desc, outHandle);
+}
+
+bool DescriptorRingService::AllocateTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources,
+                                          uint32_t count,
+                                          D3D12_GPU_DESCRIPTOR_HANDLE& outTable) {
+    D3D12_CPU_DESCRIPTOR_HANDLE tableCpu = {};
+    return AllocateTable(sources, count, count, tableCpu, outTable);
+}
+
+bool DescriptorRingService::AllocateTable(const D3D12_CPU_DESCRIPTOR_HANDLE* sources,
+                                          uint32_t sourceCount,
+                                          uint32_t tableSize,
+                                          D3D12_CPU_DESCRIPTOR_HANDLE& outCpu,
+                                          D3D12_GPU_DESCRIPTOR_HANDLE& outTable) {
+    if (!m_allocator || (sourceCount > 0 && !sources) || sourceCount > tableSize) {
+        return false;
+    }
+    const uint32_t start = m_allocator->AllocateTable(tableSize);
+    if (start == DescriptorRingAllocator::kInvalidSlot) {
+        return false;
+    }
+
+    outCpu = m_ringHeap->GetCPUDescriptorHandleForHeapStart();
+    outCpu.ptr += static_cast<SIZE_T>(start) * m_descriptorSize;
+    if (sourceCount > 0) {
+        if (m_copySizes.size() < sourceCount) {
+            m_copySizes.resize(sourceCount, 1u);
+        }
+        m_device->CopyDescriptors(1, &outCpu, &sourceCount,
+                                  sourceCount, sources, m_copySizes.data(),
+                                  D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    }
+
+    outTable = m_ringHeap->GetGPUDescriptorHandleForHeapStart();
+    outTable.ptr += static_cast<UINT64>(start) * m_descriptorSize;
+    return true;
+}
+
+const DescriptorRingStats& DescriptorRingService::GetStats() const {
+    static const DescriptorRingStats kEmpty;
+    return m_allocator ? m_allocator->GetStats() : kEmpty;
+}
+
+bool DescriptorRingService::AcquireCacheSlot(ID3D12Resource* resource,
+                                             uint64_t viewHash,
+                                             D3D12_CPU_DESCRIPTOR_HANDLE& outHandle,
+                                             bool& outNeedsWrite) {
+    if (!m_allocator) {
+        return false;
+    }
+
+    DescriptorViewKey key;
+    key.resource = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(resource));
+    key.view = viewHash;
+    const uint32_t slot = m_allocator->AcquireView(key, outNeedsWrite);
+    if (slot == DescriptorRingAllocator::kInvalidSlot) {
+        return false;
+    }
+
+    outHandle = m_cacheHeap->GetCPUDescriptorHandleForHeapStart();
+    outHandle.ptr += static_cast<SIZE_T>(slot) * m_descriptorSize;
+    if (outNeedsWrite) {
+        m_cachedResources[slot] = resource;
+    }
+    return true;
+}
+
+void DescriptorRingService::ReleaseCachedView(uint32_t slot) {
+    if (slot < m_cachedResources.size()) {
+        m_cachedResources[slot].Reset();
+    }
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,75 @@
+#include "ShaderLab/Graphics/FrameUploadRing.h"
+
+namespace ShaderLab {
+
+FrameUploadRing::~FrameUploadRing() {
+    Shutdown();
+}
+
+bool FrameUploadRing::Initialize(ID3D12Device* device, uint64_t capacityBytes) {
+    Shutdown();
+    if (!device || capacityBytes == 0) {
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = capacityBytes;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                               D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                               IID_PPV_ARGS(&m_buffer)))) {
+        return false;
+    }
+
+    D3D12_RANGE readRange = { 0, 0 };
+    if (FAILED(m_buffer->Map(0, &readRange, reinterpret_cast<void**>(&m_mapped)))) {
+        m_buffer.Reset();
+        m_mapped = nullptr;
+        return false;
+    }
+
+    m_ring.Reset(capacityBytes);
+    return true;
+}
+
+void FrameUploadRing::Shutdown() {
+    if (m_buffer && m_mapped) {
+        m_buffer->Unmap(0, nullptr);
+    }
+    m_mapped = nullptr;
+    m_buffer.Reset();
+    m_ring.Reset(0);
+}
+
+void FrameUploadRing::BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    m_ring.BeginFrame(frameIndex, completedFrameIndex);
+}
+
+void FrameUploadRing::EndFrame() {
+    m_ring.EndFrame();
+}
+
+bool FrameUploadRing::Allocate(uint64_t size, uint64_t alignment, void*& outCpu, D3D12_GPU_VIRTUAL_ADDRESS& outGpu) {
+    if (!m_mapped) {
+        return false;
+    }
+    const uint64_t offset = m_ring.Allocate(size, alignment);
+    if (offset == FrameRingBuffer::kInvalidOffset) {
+        return false;
+    }
+    outCpu = m_mapped + offset;
+    outGpu = m_buffer->GetGPUVirtualAddress() + offset;
+    return true;
+}
+
+} // namespace ShaderLab
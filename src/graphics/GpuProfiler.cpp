@@ -0,0 +1,103 @@
+#include "ShaderLab/Graphics/GpuProfiler.h"
+
+namespace ShaderLab {
+
+GpuProfiler::GpuProfiler(uint32_t frameSlots, uint32_t queriesPerFrame)
+    : m_profiler(frameSlots, queriesPerFrame) {
+}
+
+GpuProfiler::~GpuProfiler() {
+    Shutdown();
+}
+
+bool GpuProfiler::Initialize(ID3D12Device* device, ID3D12CommandQueue* queue) {
+    Shutdown();
+    if (!device || !queue || FAILED(queue->GetTimestampFrequency(&m_frequency)) || m_frequency == 0) {
+        return false;
+    }
+    D3D12_QUERY_HEAP_DESC heapDesc = {};
+    heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    heapDesc.Count = m_profiler.GetQueryCapacity();
+    if (FAILED(device->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&m_queryHeap)))) {
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = sizeof(uint64_t) * heapDesc.Count;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                               D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&m_readback)))) {
+        m_queryHeap.Reset();
+        return false;
+    }
+    return true;
+}
+
+void GpuProfiler::Shutdown() {
+    m_readback.Reset();
+    m_queryHeap.Reset();
+}
+
+void GpuProfiler::BeginFrame(uint64_t frameIndex, int64_t completedFrameIndex) {
+    CollectCompleted(completedFrameIndex);
+    m_profiler.BeginFrame(frameIndex);
+}
+
+void GpuProfiler::EndFrame(ID3D12GraphicsCommandList* commandList) {
+    const uint32_t count = m_profiler.GetGpuQueryCount();
+    if (m_queryHeap && commandList && count > 0) {
+        const uint32_t first = m_profiler.GetGpuQueryFirst();
+        commandList->ResolveQueryData(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, first, count,
+                                      m_readback.Get(), sizeof(uint64_t) * first);
+    }
+    m_profiler.EndFrame();
+}
+
+void GpuProfiler::BeginScope(ID3D12GraphicsCommandList* commandList, const char* name) {
+    if (!m_queryHeap || !commandList) {
+        return;
+    }
+    const uint32_t query = m_profiler.BeginGpuScope(name);
+    if (query != FrameProfiler::kInvalidQuery) {
+        commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, query);
+    }
+}
+
+void GpuProfiler::EndScope(ID3D12GraphicsCommandList* commandList) {
+    if (!m_queryHeap || !commandList) {
+        return;
+    }
+    const uint32_t query = m_profiler.EndGpuScope();
+    if (query != FrameProfiler::kInvalidQuery) {
+        commandList->EndQuery(m_queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, query);
+    }
+}
+
+void GpuProfiler::CollectCompleted(int64_t completedFrameIndex) {
+    if (!m_readback) {
+        return;
+    }
+    uint64_t frameIndex = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+    while (m_profiler.GetPendingGpuFrame(completedFrameIndex, frameIndex, first, count)) {
+        const D3D12_RANGE readRange = { sizeof(uint64_t) * first, sizeof(uint64_t) * (first + count) };
+        void* mapped = nullptr;
+        if (FAILED(m_readback->Map(0, &readRange, &mapped))) {
+            m_profiler.ResolveGpuFrame(frameIndex, nullptr, 0);
+            continue;
+        }
+        m_profiler.ResolveGpuFrame(frameIndex, static_cast<const uint64_t*>(mapped) + first, m_frequency);
+        const D3D12_RANGE writeRange = { 0, 0 };
+        m_readback->Unmap(0, &writeRange);
+    }
+}
+
+} // namespace ShaderLab
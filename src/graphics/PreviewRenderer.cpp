@@ -5,7 +5,9 @@
 #include "ShaderLab/Shader/ShaderCompiler.h"
 
 #include <d3d12.h>
+#include <cstddef>
 #include <cstdio>
+#include <cstring>
 
 #ifndef SHADERLAB_TINY_PLAYER
 #define SHADERLAB_TINY_PLAYER 0
@@ -60,7 +62,13 @@ struct Constants {
     float fBeat;
     float fBarBeat;
     float fBarBeat16;
+    uint32_t iHistoryFrames;
+    float iAudioRms;
+    float iAudioOnset;
+    float iAudioPeak;
+    float iAudioBands[kAudioShaderBands]; // float4 iAudioBands[2], 16-byte aligned in HLSL
 };
+static_assert(offsetof(Constants, iAudioBands) == 48, "Constants must match ShaderBase::BuildConstantsBlock");
 
 PreviewRenderer::PreviewRenderer() = default;
 
@@ -246,7 +254,8 @@ void PreviewRenderer::Render(ID3D12GraphicsCommandList* commandList,
                               float iBar,
                               float fBarBeat16,
                               float fBeat,
-                              float fBarBeat) {
+                              float fBarBeat,
+                              uint32_t historyFrames) {
     if (!pipelineState || !renderTarget) {
         return;
     }
@@ -309,6 +318,11 @@ void PreviewRenderer::Render(ID3D12GraphicsCommandList* commandList,
     constants.fBeat = fBeat;
     constants.fBarBeat = fBarBeat;
     constants.fBarBeat16 = fBarBeat16;
+    constants.iHistoryFrames = historyFrames;
+    constants.iAudioRms = m_audio.rms;
+    constants.iAudioOnset = m_audio.onset;
+    constants.iAudioPeak = m_audio.peak;
+    std::memcpy(constants.iAudioBands, m_audio.bands, sizeof(constants.iAudioBands));
     commandList->SetGraphicsRoot32BitConstants(0, sizeof(Constants) / 4, &constants, 0);
 
     // Set textures (SRV table)
@@ -0,0 +1,120 @@
+#include "ShaderLab/Graphics/RenderGraphExecutor.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
+#include "ShaderLab/Graphics/TransientTargetService.h"
+
+namespace ShaderLab {
+
+RenderGraphExecutor::RenderGraphExecutor(TransientTargetService& targets)
+    : m_targets(targets) {}
+
+void RenderGraphExecutor::Reset() {
+    m_graph.Reset();
+    m_plan.Clear();
+    m_passFunctions.clear();
+    m_physical.clear();
+}
+
+uint32_t RenderGraphExecutor::Import(const char* name, ID3D12Resource* resource, uint32_t initialAccess, uint32_t finalAccess) {
+    return m_graph.ImportTexture(name, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(resource)), initialAccess, finalAccess);
+}
+
+uint32_t RenderGraphExecutor::CreateTexture(const char* name, uint32_t width, uint32_t height, DXGI_FORMAT format, D3D12_RESOURCE_FLAGS flags) {
+    TransientTargetDesc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = static_cast<uint32_t>(format);
+    desc.flags = static_cast<uint32_t>(flags);
+    return m_graph.CreateTexture(name, desc);
+}
+
+uint32_t RenderGraphExecutor::AddPass(const char* name, PassFunction function, bool hasSideEffects) {
+    m_passFunctions.push_back(std::move(function));
+    return m_graph.AddPass(name, hasSideEffects);
+}
+
+ID3D12Resource* RenderGraphExecutor::GetResource(uint32_t resource) const {
+    if (resource >= m_plan.resourcePhysical.size()) {
+        return nullptr;
+    }
+    const uint32_t physical = m_plan.resourcePhysical[resource];
+    return physical < m_physical.size() ? m_physical[physical] : nullptr;
+}
+
+bool RenderGraphExecutor::Execute(ID3D12GraphicsCommandList* commandList, std::string& outError) {
+    if (!commandList || !m_graph.Compile(m_plan, outError)) {
+        return false;
+    }
+
+    // Imports resolve to their own pointer; transient slots lease one pooled target each.
+    m_physical.assign(m_plan.importedCount + m_plan.transientDescs.size(), nullptr);
+    for (uint32_t r = 0; r < m_graph.GetResourceCount(); ++r) {
+        if (m_graph.IsImported(r)) {
+            m_physical[m_plan.resourcePhysical[r]] = reinterpret_cast<ID3D12Resource*>(static_cast<uintptr_t>(m_graph.GetExternalId(r)));
+        }
+    }
+    m_leases.assign(m_plan.transientDescs.size(), TransientTargetPool::kInvalidHandle);
+    bool leased = true;
+    for (size_t i = 0; i < m_plan.transientDescs.size() && leased; ++i) {
+        const TransientTargetDesc& desc = m_plan.transientDescs[i];
+        ID3D12Resource* target = m_targets.Acquire(desc.width, desc.height,
+                                                   static_cast<DXGI_FORMAT>(desc.format),
+                                                   static_cast<D3D12_RESOURCE_FLAGS>(desc.flags),
+                                                   m_leases[i]);
+        m_physical[m_plan.importedCount + i] = target;
+        leased = target != nullptr;
+    }
+
+    if (leased) {
+        for (const RenderGraphStep& step : m_plan.steps) {
+            RecordBarriers(commandList, step.firstBarrier, step.barrierCount);
+            if (m_passFunctions[step.pass]) {
+                ScopedGpuProfile scope(m_profiler, commandList, m_graph.GetPassName(step.pass));
+                m_passFunctions[step.pass](commandList);
+            }
+        }
+        RecordBarriers(commandList, m_plan.finalFirstBarrier, m_plan.finalBarrierCount);
+    } else {
+        outError = "transient target allocation failed";
+    }
+
+    for (uint32_t handle : m_leases) {
+        m_targets.Release(handle);
+    }
+    return leased;
+}
+
+D3D12_RESOURCE_STATES RenderGraphExecutor::ToResourceState(uint32_t access) {
+    D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+    if (access & RenderGraphAccessPixelRead) state |= D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    if (access & RenderGraphAccessComputeRead) state |= D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    if (access & RenderGraphAccessCopySource) state |= D3D12_RESOURCE_STATE_COPY_SOURCE;
+    if (access & RenderGraphAccessRenderTarget) state |= D3D12_RESOURCE_STATE_RENDER_TARGET;
+    if (access & RenderGraphAccessUnorderedAccess) state |= D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    if (access & RenderGraphAccessCopyDest) state |= D3D12_RESOURCE_STATE_COPY_DEST;
+    return state; // Present is COMMON
+}
+
+void RenderGraphExecutor::RecordBarriers(ID3D12GraphicsCommandList* commandList, uint32_t first, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    m_barrierScratch.clear();
+    for (uint32_t i = first; i < first + count; ++i) {
+        const RenderGraphBarrier& source = m_plan.barriers[i];
+        D3D12_RESOURCE_BARRIER barrier = {};
+        if (source.type == RenderGraphBarrierType::Uav) {
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            barrier.UAV.pResource = m_physical[source.physical];
+        } else {
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Transition.pResource = m_physical[source.physical];
+            barrier.Transition.StateBefore = ToResourceState(source.before);
+            barrier.Transition.StateAfter = ToResourceState(source.after);
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        }
+        m_barrierScratch.push_back(barrier);
+    }
+    commandList->ResourceBarrier(static_cast<UINT>(m_barrierScratch.size()), m_barrierScratch.data());
+}
+
+} // namespace ShaderLab
@@ -0,0 +1,245 @@
+#include "ShaderLab/Graphics/TextureUploader.h"
+
+#include "ShaderLab/Graphics/Dx12ResourceService.h"
+
+#include <utility>
+
+namespace ShaderLab {
+
+Dx12TextureUploader::~Dx12TextureUploader() {
+    Shutdown();
+}
+
+bool Dx12TextureUploader::Initialize(ID3D12Device* device, uint64_t stagingBytes) {
+    Shutdown();
+    if (!device || stagingBytes == 0) {
+        return false;
+    }
+    m_device = device;
+
+    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    if (FAILED(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_queue))) ||
+        FAILED(device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_fence)))) {
+        Shutdown();
+        return false;
+    }
+    m_fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    if (!m_fenceEvent || !CreateStaging(stagingBytes)) {
+        Shutdown();
+        return false;
+    }
+    return true;
+}
+
+void Dx12TextureUploader::Shutdown() {
+    if (m_queue && m_fence && m_lastSignaled > 0) {
+        WaitForBatch(m_lastSignaled - 1);
+    }
+    ReleaseStaging();
+    m_textures.clear();
+    m_pendingAllocators.clear();
+    m_freeAllocators.clear();
+    m_openAllocator.Reset();
+    m_commandList.Reset();
+    m_fence.Reset();
+    m_queue.Reset();
+    m_device.Reset();
+    if (m_fenceEvent) {
+        CloseHandle(m_fenceEvent);
+        m_fenceEvent = nullptr;
+    }
+    m_lastSignaled = 0;
+}
+
+void Dx12TextureUploader::WaitForBatch(uint64_t batchIndex) {
+    const uint64_t value = batchIndex + 1;
+    if (!m_fence || value > m_lastSignaled || m_fence->GetCompletedValue() >= value) {
+        return;
+    }
+    if (SUCCEEDED(m_fence->SetEventOnCompletion(value, m_fenceEvent))) {
+        WaitForSingleObject(m_fenceEvent, INFINITE);
+    }
+}
+
+ComPtr<ID3D12Resource> Dx12TextureUploader::TakeTexture(uint64_t ticket) {
+    ComPtr<ID3D12Resource> texture;
+    auto it = m_textures.find(ticket);
+    if (it != m_textures.end()) {
+        texture = std::move(it->second);
+        m_textures.erase(it);
+    }
+    return texture;
+}
+
+bool Dx12TextureUploader::ResizeStaging(uint64_t capacityBytes) {
+    if (!m_device || m_openAllocator) {
+        return false;
+    }
+    if (m_lastSignaled > 0) {
+        WaitForBatch(m_lastSignaled - 1);
+    }
+    return CreateStaging(capacityBytes);
+}
+
+TextureStagingFootprint Dx12TextureUploader::GetFootprint(uint32_t width, uint32_t height) {
+    D3D12_RESOURCE_DESC desc = {};
+    desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    desc.Width = width;
+    desc.Height = height;
+    desc.DepthOrArraySize = 1;
+    desc.MipLevels = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT placed = {};
+    UINT64 totalBytes = 0;
+    m_device->GetCopyableFootprints(&desc, 0, 1, 0, &placed, nullptr, nullptr, &totalBytes);
+
+    TextureStagingFootprint footprint;
+    footprint.rowPitch = placed.Footprint.RowPitch;
+    footprint.totalBytes = totalBytes;
+    footprint.alignment = D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT;
+    return footprint;
+}
+
+bool Dx12TextureUploader::RecordUpload(uint64_t ticket, uint32_t width, uint32_t height, uint64_t stagingOffset,
+                                       const TextureStagingFootprint& footprint, std::string& outError) {
+    if (!OpenBatch()) {
+        outError = "Failed to open the texture upload command list.";
+        return false;
+    }
+
+    Dx12ResourceService resourceService(m_device.Get());
+    TextureAllocationRequest textureRequest{};
+    textureRequest.width = width;
+    textureRequest.height = height;
+    textureRequest.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    textureRequest.initialState = D3D12_RESOURCE_STATE_COPY_DEST;
+    ComPtr<ID3D12Resource> texture;
+    if (!resourceService.AllocateTexture2D(textureRequest, texture)) {
+        outError = "Failed to create a " + std::to_string(width) + "x" + std::to_string(height) + " texture.";
+        return false;
+    }
+
+    D3D12_TEXTURE_COPY_LOCATION dst = {};
+    dst.pResource = texture.Get();
+    dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    dst.SubresourceIndex = 0;
+
+    D3D12_TEXTURE_COPY_LOCATION src = {};
+    src.pResource = m_staging.Get();
+    src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    src.PlacedFootprint.Offset = stagingOffset;
+    src.PlacedFootprint.Footprint.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    src.PlacedFootprint.Footprint.Width = width;
+    src.PlacedFootprint.Footprint.Height = height;
+    src.PlacedFootprint.Footprint.Depth = 1;
+    src.PlacedFootprint.Footprint.RowPitch = footprint.rowPitch;
+    m_commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+
+    D3D12_RESOURCE_BARRIER barrier = {};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = texture.Get();
+    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    m_commandList->ResourceBarrier(1, &barrier);
+
+    m_textures[ticket] = std::move(texture);
+    return true;
+}
+
+void Dx12TextureUploader::SubmitBatch(uint64_t batchIndex) {
+    if (!m_openAllocator) {
+        return;
+    }
+    m_commandList->Close();
+    ID3D12CommandList* lists[] = { m_commandList.Get() };
+    m_queue->ExecuteCommandLists(1, lists);
+    m_lastSignaled = batchIndex + 1;
+    m_queue->Signal(m_fence.Get(), m_lastSignaled);
+
+    PendingAllocator pending;
+    pending.batchIndex = batchIndex;
+    pending.allocator = std::move(m_openAllocator);
+    m_pendingAllocators.push_back(std::move(pending));
+}
+
+int64_t Dx12TextureUploader::GetCompletedBatch() {
+    if (!m_fence) {
+        return -1;
+    }
+    const int64_t completed = static_cast<int64_t>(m_fence->GetCompletedValue()) - 1;
+    while (!m_pendingAllocators.empty() && completed >= 0 &&
+           m_pendingAllocators.front().batchIndex <= static_cast<uint64_t>(completed)) {
+        m_freeAllocators.push_back(std::move(m_pendingAllocators.front().allocator));
+        m_pendingAllocators.pop_front();
+    }
+    return completed;
+}
+
+void Dx12TextureUploader::ReleaseTexture(uint64_t ticket) {
+    m_textures.erase(ticket);
+}
+
+bool Dx12TextureUploader::CreateStaging(uint64_t capacityBytes) {
+    ReleaseStaging();
+    Dx12ResourceService resourceService(m_device.Get());
+    ResourceBufferAllocationRequest request{};
+    request.sizeBytes = capacityBytes;
+    request.heapType = D3D12_HEAP_TYPE_UPLOAD;
+    request.initialState = D3D12_RESOURCE_STATE_GENERIC_READ;
+    if (!resourceService.AllocateBuffer(request, m_staging)) {
+        return false;
+    }
+    D3D12_RANGE readRange = { 0, 0 };
+    if (FAILED(m_staging->Map(0, &readRange, reinterpret_cast<void**>(&m_stagingMapped)))) {
+        m_staging.Reset();
+        m_stagingMapped = nullptr;
+        return false;
+    }
+    m_stagingCapacity = capacityBytes;
+    return true;
+}
+
+void Dx12TextureUploader::ReleaseStaging() {
+    if (m_staging && m_stagingMapped) {
+        m_staging->Unmap(0, nullptr);
+    }
+    m_staging.Reset();
+    m_stagingMapped = nullptr;
+    m_stagingCapacity = 0;
+}
+
+bool Dx12TextureUploader::OpenBatch() {
+    if (m_openAllocator) {
+        return true;
+    }
+    GetCompletedBatch();
+    ComPtr<ID3D12CommandAllocator> allocator;
+    if (!m_freeAllocators.empty()) {
+        allocator = std::move(m_freeAllocators.back());
+        m_freeAllocators.pop_back();
+        if (FAILED(allocator->Reset())) {
+            return false;
+        }
+    } else if (FAILED(m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator)))) {
+        return false;
+    }
+
+    if (!m_commandList) {
+        if (FAILED(m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator.Get(), nullptr,
+                                               IID_PPV_ARGS(&m_commandList)))) {
+            return false;
+        }
+    } else if (FAILED(m_commandList->Reset(allocator.Get(), nullptr))) {
+        return false;
+    }
+    m_openAllocator = std::move(allocator);
+    return true;
+}
+
+} // namespace ShaderLab
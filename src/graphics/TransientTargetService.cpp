@@ -0,0 +1,57 @@
+#include "ShaderLab/Graphics/TransientTargetService.h"
+
+namespace ShaderLab {
+
+TransientTargetService::TransientTargetService(IResourceService& resources, uint32_t trimAfterFrames)
+    : m_resources(resources), m_pool(*this, trimAfterFrames) {}
+
+ID3D12Resource* TransientTargetService::Acquire(uint32_t width,
+                                                uint32_t height,
+                                                DXGI_FORMAT format,
+                                                D3D12_RESOURCE_FLAGS flags,
+                                                uint32_t& outHandle) {
+    TransientTargetDesc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = static_cast<uint32_t>(format);
+    desc.flags = static_cast<uint32_t>(flags);
+
+    outHandle = m_pool.Acquire(desc);
+    if (outHandle == TransientTargetPool::kInvalidHandle) {
+        return nullptr;
+    }
+    return m_targets[outHandle].Get();
+}
+
+bool TransientTargetService::CreateTarget(uint32_t handle, const TransientTargetDesc& desc, uint64_t& outBytes) {
+    if (handle >= m_targets.size()) {
+        m_targets.resize(static_cast<size_t>(handle) + 1);
+    }
+
+    TextureAllocationRequest request;
+    request.width = desc.width;
+    request.height = desc.height;
+    request.format = static_cast<DXGI_FORMAT>(desc.format);
+    request.flags = static_cast<D3D12_RESOURCE_FLAGS>(desc.flags);
+    request.initialState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    if (!m_resources.AllocateTexture2D(request, m_targets[handle])) {
+        m_targets[handle].Reset();
+        return false;
+    }
+
+    const D3D12_RESOURCE_DESC resourceDesc = m_targets[handle]->GetDesc();
+    ComPtr<ID3D12Device> device;
+    outBytes = 0;
+    if (SUCCEEDED(m_targets[handle]->GetDevice(IID_PPV_ARGS(&device)))) {
+        outBytes = device->GetResourceAllocationInfo(0, 1, &resourceDesc).SizeInBytes;
+    }
+    return true;
+}
+
+void TransientTargetService::DestroyTarget(uint32_t handle) {
+    if (handle < m_targets.size()) {
+        m_targets[handle].Reset();
+    }
+}
+
+} // namespace ShaderLab
@@ -644,6 +644,7 @@ void ShaderLabIDE::ShowBuildSettingsWindow() {
     if (LabeledActionButton("BuildFromSettings", OpenFontIcons::kPlay, "Build Now", "Build to the selected solution root", ImVec2(180.0f, 0.0f))) {
         if (m_currentMode == UIMode::PostFX && m_postFxSourceSceneIndex >= 0 && m_postFxSourceSceneIndex < (int)m_scenes.size()) {
             m_scenes[m_postFxSourceSceneIndex].postFxChain = m_postFxDraftChain;
+            NoteProjectEdit();
         }
 
         if (m_currentProjectPath.empty()) {
@@ -3,6 +3,7 @@
 #include <string>
 
 #include "CodeThemes/CodeThemeFactory.h"
+#include "ShaderLab/Core/TextSearch.h"
 
 namespace ShaderLab {
 
@@ -63,6 +64,9 @@ void ShaderLabIDE::InitializeCodeEditors() {
     langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, TextEditor::PaletteIndex>("[a-zA-Z_][a-zA-Z0-9_]*", TextEditor::PaletteIndex::Identifier));
     langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, TextEditor::PaletteIndex>("[\\[\\]\\{\\}\\!\\%\\^\\&\\*\\(\\)\\-\\+\\=\\~\\|\\<\\>\\?\\/\\;\\,\\.]", TextEditor::PaletteIndex::Punctuation));
 
+    // Hand-written tokenizer; the regexes above only cover what it declines.
+    langDef.mTokenize = TextEditor::LanguageDefinition::HLSL().mTokenize;
+
     langDef.mCommentStart = "/*";
     langDef.mCommentEnd = "*/";
     langDef.mSingleLineComment = "//";
@@ -74,6 +78,7 @@ void ShaderLabIDE::InitializeCodeEditors() {
     m_snippetTextEditor.SetLanguageDefinition(langDef);
     m_tutCodeTextEditor.SetLanguageDefinition(langDef);
     m_ubershaderTextEditor.SetLanguageDefinition(langDef);
+    m_textEditor.SetSearchCallback(&FindText);
 
     const TextEditor::Palette palette = CodeThemes::BuildCodeThemePalette(m_activeThemeName);
     m_textEditor.SetPalette(palette);
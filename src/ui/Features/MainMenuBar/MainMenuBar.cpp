@@ -104,7 +104,7 @@ void ShaderLabIDE::ChooseWorkspaceFolder() {
             m_workspaceSelectionPromptPending = false;
             EnsureWorkspaceFolders();
             StoreWorkspaceFolderInRegistry(m_workspaceRootPath);
-            InitializePresetService(m_workspaceRootPath, m_appRoot);
+            InitializePresetService(*m_assetCatalog, m_workspaceRootPath, m_appRoot);
             AboutAssets::Get().Initialize(m_workspaceRootPath, m_appRoot);
             LoadGlobalSnippets();
             AppendDemoLog(std::string("[workspace] Active workspace set to ") + m_workspaceRootPath);
@@ -163,6 +163,8 @@ void ShaderLabIDE::ShowMainMenuBar() {
                 m_demoTitle = "Untitled Demo";
                 m_demoAuthor.clear();
                 m_demoDescription.clear();
+                m_undoHistory.Clear();
+                NoteProjectEdit();
                 CreateNewProjectInWorkspace(m_demoTitle);
                 if (m_audioSystem) m_audioSystem->Stop();
             }
@@ -210,6 +212,16 @@ void ShaderLabIDE::ShowMainMenuBar() {
             ImGui::EndMenu();
         }
         menuMaxX = (std::max)(menuMaxX, ImGui::GetItemRectMax().x);
+        if (ImGui::BeginMenu("Edit")) {
+            if (ImGui::MenuItem("Undo", "Ctrl+Z")) {
+                UndoProjectEdit();
+            }
+            if (ImGui::MenuItem("Redo", "Ctrl+Y", false, m_undoHistory.CanRedo())) {
+                RedoProjectEdit();
+            }
+            ImGui::EndMenu();
+        }
+        menuMaxX = (std::max)(menuMaxX, ImGui::GetItemRectMax().x);
         if (ImGui::BeginMenu("View")) {
             if (ImGui::MenuItem("Demo Mode", nullptr, m_currentMode == UIMode::Demo)) {
                 m_currentMode = UIMode::Demo;
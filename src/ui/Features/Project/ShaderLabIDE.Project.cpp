@@ -7,6 +7,7 @@
 
 #include "ShaderLab/Audio/AudioSystem.h"
 #include "ShaderLab/DevKit/RuntimeExporter.h"
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/Core/Serializer.h"
 #include "ShaderLab/UI/UISystemAssets.h"
 
@@ -498,6 +499,11 @@ void ShaderLabIDE::OpenProject() {
         m_currentProjectPath = szFile;
         ProjectData data;
         if (Serializer::LoadProject(m_currentProjectPath, data)) {
+            if (m_asyncCompiler) {
+                m_asyncCompiler->CancelAll();
+            }
+            m_undoHistory.Clear();
+            NoteProjectEdit();
             m_scenes = data.scenes;
             m_audioLibrary = data.audioLibrary;
             m_track = data.track;
@@ -524,15 +530,14 @@ void ShaderLabIDE::OpenProject() {
             if (m_deviceRef) {
                 for(auto& scene : m_scenes) {
                     for(auto& bind : scene.bindings) {
-                        if (bind.bindingType == BindingType::File && !bind.filePath.empty()) {
-                            LoadTextureFromFile(bind.filePath, bind.textureResource);
-                        }
+                        RequestFileTexture(bind);
                     }
                 }
             }
 
             LoadProjectUiSettings();
             RefreshPresetService();
+            StartProjectCompile();
         }
     }
 }
@@ -1,108 +1,441 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 
 #include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 
+#include <imgui.h>
+#include <imgui_internal.h>
+
 #include "ShaderLab/Audio/AudioSystem.h"
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/DevKit/BuildPipeline.h"
 
 namespace ShaderLab {
 
-ProjectState ShaderLabIDE::CaptureState() {
-    ProjectState state;
-    state.scenes = m_scenes;
-    state.audioLibrary = m_audioLibrary;
-    state.track = m_track;
-    state.transport = m_transport;
-    state.renderAspectRatioPreset =
-        (m_aspectRatio == AspectRatio::Ratio_1_1) ? RenderAspectRatioPreset::Ratio_1_1 :
-        (m_aspectRatio == AspectRatio::Ratio_16_10) ? RenderAspectRatioPreset::Ratio_16_10 :
-        (m_aspectRatio == AspectRatio::Ratio_4_3) ? RenderAspectRatioPreset::Ratio_4_3 :
-        RenderAspectRatioPreset::Ratio_16_9;
-    state.fullscreenRenderResolutionPreset = m_fullscreenRenderResolutionPreset;
-    state.demoTitle = m_demoTitle;
-    state.demoAuthor = m_demoAuthor;
-    state.demoDescription = m_demoDescription;
-    state.currentMode = m_currentMode;
-    state.shaderState = m_shaderState;
-    state.activeSceneIndex = m_activeSceneIndex;
+namespace {
+
+RenderAspectRatioPreset ToRenderAspectPreset(AspectRatio aspect) {
+    return (aspect == AspectRatio::Ratio_1_1) ? RenderAspectRatioPreset::Ratio_1_1 :
+           (aspect == AspectRatio::Ratio_16_10) ? RenderAspectRatioPreset::Ratio_16_10 :
+           (aspect == AspectRatio::Ratio_4_3) ? RenderAspectRatioPreset::Ratio_4_3 :
+           RenderAspectRatioPreset::Ratio_16_9;
+}
+
+AspectRatio FromRenderAspectPreset(RenderAspectRatioPreset preset) {
+    return (preset == RenderAspectRatioPreset::Ratio_1_1) ? AspectRatio::Ratio_1_1 :
+           (preset == RenderAspectRatioPreset::Ratio_16_10) ? AspectRatio::Ratio_16_10 :
+           (preset == RenderAspectRatioPreset::Ratio_4_3) ? AspectRatio::Ratio_4_3 :
+           AspectRatio::Ratio_16_9;
+}
+
+bool TextMatches(const std::string& text, const std::shared_ptr<const std::string>& doc) {
+    return doc ? *doc == text : text.empty();
+}
+
+bool BindingMatches(const TextureBinding& binding, const BindingDoc& doc) {
+    return binding.channelIndex == doc.channelIndex && binding.enabled == doc.enabled &&
+           binding.bindingType == doc.bindingType && binding.sourceSceneIndex == doc.sourceSceneIndex &&
+           binding.filePath == doc.filePath && binding.type == doc.type;
+}
+
+bool PostFxMatches(const Scene::PostFXEffect& effect, const PostFxDoc& doc) {
+    return effect.name == doc.name && TextMatches(effect.shaderCode, doc.shaderCode) &&
+           effect.shaderCodePath == doc.shaderCodePath && effect.precompiledPath == doc.precompiledPath &&
+           effect.enabled == doc.enabled;
+}
+
+bool ComputeMatches(const Scene::ComputeEffect& effect, const ComputeDoc& doc) {
+    return effect.name == doc.name && TextMatches(effect.shaderCode, doc.shaderCode) &&
+           effect.shaderCodePath == doc.shaderCodePath && effect.precompiledPath == doc.precompiledPath &&
+           effect.entryPoint == doc.entryPoint && static_cast<int>(effect.type) == doc.type &&
+           effect.enabled == doc.enabled && effect.param0 == doc.params[0] && effect.param1 == doc.params[1] &&
+           effect.param2 == doc.params[2] && effect.param3 == doc.params[3] &&
+           effect.threadGroupX == doc.threadGroup[0] && effect.threadGroupY == doc.threadGroup[1] &&
+           effect.threadGroupZ == doc.threadGroup[2] && effect.historyCount == doc.historyCount;
+}
+
+template <typename Item, typename Doc, typename Matches>
+bool ListMatches(const std::vector<Item>& items, const std::shared_ptr<const std::vector<Doc>>& docs, Matches matches) {
+    if (!docs) {
+        return items.empty();
+    }
+    if (items.size() != docs->size()) {
+        return false;
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (!matches(items[i], (*docs)[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SceneMatchesDoc(const Scene& scene, const SceneDoc& doc) {
+    return scene.id == doc.sceneId && scene.name == doc.name && scene.description == doc.description &&
+           TextMatches(scene.shaderCode, doc.shaderCode) && scene.shaderCodePath == doc.shaderCodePath &&
+           scene.precompiledPath == doc.precompiledPath && scene.outputType == doc.outputType &&
+           ListMatches(scene.bindings, doc.bindings, BindingMatches) &&
+           ListMatches(scene.postFxChain, doc.postFxChain, PostFxMatches) &&
+           ListMatches(scene.computeEffectChain, doc.computeChain, ComputeMatches);
+}
 
-    // Strip GPU resources from the saved state to ensure they don't dangle
-    for (auto& scene : state.scenes) {
-        scene.texture.Reset();
-        scene.srvHeap.Reset();
-        scene.pipelineState.Reset();
-        scene.textureValid = false;
-        scene.postFxTextureA.Reset();
-        scene.postFxTextureB.Reset();
-        scene.postFxSrvHeap.Reset();
-        scene.postFxRtvHeap.Reset();
-        scene.postFxValid = false;
-        for (auto& fx : scene.postFxChain) {
-            fx.pipelineState.Reset();
-            fx.isDirty = true;
-            fx.historyIndex = 0;
-            fx.historyInitialized = false;
-            fx.historyTextures.clear();
+// New document for a scene that no longer matches previous; parts that did not change stay shared.
+SceneNode MakeSceneDoc(const Scene& scene, const SceneDoc* previous) {
+    auto doc = std::make_shared<SceneDoc>();
+    doc->sceneId = scene.id;
+    doc->name = scene.name;
+    doc->description = scene.description;
+    doc->shaderCode = ShareText(previous ? previous->shaderCode : nullptr, scene.shaderCode);
+    doc->shaderCodePath = scene.shaderCodePath;
+    doc->precompiledPath = scene.precompiledPath;
+    doc->outputType = scene.outputType;
+
+    if (previous && ListMatches(scene.bindings, previous->bindings, BindingMatches)) {
+        doc->bindings = previous->bindings;
+    } else {
+        auto bindings = std::make_shared<std::vector<BindingDoc>>();
+        bindings->reserve(scene.bindings.size());
+        for (const TextureBinding& binding : scene.bindings) {
+            BindingDoc entry;
+            entry.channelIndex = binding.channelIndex;
+            entry.enabled = binding.enabled;
+            entry.bindingType = binding.bindingType;
+            entry.sourceSceneIndex = binding.sourceSceneIndex;
+            entry.filePath = binding.filePath;
+            entry.type = binding.type;
+            bindings->push_back(std::move(entry));
         }
+        doc->bindings = std::move(bindings);
+    }
 
-        for (auto& binding : scene.bindings) {
-             binding.textureResource.Reset();
-             binding.fileTextureValid = false;
+    if (previous && ListMatches(scene.postFxChain, previous->postFxChain, PostFxMatches)) {
+        doc->postFxChain = previous->postFxChain;
+    } else {
+        auto chain = std::make_shared<std::vector<PostFxDoc>>();
+        chain->reserve(scene.postFxChain.size());
+        for (size_t i = 0; i < scene.postFxChain.size(); ++i) {
+            const Scene::PostFXEffect& effect = scene.postFxChain[i];
+            const PostFxDoc* old = previous && previous->postFxChain && i < previous->postFxChain->size()
+                ? &(*previous->postFxChain)[i] : nullptr;
+            PostFxDoc entry;
+            entry.name = effect.name;
+            entry.shaderCode = ShareText(old ? old->shaderCode : nullptr, effect.shaderCode);
+            entry.shaderCodePath = effect.shaderCodePath;
+            entry.precompiledPath = effect.precompiledPath;
+            entry.enabled = effect.enabled;
+            chain->push_back(std::move(entry));
         }
+        doc->postFxChain = std::move(chain);
+    }
+
+    if (previous && ListMatches(scene.computeEffectChain, previous->computeChain, ComputeMatches)) {
+        doc->computeChain = previous->computeChain;
+    } else {
+        auto chain = std::make_shared<std::vector<ComputeDoc>>();
+        chain->reserve(scene.computeEffectChain.size());
+        for (size_t i = 0; i < scene.computeEffectChain.size(); ++i) {
+            const Scene::ComputeEffect& effect = scene.computeEffectChain[i];
+            const ComputeDoc* old = previous && previous->computeChain && i < previous->computeChain->size()
+                ? &(*previous->computeChain)[i] : nullptr;
+            ComputeDoc entry;
+            entry.name = effect.name;
+            entry.shaderCode = ShareText(old ? old->shaderCode : nullptr, effect.shaderCode);
+            entry.shaderCodePath = effect.shaderCodePath;
+            entry.precompiledPath = effect.precompiledPath;
+            entry.entryPoint = effect.entryPoint;
+            entry.type = static_cast<int>(effect.type);
+            entry.enabled = effect.enabled;
+            entry.params[0] = effect.param0;
+            entry.params[1] = effect.param1;
+            entry.params[2] = effect.param2;
+            entry.params[3] = effect.param3;
+            entry.threadGroup[0] = effect.threadGroupX;
+            entry.threadGroup[1] = effect.threadGroupY;
+            entry.threadGroup[2] = effect.threadGroupZ;
+            entry.historyCount = effect.historyCount;
+            chain->push_back(std::move(entry));
+        }
+        doc->computeChain = std::move(chain);
+    }
+    return doc;
+}
+
+const std::string& DocText(const std::shared_ptr<const std::string>& text) {
+    static const std::string kEmpty;
+    return text ? *text : kEmpty;
+}
+
+// Writes doc into effect. Pipelines are only dropped when the code changed.
+void ApplyPostFxDoc(Scene::PostFXEffect& effect, const PostFxDoc& doc) {
+    if (effect.shaderCode != DocText(doc.shaderCode)) {
+        effect.shaderCode = DocText(doc.shaderCode);
+        effect.isDirty = true;
     }
+    effect.name = doc.name;
+    effect.shaderCodePath = doc.shaderCodePath;
+    effect.precompiledPath = doc.precompiledPath;
+    effect.enabled = doc.enabled;
+}
 
+void ApplyComputeDoc(Scene::ComputeEffect& effect, const ComputeDoc& doc) {
+    if (effect.shaderCode != DocText(doc.shaderCode) || effect.entryPoint != doc.entryPoint) {
+        effect.shaderCode = DocText(doc.shaderCode);
+        effect.entryPoint = doc.entryPoint;
+        effect.isDirty = true;
+    }
+    if (effect.historyCount != doc.historyCount) {
+        effect.historyCount = doc.historyCount;
+        effect.historyIndex = 0;
+        effect.historyInitialized = false;
+        effect.historyFrames = 0;
+        effect.historyTextures.clear();
+    }
+    effect.name = doc.name;
+    effect.shaderCodePath = doc.shaderCodePath;
+    effect.precompiledPath = doc.precompiledPath;
+    effect.type = static_cast<Scene::ComputeEffect::Type>(doc.type);
+    effect.enabled = doc.enabled;
+    effect.param0 = doc.params[0];
+    effect.param1 = doc.params[1];
+    effect.param2 = doc.params[2];
+    effect.param3 = doc.params[3];
+    effect.threadGroupX = doc.threadGroup[0];
+    effect.threadGroupY = doc.threadGroup[1];
+    effect.threadGroupZ = doc.threadGroup[2];
+}
+
+} // namespace
+
+ProjectSnapshot ShaderLabIDE::CaptureSnapshot() const {
+    // Diffed against the current undo level, so only what changed since gets new nodes.
+    static const ProjectSnapshot kEmpty;
+    const ProjectSnapshot* current = m_undoHistory.Current();
+    const ProjectSnapshot& base = current ? *current : kEmpty;
+
+    ProjectSnapshot snapshot;
+    snapshot.scenes = PersistentVector<SceneNode, kSnapshotSceneChunk>::Rebuild(
+        base.scenes, m_scenes.size(),
+        [&](size_t i, const SceneNode& node) { return node && SceneMatchesDoc(m_scenes[i], *node); },
+        [&](size_t i, const SceneNode* node) { return MakeSceneDoc(m_scenes[i], node ? node->get() : nullptr); });
+    snapshot.trackRows = ShareTrackRows(base.trackRows, m_track.rows);
+    snapshot.audioLibrary = ShareAudioLibrary(base.audioLibrary, m_audioLibrary);
+
+    ProjectSettingsDoc settings;
+    settings.trackName = m_track.name;
+    settings.trackBpm = m_track.bpm;
+    settings.trackLengthBeats = m_track.lengthBeats;
+    settings.transportBpm = m_transport.bpm;
+    settings.renderAspectRatioPreset = ToRenderAspectPreset(m_aspectRatio);
+    settings.fullscreenRenderResolutionPreset = m_fullscreenRenderResolutionPreset;
+    settings.demoTitle = m_demoTitle;
+    settings.demoAuthor = m_demoAuthor;
+    settings.demoDescription = m_demoDescription;
+    snapshot.settings = ShareSettings(base.settings, settings);
+    return snapshot;
+}
+
+void ShaderLabIDE::ApplySnapshot(const ProjectSnapshot& snapshot) {
+    // Results in flight may target scene indices that no longer exist.
+    if (m_asyncCompiler) {
+        m_asyncCompiler->CancelAll();
+    }
+    if (m_projectCompiler) {
+        m_projectCompiler->CancelAll();
+    }
+
+    const bool editingValid = m_editingSceneIndex >= 0 && m_editingSceneIndex < (int)m_scenes.size();
+    const std::string editingCode = editingValid ? m_scenes[m_editingSceneIndex].shaderCode : std::string();
+    const uint64_t editingId = editingValid ? m_scenes[m_editingSceneIndex].id : 0;
+    const uint64_t activeId = (m_activeSceneIndex >= 0 && m_activeSceneIndex < (int)m_scenes.size())
+        ? m_scenes[m_activeSceneIndex].id : 0;
+
+    // Scenes keep their GPU objects when only names or parameters changed. They are matched by
+    // id, so undoing a delete or a reorder does not hand one scene's resources to another.
+    std::unordered_map<uint64_t, size_t> liveById;
+    for (size_t i = 0; i < m_scenes.size(); ++i) {
+        if (m_scenes[i].id != 0) {
+            liveById.emplace(m_scenes[i].id, i);
+        }
+    }
+    std::vector<Scene> scenes(snapshot.scenes.size());
+    for (size_t i = 0; i < snapshot.scenes.size(); ++i) {
+        const SceneDoc& doc = *snapshot.scenes[i];
+        Scene& scene = scenes[i];
+        auto live = doc.sceneId != 0 ? liveById.find(doc.sceneId) : liveById.end();
+        if (live != liveById.end()) {
+            scene = std::move(m_scenes[live->second]);
+            liveById.erase(live);
+            if (SceneMatchesDoc(scene, doc)) {
+                continue;
+            }
+        }
+        scene.id = doc.sceneId;
+        m_nextSceneId = (std::max)(m_nextSceneId, doc.sceneId + 1);
+        if (scene.shaderCode != DocText(doc.shaderCode) || scene.outputType != doc.outputType ||
+            !ListMatches(scene.bindings, doc.bindings, BindingMatches)) {
+            scene.isDirty = true;
+        }
+        scene.name = doc.name;
+        scene.description = doc.description;
+        scene.shaderCode = DocText(doc.shaderCode);
+        scene.shaderCodePath = doc.shaderCodePath;
+        scene.precompiledPath = doc.precompiledPath;
+        if (scene.outputType != doc.outputType) {
+            scene.outputType = doc.outputType;
+            scene.texture = nullptr;
+            scene.textureValid = false;
+        }
+
+        const size_t bindingCount = doc.bindings ? doc.bindings->size() : 0;
+        scene.bindings.resize(bindingCount);
+        for (size_t b = 0; b < bindingCount; ++b) {
+            const BindingDoc& bindingDoc = (*doc.bindings)[b];
+            TextureBinding& binding = scene.bindings[b];
+            if (BindingMatches(binding, bindingDoc)) {
+                continue;
+            }
+            const bool reload = binding.filePath != bindingDoc.filePath || binding.bindingType != bindingDoc.bindingType ||
+                                binding.type != bindingDoc.type || !binding.fileTextureValid;
+            binding.channelIndex = bindingDoc.channelIndex;
+            binding.enabled = bindingDoc.enabled;
+            binding.bindingType = bindingDoc.bindingType;
+            binding.sourceSceneIndex = bindingDoc.sourceSceneIndex;
+            binding.filePath = bindingDoc.filePath;
+            binding.type = bindingDoc.type;
+            if (reload) {
+                RequestFileTexture(binding);
+            }
+        }
+
+        const size_t postFxCount = doc.postFxChain ? doc.postFxChain->size() : 0;
+        scene.postFxChain.resize(postFxCount);
+        for (size_t fx = 0; fx < postFxCount; ++fx) {
+            ApplyPostFxDoc(scene.postFxChain[fx], (*doc.postFxChain)[fx]);
+        }
+        const size_t computeCount = doc.computeChain ? doc.computeChain->size() : 0;
+        scene.computeEffectChain.resize(computeCount);
+        for (size_t fx = 0; fx < computeCount; ++fx) {
+            ApplyComputeDoc(scene.computeEffectChain[fx], (*doc.computeChain)[fx]);
+        }
+    }
+    m_scenes = std::move(scenes);
+
+    m_track.rows.Assign(snapshot.trackRows.ToVector());
+    m_audioLibrary = snapshot.audioLibrary ? *snapshot.audioLibrary : std::vector<AudioClip>();
+    if (snapshot.settings) {
+        const ProjectSettingsDoc& settings = *snapshot.settings;
+        m_track.name = settings.trackName;
+        m_track.bpm = settings.trackBpm;
+        m_track.lengthBeats = settings.trackLengthBeats;
+        m_transport.bpm = settings.transportBpm;
+        m_aspectRatio = FromRenderAspectPreset(settings.renderAspectRatioPreset);
+        m_fullscreenRenderResolutionPreset = settings.fullscreenRenderResolutionPreset;
+        m_demoTitle = settings.demoTitle;
+        m_demoAuthor = settings.demoAuthor;
+        m_demoDescription = settings.demoDescription;
+    }
+
+    // Selections follow their scene when it survived; otherwise the index is clamped.
+    const int lastScene = (int)m_scenes.size() - 1;
+    m_activeSceneIndex = (std::min)(m_activeSceneIndex, lastScene);
+    m_editingSceneIndex = (std::min)(m_editingSceneIndex, lastScene);
+    for (int i = 0; i <= lastScene; ++i) {
+        if (activeId != 0 && m_scenes[i].id == activeId) {
+            m_activeSceneIndex = i;
+        }
+        if (editingId != 0 && m_scenes[i].id == editingId) {
+            m_editingSceneIndex = i;
+        }
+    }
+    if (m_editingSceneIndex >= 0 && m_scenes[m_editingSceneIndex].shaderCode != editingCode) {
+        m_shaderState.text = m_scenes[m_editingSceneIndex].shaderCode;
+        m_textEditor.SetText(m_shaderState.text);
+        m_shaderState.status = CompileStatus::Clean;
+    }
+
+    StartProjectCompile();
+    m_undoCapturedGeneration = m_projectEditGeneration;
+}
+
+void ShaderLabIDE::AssignSceneIds() {
+    for (Scene& scene : m_scenes) {
+        if (scene.id == 0) {
+            scene.id = m_nextSceneId++;
+        }
+    }
+}
+
+void ShaderLabIDE::CapturePendingEdits() {
+    if (m_projectEditGeneration == m_undoCapturedGeneration) {
+        return;
+    }
+    AssignSceneIds();
+    m_undoHistory.Push(CaptureSnapshot());
+    m_undoCapturedGeneration = m_projectEditGeneration;
+}
+
+void ShaderLabIDE::UpdateUndoCheckpoint() {
+    // Nothing is captured until something was edited. An edit gesture (drag, typing in a
+    // field) is one undo level, taken once it ends.
+    if (GImGui->ActiveIdHasBeenEditedThisFrame) {
+        NoteProjectEdit();
+    }
+    if (!ImGui::IsAnyItemActive()) {
+        CapturePendingEdits();
+    }
+}
+
+void ShaderLabIDE::UndoProjectEdit() {
+    // Edits since the last checkpoint become their own level first, so they can be redone.
+    CapturePendingEdits();
+    if (const ProjectSnapshot* snapshot = m_undoHistory.Undo()) {
+        ApplySnapshot(*snapshot);
+        AppendDemoLog("[edit] Undo");
+    }
+}
+
+void ShaderLabIDE::RedoProjectEdit() {
+    // Recording pending edits drops the redo tail, as any other new edit would.
+    CapturePendingEdits();
+    if (const ProjectSnapshot* snapshot = m_undoHistory.Redo()) {
+        ApplySnapshot(*snapshot);
+        AppendDemoLog("[edit] Redo");
+    }
+}
+
+ProjectState ShaderLabIDE::CaptureState() {
+    // The snapshot holds no GPU objects, so nothing dangles once the device is gone.
+    ProjectState state;
+    AssignSceneIds();
+    state.project = CaptureSnapshot();
+    m_undoHistory.Push(state.project);
+    m_undoCapturedGeneration = m_projectEditGeneration;
+    state.history = m_undoHistory;
+    state.nextSceneId = m_nextSceneId;
+    state.trackCurrentBeat = m_track.currentBeat;
+    state.trackLastTriggeredBeat = m_track.lastTriggeredBeat;
+    state.transport = m_transport;
+    state.currentMode = m_currentMode;
+    state.shaderState = m_shaderState;
+    state.activeSceneIndex = m_activeSceneIndex;
     return state;
 }
 
 void ShaderLabIDE::RestoreState(const ProjectState& state) {
-    m_scenes = state.scenes;
-    m_audioLibrary = state.audioLibrary;
-    m_track = state.track;
+    m_scenes.clear();
+    m_activeSceneIndex = state.activeSceneIndex;
+    m_editingSceneIndex = state.activeSceneIndex;
+    m_undoHistory = state.history;
+    m_nextSceneId = state.nextSceneId;
+    // Builds every scene fresh (fresh scenes are dirty) and starts the project compile; bytecode
+    // from before the restart is still in the cache, so only the pipelines are rebuilt.
+    ApplySnapshot(state.project);
     m_transport = state.transport;
-    m_aspectRatio =
-        (state.renderAspectRatioPreset == RenderAspectRatioPreset::Ratio_1_1) ? AspectRatio::Ratio_1_1 :
-        (state.renderAspectRatioPreset == RenderAspectRatioPreset::Ratio_16_10) ? AspectRatio::Ratio_16_10 :
-        (state.renderAspectRatioPreset == RenderAspectRatioPreset::Ratio_4_3) ? AspectRatio::Ratio_4_3 :
-        AspectRatio::Ratio_16_9;
-    m_fullscreenRenderResolutionPreset = state.fullscreenRenderResolutionPreset;
-    m_demoTitle = state.demoTitle;
-    m_demoAuthor = state.demoAuthor;
-    m_demoDescription = state.demoDescription;
+    m_track.currentBeat = state.trackCurrentBeat;
+    m_track.lastTriggeredBeat = state.trackLastTriggeredBeat;
     m_currentMode = state.currentMode;
     m_shaderState = state.shaderState;
-    m_activeSceneIndex = state.activeSceneIndex;
-    m_editingSceneIndex = state.activeSceneIndex;
-
-    // Reload files and clear runtime resources (they belong to old device)
-    for (auto& scene : m_scenes) {
-        scene.pipelineState = nullptr;
-        scene.texture = nullptr;
-        scene.srvHeap = nullptr;
-        scene.isDirty = true; // Force compile on next use
-        scene.postFxTextureA = nullptr;
-        scene.postFxTextureB = nullptr;
-        scene.postFxSrvHeap = nullptr;
-        scene.postFxRtvHeap = nullptr;
-        scene.postFxValid = false;
-        for (auto& fx : scene.postFxChain) {
-            fx.pipelineState = nullptr;
-            fx.isDirty = true;
-            fx.historyIndex = 0;
-            fx.historyInitialized = false;
-            fx.historyTextures.clear();
-        }
-
-        for (auto& binding : scene.bindings) {
-            binding.textureResource = nullptr;
-
-            if (binding.bindingType == BindingType::File && !binding.filePath.empty()) {
-                 if (LoadTextureFromFile(binding.filePath, binding.textureResource)) {
-                     binding.fileTextureValid = true;
-                 }
-            }
-        }
-    }
 
     // Restore text editor
     m_textEditor.SetText(m_shaderState.text);
@@ -5,13 +5,15 @@
 #include <cstdio>
 #include <cstdlib>
 #include <filesystem>
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <system_error>
 
 #include "ShaderLab/UI/UIConfig.h"
 #include "ShaderLab/Graphics/Device.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
+#include "ShaderLab/Core/VideoExportPipeline.h"
 
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -21,6 +23,9 @@
 namespace ShaderLab {
 
 namespace {
+constexpr uint32_t kProfilerTraceFrames = 120;
+constexpr const char* kProfilerTracePath = "shaderlab_trace.json";
+
 struct PerformanceOverlayModel {
     const char* modeName = "Demo";
     float fps = 0.0f;
@@ -87,6 +92,45 @@ ImU32 GetVramUsageColor(double vramPercent, const PerformanceOverlayStyle& style
     return style.vramCritical;
 }
 
+// One row per scope depth, bars scaled to the track's span in the last complete frame.
+void DrawProfilerTrack(const FrameProfiler& profiler, ProfileTrack track, std::vector<ProfileFlameBar>& bars) {
+    profiler.BuildFlame(track, bars);
+    const ProfileFrame* frame = profiler.GetLastFrame();
+    double totalMs = 0.0;
+    uint32_t rows = 1;
+    for (const ProfileFlameBar& bar : bars) {
+        if (bar.depth == 0) totalMs += bar.durationMs;
+        rows = (std::max)(rows, bar.depth + 1);
+    }
+    if (track == ProfileTrack::Cpu && frame) {
+        totalMs = frame->cpuDurationUs / 1000.0;
+    }
+    ImGui::Text("%s %.2f ms", track == ProfileTrack::Cpu ? "CPU" : "GPU", totalMs);
+
+    const float rowHeight = ImGui::GetTextLineHeight() + 2.0f;
+    const float width = (std::max)(120.0f, ImGui::GetContentRegionAvail().x);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(ImVec2(width, rowHeight * static_cast<float>(rows)));
+    const bool hovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    for (const ProfileFlameBar& bar : bars) {
+        const ImVec2 min(origin.x + bar.x0 * width, origin.y + static_cast<float>(bar.depth) * rowHeight);
+        const ImVec2 max((std::max)(origin.x + bar.x1 * width, min.x + 1.0f), min.y + rowHeight - 1.0f);
+        const uint32_t hash = (bar.name + 1u) * 2654435761u;
+        drawList->AddRectFilled(min, max, IM_COL32(70 + (hash >> 8) % 120, 70 + (hash >> 16) % 120, 130 + (hash >> 24) % 110, 230));
+        const std::string& name = profiler.GetName(bar.name);
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(255, 255, 255, 255), name.c_str());
+        drawList->PopClipRect();
+        if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+            const ProfileScopeStats& stats = profiler.GetStats()[bar.stat];
+            ImGui::SetTooltip("%s\nlast %.3f ms\navg %.3f ms  p95 %.3f ms  max %.3f ms (%u frames)",
+                              name.c_str(), stats.lastMs, stats.avgMs, stats.p95Ms, stats.maxMs, stats.samples);
+        }
+    }
+}
+
 void DrawPerformanceOverlay(ImDrawList* drawList,
                             const ImVec2& overlayPos,
                             const PerformanceOverlayModel& model,
@@ -114,7 +158,7 @@ void DrawPerformanceOverlay(ImDrawList* drawList,
                   model.vramBudgetGB,
                   model.vramPercent);
     std::snprintf(line5, sizeof(line5), "Compute: %d active", model.activeCompute);
-    std::snprintf(line6, sizeof(line6), "Alt+D stats | Alt+V vsync");
+    std::snprintf(line6, sizeof(line6), "Alt+D stats | Alt+V vsync | Alt+P profiler");
 
     const float lineHeight = ImGui::GetTextLineHeightWithSpacing();
     const int lineCount = model.showComputeLine ? 7 : 6;
@@ -229,10 +273,30 @@ std::string FormatScreenKeyEntry(ImGuiKey key, const ImGuiIO& io) {
 }
 
 void ShaderLabIDE::BeginFrame() {
+    // The app waits for the GPU before every frame, so all earlier frames have finished.
+    const int64_t completedFrameIndex = static_cast<int64_t>(m_gpuFrameIndex) - 1;
+    if (m_descriptorRing) {
+        m_descriptorRing->BeginFrame(m_gpuFrameIndex, completedFrameIndex);
+    }
+    if (m_profiler) {
+        m_profiler->BeginFrame(m_gpuFrameIndex, completedFrameIndex);
+        if (m_profilerTracePending && !m_profiler->GetProfiler().IsCapturing()) {
+            m_profilerTracePending = false;
+            std::string traceError;
+            m_profilerTraceStatus = m_profiler->GetProfiler().WriteChromeTrace(kProfilerTracePath, traceError)
+                ? std::string("Trace written to ") + kProfilerTracePath
+                : traceError;
+        }
+        m_profiler->GetProfiler().BeginCpuScope("build ui");
+    }
     ImGui_ImplDX12_NewFrame();
     ImGui_ImplWin32_NewFrame();
     ImGui::NewFrame();
 
+    UpdateLinkedShaders();
+    ApplyCompletedCompiles();
+    UpdateTextureUploads();
+    UpdateShaderThumbnails();
     UpdatePreviewVideoExportBeginFrame();
 
     m_aboutTimeSeconds = ImGui::GetTime();
@@ -252,6 +316,9 @@ void ShaderLabIDE::BeginFrame() {
     if (altDown && !ctrlDown && !shiftDown && !io.KeySuper && ImGui::IsKeyPressed(ImGuiKey_F, false)) {
         m_previewFullscreen = !m_previewFullscreen;
     }
+    if (altDown && !ctrlDown && !shiftDown && !io.KeySuper && ImGui::IsKeyPressed(ImGuiKey_P, false)) {
+        m_profilerWindowOpen = !m_profilerWindowOpen;
+    }
     if (altDown && ImGui::IsKeyPressed(ImGuiKey_V, false)) {
         m_previewVsyncEnabled = !m_previewVsyncEnabled;
     }
@@ -261,6 +328,13 @@ void ShaderLabIDE::BeginFrame() {
     if (ctrlDown && !altDown && !io.KeySuper && ImGui::IsKeyPressed(ImGuiKey_S, false)) {
         SaveProject();
     }
+    if (ctrlDown && !altDown && !io.KeySuper && !m_shaderEditorFocused && !io.WantTextInput) {
+        if (ImGui::IsKeyPressed(ImGuiKey_Z) && !shiftDown) {
+            UndoProjectEdit();
+        } else if (ImGui::IsKeyPressed(ImGuiKey_Y) || (ImGui::IsKeyPressed(ImGuiKey_Z) && shiftDown)) {
+            RedoProjectEdit();
+        }
+    }
     if (ctrlDown && shiftDown && ImGui::IsKeyPressed(ImGuiKey_K, false)) {
         m_screenKeysOverlayEnabled = !m_screenKeysOverlayEnabled;
     }
@@ -510,6 +584,27 @@ void ShaderLabIDE::BeginFrame() {
         }
     }
 
+    if (m_profilerWindowOpen && m_profiler) {
+        ImGui::SetNextWindowSize(ImVec2(460.0f, 0.0f), ImGuiCond_FirstUseEver);
+        if (ImGui::Begin("Frame Profiler (Alt+P)", &m_profilerWindowOpen)) {
+            const FrameProfiler& profiler = m_profiler->GetProfiler();
+            DrawProfilerTrack(profiler, ProfileTrack::Cpu, m_profilerFlameBars);
+            if (m_profiler->IsInitialized()) {
+                DrawProfilerTrack(profiler, ProfileTrack::Gpu, m_profilerFlameBars);
+            }
+            if (m_profilerTracePending) {
+                ImGui::Text("Capturing trace: %u / %u frames", profiler.GetCapturedFrameCount(), kProfilerTraceFrames);
+            } else if (ImGui::Button("Capture trace")) {
+                m_profiler->GetProfiler().BeginCapture(kProfilerTraceFrames);
+                m_profilerTracePending = true;
+            }
+            if (!m_profilerTraceStatus.empty()) {
+                ImGui::TextUnformatted(m_profilerTraceStatus.c_str());
+            }
+        }
+        ImGui::End();
+    }
+
     if (m_modeChangeFlashSeconds > 0.0f) {
         m_modeChangeFlashSeconds = (std::max)(0.0f, m_modeChangeFlashSeconds - ImGui::GetIO().DeltaTime);
         float t = (kModeFlashDuration > 0.0f) ? (m_modeChangeFlashSeconds / kModeFlashDuration) : 0.0f;
@@ -530,10 +625,14 @@ void ShaderLabIDE::BeginFrame() {
     }
 
     UpdateBuildLogic();
+    UpdateUndoCheckpoint();
 }
 
 void ShaderLabIDE::EndFrame() {
     ImGui::Render();
+    if (m_profiler) {
+        m_profiler->GetProfiler().EndCpuScope();
+    }
 }
 
 bool ShaderLabIDE::StartPreviewVideoExport(const std::string& outputPath, uint32_t width, uint32_t height, uint32_t fps) {
@@ -561,30 +660,36 @@ bool ShaderLabIDE::StartPreviewVideoExport(const std::string& outputPath, uint32
 
     m_previewVideoExportTotalFrames = (std::max)(uint64_t(1), static_cast<uint64_t>(std::ceil(durationSeconds * static_cast<double>(fps))));
     m_previewVideoExportCapturedFrames = 0;
-    m_previewVideoExportPendingFrameIndex = -1;
     m_previewVideoExportPendingReadback = false;
     m_previewVideoExportWidth = width;
     m_previewVideoExportHeight = height;
     m_previewVideoExportFps = fps;
     m_previewVideoExportOutputPath = outputPath;
-    m_previewVideoExportReadbackBuffer.Reset();
-    m_previewVideoExportReadbackRowPitch = 0;
-    m_previewVideoExportReadbackBytes = 0;
 
-    char tempPath[MAX_PATH] = {};
-    DWORD tempLen = GetTempPathA(MAX_PATH, tempPath);
-    std::filesystem::path baseDir = (tempLen > 0 && tempLen < MAX_PATH)
-        ? std::filesystem::path(tempPath)
-        : std::filesystem::temp_directory_path();
-    const auto stamp = static_cast<unsigned long long>(GetTickCount64());
-    std::filesystem::path framesDir = baseDir / ("shaderlab_preview_export_" + std::to_string(stamp));
-    std::error_code ec;
-    std::filesystem::create_directories(framesDir, ec);
-    if (ec) {
-        m_previewVideoExportStatus = "Failed to create temporary export folder.";
+    // Frames stream straight into ffmpeg; without it they become lossless QOI images next to
+    // the requested output.
+    VideoFrameFormat format;
+    format.width = width;
+    format.height = height;
+    format.fps = fps;
+    std::unique_ptr<IVideoFrameSink> sink;
+    if (EncoderPipeSink::ProbeEncoder("ffmpeg")) {
+        sink = std::make_unique<EncoderPipeSink>(EncoderPipeSink::FfmpegCommand("ffmpeg", format, outputPath));
+    } else {
+        std::filesystem::path framesDir(outputPath);
+        framesDir.replace_extension();
+        framesDir += "_frames";
+        m_previewVideoExportOutputPath = framesDir.string();
+        sink = std::make_unique<QoiSequenceSink>(m_previewVideoExportOutputPath);
+        AppendDemoLog("[export] ffmpeg not found on PATH, writing QOI frames to " + m_previewVideoExportOutputPath);
+    }
+    m_previewVideoExport = std::make_unique<VideoExportPipeline>(std::move(sink), kPreviewVideoExportRingSize);
+    std::string startError;
+    if (!m_previewVideoExport->Start(format, startError)) {
+        m_previewVideoExport.reset();
+        m_previewVideoExportStatus = "Failed to start export: " + startError;
         return false;
     }
-    m_previewVideoExportFramesDir = framesDir.string();
 
     m_previewVideoExportSavedTransport = m_transport;
     StopAudioAndClearMusicState();
@@ -606,33 +711,52 @@ bool ShaderLabIDE::StartPreviewVideoExport(const std::string& outputPath, uint32
 }
 
 void ShaderLabIDE::CancelPreviewVideoExport(bool restoreTransportState) {
+    const bool wasRunning = m_previewVideoExport != nullptr;
     m_previewVideoExportActive = false;
     m_previewVideoExportEncoding = false;
     m_previewVideoExportPendingReadback = false;
-    m_previewVideoExportPendingFrameIndex = -1;
-    m_previewVideoExportReadbackBuffer.Reset();
-    m_previewVideoExportReadbackRowPitch = 0;
-    m_previewVideoExportReadbackBytes = 0;
+    m_previewVideoExport.reset(); // Stops the worker and the encoder
+    ReleasePreviewVideoExportRing();
 
-    if (restoreTransportState) {
+    if (restoreTransportState && wasRunning) {
         m_transport = m_previewVideoExportSavedTransport;
     }
 }
 
+void ShaderLabIDE::ReleasePreviewVideoExportRing() {
+    for (size_t i = 0; i < kPreviewVideoExportRingSize; ++i) {
+        if (m_previewVideoExportReadback[i] && m_previewVideoExportMapped[i]) {
+            m_previewVideoExportReadback[i]->Unmap(0, nullptr);
+        }
+        m_previewVideoExportReadback[i].Reset();
+        m_previewVideoExportMapped[i] = nullptr;
+    }
+    m_previewVideoExportReadbackRowPitch = 0;
+    m_previewVideoExportReadbackBytes = 0;
+}
+
 void ShaderLabIDE::UpdatePreviewVideoExportBeginFrame() {
     if (!m_previewVideoExportActive) {
         return;
     }
 
+    if (!m_previewVideoExport || m_previewVideoExport->HasFailed()) {
+        m_previewVideoExportStatus = "Preview export failed: " +
+            (m_previewVideoExport ? m_previewVideoExport->GetError() : std::string("export worker missing."));
+        CancelPreviewVideoExport(true);
+        return;
+    }
+
     if (m_previewVideoExportPendingReadback) {
-        if (!WritePreviewCaptureFrameToDisk()) {
-            m_previewVideoExportStatus = "Failed while writing exported frame to disk.";
+        // The copy finished with last frame's GPU wait. The worker reads the mapped slot directly.
+        const size_t slot = static_cast<size_t>(m_previewVideoExportCapturedFrames % kPreviewVideoExportRingSize);
+        if (!m_previewVideoExport->Submit(m_previewVideoExportMapped[slot], m_previewVideoExportReadbackRowPitch)) {
+            m_previewVideoExportStatus = "Preview export failed: could not queue frame.";
             CancelPreviewVideoExport(true);
             return;
         }
 
         m_previewVideoExportPendingReadback = false;
-        m_previewVideoExportPendingFrameIndex = -1;
         ++m_previewVideoExportCapturedFrames;
 
         if (m_previewVideoExportCapturedFrames >= m_previewVideoExportTotalFrames) {
@@ -649,109 +773,39 @@ void ShaderLabIDE::UpdatePreviewVideoExportBeginFrame() {
 
     std::ostringstream status;
     status << "Exporting preview video: " << m_previewVideoExportCapturedFrames
-           << "/" << m_previewVideoExportTotalFrames << " frames";
+           << "/" << m_previewVideoExportTotalFrames << " frames ("
+           << m_previewVideoExport->GetConsumedCount() << " encoded)";
     m_previewVideoExportStatus = status.str();
 }
 
-bool ShaderLabIDE::WritePreviewCaptureFrameToDisk() {
-    if (!m_previewVideoExportReadbackBuffer || m_previewVideoExportPendingFrameIndex < 0) {
-        return false;
-    }
-
-    if (m_previewVideoExportReadbackBytes == 0 || m_previewVideoExportReadbackRowPitch == 0) {
-        return false;
-    }
-
-    uint8_t* mapped = nullptr;
-    D3D12_RANGE readRange = { 0, static_cast<SIZE_T>(m_previewVideoExportReadbackBytes) };
-    if (FAILED(m_previewVideoExportReadbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped))) || !mapped) {
-        return false;
-    }
-
-    char fileName[64] = {};
-    std::snprintf(fileName, sizeof(fileName), "frame_%05lld.ppm", static_cast<long long>(m_previewVideoExportPendingFrameIndex));
-    std::filesystem::path framePath = std::filesystem::path(m_previewVideoExportFramesDir) / fileName;
-
-    std::ofstream out(framePath, std::ios::binary | std::ios::trunc);
-    if (!out.is_open()) {
-        m_previewVideoExportReadbackBuffer->Unmap(0, nullptr);
-        return false;
-    }
-
-    out << "P6\n" << m_previewVideoExportWidth << " " << m_previewVideoExportHeight << "\n255\n";
-    for (uint32_t y = 0; y < m_previewVideoExportHeight; ++y) {
-        const uint8_t* srcRow = mapped + static_cast<size_t>(y) * static_cast<size_t>(m_previewVideoExportReadbackRowPitch);
-        for (uint32_t x = 0; x < m_previewVideoExportWidth; ++x) {
-            const uint8_t* pixel = srcRow + static_cast<size_t>(x) * 4u;
-            out.put(static_cast<char>(pixel[0]));
-            out.put(static_cast<char>(pixel[1]));
-            out.put(static_cast<char>(pixel[2]));
-        }
-    }
-
-    m_previewVideoExportReadbackBuffer->Unmap(0, nullptr);
-    return out.good();
-}
-
 void ShaderLabIDE::FinalizePreviewVideoExport() {
-    if (!m_previewVideoExportActive) {
+    if (!m_previewVideoExportActive || !m_previewVideoExport) {
         return;
     }
 
     m_previewVideoExportActive = false;
     m_previewVideoExportEncoding = true;
 
+    // At most a ring's worth of frames is still queued; closing the pipe lets ffmpeg finish the file.
     std::string message;
-    const std::string inputPattern = (std::filesystem::path(m_previewVideoExportFramesDir) / "frame_%05d.ppm").string();
-    const bool ok = RunFfmpegEncode(inputPattern, m_previewVideoExportOutputPath, m_previewVideoExportFps, message);
+    const bool ok = m_previewVideoExport->Finish(message);
+    const VideoExportStats stats = m_previewVideoExport->GetStats();
+    m_previewVideoExport.reset();
+    ReleasePreviewVideoExportRing();
 
     m_transport = m_previewVideoExportSavedTransport;
     m_previewVideoExportEncoding = false;
     m_previewVideoExportPendingReadback = false;
-    m_previewVideoExportPendingFrameIndex = -1;
-    m_previewVideoExportReadbackBuffer.Reset();
-    m_previewVideoExportReadbackRowPitch = 0;
-    m_previewVideoExportReadbackBytes = 0;
 
     if (ok) {
         m_previewVideoExportStatus = "Preview export complete: " + m_previewVideoExportOutputPath;
+        std::ostringstream log;
+        log << "[export] " << stats.framesWritten << " frames, convert " << static_cast<int>(stats.convertMs)
+            << " ms, encode/write " << static_cast<int>(stats.writeMs) << " ms on the export worker";
+        AppendDemoLog(log.str());
     } else {
         m_previewVideoExportStatus = "Preview export failed: " + message;
     }
 }
 
-bool ShaderLabIDE::RunFfmpegEncode(const std::string& inputPattern,
-                                   const std::string& outputPath,
-                                   uint32_t fps,
-                                   std::string& outMessage) {
-    std::ostringstream cmd;
-    cmd << "cmd.exe /C ffmpeg -y -framerate " << fps
-        << " -i \"" << inputPattern << "\""
-        << " -c:v libx264 -pix_fmt yuv420p \"" << outputPath << "\"";
-
-    STARTUPINFOA si = {};
-    si.cb = sizeof(si);
-    PROCESS_INFORMATION pi = {};
-
-    std::string commandLine = cmd.str();
-    if (!CreateProcessA(nullptr, commandLine.data(), nullptr, nullptr, FALSE, CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi)) {
-        outMessage = "Could not launch ffmpeg. Ensure ffmpeg is installed and available on PATH.";
-        return false;
-    }
-
-    WaitForSingleObject(pi.hProcess, INFINITE);
-    DWORD exitCode = 1;
-    GetExitCodeProcess(pi.hProcess, &exitCode);
-    CloseHandle(pi.hThread);
-    CloseHandle(pi.hProcess);
-
-    if (exitCode != 0) {
-        outMessage = "ffmpeg exited with code " + std::to_string(exitCode) + ".";
-        return false;
-    }
-
-    outMessage = "ok";
-    return true;
-}
-
 } // namespace ShaderLab
@@ -1,8 +1,10 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/Core/CompilationService.h"
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/Dx12ResourceService.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
 
 #include <algorithm>
 #include <cstring>
@@ -26,6 +28,7 @@ struct ComputeDispatchParams {
     float invWidth;
     float invHeight;
     uint32_t frame;
+    uint32_t historyFrames;
 };
 
 struct UiComputeSceneResources {
@@ -195,8 +198,6 @@ bool EnsureUiComputeDispatchResources(Device* deviceRef) {
 
 bool ShaderLabIDE::CompileComputePipeline(Scene::ComputeEffect& effect) {
     if (!m_compilationService || !m_deviceRef) return false;
-    if (!EnsureUiComputeRootSignature(m_deviceRef)) return false;
-    ID3D12Device* device = m_deviceRef->GetDevice();
 
     const std::string entryPoint = effect.entryPoint.empty() ? "main" : effect.entryPoint;
     const ShaderCompileResult compileResult = m_compilationService->CompileFromSource(
@@ -206,6 +207,13 @@ bool ShaderLabIDE::CompileComputePipeline(Scene::ComputeEffect& effect) {
         L"compute.hlsl",
         ShaderCompileMode::Build,
         {});
+    return CreateComputePipelineFromBytecode(effect, compileResult);
+}
+
+bool ShaderLabIDE::CreateComputePipelineFromBytecode(Scene::ComputeEffect& effect, const ShaderCompileResult& compileResult) {
+    if (!m_deviceRef) return false;
+    if (!EnsureUiComputeRootSignature(m_deviceRef)) return false;
+    ID3D12Device* device = m_deviceRef->GetDevice();
 
     if (!compileResult.success) {
         effect.pipelineState.Reset();
@@ -338,6 +346,12 @@ ID3D12Resource* ShaderLabIDE::ApplyComputeEffectChain(ID3D12GraphicsCommandList*
             fx.historyTextures.clear();
         }
         if (fx.isDirty || !fx.pipelineState) {
+            // A scene chain effect in the project compile batch gets its pipeline when the batch delivers it.
+            const bool sceneChain = sceneIndex >= 0 && sceneIndex < static_cast<int>(m_scenes.size()) &&
+                                    &chain == &m_scenes[sceneIndex].computeEffectChain;
+            if (sceneChain && IsCompilePending(CompileTargetKind::Compute, sceneIndex, static_cast<int>(&fx - chain.data()))) {
+                continue;
+            }
             if (!CompileComputePipeline(fx)) {
                 continue;
             }
@@ -401,6 +415,8 @@ ID3D12Resource* ShaderLabIDE::ApplyComputeEffectChain(ID3D12GraphicsCommandList*
         params.invWidth = width > 0 ? 1.0f / static_cast<float>(width) : 0.0f;
         params.invHeight = height > 0 ? 1.0f / static_cast<float>(height) : 0.0f;
         params.frame = static_cast<uint32_t>(m_transport.timeSeconds * 60.0);
+        // The editor still copies outputs into history, so every slot is valid once one frame ran.
+        params.historyFrames = fx.historyInitialized ? static_cast<uint32_t>(fx.historyTextures.size()) : 0u;
         std::memcpy(g_uiComputeParamsMapped, &params, sizeof(params));
 
         D3D12_CONSTANT_BUFFER_VIEW_DESC cbvDesc = {};
@@ -410,6 +426,7 @@ ID3D12Resource* ShaderLabIDE::ApplyComputeEffectChain(ID3D12GraphicsCommandList*
         cbvCpu.ptr += static_cast<SIZE_T>(step) * 10;
         device->CreateConstantBufferView(&cbvDesc, cbvCpu);
 
+        ScopedGpuProfile fxScope(m_profiler.get(), commandList, fx.name.empty() ? "compute" : fx.name.c_str());
         D3D12_RESOURCE_BARRIER beginBarriers[2] = {};
         beginBarriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         beginBarriers[0].Transition.pResource = currentInput;
@@ -3,8 +3,10 @@
 
 #include "ShaderLab/Core/CompilationService.h"
 #include "ShaderLab/Graphics/Device.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
 #include "ShaderLab/Graphics/Dx12ResourceService.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
 
 #include <algorithm>
 #include <cmath>
@@ -62,7 +64,6 @@ void ShaderLabIDE::EnsurePostFxResources(Scene& scene, uint32_t width, uint32_t
 
     scene.postFxTextureA.Reset();
     scene.postFxTextureB.Reset();
-    scene.postFxSrvHeap.Reset();
     scene.postFxRtvHeap.Reset();
     scene.postFxValid = false;
 
@@ -82,12 +83,6 @@ void ShaderLabIDE::EnsurePostFxResources(Scene& scene, uint32_t width, uint32_t
         return;
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.NumDescriptors = 8 * kMaxPostFxChain;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    m_deviceRef->GetDevice()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&scene.postFxSrvHeap));
-
     D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
     rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
     rtvHeapDesc.NumDescriptors = 1;
@@ -107,7 +102,6 @@ void ShaderLabIDE::EnsurePostFxPreviewResources(uint32_t width, uint32_t height)
 
     m_postFxPreviewTextureA.Reset();
     m_postFxPreviewTextureB.Reset();
-    m_postFxPreviewSrvHeap.Reset();
     m_postFxPreviewRtvHeap.Reset();
 
     Dx12ResourceService resourceService(m_deviceRef->GetDevice());
@@ -126,12 +120,6 @@ void ShaderLabIDE::EnsurePostFxPreviewResources(uint32_t width, uint32_t height)
         return;
     }
 
-    D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
-    heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    heapDesc.NumDescriptors = 8 * kMaxPostFxChain;
-    heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-    m_deviceRef->GetDevice()->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_postFxPreviewSrvHeap));
-
     D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
     rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
     rtvHeapDesc.NumDescriptors = 1;
@@ -187,6 +175,14 @@ bool ShaderLabIDE::CompilePostFxEffect(Scene::PostFXEffect& effect, std::vector<
         "main",
         L"postfx.hlsl",
         ShaderCompileMode::Live);
+    return ApplyPostFxCompileResult(effect, compileResult, outErrors);
+}
+
+bool ShaderLabIDE::ApplyPostFxCompileResult(Scene::PostFXEffect& effect,
+                                            const ShaderCompileResult& compileResult,
+                                            std::vector<std::string>& outErrors) {
+    outErrors.clear();
+    if (!m_previewRenderer) return false;
 
     for (const auto& diagnostic : compileResult.diagnostics) {
         outErrors.push_back(diagnostic.message);
@@ -230,65 +226,21 @@ ID3D12Resource* ShaderLabIDE::ApplyPostFxChain(ID3D12GraphicsCommandList* comman
 
     ID3D12Resource* ping = nullptr;
     ID3D12Resource* pong = nullptr;
-    ID3D12DescriptorHeap* srvHeap = nullptr;
     ID3D12DescriptorHeap* rtvHeap = nullptr;
 
     if (usePreviewResources) {
         EnsurePostFxPreviewResources(width, height);
         ping = m_postFxPreviewTextureA.Get();
         pong = m_postFxPreviewTextureB.Get();
-        srvHeap = m_postFxPreviewSrvHeap.Get();
         rtvHeap = m_postFxPreviewRtvHeap.Get();
     } else {
         EnsurePostFxResources(scene, width, height);
         ping = scene.postFxTextureA.Get();
         pong = scene.postFxTextureB.Get();
-        srvHeap = scene.postFxSrvHeap.Get();
         rtvHeap = scene.postFxRtvHeap.Get();
     }
 
-    if (!ping || !pong || !srvHeap || !rtvHeap) return inputTexture;
-
-    auto device = m_deviceRef->GetDevice();
-    auto handleStep = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    auto startHandle = srvHeap->GetCPUDescriptorHandleForHeapStart();
-
-    auto bindInput = [&](ID3D12Resource* src, Scene::PostFXEffect& fx, int baseSlot) {
-        D3D12_CPU_DESCRIPTOR_HANDLE dest = startHandle;
-        dest.ptr += baseSlot * handleStep;
-        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-        srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-        srvDesc.Texture2D.MipLevels = 1;
-        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        device->CreateShaderResourceView(src, &srvDesc, dest);
-
-        for (int i = 1; i <= kPostFxHistoryCount; ++i) {
-            int historySlot = i;
-            int historyIndex = fx.historyIndex - (i - 1);
-            while (historyIndex < 0) historyIndex += kPostFxHistoryCount;
-            ID3D12Resource* historyRes = nullptr;
-            if (!fx.historyTextures.empty()) {
-                historyRes = fx.historyTextures[historyIndex].Get();
-            }
-
-            D3D12_CPU_DESCRIPTOR_HANDLE histDest = startHandle;
-            histDest.ptr += (baseSlot + historySlot) * handleStep;
-            if (historyRes) {
-                device->CreateShaderResourceView(historyRes, &srvDesc, histDest);
-            } else if (m_dummySrvHeap) {
-                device->CopyDescriptorsSimple(1, histDest, m_dummySrvHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-            }
-        }
-
-        for (int i = kPostFxHistoryCount + 1; i < 8; ++i) {
-            D3D12_CPU_DESCRIPTOR_HANDLE dummyDest = startHandle;
-            dummyDest.ptr += (baseSlot + i) * handleStep;
-            if (m_dummySrvHeap) {
-                device->CopyDescriptorsSimple(1, dummyDest, m_dummySrvHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-            }
-        }
-    };
+    if (!ping || !pong || !rtvHeap || !m_descriptorRing) return inputTexture;
 
     ID3D12Resource* currentInput = inputTexture;
     ID3D12Resource* currentOutput = ping;
@@ -328,6 +280,7 @@ ID3D12Resource* ShaderLabIDE::ApplyPostFxChain(ID3D12GraphicsCommandList* comman
             fx.historyIndex = 0;
         }
 
+        ScopedGpuProfile fxScope(m_profiler.get(), commandList, fx.name.empty() ? "post-fx" : fx.name.c_str());
         D3D12_RESOURCE_BARRIER barrier = {};
         barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         barrier.Transition.pResource = currentOutput;
@@ -336,16 +289,25 @@ ID3D12Resource* ShaderLabIDE::ApplyPostFxChain(ID3D12GraphicsCommandList* comman
         barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
         commandList->ResourceBarrier(1, &barrier);
 
-        int baseSlot = passIndex * 8;
-        bindInput(currentInput, fx, baseSlot);
-        ID3D12DescriptorHeap* heaps[] = { srvHeap };
-        commandList->SetDescriptorHeaps(1, heaps);
+        // Slot 0 is the pass input, 1..N the effect's history (newest first), the rest the dummy texture.
+        D3D12_CPU_DESCRIPTOR_HANDLE sources[8] = {};
+        bool sourcesReady = m_descriptorRing->GetTexture2DSrv(currentInput, DXGI_FORMAT_R8G8B8A8_UNORM, sources[0]);
+        for (int i = 1; i < 8 && sourcesReady; ++i) {
+            ID3D12Resource* historyRes = m_dummyTexture.Get();
+            if (i <= kPostFxHistoryCount) {
+                historyRes = fx.historyTextures[(fx.historyIndex - (i - 1) + kPostFxHistoryCount) % kPostFxHistoryCount].Get();
+            }
+            sourcesReady = m_descriptorRing->GetTexture2DSrv(historyRes, DXGI_FORMAT_R8G8B8A8_UNORM, sources[i]);
+        }
+        D3D12_GPU_DESCRIPTOR_HANDLE srvGpu = {};
+        if (sourcesReady && m_descriptorRing->AllocateTable(sources, 8, srvGpu)) {
+            ID3D12DescriptorHeap* heaps[] = { m_descriptorRing->GetHeap() };
+            commandList->SetDescriptorHeaps(1, heaps);
+        }
 
         D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = rtvHeap->GetCPUDescriptorHandleForHeapStart();
         m_deviceRef->GetDevice()->CreateRenderTargetView(currentOutput, nullptr, rtvHandle);
 
-        D3D12_GPU_DESCRIPTOR_HANDLE srvGpu = srvHeap->GetGPUDescriptorHandleForHeapStart();
-        srvGpu.ptr += baseSlot * handleStep;
         float iBeat = 0.0f;
         float iBar = 0.0f;
         float fBeat = 0.0f;
@@ -365,7 +327,8 @@ ID3D12Resource* ShaderLabIDE::ApplyPostFxChain(ID3D12GraphicsCommandList* comman
             iBar,
             fBarBeat16,
             fBeat,
-            fBarBeat);
+            fBarBeat,
+            static_cast<uint32_t>(kPostFxHistoryCount)); // History is seeded from the input on first use
 
         std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
         commandList->ResourceBarrier(1, &barrier);
@@ -4,6 +4,7 @@
 
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Core/VideoExportPipeline.h"
 
 #include <algorithm>
 #include <cmath>
@@ -132,25 +133,22 @@ bool ShaderLabIDE::RenderPreviewTexture(ID3D12GraphicsCommandList* commandList)
         return true;
     }
 
-    if (m_transitionActive && m_currentMode != UIMode::Scene) {
+    if (m_sequencer.GetState().transitionActive && m_currentMode != UIMode::Scene) {
+        const SequencerState& transition = m_sequencer.GetState();
         float beatsPerSec = m_transport.bpm / 60.0f;
         double exactBeat = m_transport.timeSeconds * beatsPerSec;
-        double progress = (exactBeat - m_transitionStartBeat) / m_transitionDurationBeats;
+        double progress = (exactBeat - transition.transitionStartBeat) / transition.transitionDurationBeats;
 
         const bool isPlaying = (m_transport.state == TransportState::Playing);
         if (isPlaying && progress >= 1.0) {
-            m_transitionActive = false;
-            if (m_pendingActiveScene != -2) {
-                SetActiveScene(m_pendingActiveScene);
-                m_activeSceneStartBeat = m_transitionToStartBeat;
-                m_activeSceneOffset = (m_pendingActiveScene >= 0) ? m_transitionToOffset : 0.0f;
-                m_pendingActiveScene = -2;
+            if (m_sequencer.CompleteDueTransition(exactBeat, -1)) {
+                SetActiveScene(transition.activeSceneIndex);
             }
         } else {
             if (progress < 0.0) progress = 0.0;
             if (progress > 1.0) progress = 1.0;
 
-            const std::string effectiveStem = m_currentTransitionStem;
+            const std::string effectiveStem = transition.transitionPresetStem;
 
             if (!m_transitionPSO || m_compiledTransitionStem != effectiveStem) {
                 std::vector<PreviewRenderer::TextureDecl> decls = {
@@ -164,24 +162,26 @@ bool ShaderLabIDE::RenderPreviewTexture(ID3D12GraphicsCommandList* commandList)
 
             bool validIndices = true;
 
-            if (m_transitionFromIndex < 0 || m_transitionFromIndex >= static_cast<int>(m_scenes.size())) m_transitionFromIndex = -1;
-            if (m_transitionToIndex < 0 || m_transitionToIndex >= static_cast<int>(m_scenes.size())) m_transitionToIndex = -1;
+            int fromIndex = transition.transitionFromIndex;
+            int toIndex = transition.transitionToIndex;
+            if (fromIndex < 0 || fromIndex >= static_cast<int>(m_scenes.size())) fromIndex = -1;
+            if (toIndex < 0 || toIndex >= static_cast<int>(m_scenes.size())) toIndex = -1;
 
             if (m_transitionPSO && validIndices) {
                 ID3D12Resource* fromTex = nullptr;
                 ID3D12Resource* toTex = nullptr;
-                const double fromTime = SceneTimeSeconds(exactBeat, m_transitionFromStartBeat, m_transitionFromOffset, m_transport.bpm);
-                const double toTime = SceneTimeSeconds(exactBeat, m_transitionToStartBeat, m_transitionToOffset, m_transport.bpm);
-                if (m_transitionFromIndex != -1) {
+                const double fromTime = SceneTimeSeconds(exactBeat, transition.transitionFromStartBeat, transition.transitionFromOffset, m_transport.bpm);
+                const double toTime = SceneTimeSeconds(exactBeat, transition.transitionToStartBeat, transition.transitionToOffset, m_transport.bpm);
+                if (fromIndex != -1) {
                     fromTex = GetSceneFinalTexture(commandList,
-                                                   m_transitionFromIndex,
+                                                   fromIndex,
                                                    m_previewTextureWidth,
                                                    m_previewTextureHeight,
                                                    fromTime);
                 }
-                if (m_transitionToIndex != -1) {
+                if (toIndex != -1) {
                     toTex = GetSceneFinalTexture(commandList,
-                                                 m_transitionToIndex,
+                                                 toIndex,
                                                  m_previewTextureWidth,
                                                  m_previewTextureHeight,
                                                  toTime);
@@ -276,7 +276,8 @@ bool ShaderLabIDE::RenderPreviewTexture(ID3D12GraphicsCommandList* commandList)
 
     const double beatsPerSec = m_transport.bpm / 60.0f;
     const double exactBeat = m_transport.timeSeconds * beatsPerSec;
-    const double activeTime = SceneTimeSeconds(exactBeat, m_activeSceneStartBeat, m_activeSceneOffset, m_transport.bpm);
+    const SequencerState& sequencerState = m_sequencer.GetState();
+    const double activeTime = SceneTimeSeconds(exactBeat, sequencerState.activeSceneStartBeat, sequencerState.activeSceneOffset, m_transport.bpm);
     ID3D12Resource* finalTex = GetSceneFinalTexture(commandList,
                                                     m_activeSceneIndex,
                                                     m_previewTextureWidth,
@@ -322,6 +323,12 @@ void ShaderLabIDE::QueuePreviewVideoCapture(ID3D12GraphicsCommandList* commandLi
     if (!commandList || !m_deviceRef || !m_previewTexture || m_previewTextureWidth == 0 || m_previewTextureHeight == 0) {
         return;
     }
+    // With every slot still queued for the worker the frame is simply rendered again next time;
+    // the export clock only advances once a copy is queued.
+    if (!m_previewVideoExport || !m_previewVideoExport->CanSubmit()) {
+        return;
+    }
+    const size_t slot = static_cast<size_t>(m_previewVideoExportCapturedFrames % kPreviewVideoExportRingSize);
 
     auto* device = m_deviceRef->GetDevice();
     D3D12_RESOURCE_DESC srcDesc = m_previewTexture->GetDesc();
@@ -332,9 +339,11 @@ void ShaderLabIDE::QueuePreviewVideoCapture(ID3D12GraphicsCommandList* commandLi
     UINT64 totalBytes = 0;
     device->GetCopyableFootprints(&srcDesc, 0, 1, 0, &footprint, &numRows, &rowSizeInBytes, &totalBytes);
 
-    if (!m_previewVideoExportReadbackBuffer || m_previewVideoExportReadbackBytes != totalBytes ||
-        m_previewVideoExportReadbackRowPitch != footprint.Footprint.RowPitch) {
-        m_previewVideoExportReadbackBuffer.Reset();
+    if (m_previewVideoExportReadbackBytes != totalBytes || m_previewVideoExportReadbackRowPitch != footprint.Footprint.RowPitch) {
+        if (m_previewVideoExport->GetConsumedCount() != m_previewVideoExport->GetSubmittedCount()) {
+            return; // Slots are still being read
+        }
+        ReleasePreviewVideoExportRing();
 
         D3D12_HEAP_PROPERTIES heapProps = {};
         heapProps.Type = D3D12_HEAP_TYPE_READBACK;
@@ -348,15 +357,21 @@ void ShaderLabIDE::QueuePreviewVideoCapture(ID3D12GraphicsCommandList* commandLi
         bufferDesc.SampleDesc.Count = 1;
         bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 
-        if (FAILED(device->CreateCommittedResource(&heapProps,
-                                                   D3D12_HEAP_FLAG_NONE,
-                                                   &bufferDesc,
-                                                   D3D12_RESOURCE_STATE_COPY_DEST,
-                                                   nullptr,
-                                                   IID_PPV_ARGS(m_previewVideoExportReadbackBuffer.ReleaseAndGetAddressOf())))) {
-            m_previewVideoExportStatus = "Failed to allocate export readback buffer.";
-            CancelPreviewVideoExport(true);
-            return;
+        for (size_t i = 0; i < kPreviewVideoExportRingSize; ++i) {
+            // Readback buffers may stay mapped; the CPU only reads a slot after its copy completed.
+            void* mapped = nullptr;
+            if (FAILED(device->CreateCommittedResource(&heapProps,
+                                                       D3D12_HEAP_FLAG_NONE,
+                                                       &bufferDesc,
+                                                       D3D12_RESOURCE_STATE_COPY_DEST,
+                                                       nullptr,
+                                                       IID_PPV_ARGS(m_previewVideoExportReadback[i].ReleaseAndGetAddressOf()))) ||
+                FAILED(m_previewVideoExportReadback[i]->Map(0, nullptr, &mapped)) || !mapped) {
+                m_previewVideoExportStatus = "Failed to allocate export readback buffer.";
+                CancelPreviewVideoExport(true);
+                return;
+            }
+            m_previewVideoExportMapped[i] = static_cast<uint8_t*>(mapped);
         }
 
         m_previewVideoExportReadbackBytes = totalBytes;
@@ -377,7 +392,7 @@ void ShaderLabIDE::QueuePreviewVideoCapture(ID3D12GraphicsCommandList* commandLi
     srcLoc.SubresourceIndex = 0;
 
     D3D12_TEXTURE_COPY_LOCATION dstLoc = {};
-    dstLoc.pResource = m_previewVideoExportReadbackBuffer.Get();
+    dstLoc.pResource = m_previewVideoExportReadback[slot].Get();
     dstLoc.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
     dstLoc.PlacedFootprint = footprint;
 
@@ -389,7 +404,6 @@ void ShaderLabIDE::QueuePreviewVideoCapture(ID3D12GraphicsCommandList* commandLi
     commandList->ResourceBarrier(1, &postBarrier);
 
     m_previewVideoExportPendingReadback = true;
-    m_previewVideoExportPendingFrameIndex = static_cast<int64_t>(m_previewVideoExportCapturedFrames);
 }
 
 } // namespace ShaderLab
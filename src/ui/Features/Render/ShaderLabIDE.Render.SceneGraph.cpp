@@ -2,9 +2,11 @@
 
 #include <cmath>
 
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/Dx12ResourceService.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
 
 namespace ShaderLab {
 
@@ -155,10 +157,12 @@ void ShaderLabIDE::RenderScene(ID3D12GraphicsCommandList* commandList,
 
     PopulateSceneBindingDescriptors(sceneIndex, scene);
 
+    // A scene waiting in the project compile batch is not compiled a second time here.
+    const bool batchPending = IsCompilePending(CompileTargetKind::Scene, sceneIndex, -1);
 #if SHADERLAB_DEBUG
-    if (m_dbgEnableAutoCompile && (scene.isDirty || !scene.pipelineState)) {
+    if (m_dbgEnableAutoCompile && !batchPending && (scene.isDirty || !scene.pipelineState)) {
 #else
-    if (scene.isDirty || !scene.pipelineState) {
+    if (!batchPending && (scene.isDirty || !scene.pipelineState)) {
 #endif
         CompileScene(sceneIndex);
         scene.isDirty = false;
@@ -192,6 +196,7 @@ void ShaderLabIDE::RenderScene(ID3D12GraphicsCommandList* commandList,
     commandList->ResourceBarrier(1, &barrier);
 
     if (scene.pipelineState) {
+        ScopedGpuProfile sceneScope(m_profiler.get(), commandList, scene.name.empty() ? "scene" : scene.name.c_str());
         if (scene.srvHeap) {
             ID3D12DescriptorHeap* heaps[] = { scene.srvHeap.Get() };
             commandList->SetDescriptorHeaps(1, heaps);
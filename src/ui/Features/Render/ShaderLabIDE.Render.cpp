@@ -2,7 +2,10 @@
 #include "ShaderLab/UI/UISystemDemoUtils.h"
 
 #include "ShaderLab/Graphics/Swapchain.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
+#include "ShaderLab/Audio/AudioSystem.h"
 
 #include <imgui.h>
 #include <imgui_impl_dx12.h>
@@ -12,6 +15,12 @@ namespace ShaderLab {
 void ShaderLabIDE::Render(ID3D12GraphicsCommandList* commandList) {
     bool previewRendered = false;
     if (m_previewRenderer && m_swapchainRef && m_deviceRef) {
+        // Before the live audio block is set; thumbnails render silent.
+        RenderShaderThumbnails(commandList);
+        if (m_audioSystem) {
+            m_previewRenderer->SetAudioConstants(m_audioSystem->GetAnalysisBlock());
+        }
+        ScopedGpuProfile previewScope(m_profiler.get(), commandList, "preview");
         if (m_showAbout) {
             RenderAboutLogo(commandList);
         }
@@ -45,12 +54,23 @@ void ShaderLabIDE::Render(ID3D12GraphicsCommandList* commandList) {
         }
     }
 
-    if (m_srvHeap) {
-        ID3D12DescriptorHeap* heaps[] = { m_srvHeap.Get() };
-        commandList->SetDescriptorHeaps(1, heaps);
+    {
+        ScopedGpuProfile uiScope(m_profiler.get(), commandList, "ui");
+        if (m_srvHeap) {
+            ID3D12DescriptorHeap* heaps[] = { m_srvHeap.Get() };
+            commandList->SetDescriptorHeaps(1, heaps);
+        }
+
+        ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
     }
 
-    ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), commandList);
+    if (m_descriptorRing) {
+        m_descriptorRing->EndFrame();
+    }
+    if (m_profiler) {
+        m_profiler->EndFrame(commandList);
+    }
+    ++m_gpuFrameIndex;
 }
 
 } // namespace ShaderLab
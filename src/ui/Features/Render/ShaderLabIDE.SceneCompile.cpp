@@ -1,22 +1,26 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 
+#include <cstdio>
+#include <filesystem>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ShaderLab/Audio/AudioSystem.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/Core/CompilationService.h"
+#include "ShaderLab/Core/DxcCompilationService.h"
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
+#include "ShaderLab/Core/ProjectCompileBatch.h"
 
-namespace ShaderLab {
+#include <imgui.h>
 
-bool ShaderLabIDE::CompileScene(int sceneIndex) {
-    if (sceneIndex < 0 || sceneIndex >= (int)m_scenes.size()) return false;
-    auto& scene = m_scenes[sceneIndex];
+namespace ShaderLab {
 
-    // Only compile if we have a renderer
-    if (!m_previewRenderer || !m_compilationService) return false;
+namespace {
 
-    // Collect texture declarations
+std::vector<CompilationTextureBinding> BuildSceneBindings(const Scene& scene) {
     std::vector<CompilationTextureBinding> bindings;
     for(const auto& b : scene.bindings) {
         if (!b.enabled) continue;
@@ -30,18 +34,100 @@ bool ShaderLabIDE::CompileScene(int sceneIndex) {
 
         bindings.push_back(binding);
     }
+    return bindings;
+}
+
+AsyncCompileRequest MakeSceneCompileRequest(const Scene& scene, int sceneIndex, int priority) {
+    AsyncCompileRequest request;
+    request.key.kind = CompileTargetKind::Scene;
+    request.key.sceneIndex = sceneIndex;
+    request.source = scene.shaderCode;
+    request.sourceName = L"scene.hlsl";
+    request.bindings = BuildSceneBindings(scene);
+    request.priority = priority;
+    return request;
+}
+
+AsyncCompileRequest MakePostFxCompileRequest(CompileTargetKind kind,
+                                             const Scene::PostFXEffect& effect,
+                                             int sceneIndex,
+                                             int effectIndex,
+                                             int priority) {
+    AsyncCompileRequest request;
+    request.key.kind = kind;
+    request.key.sceneIndex = sceneIndex;
+    request.key.effectIndex = effectIndex;
+    request.source = effect.shaderCode;
+    request.sourceName = L"postfx.hlsl";
+    request.bindings = { {0, "Texture2D"} };
+    request.flipFragCoord = true;
+    request.priority = priority;
+    return request;
+}
+
+AsyncCompileRequest MakeComputeCompileRequest(const Scene::ComputeEffect& effect, int sceneIndex, int effectIndex, int priority) {
+    AsyncCompileRequest request;
+    request.key.kind = CompileTargetKind::Compute;
+    request.key.sceneIndex = sceneIndex;
+    request.key.effectIndex = effectIndex;
+    request.source = effect.shaderCode;
+    request.entryPoint = effect.entryPoint.empty() ? "main" : effect.entryPoint;
+    request.target = "cs_6_0";
+    request.sourceName = L"compute.hlsl";
+    request.mode = ShaderCompileMode::Build;
+    request.priority = priority;
+    return request;
+}
+
+// Same lookup as SaveProject: workspace-relative first, then next to the project file.
+std::string ResolveLinkedShaderPath(const std::string& storedPath,
+                                    const std::filesystem::path& workspaceRoot,
+                                    const std::filesystem::path& projectRoot) {
+    namespace fs = std::filesystem;
+    fs::path path(storedPath);
+    if (!path.is_absolute()) {
+        const fs::path workspaceCandidate = workspaceRoot.empty() ? fs::path() : (workspaceRoot / path);
+        std::error_code ec;
+        if (!workspaceRoot.empty() && fs::exists(workspaceCandidate, ec) && !ec) {
+            path = workspaceCandidate;
+        } else if (!projectRoot.empty()) {
+            path = projectRoot / path;
+        } else {
+            path = workspaceCandidate;
+        }
+    }
+    return path.lexically_normal().string();
+}
+
+uint64_t MixLinkSignature(uint64_t signature, const std::string& path) {
+    return (signature ^ HashShaderText(path)) * 1099511628211ull;
+}
+
+} // namespace
+
+bool ShaderLabIDE::CompileScene(int sceneIndex) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_scenes.size()) return false;
+    auto& scene = m_scenes[sceneIndex];
+
+    // Only compile if we have a renderer
+    if (!m_previewRenderer || !m_compilationService) return false;
 
-    // Compile
-    std::vector<ShaderDiagnostic> compileDiagnostics;
-    std::vector<std::string> errors;
     const ShaderCompileResult compileResult = m_compilationService->CompilePreviewShader(
         scene.shaderCode,
-        bindings,
+        BuildSceneBindings(scene),
         false,
         "main",
         L"scene.hlsl",
         ShaderCompileMode::Live);
+    return ApplySceneCompileResult(sceneIndex, compileResult);
+}
 
+bool ShaderLabIDE::ApplySceneCompileResult(int sceneIndex, const ShaderCompileResult& compileResult) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_scenes.size() || !m_previewRenderer) return false;
+    auto& scene = m_scenes[sceneIndex];
+
+    std::vector<ShaderDiagnostic> compileDiagnostics;
+    std::vector<std::string> errors;
     for (const auto& diagnostic : compileResult.diagnostics) {
         compileDiagnostics.push_back(diagnostic);
         errors.push_back(diagnostic.message);
@@ -105,4 +191,286 @@ bool ShaderLabIDE::CompileScene(int sceneIndex) {
     return success;
 }
 
+bool ShaderLabIDE::SubmitSceneCompile(int sceneIndex) {
+    if (sceneIndex < 0 || sceneIndex >= (int)m_scenes.size() || !m_asyncCompiler) return false;
+    m_asyncCompiler->Submit(MakeSceneCompileRequest(m_scenes[sceneIndex], sceneIndex, 0));
+    return true;
+}
+
+bool ShaderLabIDE::SubmitPostFxCompile(int sceneIndex, int effectIndex, const Scene::PostFXEffect& effect) {
+    if (!m_asyncCompiler) return false;
+    m_asyncCompiler->Submit(MakePostFxCompileRequest(CompileTargetKind::PostFxDraft, effect, sceneIndex, effectIndex, 0));
+    return true;
+}
+
+void ShaderLabIDE::UpdateLinkedShaders() {
+    if (!m_assetCatalog || !m_asyncCompiler) return;
+    if (!m_linkedShaders) {
+        m_linkedShaders = std::make_unique<LinkedShaderWatcher>(*m_assetCatalog);
+    }
+
+    // Links are only resolved again when the project or a shaderCodePath changed.
+    uint64_t signature = MixLinkSignature(HashShaderText(m_currentProjectPath), m_workspaceRootPath);
+    for (const auto& scene : m_scenes) {
+        signature = MixLinkSignature(signature, scene.shaderCodePath);
+        for (const auto& fx : scene.postFxChain) {
+            signature = MixLinkSignature(signature, fx.shaderCodePath);
+        }
+        for (const auto& effect : scene.computeEffectChain) {
+            signature = MixLinkSignature(signature, effect.shaderCodePath);
+        }
+        signature = MixLinkSignature(signature, std::string());
+    }
+    if (signature != m_linkedShaderSignature) {
+        m_linkedShaderSignature = signature;
+        const std::filesystem::path workspaceRoot(m_workspaceRootPath);
+        const std::filesystem::path projectRoot = m_currentProjectPath.empty()
+            ? std::filesystem::path()
+            : std::filesystem::path(m_currentProjectPath).parent_path();
+        std::vector<LinkedShaderLink> links;
+        auto addLink = [&](CompileTargetKind kind, int sceneIndex, int effectIndex, const std::string& storedPath) {
+            if (storedPath.empty()) return;
+            LinkedShaderLink link;
+            link.key.kind = kind;
+            link.key.sceneIndex = sceneIndex;
+            link.key.effectIndex = effectIndex;
+            link.path = ResolveLinkedShaderPath(storedPath, workspaceRoot, projectRoot);
+            links.push_back(std::move(link));
+        };
+        for (int i = 0; i < (int)m_scenes.size(); ++i) {
+            const Scene& scene = m_scenes[i];
+            addLink(CompileTargetKind::Scene, i, -1, scene.shaderCodePath);
+            for (int fx = 0; fx < (int)scene.postFxChain.size(); ++fx) {
+                addLink(CompileTargetKind::PostFx, i, fx, scene.postFxChain[fx].shaderCodePath);
+            }
+            for (int fx = 0; fx < (int)scene.computeEffectChain.size(); ++fx) {
+                addLink(CompileTargetKind::Compute, i, fx, scene.computeEffectChain[fx].shaderCodePath);
+            }
+        }
+        m_linkedShaders->SetLinks(links);
+    }
+
+    std::vector<LinkedShaderChange> changes;
+    if (m_linkedShaders->Poll(ImGui::GetTime() * 1000.0, changes) == 0) return;
+
+    for (const auto& change : changes) {
+        const CompileTargetKey& key = change.key;
+        if (key.sceneIndex < 0 || key.sceneIndex >= (int)m_scenes.size()) continue;
+        Scene& scene = m_scenes[key.sceneIndex];
+
+        std::string* code = nullptr;
+        std::string name = scene.name;
+        if (key.kind == CompileTargetKind::Scene) {
+            code = &scene.shaderCode;
+        } else if (key.kind == CompileTargetKind::PostFx && key.effectIndex >= 0 && key.effectIndex < (int)scene.postFxChain.size()) {
+            code = &scene.postFxChain[key.effectIndex].shaderCode;
+            name += " / " + scene.postFxChain[key.effectIndex].name;
+        } else if (key.kind == CompileTargetKind::Compute && key.effectIndex >= 0 && key.effectIndex < (int)scene.computeEffectChain.size()) {
+            code = &scene.computeEffectChain[key.effectIndex].shaderCode;
+            name += " / " + scene.computeEffectChain[key.effectIndex].name;
+        }
+        // Our own project save writes the linked files too; those come back unchanged.
+        if (!code || *code == *change.code) continue;
+        if (HashShaderText(*code) != change.previousHash) {
+            AppendDemoLog("[hot reload] " + name + ": kept the unsaved edits, " + change.path + " changed on disk");
+            continue;
+        }
+
+        const bool inEditor = key.kind == CompileTargetKind::Scene && key.sceneIndex == m_editingSceneIndex &&
+                              m_currentMode == UIMode::Scene && m_shaderState.text == *code;
+        *code = *change.code;
+        if (inEditor) {
+            m_shaderState.text = *code;
+            m_textEditor.SetText(*code);
+            m_shaderState.status = CompileStatus::Compiling;
+        }
+
+        // The current pipeline keeps rendering until ApplyCompletedCompiles swaps in the result.
+        if (key.kind == CompileTargetKind::Scene) {
+            scene.isDirty = true;
+            SubmitSceneCompile(key.sceneIndex);
+        } else if (key.kind == CompileTargetKind::PostFx) {
+            auto& effect = scene.postFxChain[key.effectIndex];
+            effect.isDirty = true;
+            m_asyncCompiler->Submit(MakePostFxCompileRequest(CompileTargetKind::PostFx, effect, key.sceneIndex, key.effectIndex, 0));
+        } else {
+            auto& effect = scene.computeEffectChain[key.effectIndex];
+            effect.isDirty = true;
+            m_asyncCompiler->Submit(MakeComputeCompileRequest(effect, key.sceneIndex, key.effectIndex, 0));
+        }
+        AppendDemoLog("[hot reload] " + name + " reloaded from " + change.path);
+    }
+}
+
+void ShaderLabIDE::SetBytecodeCache(ShaderBytecodeCache* cache) {
+    m_bytecodeCache = cache;
+    if (m_asyncCompiler) {
+        m_asyncCompiler->SetBytecodeCache(cache);
+    }
+    if (m_projectCompiler) {
+        m_projectCompiler->SetBytecodeCache(cache);
+    }
+}
+
+void ShaderLabIDE::StartProjectCompile() {
+    // The active scene and the scenes it samples are needed for the first frame; its effects next.
+    std::vector<bool> firstScenes(m_scenes.size(), false);
+    if (m_activeSceneIndex >= 0 && m_activeSceneIndex < (int)m_scenes.size()) {
+        firstScenes[m_activeSceneIndex] = true;
+        for (const auto& binding : m_scenes[m_activeSceneIndex].bindings) {
+            if (binding.enabled && binding.sourceSceneIndex >= 0 && binding.sourceSceneIndex < (int)m_scenes.size()) {
+                firstScenes[binding.sourceSceneIndex] = true;
+            }
+        }
+    }
+
+    std::vector<AsyncCompileRequest> requests;
+    for (int i = 0; i < (int)m_scenes.size(); ++i) {
+        const Scene& scene = m_scenes[i];
+        if (scene.isDirty || !scene.pipelineState) {
+            requests.push_back(MakeSceneCompileRequest(scene, i, firstScenes[i] ? 2 : 0));
+        }
+        const int effectPriority = i == m_activeSceneIndex ? 1 : 0;
+        for (int fx = 0; fx < (int)scene.postFxChain.size(); ++fx) {
+            const auto& effect = scene.postFxChain[fx];
+            if (effect.isDirty || !effect.pipelineState) {
+                requests.push_back(MakePostFxCompileRequest(CompileTargetKind::PostFx, effect, i, fx, effectPriority));
+            }
+        }
+        for (int fx = 0; fx < (int)scene.computeEffectChain.size(); ++fx) {
+            const auto& effect = scene.computeEffectChain[fx];
+            if (effect.isDirty || !effect.pipelineState) {
+                requests.push_back(MakeComputeCompileRequest(effect, i, fx, effectPriority));
+            }
+        }
+    }
+
+    if (m_projectCompiler) {
+        m_projectCompiler->CancelAll();
+    }
+    if (requests.empty()) {
+        m_projectCompileBatch.reset();
+        m_projectCompiler.reset();
+        return;
+    }
+    if (!m_projectCompiler) {
+        m_projectCompiler = std::make_unique<AsyncCompilationService>(
+            []() { return std::make_unique<DxcCompilationService>(); },
+            AsyncCompilationService::BatchWorkerCount());
+        m_projectCompiler->SetBytecodeCache(m_bytecodeCache);
+    }
+    if (!m_projectCompileBatch) {
+        m_projectCompileBatch = std::make_unique<ProjectCompileBatch>();
+    }
+    AppendDemoLog("[compile] Compiling " + std::to_string(requests.size()) + " shaders on " +
+                  std::to_string(m_projectCompiler->GetWorkerCount()) + " workers");
+    m_projectCompileBatch->Start(*m_projectCompiler, std::move(requests));
+}
+
+bool ShaderLabIDE::IsCompilePending(CompileTargetKind kind, int sceneIndex, int effectIndex) const {
+    CompileTargetKey key;
+    key.kind = kind;
+    key.sceneIndex = sceneIndex;
+    key.effectIndex = effectIndex;
+    return (m_projectCompiler && m_projectCompiler->IsPending(key)) ||
+           (m_asyncCompiler && m_asyncCompiler->IsPending(key));
+}
+
+void ShaderLabIDE::ApplyCompletedCompiles() {
+    if (!m_asyncCompiler) return;
+
+    std::vector<AsyncCompileResult> completed;
+    const size_t editResults = m_asyncCompiler->Collect(completed);
+    if (m_projectCompiler) {
+        m_projectCompiler->Collect(completed);
+    }
+
+    for (const auto& entry : completed) {
+        // A result only lands on the target it was compiled from; edits, reloads and removals
+        // since the request leave it unapplied.
+        const CompileTargetKey& key = entry.key;
+        const bool sceneValid = key.sceneIndex >= 0 && key.sceneIndex < (int)m_scenes.size();
+        if (key.kind == CompileTargetKind::Scene) {
+            if (!sceneValid || m_scenes[key.sceneIndex].shaderCode != entry.source) {
+                continue;
+            }
+            const bool success = ApplySceneCompileResult(key.sceneIndex, entry.result);
+            if (key.sceneIndex == m_editingSceneIndex && m_currentMode != UIMode::PostFX) {
+                m_shaderState.status = success ? CompileStatus::Success : CompileStatus::Error;
+                if (success) {
+                    m_shaderState.lastCompiledText = entry.source;
+                }
+            }
+        } else if (key.kind == CompileTargetKind::PostFx) {
+            if (!sceneValid || key.effectIndex < 0 || key.effectIndex >= (int)m_scenes[key.sceneIndex].postFxChain.size()) {
+                continue;
+            }
+            auto& effect = m_scenes[key.sceneIndex].postFxChain[key.effectIndex];
+            std::vector<std::string> fxErrors;
+            if (effect.shaderCode == entry.source && !ApplyPostFxCompileResult(effect, entry.result, fxErrors)) {
+                AppendDemoLog("[compile] " + m_scenes[key.sceneIndex].name + " / " + effect.name + ": compilation failed");
+            }
+        } else if (key.kind == CompileTargetKind::Compute) {
+            if (!sceneValid || key.effectIndex < 0 || key.effectIndex >= (int)m_scenes[key.sceneIndex].computeEffectChain.size()) {
+                continue;
+            }
+            auto& effect = m_scenes[key.sceneIndex].computeEffectChain[key.effectIndex];
+            if (effect.shaderCode == entry.source && !CreateComputePipelineFromBytecode(effect, entry.result)) {
+                AppendDemoLog("[compile] " + m_scenes[key.sceneIndex].name + " / " + effect.name + ": compilation failed");
+            }
+        } else if (key.kind == CompileTargetKind::PostFxDraft) {
+            if (key.sceneIndex != m_postFxSourceSceneIndex || key.effectIndex < 0 ||
+                key.effectIndex >= (int)m_postFxDraftChain.size() ||
+                m_postFxDraftChain[key.effectIndex].shaderCode != entry.source) {
+                continue;
+            }
+            auto& effect = m_postFxDraftChain[key.effectIndex];
+            std::vector<std::string> fxErrors;
+            if (!ApplyPostFxCompileResult(effect, entry.result, fxErrors)) {
+                m_postFxDraftCompileFailed = true;
+                for (const auto& error : fxErrors) {
+                    Diagnostic diag;
+                    diag.message = effect.name + ": " + error;
+                    m_shaderState.diagnostics.push_back(diag);
+                }
+            }
+        } else if (key.kind == CompileTargetKind::Thumbnail) {
+            ApplyThumbnailCompileResult(entry);
+        }
+    }
+
+    if (m_projectCompileBatch && m_projectCompiler && m_projectCompileBatch->Update(*m_projectCompiler)) {
+        char elapsed[32];
+        std::snprintf(elapsed, sizeof(elapsed), "%.0f ms", m_projectCompileBatch->GetElapsedMs());
+        AppendDemoLog("[compile] Project compiled: " + std::to_string(m_projectCompileBatch->GetTotal()) +
+                      " shaders in " + elapsed);
+        // Nothing is pending any more; the pool is only worth keeping for the next batch.
+        m_projectCompiler.reset();
+    }
+
+    if (editResults == 0) return;
+
+    // The post-FX chain reports once every draft effect of the batch is back.
+    if (m_currentMode == UIMode::PostFX && m_shaderState.status == CompileStatus::Compiling) {
+        bool chainPending = false;
+        for (int i = 0; i < (int)m_postFxDraftChain.size() && !chainPending; ++i) {
+            chainPending = m_asyncCompiler->IsPending({CompileTargetKind::PostFxDraft, m_postFxSourceSceneIndex, i});
+        }
+        if (!chainPending) {
+            if (m_postFxDraftCompileFailed) {
+                m_shaderState.status = CompileStatus::Error;
+                m_playbackBlockedByCompileError = true;
+            } else {
+                m_shaderState.status = CompileStatus::Success;
+                if (m_postFxSelectedIndex >= 0 && m_postFxSelectedIndex < (int)m_postFxDraftChain.size()) {
+                    m_shaderState.lastCompiledText = m_postFxDraftChain[m_postFxSelectedIndex].shaderCode;
+                }
+                m_playbackBlockedByCompileError = false;
+            }
+        }
+    }
+
+    RefreshPresetService();
+}
+
 } // namespace ShaderLab
@@ -1,128 +1,147 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 
+#include "ShaderLab/Core/TextureUploadQueue.h"
 #include "ShaderLab/Graphics/Device.h"
-#include "ShaderLab/Graphics/Dx12ResourceService.h"
+#include "ShaderLab/Graphics/TextureUploader.h"
 
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 namespace ShaderLab {
 
-bool ShaderLabIDE::LoadTextureFromFile(const std::string& path, ComPtr<ID3D12Resource>& outResource) {
-    if (path.empty()) return false;
+namespace {
 
-    int w, h, channels;
-    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 4);
-    if (!data) return false;
-
-    // TODO: Handle failure in creation?
-    // Using a local helper for synchronous upload
-    CreateTextureFromData(data, w, h, 4, outResource);
+// Enough for a 2K texture; larger images grow the ring once nothing is in flight.
+constexpr uint64_t kTextureStagingBytes = 32ull * 1024ull * 1024ull;
 
+bool DecodeImageFile(const std::string& path, DecodedImage& outImage, std::string& outError) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        const char* reason = stbi_failure_reason();
+        outError = "Failed to load " + path + (reason ? std::string(": ") + reason : std::string());
+        return false;
+    }
+    outImage.width = static_cast<uint32_t>(width);
+    outImage.height = static_cast<uint32_t>(height);
+    outImage.rgba.assign(data, data + static_cast<size_t>(width) * height * 4u);
     stbi_image_free(data);
-    return outResource != nullptr;
+    return true;
 }
 
-void ShaderLabIDE::CreateTextureFromData(const void* data, int width, int height, int channels, ComPtr<ID3D12Resource>& outResource) {
-    (void)channels;
-    auto device = m_deviceRef->GetDevice();
-    Dx12ResourceService resourceService(device);
-
-    // 1. Create Default Heap Resource (Dest)
-    TextureAllocationRequest textureRequest{};
-    textureRequest.width = static_cast<uint32_t>(width);
-    textureRequest.height = static_cast<uint32_t>(height);
-    textureRequest.format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    textureRequest.initialState = D3D12_RESOURCE_STATE_COPY_DEST;
-    if (!resourceService.AllocateTexture2D(textureRequest, outResource)) {
-        return;
-    }
-
-    D3D12_RESOURCE_DESC texDesc = outResource->GetDesc();
+} // namespace
 
-    // 2. Create Upload Buffer
-    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
-    UINT numRows;
-    UINT64 rowSizeInBytes;
-    UINT64 totalBytes;
+bool ShaderLabIDE::EnsureTextureUploads() {
+    if (m_textureUploads) {
+        return true;
+    }
+    if (!m_deviceRef) {
+        return false;
+    }
+    auto uploader = std::make_unique<Dx12TextureUploader>();
+    if (!uploader->Initialize(m_deviceRef->GetDevice(), kTextureStagingBytes)) {
+        return false;
+    }
+    m_textureUploader = std::move(uploader);
+    m_textureUploads = std::make_unique<TextureUploadQueue>(m_textureUploader.get(), DecodeImageFile,
+                                                            TextureUploadQueue::DefaultWorkerCount());
+    return true;
+}
 
-    device->GetCopyableFootprints(&texDesc, 0, 1, 0, &footprint, &numRows, &rowSizeInBytes, &totalBytes);
+void ShaderLabIDE::RequestFileTexture(TextureBinding& binding) {
+    binding.textureResource = nullptr;
+    binding.fileTextureValid = false;
+    std::error_code ec;
+    if (binding.bindingType != BindingType::File || binding.filePath.empty() ||
+        !std::filesystem::is_regular_file(binding.filePath, ec) || !EnsureTextureUploads()) {
+        return; // Also skips half-typed paths from the path field
+    }
+    if (m_fileTextureLoadsByPath.find(binding.filePath) != m_fileTextureLoadsByPath.end()) {
+        return; // The load in flight fills every binding of this path
+    }
+    const uint64_t ticket = m_textureUploads->RequestFile(binding.filePath);
+    m_fileTextureTickets[ticket] = binding.filePath;
+    m_fileTextureLoadsByPath[binding.filePath] = ticket;
+}
 
-    ComPtr<ID3D12Resource> uploadBuffer;
-    ResourceBufferAllocationRequest uploadRequest{};
-    uploadRequest.sizeBytes = totalBytes;
-    uploadRequest.heapType = D3D12_HEAP_TYPE_UPLOAD;
-    uploadRequest.initialState = D3D12_RESOURCE_STATE_GENERIC_READ;
-    if (!resourceService.AllocateBuffer(uploadRequest, uploadBuffer)) {
+void ShaderLabIDE::UpdateTextureUploads() {
+    if (!m_textureUploads) {
         return;
     }
+    std::vector<TextureUploadResult> results;
+    if (m_textureUploads->Update(results) > 0) {
+        ApplyTextureUploadResults(results);
+    }
+}
 
-    // 3. Copy Memory
-    void* mappedData;
-    uploadBuffer->Map(0, nullptr, &mappedData);
-
-    const uint8_t* srcData = (const uint8_t*)data;
-    uint8_t* dstData = (uint8_t*)mappedData;
+void ShaderLabIDE::ApplyTextureUploadResults(std::vector<TextureUploadResult>& results) {
+    for (TextureUploadResult& result : results) {
+        if (ApplyThumbnailPageUpload(result)) {
+            continue;
+        }
+        if (result.ticket == m_themeBackgroundTicket) {
+            m_themeBackgroundTicket = 0;
+            if (result.success) {
+                ApplyThemeBackgroundTexture(m_textureUploader->TakeTexture(result.ticket), static_cast<int>(result.width),
+                                            static_cast<int>(result.height), result.path);
+            } else {
+                AppendDemoLog("[texture] " + result.error);
+            }
+            continue;
+        }
+
+        auto it = m_fileTextureTickets.find(result.ticket);
+        if (it == m_fileTextureTickets.end()) {
+            continue; // Taken by CreateTextureFromData
+        }
+        const std::string path = std::move(it->second);
+        m_fileTextureTickets.erase(it);
+        m_fileTextureLoadsByPath.erase(path);
+        if (!result.success) {
+            AppendDemoLog("[texture] " + result.error);
+            continue;
+        }
+
+        ComPtr<ID3D12Resource> texture = m_textureUploader->TakeTexture(result.ticket);
+        for (Scene& scene : m_scenes) {
+            for (TextureBinding& binding : scene.bindings) {
+                if (binding.bindingType == BindingType::File && binding.filePath == path && !binding.fileTextureValid) {
+                    binding.textureResource = texture;
+                    binding.fileTextureValid = true;
+                }
+            }
+        }
+    }
+}
 
-    for (UINT i = 0; i < numRows; ++i) {
-        memcpy(dstData + footprint.Footprint.RowPitch * i,
-               srcData + width * 4 * i,
-               width * 4);
+void ShaderLabIDE::CreateTextureFromData(const void* data, int width, int height, int channels, ComPtr<ID3D12Resource>& outResource) {
+    (void)channels;
+    outResource.Reset();
+    if (!data || width <= 0 || height <= 0 || !EnsureTextureUploads()) {
+        return;
     }
-    uploadBuffer->Unmap(0, nullptr);
-
-    // 4. Create Short Lived Command Queue/List
-    ComPtr<ID3D12CommandQueue> queue;
-    D3D12_COMMAND_QUEUE_DESC queueDesc = {};
-    queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-    queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-    device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&queue));
-
-    ComPtr<ID3D12CommandAllocator> allocator;
-    device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&allocator));
-
-    ComPtr<ID3D12GraphicsCommandList> cmdList;
-    device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, allocator.Get(), nullptr, IID_PPV_ARGS(&cmdList));
-
-    // 5. Record Copy
-    D3D12_TEXTURE_COPY_LOCATION dst = {};
-    dst.pResource = outResource.Get();
-    dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-    dst.SubresourceIndex = 0;
-
-    D3D12_TEXTURE_COPY_LOCATION src = {};
-    src.pResource = uploadBuffer.Get();
-    src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
-    src.PlacedFootprint = footprint;
-
-    cmdList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = outResource.Get();
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
-    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-
-    cmdList->ResourceBarrier(1, &barrier);
-    cmdList->Close();
-
-    // 6. Execute and Wait
-    ID3D12CommandList* ppCommandLists[] = { cmdList.Get() };
-    queue->ExecuteCommandLists(1, ppCommandLists);
-
-    ComPtr<ID3D12Fence> fence;
-    device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
-    HANDLE fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-
-    queue->Signal(fence.Get(), 1);
-    fence->SetEventOnCompletion(1, fenceEvent);
-    WaitForSingleObject(fenceEvent, INFINITE);
-    CloseHandle(fenceEvent);
+
+    DecodedImage image;
+    image.width = static_cast<uint32_t>(width);
+    image.height = static_cast<uint32_t>(height);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    image.rgba.assign(bytes, bytes + static_cast<size_t>(width) * height * 4u);
+    const uint64_t ticket = m_textureUploads->RequestImage(std::move(image));
+
+    std::vector<TextureUploadResult> results;
+    m_textureUploads->Flush([this](uint64_t batchIndex) { m_textureUploader->WaitForBatch(batchIndex); }, results);
+    outResource = m_textureUploader->TakeTexture(ticket);
+    ApplyTextureUploadResults(results);
 }
 
 } // namespace ShaderLab
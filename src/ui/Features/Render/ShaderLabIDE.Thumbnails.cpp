@@ -0,0 +1,411 @@
+#include "ShaderLab/UI/ShaderLabIDE.h"
+
+#include "ShaderLab/Core/AsyncCompilationService.h"
+#include "ShaderLab/Core/TextureUploadQueue.h"
+#include "ShaderLab/Core/ThumbnailCache.h"
+#include "ShaderLab/Graphics/Device.h"
+#include "ShaderLab/Graphics/Dx12ResourceService.h"
+#include "ShaderLab/Graphics/PreviewRenderer.h"
+#include "ShaderLab/Graphics/TextureUploader.h"
+#include "ShaderLab/UI/UISystemAssets.h"
+
+#include <imgui.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace ShaderLab {
+
+namespace {
+
+constexpr UINT kThumbnailSrvIndex = 122; // One per atlas page, through 125
+constexpr float kThumbnailTimeSeconds = 2.0f;
+constexpr float kThumbnailBpm = 120.0f;
+constexpr double kPageUploadDelaySeconds = 0.25;
+constexpr uint32_t kTestCardWidth = 256;
+constexpr uint32_t kTestCardHeight = 144;
+constexpr int kThumbnailInputSlots = 8;
+
+std::string GetThumbnailCachePath(const std::string& appRoot) {
+    std::filesystem::path baseDir;
+    char* appData = nullptr;
+    size_t appDataLen = 0;
+    if (_dupenv_s(&appData, &appDataLen, "APPDATA") == 0 && appData && *appData) {
+        baseDir = std::filesystem::path(appData) / "ShaderLab";
+    } else {
+        baseDir = std::filesystem::path(appRoot) / ".shaderlab";
+    }
+    if (appData) {
+        free(appData);
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(baseDir, ec);
+    return (baseDir / "thumbnails.slthumb").string();
+}
+
+// Post-FX code renders over the test card with a flipped fragCoord, so it needs its own key.
+uint64_t ThumbnailSourceHash(uint64_t codeHash, bool postFx) {
+    return postFx ? (codeHash ^ 0x9E3779B97F4A7C15ull) : codeHash;
+}
+
+// Gradient with a grid and a disc, so colour, blur and distortion effects all show something.
+std::vector<uint8_t> MakeTestCard() {
+    std::vector<uint8_t> rgba(static_cast<size_t>(kTestCardWidth) * kTestCardHeight * 4u);
+    for (uint32_t y = 0; y < kTestCardHeight; ++y) {
+        for (uint32_t x = 0; x < kTestCardWidth; ++x) {
+            const float u = static_cast<float>(x) / (kTestCardWidth - 1);
+            const float v = static_cast<float>(y) / (kTestCardHeight - 1);
+            const float dx = u - 0.5f;
+            const float dy = (v - 0.5f) * (static_cast<float>(kTestCardHeight) / kTestCardWidth);
+            const bool grid = (x % 32) == 0 || (y % 32) == 0;
+            const bool disc = std::sqrt(dx * dx + dy * dy) < 0.18f;
+            uint8_t* p = rgba.data() + (static_cast<size_t>(y) * kTestCardWidth + x) * 4u;
+            p[0] = static_cast<uint8_t>(disc ? 240 : 40 + 180 * u);
+            p[1] = static_cast<uint8_t>(disc ? 200 : 60 + 120 * v);
+            p[2] = static_cast<uint8_t>(disc ? 60 : 200 - 120 * u);
+            if (grid) {
+                p[0] = p[1] = p[2] = 230;
+            }
+            p[3] = 255;
+        }
+    }
+    return rgba;
+}
+
+} // namespace
+
+bool ShaderLabIDE::DrawShaderThumbnail(const std::string& code, uint64_t codeHash, bool postFx, const ImVec2& size) {
+    if (!m_thumbnails) {
+        m_thumbnails = std::make_unique<ThumbnailCache>();
+        m_thumbnailCachePath = GetThumbnailCachePath(m_appRoot);
+        std::error_code ec;
+        std::string error;
+        if (std::filesystem::exists(m_thumbnailCachePath, ec) && !m_thumbnails->Load(m_thumbnailCachePath, error)) {
+            AppendDemoLog("[thumbnails] " + error);
+        }
+        m_thumbnailPages.resize(m_thumbnails->GetDesc().maxPages);
+    }
+
+    const ThumbnailAtlasDesc& desc = m_thumbnails->GetDesc();
+    const uint64_t key = MakeThumbnailKey(ThumbnailSourceHash(codeHash, postFx), desc.cellWidth, desc.cellHeight,
+                                          kThumbnailTimeSeconds);
+    ThumbnailSlot slot;
+    if (m_thumbnails->Find(key, slot)) {
+        const ThumbnailPage& page = m_thumbnailPages[slot.page];
+        if (page.texture && page.revision >= slot.revision && m_deviceRef && m_srvHeap) {
+            const UINT descriptorSize =
+                m_deviceRef->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+            D3D12_GPU_DESCRIPTOR_HANDLE srv = m_srvHeap->GetGPUDescriptorHandleForHeapStart();
+            srv.ptr += static_cast<SIZE_T>(kThumbnailSrvIndex + slot.page) * descriptorSize;
+            const float pageWidth = static_cast<float>(m_thumbnails->GetPageWidth());
+            const float pageHeight = static_cast<float>(m_thumbnails->GetPageHeight());
+            ImGui::Image((ImTextureID)srv.ptr, size,
+                         ImVec2(slot.x / pageWidth, slot.y / pageHeight),
+                         ImVec2((slot.x + desc.cellWidth) / pageWidth, (slot.y + desc.cellHeight) / pageHeight));
+            return true;
+        }
+    } else if (!code.empty() && m_thumbnailFailed.count(key) == 0 && m_thumbnailRequested.insert(key).second) {
+        ThumbnailRequest request;
+        request.key = key;
+        request.source = code;
+        request.postFx = postFx;
+        m_thumbnailQueue.push_back(std::move(request));
+    }
+
+    const ImVec2 min = ImGui::GetCursorScreenPos();
+    const ImVec2 max(min.x + size.x, min.y + size.y);
+    ImGui::Dummy(size);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    drawList->AddRectFilled(min, max, ImGui::GetColorU32(ImGuiCol_FrameBg));
+    const char* label = m_thumbnailFailed.count(key) != 0 ? "no preview" : "...";
+    const ImVec2 labelSize = ImGui::CalcTextSize(label);
+    drawList->AddText(ImVec2(min.x + (size.x - labelSize.x) * 0.5f, min.y + (size.y - labelSize.y) * 0.5f),
+                      ImGui::GetColorU32(ImGuiCol_TextDisabled), label);
+    return false;
+}
+
+void ShaderLabIDE::UpdateShaderThumbnails() {
+    if (!m_thumbnails) {
+        return;
+    }
+    const ThumbnailAtlasDesc& desc = m_thumbnails->GetDesc();
+
+    if (m_thumbnailReadbackKey != 0) {
+        // The copy finished with last frame's GPU wait.
+        const size_t rowBytes = static_cast<size_t>(desc.cellWidth) * 4u;
+        std::vector<uint8_t> pixels(rowBytes * desc.cellHeight);
+        for (uint32_t y = 0; y < desc.cellHeight; ++y) {
+            std::memcpy(pixels.data() + y * rowBytes, m_thumbnailReadbackMapped + static_cast<size_t>(y) * m_thumbnailReadbackRowPitch,
+                        rowBytes);
+        }
+        // Lists draw thumbnails over their own background; shader alpha is not meant for that.
+        for (size_t i = 3; i < pixels.size(); i += 4) {
+            pixels[i] = 255;
+        }
+        ThumbnailSlot slot;
+        m_thumbnails->Insert(m_thumbnailReadbackKey, pixels.data(), static_cast<uint32_t>(rowBytes), slot);
+        m_thumbnailRequested.erase(m_thumbnailReadbackKey);
+        m_thumbnailReadbackKey = 0;
+        m_thumbnailPso.Reset();
+    }
+
+    // Pages go up whole; new thumbnails wait for the queue to drain, or a short delay, so a
+    // freshly opened list costs one upload per page rather than one per thumbnail.
+    const bool idle = m_thumbnailQueue.empty() && m_thumbnailActive.key == 0;
+    const double now = ImGui::GetTime();
+    for (size_t p = 0; p < m_thumbnails->GetPageCount() && p < m_thumbnailPages.size(); ++p) {
+        ThumbnailPage& page = m_thumbnailPages[p];
+        const uint64_t revision = m_thumbnails->GetPageRevision(p);
+        if (page.revision >= revision || page.ticket != 0) {
+            continue;
+        }
+        if (page.changedAt < 0.0) {
+            page.changedAt = now;
+        }
+        if ((!idle && now - page.changedAt < kPageUploadDelaySeconds) || !EnsureTextureUploads()) {
+            continue;
+        }
+        DecodedImage image;
+        image.width = m_thumbnails->GetPageWidth();
+        image.height = m_thumbnails->GetPageHeight();
+        image.rgba = m_thumbnails->GetPagePixels(p);
+        page.ticket = m_textureUploads->RequestImage(std::move(image), "thumbnail atlas");
+        page.ticketRevision = revision;
+        page.changedAt = -1.0;
+    }
+
+    if (!m_asyncCompiler) {
+        return;
+    }
+    CompileTargetKey compileKey;
+    compileKey.kind = CompileTargetKind::Thumbnail;
+    if (m_thumbnailActive.key != 0 && !m_thumbnailPso && !m_asyncCompiler->IsPending(compileKey)) {
+        // Canceled along with everything else (project load); try again later.
+        m_thumbnailQueue.push_back(std::move(m_thumbnailActive));
+        m_thumbnailActive = ThumbnailRequest();
+    }
+    if (m_thumbnailActive.key != 0 || m_thumbnailQueue.empty()) {
+        return;
+    }
+    m_thumbnailActive = std::move(m_thumbnailQueue.front());
+    m_thumbnailQueue.pop_front();
+
+    AsyncCompileRequest request;
+    request.key = compileKey;
+    request.source = m_thumbnailActive.source;
+    request.sourceName = L"thumbnail.hlsl";
+    if (m_thumbnailActive.postFx) {
+        request.bindings = { {0, "Texture2D"} };
+        request.flipFragCoord = true;
+    }
+    request.priority = -1; // Behind every edit and project compile
+    m_asyncCompiler->Submit(std::move(request));
+}
+
+void ShaderLabIDE::ApplyThumbnailCompileResult(const AsyncCompileResult& result) {
+    if (m_thumbnailActive.key == 0 || m_thumbnailPso || result.source != m_thumbnailActive.source) {
+        return;
+    }
+    if (result.result.success && m_previewRenderer) {
+        m_thumbnailPso = m_previewRenderer->CreatePSOFromBytecode(result.result.bytecode);
+    }
+    if (!m_thumbnailPso) {
+        m_thumbnailFailed.insert(m_thumbnailActive.key);
+        m_thumbnailRequested.erase(m_thumbnailActive.key);
+        m_thumbnailActive = ThumbnailRequest();
+    }
+}
+
+bool ShaderLabIDE::ApplyThumbnailPageUpload(TextureUploadResult& result) {
+    for (size_t p = 0; p < m_thumbnailPages.size(); ++p) {
+        ThumbnailPage& page = m_thumbnailPages[p];
+        if (page.ticket == 0 || page.ticket != result.ticket) {
+            continue;
+        }
+        page.ticket = 0;
+        page.revision = page.ticketRevision; // A failed page is not retried until it changes again
+        if (!result.success) {
+            AppendDemoLog("[thumbnails] " + result.error);
+            return true;
+        }
+        page.texture = m_textureUploader->TakeTexture(result.ticket);
+        if (!page.texture || !m_deviceRef || !m_srvHeap) {
+            return true;
+        }
+        const UINT descriptorSize = m_deviceRef->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = m_srvHeap->GetCPUDescriptorHandleForHeapStart();
+        cpuHandle.ptr += static_cast<SIZE_T>(kThumbnailSrvIndex + p) * descriptorSize;
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MipLevels = 1;
+        m_deviceRef->GetDevice()->CreateShaderResourceView(page.texture.Get(), &srvDesc, cpuHandle);
+        return true;
+    }
+    return false;
+}
+
+void ShaderLabIDE::RenderShaderThumbnails(ID3D12GraphicsCommandList* commandList) {
+    if (!m_thumbnails || !m_thumbnailPso || m_thumbnailReadbackKey != 0) {
+        return;
+    }
+    if (!m_previewRenderer || !m_deviceRef || !commandList) {
+        return;
+    }
+    auto* device = m_deviceRef->GetDevice();
+    const ThumbnailAtlasDesc& desc = m_thumbnails->GetDesc();
+
+    if (!m_dummyTexture) {
+        CreateDummyTexture();
+    }
+
+    if (!m_thumbnailTarget) {
+        Dx12ResourceService resourceService(device);
+        TextureAllocationRequest textureRequest{};
+        textureRequest.width = desc.cellWidth;
+        textureRequest.height = desc.cellHeight;
+        textureRequest.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        textureRequest.flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+        textureRequest.initialState = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        ComPtr<ID3D12Resource> target;
+        if (!resourceService.AllocateTexture2D(textureRequest, target)) {
+            return;
+        }
+
+        D3D12_RESOURCE_DESC targetDesc = target->GetDesc();
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+        UINT numRows = 0;
+        UINT64 rowSizeInBytes = 0;
+        UINT64 totalBytes = 0;
+        device->GetCopyableFootprints(&targetDesc, 0, 1, 0, &footprint, &numRows, &rowSizeInBytes, &totalBytes);
+
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+        D3D12_RESOURCE_DESC bufferDesc = {};
+        bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        bufferDesc.Width = totalBytes;
+        bufferDesc.Height = 1;
+        bufferDesc.DepthOrArraySize = 1;
+        bufferDesc.MipLevels = 1;
+        bufferDesc.SampleDesc.Count = 1;
+        bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        void* mapped = nullptr;
+        if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+                                                   D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                   IID_PPV_ARGS(m_thumbnailReadback.ReleaseAndGetAddressOf()))) ||
+            FAILED(m_thumbnailReadback->Map(0, nullptr, &mapped)) || !mapped) {
+            m_thumbnailReadback.Reset();
+            return;
+        }
+        m_thumbnailReadbackMapped = static_cast<uint8_t*>(mapped);
+        m_thumbnailReadbackRowPitch = footprint.Footprint.RowPitch;
+
+        D3D12_DESCRIPTOR_HEAP_DESC rtvDesc{};
+        rtvDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+        rtvDesc.NumDescriptors = 1;
+        device->CreateDescriptorHeap(&rtvDesc, IID_PPV_ARGS(&m_thumbnailRtvHeap));
+        device->CreateRenderTargetView(target.Get(), nullptr, m_thumbnailRtvHeap->GetCPUDescriptorHandleForHeapStart());
+
+        const std::vector<uint8_t> testCard = MakeTestCard();
+        CreateTextureFromData(testCard.data(), kTestCardWidth, kTestCardHeight, 4, m_thumbnailTestCard);
+
+        D3D12_DESCRIPTOR_HEAP_DESC heapDesc{};
+        heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        heapDesc.NumDescriptors = kThumbnailInputSlots;
+        heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+        device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&m_thumbnailInputSrvHeap));
+
+        const UINT step = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+        srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2D.MipLevels = 1;
+        for (int slot = 0; slot < kThumbnailInputSlots; ++slot) {
+            D3D12_CPU_DESCRIPTOR_HANDLE cpu = m_thumbnailInputSrvHeap->GetCPUDescriptorHandleForHeapStart();
+            cpu.ptr += static_cast<SIZE_T>(slot) * step;
+            ID3D12Resource* input = (slot == 0 && m_thumbnailTestCard) ? m_thumbnailTestCard.Get() : m_dummyTexture.Get();
+            device->CreateShaderResourceView(input, &srvDesc, cpu);
+        }
+        m_thumbnailTarget = std::move(target);
+    }
+
+    D3D12_RESOURCE_BARRIER barrier{};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = m_thumbnailTarget.Get();
+    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    commandList->ResourceBarrier(1, &barrier);
+
+    ID3D12DescriptorHeap* heaps[] = { m_thumbnailInputSrvHeap.Get() };
+    commandList->SetDescriptorHeaps(1, heaps);
+
+    float iBeat = 0.0f;
+    float iBar = 0.0f;
+    float fBeat = 0.0f;
+    float fBarBeat = 0.0f;
+    float fBarBeat16 = 0.0f;
+    ComputeTutTiming(kThumbnailTimeSeconds, kThumbnailBpm, iBeat, iBar, fBeat, fBarBeat, fBarBeat16);
+
+    // Silent, so a thumbnail does not depend on what was playing when it was rendered.
+    m_previewRenderer->SetAudioConstants(AudioShaderBlock{});
+    m_previewRenderer->Render(
+        commandList,
+        m_thumbnailPso.Get(),
+        m_thumbnailTarget.Get(),
+        m_thumbnailRtvHeap->GetCPUDescriptorHandleForHeapStart(),
+        m_thumbnailInputSrvHeap->GetGPUDescriptorHandleForHeapStart(),
+        desc.cellWidth,
+        desc.cellHeight,
+        kThumbnailTimeSeconds,
+        iBeat,
+        iBar,
+        fBarBeat16,
+        fBeat,
+        fBarBeat);
+
+    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_COPY_SOURCE;
+    commandList->ResourceBarrier(1, &barrier);
+
+    D3D12_RESOURCE_DESC targetDesc = m_thumbnailTarget->GetDesc();
+    D3D12_TEXTURE_COPY_LOCATION srcLoc = {};
+    srcLoc.pResource = m_thumbnailTarget.Get();
+    srcLoc.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+    srcLoc.SubresourceIndex = 0;
+    D3D12_TEXTURE_COPY_LOCATION dstLoc = {};
+    dstLoc.pResource = m_thumbnailReadback.Get();
+    dstLoc.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+    device->GetCopyableFootprints(&targetDesc, 0, 1, 0, &dstLoc.PlacedFootprint, nullptr, nullptr, nullptr);
+    commandList->CopyTextureRegion(&dstLoc, 0, 0, 0, &srcLoc, nullptr);
+
+    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_SOURCE;
+    barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    commandList->ResourceBarrier(1, &barrier);
+
+    // The PSO stays alive until UpdateShaderThumbnails collects the copy.
+    m_thumbnailReadbackKey = m_thumbnailActive.key;
+    m_thumbnailActive = ThumbnailRequest();
+}
+
+void ShaderLabIDE::SaveShaderThumbnails() {
+    if (!m_thumbnails || !m_thumbnails->IsDirty() || m_thumbnailCachePath.empty()) {
+        return;
+    }
+    std::string error;
+    if (!m_thumbnails->Save(m_thumbnailCachePath, error)) {
+        AppendDemoLog("[thumbnails] " + error);
+    }
+}
+
+} // namespace ShaderLab
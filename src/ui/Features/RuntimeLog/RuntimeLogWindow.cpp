@@ -19,17 +19,18 @@ void ShaderLabIDE::ShowDemoRuntimeLogWindow() {
         ImGui::Checkbox("Auto-scroll", &m_demoLogAutoScroll);
         ImGui::Separator();
 
-        if (m_transitionActive) {
+        const SequencerState& transition = m_sequencer.GetState();
+        if (transition.transitionActive) {
             const double beatsPerSec = m_transport.bpm / 60.0f;
             const double exactBeat = m_transport.timeSeconds * beatsPerSec;
-            const double fromTime = SceneTimeSeconds(exactBeat, m_transitionFromStartBeat, m_transitionFromOffset, m_transport.bpm);
-            const double toTime = SceneTimeSeconds(exactBeat, m_transitionToStartBeat, m_transitionToOffset, m_transport.bpm);
-            const std::string transitionLabel = GetTransitionDisplayNameByStem(m_currentTransitionStem);
+            const double fromTime = SceneTimeSeconds(exactBeat, transition.transitionFromStartBeat, transition.transitionFromOffset, m_transport.bpm);
+            const double toTime = SceneTimeSeconds(exactBeat, transition.transitionToStartBeat, transition.transitionToOffset, m_transport.bpm);
+            const std::string transitionLabel = GetTransitionDisplayNameByStem(transition.transitionPresetStem);
             ImGui::Text("Transition: %s", transitionLabel.c_str());
             ImGui::TextUnformatted("A:");
             ImGui::SameLine();
             PushNumericFont();
-            ImGui::Text("%d", m_transitionFromIndex);
+            ImGui::Text("%d", transition.transitionFromIndex);
             PopNumericFont();
             ImGui::SameLine();
             ImGui::TextUnformatted("time");
@@ -41,7 +42,7 @@ void ShaderLabIDE::ShowDemoRuntimeLogWindow() {
             ImGui::TextUnformatted("B:");
             ImGui::SameLine();
             PushNumericFont();
-            ImGui::Text("%d", m_transitionToIndex);
+            ImGui::Text("%d", transition.transitionToIndex);
             PopNumericFont();
             ImGui::SameLine();
             ImGui::TextUnformatted("time");
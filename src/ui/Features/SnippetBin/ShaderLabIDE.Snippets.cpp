@@ -1,8 +1,10 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
+#include "ShaderLab/Core/AssetCatalog.h"
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <sstream>
 
 #include <nlohmann/json.hpp>
 
@@ -54,105 +56,99 @@ std::string SanitizeSnippetFileStem(const std::string& name) {
     }
     return result;
 }
-} // namespace
-
-void ShaderLabIDE::LoadGlobalSnippets() {
-    m_snippetFolders.clear();
-    m_selectedSnippetFolderIndex = -1;
-    m_selectedSnippetIndex = -1;
-    m_nextSnippetId = 1;
-
-    const fs::path snippetsDir = GetGlobalSnippetDirectory(m_workspaceRootPath, m_appRoot);
-    m_snippetsDirectoryPath = snippetsDir.string();
-
-    std::error_code ec;
-    fs::create_directories(snippetsDir, ec);
-
-    const fs::path backupSnippetsDir = GetSnippetBackupDirectory(m_appRoot);
-    if (fs::exists(backupSnippetsDir, ec)) {
-        for (const auto& entry : fs::directory_iterator(backupSnippetsDir, ec)) {
-            if (ec || !entry.is_regular_file()) {
-                continue;
-            }
 
-            const fs::path source = entry.path();
-            if (source.extension() != ".json") {
-                continue;
-            }
-
-            const fs::path destination = snippetsDir / source.filename();
-            if (!fs::exists(destination, ec)) {
-                fs::copy_file(source, destination, fs::copy_options::none, ec);
-            }
-        }
+bool ParseSnippetFolder(const std::string& text,
+                        const fs::path& filePath,
+                        const std::string& fallbackFolderName,
+                        ShaderSnippetFolder& outFolder) {
+    json root;
+    try {
+        root = json::parse(text);
+    } catch (...) {
+        return false;
     }
 
-    const auto loadFromFile = [this](const fs::path& filePath, const std::string& fallbackFolderName) {
-        std::ifstream in(filePath);
-        if (!in.is_open()) {
-            return;
-        }
+    if (!root.contains("snippets") || !root["snippets"].is_array()) {
+        return false;
+    }
 
-        json root;
-        try {
-            in >> root;
-        } catch (...) {
-            return;
-        }
+    outFolder.name = root.value("folder", fallbackFolderName);
+    outFolder.filePath = filePath.string();
 
-        if (!root.contains("snippets") || !root["snippets"].is_array()) {
-            return;
+    for (const auto& item : root["snippets"]) {
+        if (!item.is_object()) {
+            continue;
         }
 
-        ShaderSnippetFolder folder;
-        folder.name = root.value("folder", fallbackFolderName);
-        folder.filePath = filePath.string();
+        ShaderSnippet snippet;
+        snippet.name = item.value("name", std::string{});
+        snippet.code = item.value("code", std::string{});
 
-        for (const auto& item : root["snippets"]) {
-            if (!item.is_object()) {
-                continue;
-            }
+        if (snippet.name.empty() || snippet.code.empty()) {
+            continue;
+        }
 
-            ShaderSnippet snippet;
-            snippet.name = item.value("name", std::string{});
-            snippet.code = item.value("code", std::string{});
+        outFolder.snippets.push_back(std::move(snippet));
+    }
+    return true;
+}
+} // namespace
 
-            if (snippet.name.empty() || snippet.code.empty()) {
-                continue;
-            }
+void ShaderLabIDE::LoadGlobalSnippets() {
+    m_snippetFolders.clear();
+    m_selectedSnippetFolderIndex = -1;
+    m_selectedSnippetIndex = -1;
+    m_nextSnippetId = 1;
 
-            folder.snippets.push_back(std::move(snippet));
-            m_nextSnippetId = (std::max)(m_nextSnippetId, static_cast<int>(folder.snippets.size()) + 1);
-        }
+    const fs::path snippetsDir = GetGlobalSnippetDirectory(m_workspaceRootPath, m_appRoot);
+    m_snippetsDirectoryPath = snippetsDir.string();
 
+    const auto addFolder = [this](ShaderSnippetFolder folder) {
+        m_nextSnippetId = (std::max)(m_nextSnippetId, static_cast<int>(folder.snippets.size()) + 1);
         m_snippetFolders.push_back(std::move(folder));
     };
 
-    if (fs::exists(snippetsDir)) {
-        std::vector<fs::path> jsonFiles;
-        for (const auto& entry : fs::directory_iterator(snippetsDir, ec)) {
-            if (ec) {
-                break;
-            }
-
-            if (!entry.is_regular_file()) {
-                continue;
-            }
-
-            if (entry.path().extension() == ".json") {
-                jsonFiles.push_back(entry.path());
-            }
+    // The catalog worker seeds, reads and parses the folder files; only the first scan of a new
+    // folder is waited for. Later changes on disk are not merged in, so unsaved edits are kept.
+    if (m_assetCatalog) {
+        if (m_snippetsCollection < 0) {
+            AssetCollectionDesc desc;
+            desc.root = snippetsDir.string();
+            desc.seedFrom = GetSnippetBackupDirectory(m_appRoot).string();
+            desc.suffixes = { ".json" };
+            desc.createRoot = true;
+            desc.parse = [](const AssetEntry& entry) -> std::shared_ptr<const void> {
+                ShaderSnippetFolder folder;
+                if (!ParseSnippetFolder(*entry.content, fs::path(entry.path), entry.stem, folder)) {
+                    return nullptr;
+                }
+                return std::make_shared<ShaderSnippetFolder>(std::move(folder));
+            };
+            m_snippetsCollection = m_assetCatalog->AddCollection(std::move(desc));
+        } else {
+            m_assetCatalog->SetCollectionRoot(m_snippetsCollection, snippetsDir.string(),
+                                              GetSnippetBackupDirectory(m_appRoot).string());
         }
-
-        std::sort(jsonFiles.begin(), jsonFiles.end());
-        for (const auto& path : jsonFiles) {
-            loadFromFile(path, path.stem().string());
+        m_assetCatalog->WaitForScan(m_snippetsCollection, 2000);
+        if (const auto snapshot = m_assetCatalog->GetSnapshot(m_snippetsCollection)) {
+            for (const AssetEntry& entry : snapshot->entries) {
+                if (const ShaderSnippetFolder* folder = entry.Parsed<ShaderSnippetFolder>()) {
+                    addFolder(*folder);
+                }
+            }
         }
     }
 
     const fs::path legacyPath = GetLegacySnippetBaseDir(m_appRoot) / "snippets.json";
-    if (m_snippetFolders.empty() && fs::exists(legacyPath)) {
-        loadFromFile(legacyPath, "General");
+    std::error_code ec;
+    if (m_snippetFolders.empty() && fs::exists(legacyPath, ec)) {
+        std::ifstream in(legacyPath, std::ios::binary);
+        std::ostringstream text;
+        text << in.rdbuf();
+        ShaderSnippetFolder folder;
+        if (ParseSnippetFolder(text.str(), legacyPath, "General", folder)) {
+            addFolder(std::move(folder));
+        }
     }
 
     if (m_snippetFolders.empty()) {
@@ -233,6 +229,7 @@ void ShaderLabIDE::InsertSnippetIntoEditor(const std::string& snippetCode) {
         if (m_activeSceneIndex >= 0 && m_activeSceneIndex < (int)m_scenes.size()) {
             m_scenes[m_activeSceneIndex].shaderCode = m_shaderState.text;
             m_scenes[m_activeSceneIndex].isDirty = true;
+            NoteProjectEdit();
         }
     }
 
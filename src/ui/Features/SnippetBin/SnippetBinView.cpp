@@ -1,6 +1,8 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 #include "ShaderLab/UI/ShaderLabIDECore/ActionWidgets.h"
 #include "ShaderLab/UI/OpenFontIcons.h"
+#include "ShaderLab/UI/UISystemAssets.h"
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
 
 #include <imgui.h>
 
@@ -250,16 +252,43 @@ void ShaderLabIDE::ShowSnippetBin() {
         m_selectedSnippetIndex = 0;
     }
 
-    std::vector<const char*> snippetNames;
-    snippetNames.reserve(snippets.size());
-    for (const auto& snippet : snippets) {
-        snippetNames.push_back(snippet.name.c_str());
-    }
-
     ImGui::TextUnformatted("Snippet");
     ImGui::SameLine();
     ImGui::SetNextItemWidth(-1.0f);
-    ImGui::Combo("##SnippetSelector", &m_selectedSnippetIndex, snippetNames.data(), (int)snippetNames.size());
+    if (ImGui::BeginCombo("##SnippetSelector", snippets[m_selectedSnippetIndex].name.c_str(), ImGuiComboFlags_HeightLarge)) {
+        if (ImGui::IsWindowAppearing()) {
+            ImGui::SetKeyboardFocusHere();
+        }
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::InputTextWithHint("##SnippetFilter", "Filter snippets", m_snippetListFilter, sizeof(m_snippetListFilter));
+
+        // Names are only re-keyed when they change; only the visible rows are submitted.
+        m_snippetListSearch.Resize(snippets.size());
+        for (size_t i = 0; i < snippets.size(); ++i) {
+            m_snippetListSearch.SetItem(i, snippets[i].name);
+        }
+        const std::vector<int>& matches = m_snippetListSearch.Query(m_snippetListFilter);
+        ImGuiListClipper clipper;
+        clipper.Begin((int)matches.size());
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const int snippetIndex = matches[row];
+                ImGui::PushID(snippetIndex);
+                const bool isSelected = (snippetIndex == m_selectedSnippetIndex);
+                if (ImGui::Selectable(snippets[snippetIndex].name.c_str(), isSelected)) {
+                    m_selectedSnippetIndex = snippetIndex;
+                }
+                if (isSelected) {
+                    ImGui::SetItemDefaultFocus();
+                }
+                ImGui::PopID();
+            }
+        }
+        if (matches.empty()) {
+            ImGui::TextDisabled("No matching snippets.");
+        }
+        ImGui::EndCombo();
+    }
 
     auto& selected = snippets[m_selectedSnippetIndex];
 
@@ -321,6 +350,11 @@ void ShaderLabIDE::ShowSnippetBin() {
         ImGui::EndTable();
     }
 
+    // Whole shaders get a thumbnail; helper functions have nothing to draw.
+    if (LooksLikeSceneContract(selected.code)) {
+        DrawShaderThumbnail(selected.code, HashShaderText(selected.code), false, ImVec2(160.0f, 90.0f));
+    }
+
     ImGui::Separator();
     ImGui::TextUnformatted("Snippet Code");
     ImGui::SameLine();
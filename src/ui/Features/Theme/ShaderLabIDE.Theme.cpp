@@ -3,11 +3,12 @@
 #include <filesystem>
 #include <fstream>
 #include <system_error>
+#include <utility>
 
 #include "ShaderLab/UI/ShaderLabIDE.h"
+#include "ShaderLab/Core/TextureUploadQueue.h"
 #include "ShaderLab/Graphics/Device.h"
 #include <nlohmann/json.hpp>
-#include "stb_image.h"
 
 #include <imgui.h>
 
@@ -577,11 +578,16 @@ void ShaderLabIDE::SaveUiThemeSettings() const {
 void ShaderLabIDE::EnsureThemeBackgroundTexture() {
     std::string requestedPath = m_uiThemeColors.BackgroundImage;
     if (requestedPath.empty()) {
+        if (m_themeBackgroundTicket != 0 && m_textureUploads) {
+            m_textureUploads->Cancel(m_themeBackgroundTicket);
+        }
+        m_themeBackgroundTicket = 0;
         m_themeBackgroundTexture.Reset();
         m_themeBackgroundSrvGpuHandle = {};
         m_themeBackgroundWidth = 0;
         m_themeBackgroundHeight = 0;
         m_loadedThemeBackgroundPath.clear();
+        m_requestedThemeBackgroundPath.clear();
         return;
     }
 
@@ -592,34 +598,35 @@ void ShaderLabIDE::EnsureThemeBackgroundTexture() {
     resolvedPath = resolvedPath.lexically_normal();
     requestedPath = resolvedPath.string();
 
-    if (requestedPath == m_loadedThemeBackgroundPath && m_themeBackgroundTexture && m_themeBackgroundSrvGpuHandle.ptr != 0) {
+    if (requestedPath == m_requestedThemeBackgroundPath) {
         return;
     }
 
+    if (m_themeBackgroundTicket != 0 && m_textureUploads) {
+        m_textureUploads->Cancel(m_themeBackgroundTicket);
+    }
+    m_themeBackgroundTicket = 0;
     m_themeBackgroundTexture.Reset();
     m_themeBackgroundSrvGpuHandle = {};
     m_themeBackgroundWidth = 0;
     m_themeBackgroundHeight = 0;
     m_loadedThemeBackgroundPath.clear();
+    m_requestedThemeBackgroundPath.clear();
 
-    if (!m_deviceRef || !m_srvHeap || !fs::exists(resolvedPath)) {
+    if (!m_deviceRef || !m_srvHeap || !fs::exists(resolvedPath) || !EnsureTextureUploads()) {
         return;
     }
 
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    unsigned char* data = stbi_load(requestedPath.c_str(), &width, &height, &channels, 4);
-    if (!data || width <= 0 || height <= 0) {
-        if (data) stbi_image_free(data);
-        return;
-    }
+    // Decoded and uploaded in the background; ApplyThemeBackgroundTexture picks it up.
+    m_themeBackgroundTicket = m_textureUploads->RequestFile(requestedPath);
+    m_requestedThemeBackgroundPath = requestedPath;
+}
 
-    CreateTextureFromData(data, width, height, 4, m_themeBackgroundTexture);
-    stbi_image_free(data);
-    if (!m_themeBackgroundTexture) {
+void ShaderLabIDE::ApplyThemeBackgroundTexture(ComPtr<ID3D12Resource> texture, int width, int height, const std::string& path) {
+    if (!texture || !m_deviceRef || !m_srvHeap) {
         return;
     }
+    m_themeBackgroundTexture = std::move(texture);
 
     constexpr UINT kThemeBackgroundSrvIndex = 126;
     const UINT descriptorSize = m_deviceRef->GetDevice()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -638,7 +645,7 @@ void ShaderLabIDE::EnsureThemeBackgroundTexture() {
     m_themeBackgroundSrvGpuHandle.ptr += static_cast<SIZE_T>(kThemeBackgroundSrvIndex) * descriptorSize;
     m_themeBackgroundWidth = width;
     m_themeBackgroundHeight = height;
-    m_loadedThemeBackgroundPath = requestedPath;
+    m_loadedThemeBackgroundPath = path;
 }
 
 void ShaderLabIDE::DrawThemeBackgroundTiled() {
@@ -1,5 +1,6 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 #include "ShaderLab/UI/OpenFontIcons.h"
+#include "ShaderLab/UI/UISystemAssets.h"
 
 #include <imgui.h>
 
@@ -7,14 +8,15 @@
 #include <cctype>
 #include <cmath>
 #include <filesystem>
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <shellapi.h>
 
+#include "ShaderLab/Core/AssetCatalog.h"
 #include "ShaderLab/Core/CompilationService.h"
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/Dx12ResourceService.h"
 #include "ShaderLab/Graphics/PreviewRenderer.h"
@@ -26,16 +28,6 @@ namespace fs = std::filesystem;
 
 constexpr UINT kTutsPreviewSrvIndex = 121;
 
-std::string ReadAllText(const fs::path& path) {
-    std::ifstream in(path, std::ios::binary);
-    if (!in.is_open()) {
-        return {};
-    }
-    std::ostringstream ss;
-    ss << in.rdbuf();
-    return ss.str();
-}
-
 std::string HumanizeStem(const std::string& stem) {
     std::string out;
     out.reserve(stem.size());
@@ -209,109 +201,55 @@ void RenderMarkdownLine(const std::string& line, const ImVec4& headingColor, flo
     }
 }
 
-bool LooksLikeSceneContract(const std::string& code) {
-    if (code.find("float4 main") != std::string::npos &&
-        code.find("fragCoord") != std::string::npos &&
-        code.find("iResolution") != std::string::npos &&
-        code.find("iTime") != std::string::npos) {
-        return true;
-    }
-    if (code.find("mainImage") != std::string::npos) {
-        return true;
-    }
-    return false;
-}
-
-void ComputeTutTiming(double timeSeconds,
-                      float bpm,
-                      float& outIBeat,
-                      float& outIBar,
-                      float& outFBeat,
-                      float& outFBarBeat,
-                      float& outFBarBeat16) {
-    constexpr float kBeatsPerBar = 4.0f;
-    constexpr float kSixteenthPerBeat = 4.0f;
-
-    const float beatsPerSecond = bpm / 60.0f;
-    float exactBeat = static_cast<float>(timeSeconds * static_cast<double>(beatsPerSecond));
-    if (exactBeat < 0.0f) {
-        exactBeat = 0.0f;
-    }
-
-    const float beat = std::floor(exactBeat);
-    const float bar = std::floor(beat / kBeatsPerBar);
-    const float beatInBar = exactBeat - std::floor(exactBeat / kBeatsPerBar) * kBeatsPerBar;
-    float barBeat16 = std::floor(beatInBar * kSixteenthPerBeat);
-    barBeat16 = (std::max)(0.0f, (std::min)(15.0f, barBeat16));
-
-    outIBeat = beat;
-    outIBar = bar;
-    outFBeat = exactBeat;
-    outFBarBeat = beatInBar;
-    outFBarBeat16 = barBeat16;
-}
-
 } // namespace
 
-void ShaderLabIDE::RefreshTutsCatalog(bool force) {
-    const double now = ImGui::GetTime();
-    if (!force && (now - m_tutsLastScanTime) < 1.0) {
+void ShaderLabIDE::RefreshTutsCatalog() {
+    if (!m_assetCatalog) {
         return;
     }
-    m_tutsLastScanTime = now;
-
-    m_tutTopics.clear();
-    m_tutsMenuVisible = false;
-
-    const fs::path tutsRoot = fs::path(m_appRoot) / "editor_assets" / "tuts";
-    std::error_code ec;
-    if (!fs::exists(tutsRoot, ec) || !fs::is_directory(tutsRoot, ec)) {
-        return;
+    if (m_tutsCollection < 0) {
+        AssetCollectionDesc desc;
+        desc.root = (fs::path(m_appRoot) / "editor_assets" / "tuts").string();
+        desc.suffixes = { ".md" };
+        desc.maxDepth = 1;
+        desc.loadContent = true;
+        m_tutsCollection = m_assetCatalog->AddCollection(std::move(desc));
     }
 
-    std::vector<fs::path> topicDirs;
-    for (const auto& entry : fs::directory_iterator(tutsRoot, ec)) {
-        if (ec) {
-            break;
-        }
-        if (entry.is_directory()) {
-            topicDirs.push_back(entry.path());
-        }
+    const auto snapshot = m_assetCatalog->GetSnapshot(m_tutsCollection);
+    if (!snapshot || snapshot->generation == m_tutsGeneration) {
+        return;
     }
-    std::sort(topicDirs.begin(), topicDirs.end());
-
-    for (const auto& topicPath : topicDirs) {
-        TutTopic topic;
-        topic.name = HumanizeStem(topicPath.filename().string());
-
-        std::vector<fs::path> files;
-        for (const auto& file : fs::directory_iterator(topicPath, ec)) {
-            if (ec) {
-                break;
-            }
-            if (file.is_regular_file() && file.path().extension() == ".md") {
-                files.push_back(file.path());
-            }
-        }
-        std::sort(files.begin(), files.end());
+    m_tutsGeneration = snapshot->generation;
 
-        for (const auto& filePath : files) {
-            TutItem item;
-            item.title = HumanizeStem(filePath.stem().string());
-            item.filePath = filePath.string();
-            topic.items.push_back(std::move(item));
+    // Entries are sorted by relative path, so each topic folder's pages arrive together.
+    m_tutTopics.clear();
+    std::string currentTopic;
+    for (const AssetEntry& entry : snapshot->entries) {
+        const size_t slash = entry.relativePath.find('/');
+        if (slash == std::string::npos) {
+            continue;
         }
-
-        if (!topic.items.empty()) {
+        const std::string topicFolder = entry.relativePath.substr(0, slash);
+        if (m_tutTopics.empty() || topicFolder != currentTopic) {
+            currentTopic = topicFolder;
+            TutTopic topic;
+            topic.name = HumanizeStem(topicFolder);
             m_tutTopics.push_back(std::move(topic));
         }
+
+        TutItem item;
+        item.title = HumanizeStem(entry.stem);
+        item.filePath = entry.path;
+        item.markdown = entry.content;
+        m_tutTopics.back().items.push_back(std::move(item));
     }
 
     m_tutsMenuVisible = !m_tutTopics.empty();
 }
 
 void ShaderLabIDE::ShowTutsMenu() {
-    RefreshTutsCatalog(false);
+    RefreshTutsCatalog();
     if (!m_tutsMenuVisible) {
         return;
     }
@@ -323,7 +261,7 @@ void ShaderLabIDE::ShowTutsMenu() {
                 for (int itemIndex = 0; itemIndex < (int)topic.items.size(); ++itemIndex) {
                     const auto& item = topic.items[itemIndex];
                     if (ImGui::MenuItem(item.title.c_str())) {
-                        const std::string markdown = ReadAllText(item.filePath);
+                        const std::string markdown = item.markdown ? *item.markdown : std::string();
                         if (markdown.empty()) {
                             m_tutErrorMessage = "Failed to load tutorial markdown file.";
                             continue;
@@ -347,6 +285,7 @@ void ShaderLabIDE::ShowTutsMenu() {
                             if (fence && inCode) {
                                 TutCodeBlock block;
                                 block.code = code;
+                                block.hash = HashShaderText(code);
                                 block.looksLikeSceneContract = LooksLikeSceneContract(code);
                                 m_tutActiveDocument.codeBlocks.push_back(std::move(block));
                                 inCode = false;
@@ -365,18 +304,13 @@ void ShaderLabIDE::ShowTutsMenu() {
                         m_showTutsPopup = true;
                         m_tutErrorMessage.clear();
 
+                        // Examples show their atlas thumbnail; only an activated one compiles and runs live.
                         m_tutActiveCodeBlockIndex = -1;
                         m_tutDisplayedCodeBlockIndex = -1;
-                        for (int i = 0; i < (int)m_tutActiveDocument.codeBlocks.size(); ++i) {
-                            if (m_tutActiveDocument.codeBlocks[i].looksLikeSceneContract) {
-                                m_tutActiveCodeBlockIndex = i;
-                                m_tutPreviewSourceCode = m_tutActiveDocument.codeBlocks[i].code;
-                                m_tutPreviewPso.Reset();
-                                m_tutPreviewTimeSeconds = 0.0;
-                                m_tutPreviewPlaying = true;
-                                break;
-                            }
-                        }
+                        m_tutPreviewSourceCode.clear();
+                        m_tutPreviewPso.Reset();
+                        m_tutPreviewTimeSeconds = 0.0;
+                        m_tutPreviewPlaying = true;
                         ImGui::OpenPopup("Tutorial");
                     }
                 }
@@ -503,6 +437,8 @@ void ShaderLabIDE::ShowTutsPopup() {
                     m_tutActiveDocument.codeBlocks[codeIndex].looksLikeSceneContract) {
                     const bool active = (m_tutActiveCodeBlockIndex == codeIndex);
                     if (!active) {
+                        const TutCodeBlock& block = m_tutActiveDocument.codeBlocks[codeIndex];
+                        DrawShaderThumbnail(block.code, block.hash, false, ImVec2(320.0f, 180.0f));
                         if (ImGui::Button("Activate Preview")) {
                             m_tutActiveCodeBlockIndex = codeIndex;
                             m_tutPreviewSourceCode = m_tutActiveDocument.codeBlocks[codeIndex].code;
@@ -585,6 +521,7 @@ void ShaderLabIDE::ShowTutsPopup() {
                         newScene.isDirty = true;
 
                         m_scenes.push_back(std::move(newScene));
+                        NoteProjectEdit();
                         const int newSceneIndex = static_cast<int>(m_scenes.size()) - 1;
 
                         SetActiveScene(newSceneIndex);
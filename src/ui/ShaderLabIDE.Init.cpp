@@ -9,6 +9,10 @@
 #include "ShaderLab/UI/UIConfig.h"
 #include "ShaderLab/Graphics/Device.h"
 #include "ShaderLab/Graphics/Swapchain.h"
+#include "ShaderLab/Graphics/CommandQueue.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/Core/DxcCompilationService.h"
 
 #include <imgui.h>
@@ -19,6 +23,13 @@ namespace ShaderLab {
 
 namespace fs = std::filesystem;
 
+namespace {
+
+constexpr uint32_t kDescriptorCacheCapacity = 1024;
+constexpr uint32_t kDescriptorRingCapacity = 8192;
+
+} // namespace
+
 bool ShaderLabIDE::Initialize(HWND hwnd, Device* device, Swapchain* swapchain) {
     if (!device || !device->IsValid() || !swapchain || !hwnd) {
         return false;
@@ -166,6 +177,19 @@ bool ShaderLabIDE::Initialize(HWND hwnd, Device* device, Swapchain* swapchain) {
     m_deviceRef = device;
     m_swapchainRef = swapchain;
     m_compilationService = std::make_unique<DxcCompilationService>();
+    m_asyncCompiler = std::make_unique<AsyncCompilationService>(
+        []() { return std::make_unique<DxcCompilationService>(); },
+        AsyncCompilationService::DefaultWorkerCount());
+    m_asyncCompiler->SetBytecodeCache(m_bytecodeCache);
+    // The editor waits for the GPU every frame, so two slots are enough for readback.
+    m_profiler = std::make_unique<GpuProfiler>(2);
+    if (swapchain->GetCommandQueue()) {
+        m_profiler->Initialize(device->GetDevice(), swapchain->GetCommandQueue()->GetQueue());
+    }
+    m_descriptorRing = std::make_unique<DescriptorRingService>();
+    if (!m_descriptorRing->Initialize(device->GetDevice(), kDescriptorCacheCapacity, kDescriptorRingCapacity)) {
+        m_descriptorRing.reset(); // Post-FX passes are skipped without it
+    }
     CreateTitlebarIconTexture();
 
     if (m_workspaceSelectionPromptPending) {
@@ -20,8 +20,18 @@
 #include "ShaderLab/UI/UISystemDemoUtils.h"
 #include "ShaderLab/UI/UISystemAssets.h"
 #include "ShaderLab/UI/AboutAssets.h"
+#include "ShaderLab/Core/AssetCatalog.h"
+#include "ShaderLab/Core/AsyncCompilationService.h"
 #include "ShaderLab/Core/CompilationService.h"
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
+#include "ShaderLab/Core/ProjectCompileBatch.h"
+#include "ShaderLab/Core/TextureUploadQueue.h"
+#include "ShaderLab/Core/ThumbnailCache.h"
+#include "ShaderLab/Core/VideoExportPipeline.h"
 #include "ShaderLab/Audio/AudioSystem.h"
+#include "ShaderLab/Graphics/DescriptorRingService.h"
+#include "ShaderLab/Graphics/GpuProfiler.h"
+#include "ShaderLab/Graphics/TextureUploader.h"
 
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -127,7 +137,9 @@ ShaderLabIDE::ShaderLabIDE() {
     ResolveWorkspaceRootPath();
     m_workspaceSelectionPromptPending = !m_workspaceExplicitlyConfigured;
     EnsureWorkspaceFolders();
-    InitializePresetService(m_workspaceRootPath, m_appRoot);
+    m_assetCatalog = std::make_unique<AssetCatalog>();
+    m_assetCatalog->Start();
+    InitializePresetService(*m_assetCatalog, m_workspaceRootPath, m_appRoot);
     AboutAssets::Get().Initialize(m_workspaceRootPath, m_appRoot);
 
     LoadGlobalUiBuildSettings();
@@ -160,6 +172,7 @@ void ShaderLabIDE::Shutdown() {
     SaveUiThemeSettings();
 
     SaveGlobalUiBuildSettings();
+    SaveShaderThumbnails();
 
     if (m_initialized) {
         ImGui_ImplDX12_Shutdown();
@@ -177,8 +190,30 @@ void ShaderLabIDE::Shutdown() {
     m_themeBackgroundHeight = 0;
     m_loadedThemeBackgroundPath.clear();
     m_previewRtvHeap.Reset();
+    m_thumbnailPages.clear();
+    m_thumbnailPso.Reset();
+    m_thumbnailTarget.Reset();
+    m_thumbnailReadback.Reset();
+    m_thumbnailReadbackMapped = nullptr;
+    m_thumbnailTestCard.Reset();
     m_srvHeap.Reset();
+    CancelPreviewVideoExport(false);
+    m_textureUploads.reset();
+    m_textureUploader.reset(); // Waits for uploads still on the GPU
+    m_fileTextureTickets.clear();
+    m_fileTextureLoadsByPath.clear();
+    m_themeBackgroundTicket = 0;
+    m_requestedThemeBackgroundPath.clear();
+    m_projectCompileBatch.reset();
+    m_projectCompiler.reset();
+    m_asyncCompiler.reset();
     m_compilationService.reset();
+    m_profiler.reset();
+    m_descriptorRing.reset();
+    m_linkedShaders.reset();
+    if (m_assetCatalog) {
+        m_assetCatalog->Stop();
+    }
     m_initialized = false;
 }
 
@@ -1,5 +1,6 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 #include "ShaderLab/Core/CompilationService.h"
+#include "ShaderLab/Core/ProjectCompileBatch.h"
 #include "ShaderLab/UI/ShaderLabIDECore/ActionWidgets.h"
 #include "ShaderLab/UI/OpenFontIcons.h"
 #include "ShaderLab/UI/UISystemAssets.h"
@@ -179,40 +180,13 @@ void ShaderLabIDE::ShowShaderEditorSearchReplaceBar() {
     ImGui::InputText("##Search", m_shaderState.searchBuffer, sizeof(m_shaderState.searchBuffer));
     ImGui::SameLine();
     if (LabeledActionButton("FindNext", OpenFontIcons::kSearch, "Next", "Find next", ImVec2(120.0f, 0.0f))) {
-        std::string searchStr = m_shaderState.searchBuffer;
-        if (!searchStr.empty()) {
-            std::string text = m_textEditor.GetText();
-            auto cursor = m_textEditor.GetCursorPosition();
-
-            auto lines = m_textEditor.GetTextLines();
-            size_t textPos = 0;
-            for (int i = 0; i < cursor.mLine && i < (int)lines.size(); i++) {
-                textPos += lines[i].length() + 1;
-            }
-            textPos += cursor.mColumn;
-            textPos += 1;
-
-            size_t found = text.find(searchStr, textPos);
-            if (found == std::string::npos) {
-                found = text.find(searchStr, 0);
-            }
-
-            if (found != std::string::npos) {
-                TextEditor::Coordinates newPos;
-                size_t pos = 0;
-                for (int line = 0; line < (int)lines.size(); line++) {
-                    if (pos + lines[line].length() >= found) {
-                        newPos.mLine = line;
-                        newPos.mColumn = (int)(found - pos);
-                        break;
-                    }
-                    pos += lines[line].length() + 1;
-                }
-                m_textEditor.SetCursorPosition(newPos);
-                TextEditor::Coordinates endPos = newPos;
-                endPos.mColumn += (int)searchStr.length();
-                m_textEditor.SetSelection(newPos, endPos);
-            }
+        const std::string searchStr = m_shaderState.searchBuffer;
+        TextEditor::Coordinates matchStart;
+        TextEditor::Coordinates matchEnd;
+        if (!searchStr.empty() &&
+            m_textEditor.FindNext(searchStr, m_textEditor.GetCursorPosition(), matchStart, matchEnd)) {
+            m_textEditor.SetCursorPosition(matchStart);
+            m_textEditor.SetSelection(matchStart, matchEnd);
         }
     }
 
@@ -222,36 +196,11 @@ void ShaderLabIDE::ShowShaderEditorSearchReplaceBar() {
     ImGui::InputText("##Replace", m_shaderState.replaceBuffer, sizeof(m_shaderState.replaceBuffer));
     ImGui::SameLine();
     if (LabeledActionButton("ReplaceAll", OpenFontIcons::kRefresh, "Replace All", "Replace all", ImVec2(120.0f, 0.0f))) {
-        std::string search = m_shaderState.searchBuffer;
-        std::string replace = m_shaderState.replaceBuffer;
-        if (!search.empty()) {
-            std::string text = m_textEditor.GetText();
-            size_t pos = 0;
-            int count = 0;
-            while ((pos = text.find(search, pos)) != std::string::npos) {
-                text.replace(pos, search.length(), replace);
-                pos += replace.length();
-                count++;
-            }
-            if (count > 0) {
-                m_textEditor.SetText(text);
-                m_shaderState.text = text;
-                if (m_currentMode == UIMode::PostFX) {
-                    if (m_postFxSelectedIndex >= 0 && m_postFxSelectedIndex < (int)m_postFxDraftChain.size()) {
-                        auto& effect = m_postFxDraftChain[m_postFxSelectedIndex];
-                        effect.shaderCode = text;
-                        effect.isDirty = true;
-                    } else if (m_computeEffectSelectedIndex >= 0 && m_computeEffectSelectedIndex < (int)m_computeEffectDraftChain.size()) {
-                        auto& effect = m_computeEffectDraftChain[m_computeEffectSelectedIndex];
-                        effect.shaderCode = text;
-                        effect.isDirty = true;
-                    }
-                } else if (m_editingSceneIndex >= 0 && m_editingSceneIndex < (int)m_scenes.size() &&
-                           m_activeSceneIndex == m_editingSceneIndex) {
-                    m_scenes[m_editingSceneIndex].shaderCode = text;
-                }
-                m_shaderState.status = CompileStatus::Dirty;
-            }
+        const std::string search = m_shaderState.searchBuffer;
+        const std::string replace = m_shaderState.replaceBuffer;
+        // Edits the editor in place as one undo step; ShowShaderEditorBody picks up the changed text.
+        if (!search.empty() && !m_textEditor.IsReadOnly()) {
+            m_textEditor.ReplaceAll(search, replace);
         }
     }
 
@@ -411,7 +360,7 @@ void ShaderLabIDE::ShowShaderEditorThemeAndFontControls() {
 }
 
 void ShaderLabIDE::CompileShaderEditorSelection() {
-    if (!m_compilationService) {
+    if (!m_compilationService || !m_asyncCompiler) {
         return;
     }
 
@@ -436,21 +385,18 @@ void ShaderLabIDE::CompileShaderEditorSelection() {
                 }
             }
 
-            for (auto& effect : m_postFxDraftChain) {
+            // Effects compile in the background; ApplyCompletedCompiles reports the chain.
+            bool anySubmitted = false;
+            for (int i = 0; i < (int)m_postFxDraftChain.size(); ++i) {
+                const auto& effect = m_postFxDraftChain[i];
                 if (!effect.pipelineState || effect.isDirty) {
-                    std::vector<std::string> fxErrors;
-                    if (!CompilePostFxEffect(effect, fxErrors)) {
-                        anyErrors = true;
-                        for (const auto& error : fxErrors) {
-                            Diagnostic diag;
-                            diag.message = effect.name + ": " + error;
-                            m_shaderState.diagnostics.push_back(diag);
-                        }
-                    }
+                    anySubmitted = SubmitPostFxCompile(m_postFxSourceSceneIndex, i, effect) || anySubmitted;
                 }
             }
 
-            if (anyErrors) {
+            if (anySubmitted) {
+                m_postFxDraftCompileFailed = anyErrors;
+            } else if (anyErrors) {
                 m_shaderState.status = CompileStatus::Error;
                 m_playbackBlockedByCompileError = true;
             } else {
@@ -508,22 +454,10 @@ void ShaderLabIDE::CompileShaderEditorSelection() {
 
         m_scenes[m_editingSceneIndex].shaderCode = m_shaderState.text;
         m_scenes[m_editingSceneIndex].isDirty = true;
+        NoteProjectEdit();
 
-        if (CompileScene(m_editingSceneIndex)) {
-            m_shaderState.status = CompileStatus::Success;
-            m_shaderState.lastCompiledText = m_shaderState.text;
-            m_playbackBlockedByCompileError = false;
-        } else {
-            if (m_editingSceneIndex >= 0 && m_editingSceneIndex < (int)m_scenes.size()) {
-                m_scenes[m_editingSceneIndex].compiledShaderBytes = 0;
-            } else {
-                Diagnostic diag;
-                diag.message = "No active scene selected.";
-                m_shaderState.diagnostics.push_back(diag);
-            }
-            m_shaderState.status = CompileStatus::Error;
-            m_playbackBlockedByCompileError = true;
-        }
+        // The previous pipeline keeps rendering until ApplyCompletedCompiles swaps in the result.
+        SubmitSceneCompile(m_editingSceneIndex);
     }
 
     RefreshPresetService();
@@ -594,6 +528,11 @@ void ShaderLabIDE::ShowShaderEditorHeader(bool editorFocused, bool ctrlEnterPres
     ImGui::AlignTextToFramePadding();
     ImGui::TextColored(statusColor, "%s", statusText);
     ShowShaderEditorCompiledByteSize();
+    if (m_projectCompileBatch && m_projectCompileBatch->IsActive()) {
+        ImGui::SameLine(0.0f, 14.0f);
+        ImGui::TextColored(m_uiThemeColors.IconColor, "Project %zu/%zu",
+                           m_projectCompileBatch->GetCompleted(), m_projectCompileBatch->GetTotal());
+    }
     ImGui::SameLine(0.0f, 14.0f);
     ImGui::TextDisabled("Auto-indent: Alt+Shift+F");
     ShowShaderEditorThemeAndFontControls();
@@ -666,6 +605,7 @@ void ShaderLabIDE::ShowShaderEditorBody(bool editorFocused, bool ctrlEnterPresse
                 (m_currentMode != UIMode::Scene || m_activeSceneIndex == m_editingSceneIndex)) {
                 m_scenes[m_editingSceneIndex].shaderCode = m_shaderState.text;
                 m_scenes[m_editingSceneIndex].isDirty = true;
+                NoteProjectEdit();
             }
         }
         if (m_shaderState.text != m_shaderState.lastCompiledText) {
@@ -675,8 +615,10 @@ void ShaderLabIDE::ShowShaderEditorBody(bool editorFocused, bool ctrlEnterPresse
 }
 
 void ShaderLabIDE::ShowShaderEditor() {
+    m_shaderEditorFocused = false;
     if (ImGui::Begin("Shader Editor")) {
         const bool editorFocused = ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows);
+        m_shaderEditorFocused = editorFocused;
         const bool ctrlDown = ImGui::IsKeyDown(ImGuiKey_LeftCtrl) || ImGui::IsKeyDown(ImGuiKey_RightCtrl);
         const bool shiftDown = ImGui::IsKeyDown(ImGuiKey_LeftShift) || ImGui::IsKeyDown(ImGuiKey_RightShift);
         const bool altDown = ImGui::IsKeyDown(ImGuiKey_LeftAlt) || ImGui::IsKeyDown(ImGuiKey_RightAlt);
@@ -703,6 +645,7 @@ void ShaderLabIDE::ShowShaderEditor() {
                            (m_currentMode != UIMode::Scene || m_activeSceneIndex == m_editingSceneIndex)) {
                     m_scenes[m_editingSceneIndex].shaderCode = formatted;
                     m_scenes[m_editingSceneIndex].isDirty = true;
+                    NoteProjectEdit();
                 }
 
                 if (m_shaderState.text != m_shaderState.lastCompiledText) {
@@ -744,6 +687,8 @@ void ShaderLabIDE::ShowShaderEditor() {
                 ImGui::TextDisabled("Note: iResolution/iTime are engine constants and are also forwarded to main(fragCoord, iResolution, iTime) for compatibility.");
                 ImGui::BulletText("iBeat, iBar : float");
                 ImGui::BulletText("fBeat, fBarBeat, fBarBeat16 : float");
+                ImGui::BulletText("iAudioRms, iAudioOnset, iAudioPeak : float (live music analysis)");
+                ImGui::BulletText("iAudioBands[2] : float4 (8 band levels, low to high)");
                 ImGui::BulletText("iChannel0..iChannel7 : texture inputs");
                 ImGui::BulletText("iSampler0 : sampler state");
             }
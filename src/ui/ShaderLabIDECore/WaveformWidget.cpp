@@ -0,0 +1,50 @@
+#include "ShaderLab/UI/ShaderLabIDECore/WaveformWidget.h"
+#include "ShaderLab/Core/WaveformPyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ShaderLab::EditorWaveformWidgets {
+
+void DrawWaveform(const WaveformPyramid* pyramid, double startSeconds, double endSeconds, const ImVec2& size) {
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = (std::max)(1.0f, std::floor(size.x > 0.0f ? size.x : ImGui::GetContentRegionAvail().x));
+    const float height = (std::max)(1.0f, size.y);
+    ImGui::Dummy(ImVec2(width, height));
+    if (!ImGui::IsItemVisible()) {
+        return;
+    }
+
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    const float middle = origin.y + height * 0.5f;
+    const float halfHeight = height * 0.5f;
+    const ImU32 peakColor = ImGui::GetColorU32(ImGuiCol_PlotLines, 0.55f);
+    const ImU32 rmsColor = ImGui::GetColorU32(ImGuiCol_PlotLines);
+    if (!pyramid || pyramid->IsEmpty()) {
+        drawList->AddLine(ImVec2(origin.x, middle), ImVec2(origin.x + width, middle), ImGui::GetColorU32(ImGuiCol_Border));
+        return;
+    }
+
+    // One column per pixel, so the cost follows the widget width and not the clip length.
+    static std::vector<WaveformColumn> columns;
+    const uint32_t columnCount = static_cast<uint32_t>(width);
+    columns.resize(columnCount);
+    pyramid->Query(startSeconds, endSeconds, columnCount, columns.data());
+    for (uint32_t c = 0; c < columnCount; ++c) {
+        const WaveformColumn& column = columns[c];
+        if (!column.valid) {
+            continue;
+        }
+        const float x = origin.x + static_cast<float>(c) + 0.5f;
+        const float top = middle - column.max * halfHeight;
+        const float bottom = middle - column.min * halfHeight;
+        drawList->AddLine(ImVec2(x, top), ImVec2(x, (std::max)(bottom, top + 1.0f)), peakColor);
+        const float rms = (std::min)(column.rms, (std::max)(column.max, -column.min)) * halfHeight;
+        if (rms >= 0.5f) {
+            drawList->AddLine(ImVec2(x, middle - rms), ImVec2(x, middle + rms), rmsColor);
+        }
+    }
+}
+
+}
@@ -1,5 +1,6 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 #include "ShaderLab/UI/ShaderLabIDECore/ActionWidgets.h"
+#include "ShaderLab/UI/ShaderLabIDECore/WaveformWidget.h"
 #include "ShaderLab/UI/OpenFontIcons.h"
 #include "ShaderLab/Audio/AudioSystem.h"
 
@@ -8,13 +9,183 @@
 #include <commdlg.h>
 #pragma comment(lib, "Comdlg32.lib")
 
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <string>
+#include <vector>
 
 namespace ShaderLab {
 
 using EditorActionWidgets::LabeledActionButton;
 
+namespace {
+
+std::filesystem::path GetCacheDir(const std::string& appRoot) {
+    std::filesystem::path baseDir;
+    char* appData = nullptr;
+    size_t appDataLen = 0;
+    if (_dupenv_s(&appData, &appDataLen, "APPDATA") == 0 && appData && *appData) {
+        baseDir = std::filesystem::path(appData) / "ShaderLab";
+    } else {
+        baseDir = std::filesystem::path(appRoot) / ".shaderlab";
+    }
+    if (appData) {
+        free(appData);
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(baseDir, ec);
+    return baseDir;
+}
+
+std::string GetTempoCachePath(const std::string& appRoot) {
+    return (GetCacheDir(appRoot) / "tempo_cache.txt").string();
+}
+
+// Worker side of StartTempoDetection; a clip that was analyzed before is only hashed.
+bool DetectTempo(const std::string& path, const std::shared_ptr<TempoAnalysisCache>& cache, const std::string& cachePath,
+                 TempoAnalysisResult& outResult, std::string& outError) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        outError = "Cannot open " + path;
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const uint64_t hash = HashTempoSource(bytes.data(), bytes.size());
+    if (cache->Find(hash, outResult)) {
+        return true;
+    }
+    std::vector<float> samples;
+    uint32_t sampleRate = 0;
+    if (!AudioSystem::DecodeMono(bytes.data(), bytes.size(), samples, sampleRate, outError) ||
+        !AnalyzeTempo(samples.data(), samples.size(), sampleRate, TempoAnalysisOptions(), outResult, outError)) {
+        return false;
+    }
+    cache->Store(hash, outResult);
+    std::string saveError;
+    cache->Save(cachePath, saveError);
+    return true;
+}
+
+// Worker side of RequestWaveform: the sidecar of a known file is loaded, anything else is
+// decoded and reduced chunk by chunk without holding the decoded clip.
+bool BuildWaveform(const std::string& path, const std::string& cacheDir, WaveformPyramid& outPyramid, std::string& outError) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        outError = "Cannot open " + path;
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const uint64_t hash = HashTempoSource(bytes.data(), bytes.size());
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.slwave", static_cast<unsigned long long>(hash));
+    const std::string sidecarPath = (std::filesystem::path(cacheDir) / name).string();
+    std::string loadError;
+    if (WaveformPyramid::Load(sidecarPath, outPyramid, loadError) && outPyramid.GetSourceHash() == hash) {
+        return true;
+    }
+
+    WaveformPyramidBuilder builder;
+    uint32_t sampleRate = 0;
+    if (!builder.Begin(WaveformBuildOptions(), outError) ||
+        !AudioSystem::DecodeMono(bytes.data(), bytes.size(), [&](const float* samples, size_t count) {
+            builder.Append(samples, count);
+        }, sampleRate, outError) ||
+        !builder.Finish(sampleRate, outPyramid, outError)) {
+        return false;
+    }
+    outPyramid.SetSourceHash(hash);
+    std::string saveError;
+    outPyramid.Save(sidecarPath, saveError);
+    return true;
+}
+
+} // namespace
+
+const WaveformPyramid* ShaderLabIDE::RequestWaveform(const std::string& clipPath) {
+    auto it = m_waveforms.find(clipPath);
+    if (it == m_waveforms.end()) {
+        if (m_waveformCacheDir.empty()) {
+            const std::filesystem::path dir = GetCacheDir(m_appRoot) / "waveforms";
+            std::error_code ec;
+            std::filesystem::create_directories(dir, ec);
+            m_waveformCacheDir = dir.string();
+        }
+        auto build = std::make_unique<WaveformBuild>();
+        WaveformBuild* job = build.get();
+        build->done = std::async(std::launch::async, [job, path = clipPath, cacheDir = m_waveformCacheDir]() {
+            return BuildWaveform(path, cacheDir, job->pyramid, job->error);
+        });
+        m_waveforms.emplace(clipPath, std::move(build));
+        return nullptr;
+    }
+    WaveformBuild& build = *it->second;
+    if (!build.ready && !build.failed && build.done.valid() &&
+        build.done.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        if (build.done.get()) {
+            build.ready = true;
+        } else {
+            build.failed = true;
+            AppendDemoLog("[waveform] " + clipPath + ": " + build.error);
+        }
+    }
+    return build.ready ? &build.pyramid : nullptr;
+}
+
+void ShaderLabIDE::StartTempoDetection(const std::string& clipPath) {
+    for (const auto& detection : m_tempoDetections) {
+        if (detection->path == clipPath) {
+            return;
+        }
+    }
+    if (!m_tempoCache) {
+        m_tempoCache = std::make_shared<TempoAnalysisCache>();
+        m_tempoCachePath = GetTempoCachePath(m_appRoot);
+        std::string error;
+        if (!m_tempoCache->Load(m_tempoCachePath, error)) {
+            AppendDemoLog("[tempo] " + error);
+        }
+    }
+    auto detection = std::make_unique<TempoDetection>();
+    detection->path = clipPath;
+    TempoDetection* job = detection.get();
+    detection->done = std::async(std::launch::async, [job, cache = m_tempoCache, cachePath = m_tempoCachePath]() {
+        return DetectTempo(job->path, cache, cachePath, job->result, job->error);
+    });
+    m_tempoDetections.push_back(std::move(detection));
+}
+
+void ShaderLabIDE::PollTempoDetections() {
+    for (size_t i = 0; i < m_tempoDetections.size();) {
+        TempoDetection& detection = *m_tempoDetections[i];
+        if (detection.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++i;
+            continue;
+        }
+        if (detection.done.get()) {
+            for (AudioClip& clip : m_audioLibrary) {
+                if (clip.path == detection.path) {
+                    clip.bpm = detection.result.bpm;
+                    clip.beatOffset = detection.result.beatOffset;
+                }
+            }
+            NoteProjectEdit();
+            char message[256];
+            std::snprintf(message, sizeof(message), "[tempo] %s: %.2f BPM, downbeat at %.3f s (confidence %.2f)",
+                          detection.path.c_str(), detection.result.bpm, detection.result.beatOffset, detection.result.confidence);
+            AppendDemoLog(message);
+        } else {
+            AppendDemoLog("[tempo] " + detection.path + ": " + detection.error);
+        }
+        m_tempoDetections.erase(m_tempoDetections.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+}
+
 void ShaderLabIDE::ShowAudioLibrary() {
+    PollTempoDetections();
     if (ImGui::Begin("Audio Library")) {
         // Add Button
         if (LabeledActionButton("AddAudioFile", OpenFontIcons::kFilePlus, "Add Audio", "Add audio file", ImVec2(276.0f, 0.0f))) {
@@ -41,6 +212,8 @@ void ShaderLabIDE::ShowAudioLibrary() {
                  // Smart guess type (wav/ogg often sfx, mp3 often music)
                  // Keeping default Music for now.
                  m_audioLibrary.push_back(clip);
+                 NoteProjectEdit();
+                 StartTempoDetection(clip.path);
              }
         }
 
@@ -48,11 +221,13 @@ void ShaderLabIDE::ShowAudioLibrary() {
 
         // List
         ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable;
-        if (ImGui::BeginTable("AudioLibTable", 5, flags)) {
+        if (ImGui::BeginTable("AudioLibTable", 7, flags)) {
             ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_WidthFixed, 30.0f);
             ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("Waveform", ImGuiTableColumnFlags_WidthFixed, 160.0f);
             ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthFixed, 80.0f);
             ImGui::TableSetupColumn("BPM", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+            ImGui::TableSetupColumn("Downbeat", ImGuiTableColumnFlags_WidthFixed, 90.0f);
             ImGui::TableSetupColumn("Action", ImGuiTableColumnFlags_WidthFixed, 120.0f);
             ImGui::TableHeadersRow();
 
@@ -71,6 +246,20 @@ void ShaderLabIDE::ShowAudioLibrary() {
                 if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s", clip.path.c_str());
 
                 ImGui::TableSetColumnIndex(2);
+                {
+                    const WaveformPyramid* waveform = RequestWaveform(clip.path);
+                    const double duration = waveform ? waveform->GetDurationSeconds() : 0.0;
+                    EditorWaveformWidgets::DrawWaveform(waveform, 0.0, duration, ImVec2(-1.0f, ImGui::GetFrameHeight()));
+                    if (ImGui::IsItemHovered()) {
+                        if (waveform) {
+                            ImGui::SetTooltip("%.2f s, %u Hz", duration, waveform->GetSampleRate());
+                        } else {
+                            ImGui::SetTooltip("Building waveform...");
+                        }
+                    }
+                }
+
+                ImGui::TableSetColumnIndex(3);
                 const char* types[] = { "Music", "OneShot" };
                 int currentType = (clip.type == AudioType::Music) ? 0 : 1;
                 ImGui::SetNextItemWidth(-FLT_MIN);
@@ -78,7 +267,7 @@ void ShaderLabIDE::ShowAudioLibrary() {
                     clip.type = (currentType == 0) ? AudioType::Music : AudioType::OneShot;
                 }
 
-                ImGui::TableSetColumnIndex(3);
+                ImGui::TableSetColumnIndex(4);
                  if (clip.type == AudioType::Music) {
                      ImGui::SetNextItemWidth(-FLT_MIN);
                      // BPM of the specific audio file - This should remain editable as it's a property of the file
@@ -89,7 +278,31 @@ void ShaderLabIDE::ShowAudioLibrary() {
                      ImGui::TextDisabled("-");
                 }
 
-                ImGui::TableSetColumnIndex(4);
+                ImGui::TableSetColumnIndex(5);
+                if (clip.type == AudioType::Music) {
+                    bool detecting = false;
+                    for (const auto& detection : m_tempoDetections) {
+                        detecting = detecting || detection->path == clip.path;
+                    }
+                    if (detecting) {
+                        ImGui::TextDisabled("Detecting...");
+                    } else {
+                        ImGui::SetNextItemWidth(-40.0f);
+                        PushNumericFont();
+                        ImGui::InputFloat("##BeatOffset", &clip.beatOffset, 0.0f, 0.0f, "%.3f");
+                        PopNumericFont();
+                        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Seconds to the first downbeat");
+                        ImGui::SameLine();
+                        if (ImGui::SmallButton("Auto")) {
+                            StartTempoDetection(clip.path);
+                        }
+                        if (ImGui::IsItemHovered()) ImGui::SetTooltip("Detect BPM and downbeat from the audio");
+                    }
+                } else {
+                    ImGui::TextDisabled("-");
+                }
+
+                ImGui::TableSetColumnIndex(6);
                 if (LabeledActionButton("DeleteAudio", OpenFontIcons::kTrash2, "Delete", "Delete audio clip", ImVec2(110.0f, 0.0f))) {
                      // Check if this clip is currently playing and stop it
                      if (m_audioSystem && m_audioSystem->IsPlaying() && m_currentMode == UIMode::Demo) {
@@ -108,6 +321,7 @@ void ShaderLabIDE::ShowAudioLibrary() {
                      }
 
                      m_audioLibrary.erase(m_audioLibrary.begin() + i);
+                     NoteProjectEdit();
                      // Note: References by index in Track/Grid will break!
                      // Ideally we would use UUIDs, but for strict prototype index fixup is skipped.
                      // Warning: Deleting items shifts indices.
@@ -11,7 +11,7 @@ void ShaderLabIDE::CreateDefaultTrack() {
     TrackerRow startRow;
     startRow.rowId = 0;
     startRow.sceneIndex = 0;
-    m_track.rows.push_back(startRow);
+    m_track.rows.Insert(startRow);
 }
 
 } // namespace ShaderLab
@@ -1,5 +1,6 @@
 #include "ShaderLab/UI/ShaderLabIDE.h"
 #include "ShaderLab/UI/ShaderLabIDECore/ActionWidgets.h"
+#include "ShaderLab/UI/ShaderLabIDECore/WaveformWidget.h"
 #include "ShaderLab/UI/OpenFontIcons.h"
 #include "ShaderLab/UI/UISystemAssets.h"
 #include "ShaderLab/Audio/AudioSystem.h"
@@ -348,8 +349,49 @@ void ShaderLabIDE::RenderPlaylistMusicColumn(int beat, TrackerRow*& row, int& fo
     MarkPlaylistFocusedRow(beat, focusedBeatThisFrame);
 }
 
-void ShaderLabIDE::RenderPlaylistOneShotColumn(int beat, TrackerRow*& row, int& focusedBeatThisFrame) {
+void ShaderLabIDE::BuildPlaylistMusicSpans(std::vector<PlaylistMusicSpan>& outSpans) const {
+    outSpans.clear();
+    for (const TrackerRow& row : m_track.rows) {
+        if (row.rowId >= 0 && row.musicIndex >= 0 && row.musicIndex < (int)m_audioLibrary.size()) {
+            PlaylistMusicSpan span;
+            span.beat = row.rowId;
+            span.musicIndex = row.musicIndex;
+            outSpans.push_back(span);
+        }
+    }
+    // Same tempo rule as the sequencer: a clip with a BPM sets the transport tempo.
+    float bpm = m_track.bpm > 0.0f ? m_track.bpm : 120.0f;
+    int previousBeat = 0;
+    double time = 0.0;
+    for (PlaylistMusicSpan& span : outSpans) {
+        time += (span.beat - previousBeat) * 60.0 / bpm;
+        previousBeat = span.beat;
+        const float clipBpm = m_audioLibrary[span.musicIndex].bpm;
+        if (clipBpm > 0.0f) {
+            bpm = clipBpm;
+        }
+        span.timeSeconds = time;
+        span.bpm = bpm;
+    }
+}
+
+void ShaderLabIDE::RenderPlaylistWaveColumn(int beat, const std::vector<PlaylistMusicSpan>& spans) {
     ImGui::TableSetColumnIndex(6);
+    auto next = std::upper_bound(spans.begin(), spans.end(), beat, [](int value, const PlaylistMusicSpan& span) {
+        return value < span.beat;
+    });
+    if (next == spans.begin()) {
+        return;
+    }
+    const PlaylistMusicSpan& span = *(next - 1);
+    const double beatSeconds = 60.0 / span.bpm;
+    const double start = span.timeSeconds + (beat - span.beat) * beatSeconds;
+    const WaveformPyramid* waveform = RequestWaveform(m_audioLibrary[span.musicIndex].path);
+    EditorWaveformWidgets::DrawWaveform(waveform, start, start + beatSeconds, ImVec2(-1.0f, ImGui::GetFrameHeight()));
+}
+
+void ShaderLabIDE::RenderPlaylistOneShotColumn(int beat, TrackerRow*& row, int& focusedBeatThisFrame) {
+    ImGui::TableSetColumnIndex(7);
 
     std::string currentOSName = "(None)";
     int currentOSIdx = (row) ? row->oneShotIndex : -1;
@@ -382,23 +424,14 @@ void ShaderLabIDE::RenderPlaylistOneShotColumn(int beat, TrackerRow*& row, int&
 }
 
 TrackerRow* ShaderLabIDE::FindPlaylistRowByBeat(int targetBeat) {
-    for (auto& candidate : m_track.rows) {
-        if (candidate.rowId == targetBeat) {
-            return &candidate;
-        }
-    }
-    return nullptr;
+    return m_track.rows.Find(targetBeat);
 }
 
+// The store never moves rows, so pointers other columns hold this frame stay valid. Only
+// edits ask for a row to exist, so this is where the tracker reports them to undo.
 TrackerRow* ShaderLabIDE::EnsurePlaylistRowByBeat(int targetBeat) {
-    if (TrackerRow* existing = FindPlaylistRowByBeat(targetBeat)) {
-        return existing;
-    }
-
-    TrackerRow newRow;
-    newRow.rowId = targetBeat;
-    m_track.rows.push_back(newRow);
-    return &m_track.rows.back();
+    NoteProjectEdit();
+    return &m_track.rows.Ensure(targetBeat);
 }
 
 void ShaderLabIDE::ScrubPlaylistToBeat(int targetBeat) {
@@ -539,10 +572,12 @@ void ShaderLabIDE::RenderPlaylistTopToolbar(const ImVec2& spinnerSize) {
     };
     if (SpinnerIconButton("BpmDec", OpenFontIcons::kMinus, "Decrease BPM")) {
         if (track.bpm > 1.0f) track.bpm -= 1.0f;
+        NoteProjectEdit();
     }
     ImGui::SameLine(0.0f, kSpinnerGap);
     if (SpinnerIconButton("BpmInc", OpenFontIcons::kPlus, "Increase BPM")) {
         track.bpm += 1.0f;
+        NoteProjectEdit();
     }
 
     ImGui::SameLine(0.0f, kGroupGap);
@@ -570,6 +605,7 @@ void ShaderLabIDE::RenderPlaylistTopToolbar(const ImVec2& spinnerSize) {
     if (barsChanged) {
         if (bars < 1) bars = 1;
         track.lengthBeats = bars * 4;
+        NoteProjectEdit();
     }
     ImGui::SameLine(0.0f, kGroupGap * 0.6f);
     PushNumericFont();
@@ -592,6 +628,7 @@ void ShaderLabIDE::SetupPlaylistTrackerTable() const {
     ImGui::TableSetupColumn("Transition", ImGuiTableColumnFlags_WidthStretch, 0.5f);
     ImGui::TableSetupColumn("Trans Time", ImGuiTableColumnFlags_WidthFixed, 250.0f);
     ImGui::TableSetupColumn("Music", ImGuiTableColumnFlags_WidthStretch, 0.5f);
+    ImGui::TableSetupColumn("Wave", ImGuiTableColumnFlags_WidthFixed, 120.0f);
     ImGui::TableSetupColumn("OneShot", ImGuiTableColumnFlags_WidthFixed, 250.0f);
     ImGui::PushStyleColor(ImGuiCol_Text, m_uiThemeColors.TrackerHeadingFontColor);
     ImGui::PushItemFlag(ImGuiItemFlags_NoNav, true);
@@ -615,7 +652,8 @@ void ShaderLabIDE::ShowDemoPlaylist() {
     // Just ensure it has some rows maybe.
     if (m_track.rows.empty()) {
         TrackerRow startRow; startRow.rowId = 0;
-        m_track.rows.push_back(startRow);
+        m_track.rows.Insert(startRow);
+        NoteProjectEdit();
     }
 
     if (ImGui::Begin("Demo: Playlist")) {
@@ -625,9 +663,9 @@ void ShaderLabIDE::ShowDemoPlaylist() {
         RenderPlaylistTopToolbar(spinnerSize);
 
         // 2. Tracker Grid
-        // We want a table: [Beat] [Scene] [Transition] [Music] [OneShot]
+        // We want a table: [Beat] [Scene] [Transition] [Music] [Wave] [OneShot]
         ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingStretchProp;
-        if (ImGui::BeginTable("TrackerGrid", 7, flags)) {
+        if (ImGui::BeginTable("TrackerGrid", 8, flags)) {
             SetupPlaylistTrackerTable();
 
             // Prepare scene names for Combos
@@ -650,6 +688,9 @@ void ShaderLabIDE::ShowDemoPlaylist() {
             const bool editingAnyItem = ImGui::IsAnyItemActive();
             int focusedBeatThisFrame = -1;
 
+            std::vector<PlaylistMusicSpan> musicSpans;
+            BuildPlaylistMusicSpans(musicSpans);
+
             // Iterate through every beat
             ImGuiListClipper clipper;
             clipper.Begin(track.lengthBeats);
@@ -666,6 +707,7 @@ void ShaderLabIDE::ShowDemoPlaylist() {
                     RenderPlaylistSceneColumn(beat, row, sceneNames, spinnerSize, focusedBeatThisFrame);
                     RenderPlaylistTransitionColumn(beat, row, transitionNames, transitionStems, spinnerSize, focusedBeatThisFrame);
                     RenderPlaylistMusicColumn(beat, row, focusedBeatThisFrame);
+                    RenderPlaylistWaveColumn(beat, musicSpans);
                     RenderPlaylistOneShotColumn(beat, row, focusedBeatThisFrame);
 
                     if (pushedBarStartStyle) {
@@ -2,11 +2,11 @@
 #include "ShaderLab/UI/ShaderLabIDECore/ActionWidgets.h"
 #include "ShaderLab/UI/OpenFontIcons.h"
 #include "ShaderLab/UI/UISystemAssets.h"
+#include "ShaderLab/Core/ListSearchIndex.h"
 
 #include <imgui.h>
 
-#include <algorithm>
-#include <cctype>
+#include <vector>
 
 namespace ShaderLab {
 
@@ -15,12 +15,20 @@ using EditorActionWidgets::LabeledActionButton;
 
 int g_selectedPostFxPresetIndex = 0;
 int g_selectedComputePresetIndex = 0;
-
-std::string ToLowerAscii(std::string value) {
-    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
-        return static_cast<char>(std::tolower(c));
-    });
-    return value;
+char g_presetFilter[64] = {};
+ListSearchIndex g_postFxPresetSearch;
+ListSearchIndex g_computePresetSearch;
+
+// Presets whose name matches the filter, or null when there is no filter and every preset is listed.
+const std::vector<int>* FilterPresets(ListSearchIndex& search, const std::vector<ShaderPreset>& presets) {
+    if (g_presetFilter[0] == '\0') {
+        return nullptr;
+    }
+    search.Resize(presets.size());
+    for (size_t i = 0; i < presets.size(); ++i) {
+        search.SetItem(i, presets[i].name);
+    }
+    return &search.Query(g_presetFilter);
 }
 
 void ApplyComputeDefaults(Scene::ComputeEffect& effect) {
@@ -66,6 +74,9 @@ void ApplyComputeDefaults(Scene::ComputeEffect& effect) {
 
 void ShaderLabIDE::ShowPostFxLibraryWindow() {
     if (ImGui::Begin("FX: Library")) {
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::InputTextWithHint("##PresetFilter", "Filter presets", g_presetFilter, sizeof(g_presetFilter));
+
         // =====================================================================
         // PIXEL SHADER PRESETS
         // =====================================================================
@@ -80,11 +91,26 @@ void ShaderLabIDE::ShowPostFxLibraryWindow() {
                 g_selectedPostFxPresetIndex = (int)presets.size() - 1;
             }
 
-            if (ImGui::BeginListBox("##PostFxPresets", ImVec2(-1, 150))) {
-                for (int i = 0; i < (int)presets.size(); ++i) {
-                    bool isSelected = (i == g_selectedPostFxPresetIndex);
-                    if (ImGui::Selectable(presets[i].name.c_str(), isSelected)) {
-                        g_selectedPostFxPresetIndex = i;
+            // Thumbnails come from the atlas; a preset is only rendered again once its file changes.
+            // Rows outside the list box are clipped, so they never queue a thumbnail either.
+            const ImVec2 thumbnailSize(64.0f, 36.0f);
+            const std::vector<int>* matches = FilterPresets(g_postFxPresetSearch, presets);
+            if (ImGui::BeginListBox("##PostFxPresets", ImVec2(-1, 220))) {
+                ImGuiListClipper clipper;
+                clipper.Begin(matches ? (int)matches->size() : (int)presets.size());
+                while (clipper.Step()) {
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                        const int i = matches ? (*matches)[row] : row;
+                        ImGui::PushID(i);
+                        bool isSelected = (i == g_selectedPostFxPresetIndex);
+                        DrawShaderThumbnail(presets[i].code, presets[i].contentHash, true, thumbnailSize);
+                        const bool thumbnailClicked = ImGui::IsItemClicked();
+                        ImGui::SameLine();
+                        if (ImGui::Selectable(presets[i].name.c_str(), isSelected, 0, ImVec2(0.0f, thumbnailSize.y)) ||
+                            thumbnailClicked) {
+                            g_selectedPostFxPresetIndex = i;
+                        }
+                        ImGui::PopID();
                     }
                 }
                 ImGui::EndListBox();
@@ -128,11 +154,19 @@ void ShaderLabIDE::ShowPostFxLibraryWindow() {
                 g_selectedComputePresetIndex = (int)computePresets.size() - 1;
             }
 
+            const std::vector<int>* computeMatches = FilterPresets(g_computePresetSearch, computePresets);
             if (ImGui::BeginListBox("##ComputePresets", ImVec2(-1, 150))) {
-                for (int i = 0; i < (int)computePresets.size(); ++i) {
-                    bool isSelected = (i == g_selectedComputePresetIndex);
-                    if (ImGui::Selectable(computePresets[i].name.c_str(), isSelected)) {
-                        g_selectedComputePresetIndex = i;
+                ImGuiListClipper clipper;
+                clipper.Begin(computeMatches ? (int)computeMatches->size() : (int)computePresets.size());
+                while (clipper.Step()) {
+                    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                        const int i = computeMatches ? (*computeMatches)[row] : row;
+                        ImGui::PushID(i);
+                        bool isSelected = (i == g_selectedComputePresetIndex);
+                        if (ImGui::Selectable(computePresets[i].name.c_str(), isSelected)) {
+                            g_selectedComputePresetIndex = i;
+                        }
+                        ImGui::PopID();
                     }
                 }
                 ImGui::EndListBox();
@@ -174,6 +208,7 @@ void ShaderLabIDE::ShowPostFxLibraryWindow() {
     float time;
     float invWidth, invHeight;
     uint frame;
+    uint historyFrames;
 };
 
 Texture2D<float4> inputTexture : register(t0);
@@ -49,6 +49,7 @@ void ShaderLabIDE::ShowPostFxSourceWindow() {
             if (LabeledActionButton("ApplyFxDraft", OpenFontIcons::kCheck, "Apply", "Apply draft chains to scene", ImVec2(110.0f, 0.0f))) {
                 m_scenes[m_postFxSourceSceneIndex].postFxChain = m_postFxDraftChain;
                 m_scenes[m_postFxSourceSceneIndex].computeEffectChain = m_computeEffectDraftChain;
+                NoteProjectEdit();
                 RefreshPresetService();
             }
         }
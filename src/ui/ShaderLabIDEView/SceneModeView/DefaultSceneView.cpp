@@ -20,6 +20,7 @@ void ShaderLabIDE::CreateDefaultScene() {
     }
 
     m_scenes.emplace_back(sceneName, shaderCode);
+    NoteProjectEdit();
     m_shaderState.text = shaderCode;
 }
 
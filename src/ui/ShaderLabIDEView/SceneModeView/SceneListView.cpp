@@ -6,6 +6,7 @@
 #include <imgui.h>
 
 #include <cstdio>
+#include <vector>
 
 namespace ShaderLab {
 
@@ -44,55 +45,87 @@ float4 main(float2 fragCoord, float2 iResolution, float iTime) {
 )";
 
             m_scenes.emplace_back(nameBuf, templateShader);
+            NoteProjectEdit();
             RefreshPresetService();
         }
 
+        ImGui::SetNextItemWidth(-FLT_MIN);
+        ImGui::InputTextWithHint("##SceneFilter", "Filter scenes", m_sceneListFilter, sizeof(m_sceneListFilter));
+
         ImGui::Separator();
 
-        for (int i = 0; i < (int)m_scenes.size(); i++) {
-            ImGui::PushID(i);
-            bool isSelected = (i == m_activeSceneIndex);
-            if (ImGui::Selectable(m_scenes[i].name.c_str(), isSelected)) {
-                SetActiveScene(i);
+        const std::vector<int>* matches = nullptr;
+        if (m_sceneListFilter[0] != '\0') {
+            m_sceneListSearch.Resize(m_scenes.size());
+            for (size_t i = 0; i < m_scenes.size(); ++i) {
+                m_sceneListSearch.SetItem(i, m_scenes[i].name);
+            }
+            matches = &m_sceneListSearch.Query(m_sceneListFilter);
+            if (matches->empty()) {
+                ImGui::TextDisabled("No matching scenes.");
             }
+        }
 
-            if (ImGui::BeginPopupContextItem()) {
-                if (ImGui::BeginMenu("Output Type")) {
-                     if (ImGui::MenuItem("2D Texture", nullptr, m_scenes[i].outputType == TextureType::Texture2D)) {
-                         m_scenes[i].outputType = TextureType::Texture2D;
-                         m_scenes[i].texture.Reset();
-                     }
-                     if (ImGui::MenuItem("Cube Map", nullptr, m_scenes[i].outputType == TextureType::TextureCube)) {
-                         m_scenes[i].outputType = TextureType::TextureCube;
-                         m_scenes[i].texture.Reset();
-                     }
-                     ImGui::EndMenu();
+        // Only the visible rows are submitted; list edits are applied once the clipper is done.
+        int duplicateIndex = -1;
+        int deleteIndex = -1;
+        ImGuiListClipper clipper;
+        clipper.Begin(matches ? (int)matches->size() : (int)m_scenes.size());
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                const int i = matches ? (*matches)[row] : row;
+                ImGui::PushID(i);
+                bool isSelected = (i == m_activeSceneIndex);
+                if (ImGui::Selectable(m_scenes[i].name.c_str(), isSelected)) {
+                    SetActiveScene(i);
                 }
 
-                ImGui::Separator();
+                if (ImGui::BeginPopupContextItem()) {
+                    if (ImGui::BeginMenu("Output Type")) {
+                         if (ImGui::MenuItem("2D Texture", nullptr, m_scenes[i].outputType == TextureType::Texture2D)) {
+                             m_scenes[i].outputType = TextureType::Texture2D;
+                             m_scenes[i].texture.Reset();
+                             NoteProjectEdit();
+                         }
+                         if (ImGui::MenuItem("Cube Map", nullptr, m_scenes[i].outputType == TextureType::TextureCube)) {
+                             m_scenes[i].outputType = TextureType::TextureCube;
+                             m_scenes[i].texture.Reset();
+                             NoteProjectEdit();
+                         }
+                         ImGui::EndMenu();
+                    }
+
+                    ImGui::Separator();
 
-                if (ImGui::MenuItem("Rename")) {
-                }
-                if (ImGui::MenuItem("Duplicate")) {
-                    m_scenes.push_back(m_scenes[i]);
-                    m_scenes.back().name += " (Copy)";
-                    RefreshPresetService();
-                }
-                if (ImGui::MenuItem("Delete", nullptr, false, m_scenes.size() > 1)) {
-                    m_scenes.erase(m_scenes.begin() + i);
-                    if (m_activeSceneIndex >= (int)m_scenes.size()) {
-                        m_activeSceneIndex = (int)m_scenes.size() - 1;
+                    if (ImGui::MenuItem("Rename")) {
+                    }
+                    if (ImGui::MenuItem("Duplicate")) {
+                        duplicateIndex = i;
+                    }
+                    if (ImGui::MenuItem("Delete", nullptr, false, m_scenes.size() > 1)) {
+                        deleteIndex = i;
                     }
-                    SetActiveScene(m_activeSceneIndex);
-                    RefreshPresetService();
                     ImGui::EndPopup();
-                    ImGui::PopID();
-                    i--;
-                    continue;
                 }
-                ImGui::EndPopup();
+                ImGui::PopID();
             }
-            ImGui::PopID();
+        }
+
+        if (duplicateIndex >= 0) {
+            m_scenes.push_back(m_scenes[duplicateIndex]);
+            m_scenes.back().id = 0; // The copy is a new scene
+            m_scenes.back().name += " (Copy)";
+            NoteProjectEdit();
+            RefreshPresetService();
+        }
+        if (deleteIndex >= 0) {
+            m_scenes.erase(m_scenes.begin() + deleteIndex);
+            NoteProjectEdit();
+            if (m_activeSceneIndex >= (int)m_scenes.size()) {
+                m_activeSceneIndex = (int)m_scenes.size() - 1;
+            }
+            SetActiveScene(m_activeSceneIndex);
+            RefreshPresetService();
         }
 
         if (m_currentMode == UIMode::Scene) {
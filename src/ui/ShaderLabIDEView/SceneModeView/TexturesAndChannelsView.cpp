@@ -58,8 +58,8 @@ void ShaderLabIDE::ShowSceneTexturesAndChannels() {
 
                 if (GetOpenFileNameA(&ofn)) {
                     binding.filePath = ImportAssetIntoProject(szFile);
-                    LoadTextureFromFile(binding.filePath, binding.textureResource);
-                    binding.fileTextureValid = binding.textureResource != nullptr;
+                    RequestFileTexture(binding);
+                    NoteProjectEdit();
                 }
             };
 
@@ -93,6 +93,7 @@ void ShaderLabIDE::ShowSceneTexturesAndChannels() {
                 browseAndAssignFileTexture(binding);
 
                 scene.bindings.push_back(binding);
+                NoteProjectEdit();
             }
             if (singleRowButtons) {
                 ImGui::SameLine();
@@ -113,6 +114,7 @@ void ShaderLabIDE::ShowSceneTexturesAndChannels() {
                 }
                 binding.sourceSceneIndex = defaultScene;
                 scene.bindings.push_back(binding);
+                NoteProjectEdit();
             }
 
             if (compactFont && compactFontSize > 0.0f) {
@@ -299,10 +301,7 @@ void ShaderLabIDE::ShowSceneTexturesAndChannels() {
                             strncpy_s(pathBuf, binding.filePath.c_str(), _TRUNCATE);
                             if (ImGui::InputText("File Path", pathBuf, sizeof(pathBuf))) {
                                 binding.filePath = pathBuf;
-                                if (!binding.filePath.empty()) {
-                                    LoadTextureFromFile(binding.filePath, binding.textureResource);
-                                    binding.fileTextureValid = binding.textureResource != nullptr;
-                                }
+                                RequestFileTexture(binding);
                             }
                             if (LabeledActionButton("BrowseTexture", OpenFontIcons::kFolder, "Browse", "Browse texture file", ImVec2(120.0f * dpiScale, 0.0f))) {
                                 browseAndAssignFileTexture(binding);
@@ -323,6 +322,7 @@ void ShaderLabIDE::ShowSceneTexturesAndChannels() {
 
                 if (bindingToRemove >= 0 && bindingToRemove < (int)scene.bindings.size()) {
                     scene.bindings.erase(scene.bindings.begin() + bindingToRemove);
+                    NoteProjectEdit();
                 }
             }
 
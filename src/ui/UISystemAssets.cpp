@@ -1,10 +1,13 @@
 #include "ShaderLab/UI/UISystemAssets.h"
 
+#include "ShaderLab/Core/AssetCatalog.h"
+#include "ShaderLab/Core/LinkedShaderWatcher.h"
+
 #include <algorithm>
 #include <cctype>
-#include <chrono>
+#include <cmath>
 #include <filesystem>
-#include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,31 +23,16 @@ namespace {
 
 struct PresetFolderService {
     std::string category;
-    fs::path workspaceRoot;
-    fs::path appBackupRoot;
+    int collection = -1;
+    std::shared_ptr<const AssetCollectionSnapshot> snapshot;
     std::vector<ShaderPreset> presets;
 
-    fs::path WorkspaceDir() const {
-        return workspaceRoot / "presets" / category;
-    }
-
-    fs::path BackupDir() const {
-        return appBackupRoot / "editor_assets" / "presets" / category;
+    static fs::path WorkspaceDir(const std::string& workspaceRoot, const std::string& category) {
+        return fs::path(workspaceRoot) / "presets" / category;
     }
 
-    static std::string ReadAllText(const fs::path& path) {
-        std::ifstream in(path, std::ios::binary);
-        if (!in.is_open()) {
-            return {};
-        }
-        std::string content;
-        in.seekg(0, std::ios::end);
-        content.resize(static_cast<size_t>(in.tellg()));
-        in.seekg(0, std::ios::beg);
-        if (!content.empty()) {
-            in.read(content.data(), static_cast<std::streamsize>(content.size()));
-        }
-        return content;
+    static fs::path BackupDir(const std::string& appRoot, const std::string& category) {
+        return fs::path(appRoot) / "editor_assets" / "presets" / category;
     }
 
     static std::string HumanizeStem(const std::string& stem) {
@@ -67,58 +55,42 @@ struct PresetFolderService {
         return out;
     }
 
-    void EnsureWorkspaceAndSeedFromBackup() const {
-        std::error_code ec;
-        fs::create_directories(WorkspaceDir(), ec);
-
-        const fs::path backup = BackupDir();
-        if (!fs::exists(backup, ec)) {
-            return;
+    void Attach(AssetCatalog& catalog, const std::string& workspaceRoot, const std::string& appRoot) {
+        const std::string root = WorkspaceDir(workspaceRoot, category).string();
+        const std::string seedFrom = BackupDir(appRoot, category).string();
+        if (collection < 0) {
+            AssetCollectionDesc desc;
+            desc.root = root;
+            desc.seedFrom = seedFrom;
+            desc.suffixes = { ".hlsl" };
+            desc.loadContent = true;
+            desc.createRoot = true;
+            collection = catalog.AddCollection(std::move(desc));
+        } else {
+            catalog.SetCollectionRoot(collection, root, seedFrom);
         }
+    }
 
-        for (const auto& entry : fs::directory_iterator(backup, ec)) {
-            if (ec || !entry.is_regular_file()) {
-                continue;
-            }
-            const fs::path source = entry.path();
-            if (source.extension() != ".hlsl") {
-                continue;
-            }
-            const fs::path dest = WorkspaceDir() / source.filename();
-            if (!fs::exists(dest, ec)) {
-                fs::copy_file(source, dest, fs::copy_options::none, ec);
-            }
+    // Only rebuilds the list when the catalog published a newer snapshot.
+    void Update(const AssetCatalog& catalog) {
+        auto latest = catalog.GetSnapshot(collection);
+        if (!latest || latest == snapshot) {
+            return;
         }
-    }
+        snapshot = std::move(latest);
 
-    void Reload() {
         presets.clear();
-        EnsureWorkspaceAndSeedFromBackup();
-
-        std::error_code ec;
-        std::vector<fs::path> files;
-        if (fs::exists(WorkspaceDir(), ec)) {
-            for (const auto& entry : fs::directory_iterator(WorkspaceDir(), ec)) {
-                if (ec || !entry.is_regular_file()) {
-                    continue;
-                }
-                if (entry.path().extension() == ".hlsl") {
-                    files.push_back(entry.path());
-                }
+        for (const AssetEntry& entry : snapshot->entries) {
+            if (!entry.content || entry.content->empty()) {
+                continue;
             }
-        }
-
-        std::sort(files.begin(), files.end());
-
-        for (const auto& path : files) {
             ShaderPreset preset;
-            preset.stem = path.stem().string();
+            preset.stem = entry.stem;
             preset.name = HumanizeStem(preset.stem);
-            preset.filePath = path.string();
-            preset.code = ReadAllText(path);
-            if (!preset.code.empty()) {
-                presets.push_back(std::move(preset));
-            }
+            preset.filePath = entry.path;
+            preset.code = *entry.content;
+            preset.contentHash = HashShaderText(preset.code);
+            presets.push_back(std::move(preset));
         }
     }
 
@@ -137,42 +109,38 @@ struct PresetServiceState {
     PresetFolderService postFx{ "postfx" };
     PresetFolderService compute{ "compute" };
     PresetFolderService transitions{ "transitions" };
-    std::chrono::steady_clock::time_point lastRefresh{};
-    bool hasRefreshed = false;
+    AssetCatalog* catalog = nullptr;
 };
 
 PresetServiceState g_state;
 
+constexpr uint32_t kInitialScanTimeoutMs = 2000;
 
-} // namespace
 
-void InitializePresetService(const std::string& workspaceRoot, const std::string& appRoot) {
-    g_state.scenes.workspaceRoot = fs::path(workspaceRoot);
-    g_state.postFx.workspaceRoot = fs::path(workspaceRoot);
-    g_state.compute.workspaceRoot = fs::path(workspaceRoot);
-    g_state.transitions.workspaceRoot = fs::path(workspaceRoot);
+} // namespace
 
-    g_state.scenes.appBackupRoot = fs::path(appRoot);
-    g_state.postFx.appBackupRoot = fs::path(appRoot);
-    g_state.compute.appBackupRoot = fs::path(appRoot);
-    g_state.transitions.appBackupRoot = fs::path(appRoot);
+void InitializePresetService(AssetCatalog& catalog, const std::string& workspaceRoot, const std::string& appRoot) {
+    g_state.catalog = &catalog;
+    PresetFolderService* services[] = { &g_state.scenes, &g_state.postFx, &g_state.compute, &g_state.transitions };
+    for (PresetFolderService* service : services) {
+        service->Attach(catalog, workspaceRoot, appRoot);
+    }
+    // Scenes and transitions are looked up by stem while the project loads, so wait for the first scan.
+    for (PresetFolderService* service : services) {
+        catalog.WaitForScan(service->collection, kInitialScanTimeoutMs);
+    }
 
     RefreshPresetService();
 }
 
 void RefreshPresetService() {
-    const auto now = std::chrono::steady_clock::now();
-    constexpr auto kRefreshDebounce = std::chrono::milliseconds(200);
-    if (g_state.hasRefreshed && (now - g_state.lastRefresh) < kRefreshDebounce) {
+    if (!g_state.catalog) {
         return;
     }
-
-    g_state.scenes.Reload();
-    g_state.postFx.Reload();
-    g_state.compute.Reload();
-    g_state.transitions.Reload();
-    g_state.lastRefresh = now;
-    g_state.hasRefreshed = true;
+    g_state.scenes.Update(*g_state.catalog);
+    g_state.postFx.Update(*g_state.catalog);
+    g_state.compute.Update(*g_state.catalog);
+    g_state.transitions.Update(*g_state.catalog);
 }
 
 const std::vector<ShaderPreset>& GetScenePresets() {
@@ -228,4 +196,46 @@ std::string GetEditorTransitionShaderSourceByStem(const std::string& stem) {
     return {};
 }
 
+bool LooksLikeSceneContract(const std::string& code) {
+    if (code.find("float4 main") != std::string::npos &&
+        code.find("fragCoord") != std::string::npos &&
+        code.find("iResolution") != std::string::npos &&
+        code.find("iTime") != std::string::npos) {
+        return true;
+    }
+    if (code.find("mainImage") != std::string::npos) {
+        return true;
+    }
+    return false;
+}
+
+void ComputeTutTiming(double timeSeconds,
+                      float bpm,
+                      float& outIBeat,
+                      float& outIBar,
+                      float& outFBeat,
+                      float& outFBarBeat,
+                      float& outFBarBeat16) {
+    constexpr float kBeatsPerBar = 4.0f;
+    constexpr float kSixteenthPerBeat = 4.0f;
+
+    const float beatsPerSecond = bpm / 60.0f;
+    float exactBeat = static_cast<float>(timeSeconds * static_cast<double>(beatsPerSecond));
+    if (exactBeat < 0.0f) {
+        exactBeat = 0.0f;
+    }
+
+    const float beat = std::floor(exactBeat);
+    const float bar = std::floor(beat / kBeatsPerBar);
+    const float beatInBar = exactBeat - std::floor(exactBeat / kBeatsPerBar) * kBeatsPerBar;
+    float barBeat16 = std::floor(beatInBar * kSixteenthPerBeat);
+    barBeat16 = (std::max)(0.0f, (std::min)(15.0f, barBeat16));
+
+    outIBeat = beat;
+    outIBar = bar;
+    outFBeat = exactBeat;
+    outFBarBeat = beatInBar;
+    outFBarBeat16 = barBeat16;
+}
+
 } // namespace ShaderLab
@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+"""Regenerates the compact track fixtures used by the ShaderLabSimCli tests.
+
+Rows are (rowId, sceneIndex, transition, flags, durationQ4, offsetQ4, musicIndex);
+transition 255 means none and flags bit 0 stops the demo.
+"""
+
+import os
+import struct
+
+ROW_FORMAT = '<hhBBBbb'
+
+
+def write_v2(path, bpm, length_beats, rows):
+    data = struct.pack('<HHHHH', 0x4B54, 0x3252, int(bpm * 256), length_beats, len(rows))
+    for row in rows:
+        data += struct.pack(ROW_FORMAT, *row)
+    with open(path, 'wb') as f:
+        f.write(data)
+
+
+def write_v3(path, bpm, length_beats, rows, scene_count):
+    data = struct.pack('<HHHHH', 0x4B54, 0x3352, int(bpm * 256), length_beats, len(rows))
+    data += struct.pack('<HBB', scene_count, 6, 0)
+    data += struct.pack('<6h', *range(6))
+    for scene in range(scene_count):
+        data += struct.pack('<hH', scene, 1) + struct.pack('<h', 10 + scene)
+    for row in rows:
+        data += struct.pack(ROW_FORMAT, *row)
+    with open(path, 'wb') as f:
+        f.write(data)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+
+    # 140 BPM, three scenes, a cut-only transition and a stop row: 798 frames at 60 fps.
+    write_v2(os.path.join(here, 'stop_v2.bin'), 140.0, 32, [
+        (0, 0, 255, 0, 0, 0, 0),
+        (8, 1, 0, 0, 32, 0, -1),
+        (16, -1, 2, 0, 16, 0, -1),
+        (20, 2, 255, 0, 0, 0, -1),
+        (24, -1, 0, 0, 16, 0, -1),
+        (28, 0, 255, 0, 0, 0, -1),
+        (31, -1, 255, 1, 0, 0, -1),
+    ])
+
+    # 128 BPM, four scenes with post-FX, overlapping transitions and no stop row.
+    write_v3(os.path.join(here, 'four_scenes_v3.bin'), 128.0, 112, [
+        (0, 0, 255, 0, 0, 0, 0),
+        (16, 1, 0, 0, 32, 0, -1),
+        (32, 2, 255, 0, 0, 0, -1),
+        (48, -1, 1, 0, 64, 0, -1),
+        (56, 3, 255, 0, 0, 0, -1),
+        (64, 0, 255, 0, 0, 0, -1),
+        (80, 2, 2, 0, 16, 0, -1),
+        (96, 1, 255, 0, 0, 0, -1),
+    ], 4)
+
+
+if __name__ == '__main__':
+    main()
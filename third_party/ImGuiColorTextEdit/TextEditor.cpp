@@ -1,8 +1,11 @@
 #include <algorithm>
 #include <chrono>
 #include <string>
+#include <string_view>
 #include <regex>
 #include <cmath>
+#include <iterator>
+#include <limits>
 
 #include "TextEditor.h"
 
@@ -41,6 +44,7 @@ TextEditor::TextEditor()
 	, mColorRangeMax(0)
 	, mSelectionMode(SelectionMode::Normal)
 	, mCheckComments(true)
+	, mCommentRangeMin(0)
 	, mLastClick(-1.0f)
 	, mHandleKeyboardInputs(true)
 	, mHandleMouseInputs(true)
@@ -259,13 +263,18 @@ void TextEditor::DeleteRange(const Coordinates & aStart, const Coordinates & aEn
 int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValue)
 {
 	assert(!mReadOnly);
+	assert(!mLines.empty());
+
+	if (*aValue == '\0')
+		return 0;
 
+	// Split into lines first, so a multi-line insert shifts the lines below it once rather than once per newline.
 	int cindex = GetCharacterIndex(aWhere);
-	int totalLines = 0;
+	Line head;
+	Lines added;
+	Line* current = &head;
 	while (*aValue != '\0')
 	{
-		assert(!mLines.empty());
-
 		if (*aValue == '\r')
 		{
 			// skip
@@ -273,35 +282,37 @@ int TextEditor::InsertTextAt(Coordinates& /* inout */ aWhere, const char * aValu
 		}
 		else if (*aValue == '\n')
 		{
-			if (cindex < (int)mLines[aWhere.mLine].size())
-			{
-				auto& newLine = InsertLine(aWhere.mLine + 1);
-				auto& line = mLines[aWhere.mLine];
-				newLine.insert(newLine.begin(), line.begin() + cindex, line.end());
-				line.erase(line.begin() + cindex, line.end());
-			}
-			else
-			{
-				InsertLine(aWhere.mLine + 1);
-			}
-			++aWhere.mLine;
+			added.emplace_back();
+			current = &added.back();
 			aWhere.mColumn = 0;
-			cindex = 0;
-			++totalLines;
 			++aValue;
 		}
 		else
 		{
-			auto& line = mLines[aWhere.mLine];
 			auto d = UTF8CharLength(*aValue);
 			while (d-- > 0 && *aValue != '\0')
-				line.insert(line.begin() + cindex++, Glyph(*aValue++, PaletteIndex::Default));
+				current->emplace_back(Glyph(*aValue++, PaletteIndex::Default));
 			++aWhere.mColumn;
 		}
+	}
 
-		mTextChanged = true;
+	auto& line = mLines[aWhere.mLine];
+	if (added.empty())
+	{
+		line.insert(line.begin() + cindex, head.begin(), head.end());
+	}
+	else
+	{
+		added.back().insert(added.back().end(), line.begin() + cindex, line.end());
+		line.erase(line.begin() + cindex, line.end());
+		line.insert(line.end(), head.begin(), head.end());
+		InsertLines(aWhere.mLine + 1, added);
 	}
 
+	const int totalLines = (int)added.size();
+	aWhere.mLine += totalLines;
+	mTextChanged = true;
+
 	return totalLines;
 }
 
@@ -598,6 +609,9 @@ void TextEditor::RemoveLine(int aStart, int aEnd)
 
 	mLines.erase(mLines.begin() + aStart, mLines.begin() + aEnd);
 	assert(!mLines.empty());
+	if (mLineStates.size() >= (size_t)aEnd)
+		mLineStates.erase(mLineStates.begin() + aStart, mLineStates.begin() + aEnd);
+	mCommentRangeMin = std::min(mCommentRangeMin, aStart);
 
 	mTextChanged = true;
 }
@@ -628,6 +642,9 @@ void TextEditor::RemoveLine(int aIndex)
 
 	mLines.erase(mLines.begin() + aIndex);
 	assert(!mLines.empty());
+	if (mLineStates.size() > (size_t)aIndex)
+		mLineStates.erase(mLineStates.begin() + aIndex);
+	mCommentRangeMin = std::min(mCommentRangeMin, aIndex);
 
 	mTextChanged = true;
 }
@@ -637,6 +654,9 @@ TextEditor::Line& TextEditor::InsertLine(int aIndex)
 	assert(!mReadOnly);
 
 	auto& result = *mLines.insert(mLines.begin() + aIndex, Line());
+	if (mLineStates.size() >= (size_t)aIndex)
+		mLineStates.insert(mLineStates.begin() + aIndex, LineState());
+	mCommentRangeMin = std::min(mCommentRangeMin, aIndex);
 
 	ErrorMarkers etmp;
 	for (auto& i : mErrorMarkers)
@@ -651,6 +671,30 @@ TextEditor::Line& TextEditor::InsertLine(int aIndex)
 	return result;
 }
 
+void TextEditor::InsertLines(int aIndex, Lines& aLines)
+{
+	assert(!mReadOnly);
+
+	const int count = (int)aLines.size();
+	if (count == 0)
+		return;
+
+	mLines.insert(mLines.begin() + aIndex, std::make_move_iterator(aLines.begin()), std::make_move_iterator(aLines.end()));
+	if (mLineStates.size() >= (size_t)aIndex)
+		mLineStates.insert(mLineStates.begin() + aIndex, (size_t)count, LineState());
+	mCommentRangeMin = std::min(mCommentRangeMin, aIndex);
+
+	ErrorMarkers etmp;
+	for (auto& i : mErrorMarkers)
+		etmp.insert(ErrorMarkers::value_type(i.first >= aIndex ? i.first + count : i.first, i.second));
+	mErrorMarkers = std::move(etmp);
+
+	Breakpoints btmp;
+	for (auto i : mBreakpoints)
+		btmp.insert(i >= aIndex ? i + count : i);
+	mBreakpoints = std::move(btmp);
+}
+
 std::string TextEditor::GetWordUnderCursor() const
 {
 	auto c = GetCursorPosition();
@@ -1169,6 +1213,7 @@ void TextEditor::Render(const char* aTitle, const ImVec2& aSize, bool aBorder)
 void TextEditor::SetText(const std::string & aText)
 {
 	mLines.clear();
+	mLineStates.clear();
 	mLines.emplace_back(Line());
 	for (auto chr : aText)
 	{
@@ -1196,6 +1241,7 @@ void TextEditor::SetText(const std::string & aText)
 void TextEditor::SetTextLines(const std::vector<std::string> & aLines)
 {
 	mLines.clear();
+	mLineStates.clear();
 
 	if (aLines.empty())
 	{
@@ -2165,6 +2211,12 @@ void TextEditor::Colorize(int aFromLine, int aLines)
 	mColorRangeMax = std::max(mColorRangeMax, toLine);
 	mColorRangeMin = std::max(0, mColorRangeMin);
 	mColorRangeMax = std::max(mColorRangeMin, mColorRangeMax);
+
+	// The comment pass restarts at the first invalidated line and runs until the entry state settles.
+	const int fromLine = std::max(0, aFromLine);
+	for (int i = fromLine; i < toLine && i < (int)mLineStates.size(); ++i)
+		mLineStates[i].mValid = false;
+	mCommentRangeMin = std::min(mCommentRangeMin, fromLine);
 	mCheckComments = true;
 }
 
@@ -2282,140 +2334,296 @@ void TextEditor::ColorizeInternal()
 
 	if (mCheckComments)
 	{
-		auto endLine = mLines.size();
-		auto endIndex = 0;
-		auto commentStartLine = endLine;
-		auto commentStartIndex = endIndex;
-		auto withinString = false;
-		auto withinSingleLineComment = false;
-		auto withinPreproc = false;
-		auto firstChar = true;			// there is no other non-whitespace characters in the line before
-		auto concatenate = false;		// '\' on the very end of the line
-		auto currentLine = 0;
-		auto currentIndex = 0;
-		while (currentLine < endLine || currentIndex < endIndex)
-		{
-			auto& line = mLines[currentLine];
-
-			if (currentIndex == 0 && !concatenate)
-			{
-				withinSingleLineComment = false;
-				withinPreproc = false;
-				firstChar = true;
-			}
+		const int lineCount = (int)mLines.size();
+		int fromLine = std::min(mCommentRangeMin, lineCount - 1);
+		if (mLineStates.size() != mLines.size())
+		{
+			mLineStates.assign(mLines.size(), LineState());
+			fromLine = 0;
+		}
+		while (fromLine > 0 && !mLineStates[fromLine].mValid)
+			--fromLine;
 
-			concatenate = false;
+		LineState state;
+		if (fromLine > 0)
+			state = mLineStates[fromLine];
+		state.mValid = true;
 
-			if (!line.empty())
-			{
-				auto& g = line[currentIndex];
-				auto c = g.mChar;
+		for (int currentLine = fromLine; currentLine < lineCount; ++currentLine)
+		{
+			// Past the edit, a line entered in the same state as last time scans the same as last time.
+			if (currentLine > fromLine && mLineStates[currentLine] == state)
+				break;
+			mLineStates[currentLine] = state;
+			ScanCommentLine(currentLine, state);
+		}
+
+		mCommentRangeMin = std::numeric_limits<int>::max();
+		mCheckComments = false;
+	}
+
+	if (mColorRangeMin < mColorRangeMax)
+	{
+		const int increment = (mLanguageDefinition.mTokenize == nullptr) ? 500 : 10000;
+		const int to = std::min(mColorRangeMin + increment, mColorRangeMax);
+		ColorizeRange(mColorRangeMin, to);
+		mColorRangeMin = to;
+
+		if (mColorRangeMax == mColorRangeMin)
+		{
+			mColorRangeMin = std::numeric_limits<int>::max();
+			mColorRangeMax = 0;
+		}
+		return;
+	}
+}
 
-				if (c != mLanguageDefinition.mPreprocChar && !isspace(c))
-					firstChar = false;
+void TextEditor::ScanCommentLine(int aLine, LineState& aState)
+{
+	auto& line = mLines[aLine];
 
-				if (currentIndex == (int)line.size() - 1 && line[line.size() - 1].mChar == '\\')
-					concatenate = true;
+	if (!aState.mContinued)
+	{
+		aState.mSingleLineComment = false;
+		aState.mPreprocessor = false;
+		aState.mFirstChar = true;
+	}
+	aState.mContinued = false;
 
-				bool inComment = (commentStartLine < currentLine || (commentStartLine == currentLine && commentStartIndex <= currentIndex));
+	// Index where the open multi-line comment started; -1 if on an earlier line.
+	const int none = std::numeric_limits<int>::max();
+	int commentStart = aState.mInComment ? -1 : none;
 
-				if (withinString)
-				{
-					line[currentIndex].mMultiLineComment = inComment;
+	int currentIndex = 0;
+	while (currentIndex < (int)line.size())
+	{
+		auto& g = line[currentIndex];
+		auto c = g.mChar;
 
-					if (c == '\"')
-					{
-						if (currentIndex + 1 < (int)line.size() && line[currentIndex + 1].mChar == '\"')
-						{
-							currentIndex += 1;
-							if (currentIndex < (int)line.size())
-								line[currentIndex].mMultiLineComment = inComment;
-						}
-						else
-							withinString = false;
-					}
-					else if (c == '\\')
-					{
-						currentIndex += 1;
-						if (currentIndex < (int)line.size())
-							line[currentIndex].mMultiLineComment = inComment;
-					}
-				}
-				else
-				{
-					if (firstChar && c == mLanguageDefinition.mPreprocChar)
-						withinPreproc = true;
+		aState.mContinued = false;
 
-					if (c == '\"')
-					{
-						withinString = true;
-						line[currentIndex].mMultiLineComment = inComment;
-					}
-					else
-					{
-						auto pred = [](const char& a, const Glyph& b) { return a == b.mChar; };
-						auto from = line.begin() + currentIndex;
-						auto& startStr = mLanguageDefinition.mCommentStart;
-						auto& singleStartStr = mLanguageDefinition.mSingleLineComment;
-
-						if (singleStartStr.size() > 0 &&
-							currentIndex + singleStartStr.size() <= line.size() &&
-							equals(singleStartStr.begin(), singleStartStr.end(), from, from + singleStartStr.size(), pred))
-						{
-							withinSingleLineComment = true;
-						}
-						else if (!withinSingleLineComment && currentIndex + startStr.size() <= line.size() &&
-							equals(startStr.begin(), startStr.end(), from, from + startStr.size(), pred))
-						{
-							commentStartLine = currentLine;
-							commentStartIndex = currentIndex;
-						}
+		if (c != mLanguageDefinition.mPreprocChar && !isspace(c))
+			aState.mFirstChar = false;
 
-						inComment = inComment = (commentStartLine < currentLine || (commentStartLine == currentLine && commentStartIndex <= currentIndex));
+		if (currentIndex == (int)line.size() - 1 && line[line.size() - 1].mChar == '\\')
+			aState.mContinued = true;
 
-						line[currentIndex].mMultiLineComment = inComment;
-						line[currentIndex].mComment = withinSingleLineComment;
+		bool inComment = commentStart <= currentIndex;
 
-						auto& endStr = mLanguageDefinition.mCommentEnd;
-						if (currentIndex + 1 >= (int)endStr.size() &&
-							equals(endStr.begin(), endStr.end(), from + 1 - endStr.size(), from + 1, pred))
-						{
-							commentStartIndex = endIndex;
-							commentStartLine = endLine;
-						}
-					}
-				}
-				line[currentIndex].mPreprocessor = withinPreproc;
-				currentIndex += UTF8CharLength(c);
-				if (currentIndex >= (int)line.size())
+		if (aState.mInString)
+		{
+			line[currentIndex].mMultiLineComment = inComment;
+
+			if (c == '\"')
+			{
+				if (currentIndex + 1 < (int)line.size() && line[currentIndex + 1].mChar == '\"')
 				{
-					currentIndex = 0;
-					++currentLine;
+					currentIndex += 1;
+					if (currentIndex < (int)line.size())
+						line[currentIndex].mMultiLineComment = inComment;
 				}
+				else
+					aState.mInString = false;
+			}
+			else if (c == '\\')
+			{
+				currentIndex += 1;
+				if (currentIndex < (int)line.size())
+					line[currentIndex].mMultiLineComment = inComment;
+			}
+		}
+		else
+		{
+			if (aState.mFirstChar && c == mLanguageDefinition.mPreprocChar)
+				aState.mPreprocessor = true;
+
+			if (c == '\"')
+			{
+				aState.mInString = true;
+				line[currentIndex].mMultiLineComment = inComment;
 			}
 			else
 			{
-				currentIndex = 0;
-				++currentLine;
+				auto pred = [](const char& a, const Glyph& b) { return a == b.mChar; };
+				auto from = line.begin() + currentIndex;
+				auto& startStr = mLanguageDefinition.mCommentStart;
+				auto& singleStartStr = mLanguageDefinition.mSingleLineComment;
+
+				if (singleStartStr.size() > 0 &&
+					currentIndex + singleStartStr.size() <= line.size() &&
+					equals(singleStartStr.begin(), singleStartStr.end(), from, from + singleStartStr.size(), pred))
+				{
+					aState.mSingleLineComment = true;
+				}
+				else if (!aState.mSingleLineComment && currentIndex + startStr.size() <= line.size() &&
+					equals(startStr.begin(), startStr.end(), from, from + startStr.size(), pred))
+				{
+					commentStart = currentIndex;
+				}
+
+				inComment = commentStart <= currentIndex;
+
+				line[currentIndex].mMultiLineComment = inComment;
+				line[currentIndex].mComment = aState.mSingleLineComment;
+
+				auto& endStr = mLanguageDefinition.mCommentEnd;
+				if (currentIndex + 1 >= (int)endStr.size() &&
+					equals(endStr.begin(), endStr.end(), from + 1 - endStr.size(), from + 1, pred))
+				{
+					commentStart = none;
+				}
 			}
 		}
-		mCheckComments = false;
+		if (currentIndex < (int)line.size())
+			line[currentIndex].mPreprocessor = aState.mPreprocessor;
+		currentIndex += UTF8CharLength(c);
 	}
 
-	if (mColorRangeMin < mColorRangeMax)
+	aState.mInComment = commentStart != none;
+}
+
+size_t TextEditor::SearchText(const char* aText, size_t aTextSize, const std::string& aNeedle, size_t aFrom) const
+{
+	if (mSearchCallback != nullptr)
+		return mSearchCallback(aText, aTextSize, aNeedle.data(), aNeedle.size(), aFrom);
+	return std::string_view(aText, aTextSize).find(aNeedle, aFrom);
+}
+
+void TextEditor::GetLineChars(int aLine, std::string& aOut) const
+{
+	auto& line = mLines[aLine];
+	aOut.resize(line.size());
+	for (size_t i = 0; i < line.size(); ++i)
+		aOut[i] = line[i].mChar;
+}
+
+bool TextEditor::FindNext(const std::string& aNeedle, const Coordinates& aFrom, Coordinates& aOutStart, Coordinates& aOutEnd) const
+{
+	if (aNeedle.empty() || mLines.empty())
+		return false;
+
+	const auto from = SanitizeCoordinates(aFrom);
+	const int fromIndex = GetCharacterIndex(from);
+	const int lineCount = (int)mLines.size();
+
+	if (aNeedle.find('\n') != std::string::npos)
 	{
-		const int increment = (mLanguageDefinition.mTokenize == nullptr) ? 500 : 10000;
-		const int to = std::min(mColorRangeMin + increment, mColorRangeMax);
-		ColorizeRange(mColorRangeMin, to);
-		mColorRangeMin = to;
+		// The match may span lines, so this one needs the flat text.
+		const std::string text = GetText();
+		size_t offset = 0;
+		for (int i = 0; i < from.mLine; ++i)
+			offset += mLines[i].size() + 1;
+		offset += fromIndex;
 
-		if (mColorRangeMax == mColorRangeMin)
+		size_t found = SearchText(text.data(), text.size(), aNeedle, offset + 1);
+		if (found == std::string::npos)
+			found = SearchText(text.data(), text.size(), aNeedle, 0);
+		if (found == std::string::npos)
+			return false;
+
+		int line = 0;
+		while (line + 1 < lineCount && found > mLines[line].size())
 		{
-			mColorRangeMin = std::numeric_limits<int>::max();
-			mColorRangeMax = 0;
+			found -= mLines[line].size() + 1;
+			++line;
+		}
+		const int endLine = std::min(lineCount - 1, line + (int)std::count(aNeedle.begin(), aNeedle.end(), '\n'));
+		const size_t tail = aNeedle.size() - aNeedle.rfind('\n') - 1;
+		aOutStart = Coordinates(line, GetCharacterColumn(line, (int)found));
+		aOutEnd = Coordinates(endLine, GetCharacterColumn(endLine, (int)tail));
+		return true;
+	}
+
+	// One line at a time from the cursor; the cursor line comes round again last to cover the wrap.
+	std::string buffer;
+	for (int i = 0; i <= lineCount; ++i)
+	{
+		const int line = (from.mLine + i) % lineCount;
+		GetLineChars(line, buffer);
+		const size_t found = SearchText(buffer.data(), buffer.size(), aNeedle, i == 0 ? (size_t)fromIndex + 1 : 0);
+		if (found != std::string::npos)
+		{
+			aOutStart = Coordinates(line, GetCharacterColumn(line, (int)found));
+			aOutEnd = Coordinates(line, GetCharacterColumn(line, (int)(found + aNeedle.size())));
+			return true;
 		}
-		return;
 	}
+	return false;
+}
+
+int TextEditor::ReplaceAll(const std::string& aNeedle, const std::string& aReplacement)
+{
+	if (mReadOnly || aNeedle.empty() || mLines.empty())
+		return 0;
+
+	// Only the span from the first to the last matching line is rewritten, undone and recolored.
+	int firstLine = -1;
+	int lastLine = -1;
+	if (aNeedle.find('\n') != std::string::npos)
+	{
+		firstLine = 0;
+		lastLine = (int)mLines.size() - 1;
+	}
+	else
+	{
+		std::string buffer;
+		for (int i = 0; i < (int)mLines.size(); ++i)
+		{
+			GetLineChars(i, buffer);
+			if (SearchText(buffer.data(), buffer.size(), aNeedle, 0) != std::string::npos)
+			{
+				if (firstLine < 0)
+					firstLine = i;
+				lastLine = i;
+			}
+		}
+	}
+	if (firstLine < 0)
+		return 0;
+
+	const Coordinates start(firstLine, 0);
+	const Coordinates end(lastLine, GetLineMaxColumn(lastLine));
+	const std::string removed = GetText(start, end);
+
+	std::string added;
+	added.reserve(removed.size());
+	int count = 0;
+	size_t pos = 0;
+	size_t found = 0;
+	while ((found = SearchText(removed.data(), removed.size(), aNeedle, pos)) != std::string::npos)
+	{
+		added.append(removed, pos, found - pos);
+		added += aReplacement;
+		pos = found + aNeedle.size();
+		++count;
+	}
+	if (count == 0)
+		return 0;
+	added.append(removed, pos, std::string::npos);
+
+	UndoRecord u;
+	u.mBefore = mState;
+	u.mRemoved = removed;
+	u.mRemovedStart = start;
+	u.mRemovedEnd = end;
+
+	DeleteRange(start, end);
+	auto where = start;
+	const int totalLines = InsertTextAt(where, added.c_str());
+
+	const size_t lastBreak = added.rfind('\n');
+	const int tail = (int)(lastBreak == std::string::npos ? added.size() : added.size() - lastBreak - 1);
+	u.mAdded = added;
+	u.mAddedStart = start;
+	u.mAddedEnd = Coordinates(where.mLine, GetCharacterColumn(where.mLine, tail));
+
+	const auto cursor = SanitizeCoordinates(mState.mCursorPosition);
+	mState.mSelectionStart = mState.mSelectionEnd = mState.mCursorPosition = cursor;
+	u.mAfter = mState;
+	AddUndo(u);
+
+	Colorize(firstLine - 1, totalLines + 2);
+	return count;
 }
 
 float TextEditor::TextDistanceToLineStart(const Coordinates& aFrom) const
@@ -2764,6 +2972,29 @@ static bool TokenizeCStylePunctuation(const char * in_begin, const char * in_end
 	return false;
 }
 
+static bool TokenizeCStylePreprocessorDirective(const char * in_begin, const char * in_end, const char *& out_begin, const char *& out_end)
+{
+	const char * p = in_begin;
+
+	if (*p != '#')
+		return false;
+	p++;
+
+	while (p < in_end && (*p == ' ' || *p == '\t'))
+		p++;
+
+	const char * name = p;
+	while (p < in_end && isascii(*p) && (isalpha(*p) || *p == '_'))
+		p++;
+
+	if (p == name)
+		return false;
+
+	out_begin = in_begin;
+	out_end = p;
+	return true;
+}
+
 const TextEditor::LanguageDefinition& TextEditor::LanguageDefinition::CPlusPlus()
 {
 	static bool inited = false;
@@ -2881,6 +3112,36 @@ const TextEditor::LanguageDefinition& TextEditor::LanguageDefinition::HLSL()
 			langDef.mIdentifiers.insert(std::make_pair(std::string(k), id));
 		}
 
+		// Same tokens as the regexes below, without running std::regex per token.
+		langDef.mTokenize = [](const char * in_begin, const char * in_end, const char *& out_begin, const char *& out_end, PaletteIndex & paletteIndex) -> bool
+		{
+			paletteIndex = PaletteIndex::Max;
+
+			while (in_begin < in_end && isascii(*in_begin) && isblank(*in_begin))
+				in_begin++;
+
+			if (in_begin == in_end)
+			{
+				out_begin = in_end;
+				out_end = in_end;
+				paletteIndex = PaletteIndex::Default;
+			}
+			else if (TokenizeCStylePreprocessorDirective(in_begin, in_end, out_begin, out_end))
+				paletteIndex = PaletteIndex::Preprocessor;
+			else if (TokenizeCStyleString(in_begin, in_end, out_begin, out_end))
+				paletteIndex = PaletteIndex::String;
+			else if (TokenizeCStyleCharacterLiteral(in_begin, in_end, out_begin, out_end))
+				paletteIndex = PaletteIndex::CharLiteral;
+			else if (TokenizeCStyleIdentifier(in_begin, in_end, out_begin, out_end))
+				paletteIndex = PaletteIndex::Identifier;
+			else if (TokenizeCStyleNumber(in_begin, in_end, out_begin, out_end))
+				paletteIndex = PaletteIndex::Number;
+			else if (TokenizeCStylePunctuation(in_begin, in_end, out_begin, out_end))
+				paletteIndex = PaletteIndex::Punctuation;
+
+			return paletteIndex != PaletteIndex::Max;
+		};
+
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("[ \\t]*#[ \\t]*[a-zA-Z_]+", PaletteIndex::Preprocessor));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("L?\\\"(\\\\.|[^\\\"])*\\\"", PaletteIndex::String));
 		langDef.mTokenRegexStrings.push_back(std::make_pair<std::string, PaletteIndex>("\\'\\\\?[^\\']\\'", PaletteIndex::CharLiteral));
@@ -237,6 +237,15 @@ public:
 	void InsertText(const std::string& aValue);
 	void InsertText(const char* aValue);
 
+	// Substring search over raw chars; returns std::string::npos when there is no match.
+	typedef size_t(*SearchCallback)(const char* aText, size_t aTextSize, const char* aNeedle, size_t aNeedleSize, size_t aFrom);
+	void SetSearchCallback(SearchCallback aCallback) { mSearchCallback = aCallback; }
+
+	// Finds the next match starting after aFrom, wrapping around at the end of the text.
+	bool FindNext(const std::string& aNeedle, const Coordinates& aFrom, Coordinates& aOutStart, Coordinates& aOutEnd) const;
+	// Replaces every match as one undoable edit; returns the number of replacements.
+	int ReplaceAll(const std::string& aNeedle, const std::string& aReplacement);
+
 	void MoveUp(int aAmount = 1, bool aSelect = false);
 	void MoveDown(int aAmount = 1, bool aSelect = false);
 	void MoveLeft(int aAmount = 1, bool aSelect = false, bool aWordMode = false);
@@ -312,10 +321,34 @@ private:
 
 	typedef std::vector<UndoRecord> UndoBuffer;
 
+	// Comment / string / preprocessor scanner state on entry to a line.
+	struct LineState
+	{
+		bool mValid = false;
+		bool mInComment = false;
+		bool mInString = false;
+		bool mContinued = false;
+		bool mSingleLineComment = false;
+		bool mPreprocessor = false;
+		bool mFirstChar = true;
+
+		bool operator==(const LineState& o) const
+		{
+			return mValid == o.mValid && mInComment == o.mInComment && mInString == o.mInString &&
+				mContinued == o.mContinued && mSingleLineComment == o.mSingleLineComment &&
+				mPreprocessor == o.mPreprocessor && mFirstChar == o.mFirstChar;
+		}
+		bool operator!=(const LineState& o) const { return !(*this == o); }
+	};
+	typedef std::vector<LineState> LineStates;
+
 	void ProcessInputs();
 	void Colorize(int aFromLine = 0, int aCount = -1);
 	void ColorizeRange(int aFromLine = 0, int aToLine = 0);
 	void ColorizeInternal();
+	void ScanCommentLine(int aLine, LineState& aState);
+	size_t SearchText(const char* aText, size_t aTextSize, const std::string& aNeedle, size_t aFrom) const;
+	void GetLineChars(int aLine, std::string& aOut) const;
 	float TextDistanceToLineStart(const Coordinates& aFrom) const;
 	void EnsureCursorVisible();
 	int GetPageSize() const;
@@ -338,6 +371,7 @@ private:
 	void RemoveLine(int aStart, int aEnd);
 	void RemoveLine(int aIndex);
 	Line& InsertLine(int aIndex);
+	void InsertLines(int aIndex, Lines& aLines);
 	void EnterCharacter(ImWchar aChar, bool aShift);
 	void Backspace();
 	void DeleteSelection();
@@ -381,6 +415,9 @@ private:
 	RegexList mRegexList;
 
 	bool mCheckComments;
+	LineStates mLineStates;             // parallel to mLines; lines below an edit are rescanned until their entry state settles
+	int mCommentRangeMin;
+	SearchCallback mSearchCallback = nullptr;
 	Breakpoints mBreakpoints;
 	ErrorMarkers mErrorMarkers;
 	ImVec2 mCharAdvance;